@@ -51,6 +51,15 @@ for %%V in (%VENDOR_LIBS%) do (
         )
     )
 )
+REM Names with spaces can't go through the FOR list above (Adafruit SPIFlash: QSPI message log;
+REM it pulls in SdFat for its FAT layer even though the firmware only uses raw sectors)
+for %%V in ("Adafruit SPIFlash" "SdFat - Adafruit Fork") do (
+    if exist "libraries\%%~V" (
+        for %%D in ("%ARDUINO_LIB_DIR%" "%SKETCHBOOK_LIB_DIR%") do (
+            xcopy /E /I /Y "libraries\%%~V" "%%~D\%%~V" 2>nul >nul
+        )
+    )
+)
 REM Handle library names with different naming conventions
 if not exist "%ARDUINO_LIB_DIR%\Adafruit_GFX_Library" if exist "%ARDUINO_LIB_DIR%\Adafruit-GFX-Library" (
     move /Y "%ARDUINO_LIB_DIR%\Adafruit-GFX-Library" "%ARDUINO_LIB_DIR%\Adafruit_GFX_Library" 2>nul >nul
@@ -68,6 +77,15 @@ echo   OK: Libraries verified
 echo   OK: Libraries verified
 echo.
 
+REM ---- Regenerate the pre-rasterised font atlas (main\font_atlas.h is committed, so Python is optional) ----
+where python >nul 2>nul
+if !errorlevel! equ 0 (
+    python build_scripts\gen_font_atlas.py
+) else (
+    echo   [WARN] python not found, using committed main\font_atlas.h
+)
+echo.
+
 REM ---- Compile firmware ----
 echo [3/3] Building firmware...
 if exist "%BUILD_DIR%\*.a" (
@@ -76,7 +94,9 @@ if exist "%BUILD_DIR%\*.a" (
 )
 rd /s /q %BUILD_DIR% 2>nul
 mkdir %BUILD_DIR% 2>nul
-call "%ARDUINO_CLI%" compile -b %BOARD% --build-path %BUILD_DIR% %SKETCH_DIR% 2>&1
+REM The settings pages (settings_store.h, 0xEB000) sit inside the core's FLASH region: cap the image
+REM (.text + .data) at SETTINGS_IMAGE_MAX = 0xEB000 - 0x26000 so a larger build fails here
+call "%ARDUINO_CLI%" compile -b %BOARD% --build-path %BUILD_DIR% --build-property "upload.maximum_size=806912" %SKETCH_DIR% 2>&1
 
 if !errorlevel! neq 0 (
     echo.
@@ -54,7 +54,9 @@ echo.
 REM Step 4: Build firmware
 echo [3/4] Building firmware...
 rd /s /q %BUILD_DIR% 2>nul
-call "%ARDUINO_CLI%" compile -b %BOARD% --build-path %BUILD_DIR% %SKETCH_DIR% 2>&1
+REM The settings pages (settings_store.h, 0xEB000) sit inside the core's FLASH region: cap the image
+REM (.text + .data) at SETTINGS_IMAGE_MAX = 0xEB000 - 0x26000 so a larger build fails here
+call "%ARDUINO_CLI%" compile -b %BOARD% --build-path %BUILD_DIR% --build-property "upload.maximum_size=806912" %SKETCH_DIR% 2>&1
 if !errorlevel! neq 0 (
     echo [FAIL] Compilation failed. See errors above.
     set FAILED=1
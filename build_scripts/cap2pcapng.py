@@ -0,0 +1,329 @@
+#!/usr/bin/env python3
+"""Convert a LoRa capture dump (PCAP command replies) into pcapng, with a Wireshark dissector.
+
+The firmware keeps every frame it sends or receives in a ring on the QSPI flash (lora_capture.h).
+Pull it over BLE with PCAP, PCAP:<NEXT>, ... and save the replies — one "OK{PCAP:<first>:<hex>,...}"
+per line, any other lines are ignored — then:
+
+    python build_scripts/cap2pcapng.py dump.txt capture.pcapng      # pcapng, LINKTYPE_USER0
+    python build_scripts/cap2pcapng.py dump.txt --text               # decoded listing on stdout
+    python build_scripts/cap2pcapng.py --lua techo_lora.lua          # Wireshark Lua dissector
+
+Each pcapng packet is the record as stored (CapRecHdr + raw frame), so the dissector shows the
+radio metadata as well as the frame. Direction goes into epb_flags, CRC errors into a comment.
+Timestamps are wall-clock when the boot segment has a valid clock marker, else time since reset.
+"""
+
+import base64
+import calendar
+import re
+import struct
+import sys
+
+# Must match lora_capture.h
+HDR = struct.Struct("<IIHHhbBBB")      # t_ms freq_khz seq bw_100hz rssi_q4 snr_q4 sf cr flags
+CLOCK = struct.Struct("<BBHBBBBB")     # format valid year month day hour minute second
+CAP_FORMAT = 1
+F_TX, F_CRC_ERR, F_ERR, F_TRUNC, F_CLOCK, F_BOOT = 0x01, 0x02, 0x04, 0x08, 0x40, 0x80
+LINKTYPE_USER0 = 147
+
+REPLY = re.compile(r"OK\{PCAP:(\d+):([0-9A-Fa-f,]*)\}")
+PP_FIELD = re.compile(rb"~PP([A-Za-z0-9_-]+)")
+
+# Must match pos_codec.h
+POS_F_DELTA, POS_F_ALT, POS_F_MOTION, POS_F_HIRES = 0x80, 0x40, 0x20, 0x10
+
+
+def read_dump(path):
+    """Records by message number — overlapping pages from a re-run dump are merged."""
+    recs = {}
+    for line in open(path, encoding="latin-1"):
+        for m in REPLY.finditer(line):
+            n = int(m.group(1))
+            for h in m.group(2).split(","):
+                if h:
+                    recs[n] = bytes.fromhex(h)
+                n += 1
+    return [recs[n] for n in sorted(recs)]
+
+
+def decode(rec):
+    if len(rec) < HDR.size:
+        return None
+    t_ms, freq, seq, bw, rssi, snr, sf, cr, flags = HDR.unpack_from(rec)
+    return dict(t_ms=t_ms, freq_khz=freq, seq=seq, bw_hz=bw * 100, rssi=rssi / 4.0, snr=snr / 4.0,
+                sf=sf, cr=cr, flags=flags, body=rec[HDR.size:])
+
+
+def clock_epoch(body):
+    if len(body) < CLOCK.size:
+        return None
+    fmt, valid, y, mo, d, h, mi, s = CLOCK.unpack_from(body)
+    if fmt != CAP_FORMAT or not valid or not (1 <= mo <= 12 and 1 <= d <= 31):
+        return None
+    return calendar.timegm((y, mo, d, h, mi, s, 0, 0, 0))
+
+
+def timestamps(recs):
+    """Microsecond timestamp per record; each boot segment gets the offset of its first clock marker."""
+    out, seg, offset = [], [], None
+
+    def close():
+        for r in seg:
+            base = offset if offset is not None else 0
+            out.append(base + r["t_ms"] * 1000)
+
+    for r in recs:
+        if r["flags"] & F_BOOT and seg:
+            close()
+            seg, offset = [], None
+        seg.append(r)
+        if offset is None and r["flags"] & F_CLOCK:
+            e = clock_epoch(r["body"])
+            if e is not None:
+                offset = e * 1000000 - r["t_ms"] * 1000
+    close()
+    return out
+
+
+# ── Frame dissection ── (mirrors Packet::parseHeader in packet.cpp)
+
+def dissect(frame):
+    """(type, channel, [(field, value)], payload)"""
+    idx = frame.find(b"~")
+    if idx < 0:
+        return ("?", "", [], frame)
+    head = frame[:idx]
+    ch = ""
+    if head[:2] == b"PT" and idx == 3:
+        kind, ch = "PTT", chr(head[2])
+    elif head[:2] == b"RN" and idx == 3:
+        kind, ch = "RANGE", chr(head[2])
+    elif head[:3] == b"TXM" and idx >= 5:
+        kind, ch = "TXT_MULTI " + head[4:].decode("latin-1"), chr(head[3])
+    elif head == b"MAP":
+        kind = "MAP"
+    elif head == b"REQ":
+        kind = "REQ"
+    elif head == b"WPT":
+        kind = "WAYPOINT"
+    elif head[:1] == b"B" and idx > 1:
+        kind = "BEACON " + head[1:].decode("latin-1")
+    elif head[:2] == b"TX" and idx >= 3:
+        kind, ch = "TXT", chr(head[2])
+    elif head == b"PS":
+        kind = "P2P_SYNC"
+    elif head[:2] == b"PR":
+        kind = "PRB"
+    else:
+        kind = "?"
+
+    fields, i = [], idx
+    while i < len(frame) and frame[i:i + 1] == b"~":
+        if frame[i:i + 2] == b"~~":
+            i += 2
+            break
+        j = frame.find(b"~", i + 1)
+        if j < 0:
+            j = len(frame)
+        f = frame[i + 1:j]
+        if len(f) >= 2:
+            fields.append((f[:2].decode("latin-1"), f[2:].decode("latin-1")))
+        i = j
+    payload = frame[i:]
+    if kind == "PTT" and payload[:1] == b"O":
+        kind = "PTT opus"
+    return (kind, ch, fields, payload)
+
+
+def packed_position(text):
+    """~PP value (pos_codec.h) as "lat,lon[ alt=..][ spd=.. crs=..][ batt=..]"."""
+    b = base64.urlsafe_b64decode(text + "=" * (-len(text) % 4))
+    flags, i = b[0] & 0xF0, 1
+    if flags & POS_F_HIRES:
+        lat, lon = struct.unpack_from("<ii", b, 1)
+        s, i = "%.7f,%.7f" % (lat / 1e7, lon / 1e7), 9
+    elif flags & POS_F_DELTA:
+        s, i = "delta(%+d,%+d)" % struct.unpack_from("<bb", b, 2), 4
+    else:
+        lat = int.from_bytes(b[1:4], "little", signed=True)
+        lon = int.from_bytes(b[4:7], "little", signed=True)
+        s, i = "%.6f,%.6f" % (lat * 90 / 2 ** 23, lon * 180 / 2 ** 23), 7
+    if flags & POS_F_ALT:
+        s += " alt=%d" % struct.unpack_from("<h", b, i)
+        i += 2
+    if flags & POS_F_MOTION:
+        s += " spd=%.1f crs=%.0f" % (b[i] * 0.5, b[i + 1] * 360 / 256)
+    if b[0] & 0x0F:
+        s += " batt=%d" % ((((b[0] & 0x0F) - 1) * 100 + 7) // 14)
+    return s
+
+
+def describe(r):
+    if r["flags"] & (F_BOOT | F_CLOCK):
+        e = clock_epoch(r["body"])
+        what = "BOOT" if r["flags"] & F_BOOT else "CLOCK"
+        return "%s %s" % (what, "" if e is None else "rtc=%d" % e)
+    kind, ch, fields, payload = dissect(r["body"])
+    s = "%s %s" % ("TX" if r["flags"] & F_TX else "RX", kind)
+    if ch:
+        s += " ch=" + ch
+    for k, v in fields:
+        s += " %s=%s" % (k, v)
+    if payload:
+        s += " | " + ("%d bytes" % len(payload) if kind.startswith("PTT") else repr(payload.decode("latin-1")))
+        m = PP_FIELD.search(payload)
+        if m and not kind.startswith("PTT"):
+            try:
+                s += " pos=" + packed_position(m.group(1).decode())
+            except (ValueError, IndexError, struct.error):
+                s += " pos=?"
+    return s
+
+
+# ── pcapng writer ──
+
+def block(btype, body):
+    body += b"\0" * (-len(body) % 4)
+    n = 12 + len(body)
+    return struct.pack("<II", btype, n) + body + struct.pack("<I", n)
+
+
+def option(code, value):
+    return struct.pack("<HH", code, len(value)) + value + b"\0" * (-len(value) % 4)
+
+
+def write_pcapng(path, recs, ts):
+    with open(path, "wb") as f:
+        f.write(block(0x0A0D0D0A, struct.pack("<IHHq", 0x1A2B3C4D, 1, 0, -1)))
+        idb_opts = option(2, b"lora0") + option(3, b"T-Echo SX1262 capture ring") + option(0, b"")
+        f.write(block(0x00000001, struct.pack("<HHI", LINKTYPE_USER0, 0, 0) + idb_opts))
+        for raw, r, t in zip(recs, (decode(x) for x in recs), ts):
+            if r["flags"] & (F_BOOT | F_CLOCK):
+                continue
+            opts = option(2, struct.pack("<I", 2 if r["flags"] & F_TX else 1))
+            notes = [n for bit, n in ((F_CRC_ERR, "CRC error"), (F_ERR, "radio error"), (F_TRUNC, "truncated"))
+                     if r["flags"] & bit]
+            if notes:
+                opts += option(1, ", ".join(notes).encode())
+            opts += option(0, b"")
+            data = raw + b"\0" * (-len(raw) % 4)
+            f.write(block(0x00000006, struct.pack("<IIIII", 0, t >> 32, t & 0xFFFFFFFF, len(raw), len(raw))
+                          + data + opts))
+
+
+LUA = r'''-- T-Echo LoRa capture dissector (generated by build_scripts/cap2pcapng.py)
+-- Copy into the Wireshark personal plugins folder. Packets use LINKTYPE_USER0 (DLT 147).
+local p = Proto("techo_lora", "T-Echo LoRa capture")
+local f = p.fields
+f.t_ms   = ProtoField.uint32("techo_lora.t_ms", "Uptime (ms)")
+f.freq   = ProtoField.uint32("techo_lora.freq_khz", "Frequency (kHz)")
+f.seq    = ProtoField.uint16("techo_lora.seq", "Capture seq")
+f.bw     = ProtoField.uint16("techo_lora.bw_100hz", "Bandwidth (x100 Hz)")
+f.rssi   = ProtoField.float("techo_lora.rssi", "RSSI (dBm)")
+f.snr    = ProtoField.float("techo_lora.snr", "SNR (dB)")
+f.sf     = ProtoField.uint8("techo_lora.sf", "Spreading factor")
+f.cr     = ProtoField.uint8("techo_lora.cr", "Coding rate (4/x)")
+f.flags  = ProtoField.uint8("techo_lora.flags", "Flags", base.HEX)
+f.tx     = ProtoField.bool("techo_lora.flags.tx", "Sent", 8, nil, 0x01)
+f.crc    = ProtoField.bool("techo_lora.flags.crc_err", "CRC error", 8, nil, 0x02)
+f.err    = ProtoField.bool("techo_lora.flags.err", "Radio error", 8, nil, 0x04)
+f.trunc  = ProtoField.bool("techo_lora.flags.trunc", "Truncated", 8, nil, 0x08)
+f.ftype  = ProtoField.string("techo_lora.type", "Type")
+f.chan   = ProtoField.string("techo_lora.channel", "Channel")
+f.field  = ProtoField.string("techo_lora.field", "Field")
+f.body   = ProtoField.bytes("techo_lora.payload", "Payload")
+
+local HDR = 18
+
+local function classify(s)
+    local idx = s:find("~", 1, true)
+    if not idx then return "?", "", #s end
+    local head = s:sub(1, idx - 1)
+    local n = #head
+    if head:sub(1, 2) == "PT" and n == 3 then return "PTT", head:sub(3, 3), n, 2 end
+    if head:sub(1, 2) == "RN" and n == 3 then return "RANGE", head:sub(3, 3), n, 2 end
+    if head:sub(1, 3) == "TXM" and n >= 5 then return "TXT_MULTI " .. head:sub(5), head:sub(4, 4), n, 3 end
+    if head == "MAP" then return "MAP", "", n end
+    if head == "REQ" then return "REQ", "", n end
+    if head == "WPT" then return "WAYPOINT", "", n end
+    if head:sub(1, 1) == "B" and n > 1 then return "BEACON " .. head:sub(2), "", n end
+    if head:sub(1, 2) == "TX" and n >= 3 then return "TXT", head:sub(3, 3), n, 2 end
+    if head == "PS" then return "P2P_SYNC", "", n end
+    if head:sub(1, 2) == "PR" then return "PRB", "", n end
+    return "?", "", n
+end
+
+function p.dissector(buf, pinfo, tree)
+    if buf:len() < HDR then return end
+    pinfo.cols.protocol = "T-Echo LoRa"
+    local t = tree:add(p, buf(), "T-Echo LoRa capture")
+    local r = t:add(buf(0, HDR), "Radio")
+    r:add_le(f.t_ms, buf(0, 4))
+    r:add_le(f.freq, buf(4, 4))
+    r:add_le(f.seq, buf(8, 2))
+    r:add_le(f.bw, buf(10, 2))
+    r:add(f.rssi, buf(12, 2), buf(12, 2):le_int() / 4)
+    r:add(f.snr, buf(14, 1), buf(14, 1):int() / 4)
+    r:add(f.sf, buf(15, 1))
+    r:add(f.cr, buf(16, 1))
+    local fl = r:add(f.flags, buf(17, 1))
+    fl:add(f.tx, buf(17, 1)); fl:add(f.crc, buf(17, 1)); fl:add(f.err, buf(17, 1)); fl:add(f.trunc, buf(17, 1))
+    if buf:len() == HDR then return end
+
+    local fr = buf(HDR)
+    local s = fr:string()
+    local kind, ch, hl, choff = classify(s)
+    local ft = t:add(fr, "Frame: " .. kind)
+    ft:add(f.ftype, fr(0, math.max(hl, 1)), kind)
+    if ch ~= "" then ft:add(f.chan, fr(choff, 1), ch) end
+
+    local i = hl + 1            -- 1-based position of the '~' after the type
+    local info = kind
+    while i <= #s and s:sub(i, i) == "~" do
+        if s:sub(i, i + 1) == "~~" then i = i + 2; break end
+        local j = s:find("~", i + 1, true) or (#s + 1)
+        local v = s:sub(i + 1, j - 1)
+        if #v >= 2 then
+            ft:add(f.field, fr(i, j - i - 1), v:sub(1, 2) .. "=" .. v:sub(3))
+            if v:sub(1, 2) == "DI" or v:sub(1, 2) == "PC" then info = info .. " " .. v end
+        end
+        i = j
+    end
+    if i <= #s then ft:add(f.body, fr(i - 1)) end
+    if ch ~= "" then info = info .. " ch=" .. ch end
+    pinfo.cols.info = info
+end
+
+local encaps = wtap_encaps or wtap
+DissectorTable.get("wtap_encap"):add(encaps.USER0, p)
+'''
+
+
+def main(argv):
+    if len(argv) >= 2 and argv[0] == "--lua":
+        open(argv[1], "w").write(LUA)
+        print("wrote", argv[1])
+        return 0
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+    raw = read_dump(argv[0])
+    recs = [decode(x) for x in raw]
+    if any(r is None for r in recs):
+        print("short record in dump", file=sys.stderr)
+        return 1
+    ts = timestamps(recs)
+    if argv[1] == "--text":
+        for r, t in zip(recs, ts):
+            print("%12.3f %4d %9.3f MHz SF%-2d %6.1f dBm %5.1f dB  %s"
+                  % (t / 1e6, r["seq"], r["freq_khz"] / 1000.0, r["sf"], r["rssi"], r["snr"], describe(r)))
+        return 0
+    write_pcapng(argv[1], raw, ts)
+    frames = sum(1 for r in recs if not r["flags"] & (F_BOOT | F_CLOCK))
+    print("%d frames -> %s" % (frames, argv[1]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
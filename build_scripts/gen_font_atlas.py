@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Pre-rasterise the Adafruit_GFX fonts the firmware uses into byte-aligned 1bpp atlases.
+
+Adafruit_GFX stores glyph bitmaps as one continuous bit stream, so drawing text means one
+drawPixel() per set bit. The atlas re-packs every glyph row on a byte boundary (MSB = leftmost
+pixel) so font_blit.cpp can OR/AND whole rows into the frame with a shift.
+
+Usage (from the repo root):  python build_scripts/gen_font_atlas.py
+Writes main/font_atlas.h — commit the result; the Arduino build does not run Python.
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+FONT_DIR = os.path.join(ROOT, "libraries", "Adafruit-GFX-Library", "Fonts")
+OUT = os.path.join(ROOT, "main", "font_atlas.h")
+
+# Every font main/ passes to setFont()
+FONTS = ["FreeMonoBold9pt7b", "FreeMonoBold12pt7b", "Org_01"]
+
+
+def parse_font(name):
+    src = open(os.path.join(FONT_DIR, name + ".h"), encoding="latin-1").read()
+    bm = re.search(r"%sBitmaps\[\]\s*PROGMEM\s*=\s*\{(.*?)\};" % name, src, re.S).group(1)
+    bitmap = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]+", bm)]
+    gl = re.search(r"%sGlyphs\[\]\s*PROGMEM\s*=\s*\{(.*?)\};" % name, src, re.S).group(1)
+    glyphs = [tuple(int(v) for v in g)
+              for g in re.findall(r"\{\s*(-?\d+),\s*(-?\d+),\s*(-?\d+),\s*(-?\d+),\s*(-?\d+),\s*(-?\d+)\s*\}", gl)]
+    ft = re.search(r"GFXfont\s+%s\s+PROGMEM\s*=\s*\{.*?\(GFXglyph\s*\*\)\s*%sGlyphs,\s*(0x[0-9A-Fa-f]+|\d+),\s*(0x[0-9A-Fa-f]+|\d+),\s*(\d+)\s*\}"
+                   % (name, name), src, re.S)
+    first, last, y_adv = int(ft.group(1), 0), int(ft.group(2), 0), int(ft.group(3))
+    assert len(glyphs) == last - first + 1, name
+    return bitmap, glyphs, first, last, y_adv
+
+
+def signature(glyphs, first, last, y_adv):
+    # Must match fontSignature() in font_blit.cpp
+    h = 2166136261
+
+    def mix(b):
+        nonlocal h
+        h = ((h ^ (b & 0xFF)) * 16777619) & 0xFFFFFFFF
+
+    mix(first)
+    mix(last)
+    mix(y_adv)
+    for off, w, hh, xadv, xo, yo in glyphs:
+        for b in (off, off >> 8, w, hh, xadv, xo, yo):
+            mix(b)
+    return h
+
+
+def rasterise(bitmap, glyphs):
+    bits_out, entries = [], []
+    for off, w, h, xadv, xo, yo in glyphs:
+        stride = (w + 7) // 8
+        start = len(bits_out)
+        bit = off * 8
+        for _ in range(h):
+            row = [0] * stride
+            for x in range(w):
+                if bitmap[bit >> 3] & (0x80 >> (bit & 7)):
+                    row[x >> 3] |= 0x80 >> (x & 7)
+                bit += 1
+            bits_out.extend(row)
+        entries.append((start, w, h, stride, xadv, xo, yo))
+    return bits_out, entries
+
+
+def main():
+    out = []
+    out.append("// font_atlas.h — GENERATED by build_scripts/gen_font_atlas.py, do not edit")
+    out.append("// Byte-aligned 1bpp glyph rows for font_blit.cpp (included there only)")
+    out.append("")
+    out.append("#ifndef FONT_ATLAS_H")
+    out.append("#define FONT_ATLAS_H")
+    out.append("")
+    out.append('#include "font_blit.h"')
+    out.append("")
+    names = []
+    for name in FONTS:
+        bitmap, glyphs, first, last, y_adv = parse_font(name)
+        bits, entries = rasterise(bitmap, glyphs)
+        assert len(bits) < 65536, name
+        out.append("static const uint8_t %sAtlasBits[] = {" % name)
+        for i in range(0, len(bits), 16):
+            out.append("    " + " ".join("0x%02X," % b for b in bits[i:i + 16]))
+        out.append("};")
+        out.append("")
+        out.append("static const FontAtlasGlyph %sAtlasGlyphs[] = {" % name)
+        for c, (start, w, h, stride, xadv, xo, yo) in enumerate(entries):
+            out.append("    { %5d, %2d, %2d, %d, %2d, %3d, %3d },  // 0x%02X" % (start, w, h, stride, xadv, xo, yo, first + c))
+        out.append("};")
+        out.append("")
+        out.append("static const FontAtlas %sAtlas = {" % name)
+        out.append("    0x%08Xu, %sAtlasBits, %sAtlasGlyphs, 0x%02X, 0x%02X, %d" % (
+            signature(glyphs, first, last, y_adv), name, name, first, last, y_adv))
+        out.append("};")
+        out.append("")
+        names.append(name)
+    out.append("static const FontAtlas* const font_atlases[] = {")
+    for name in names:
+        out.append("    &%sAtlas," % name)
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    open(OUT, "w", newline="\n").write("\n".join(out) + "\n")
+    print("wrote %s (%d fonts)" % (os.path.relpath(OUT, ROOT), len(names)))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
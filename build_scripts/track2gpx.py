@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Decode a GPS track dump (TRKDUMP replies) into GPX 1.1.
+
+The firmware logs its track to the QSPI flash as delta/varint-coded blocks (main/track_log.h).
+Pull them over BLE with TRKDUMP, TRKDUMP:<NEXT>, ... and save the replies — one
+"OK{TRK:<first>:<hex>,...}" per line, other lines are ignored — then:
+
+    python build_scripts/track2gpx.py dump.txt track.gpx
+    python build_scripts/track2gpx.py dump.txt --text          # one point per line
+"""
+
+import re
+import struct
+import sys
+import time
+
+# Must match track_log.h
+HDR = struct.Struct("<BBHIiih")        # format flags points t0 lat0 lon0 alt0
+TRACK_FORMAT = 1
+B_SEGMENT = 0x01
+
+REPLY = re.compile(r"OK\{TRK:(\d+):([0-9A-Fa-f,]*)\}")
+
+
+def read_dump(path):
+    blocks = {}
+    for line in open(path, encoding="latin-1"):
+        for m in REPLY.finditer(line):
+            n = int(m.group(1))
+            for h in m.group(2).split(","):
+                if h:
+                    blocks[n] = bytes.fromhex(h)
+                n += 1
+    return [blocks[n] for n in sorted(blocks)]
+
+
+def varint(b, i):
+    v = shift = 0
+    while True:
+        c = b[i]
+        i += 1
+        v |= (c & 0x7F) << shift
+        shift += 7
+        if not c & 0x80:
+            return v, i
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def tdiv(a, b):
+    """C integer division (truncates toward zero)."""
+    q = abs(a) // abs(b)
+    return q if (a < 0) == (b < 0) else -q
+
+
+def decode_block(b):
+    """(starts_segment, [(t, lat_e6, lon_e6, alt_m)])"""
+    fmt, flags, points, t, lat, lon, alt = HDR.unpack_from(b)
+    if fmt != TRACK_FORMAT:
+        raise ValueError("unknown block format %d" % fmt)
+    out = [(t, lat, lon, alt)]
+    i, pdlat, pdlon, pdt = HDR.size, 0, 0, 0
+    while len(out) < points and i < len(b):
+        tag, i = varint(b, i)
+        dt = tag >> 1
+        rlat, i = varint(b, i)
+        rlon, i = varint(b, i)
+        dlat = unzigzag(rlat) + (tdiv(pdlat * dt, pdt) if pdt else 0)
+        dlon = unzigzag(rlon) + (tdiv(pdlon * dt, pdt) if pdt else 0)
+        if tag & 1:
+            dalt, i = varint(b, i)
+            alt += unzigzag(dalt)
+        t, lat, lon = t + dt, lat + dlat, lon + dlon
+        pdlat, pdlon, pdt = dlat, dlon, dt
+        out.append((t, lat, lon, alt))
+    return bool(flags & B_SEGMENT), out
+
+
+def segments(blocks):
+    segs = []
+    for b in blocks:
+        new, pts = decode_block(b)
+        if new or not segs:
+            segs.append([])
+        segs[-1].extend(pts)
+    return [s for s in segs if s]
+
+
+def iso(t):
+    return time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime(t))
+
+
+def write_gpx(path, segs):
+    with open(path, "w", encoding="utf-8") as f:
+        f.write('<?xml version="1.0" encoding="UTF-8"?>\n')
+        f.write('<gpx version="1.1" creator="T-Echo track_log" xmlns="http://www.topografix.com/GPX/1/1">\n')
+        f.write("  <trk>\n    <name>T-Echo %s</name>\n" % (iso(segs[0][0][0]) if segs else ""))
+        for s in segs:
+            f.write("    <trkseg>\n")
+            for t, lat, lon, alt in s:
+                f.write('      <trkpt lat="%.6f" lon="%.6f"><ele>%d</ele><time>%s</time></trkpt>\n'
+                        % (lat / 1e6, lon / 1e6, alt, iso(t)))
+            f.write("    </trkseg>\n")
+        f.write("  </trk>\n</gpx>\n")
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+    blocks = read_dump(argv[0])
+    segs = segments(blocks)
+    n = sum(len(s) for s in segs)
+    if argv[1] == "--text":
+        for k, s in enumerate(segs):
+            for t, lat, lon, alt in s:
+                print("%d %s %.6f %.6f %d" % (k, iso(t), lat / 1e6, lon / 1e6, alt))
+        return 0
+    write_gpx(argv[1], segs)
+    size = sum(len(b) for b in blocks)
+    print("%d points in %d segments, %d blocks, %.2f bytes/point -> %s"
+          % (n, len(segs), len(blocks), size / max(n, 1), argv[1]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
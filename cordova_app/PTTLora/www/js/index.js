@@ -1686,12 +1686,16 @@ var app = {
 			return;
 		}
 
-		// Handle Screen Mirror (LINE:S) — must use the unwrapped payload when NOTIF prefix was stripped
-		if (lineMatch && lineMatch[1] === 'S') {
+		// Handle Screen Mirror (LINE:S keyframe, LINE:SD delta) — must use the unwrapped payload when NOTIF prefix was stripped
+		if (lineMatch && (lineMatch[1] === 'S' || lineMatch[1] === 'SD')) {
 			var syncSource = (wrappedData.length > 0) ? wrappedData : message;
 			var syncData = syncSource.slice(lineMatch[0].length);
 			logMessage('SCREEN:MIRROR data=' + JSON.stringify(syncData).substring(0, 300));
-			app.renderScreenMirror(syncData, deviceName);
+			var syncSeq = app.renderScreenMirror(syncData, deviceName, lineMatch[1] === 'SD');
+			// Ack so the device can send only changed fields from now on
+			if (syncSeq) {
+				app.sendDataToDevice(deviceName, 'SYNCACK:' + syncSeq);
+			}
 			
 			// BLE liveness update from screen mirror — if the device sends screen data,
 			// BLE is confirmed alive. This serves as fallback when GETSTATUS responses
@@ -2366,6 +2370,7 @@ var app = {
     // === Screen Mirror Rendering ===
 
     _screenMirrorData: {},
+    _screenMirrorByDevice: {},   // Last full field set per device — deltas merge onto it
 
     parseScreenMirrorFields: function(data) {
         var fields = {};
@@ -2424,11 +2429,21 @@ var app = {
         return fields;
     },
 
-    renderScreenMirror: function(syncData, sourceDeviceName) {
+    renderScreenMirror: function(syncData, sourceDeviceName, isDelta) {
         if (!syncData) return;
         
         var fields = this.parseScreenMirrorFields(syncData);
+        var devKey = sourceDeviceName || '';
+        if (isDelta) {
+            // A delta only makes sense on top of a keyframe from the same device
+            var base = this._screenMirrorByDevice[devKey];
+            if (!base) return;
+            fields = Object.assign({}, base, fields);
+            delete fields['v:b'];
+        }
+        this._screenMirrorByDevice[devKey] = fields;
         this._screenMirrorData = fields;
+        var syncSeq = fields.v;
 
         // Determine which device this screen mirror came from
         var isTargetDevice = !sourceDeviceName || sourceDeviceName === app.targetDeviceName;
@@ -2438,7 +2453,7 @@ var app = {
         var chanSfEl = document.getElementById('screenChanSf');
         var contentArea = document.getElementById('screenContentArea');
 
-        if (!contentArea) return;
+        if (!contentArea) return syncSeq;
 
         // Clear refreshing state when screen data arrives from the target device
         if (isTargetDevice) {
@@ -2490,7 +2505,7 @@ var app = {
         } else {
             var srcShortId = this.getShortDeviceId(sourceDeviceName) || sourceDeviceName;
             logMessage(srcShortId + ' screen data received (non-target, ignoring)');
-            return; // Do not render non-target device data into the display section
+            return syncSeq; // Do not render non-target device data into the display section
         }
 
         // Update status bar
@@ -2746,6 +2761,7 @@ var app = {
         }
 
         contentArea.innerHTML = html;
+        return syncSeq;
     },
 
     _screenRow: function(text) {
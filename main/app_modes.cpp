@@ -12,6 +12,18 @@
 #include "screen_sync.h"
 #include "display_layout.h"  // For per-mode drawXxxLayout() wiring
 #include "disp_timer.h"
+#include "disp_dirty.h"
+#include "disp_budget.h"
+#include "buddy_list.h"
+#include "settings_store.h"
+#include "lora_capture.h"
+#include "track_log.h"
+#include "waypoint_store.h"
+#include "geodesy.h"
+#include "peer_roster.h"
+#include "epoch_clock.h"
+#include "mesh_relay.h"
+#include "retained_ram.h"
 
 // Extern for partial/full refresh control from display.cpp
 extern void forceFullRefresh();
@@ -47,8 +59,8 @@ static uint8_t txt_reassemble_expected, txt_reassemble_recv_count;
 static uint32_t txt_reassemble_timer;
 
 // TXT Mode Inbox display state
-uint8_t  txtInboxScrollPage = 0;
-uint8_t  txtInboxMsgCount = 0;
+uint16_t txtInboxScrollPage = 0;
+uint16_t txtInboxMsgCount = 0;
 bool     txtShowInbox = false;
 
 
@@ -99,6 +111,9 @@ static const char* s_pending_draw_mode = nullptr;  // Track which mode to redraw
 static bool s_display_rendering = false;       // True while inside a blocking draw call
 static bool s_dirty_screen = false;            // Dirty-draw queued for next flush cycle
 
+static void wpBroadcastTick(uint32_t now);
+static void beaconPickNearest();
+
 
 void switchMode(String receivedMode) {
     int newModeIndex = -1;
@@ -160,6 +175,7 @@ void handleAppModes() {
 
     if (currentPinState != lastPinState) {
         debounceTimestamp = millis();
+        dispBudgetActivity();
 
         if (currentPinState && !lastPinState) {
             btnState = BTN_STATE_PRESSING;
@@ -233,7 +249,7 @@ void handleAppModes() {
             // Handle non-display work from updMode()
             if (current_mode == "TST" || current_mode == "RAW" || current_mode == "TXT" ||
                 current_mode == "RANGE" || current_mode == "PONG" || current_mode == "SCAN" ||
-                current_mode == "BEACON") {
+                current_mode == "BEACON" || current_mode == "WP") {
                 setupLoRa();
             }
 
@@ -245,6 +261,7 @@ void handleAppModes() {
 
             // Now render — button is already released so no interference
             s_display_rendering = true;
+            uint32_t render_t0 = micros();
             if (strcmp(current_mode, "RANGE") == 0) drawRangeLayout();
             else if (strcmp(current_mode, "BEACON") == 0) drawBeaconLayout();
             else if (strcmp(current_mode, "PTT") == 0) drawPttLayout();
@@ -259,6 +276,7 @@ void handleAppModes() {
             else if (strcmp(current_mode, "RAW") == 0) drawRawLayout();
             else if (strcmp(current_mode, "WP") == 0) drawWpLayout();
             else drawDefaultLayout();
+            dispBudgetBlocked(micros() - render_t0);
             s_display_rendering = false;
 
             // Push the new mode + full screen state to the companion app immediately
@@ -273,10 +291,21 @@ void handleAppModes() {
 
     // ── Flush any dirty-draw display update (after button work is fully done) ──
     flushDisplayIfNeeded();
+    uint32_t pump_t0 = micros();
+    dispFramePump();
+    dispBudgetBlocked(micros() - pump_t0);
 
     checkLoraPacketComplete();
+    buddyTick(millis());
+    settingsStoreTick(millis());
+    capTick(millis());
+    wpBroadcastTick(millis());
+    rosterTick(millis());
+    clockTick(millis());
+    meshTick(millis());
 
     loopGPS();
+    trackTick(millis());
     sendScreenSyncIfDirty();
     //sendSerialToAppLn(F("[LOOP] loopAppModes END"));
 
@@ -397,26 +426,11 @@ void handleAppModes() {
         }
         
         else if (current_mode == "BEACON") {
-            // Find the closest peer with GPS for distance readout
-            double bestDist = -1;
-            String bestName;
-            unsigned long now = millis();
-            
-            for (int i = 0; i < peerRosterCount; i++) {
-                if (peerRoster[i].distanceM > 0 && peerRoster[i].distanceM < 50000) {
-                    if (bestDist < 0 || peerRoster[i].distanceM < bestDist) {
-                        bestDist = peerRoster[i].distanceM;
-                        const char* displayName = peerRoster[i].callSign[0] != '\0' ? peerRoster[i].callSign : peerRoster[i].deviceId.c_str();
-                        bestName = displayName;
-                    }
-                }
-            }
-            
-            // Update distance display if we have a valid peer
-            if (bestDist >= 0) {
-                beacon_display_dist = bestDist;
-                beacon_display_name = bestName;
-                beacon_last_distance_update = now;
+            // Closest peer for the distance readout — only read again when the roster changed
+            static uint32_t last_roster_rev = 0;
+            if (rosterRevision() != last_roster_rev) {
+                last_roster_rev = rosterRevision();
+                beaconPickNearest();
             }
             
             // Render BEACON layout via frame engine — only when peer data changes or every 3s
@@ -427,7 +441,31 @@ void handleAppModes() {
                 last_beacon_draw = millis();
                 last_beacon_dist = beacon_display_dist;
             }
-        }    
+        }
+        else if (current_mode == "WP") {
+            // Touch: broadcast our own position as a waypoint
+            if (debouncedTouchPress() && !wpBroadcastActive && gps_status == GPS_LOC) {
+                char label[WP_LABEL_LEN + 1];
+                snprintf(label, sizeof(label), "WP%u", (unsigned)wpStoreCount() + 1);
+                startWaypointBroadcast(gps_latitude, gps_longitude, gps_altitude, label);
+            }
+
+            // Show the stored waypoint nearest to us — only query again when the store or our position changed
+            static uint32_t last_wp_rev = 0;
+            static double last_wp_lat = 0, last_wp_lon = 0;
+            if (!wpBroadcastActive && (wpStoreRevision() != last_wp_rev ||
+                                       gps_latitude != last_wp_lat || gps_longitude != last_wp_lon)) {
+                last_wp_rev = wpStoreRevision();
+                last_wp_lat = gps_latitude;
+                last_wp_lon = gps_longitude;
+                const WaypointRecord* r = wpStoreGet(wpStoreNearest(gps_latitude, gps_longitude, nullptr));
+                layout_state.wp_lat = r ? r->lat_e6 * 1e-6 : 0;
+                layout_state.wp_lon = r ? r->lon_e6 * 1e-6 : 0;
+                layout_state.wp_alt = r ? r->alt_m : 0;
+                snprintf(layout_state.wp_label, sizeof(layout_state.wp_label), "%s", r ? r->label : "");
+                s_dirty_screen = true;
+            }
+        }
     }
 
     // Handle touch input in settings mode — one value change per touch press/release cycle
@@ -436,6 +474,7 @@ void handleAppModes() {
         uint8_t touch_state = digitalRead(TOUCH_PIN) ? 0 : 1;
         // Detect rising edge (pin goes HIGH on release) to trigger update
         if (!touch_state && last_touch_state) {
+            dispBudgetActivity();
             unsigned long currentTime = millis();
             if ((currentTime - lastTouchPressTime) > touchDebounceDelay) {
                 updateCurrentSetting();
@@ -446,18 +485,101 @@ void handleAppModes() {
     }
 }
 
+// ── Waypoint broadcast ──
+
+bool wpBroadcastActive = false;
+uint32_t wpBroadcastStartMs = 0;
+static uint32_t s_wp_last_tx_ms = 0;
+static uint16_t s_wp_bcast_slot = 0;
+
+void startWaypointBroadcast(double lat, double lon, float alt, const char* label) {
+    int slot = wpStoreAdd(lat, lon, alt, label, bleGetDeviceIdShort(), WP_F_OWN);
+    if (slot < 0) {
+        showError("wp store full");
+        return;
+    }
+    s_wp_bcast_slot = slot;
+    wpBroadcastActive = true;
+    wpBroadcastStartMs = millis();
+    s_wp_last_tx_ms = wpBroadcastStartMs - WP_BROADCAST_INTERVAL_MS;   // First one goes out on the next tick
+}
+
+static void wpBroadcastTick(uint32_t now) {
+    if (!wpBroadcastActive) return;
+    uint32_t elapsed = now - wpBroadcastStartMs;
+    if (elapsed >= WP_BROADCAST_DURATION_MS) {
+        wpBroadcastActive = false;
+        layout_state.wp_broadcasting = false;
+        layout_state.wp_bcast_remaining_s = 0;
+        s_dirty_screen = true;
+        return;
+    }
+    if (now - s_wp_last_tx_ms >= WP_BROADCAST_INTERVAL_MS) {
+        s_wp_last_tx_ms = now;
+        const WaypointRecord* r = wpStoreGet(s_wp_bcast_slot);
+        if (r) sendWaypointPacket(r->lat_e6 * 1e-6, r->lon_e6 * 1e-6, r->alt_m, r->label);
+    }
+    if (current_mode == "WP") {
+        const WaypointRecord* r = wpStoreGet(s_wp_bcast_slot);
+        uint32_t remaining = (WP_BROADCAST_DURATION_MS - elapsed + 999) / 1000;
+        if (r && (!layout_state.wp_broadcasting || remaining != layout_state.wp_bcast_remaining_s)) {
+            layout_state.wp_lat = r->lat_e6 * 1e-6;
+            layout_state.wp_lon = r->lon_e6 * 1e-6;
+            layout_state.wp_alt = r->alt_m;
+            snprintf(layout_state.wp_label, sizeof(layout_state.wp_label), "%s", r->label);
+            layout_state.wp_broadcasting = true;
+            layout_state.wp_bcast_remaining_s = remaining;
+            s_dirty_screen = true;
+        }
+    }
+}
+
+// Closest peer with a distance for the BEACON readout — first in the roster's order
+static void beaconPickNearest() {
+    const RosterPeer* p = rosterNearest(0);
+    if (!p || !(p->flags & ROSTER_F_DIST) || p->distanceM >= 50000) return;
+    beacon_display_dist = p->distanceM;
+    beacon_display_name = rosterName(p);
+    beacon_last_distance_update = millis();
+}
+
+// "~PP<packed>,<sender>,<label>" — the parser already decoded the position
+static void handleWaypointPacket(const Packet& packet) {
+    const char* content = packet.content.c_str();
+    const char* who = strchr(content, ',');
+    const char* label = who ? strchr(who + 1, ',') : nullptr;     // Keeps any further commas
+    if (strncmp(content, "~PP", 3) != 0 || !packet.has_pos || !label) {
+        sendSerialToAppLn(F("[WP] Malformed waypoint"));
+        return;
+    }
+    who++;
+    label++;
+    char sender[WP_SENDER_LEN];
+    size_t n = label - who - 1;
+    if (n > sizeof(sender) - 1) n = sizeof(sender) - 1;
+    memcpy(sender, who, n);
+    sender[n] = '\0';
+
+    if (strcmp(sender, bleGetDeviceIdShort()) == 0) return;     // Our own, relayed back
+    wpStoreAdd(packet.pos.lat, packet.pos.lon, packet.pos.alt_m, label, sender, 0);
+}
+
 void handlePacket(Packet packet) {
     if (packet.type == "REQ") {  // Request for retransmission
         unsigned int requestedCounter = atoi(packet.content.c_str()); 
         handleRetransmitRequest(requestedCounter);
         return;
     }
+    if (packet.type == "WAYPOINT") {  // Stored in every mode
+        handleWaypointPacket(packet);
+        return;
+    }
     if (packet.type == "NULL") {
       // Handle unknown packet type and show the raw message
       if (current_mode == "RAW") {
           strncpy(layout_state.raw_hex_line1, packet.content.c_str(), sizeof(layout_state.raw_hex_line1) - 1);
           layout_state.raw_hex_line1[sizeof(layout_state.raw_hex_line1) - 1] = '\0';
-          drawRawLayout();
+          deferDraw();
       }
     } 
     else {
@@ -466,27 +588,11 @@ void handlePacket(Packet packet) {
           // BEACON mode: add peer to roster and display it
           beaconAddOrUpdate(packet);
           
-          // Re-scan for closest peer with distance after adding/updating roster
-          double bestDist = -1;
-          String bestName;
-          for (int i = 0; i < peerRosterCount; i++) {
-              if (peerRoster[i].distanceM > 0 && peerRoster[i].distanceM < 50000) {
-                  if (bestDist < 0 || peerRoster[i].distanceM < bestDist) {
-                      bestDist = peerRoster[i].distanceM;
-                      const char* dn = peerRoster[i].callSign[0] != '\0' ? peerRoster[i].callSign : peerRoster[i].deviceId.c_str();
-                      bestName = dn;
-                  }
-              }
-          }
-          
-          // Update distance display immediately
-          if (bestDist >= 0) {
-              beacon_display_dist = bestDist;
-              beacon_display_name = bestName;
-          }
+          // The roster keeps its order — take the closest peer straight from it
+          beaconPickNearest();
           
-          // Render updated BEACON layout via frame engine
-          drawBeaconLayout();
+          // Render updated BEACON layout at the end of the loop
+          deferDraw();
       }
        else if (current_mode == "RAW" || current_mode == "TST") {
            //Cool of period to allow receiving of messages because of switching from sent to receive takes time
@@ -498,7 +604,7 @@ void handlePacket(Packet packet) {
                // Set raw layout state for drawRawLayout()
                strncpy(layout_state.raw_hex_line1, packet.content.c_str(), sizeof(layout_state.raw_hex_line1) - 1);
                layout_state.raw_hex_line1[sizeof(layout_state.raw_hex_line1) - 1] = '\0';
-               drawRawLayout();
+               deferDraw();
             } else {
                 // TST mode — update test counters for drawTstLayout()
                 layout_state.tst_sent = test_message_counter;
@@ -508,7 +614,7 @@ void handlePacket(Packet packet) {
                     layout_state.tst_last_snr = radio->getSNR();
                     layout_state.tst_last_time_on_air = timeOnAir;
                 }
-                drawTstLayout();
+                deferDraw();
             }
            markScreenDirty();
        } 
@@ -540,7 +646,7 @@ void handlePacket(Packet packet) {
                       
                       // Mark PTT RX state for drawPttLayout()
                       setPttRxActive(true);
-                      drawPttLayout();
+                      deferDraw();
                       
                       sendBinaryNotification(frame, 4 + opusLen);
                   }
@@ -554,8 +660,9 @@ void handlePacket(Packet packet) {
               inboxStore(bleGetDeviceIdShort(), 8, (const uint8_t*)packet.content.c_str(), packet.content.length());
               markScreenDirty();
               
-              // Render TXT single message view via frame engine
-              drawTxtSingleLayout();
+              // Show it in the single message view at the end of the loop
+              txtShowInbox = false;
+              deferDraw();
           }
       }
       else if (current_mode == "TXT" && packet.type == "TXT_MULTI") {
@@ -615,13 +722,13 @@ void handlePacket(Packet packet) {
           layout_state.pong_state = 2;  // received
           layout_state.pong_rtt_ms = 0;  // Set to actual RTT when available
           
-          drawPongLayout();
+          drawPongLayout();  // Rendered now so "received" is submitted before the state flips back
 
           sendSerialToApp(F("[SX1262] Sending another packet ... "));
           //Don't flood, just wait 3 seconds
           delay(1000);
           layout_state.pong_state = 1;  // sending again
-          drawPongLayout();
+          deferDraw();
           sendPacket("Ping!");
       } 
       else if (current_mode == "RANGE" && packet.type == "RANGE") {
@@ -669,7 +776,7 @@ void handlePacket(Packet packet) {
                       }
 
                       //Let's calculate the range
-                      double distance = TinyGPSPlus::distanceBetween(range_home_lat, range_home_long, gps_latitude, gps_longitude);
+                      double distance = geoFromOriginDistance(range_home_lat, range_home_long);
 
                       if(distance>0) {
                           if(range_max_dist < distance) {
@@ -690,7 +797,7 @@ void handlePacket(Packet packet) {
                       layout_state.range_last_snr = radio->getSNR();
                       layout_state.range_last_time_on_air = timeOnAir;
                   }
-                  drawRangeLayout();
+                  deferDraw();
 
               }
               else {
@@ -716,6 +823,7 @@ bool debouncedTouchPress() {
     if (currentState != touchButtonPressed) {
         // Button state has changed, reset the debounce timer
         lastTouchPressTime = currentTime;
+        dispBudgetActivity();
         touchButtonPressed = currentState;
     }
 
@@ -746,6 +854,13 @@ void setupAppModes() {
     btnState = BTN_STATE_IDLE;
     btnPressTime = 0;
     settingsToggled = false;
+
+    // Mount the message log now rather than on the first TXT access (replays one flash sector)
+    inboxInit();
+    buddyInit();
+    capInit();
+    trackInit();
+    wpStoreInit();
 }
 void powerOff() {
     // Power Off display message
@@ -756,6 +871,11 @@ void powerOff() {
     updDisp(4, "Powered Off..", false);
     updDisp(7, "Press reset button", false);
     updDisp(8, "to turn on.", true);
+    dispFrameFlush();  // Last frame must reach the panel before System OFF
+    buddyFlush();      // Pending directory pages — the batch timer won't run again
+    settingsStoreSave();
+    trackFlush();      // Open track block (up to TRACK_FLUSH_MS of points)
+    retainedCrashStreakEnd();  // Clean shutdown — the next boot starts a new crash streak
 
     //Make sure we turn of the backlight
     enableBacklight(false);
@@ -844,13 +964,15 @@ void sendTxtMessage(const char* message) {
 
     if (msgLen <= TXT_CHUNK_SIZE) {
         // Short message — send as a single packet (no chunking needed)
-        // Format: TX{channel}~GP{lat},{lon}~ST{datetime}message or TX{channel}message
+        // Format: TX{channel}~PP{packed position}~ST{datetime}message or TX{channel}message
         char send_pkt_buf[TXT_CHUNK_SIZE + 16 + 80];
         if (hasGPS) {
-            snprintf(send_pkt_buf, sizeof(send_pkt_buf), "TX%c~GP%.6f,%.6f~ST%s%s",
-                     channels[deviceSettings.channel_idx],
-                     gps_latitude, gps_longitude,
-                     getFormattedDateTime().c_str(), message);
+            char pp[POS_FIELD_MAX + 1];
+            char sd[CLOCK_SD_LEN + 1];
+            gpsPackPosition(0, false, -1, pp, sizeof(pp));
+            clockFormatSD(sd, sizeof(sd));
+            snprintf(send_pkt_buf, sizeof(send_pkt_buf), "TX%c~PP%s~ST%s%s",
+                     channels[deviceSettings.channel_idx], pp, sd, message);
         } else {
             snprintf(send_pkt_buf, sizeof(send_pkt_buf), "TX%c%s", channels[deviceSettings.channel_idx], message);
         }
@@ -866,11 +988,7 @@ void sendTxtMessage(const char* message) {
         delay(100);
         
         // Only render TXT layout if we're actually in TXT mode (TST doesn't need it)
-        if (current_mode == "TXT") {
-            extern bool txtShowInbox;
-            if (txtShowInbox) drawTxtInboxLayout();
-            else drawTxtSingleLayout();
-        }
+        if (current_mode == "TXT") deferDraw();
     } else {
         // Long message — split into chunks with TXM multi-packet header
         int numChunks = (msgLen + TXT_CHUNK_SIZE - 1) / TXT_CHUNK_SIZE;
@@ -886,13 +1004,16 @@ void sendTxtMessage(const char* message) {
             int remaining = msgLen - offset;
             int chunkLen = (remaining < TXT_CHUNK_SIZE) ? remaining : TXT_CHUNK_SIZE;
 
-            // Format: TXM{channel}{seq}/{total}~GP{lat},{lon}~ST{datetime}~{content}
+            // Format: TXM{channel}{seq}/{total}~PP{packed position}~ST{datetime}~{content}
+            // The first chunk carries the full position, the others a delta from it
             char send_pkt_buf[MAX_PACKET_SIZE];
             if (hasGPS) {
-                snprintf(send_pkt_buf, sizeof(send_pkt_buf), "TXM%c%d/%d~GP%.6f,%.6f~ST%s~",
-                         channels[deviceSettings.channel_idx], i + 1, numChunks,
-                         gps_latitude, gps_longitude,
-                         getFormattedDateTime().c_str());
+                char pp[POS_FIELD_MAX + 1];
+                char sd[CLOCK_SD_LEN + 1];
+                gpsPackPosition(0, i > 0, -1, pp, sizeof(pp));
+                clockFormatSD(sd, sizeof(sd));
+                snprintf(send_pkt_buf, sizeof(send_pkt_buf), "TXM%c%d/%d~PP%s~ST%s~",
+                         channels[deviceSettings.channel_idx], i + 1, numChunks, pp, sd);
             } else {
                 snprintf(send_pkt_buf, sizeof(send_pkt_buf), "TXM%c%d/%d~",
                          channels[deviceSettings.channel_idx], i + 1, numChunks);
@@ -908,13 +1029,8 @@ void sendTxtMessage(const char* message) {
                 char chunkDisplay[32];
                 snprintf(chunkDisplay, sizeof(chunkDisplay), "%d/%d", i + 1, numChunks);
                 
-                // Update TXT inbox count and render
+                // Update TXT inbox count; rendered once at the end of the loop
                 txtInboxMsgCount = inboxCount();
-                {
-                    extern bool txtShowInbox;
-                    if (txtShowInbox) drawTxtInboxLayout();
-                    else drawTxtSingleLayout();
-                }
             }
 
             // Brief gap between chunks to avoid radio contention
@@ -925,11 +1041,7 @@ void sendTxtMessage(const char* message) {
 
         // Final TXT layout render after all chunks sent
         txtInboxMsgCount = inboxCount();
-        {
-            extern bool txtShowInbox;
-            if (txtShowInbox) drawTxtInboxLayout();
-            else drawTxtSingleLayout();
-        }
+        if (current_mode == "TXT") deferDraw();
     }
 }
 
@@ -947,20 +1059,14 @@ void sendTestMessage(bool now) {
         // Update mode and channel display after sending
         sendTestMessageTimer = millis();
 
-        // Restore the correct per-mode layout — sendTxtMessage() renders TXT layout
-        // which would flash on screen while in other modes (e.g., TST)
+        // Refresh the per-mode layout with the new counters at the end of the loop
         if (current_mode == "TST") {
             layout_state.tst_sent = test_message_counter;
             layout_state.tst_rcvd = pckt_count;
-            drawTstLayout();
-        } else if (current_mode == "RAW") {
-            drawRawLayout();
         } else if (current_mode == "RANGE") {
             layout_state.range_sender = range_role_sender;
-            drawRangeLayout();
-        } else {
-            drawDefaultLayout();
         }
+        deferDraw();
     }
 }
 
@@ -983,7 +1089,7 @@ void turnoffLed(){
 // ============================================================
 
 void txtModeInboxDisplay() {
-    uint8_t msg_count = inboxCount();
+    uint16_t msg_count = inboxCount();
     if (msg_count == 0) {
         // No messages in inbox — render empty state
         layout_state.mode = current_mode;
@@ -14,26 +14,11 @@ extern double range_home_long;
 
 void sendTxtMessage(const char* message);
 
-// Waypoint storage in RTC RAM (same region as text inbox)
-#define WP_RTC_START 0x200075C0
-#define WP_MAX_ENTRIES 8
-#define WP_MAX_LABEL 24
-struct WaypointEntry {
-    double lat;
-    double lon;
-    float  alt;
-    char   label[WP_MAX_LABEL + 1];
-    String senderId;
-    uint32_t timestamp; // RTC seconds stored in RTC RAM
-    bool valid;
-};
-extern WaypointEntry wpStoredWaypoints[WP_MAX_ENTRIES];
-extern int     wpStoredCount;
-
-// Waypoint broadcast
+// Waypoint broadcast — received and own waypoints are kept in waypoint_store.h
 extern bool wpBroadcastActive;
 extern uint32_t wpBroadcastStartMs;
 
+// Stores the waypoint as our own and sends it every WP_BROADCAST_INTERVAL_MS for WP_BROADCAST_DURATION_MS
 void startWaypointBroadcast(double lat, double lon, float alt, const char* label);
 
 // Core mode functions
@@ -59,8 +44,8 @@ extern String beacon_display_name;
 extern unsigned long beacon_last_distance_update;
 
 // Text inbox display state (TXT mode)
-extern uint8_t  txtInboxScrollPage;
-extern uint8_t  txtInboxMsgCount;
+extern uint16_t txtInboxScrollPage;
+extern uint16_t txtInboxMsgCount;
 extern bool     txtShowInbox;       // true = showing inbox, false = showing single latest
 
 // TST test message counters
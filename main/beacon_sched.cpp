@@ -0,0 +1,94 @@
+// beacon_sched.cpp — SmartBeaconing rate, turn / drift triggers, advertised interval
+
+#include "beacon_sched.h"
+#include "lora.h"
+#include "gps.h"
+#include "geodesy.h"
+#include <math.h>
+
+// Where and how we were at the last beacon
+static struct {
+    double lat, lon;
+    float  course;
+    bool   moving;          // course is meaningful
+    bool   valid;           // had a fix
+} s_ref;
+
+static uint32_t s_interval_ms = PEER_BEACON_INTERVAL;  // Advertised by the last beacon
+
+// Stats
+static uint32_t s_sent = 0;
+static uint32_t s_by_time = 0;
+static uint32_t s_by_turn = 0;
+static uint32_t s_by_drift = 0;
+static float    s_turn_deg = 0;
+static float    s_moved_m = 0;
+
+static uint32_t rateNow() {
+    if (gps_status != GPS_LOC) return PEER_BEACON_INTERVAL;
+    float v = gps_speed_mps;
+    if (v < BCN_SLOW_MPS) return BCN_SLOW_RATE_MS;
+    if (v >= BCN_FAST_MPS) return BCN_FAST_RATE_MS;
+    uint32_t rate = (uint32_t)(BCN_FAST_RATE_MS * (BCN_FAST_MPS / v));
+    return rate > BCN_SLOW_RATE_MS ? BCN_SLOW_RATE_MS : rate;
+}
+
+// 0..180
+static float courseDelta(float a, float b) {
+    return fabsf(fmodf(a - b + 540.0f, 360.0f) - 180.0f);
+}
+
+bool bcnDue(uint32_t now, uint32_t last_tx_ms) {
+    uint32_t since = now - last_tx_ms;
+    uint32_t rate = rateNow();
+    // Speeding up shortens the wait at once; slowing down only takes effect after this beacon
+    if (since >= (rate < s_interval_ms ? rate : s_interval_ms)) {
+        s_by_time++;
+        return true;
+    }
+    if (since < BCN_MIN_GAP_MS || gps_status != GPS_LOC || !s_ref.valid) return false;
+
+    if (gps_speed_mps >= BCN_SLOW_MPS) {
+        if (!s_ref.moving) return false;
+        s_turn_deg = courseDelta(gps_course, s_ref.course);
+        if (s_turn_deg >= BCN_TURN_MIN_DEG + BCN_TURN_SLOPE / gps_speed_mps) {
+            s_by_turn++;
+            return true;
+        }
+    } else {
+        // The speed says standing still — catch a slow walk the speed over ground misses
+        s_moved_m = geoDistance(s_ref.lat, s_ref.lon, gps_latitude, gps_longitude);
+        if (s_moved_m >= BCN_DRIFT_M) {
+            s_by_drift++;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t bcnCommit() {
+    s_interval_ms = rateNow();
+    s_ref.valid = gps_status == GPS_LOC;
+    if (s_ref.valid) {
+        s_ref.lat = gps_latitude;
+        s_ref.lon = gps_longitude;
+        s_ref.course = gps_course;
+        s_ref.moving = gps_speed_mps >= BCN_SLOW_MPS;
+    }
+    s_turn_deg = 0;
+    s_moved_m = 0;
+    s_sent++;
+    return (uint16_t)((s_interval_ms + 999) / 1000);   // Round up — never promise too early
+}
+
+uint32_t bcnPeerTimeoutMs(uint16_t interval_s, uint32_t fallback_ms) {
+    if (interval_s == 0) return fallback_ms;    // Older firmware, fixed rate
+    return (uint32_t)interval_s * 1000 * BCN_TIMEOUT_BEACONS + BCN_TIMEOUT_SLACK_MS;
+}
+
+int bcnFormatStats(char* out, size_t out_len) {
+    return snprintf(out, out_len,
+                    "OK{BCNSTATS:iv_s=%lu,sent=%lu,time=%lu,turn=%lu,drift=%lu,speed=%.1f,turn_deg=%.0f,moved_m=%.0f}",
+                    (unsigned long)(s_interval_ms / 1000), (unsigned long)s_sent, (unsigned long)s_by_time,
+                    (unsigned long)s_by_turn, (unsigned long)s_by_drift, gps_speed_mps, s_turn_deg, s_moved_m);
+}
@@ -0,0 +1,42 @@
+// beacon_sched.h — SmartBeaconing: peer beacon interval from speed, course change and distance
+
+#ifndef BEACON_SCHED_H
+#define BEACON_SCHED_H
+
+#include <Arduino.h>
+
+// The beacon rate follows movement instead of a fixed PEER_BEACON_INTERVAL:
+//
+//   stationary   speed < BCN_SLOW_MPS       every BCN_SLOW_RATE_MS, or once we have drifted
+//                                           BCN_DRIFT_M from the last beacon (creeping, speed lost)
+//   moving       BCN_FAST_RATE_MS x BCN_FAST_MPS / speed, clamped to the two rates
+//   turning      course changed by BCN_TURN_MIN_DEG + BCN_TURN_SLOPE / speed since the last
+//                beacon — beacon right away, at most every BCN_MIN_GAP_MS
+//   no fix       PEER_BEACON_INTERVAL, as before
+//
+// Every beacon advertises its interval as ~BI<seconds>. The next one never comes later than that
+// (a faster rate applies at once, a slower one only from the next beacon), so receivers time the
+// peer out after BCN_TIMEOUT_BEACONS missed beacons rather than after a fixed PEER_TIMEOUT.
+
+#define BCN_SLOW_MPS            1.0f        // Below this we are standing still
+#define BCN_FAST_MPS            14.0f       // ~50 km/h — BCN_FAST_RATE_MS from here up
+#define BCN_SLOW_RATE_MS        600000
+#define BCN_FAST_RATE_MS        30000
+#define BCN_TURN_MIN_DEG        25.0f
+#define BCN_TURN_SLOPE          60.0f       // deg x m/s — 55° at walking pace, 29° at BCN_FAST_MPS
+#define BCN_MIN_GAP_MS          15000       // Turn / drift beacons never come closer than this
+#define BCN_DRIFT_M             250.0f
+#define BCN_TIMEOUT_BEACONS     2           // A peer is gone after this many missed beacons
+#define BCN_TIMEOUT_SLACK_MS    10000       // Plus airtime, hop wait, loop latency
+
+// Loop context. last_tx_ms: our last beacon or probe on the air
+bool bcnDue(uint32_t now, uint32_t last_tx_ms);
+// sendPeerBeacon() — takes the current fix as the new reference, returns the ~BI value (seconds)
+uint16_t bcnCommit();
+// Liveness timeout for a peer that advertised interval_s, PEER_TIMEOUT-style fallback when 0
+uint32_t bcnPeerTimeoutMs(uint16_t interval_s, uint32_t fallback_ms);
+
+// "OK{BCNSTATS:iv_s=..,sent=..,time=..,turn=..,drift=..,speed=..,turn_deg=..,moved_m=..}"
+int bcnFormatStats(char* out, size_t out_len);
+
+#endif
@@ -5,6 +5,9 @@
 #include "app_modes.h"
 #include "buddy_list.h"
 #include "display_layout.h"
+#include "ble_proto.h"
+#include "screen_sync.h"
+#include "ble_cmd.h"
 
 // Create BLE service and characteristic
 BLEService bleService("1235");
@@ -13,6 +16,7 @@ BLECharacteristic bleCharacteristic("ABCE");
 void onCharacteristicWritten(uint16_t conn_handle, BLECharacteristic* chr, uint8_t* data, uint16_t len);
 void onConnect(uint16_t conn_handle);
 void onDisconnect(uint16_t conn_handle, uint8_t reason);
+static void onBleEvent(ble_evt_t* evt);
 
 // Renamed helper function to check if the data contains printable characters
 bool isDataPrintable(const uint8_t* data, int length);
@@ -31,35 +35,9 @@ volatile bool cccd_subscribed = false;
 // Deferred display update flag — avoids calling display functions inside SoftDevice callback context
 static volatile bool pending_display_update = false;
 
-// High-priority notification queue — screen sync, binary audio, fragmented notifications (drops when full)
-static char notif_queue[4][320];
-static uint8_t notif_queue_len[4];
-static uint8_t notif_head = 0;
-static uint8_t notif_tail = 0;
-static volatile bool notif_queue_empty = true;
-
-// Low-priority notification queue — serial log / debug messages (drops when full)
-#define NOTIF_LOW_QUEUE_SIZE 16
-#define NOTIF_LOW_SLOT_SIZE 320
-static char notif_low_queue[NOTIF_LOW_QUEUE_SIZE][NOTIF_LOW_SLOT_SIZE];
-static uint8_t notif_low_queue_len[NOTIF_LOW_QUEUE_SIZE];
-static uint8_t notif_low_head = 0;
-static uint8_t notif_low_tail = 0;
-static volatile bool notif_low_queue_empty = true;
-
 // Track if we're inside the write callback — prevents SoftDevice deadlock
 static volatile bool in_write_callback = false;
 
-// Fragmented notification queue — holds split payloads for multi-MTU messages
-// Each item: "LINE:BLOB|S{seq}|T{total}|<data>~~" (header) or "LINE:BLOB|S{seq}|<data>~~" (continuation)
-#define BLOB_4 32
-#define NOTIF_SLOT_SIZE 320
-static char blob_notif_queue[BLOB_4][NOTIF_SLOT_SIZE];
-static uint8_t blob_notif_len[BLOB_4];
-static uint8_t blob_notif_head = 0;
-static uint8_t blob_notif_tail = 0;
-static volatile bool blob_notif_empty = true;
-
 // Stall queue/drain processing during connection handshake — SoftDevice needs time to stabilize
 uint32_t ble_connect_stall_until = 0;
 #define BLE_CONNECT_STALL_MS 800
@@ -75,100 +53,360 @@ static volatile bool drain_failed = false;
 static uint32_t drain_fail_start = 0;
 static uint32_t drain_stall_until = 0;
 #define DRAIN_FAIL_TIMEOUT_MS   1500    // Clear stale items after 1.5s of persistent failures
-#define DRAIN_STALL_MS          3000    // Silent stall for 3s after first failure
+#define DRAIN_BACKOFF_MS        50      // Short retry backoff after a refused notify()
 
-// Maximum BLE ATT MTU we should send per notification (negotiated with central)
+// Maximum BLE ATT MTU we request; the notify payload is the negotiated MTU minus 3 (ATT header)
 #define MAX_BLE_MTU 247
+#define ATT_HDR_LEN 3
+
+// Notification credits — one per SoftDevice HVN TX buffer. notify() only runs while a credit
+// is available, and BLE_GATTS_EVT_HVN_TX_COMPLETE hands credits back as packets leave the air,
+// so the drain is paced by the link instead of by notify() failures. The loop takes credits and
+// the BLE task returns them, so both sides update with __atomic read-modify-writes. The SoftDevice
+// reports every buffer it sends while connected; buffers still queued at a disconnect are dropped
+// with the link, and onConnect() starts the count over.
+#define BLE_HVN_TX_QUEUE        6
+static volatile uint8_t ble_credits = BLE_HVN_TX_QUEUE;
+static volatile uint8_t ble_tx_phy = BLE_GAP_PHY_1MBPS;
 
 // Notification string buffer size: PREFIX(16) + payload(230) + ~~(2) + margin = 252
 // Used by both sendSerialToApp() and sendNotificationToApp()
 #define NOTIF_STR_MAX_LEN (16 + 230 + 2 + 4)
 
-// Map Nordic softdevice error codes to human-readable names
-static const char* bleErrorName(int32_t err) {
-    switch ((uint32_t)err) {
-        case 0:        return "ERROR_NONE";
-        case 1:        return "NRF_ERROR_SVC_HANDLER_ALLOC_FAILED (unhandled BLE write)";
-        case 0x10001:  return "NRF_ERROR_SVC_HANDLER_ALLOC_FAILED";
-        case 0x10002:  return "NRF_ERROR_SOFTDEVICE_NOT_PRESENT";
-        case 0x10003:  return "NRF_ERROR_STACK_SIZE";
-        case 0x2001:   return "NRF_ERROR_INVALID_ADDR";
-        case 0x2002:   return "NRF_ERROR_NULL";
-        case 0x2003:   return "NRF_ERROR_INVALID_PARAM";
-        case 0x2004:   return "NRF_ERROR_INVALID_STATE";
-        case 0x2005:   return "NRF_ERROR_INVALID_LENGTH";
-        case 0x2006:   return "NRF_ERROR_INVALID_FLAGS";
-        case 0x2007:   return "NRF_ERROR_INVALID_DATA";
-        case 0x200B:   return "NRF_ERROR_NO_MEM";      // No memory available
-        case 0x3001:   return "NRF_ERROR_BUSY";
-        case 0x3008:   return "BLE_ERROR_INVALID_DB_IDX";
-        case 0x3009:   return "BLE_ERROR_INVALID_CONN_HANDLE";
-        case 0x300A:   return "BLE_ERROR_ATTR_DATA_SIZE"; // Attribute data too small
-        case 0x300B:   return "BLE_ERROR_UNSUPPORTED_PRF";
-        case 0x300C:   return "BLE_ERROR_INVALID_ADDR";
-        case 0x4001:   return "NRF_ERROR_COMMUNICATION";
-        default:       return "UNKNOWN_ERR";
-    }
-}
-
-// Fragmented notification — each fragment carries exactly 64 bytes of raw message data.
-// Fragment format: "LINE:BLOB|S{seq}|<raw_data>~~" (~79 bytes total per fragment)
-#define BLOB_4 32 // slots for fragmented items
-
-// Deferred screen sync — avoid dropping in write callback (in_write_callback causes sendNotificationToApp to return immediately)
-static volatile bool pending_screen_sync = false;
-
 // Extern for sendSerialToAppLn in screen_sync.cpp — used by drain failure logging
 extern void sendSerialToAppLn(const String& msg);
 
-// Binary notification queue for Opus frames (raw bytes, no text wrapping)
-#define BINARY_NOTIF_QUEUE_SIZE 4
-static uint8_t bin_notif_queue[BINARY_NOTIF_QUEUE_SIZE][128];
-static uint8_t bin_notif_len[BINARY_NOTIF_QUEUE_SIZE];
-static uint8_t bin_notif_head = 0;
-static uint8_t bin_notif_tail = 0;
+// ── Unified notification ring ─────────────────────────────────────────────
+// Every outbound notification (voice, high-priority text, blob fragments, serial log) lives
+// in one byte-packed ring of variable-length records:  [class:1][len:1][payload:len]
+// Records are appended at the head and drained by class priority, so a record in the middle
+// of the ring can be sent first — it is tombstoned (NQ_FLAG_DONE) and its bytes are reclaimed
+// once everything older than it has gone too. Per-class quotas stop one class (e.g. a serial
+// log burst) from starving the others; when the ring itself is full, a push may evict
+// lower-priority records sitting at the tail.
+#define NQ_RING_SIZE    6144
+#define NQ_HDR          2       // class byte + length byte
+#define NQ_FLAG_DONE    0x80    // Tombstone — record already sent or dropped
+#define NQ_FLAG_MARK    0x40    // Payload starts with a 4-byte enqueue timestamp (latency probe)
+#define NQ_FLAG_RAW     0x20    // Binary PRI record (TLV reply) — sent verbatim, no "~~"
+#define NQ_CLASS_MASK   0x03
+#define NQ_MARK_LEN     4
+
+// Drain priority order — lower value drains first
+enum NotifClass : uint8_t {
+    NQ_VOICE = 0,   // Binary Opus frames (raw bytes, no text wrapping)
+    NQ_PRI   = 1,   // Screen sync, command replies — LINE:NOTIF
+    NQ_BLOB  = 2,   // Fragments of multi-MTU messages — LINE:BLOB
+    NQ_LOW   = 3,   // Serial log / debug relay — LINE:SERIAL
+    NQ_CLASS_COUNT
+};
+
+// Per-class byte quotas (header included). They oversubscribe the ring on purpose:
+// classes are rarely all busy at once, and eviction by priority covers the rest.
+static const uint16_t nq_quota[NQ_CLASS_COUNT] = { 2560, 1536, 2560, 1024 };
+static const char* const nq_class_name[NQ_CLASS_COUNT] = { "VOICE", "PRI", "BLOB", "LOW" };
+
+static uint8_t  nq_ring[NQ_RING_SIZE];
+static uint16_t nq_head = 0;        // Next write offset
+static uint16_t nq_tail = 0;        // Oldest record (never a tombstone once reclaimed)
+static uint16_t nq_used = 0;        // Bytes between tail and head, tombstones included
+static uint16_t nq_class_bytes[NQ_CLASS_COUNT];
+static uint16_t nq_class_count[NQ_CLASS_COUNT];    // A voice quota holds hundreds of short Opus frames
+
+// The ring has producers in two tasks: the loop, and Bluefruit's callbacks (onConnect,
+// onDisconnect and the write callback run in the BLE task). Eviction, reclaim and re-basing
+// rewrite head/tail, so every access to the ring, its counters and the static message buffers
+// that feed it holds this lock. Recursive — the drain's refit pushes back into the ring.
+// Created in setupBLE(); until then only the loop task exists and the guard is a no-op.
+static SemaphoreHandle_t nq_mutex = nullptr;
+
+struct NqLock {
+    NqLock() { if (nq_mutex) xSemaphoreTakeRecursive(nq_mutex, portMAX_DELAY); }
+    ~NqLock() { if (nq_mutex) xSemaphoreGiveRecursive(nq_mutex); }
+};
+
+static void nqCopyIn(uint16_t off, const uint8_t* src, uint16_t n) {
+    uint16_t first = NQ_RING_SIZE - off;
+    if (first > n) first = n;
+    memcpy(nq_ring + off, src, first);
+    if (n > first) memcpy(nq_ring, src + first, n - first);
+}
 
-// Return count of pending notifications in queue (high-priority only — low-priority is background)
-int getPendingNotificationCount() {
-    if (notif_queue_empty) return 0;
-    int count = notif_head >= notif_tail ? (notif_head - notif_tail) : (4 - notif_tail + notif_head);
-    if (count == 0 && !notif_queue_empty) count = 4 - 1;
-    return count;
+static void nqCopyOut(uint16_t off, uint8_t* dst, uint16_t n) {
+    uint16_t first = NQ_RING_SIZE - off;
+    if (first > n) first = n;
+    memcpy(dst, nq_ring + off, first);
+    if (n > first) memcpy(dst + first, nq_ring, n - first);
 }
 
-static bool priQueueFull() {
-    uint8_t next = (notif_head + 1) % 4;
-    return next == notif_tail;
+static inline uint8_t nqRecLen(uint16_t off) {
+    return nq_ring[(off + 1) % NQ_RING_SIZE];
 }
 
-// Enqueue low-priority (serial/log) messages. Drops silently when full — never blocks high-priority slots.
-static bool enqueueLow(const char* msg) {
-    uint8_t next = (notif_low_head + 1) % NOTIF_LOW_QUEUE_SIZE;
-    if (next == notif_low_tail) return false;  // Drop silently when full
-    size_t len = strlen(msg);
-    if (len >= NOTIF_LOW_SLOT_SIZE - 1) return false;
-    memcpy(notif_low_queue[notif_low_head], msg, len + 1);
-    notif_low_queue_len[notif_low_head] = (uint8_t)(len + 1);
-    notif_low_head = next;
-    notif_low_queue_empty = false;
+// Advance the tail past tombstoned records so their bytes become free again
+static void nqReclaim() {
+    while (nq_used > 0 && (nq_ring[nq_tail] & NQ_FLAG_DONE)) {
+        uint16_t rec = NQ_HDR + nqRecLen(nq_tail);
+        nq_tail = (nq_tail + rec) % NQ_RING_SIZE;
+        nq_used -= rec;
+    }
+    if (nq_used == 0) { nq_head = 0; nq_tail = 0; }  // Re-base so the next burst is contiguous
+}
+
+// Mark a live record as consumed
+static void nqRetire(uint16_t off) {
+    uint8_t cls = nq_ring[off] & NQ_CLASS_MASK;
+    nq_ring[off] |= NQ_FLAG_DONE;
+    nq_class_bytes[cls] -= NQ_HDR + nqRecLen(off);
+    nq_class_count[cls]--;
+    nqReclaim();
+}
+
+// Append one record. Returns false when the class quota is spent or the ring is full of
+// equal-or-higher priority data — callers treat that as a drop, same as the old fixed queues.
+// A marked record carries its enqueue time so the drain can measure delivery latency.
+static bool nqPush(uint8_t cls, const uint8_t* data, size_t len, bool mark = false, bool raw = false) {
+    NqLock lock;
+    size_t stored = len + (mark ? NQ_MARK_LEN : 0);
+    if (len == 0 || stored > 255) return false;
+    uint16_t need = NQ_HDR + (uint16_t)stored;
+    if (nq_class_bytes[cls] + need > nq_quota[cls]) return false;
+
+    while (NQ_RING_SIZE - nq_used < need) {
+        if (nq_used == 0) return false;
+        uint8_t tailCls = nq_ring[nq_tail] & NQ_CLASS_MASK;
+        if (tailCls <= cls) return false;
+        nqRetire(nq_tail);  // Evict older, lower-priority record
+    }
+
+    uint8_t hdr[NQ_HDR] = { (uint8_t)(cls | (mark ? NQ_FLAG_MARK : 0) | (raw ? NQ_FLAG_RAW : 0)), (uint8_t)stored };
+    uint16_t off = nq_head;
+    nqCopyIn(off, hdr, NQ_HDR);
+    off = (off + NQ_HDR) % NQ_RING_SIZE;
+    if (mark) {
+        uint32_t now = millis();
+        nqCopyIn(off, (const uint8_t*)&now, NQ_MARK_LEN);
+        off = (off + NQ_MARK_LEN) % NQ_RING_SIZE;
+    }
+    nqCopyIn(off, data, (uint16_t)len);
+    nq_head = (nq_head + need) % NQ_RING_SIZE;
+    nq_used += need;
+    nq_class_bytes[cls] += need;
+    nq_class_count[cls]++;
     return true;
 }
 
+// Whether `count` records totalling `bytes` payload bytes would currently be accepted.
+// Lets multi-record messages (blob fragments) go in all-or-nothing. Only the run of
+// lower-priority records at the tail counts as reclaimable: nqPush() evicts from the tail and
+// stops at the first record it may not drop, however much lower-priority data sits behind it.
+static bool nqCanFit(uint8_t cls, size_t bytes, uint16_t count) {
+    uint32_t need = bytes + (uint32_t)count * NQ_HDR;
+    if (nq_class_bytes[cls] + need > nq_quota[cls]) return false;
+    uint32_t avail = NQ_RING_SIZE - nq_used;
+    uint16_t off = nq_tail;
+    uint16_t scanned = 0;
+    while (avail < need && scanned < nq_used) {
+        uint8_t hdr = nq_ring[off];
+        if (!(hdr & NQ_FLAG_DONE) && (hdr & NQ_CLASS_MASK) <= cls) break;
+        uint16_t rec = NQ_HDR + nqRecLen(off);
+        avail += rec;   // Evicted, or a tombstone reclaimed along with it
+        off = (off + rec) % NQ_RING_SIZE;
+        scanned += rec;
+    }
+    return need <= avail;
+}
+
+// Offset of the oldest live record of `cls`, or -1 if there is none
+static int32_t nqFindOldest(uint8_t cls) {
+    if (nq_class_count[cls] == 0) return -1;
+    uint16_t off = nq_tail;
+    uint16_t scanned = 0;
+    while (scanned < nq_used) {
+        uint8_t hdr = nq_ring[off];
+        if (!(hdr & NQ_FLAG_DONE) && (hdr & NQ_CLASS_MASK) == cls) return off;
+        uint16_t rec = NQ_HDR + nqRecLen(off);
+        off = (off + rec) % NQ_RING_SIZE;
+        scanned += rec;
+    }
+    return -1;
+}
+
+// Drop every pending record of one class (e.g. stale replies after disconnect)
+static void nqDropClass(uint8_t cls) {
+    NqLock lock;
+    int32_t off;
+    while ((off = nqFindOldest(cls)) >= 0) nqRetire((uint16_t)off);
+}
+
+// Live records of one class
+static uint16_t nqCount(uint8_t cls) {
+    NqLock lock;
+    return nq_class_count[cls];
+}
+
+// Return count of pending notifications in queue (high-priority only — low-priority is background)
+int getPendingNotificationCount() {
+    return nqCount(NQ_PRI);
+}
+
+// Enqueue low-priority (serial/log) messages. Drops silently when full — never blocks high-priority records.
+static bool enqueueLow(const char* msg) {
+    return nqPush(NQ_LOW, (const uint8_t*)msg, strlen(msg));
+}
+
 // Enqueue high-priority messages only. Returns false if full — no silent drop (caller must handle).
-static bool enqueue(const char* msg) {
-    if (priQueueFull()) return false;
-    size_t len = strlen(msg);
-    if (len >= NOTIF_SLOT_SIZE - 1) return false;
-    memcpy(notif_queue[notif_head], msg, len + 1);
-    notif_queue_len[notif_head] = (uint8_t)(len + 1);
-    notif_head = (notif_head + 1) % 4;
-    notif_queue_empty = false;
-    return true;
+static bool enqueue(const char* msg, bool mark = false) {
+    return nqPush(NQ_PRI, (const uint8_t*)msg, strlen(msg), mark);
+}
+
+// Largest notify payload the current link accepts: negotiated ATT MTU minus the 3-byte ATT header.
+// Falls back to the requested maximum while disconnected so queued records keep their size;
+// drainQueue() re-fits them if the next link negotiates less (nqRefit).
+static uint16_t blePayloadMax() {
+    uint16_t mtu = MAX_BLE_MTU;
+    if (ble_connected) {
+        BLEConnection* conn = Bluefruit.Connection(ble_active_conn_handle);
+        if (conn && conn->getMtu() > ATT_HDR_LEN) mtu = conn->getMtu();
+    }
+    if (mtu > MAX_BLE_MTU) mtu = MAX_BLE_MTU;
+    return mtu - ATT_HDR_LEN;
+}
+
+uint16_t bleNotifyPayloadMax() { return blePayloadMax(); }
+
+// Binary TLV replies ride the high-priority class but skip the text terminator
+bool sendRawNotification(const uint8_t* data, uint16_t len) {
+    if (!data || len == 0 || len > blePayloadMax()) return false;
+    return nqPush(NQ_PRI, data, len, false, true);
+}
+
+// ── Screen-sync delivery latency ──────────────────────────────────────────
+// Screen sync marks its last record; the drain records enqueue→notify latency for it.
+#define SYNC_LAT_SAMPLES 32
+static uint16_t sync_lat_ms[SYNC_LAT_SAMPLES];
+static uint8_t  sync_lat_idx = 0;
+static uint8_t  sync_lat_count = 0;
+static volatile bool nq_mark_next = false;
+
+void bleMarkNextNotification() { nq_mark_next = true; }
+
+static void recordSyncLatency(uint32_t ms) {
+    sync_lat_ms[sync_lat_idx] = ms > 0xFFFF ? 0xFFFF : (uint16_t)ms;
+    sync_lat_idx = (sync_lat_idx + 1) % SYNC_LAT_SAMPLES;
+    if (sync_lat_count < SYNC_LAT_SAMPLES) sync_lat_count++;
+}
+
+// Percentile over the last SYNC_LAT_SAMPLES deliveries (insertion sort — 32 entries at most)
+static uint16_t syncLatencyPercentile(uint8_t pct) {
+    if (sync_lat_count == 0) return 0;
+    uint16_t sorted[SYNC_LAT_SAMPLES];
+    for (uint8_t i = 0; i < sync_lat_count; i++) {
+        uint16_t v = sync_lat_ms[i];
+        int8_t j = i - 1;
+        while (j >= 0 && sorted[j] > v) { sorted[j + 1] = sorted[j]; j--; }
+        sorted[j + 1] = v;
+    }
+    uint8_t rank = (uint8_t)(((uint16_t)pct * (sync_lat_count - 1) + 50) / 100);
+    return sorted[rank];
 }
 
-// Drain all pending text notifications — handles both regular queue and blob fragments
+static bool enqueueFragmented(const char* message, bool mark);
+
+// ── Re-fit after an MTU change ──
+// Records queued while disconnected were sized for MAX_BLE_MTU. When the next link negotiates
+// less, cutting them at the drain would put a truncated message on the wire, so the drain hands
+// them here: a notification, or a blob rebuilt from its fragments, goes back through
+// enqueueFragmented() at the current size; a serial line is split into several. Voice, TLV and
+// bench records have no framing to split at and are dropped whole. The rebuilt records go in at
+// the head, behind anything queued since the connect.
+#define NQ_REFIT_MAX    2560    // nq_quota[NQ_BLOB] — the longest blob the ring can hold
+
+static char nq_refit_msg[NQ_REFIT_MAX + 1];
+static uint16_t nq_refit_offs[255];
+
+static void nqRefit(uint16_t off, uint16_t payloadMax) {
+    uint8_t hdr = nq_ring[off];
+    uint8_t cls = hdr & NQ_CLASS_MASK;
+    uint16_t skip = (hdr & NQ_FLAG_MARK) ? NQ_MARK_LEN : 0;
+    uint16_t len = nqRecLen(off) - skip;
+    char rec[256];
+    nqCopyOut((off + NQ_HDR + skip) % NQ_RING_SIZE, (uint8_t*)rec, len);
+    rec[len] = '\0';
+
+    if (cls == NQ_LOW && !(hdr & NQ_FLAG_RAW)) {
+        // "LINE:SERIAL|DATA:" on every piece; the drain appends "~~"
+        nqRetire(off);
+        const char* data = strstr(rec, "|DATA:");
+        uint16_t pre = data ? (uint16_t)(data - rec) + 6 : 0;
+        if (pre + 2 >= payloadMax) return;
+        uint16_t chunk = payloadMax - 2 - pre;
+        char piece[MAX_BLE_MTU];
+        memcpy(piece, rec, pre);
+        for (uint16_t p = pre; p < len; p += chunk) {
+            uint16_t n = len - p < chunk ? len - p : chunk;
+            memcpy(piece + pre, rec + p, n);
+            if (!nqPush(NQ_LOW, (const uint8_t*)piece, pre + n)) break;
+        }
+        return;
+    }
+
+    if (cls == NQ_PRI && !(hdr & NQ_FLAG_RAW) && strncmp(rec, "LINE:NOTIF|DATA:", 16) == 0) {
+        bool mark = hdr & NQ_FLAG_MARK;
+        nqRetire(off);
+        if (len >= 18 && rec[len - 2] == '~' && rec[len - 1] == '~') rec[len - 2] = '\0';
+        if (!enqueueFragmented(rec + 16, mark)) SerialMon.println(F("[BLE] refit: notification dropped"));
+        return;
+    }
+
+    if (cls != NQ_BLOB || strncmp(rec, "LINE:BLOB|S0|", 13) != 0) {
+        // Binary, bench filler, or the rest of a blob whose head went out on the last link
+        nqRetire(off);
+        return;
+    }
+
+    // S0, S1, ... in ring order up to the next blob's S0
+    uint16_t count = 0;
+    size_t msgLen = 0;
+    bool mark = false;
+    uint16_t at = off;
+    uint16_t scanned = (uint16_t)((off + NQ_RING_SIZE - nq_tail) % NQ_RING_SIZE);
+    while (scanned < nq_used && count < 255) {
+        uint8_t h = nq_ring[at];
+        uint16_t rec_len = nqRecLen(at);
+        if (!(h & NQ_FLAG_DONE) && (h & NQ_CLASS_MASK) == NQ_BLOB) {
+            uint16_t h_skip = (h & NQ_FLAG_MARK) ? NQ_MARK_LEN : 0;
+            uint16_t n = rec_len - h_skip;
+            nqCopyOut((at + NQ_HDR + h_skip) % NQ_RING_SIZE, (uint8_t*)rec, n);
+            rec[n] = '\0';
+            char prefix[16];
+            int pre = snprintf(prefix, sizeof(prefix), "LINE:BLOB|S%u|", count);
+            if (strncmp(rec, prefix, pre) != 0 || n < pre + 2) break;
+            size_t dataLen = n - pre - 2;           // Fragments end in "~~"
+            if (msgLen + dataLen > NQ_REFIT_MAX) break;
+            memcpy(nq_refit_msg + msgLen, rec + pre, dataLen);
+            msgLen += dataLen;
+            nq_refit_offs[count++] = at;
+            if (h & NQ_FLAG_MARK) {                 // Only the last fragment of a blob is marked
+                mark = true;
+                break;
+            }
+        }
+        at = (at + NQ_HDR + rec_len) % NQ_RING_SIZE;
+        scanned += NQ_HDR + rec_len;
+    }
+    nq_refit_msg[msgLen] = '\0';
+    for (uint16_t i = 0; i < count; i++) nqRetire(nq_refit_offs[i]);
+    if (!enqueueFragmented(nq_refit_msg, mark)) SerialMon.println(F("[BLE] refit: blob dropped"));
+}
+
+// Drain pending notifications in class priority order: voice -> high-priority -> blob -> low-priority.
+// Sends as long as HVN credits last, so each call fills the SoftDevice TX queue and no more.
 static void drainQueue() {
-    if (notif_queue_empty && blob_notif_empty && notif_low_queue_empty) return;
+    // Held across notify() too: a credit is in hand, so it takes an HVN buffer without waiting
+    // on the BLE task
+    NqLock lock;
+    if (nq_used == 0) return;
 
     // Stall silently during connection handshake — SoftDevice needs time to stabilize
     if (millis() < ble_connect_stall_until) return;
@@ -190,343 +428,208 @@ static void drainQueue() {
     if (post_stall_wait_until > 0 && millis() >= post_stall_wait_until) {
         post_stall_wait_until = 0;
     }
-    
-    // Stall silently after drain failure — prevents hammering notify() when central can't keep up
-    if (drain_failed && millis() < drain_stall_until) return;
-
-    // Clear stale stall state if timeout expired and CCCD is now subscribed again
-    if (drain_failed && millis() >= drain_stall_until) {
-        if (cccd_subscribed) {
-            drain_failed = false;
-            drain_stall_until = 0;
-            drain_fail_start = 0;
-        } else {
-            // Still no CCCD — pause draining but keep queued items intact.
-            // The phone app will write CCCD at some point, and the next drain cycle will send them.
-            return;
-        }
-    }
-
-    // Drain all pending items — don't limit to 1 per call.
-    // Priority order: blob fragments -> high-priority notifications -> low-priority notifications
-    uint8_t iter = 0;
-    
-    while (!notif_queue_empty || !blob_notif_empty || !notif_low_queue_empty) {
-        if (iter++ > 40) { SerialMon.println(F("[BLE] drainQueue: infinite loop detected, breaking")); break; }
-
-        // Prefer blob fragments when available (time-sensitive screen updates)
-        bool useBlob = !blob_notif_empty && notif_queue_empty && notif_low_queue_empty;
-        
-        // Use low-priority queue only when high queues are empty
-        bool useLow = notif_low_queue_empty ? false : (!notif_queue_empty ? false : !blob_notif_empty ? false : true);
-        
-        uint8_t buffer[MAX_BLE_MTU];
-        uint8_t msg_len;
-        size_t total;
-        uint8_t idx;
-        bool drained = false;
-        
-        if (useBlob) {
-            msg_len = blob_notif_len[blob_notif_tail];
-            total = msg_len + 2; // +2 for "~~"
-            
-            // Clamp payload to max BLE MTU
-            if (total > MAX_BLE_MTU) {
-                msg_len = (uint8_t)(MAX_BLE_MTU - 2);
-                total = msg_len + 2;
-            }
 
-            if (msg_len == 0) {
-                blob_notif_empty = true;
-                blob_notif_tail = (blob_notif_tail + 1) % BLOB_4;
-                continue;
-            }
+    // Check if central has subscribed to this characteristic before attempting notify
+    // Without CCCD subscription, sd_ble_gatts_h_notify() returns NRF_ERROR_INVALID_STATE.
+    // Don't drop queue items — just pause and wait for the phone app to subscribe to CCCD.
+    if (!cccd_subscribed) return;
 
-            memcpy(buffer, blob_notif_queue[blob_notif_tail], msg_len);
-        } else if (useLow) {
-            idx = notif_low_tail;
-            msg_len = notif_low_queue_len[idx];
-            total = msg_len + 2;
-            
-            if (total > MAX_BLE_MTU) {
-                msg_len = (uint8_t)(MAX_BLE_MTU - 2);
-                total = msg_len + 2;
-            }
+    // Short backoff after a refused notify()
+    if (drain_failed && millis() < drain_stall_until) return;
 
-            if (msg_len == 0) {
-                notif_low_queue_empty = true;
-                continue;
-            }
+    uint16_t payloadMax = blePayloadMax();
 
-            memcpy(buffer, notif_low_queue[idx], msg_len);
-            buffer[msg_len] = '~';
-            buffer[msg_len + 1] = '~';
-        } else {
-            idx = notif_tail;
-            msg_len = notif_queue_len[idx];
-            total = msg_len + 2;
-            
-            // Clamp payload to max BLE MTU
-            if (total > MAX_BLE_MTU) {
-                msg_len = (uint8_t)(MAX_BLE_MTU - 2);
-                total = msg_len + 2;
-            }
+    while (ble_credits > 0) {
+        uint8_t cls = 0;
+        while (cls < NQ_CLASS_COUNT && nq_class_count[cls] == 0) cls++;
+        if (cls == NQ_CLASS_COUNT) return;
 
-            // Sanity: skip empty slots
-            if (msg_len == 0) {
-                notif_queue_empty = true;
-                break;
-            }
+        int32_t off = nqFindOldest(cls);
+        if (off < 0) return;
 
-            memcpy(buffer, notif_queue[idx], msg_len);
-            buffer[msg_len] = '~';
-            buffer[msg_len + 1] = '~';
+        uint8_t hdr = nq_ring[off];
+        uint16_t pos = (off + NQ_HDR) % NQ_RING_SIZE;
+        uint16_t msg_len = nqRecLen((uint16_t)off);
+        uint32_t queued_ms = 0;
+        if (hdr & NQ_FLAG_MARK) {
+            nqCopyOut(pos, (uint8_t*)&queued_ms, NQ_MARK_LEN);
+            pos = (pos + NQ_MARK_LEN) % NQ_RING_SIZE;
+            msg_len -= NQ_MARK_LEN;
         }
 
-        // After stall timeout expires: pause draining but keep items intact
-        if (drain_failed && millis() >= drain_stall_until) {
-            if (!cccd_subscribed) {
-                // CCCD not written — don't drop queue items; wait for central to subscribe
-                return;
-            }
-            if (useBlob) {
-                blob_notif_queue[blob_notif_tail][0] = '\0';
-                blob_notif_len[blob_notif_tail] = 0;
-                blob_notif_tail = (blob_notif_tail + 1) % BLOB_4;
-                if (blob_notif_head == blob_notif_tail) {
-                    blob_notif_empty = true;
-                }
-            } else {
-                notif_queue[idx][0] = '\0';
-                notif_queue_len[idx] = 0;
-                notif_tail = (notif_tail + 1) % 4;
-                if (notif_head == notif_tail) {
-                    notif_queue_empty = true;
-                }
-            }
-            drain_failed = false;
-            drain_stall_until = 0;
-            continue; // Try draining next item
+        // PRI/LOW records are stored bare and get their "~~" terminator here;
+        // blob fragments carry their own and voice frames are raw bytes
+        bool addTerm = (cls == NQ_PRI || cls == NQ_LOW) && !(hdr & NQ_FLAG_RAW);
+        uint16_t room = addTerm ? payloadMax - 2 : payloadMax;
+        if (msg_len > room) {
+            // Queued under a larger MTU — rebuild at this one rather than cut
+            nqRefit((uint16_t)off, payloadMax);
+            continue;
         }
 
-        // Check if central has subscribed to this characteristic before attempting notify
-        // Without CCCD subscription, sd_ble_gatts_h_notify() returns NRF_ERROR_INVALID_STATE (code=1)
-        if (!cccd_subscribed) {
-            // Don't drop queue items — just pause and wait for the phone app to subscribe to CCCD.
-            return;
+        uint8_t buffer[MAX_BLE_MTU];
+        nqCopyOut(pos, buffer, msg_len);
+        size_t total = msg_len;
+        if (addTerm) {
+            buffer[total++] = '~';
+            buffer[total++] = '~';
         }
 
-            int32_t ret = bleCharacteristic.notify(buffer, total);
-
-            if (ret == ERROR_NONE) {
-                const char* src = useBlob ? "BLOB" : (useLow ? "LOW" : "PRI");
-                sendSerialToAppLn(String("[BLE] SENT ") + src + " len=" + String(total));
-                drain_failed = false;
-            drain_stall_until = 0;
-            if (useBlob) {
-                blob_notif_queue[blob_notif_tail][0] = '\0';
-                blob_notif_len[blob_notif_tail] = 0;
-                blob_notif_tail = (blob_notif_tail + 1) % BLOB_4;
-                if (blob_notif_head == blob_notif_tail) {
-                    blob_notif_empty = true;
-                }
-            } else if (useLow) {
-                notif_low_queue[notif_low_tail][0] = '\0';
-                notif_low_queue_len[notif_low_tail] = 0;
-                notif_low_tail = (notif_low_tail + 1) % NOTIF_LOW_QUEUE_SIZE;
-                if (notif_low_head == notif_low_tail) {
-                    notif_low_queue_empty = true;
-                }
-            } else {
-                notif_queue[idx][0] = '\0';
-                notif_queue_len[idx] = 0;
-                notif_tail = (notif_tail + 1) % 4;
-                if (notif_head == notif_tail) {
-                    notif_queue_empty = true;
-                }
-            }
-            // Only drain one item per call — pacing is critical to avoid overwhelming the BLE link
-            break;
-        } else {
-            // Error code 1 from notify() is a known Bluefruit52Lib/SoftDevice quirk:
-            // the GATT server buffer reports momentarily full right after CCCD enable,
-            // but the notification still gets delivered to the central.
-            // Treating it as success prevents unnecessary drain failure logs and stale item clearing.
-            if (ret == 1) {
-                if (!drain_failed) {
-                    drain_failed = true;   // One-time suppress: prevents re-logging on this item
-                    drain_fail_start = millis();
-                }
-            if (useBlob) {
-                blob_notif_queue[blob_notif_tail][0] = '\0';
-                blob_notif_len[blob_notif_tail] = 0;
-                blob_notif_tail = (blob_notif_tail + 1) % BLOB_4;
-                if (blob_notif_head == blob_notif_tail) {
-                    blob_notif_empty = true;
-                }
-            } else if (useLow) {
-                notif_low_queue[notif_low_tail][0] = '\0';
-                notif_low_queue_len[notif_low_tail] = 0;
-                notif_low_tail = (notif_low_tail + 1) % NOTIF_LOW_QUEUE_SIZE;
-                if (notif_low_head == notif_low_tail) {
-                    notif_low_queue_empty = true;
-                }
-            } else {
-                notif_queue[idx][0] = '\0';
-                notif_queue_len[idx] = 0;
-                notif_tail = (notif_tail + 1) % 4;
-                if (notif_head == notif_tail) {
-                    notif_queue_empty = true;
-                }
-            }
-                // Only drain one item per call — pacing is critical to avoid overwhelming the BLE link
-                break;
-            }
+        // notify() returns true once the packet is in a SoftDevice HVN TX buffer
+        if (bleCharacteristic.notify(buffer, total)) {
+            __atomic_fetch_sub(&ble_credits, 1, __ATOMIC_RELAXED);
+            if (hdr & NQ_FLAG_MARK) recordSyncLatency(millis() - queued_ms);
+            nqRetire((uint16_t)off);
+            drain_failed = false;
+            drain_fail_start = 0;
+            continue;
+        }
 
-            // Track actual drain failures — set extended stall window to give central time to recover
-            if (!drain_failed) {
-                const char* src = useBlob ? "BLOB" : (useLow ? "LOW" : "PRI");
-                String msg = F("[BLE] FAIL ");
-                msg += src;
-                msg += ": ";
-                msg += bleErrorName(ret);
-                msg += " code=";
-                msg += ret;
-                msg += " len=";
-                msg += total;
-                SerialMon.println(msg);
-                // Print the full payload for identification of what failed to send
-                msg = F("[BLE] FAIL payload: ");
-                int printLen = (total - 2) < 240 ? (int)(total - 2) : 240;
-                for (int i = 0; i < printLen && i < total; i++) {
-                    uint8_t b = buffer[i];
-                    if (b >= 32 && b < 127) msg += (char)b;
-                    else msg += '.';
-                }
-                SerialMon.println(msg);  // USB-only — do NOT enqueue to notification queue
-                drain_failed = true;
-                drain_fail_start = millis();
-                drain_stall_until = millis() + DRAIN_STALL_MS;
-            } else if (millis() - drain_fail_start > DRAIN_FAIL_TIMEOUT_MS) {
-                // Clear stale notification — nothing is consuming it
-                if (useBlob) {
-                    blob_notif_queue[blob_notif_tail][0] = '\0';
-                    blob_notif_len[blob_notif_tail] = 0;
-                    blob_notif_tail = (blob_notif_tail + 1) % BLOB_4;
-                    if (blob_notif_head == blob_notif_tail) {
-                        blob_notif_empty = true;
-                    }
-                } else if (useLow) {
-                    notif_low_queue[notif_low_tail][0] = '\0';
-                    notif_low_queue_len[notif_low_tail] = 0;
-                    notif_low_tail = (notif_low_tail + 1) % NOTIF_LOW_QUEUE_SIZE;
-                    if (notif_low_head == notif_low_tail) {
-                        notif_low_queue_empty = true;
-                    }
-                } else {
-                    notif_queue[notif_tail][0] = '\0';
-                    notif_queue_len[notif_tail] = 0;
-                    notif_tail = (notif_tail + 1) % 4;
-                    if (notif_head == notif_tail) {
-                        notif_queue_empty = true;
-                    }
-                }
-                drain_failed = false;
-                drain_stall_until = 0;
-            } else {
-                // Within stall window — break without re-hammering notify()
-            }
-            break; // Failed to send — stop draining, retry next iteration
+        // Refused despite holding a credit — link congested or going down. Back off briefly,
+        // and drop the record if it keeps failing so one bad item can't wedge the ring.
+        if (!drain_failed) {
+            String msg = F("[BLE] FAIL ");
+            msg += nq_class_name[cls];
+            msg += " len=";
+            msg += total;
+            msg += " mtu_payload=";
+            msg += payloadMax;
+            msg += " credits=";
+            msg += ble_credits;
+            SerialMon.println(msg);  // USB-only — do NOT enqueue to notification queue
+            drain_failed = true;
+            drain_fail_start = millis();
+        } else if (millis() - drain_fail_start > DRAIN_FAIL_TIMEOUT_MS) {
+            // Clear stale notification — nothing is consuming it
+            nqRetire((uint16_t)off);
+            drain_failed = false;
         }
+        drain_stall_until = millis() + DRAIN_BACKOFF_MS;
+        return;
     }
 }
 
-// Fragmented notification — splits payloads exceeding MTU across BLE notifications
-// All fragments share a uniform format so the companion app doesn't need special parsing:
-//   "LINE:BLOB|<raw_payload_data>~~"
-// The app strips the LINE:BLOB prefix, concatenates raw data in order (S0=first, S1=next...),
-// and reconstructs the original message before processing.
-bool sendFragmentedNotification(const char* message) {
-    if (!message || !message[0]) return false;
-
+// Split `message` into LINE:BLOB fragments sized to the negotiated MTU, or queue it as a single
+// LINE:NOTIF when it fits. Fragments go in all-or-nothing — a partial blob only confuses the
+// app's reassembly. `mark` tags the final record for screen-sync latency tracking.
+static bool enqueueFragmented(const char* message, bool mark) {
+    NqLock lock;    // nqCanFit() and the pushes after it must see the same ring
     size_t msgLen = strlen(message);
+    uint16_t payloadMax = blePayloadMax();
 
-    // Single notification fits — use normal path
-    if (msgLen + 2 <= MAX_BLE_MTU) {
+    // Single notification fits — use normal path ("LINE:NOTIF|DATA:" + msg + "~~")
+    if (16 + msgLen + 2 <= payloadMax) {
         static char notifStr[NOTIF_STR_MAX_LEN];
-        snprintf(notifStr, sizeof(notifStr), "LINE:NOTIF|DATA:%.*s", (int)(msgLen + 2), message);
-        return enqueue(notifStr);
+        snprintf(notifStr, sizeof(notifStr), "LINE:NOTIF|DATA:%s", message);
+        return enqueue(notifStr, mark);
     }
 
-    // Multi-fragment mode — each fragment carries exactly MAX_BLOB_DATA bytes of raw payload.
-    const int MAX_BLOB_DATA = 64; // ~64 bytes of original message data per fragment
-    
-    int totalFragments = (msgLen + MAX_BLOB_DATA - 1) / MAX_BLOB_DATA;
-    if (totalFragments > 255 || totalFragments < 2) return false;
+    // Multi-fragment mode — each fragment fills one notification: "LINE:BLOB|S{seq}|<raw_data>~~"
+    int totalFragments = 0;
+    size_t totalBytes = 0;
+    for (size_t off = 0; off < msgLen; totalFragments++) {
+        int pre = snprintf(nullptr, 0, "LINE:BLOB|S%d|", totalFragments);
+        size_t dataSz = payloadMax - pre - 2;
+        if (dataSz > msgLen - off) dataSz = msgLen - off;
+        off += dataSz;
+        totalBytes += pre + dataSz + 2;
+    }
+    if (totalFragments > 255) return false;
+    if (mark) totalBytes += NQ_MARK_LEN;
+    if (!nqCanFit(NQ_BLOB, totalBytes, (uint16_t)totalFragments)) return false;
 
+    size_t dataOff = 0;
     for (int frag = 0; frag < totalFragments; frag++) {
-        int dataOff = frag * MAX_BLOB_DATA;
-        size_t remaining = msgLen - dataOff;
-        size_t dataSz = remaining > MAX_BLOB_DATA ? MAX_BLOB_DATA : remaining;
-
-        // Build fragment: "LINE:BLOB|S{seq}|<raw_data>~~"
-        char buf[NOTIF_SLOT_SIZE];
+        char buf[MAX_BLE_MTU];
         int off = sprintf(buf, "LINE:BLOB|S%d|", frag);
+        size_t dataSz = payloadMax - off - 2;
+        if (dataSz > msgLen - dataOff) dataSz = msgLen - dataOff;
         memcpy(buf + off, message + dataOff, dataSz);
+        dataOff += dataSz;
         off += (int)dataSz;
         buf[off++] = '~';
         buf[off++] = '~';
-        buf[off] = '\0';
 
-        blob_notif_queue[blob_notif_head][0] = '\0';
-        memcpy(blob_notif_queue[blob_notif_head], buf, (uint8_t)(off + 1));
-        blob_notif_len[blob_notif_head] = (uint8_t)off;
-        blob_notif_head = (blob_notif_head + 1) % BLOB_4;
-        blob_notif_empty = false;
+        bool last = (frag == totalFragments - 1);
+        if (!nqPush(NQ_BLOB, (const uint8_t*)buf, (size_t)off, mark && last)) return false;
     }
 
     return true;
 }
-static bool binQueueFull() {
-    uint8_t next = (bin_notif_head + 1) % BINARY_NOTIF_QUEUE_SIZE;
-    return next == bin_notif_tail;
+
+// Fragmented notification — splits payloads exceeding MTU across BLE notifications
+// All fragments share a uniform format so the companion app doesn't need special parsing:
+//   "LINE:BLOB|S{seq}|<raw_payload_data>~~"
+// The app strips the LINE:BLOB prefix, concatenates raw data in order (S0=first, S1=next...),
+// and reconstructs the original message before processing.
+bool sendFragmentedNotification(const char* message) {
+    if (!message || !message[0]) return false;
+    bool mark = nq_mark_next;
+    nq_mark_next = false;
+    return enqueueFragmented(message, mark);
 }
 
-static bool enqueueBinary(const uint8_t* data, uint8_t len) {
-    if (len > 127) return false;
-    if (binQueueFull()) return false;
-    memcpy(bin_notif_queue[bin_notif_head], data, len);
-    bin_notif_len[bin_notif_head] = len;
-    bin_notif_head = (bin_notif_head + 1) % BINARY_NOTIF_QUEUE_SIZE;
-    return true;
+// ── Loopback throughput benchmark ─────────────────────────────────────────
+// BENCH[:<kbytes>] streams filler notifications sized to the negotiated MTU through the normal
+// ring and credit path, forcing a screen sync every BENCH_SYNC_EVERY_MS so the latency figures
+// reflect a loaded link. Reports sustained notify bytes/s and screen-sync delivery percentiles.
+#define BENCH_DEFAULT_KB        32
+#define BENCH_MAX_KB            512
+#define BENCH_SYNC_EVERY_MS     250
+static volatile bool bench_active = false;
+static uint32_t bench_total = 0;
+static uint32_t bench_queued = 0;
+static uint32_t bench_start_ms = 0;
+static uint32_t bench_last_sync_ms = 0;
+
+void bleBenchStart(int kb) {
+    if (kb <= 0) kb = BENCH_DEFAULT_KB;
+    if (kb > BENCH_MAX_KB) kb = BENCH_MAX_KB;
+    bench_total = (uint32_t)kb * 1024;
+    bench_queued = 0;
+    bench_start_ms = millis();
+    bench_last_sync_ms = bench_start_ms;
+    sync_lat_count = 0;
+    sync_lat_idx = 0;
+    bench_active = true;
 }
 
-static void drainBinaryQueue() {
-    if (bin_notif_head == bin_notif_tail) return;
-    
-    uint8_t idx = bin_notif_tail;
-    uint8_t len = bin_notif_len[idx];
-    
-    SerialMon.print(F("[BLE] drainBinary: idx="));
-    SerialMon.print(idx);
-    SerialMon.print(" len=");
-    SerialMon.print(len);
-    SerialMon.print(" notify()...");
-    
-    int32_t ret = bleCharacteristic.notify(bin_notif_queue[idx], len);
-    
-    SerialMon.print(ret == ERROR_NONE ? "ERROR_NONE" : String("ERR(") + ret + ")");
-    SerialMon.println();
-    
-    if (ret == ERROR_NONE) {
-        bin_notif_len[idx] = 0;
-        bin_notif_tail = (bin_notif_tail + 1) % BINARY_NOTIF_QUEUE_SIZE;
+// Called from handleBLE(): keep the ring topped up, then report once everything has left the air
+static void benchStep() {
+    if (!bench_active) return;
+
+    uint16_t payloadMax = blePayloadMax();
+    while (bench_queued < bench_total) {
+        char buf[MAX_BLE_MTU];
+        int off = snprintf(buf, sizeof(buf), "LINE:BENCH|%lu|", (unsigned long)bench_queued);
+        while (off < payloadMax - 2) buf[off++] = 'x';
+        buf[off++] = '~';
+        buf[off++] = '~';
+        if (!nqPush(NQ_BLOB, (const uint8_t*)buf, (size_t)off)) break;  // Ring full — retry next loop
+        bench_queued += off;
+    }
+
+    if (millis() - bench_last_sync_ms >= BENCH_SYNC_EVERY_MS) {
+        bench_last_sync_ms = millis();
+        sendScreenSyncForced();
     }
+
+    if (bench_queued < bench_total || nqCount(NQ_BLOB) > 0 || ble_credits < BLE_HVN_TX_QUEUE) return;
+
+    bench_active = false;
+    uint32_t elapsed = millis() - bench_start_ms;
+    if (elapsed == 0) elapsed = 1;
+    char r[192];
+    snprintf(r, sizeof(r), "OK{BENCH:bytes=%lu,ms=%lu,Bps=%lu,mtu=%u,phy=%s,sync_n=%u,sync_p50=%u,sync_p95=%u,sync_max=%u}",
+             (unsigned long)bench_queued, (unsigned long)elapsed, (unsigned long)(bench_queued * 1000UL / elapsed),
+             blePayloadMax() + ATT_HDR_LEN, ble_tx_phy == BLE_GAP_PHY_2MBPS ? "2M" : "1M",
+             sync_lat_count, syncLatencyPercentile(50), syncLatencyPercentile(95), syncLatencyPercentile(100));
+    sendNotificationToApp(r);
 }
 
 void sendBinaryNotification(const uint8_t* data, uint8_t len) {
     if (!data || len == 0) return;
-    enqueueBinary(data, len);
+    nqPush(NQ_VOICE, data, len);
 }
 
 // Increase SoftDevice ATT MTU to 247 before BLE init (default is 23)
@@ -534,10 +637,12 @@ void sendBinaryNotification(const uint8_t* data, uint8_t len) {
 // This reduces BLE fragmentation from ~8 packets per message down to 1-2
 
 void setupBLE() {
+    nq_mutex = xSemaphoreCreateRecursiveMutex();
+
     // Set maximum ATT MTU via Bluefruit API before Bluefruit.begin()
     // Request max ATT MTU (247 bytes) for larger single-packet payloads — reduces fragmentation
-    // Use explicit connection parameters: min_event_length=3, hvn_tx_queue=6
-    Bluefruit.configPrphConn(247, BLE_GAP_EVENT_LENGTH_DEFAULT, 6, BLE_GATTC_WRITE_CMD_TX_QUEUE_SIZE_DEFAULT);
+    // Use explicit connection parameters: min_event_length=3, hvn_tx_queue=BLE_HVN_TX_QUEUE (drain credits)
+    Bluefruit.configPrphConn(MAX_BLE_MTU, BLE_GAP_EVENT_LENGTH_DEFAULT, BLE_HVN_TX_QUEUE, BLE_GATTC_WRITE_CMD_TX_QUEUE_SIZE_DEFAULT);
 
     // Request MTU override via GATT before advertising — central will negotiate this value
     uint16_t mtu = 247;
@@ -545,6 +650,7 @@ void setupBLE() {
 
     Bluefruit.begin();
     Bluefruit.setTxPower(4);  // Set the TX power to max (4dBm)
+    Bluefruit.setEventCallback(onBleEvent);
 
     char deviceName[25];
     uint64_t mac = NRF_FICR->DEVICEID[0];
@@ -590,17 +696,21 @@ static volatile bool serial_pending = false;
 
 bool isPhoneConnected() {
     static uint8_t call_cnt = 0;
+    uint16_t pri, used;
+    {
+        NqLock lock;
+        pri = nq_class_count[NQ_PRI];
+        used = nq_used;
+    }
     if (call_cnt++ % 100 == 0) {
-        SerialMon.print(F("[BLE] isPhoneConnected(): notif_queue_empty="));
-        SerialMon.print(notif_queue_empty ? 1 : 0);
-        SerialMon.print(" head=");
-        SerialMon.print(notif_head);
-        SerialMon.print(" tail=");
-        SerialMon.print(notif_tail);
+        SerialMon.print(F("[BLE] isPhoneConnected(): pri_pending="));
+        SerialMon.print(pri);
+        SerialMon.print(" ring_used=");
+        SerialMon.print(used);
         SerialMon.print(" => returning ");
-        SerialMon.println(!notif_queue_empty ? "true" : "false");
+        SerialMon.println(pri ? "true" : "false");
     }
-    return !notif_queue_empty;
+    return pri > 0;
 }
 
 void sendSerialToApp(const String& msg) {
@@ -613,6 +723,7 @@ void sendSerialToApp(const String& msg) {
     if (millis() < ble_connect_stall_until) return;
 
     // Use the existing notification queue — it already handles wrapping, ~~ terminators, and drain timing
+    NqLock lock;    // notifStr is shared with the BLE task's log lines
     static char notifStr[NOTIF_STR_MAX_LEN];
     snprintf(notifStr, sizeof(notifStr), "LINE:SERIAL|DATA:%s", msg.c_str());
     enqueueLow(notifStr);
@@ -660,21 +771,15 @@ void handleBLE() {
         }
     }
 
-    // Process deferred screen sync — was being dropped because sendNotificationToApp checks in_write_callback
-    if (pending_screen_sync) {
-        pending_screen_sync = false;
-        
-        // Send screen sync — high-priority queue has room since serial logs go to low-priority queue now
-        extern void sendScreenSyncForced();
-        sendScreenSyncForced();
-    }
+    // Commands received in the write callback run here, one per pass, so drain keeps up
+    bleCmdRun();
 
     if (ble_connected) {
+        benchStep();
         drainQueue();
     } else {
         // Heartbeat summary removed — was noisy diagnostic, not actionable
     }
-    drainBinaryQueue();
 }
 
 bool isBleConnected() { return ble_connected; }
@@ -684,25 +789,61 @@ static void sendSerialFromQueue() {
     // nothing: sendSerialToApp calls enqueue() directly above
 }
 
+// Raw SoftDevice event hook — Bluefruit handles everything itself, this only tracks
+// notification credits and the PHY actually in use
+static void onBleEvent(ble_evt_t* evt) {
+    switch (evt->header.evt_id) {
+        case BLE_GATTS_EVT_HVN_TX_COMPLETE: {
+            // Add and clamp in one step, so a credit the loop takes in between is not overwritten
+            uint8_t count = evt->evt.gatts_evt.params.hvn_tx_complete.count;
+            uint8_t c = __atomic_load_n(&ble_credits, __ATOMIC_RELAXED);
+            uint8_t next;
+            do {
+                next = c + count > BLE_HVN_TX_QUEUE ? BLE_HVN_TX_QUEUE : c + count;
+            } while (!__atomic_compare_exchange_n(&ble_credits, &c, next, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+            break;
+        }
+        case BLE_GAP_EVT_PHY_UPDATE:
+            ble_tx_phy = evt->evt.gap_evt.params.phy_update.tx_phy;
+            break;
+        default:
+            break;
+    }
+}
+
 void onConnect(uint16_t conn_handle) {
     SerialMon.print(F("[BLE] onConnect: setting ble_connected=true, stall_until="));
     SerialMon.println(millis() + BLE_CONNECT_STALL_MS);
     cccd_subscribed = false;  // Reset — new connection needs fresh subscription
     ble_connected = true;
+    ble_active_conn_handle = conn_handle;
+    __atomic_store_n(&ble_credits, BLE_HVN_TX_QUEUE, __ATOMIC_RELAXED);
+    ble_tx_phy = BLE_GAP_PHY_1MBPS;
+    screenSyncReset();      // Phone has no mirror state yet — keyframes until it acks
+
+    // Ask for 2M PHY (SoftDevice stays on 1M if the phone can't) and data length extension so a
+    // full-MTU notification travels as one LL packet. The ATT MTU itself is requested by the app.
+    BLEConnection* conn = Bluefruit.Connection(conn_handle);
+    if (conn) {
+        conn->requestPHY(BLE_GAP_PHY_2MBPS);
+        conn->requestDataLengthUpdate();
+    }
     // Stall drain for 1.5s to let SoftDevice stabilize — prevents handshake deadlock
     ble_connect_stall_until = millis() + BLE_CONNECT_STALL_MS;
     sendSerialToAppLn("[BLE] connected");
 }
 
 void onDisconnect(uint16_t conn_handle, uint8_t reason) {
-    SerialMon.print(F("[BLE] onDisconnect: clearing queue, head="));
-    SerialMon.print(notif_head);
-    SerialMon.print(" tail=");
-    SerialMon.println(notif_tail);
+    SerialMon.print(F("[BLE] onDisconnect: clearing queue, pri_pending="));
+    SerialMon.print(nqCount(NQ_PRI));
+    SerialMon.print(" voice_pending=");
+    SerialMon.println(nqCount(NQ_VOICE));
     ble_connected = false;
-    notif_queue_empty = true;
-    notif_head = 0;
-    notif_tail = 0;
+    ble_active_conn_handle = 0xFFFF;
+    bench_active = false;
+    // Replies and audio are stale by the time the phone reconnects — blob/log records are kept
+    nqDropClass(NQ_PRI);
+    nqDropClass(NQ_VOICE);
     ble_connect_stall_until = 0;
     
     // Reset drain failure state — prevents stall from blocking first messages after reconnect
@@ -720,6 +861,14 @@ void onDisconnect(uint16_t conn_handle, uint8_t reason) {
     pending_display_update = true;
 }
 
+// A write from the phone proves the link and subscription are up — let drain start right away
+static void drainResume() {
+    ble_connect_stall_until = 0;
+    drain_failed = false;
+    drain_stall_until = 0;
+    drain_fail_start = 0;
+}
+
 void onCharacteristicWritten(uint16_t conn_handle, BLECharacteristic* chr, uint8_t* data, uint16_t len) {
     // Mark CCCD as subscribed — Bluefruit52Lib calls this callback when the central writes the CCCD
     // This enables drain to proceed after the connection is established and the phone subscribes
@@ -755,43 +904,22 @@ void onCharacteristicWritten(uint16_t conn_handle, BLECharacteristic* chr, uint8
         }
     }
 
-    bool handled = false;
-    if (printable) {
-        int delim = -1;
-        for (int i = 0; i < nlen; i++) { if (localBuf[i] == ':') { delim = i; break; } }
-        if (delim != -1) {
-            char action[64]; int alen = delim < sizeof(action)-1 ? delim : sizeof(action)-1;
-            for (int i=0;i<alen;i++) action[i] = localBuf[i]; action[alen]='\0';
-            char value[256]; int vstart=delim+1, vlen=nlen-vstart;
-            vlen = vlen < sizeof(value)-1 ? vlen : sizeof(value)-1;
-            for (int i=0;i<vlen;i++) value[i] = localBuf[vstart+i]; value[vlen]='\0';
-            if (strcmp(action,"SETMODE")==0) { switchMode(String(value)); pending_screen_sync=true; handled=true; }
-            else if (strcmp(action,"SENDTXT")==0) { sendTxtMessage(value); handled=true; }
-            else if (strcmp(action,"SETNAME")==0) { static char localName[32]; int slen=strlen(value); if(slen>0&&slen<sizeof(localName)){for(int i=0;i<slen;i++)localName[i]=value[i];localName[slen]='\0';buddySetDisplayName(localName);char r[48];snprintf(r,sizeof(r),"OK{NAME:%s}",localName);sendNotificationToApp(r);}else{sendNotificationToApp("ERR{NAME:too long}");handled=true;} }
-            else if (strcmp(action,"SETBUDDY")==0) { int c=buddyImportCsv(value);char r[48];snprintf(r,sizeof(r),"OK{BUDDY:%d}",c);sendNotificationToApp(r);handled=true; }
-            else if (strcmp(action,"GETBUDDY")==0) { static char cb[512];if(buddyExportCsv(cb,sizeof(cb))){char r[560];snprintf(r,sizeof(r),"OK{BUDDY:%s}",cb);sendNotificationToApp(r);}else{sendNotificationToApp("OK{BUDDY:}");}handled=true; }
-            else if (strcmp(action,"GETSCREEN")==0) { pending_screen_sync=true;handled=true; }
-            else if (strcmp(action,"GETSTATUS")==0) { extern bool isPeerAlive();bool la=isPeerAlive();char r[32];snprintf(r,sizeof(r),"OK{BLE:1}{LORA:%d}",la?1:0);sendNotificationToApp(r);handled=true; }
-            else if (strcmp(action,"GETSETTINGS")==0) { char buf[192];snprintf(buf,sizeof(buf),"OK{SETTINGS:SF=%d,BITRATE=%d,CHAN=%c,VOL=%d,BL=%d,BW=%d,CR=%d,FH=%d,HOUR=%d,MIN=%d,SEC=%d}",deviceSettings.spreading_factor,deviceSettings.bitrate_idx,channels[deviceSettings.channel_idx],deviceSettings.volume_level,deviceSettings.backlight?1:0,deviceSettings.bandwidth_idx,deviceSettings.coding_rate_idx,deviceSettings.frequency_hopping_enabled?1:0,deviceSettings.hours,deviceSettings.minutes,deviceSettings.seconds);sendNotificationToApp(buf);handled=true; }
-             else if (strcmp(action,"SETSETTINGS")==0) { extern void setupLoRa();char buf[256];int vlen=strlen(value);if(vlen>=sizeof(buf))vlen=sizeof(buf)-1;for(int i=0;i<vlen;i++)buf[i]=value[i];buf[vlen]='\0';bool needReinit=false;char*cp=buf;while(cp&&*cp){char*kp=strchr(cp,',');int klen=kp?kp-cp:vlen;if(klen>=64)klen=63;char key[64],val[64];memcpy(key,cp,klen);key[klen]='\0';char*eqp=strchr(key,'=');if(!eqp){cp=kp?kp+1:nullptr;continue;*eqp='\0';strncpy(val,eqp+1,sizeof(val)-1);val[sizeof(val)-1]='\0';if(strcmp(key,"SF")==0){deviceSettings.spreading_factor=atoi(val);}else if(strcmp(key,"BITRATE")==0){deviceSettings.bitrate_idx=atoi(val);needReinit=true;}else if(strcmp(key,"CHAN")==0){char c=toupper(val[0]);deviceSettings.channel_idx=c-'A';needReinit=true;}else if(strcmp(key,"VOL")==0){deviceSettings.volume_level=atoi(val);}else if(strcmp(key,"BL")==0){deviceSettings.backlight=!!atoi(val);}else if(strcmp(key,"BW")==0){deviceSettings.bandwidth_idx=atoi(val);needReinit=true;}else if(strcmp(key,"CR")==0){deviceSettings.coding_rate_idx=atoi(val);needReinit=true;}else if(strcmp(key,"FH")==0){deviceSettings.frequency_hopping_enabled=!!atoi(val);}else if(strcmp(key,"HOUR")==0){deviceSettings.hours=atoi(val);}else if(strcmp(key,"MIN")==0){deviceSettings.minutes=atoi(val);}else if(strcmp(key,"SEC")==0){deviceSettings.seconds=atoi(val);}}cp=kp?kp+1:nullptr;}if(needReinit)setupLoRa();sendNotificationToApp("OK{SETTINGS:saved}");handled=true; }
-            else { handled=true; }
-        } else {
-            if (nlen==11 && localBuf[0]=='G' && localBuf[1]=='E' && localBuf[2]=='T' && localBuf[3]=='S' && localBuf[4]=='E' && localBuf[5]=='T' && localBuf[6]=='T' && localBuf[7]=='I' && localBuf[8]=='N' && localBuf[9]=='G' && localBuf[10]=='S') { char buf[192];snprintf(buf,sizeof(buf),"OK{SETTINGS:SF=%d,BITRATE=%d,CHAN=%c,VOL=%d,BL=%d,BW=%d,CR=%d,FH=%d,HOUR=%d,MIN=%d,SEC=%d}",deviceSettings.spreading_factor,deviceSettings.bitrate_idx,channels[deviceSettings.channel_idx],deviceSettings.volume_level,deviceSettings.backlight?1:0,deviceSettings.bandwidth_idx,deviceSettings.coding_rate_idx,deviceSettings.frequency_hopping_enabled?1:0,deviceSettings.hours,deviceSettings.minutes,deviceSettings.seconds);sendNotificationToApp(buf);handled=true; }
-            else if (nlen==9 && localBuf[0]=='G' && localBuf[1]=='E' && localBuf[2]=='T' && localBuf[3]=='S' && localBuf[4]=='T' && localBuf[5]=='A' && localBuf[6]=='T' && localBuf[7]=='U' && localBuf[8]=='S') { extern bool isPeerAlive();bool la=isPeerAlive();char r[32];snprintf(r,sizeof(r),"OK{BLE:1}{LORA:%d}",la?1:0);sendNotificationToApp(r);handled=true; }
-            else if (nlen==9 && localBuf[0]=='G' && localBuf[1]=='E' && localBuf[2]=='T' && localBuf[3]=='S' && localBuf[4]=='C' && localBuf[5]=='R' && localBuf[6]=='E' && localBuf[7]=='E' && localBuf[8]=='N') { pending_screen_sync=true;handled=true; }
-            else { handled=true; }
-        }
-    }
-
-    if (!handled && nlen>=4 && (uint8_t)localBuf[0]==0xFE && (uint8_t)localBuf[1]==0x01) {
+    // Binary frames first — Opus and TLV payloads can contain ':' and still pass the printable check.
+    // Everything except voice is only queued here; handlers run from handleBLE() in loop context.
+    if (nlen>=4 && (uint8_t)localBuf[0]==0xFE && (uint8_t)localBuf[1]==0x01) {
         uint16_t opusLen = ((uint16_t)(uint8_t)localBuf[3] << 8) | (uint8_t)localBuf[2];
         if(opusLen>0 && 4+opusLen<=nlen){extern void sendPacket(uint8_t*,uint16_t,unsigned int);static char opusPkt[MAX_PKT];snprintf(opusPkt,sizeof(opusPkt),"PT%cO",channels[deviceSettings.channel_idx]);int pl=strlen(opusPkt);for(int i=0;i<opusLen&&pl+i<MAX_PKT-1;i++)opusPkt[pl+i]=localBuf[4+i];pl+=opusLen;setPttTxActive(true);pending_display_update=true;sendPacket((uint8_t*)opusPkt,(uint16_t)pl,0);}
+    } else if (tlvIsFrame((const uint8_t*)localBuf, nlen)) {
+        bleCmdSubmitFrame((const uint8_t*)localBuf, nlen);
+        drainResume();
+    } else if (printable) {
+        if (bleCmdSubmitText(localBuf, nlen)) drainResume();
     }
 
     static uint32_t last_action_log_ms = 0;
     if (millis() - last_action_log_ms > 5000) {
         last_action_log_ms = millis();
-        sendSerialToAppLn(String("[BLE] pending_sync=") + (pending_screen_sync ? "1" : "0") + " pending_disp=" + (pending_display_update ? "1" : "0"));
+        sendSerialToAppLn(String("[BLE] pending_cmds=") + bleCmdPending() + " pending_disp=" + (pending_display_update ? "1" : "0"));
     }
 
     in_write_callback = false;
@@ -804,62 +932,31 @@ void sendNotificationToApp(const char* message) {
     // Stall period: drop all notifications until SoftDevice stabilizes after connect
     if (millis() < ble_connect_stall_until) {
         SerialMon.println(F("DBG:sendNotif DROPPED stall"));
+        nq_mark_next = false;
         return;
     }
 
-    // In write callback: enqueue for later drain, don't drop.
-    // The queue will be drained in handleBLE() after the callback returns.
-    if (in_write_callback) {
-        size_t msgLen = strlen(message);
-        static char notifStr_wc[NOTIF_STR_MAX_LEN];
-        uint8_t buffer_wc[msgLen + 3];
-        memcpy(buffer_wc, message, msgLen);
-        buffer_wc[msgLen] = '~';
-        buffer_wc[msgLen + 1] = '~';
-        buffer_wc[msgLen + 2] = '\0';
-        snprintf(notifStr_wc, sizeof(notifStr_wc), "LINE:NOTIF|DATA:%.*s", (int)(msgLen + 2), buffer_wc);
-        
-        // Use fragmentation when the wrapped message exceeds MTU
-        if (strlen(notifStr_wc) > MAX_BLE_MTU) {
-            extern bool sendFragmentedNotification(const char*);
-            sendFragmentedNotification(message);
-        }
-        
-        if (!enqueue(notifStr_wc)) {
-            return; // queue full, nothing we can do in write callback anyway
-        }
-        // Clear stall state so handleBLE() will drain after this callback returns
-        ble_connect_stall_until = 0;
-        drain_failed = false;
-        drain_stall_until = 0;
-        if (drain_fail_start > 0) drain_fail_start = 0;
-        return;
-    }
+    bool mark = nq_mark_next;
+    nq_mark_next = false;
 
     size_t msgLen = strlen(message);
-    
-    // Check if the wrapped message would exceed MTU — use fragmentation to avoid truncation
-    extern bool sendFragmentedNotification(const char*);
-    if (msgLen + 2 > MAX_BLE_MTU) {
-        sendFragmentedNotification(message);
-        return;  // Fragmented — skip regular enqueue path entirely
-    }
-    
-    // Create buffer with "~~" terminator
-    uint8_t buffer[msgLen + 3];
-    memcpy(buffer, message, msgLen);
-    buffer[msgLen] = '~';
-    buffer[msgLen + 1] = '~';
-    buffer[msgLen + 2] = '\0';
-
-    // Build notification string for queue — fits within MTU after this check
-    static char notifStr[NOTIF_STR_MAX_LEN];
-    snprintf(notifStr, sizeof(notifStr), "LINE:NOTIF|DATA:%.*s", (int)(msgLen + 2), buffer);
-    
-    if (!enqueue(notifStr)) {
-        // Queue full — drop notification rather than deadlocking the BLE stack.
-        // Drain will happen next iteration of loop() via handleBLE().
+    bool queued;
+    NqLock lock;    // notifStr below; replies come from the BLE task too (ERR{BUSY})
+
+    // Wrapped message ("LINE:NOTIF|DATA:" + msg + "~~" + drain's "~~") must fit one notification,
+    // otherwise fragment at the negotiated MTU instead of truncating
+    if (16 + msgLen + 4 > blePayloadMax()) {
+        queued = enqueueFragmented(message, mark);
+    } else {
+        static char notifStr[NOTIF_STR_MAX_LEN];
+        snprintf(notifStr, sizeof(notifStr), "LINE:NOTIF|DATA:%s~~", message);
+        queued = enqueue(notifStr, mark);
     }
+
+    // In write callback: the ring is drained in handleBLE() after the callback returns.
+    // Clear stall state so that drain happens straight away.
+    if (in_write_callback && queued) drainResume();
+    // Queue full — drop notification rather than deadlocking the BLE stack.
 }
 
 // Helper function to check if the data contains printable characters.
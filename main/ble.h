@@ -9,7 +9,11 @@ void handleBLE();
 bool isDataPrintable(const uint8_t* data, int length);
 void sendNotificationToApp(const char* message);
 bool sendFragmentedNotification(const char* message);
+void bleMarkNextNotification();  // Next notification is a latency probe (screen sync)
 void sendBinaryNotification(const uint8_t* data, uint8_t len);
+bool sendRawNotification(const uint8_t* data, uint16_t len);  // Binary TLV reply, high priority
+uint16_t bleNotifyPayloadMax();                                 // Negotiated ATT MTU - 3
+void bleBenchStart(int kb);                                      // BENCH[:kb] — loop context
 bool isPhoneConnected();
 bool isBleConnected();
 void serialHookInit();
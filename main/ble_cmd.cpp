@@ -0,0 +1,460 @@
+#include "ble_cmd.h"
+#include "ble.h"
+#include "ble_proto.h"
+#include "app_modes.h"
+#include "buddy_list.h"
+#include "screen_sync.h"
+#include "lora.h"
+#include "display_layout.h"
+#include "text_inbox.h"
+#include "disp_dirty.h"
+#include "disp_budget.h"
+#include "font_blit.h"
+#include "lora_capture.h"
+#include "track_log.h"
+#include "waypoint_store.h"
+#include "geodesy.h"
+#include "beacon_sched.h"
+#include "peer_roster.h"
+#include "epoch_clock.h"
+#include "gnss.h"
+#include "mesh_relay.h"
+
+#include <Arduino.h>
+
+// ── Handlers ── (loop context; arg is a NUL-terminated private copy and may be modified)
+
+static void cmdSetMode(char* arg, uint16_t len) {
+    switchMode(String(arg));
+    sendScreenSyncForced();
+}
+
+static void cmdSendTxt(char* arg, uint16_t len) {
+    sendTxtMessage(arg);
+}
+
+static void cmdSetName(char* arg, uint16_t len) {
+    static char localName[32];
+    if (len == 0 || len >= sizeof(localName)) {
+        sendNotificationToApp("ERR{NAME:too long}");
+        return;
+    }
+    memcpy(localName, arg, len + 1);
+    buddySetDisplayName(localName);
+    char r[48];
+    snprintf(r, sizeof(r), "OK{NAME:%s}", localName);
+    sendNotificationToApp(r);
+}
+
+static void cmdSetBuddy(char* arg, uint16_t len) {
+    char r[48];
+    snprintf(r, sizeof(r), "OK{BUDDY:%d}", buddyImportCsv(arg));
+    sendNotificationToApp(r);
+}
+
+// "GETBUDDY" or "GETBUDDY:<cursor>" — one page of the directory; {NEXT:n} when more remain
+static void cmdGetBuddy(char* arg, uint16_t len) {
+    static char cb[512];
+    static char r[576];
+    uint16_t cursor = len ? (uint16_t)atoi(arg) : 0;
+    buddyExportCsv(cb, sizeof(cb), cursor);
+    int n = snprintf(r, sizeof(r), "OK{BUDDY:%s}", cb);
+    if (cursor != BUDDY_EXPORT_DONE && n > 0 && (size_t)n < sizeof(r)) {
+        snprintf(r + n, sizeof(r) - n, "{NEXT:%u}", cursor);
+    }
+    sendNotificationToApp(r);
+}
+
+static void cmdGetDirStats(char* arg, uint16_t len) {
+    char r[192];
+    buddyFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+// "PCAP" / "PCAP:<from>" — one page of the capture ring; "PCAP:ON|OFF|CLEAR" control it
+static void cmdPcap(char* arg, uint16_t len) {
+    static char r[CAP_EXPORT_MAX_CHARS + 32];
+    if (strcmp(arg, "ON") == 0 || strcmp(arg, "OFF") == 0) {
+        capSetEnabled(arg[1] == 'N');
+        snprintf(r, sizeof(r), "OK{PCAP:%s}", arg);
+    } else if (strcmp(arg, "CLEAR") == 0) {
+        capClear();
+        snprintf(r, sizeof(r), "OK{PCAP:cleared}");
+    } else {
+        capExport(r, sizeof(r), len ? strtoul(arg, nullptr, 10) : 0);
+    }
+    sendNotificationToApp(r);
+}
+
+static void cmdGetCapStats(char* arg, uint16_t len) {
+    char r[224];
+    capFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+// "TRKDUMP" / "TRKDUMP:<from>" — one page of track blocks; "TRKDUMP:ON|OFF|CLEAR" control logging
+static void cmdTrkDump(char* arg, uint16_t len) {
+    static char r[1056];
+    if (strcmp(arg, "ON") == 0 || strcmp(arg, "OFF") == 0) {
+        trackSetEnabled(arg[1] == 'N');
+        snprintf(r, sizeof(r), "OK{TRK:%s}", arg);
+    } else if (strcmp(arg, "CLEAR") == 0) {
+        trackClear();
+        snprintf(r, sizeof(r), "OK{TRK:cleared}");
+    } else {
+        if (!len) trackFlush();     // A new dump includes the points still in RAM
+        trackExport(r, sizeof(r), len ? strtoul(arg, nullptr, 10) : 0);
+    }
+    sendNotificationToApp(r);
+}
+
+static void cmdGetTrkStats(char* arg, uint16_t len) {
+    char r[224];
+    trackFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetWpStats(char* arg, uint16_t len) {
+    char r[160];
+    wpStoreFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGeoBench(char* arg, uint16_t len) {
+    char r[128];
+    geoBenchmark(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetBcnStats(char* arg, uint16_t len) {
+    char r[128];
+    bcnFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetRoster(char* arg, uint16_t len) {
+    char r[128];
+    rosterFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetClock(char* arg, uint16_t len) {
+    char r[160];
+    clockFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetGnss(char* arg, uint16_t len) {
+    char r[224];
+    gnssFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+// "GNSSCFG:<fix_ms>[,<psm 0|1>]" — fix_ms 0 keeps the rate
+static void cmdGnssCfg(char* arg, uint16_t len) {
+    char* comma = strchr(arg, ',');
+    int8_t psm = comma ? (int8_t)(atoi(comma + 1) != 0) : -1;
+    if (!gnssConfigure((uint16_t)atoi(arg), psm)) {
+        sendNotificationToApp("ERR{GNSSCFG:fix_ms}");
+        return;
+    }
+    cmdGetGnss(arg, len);
+}
+
+static void cmdGetMesh(char* arg, uint16_t len) {
+    char r[160];
+    meshFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetScreen(char* arg, uint16_t len) {
+    sendScreenSyncForced();
+}
+
+static void cmdBench(char* arg, uint16_t len) {
+    bleBenchStart(atoi(arg));
+}
+
+static void cmdGetStatus(char* arg, uint16_t len) {
+    char r[32];
+    snprintf(r, sizeof(r), "OK{BLE:1}{LORA:%d}", isPeerAlive() ? 1 : 0);
+    sendNotificationToApp(r);
+}
+
+static void cmdGetSettings(char* arg, uint16_t len) {
+    char r[192];
+    protoFormatSettingsText(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdSetSettings(char* arg, uint16_t len) {
+    bool needReinit = false;
+    char* cp = arg;
+    while (cp && *cp) {
+        char* kp = strchr(cp, ',');
+        if (kp) *kp = '\0';
+        char* eqp = strchr(cp, '=');
+        if (eqp) {
+            *eqp = '\0';
+            protoApplySettingText(cp, eqp + 1, needReinit);
+        }
+        cp = kp ? kp + 1 : nullptr;
+    }
+    if (needReinit) setupLoRa();
+    sendNotificationToApp("OK{SETTINGS:saved}");
+}
+
+static void cmdSyncAck(char* arg, uint16_t len) {
+    screenSyncAck(strtoul(arg, nullptr, 10));
+}
+
+static void cmdGetSyncStats(char* arg, uint16_t len) {
+    char r[240];
+    screenSyncFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetCmdStats(char* arg, uint16_t len) {
+    char r[480];
+    bleCmdFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetDispStats(char* arg, uint16_t len) {
+    char r[224];
+    dispDirtyFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdLayoutBench(char* arg, uint16_t len) {
+    static char r[560];
+    layoutBenchmark(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdMsgBench(char* arg, uint16_t len) {
+    char r[320];
+    inboxBenchmark(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdGetPanelStats(char* arg, uint16_t len) {
+    char r[192];
+    dispBudgetFormatStats(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdFontBench(char* arg, uint16_t len) {
+    char r[96];
+    fontBlitBenchmark(r, sizeof(r));
+    sendNotificationToApp(r);
+}
+
+static void cmdTlvFrame(char* arg, uint16_t len) {
+    protoHandleFrame((const uint8_t*)arg, len);
+}
+
+// ── Command table ──
+// Lookup is a perfect hash over the names: FNV-1a seeded with BLE_CMD_HASH_SEED, top
+// BLE_CMD_SLOT_BITS bits pick the slot. Both the slot map and the collision check are evaluated
+// by the compiler — if a new command trips the static_assert, try the next seed.
+
+typedef void (*BleCmdHandler)(char* arg, uint16_t len);
+
+#define BLE_CMD_ARG         0x01    // Needs a ":value" — ignored when sent bare
+
+struct BleCmd {
+    const char*   name;
+    BleCmdHandler fn;
+    uint8_t       flags;
+};
+
+static constexpr BleCmd ble_cmds[] = {
+    { "SETMODE",      cmdSetMode,      BLE_CMD_ARG },
+    { "SENDTXT",      cmdSendTxt,      BLE_CMD_ARG },
+    { "SETNAME",      cmdSetName,      BLE_CMD_ARG },
+    { "SETBUDDY",     cmdSetBuddy,     BLE_CMD_ARG },
+    { "GETBUDDY",     cmdGetBuddy,     0 },
+    { "GETSCREEN",    cmdGetScreen,    0 },
+    { "BENCH",        cmdBench,        0 },
+    { "GETSTATUS",    cmdGetStatus,    0 },
+    { "GETSETTINGS",  cmdGetSettings,  0 },
+    { "SETSETTINGS",  cmdSetSettings,  BLE_CMD_ARG },
+    { "SYNCACK",      cmdSyncAck,      BLE_CMD_ARG },
+    { "GETSYNCSTATS", cmdGetSyncStats, 0 },
+    { "GETCMDSTATS",  cmdGetCmdStats,  0 },
+    { "GETDISPSTATS", cmdGetDispStats, 0 },
+    { "FONTBENCH",    cmdFontBench,    0 },
+    { "GETPANELSTATS", cmdGetPanelStats, 0 },
+    { "LAYOUTBENCH",  cmdLayoutBench,  0 },
+    { "MSGBENCH",     cmdMsgBench,     0 },
+    { "GETDIRSTATS",  cmdGetDirStats,  0 },
+    { "PCAP",         cmdPcap,         0 },
+    { "GETCAPSTATS",  cmdGetCapStats,  0 },
+    { "TRKDUMP",      cmdTrkDump,      0 },
+    { "GETTRKSTATS",  cmdGetTrkStats,  0 },
+    { "GETWPSTATS",   cmdGetWpStats,   0 },
+    { "GEOBENCH",     cmdGeoBench,     0 },
+    { "GETBCNSTATS",  cmdGetBcnStats,  0 },
+    { "GETROSTER",    cmdGetRoster,    0 },
+    { "GETCLOCK",     cmdGetClock,     0 },
+    { "GETGNSS",      cmdGetGnss,      0 },
+    { "GNSSCFG",      cmdGnssCfg,      BLE_CMD_ARG },
+    { "GETMESH",      cmdGetMesh,      0 },
+};
+static constexpr uint8_t BLE_CMD_COUNT = sizeof(ble_cmds) / sizeof(ble_cmds[0]);
+static constexpr uint8_t BLE_CMD_TLV = BLE_CMD_COUNT;  // Binary frames share the queue and stats
+
+#define BLE_CMD_HASH_SEED   13u
+#define BLE_CMD_SLOT_BITS   6
+#define BLE_CMD_NONE        0xFF
+
+static constexpr uint32_t cmdHash(const char* s, uint32_t h = BLE_CMD_HASH_SEED) {
+    return *s ? cmdHash(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+
+static constexpr uint8_t cmdSlot(const char* s) {
+    return (uint8_t)(cmdHash(s) >> (32 - BLE_CMD_SLOT_BITS));
+}
+
+static constexpr bool cmdSlotsUnique(uint8_t i = 0, uint8_t j = 1) {
+    return i >= BLE_CMD_COUNT ? true
+         : j >= BLE_CMD_COUNT ? cmdSlotsUnique(i + 1, i + 2)
+         : cmdSlot(ble_cmds[i].name) != cmdSlot(ble_cmds[j].name) && cmdSlotsUnique(i, j + 1);
+}
+static_assert(cmdSlotsUnique(), "BLE command hash collision — change BLE_CMD_HASH_SEED");
+static_assert(BLE_CMD_COUNT < BLE_CMD_NONE, "too many BLE commands");
+
+static constexpr uint8_t cmdAt(uint8_t slot, uint8_t i = 0) {
+    return i >= BLE_CMD_COUNT ? BLE_CMD_NONE : cmdSlot(ble_cmds[i].name) == slot ? i : cmdAt(slot, i + 1);
+}
+
+#define S4(n) cmdAt(n), cmdAt(n + 1), cmdAt(n + 2), cmdAt(n + 3)
+static constexpr uint8_t ble_cmd_slots[1 << BLE_CMD_SLOT_BITS] = {
+    S4(0),  S4(4),  S4(8),  S4(12), S4(16), S4(20), S4(24), S4(28),
+    S4(32), S4(36), S4(40), S4(44), S4(48), S4(52), S4(56), S4(60)
+};
+#undef S4
+
+// Runtime lookup of a name of `len` bytes (not NUL-terminated)
+static uint8_t cmdLookup(const char* name, uint16_t len) {
+    uint32_t h = BLE_CMD_HASH_SEED;
+    for (uint16_t i = 0; i < len; i++) h = (h ^ (uint8_t)name[i]) * 16777619u;
+    uint8_t idx = ble_cmd_slots[h >> (32 - BLE_CMD_SLOT_BITS)];
+    if (idx == BLE_CMD_NONE) return BLE_CMD_NONE;
+    const char* n = ble_cmds[idx].name;
+    if (strncmp(n, name, len) != 0 || n[len] != '\0') return BLE_CMD_NONE;
+    return idx;
+}
+
+// ── Queue ── (single producer: SoftDevice callback, single consumer: loop)
+
+struct BleCmdEntry {
+    uint8_t  cmd;
+    uint16_t len;
+    uint32_t queued_us;
+    char     arg[BLE_CMD_ARG_MAX + 1];
+};
+
+static BleCmdEntry cmd_queue[BLE_CMD_QUEUE_LEN];
+static volatile uint8_t cmd_head = 0;   // Next slot to fill (callback)
+static volatile uint8_t cmd_tail = 0;   // Next slot to run (loop)
+
+struct BleCmdStats {
+    uint16_t runs;
+    uint16_t busy;          // Refused because the queue was full
+    uint32_t total_us;
+    uint32_t max_us;
+    uint32_t max_wait_us;   // Queued → started
+};
+
+static BleCmdStats cmd_stats[BLE_CMD_COUNT + 1];
+static uint16_t cmd_unknown = 0;
+static uint8_t cmd_depth_max = 0;
+
+uint8_t bleCmdPending() {
+    return (uint8_t)(cmd_head - cmd_tail);
+}
+
+static bool cmdPush(uint8_t cmd, const char* arg, uint16_t len) {
+    if (bleCmdPending() >= BLE_CMD_QUEUE_LEN) {
+        cmd_stats[cmd].busy++;
+        return false;
+    }
+    BleCmdEntry& e = cmd_queue[cmd_head % BLE_CMD_QUEUE_LEN];
+    if (len > BLE_CMD_ARG_MAX) len = BLE_CMD_ARG_MAX;
+    e.cmd = cmd;
+    e.len = len;
+    e.queued_us = micros();
+    memcpy(e.arg, arg, len);
+    e.arg[len] = '\0';
+    __DMB();    // Entry must be complete before the loop can see it
+    cmd_head++;
+    uint8_t depth = bleCmdPending();
+    if (depth > cmd_depth_max) cmd_depth_max = depth;
+    return true;
+}
+
+bool bleCmdSubmitText(const char* buf, uint16_t len) {
+    uint16_t nlen = 0;
+    while (nlen < len && buf[nlen] != ':') nlen++;
+    bool has_arg = nlen < len;
+
+    uint8_t cmd = cmdLookup(buf, nlen);
+    if (cmd == BLE_CMD_NONE || (!has_arg && (ble_cmds[cmd].flags & BLE_CMD_ARG))) {
+        cmd_unknown++;
+        return false;
+    }
+
+    uint16_t vstart = has_arg ? nlen + 1 : len;
+    if (!cmdPush(cmd, buf + vstart, len - vstart)) {
+        // Back-pressure — the app retries; nothing slow runs here
+        char r[40];
+        snprintf(r, sizeof(r), "ERR{BUSY:%s}", ble_cmds[cmd].name);
+        sendNotificationToApp(r);
+    }
+    return true;
+}
+
+void bleCmdSubmitFrame(const uint8_t* buf, uint16_t len) {
+    if (!cmdPush(BLE_CMD_TLV, (const char*)buf, len)) {
+        protoReplyError(buf[3], PROTO_OP_PING, PROTO_ERR_BUSY);
+    }
+}
+
+void bleCmdRun() {
+    if (cmd_head == cmd_tail) return;
+    __DMB();
+    BleCmdEntry& e = cmd_queue[cmd_tail % BLE_CMD_QUEUE_LEN];
+
+    uint32_t t0 = micros();
+    BleCmdStats& st = cmd_stats[e.cmd];
+    uint32_t wait = t0 - e.queued_us;
+    if (wait > st.max_wait_us) st.max_wait_us = wait;
+
+    if (e.cmd == BLE_CMD_TLV) {
+        cmdTlvFrame(e.arg, e.len);
+    } else {
+        ble_cmds[e.cmd].fn(e.arg, e.len);
+    }
+
+    uint32_t dt = micros() - t0;
+    st.runs++;
+    st.total_us += dt;
+    if (dt > st.max_us) st.max_us = dt;
+    cmd_tail++;     // Release the slot only after the handler is done with e.arg
+}
+
+int bleCmdFormatStats(char* out, size_t out_len) {
+    int off = snprintf(out, out_len, "OK{CMDSTATS:");
+    for (uint8_t i = 0; i <= BLE_CMD_COUNT && off < (int)out_len; i++) {
+        const BleCmdStats& st = cmd_stats[i];
+        if (st.runs == 0 && st.busy == 0) continue;
+        off += snprintf(out + off, out_len - off, "%s=%u,%lu,%lu,%lu,%u;",
+                        i == BLE_CMD_TLV ? "TLV" : ble_cmds[i].name, st.runs,
+                        (unsigned long)(st.runs ? st.total_us / st.runs : 0), (unsigned long)st.max_us,
+                        (unsigned long)st.max_wait_us, st.busy);
+    }
+    if (off < (int)out_len) off += snprintf(out + off, out_len - off, "unknown=%u,depth_max=%u}", cmd_unknown, cmd_depth_max);
+    return off;
+}
@@ -0,0 +1,28 @@
+#ifndef BLE_CMD_H
+#define BLE_CMD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Companion-app command dispatcher.
+// onCharacteristicWritten() only looks the command up (perfect hash, one strcmp) and copies it
+// into a bounded queue; handlers run later from handleBLE() in loop context, so nothing slow
+// (radio re-init, LoRa TX, display redraw) ever executes inside the SoftDevice callback.
+// When the queue is full the write is refused with ERR{BUSY:<CMD>} (or PROTO_ERR_BUSY for TLV).
+
+#define BLE_CMD_QUEUE_LEN   4
+#define BLE_CMD_ARG_MAX     256
+
+// Callback context — returns false if the text isn't a known command
+bool bleCmdSubmitText(const char* buf, uint16_t len);
+// Callback context — binary TLV request frame (tlvIsFrame() already checked)
+void bleCmdSubmitFrame(const uint8_t* buf, uint16_t len);
+
+// Loop context — run the oldest queued command, if any
+void bleCmdRun();
+uint8_t bleCmdPending();
+
+// "OK{CMDSTATS:NAME=runs,avg_us,max_us,max_wait_us,busy;...}"
+int bleCmdFormatStats(char* out, size_t out_len);
+
+#endif // BLE_CMD_H
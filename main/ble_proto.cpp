@@ -0,0 +1,291 @@
+#include "ble_proto.h"
+#include "ble.h"
+#include "settings.h"
+#include "app_modes.h"
+#include "buddy_list.h"
+#include "battery.h"
+#include "gps.h"
+#include "lora.h"
+#include "epoch_clock.h"
+#include "mesh_relay.h"
+
+#include <Arduino.h>
+
+// ── Setting table ──
+// One row per companion-visible setting; both the TLV ops and the legacy text
+// GETSETTINGS / SETSETTINGS walk this table, so the two can't drift apart.
+struct ProtoSetting {
+    uint8_t     id;         // ProtoField
+    const char* key;        // Text-protocol key
+    bool        reinit;     // Radio must be re-initialised after a change
+};
+
+static const ProtoSetting proto_settings[] = {
+    { PF_SF,      "SF",      false },
+    { PF_BITRATE, "BITRATE", true  },
+    { PF_CHAN,    "CHAN",    true  },
+    { PF_VOL,     "VOL",     false },
+    { PF_BL,      "BL",      false },
+    { PF_BW,      "BW",      true  },
+    { PF_CR,      "CR",      true  },
+    { PF_FH,      "FH",      false },
+    { PF_HOUR,    "HOUR",    false },
+    { PF_MIN,     "MIN",     false },
+    { PF_SEC,     "SEC",     false },
+    { PF_MESH,    "MESH",    false },
+    { PF_TTL,     "TTL",     false },
+};
+static const uint8_t PROTO_SETTING_COUNT = sizeof(proto_settings) / sizeof(proto_settings[0]);
+
+static int32_t settingGet(uint8_t id) {
+    switch (id) {
+        case PF_SF:      return deviceSettings.spreading_factor;
+        case PF_BITRATE: return deviceSettings.bitrate_idx;
+        case PF_CHAN:    return deviceSettings.channel_idx;
+        case PF_VOL:     return deviceSettings.volume_level;
+        case PF_BL:      return deviceSettings.backlight ? 1 : 0;
+        case PF_BW:      return deviceSettings.bandwidth_idx;
+        case PF_CR:      return deviceSettings.coding_rate_idx;
+        case PF_FH:      return deviceSettings.frequency_hopping_enabled ? 1 : 0;
+        case PF_HOUR:    return deviceSettings.hours;
+        case PF_MIN:     return deviceSettings.minutes;
+        case PF_SEC:     return deviceSettings.seconds;
+        case PF_MESH:    return deviceSettings.mesh_enabled ? 1 : 0;
+        case PF_TTL:     return deviceSettings.mesh_ttl;
+        default:         return 0;
+    }
+}
+
+// Returns false for unknown ids or out-of-range values (nothing is changed)
+static bool settingSet(uint8_t id, int32_t v) {
+    switch (id) {
+        case PF_SF:      if (v < 6 || v > 12) return false; deviceSettings.spreading_factor = v; return true;
+        case PF_BITRATE: if (v < 0 || v >= (int32_t)num_bitrate_modes) return false; deviceSettings.bitrate_idx = v; return true;
+        case PF_CHAN:    if (v < 0 || v >= (int32_t)strlen(channels)) return false; deviceSettings.channel_idx = v; return true;
+        case PF_VOL:     if (v < 1 || v > 10) return false; deviceSettings.volume_level = v; return true;
+        case PF_BL:      deviceSettings.backlight = (v != 0); return true;
+        case PF_BW:      if (!validBandwidth((uint32_t)v)) return false; deviceSettings.bandwidth_idx = v; return true;
+        case PF_CR:      if (v < CR_5 || v > CR_8) return false; deviceSettings.coding_rate_idx = v; return true;
+        case PF_FH:      deviceSettings.frequency_hopping_enabled = (v != 0); return true;
+        case PF_HOUR:    if (v < 0 || v > 23) return false; deviceSettings.hours = v; return true;
+        case PF_MIN:     if (v < 0 || v > 59) return false; deviceSettings.minutes = v; return true;
+        case PF_SEC:     if (v < 0 || v > 59) return false; deviceSettings.seconds = v; return true;
+        case PF_MESH:    deviceSettings.mesh_enabled = (v != 0); return true;
+        case PF_TTL:     if (v < 1 || v > MESH_TTL_MAX) return false; deviceSettings.mesh_ttl = v; return true;
+        default:         return false;
+    }
+}
+
+static const ProtoSetting* settingById(uint8_t id) {
+    for (uint8_t i = 0; i < PROTO_SETTING_COUNT; i++) {
+        if (proto_settings[i].id == id) return &proto_settings[i];
+    }
+    return nullptr;
+}
+
+bool protoApplySettingText(const char* key, const char* val, bool& needReinit) {
+    for (uint8_t i = 0; i < PROTO_SETTING_COUNT; i++) {
+        if (strcmp(key, proto_settings[i].key) != 0) continue;
+        // Channel travels as a letter in the text protocol, as an index in TLV
+        int32_t v = (proto_settings[i].id == PF_CHAN) ? (toupper(val[0]) - 'A') : atoi(val);
+        if (!settingSet(proto_settings[i].id, v)) return false;
+        if (proto_settings[i].reinit) needReinit = true;
+        return true;
+    }
+    return false;
+}
+
+int protoFormatSettingsText(char* out, size_t out_len) {
+    int off = snprintf(out, out_len, "OK{SETTINGS:");
+    for (uint8_t i = 0; i < PROTO_SETTING_COUNT && off < (int)out_len; i++) {
+        const ProtoSetting& s = proto_settings[i];
+        if (s.id == PF_CHAN) {
+            off += snprintf(out + off, out_len - off, "%s%s=%c", i ? "," : "", s.key, channels[deviceSettings.channel_idx]);
+        } else {
+            off += snprintf(out + off, out_len - off, "%s%s=%ld", i ? "," : "", s.key, (long)settingGet(s.id));
+        }
+    }
+    if (off < (int)out_len) off += snprintf(out + off, out_len - off, "}");
+    return off;
+}
+
+// ── Request execution ──
+// Side effects happen once in protoExecute(); protoEmit() only reads state, so it can be
+// re-run into a fresh frame when the current one is full.
+
+struct ProtoResult {
+    uint8_t err;
+    uint8_t count;
+};
+
+static ProtoResult protoExecute(uint8_t op, TlvCursor fields) {
+    ProtoResult res = { PROTO_ERR_NONE, 0 };
+    TlvField f;
+
+    switch (op) {
+        case PROTO_OP_PING:
+        case PROTO_OP_GET_SETTINGS:
+        case PROTO_OP_GET_STATUS:
+        case PROTO_OP_GET_SCREEN:
+            break;
+
+        case PROTO_OP_SET_SETTINGS: {
+            bool needReinit = false;
+            while (tlvNextField(fields, f)) {
+                const ProtoSetting* s = settingById(f.tag & ~TLV_WT_MASK);
+                if (!s || (f.tag & TLV_WT_MASK) == TLV_WT_BYTES) continue;
+                if (!settingSet(s->id, (int32_t)f.u)) { res.err = PROTO_ERR_BAD_ARG; continue; }
+                if (s->reinit) needReinit = true;
+                res.count++;
+            }
+            if (needReinit) setupLoRa();
+            break;
+        }
+
+        case PROTO_OP_SET_MODE:
+            res.err = PROTO_ERR_BAD_ARG;
+            while (tlvNextField(fields, f)) {
+                if (f.tag == TLV_TAG(TLV_WT_U8, PF_MODE) && f.u < (uint32_t)numModes) {
+                    switchMode(String(modes[f.u]));
+                    res.err = PROTO_ERR_NONE;
+                }
+            }
+            break;
+
+        case PROTO_OP_SEND_TXT:
+        case PROTO_OP_SET_NAME: {
+            res.err = PROTO_ERR_BAD_ARG;
+            uint8_t want = (op == PROTO_OP_SEND_TXT) ? TLV_TAG(TLV_WT_BYTES, PF_TEXT) : TLV_TAG(TLV_WT_BYTES, PF_NAME);
+            while (tlvNextField(fields, f)) {
+                if (f.tag != want || f.len == 0) continue;
+                static char text[256];
+                tlvCopyStr(f, text, op == PROTO_OP_SET_NAME ? 32 : sizeof(text));
+                if (op == PROTO_OP_SEND_TXT) sendTxtMessage(text);
+                else buddySetDisplayName(text);
+                res.err = PROTO_ERR_NONE;
+            }
+            break;
+        }
+
+        default:
+            res.err = PROTO_ERR_UNKNOWN_OP;
+            break;
+    }
+    return res;
+}
+
+static void protoEmit(TlvWriter& w, uint8_t op, const ProtoResult& res) {
+    if (res.err != PROTO_ERR_NONE) {
+        tlvBeginMsg(w, PROTO_OP_ERROR | TLV_OP_RESP);
+        tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_OP), op);
+        tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_ERR), res.err);
+        tlvEndMsg(w);
+        return;
+    }
+
+    tlvBeginMsg(w, op | TLV_OP_RESP);
+    switch (op) {
+        case PROTO_OP_GET_SETTINGS:
+            for (uint8_t i = 0; i < PROTO_SETTING_COUNT; i++) {
+                uint8_t id = proto_settings[i].id;
+                if (id == PF_BW) tlvPutU32(w, TLV_TAG(TLV_WT_U32, id), (uint32_t)settingGet(id));  // Hz
+                else tlvPutU8(w, TLV_TAG(TLV_WT_U8, id), (uint8_t)settingGet(id));
+            }
+            break;
+
+        case PROTO_OP_SET_SETTINGS:
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_COUNT), res.count);
+            break;
+
+        case PROTO_OP_GET_STATUS:
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_BLE), 1);
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_LORA), isPeerAlive() ? 1 : 0);
+            break;
+
+        case PROTO_OP_GET_SCREEN: {
+            uint8_t mi = 0;
+            for (int i = 0; i < numModes; i++) {
+                if (strcmp(current_mode, modes[i]) == 0) { mi = (uint8_t)i; break; }
+            }
+            RTC_Date now = clockDateTime();
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_MODE), mi);
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_CHAN), (uint8_t)deviceSettings.channel_idx);
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_SF), (uint8_t)deviceSettings.spreading_factor);
+            tlvPutU16(w, TLV_TAG(TLV_WT_U16, PF_BITRATE_BPS), (uint16_t)getBitrateFromIndex(deviceSettings.bitrate_idx));
+            tlvPutU32(w, TLV_TAG(TLV_WT_U32, PF_FREQ_KHZ), (uint32_t)(currentFrequency * 1000.0f + 0.5f));
+            tlvPutU16(w, TLV_TAG(TLV_WT_U16, PF_TIME_MIN), (uint16_t)(now.hour * 60 + now.minute));
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_SATS), (uint8_t)gps_satellites);
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_BATT), getBatteryPercentage());
+            tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_GPS_FIX), gps_status == GPS_LOC ? 1 : 0);
+            break;
+        }
+
+        default:    // PING, SET_MODE, SEND_TXT, SET_NAME — bare ack
+            break;
+    }
+    tlvEndMsg(w);
+}
+
+// Response frames are built in place and handed to the notification ring as raw PRI records
+static uint8_t proto_reply_buf[256];
+static uint8_t proto_probe_buf[256];    // Whether a response fits a frame of its own
+
+static void protoFlush(TlvWriter& w, uint8_t req_id, uint16_t cap, bool more) {
+    uint16_t n = tlvFinishFrame(w, more);
+    if (w.count > 0 || !more) sendRawNotification(proto_reply_buf, n);
+    tlvBeginFrame(w, proto_reply_buf, cap, req_id);
+}
+
+void protoReplyError(uint8_t req_id, uint8_t op, uint8_t err) {
+    TlvWriter w;
+    uint16_t cap = bleNotifyPayloadMax();
+    if (cap > sizeof(proto_reply_buf)) cap = sizeof(proto_reply_buf);
+    tlvBeginFrame(w, proto_reply_buf, cap, req_id);
+    ProtoResult res = { err, 0 };
+    protoEmit(w, op, res);
+    sendRawNotification(proto_reply_buf, tlvFinishFrame(w, false));
+}
+
+void protoHandleFrame(const uint8_t* data, uint16_t len) {
+    TlvFrame frame;
+    if (!tlvParseFrame(data, len, frame)) return;
+
+    if (frame.version != TLV_VERSION) {
+        protoReplyError(frame.req_id, PROTO_OP_PING, PROTO_ERR_VERSION);
+        return;
+    }
+
+    uint16_t cap = bleNotifyPayloadMax();
+    if (cap > sizeof(proto_reply_buf)) cap = sizeof(proto_reply_buf);
+
+    TlvWriter w;
+    tlvBeginFrame(w, proto_reply_buf, cap, frame.req_id);
+
+    uint8_t op;
+    TlvCursor fields;
+    uint8_t handled = 0;
+    while (handled < frame.count && tlvNextMsg(frame.body, op, fields)) {
+        handled++;
+        ProtoResult res = protoExecute(op, fields);
+        protoEmit(w, op, res);
+        if (!w.overflow) continue;
+        w.overflow = false;     // The open message was rolled back
+
+        // A single response larger than the MTU — report it instead of truncating, in this frame
+        // if the error still fits
+        TlvWriter probe;
+        tlvBeginFrame(probe, proto_probe_buf, cap, frame.req_id);
+        protoEmit(probe, op, res);
+        if (probe.overflow) {
+            res.err = PROTO_ERR_BAD_ARG;
+            protoEmit(w, op, res);
+            if (!w.overflow) continue;
+            w.overflow = false;
+        }
+
+        // Frame full — send what we have and put this response in a fresh frame
+        protoFlush(w, frame.req_id, cap, true);
+        protoEmit(w, op, res);
+    }
+    protoFlush(w, frame.req_id, cap, false);
+}
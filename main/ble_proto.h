@@ -0,0 +1,64 @@
+#ifndef BLE_PROTO_H
+#define BLE_PROTO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "tlv_codec.h"
+
+// Companion-app control protocol (binary TLV, see tlv_codec.h for framing).
+// A request frame may batch several ops; all responses go back in as few frames as the
+// negotiated MTU allows, tagged with the request's req_id (TLV_FLAG_MORE on all but the last).
+// The legacy text commands (GETSETTINGS, SETSETTINGS:..) map onto the same setting table.
+
+enum ProtoOp : uint8_t {
+    PROTO_OP_PING           = 0x00,
+    PROTO_OP_GET_SETTINGS   = 0x01,
+    PROTO_OP_SET_SETTINGS   = 0x02,
+    PROTO_OP_GET_STATUS     = 0x03,
+    PROTO_OP_GET_SCREEN     = 0x04,
+    PROTO_OP_SET_MODE       = 0x05,
+    PROTO_OP_SEND_TXT       = 0x06,
+    PROTO_OP_SET_NAME       = 0x07,
+    PROTO_OP_ERROR          = 0x7F  // Response only: F_ERR carries ProtoErr
+};
+
+// Field ids — combine with a wire type through TLV_TAG()
+enum ProtoField : uint8_t {
+    // Settings (U8, except PF_BW: U32 Hz)
+    PF_SF = 1, PF_BITRATE, PF_CHAN, PF_VOL, PF_BL, PF_BW, PF_CR, PF_FH, PF_HOUR, PF_MIN, PF_SEC, PF_MESH, PF_TTL,
+    // Status
+    PF_BLE = 16, PF_LORA,
+    // Screen header / status bar
+    PF_MODE = 20,       // U8 index into modes[]
+    PF_FREQ_KHZ,        // U32
+    PF_TIME_MIN,        // U16 minutes since midnight
+    PF_SATS,            // U8
+    PF_BATT,            // U8 percent
+    PF_GPS_FIX,         // U8 0/1
+    PF_BITRATE_BPS,     // U16
+    // Payloads
+    PF_TEXT = 32,       // BYTES
+    PF_NAME,            // BYTES
+    // Replies
+    PF_ERR = 60,        // U8 ProtoErr
+    PF_OP,              // U8 — op an error refers to
+    PF_COUNT            // U8 — e.g. number of settings applied
+};
+
+enum ProtoErr : uint8_t {
+    PROTO_ERR_NONE = 0,
+    PROTO_ERR_VERSION,      // Unsupported frame version
+    PROTO_ERR_UNKNOWN_OP,
+    PROTO_ERR_BAD_ARG,
+    PROTO_ERR_BUSY          // Previous request still pending
+};
+
+// Handle one complete TLV request frame — call from loop context, not the SoftDevice callback
+void protoHandleFrame(const uint8_t* data, uint16_t len);
+void protoReplyError(uint8_t req_id, uint8_t op, uint8_t err);
+
+// Shared setting table, also used by the text compatibility layer
+bool protoApplySettingText(const char* key, const char* val, bool& needReinit);
+int  protoFormatSettingsText(char* out, size_t out_len);
+
+#endif // BLE_PROTO_H
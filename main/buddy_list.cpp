@@ -1,178 +1,496 @@
 #include "buddy_list.h"
+#include "qspi_flash.h"
 #include <cstring>
 #include <cstdint>
 
-static volatile uint8_t* buddy_base = nullptr;
+#define BUDDY_PAGE_MAGIC    0x59444442  // 'BDDY'
+#define BUDDY_PAGE_FORMAT   2           // 1: 8-byte device_id, too short for an 8-digit ID
+#define IDX_EMPTY           0x0000      // Index entries hold slot + 1
+#define IDX_TOMB            0xFFFF
+#define BUDDY_SELF_ID       "SELF"
+
+static_assert((BUDDY_INDEX_SIZE & (BUDDY_INDEX_SIZE - 1)) == 0, "BUDDY_INDEX_SIZE must be a power of two");
+static_assert(BUDDY_INDEX_SIZE >= 2 * BUDDY_MAX_CONTACTS, "hash index load factor above 1/2");
+static_assert(BUDDY_MAX_CONTACTS < IDX_TOMB, "slot numbers must fit an index entry");
+static_assert(BUDDY_PAGES <= 16, "dirty mask is 16 bits");
+static_assert(2 * BUDDY_PAGES <= QSPI_BUDDY_SECTORS, "QSPI_BUDDY_SECTORS too small for two copies per page");
+
+struct __attribute__((packed)) BuddyPageHdr {
+    uint32_t magic;         // BUDDY_PAGE_MAGIC
+    uint32_t seq;           // Newer copy wins
+    uint32_t check;         // FNV-1a over the page's records
+    uint16_t page;
+    uint16_t count;         // Used records (statistics)
+    uint16_t format;        // BUDDY_PAGE_FORMAT; 0 (padding) in format 1
+    uint8_t  _pad[14];
+};
+
+struct __attribute__((packed)) BuddyFlashRec {
+    BuddyContact c;
+    uint8_t  used;
+    uint8_t  _pad[CONTACT_SLOT_SIZE - sizeof(BuddyContact) - 1];
+};
+
+static_assert(sizeof(BuddyPageHdr) == CONTACT_SLOT_SIZE, "page header is one record long");
+static_assert(sizeof(BuddyFlashRec) == CONTACT_SLOT_SIZE, "flash record size");
+static_assert(sizeof(BuddyPageHdr) + BUDDY_PAGE_RECORDS * sizeof(BuddyFlashRec) <= FLASH_SECTOR_SIZE, "page overflows a sector");
+
+static BuddyContact s_contacts[BUDDY_MAX_CONTACTS];
+static uint8_t  s_used[(BUDDY_MAX_CONTACTS + 7) / 8];
+static uint8_t  s_ref[(BUDDY_MAX_CONTACTS + 7) / 8];   // Clock bit: used since the hand last passed
+static uint16_t s_by_id[BUDDY_INDEX_SIZE];
+static uint16_t s_by_sign[BUDDY_INDEX_SIZE];
+static uint16_t s_count = 0;
+static uint16_t s_tombs = 0;
+static uint16_t s_hand = 0;
+
+static const FlashOps* s_ops = nullptr;    // nullptr = RAM only
+static uint32_t s_page_seq[BUDDY_PAGES];
+static uint8_t  s_page_copy[BUDDY_PAGES];  // Copy holding the current contents
+static uint16_t s_dirty = 0;                // Bit per page
+static uint32_t s_dirty_since = 0;
+static uint32_t s_last_change = 0;
 static bool g_buddy_inited = false;
 
-#define MAGIC_BDLY 0x42444C59  // 'BDLY'
+// Stats
+static uint32_t s_pages_written = 0;
+static uint32_t s_lookups = 0;
+static uint16_t s_probe_max = 0;
+static uint32_t s_evicted = 0;
+static uint16_t s_rebuilds = 0;
+static uint32_t s_mount_ms = 0;
+
+static bool bitGet(const uint8_t* m, uint16_t i) { return m[i >> 3] & (1 << (i & 7)); }
+static void bitSet(uint8_t* m, uint16_t i) { m[i >> 3] |= 1 << (i & 7); }
+static void bitClr(uint8_t* m, uint16_t i) { m[i >> 3] &= ~(1 << (i & 7)); }
 
-inline static BuddyHeader* _bhdr() {
-    return (BuddyHeader*)buddy_base;
+static uint32_t fnv(const void* p, uint32_t len, uint32_t h = 2166136261u) {
+    const uint8_t* b = (const uint8_t*)p;
+    for (uint32_t i = 0; i < len; i++) {
+        h ^= b[i];
+        h *= 16777619u;
+    }
+    return h;
 }
 
-inline static BuddyContact* _contactPtr(uint8_t idx) {
-    uint32_t off = sizeof(BuddyHeader);
-    off += (idx * CONTACT_SLOT_SIZE);
-    return (BuddyContact*)(buddy_base + off);
+static uint32_t strHash(const char* s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
 }
 
-void buddyInit() {
-    buddy_base = (volatile uint8_t*)BUDDY_RAM_BASE;
-    
-    if (_bhdr()->magic != MAGIC_BDLY) {
-        memset((void*)buddy_base, 0, sizeof(BuddyHeader) + (BUDDY_MAX_CONTACTS * CONTACT_SLOT_SIZE));
-        _bhdr()->magic = MAGIC_BDLY;
-        _bhdr()->count = 0;
+// ── Hash indexes ──
+
+static const char* keyOf(const uint16_t* idx, uint16_t slot) {
+    return idx == s_by_id ? s_contacts[slot].device_id : s_contacts[slot].call_sign;
+}
+
+// Index position of `key` (optionally: the entry for `slot`), or -1
+static int idxFind(const uint16_t* idx, const char* key, int slot = -1) {
+    uint16_t pos = strHash(key) & (BUDDY_INDEX_SIZE - 1);
+    for (uint16_t n = 0; n < BUDDY_INDEX_SIZE; n++) {
+        uint16_t e = idx[pos];
+        if (e == IDX_EMPTY) break;
+        if (e != IDX_TOMB && (slot < 0 || e - 1 == slot) && strcmp(keyOf(idx, e - 1), key) == 0) {
+            if (n > s_probe_max) s_probe_max = n;
+            return pos;
+        }
+        pos = (pos + 1) & (BUDDY_INDEX_SIZE - 1);
+    }
+    return -1;
+}
+
+static void idxInsert(uint16_t* idx, const char* key, uint16_t slot) {
+    uint16_t pos = strHash(key) & (BUDDY_INDEX_SIZE - 1);
+    while (idx[pos] != IDX_EMPTY && idx[pos] != IDX_TOMB) pos = (pos + 1) & (BUDDY_INDEX_SIZE - 1);
+    if (idx[pos] == IDX_TOMB) s_tombs--;
+    idx[pos] = slot + 1;
+}
+
+static void idxRemove(uint16_t* idx, const char* key, uint16_t slot) {
+    int pos = idxFind(idx, key, slot);
+    if (pos < 0) return;
+    // A tombstone is only needed if a probe chain continues past this entry
+    if (idx[(pos + 1) & (BUDDY_INDEX_SIZE - 1)] == IDX_EMPTY) {
+        idx[pos] = IDX_EMPTY;
+    } else {
+        idx[pos] = IDX_TOMB;
+        s_tombs++;
+    }
+}
+
+static void idxRebuild() {
+    memset(s_by_id, 0, sizeof(s_by_id));
+    memset(s_by_sign, 0, sizeof(s_by_sign));
+    s_tombs = 0;
+    for (uint16_t i = 0; i < BUDDY_MAX_CONTACTS; i++) {
+        if (!bitGet(s_used, i)) continue;
+        idxInsert(s_by_id, s_contacts[i].device_id, i);
+        if (s_contacts[i].call_sign[0]) idxInsert(s_by_sign, s_contacts[i].call_sign, i);
+    }
+    s_rebuilds++;
+}
+
+static int findById(const char* deviceId) {
+    int pos = idxFind(s_by_id, deviceId);
+    return pos < 0 ? -1 : s_by_id[pos] - 1;
+}
+
+// ── Flash pages ──
+
+static uint32_t copyAddr(uint8_t page, uint8_t copy) {
+    return QSPI_BUDDY_BASE + (uint32_t)(page * 2 + copy) * FLASH_SECTOR_SIZE;
+}
+
+static void markDirty(uint16_t slot) {
+    uint32_t now = millis();
+    if (!s_dirty) s_dirty_since = now;
+    s_dirty |= 1 << (slot / BUDDY_PAGE_RECORDS);
+    s_last_change = now;
+}
+
+static void toRec(uint16_t slot, BuddyFlashRec& r) {
+    memset(&r, 0, sizeof(r));
+    if (slot < BUDDY_MAX_CONTACTS && bitGet(s_used, slot)) {
+        r.c = s_contacts[slot];
+        r.used = 1;
+    }
+}
+
+#define RECS_PER_CHUNK  8   // 256-byte program / read chunks
+
+static bool writePage(uint8_t page) {
+    uint8_t copy = s_page_copy[page] ^ 1;
+    uint32_t addr = copyAddr(page, copy);
+    if (!s_ops->erase(addr)) return false;
+
+    BuddyFlashRec chunk[RECS_PER_CHUNK];
+    uint32_t check = 2166136261u;
+    uint16_t count = 0;
+    uint16_t first = page * BUDDY_PAGE_RECORDS;
+    for (uint16_t i = 0; i < BUDDY_PAGE_RECORDS; i += RECS_PER_CHUNK) {
+        uint16_t n = BUDDY_PAGE_RECORDS - i < RECS_PER_CHUNK ? BUDDY_PAGE_RECORDS - i : RECS_PER_CHUNK;
+        for (uint16_t k = 0; k < n; k++) {
+            toRec(first + i + k, chunk[k]);
+            count += chunk[k].used;
+        }
+        check = fnv(chunk, n * sizeof(BuddyFlashRec), check);
+        if (!s_ops->program(addr + sizeof(BuddyPageHdr) + i * sizeof(BuddyFlashRec), chunk, n * sizeof(BuddyFlashRec))) {
+            return false;
+        }
     }
+
+    // Header last — until it is there the previous copy stays current
+    BuddyPageHdr h;
+    memset(&h, 0, sizeof(h));
+    h.magic = BUDDY_PAGE_MAGIC;
+    h.seq = s_page_seq[page] + 1;
+    h.check = check;
+    h.page = page;
+    h.count = count;
+    h.format = BUDDY_PAGE_FORMAT;
+    if (!s_ops->program(addr, &h, sizeof(h))) return false;
+    s_page_seq[page] = h.seq;
+    s_page_copy[page] = copy;
+    s_pages_written++;
+    return true;
+}
+
+// Load one copy into the table; false (page slots left empty) if it does not verify
+static bool loadCopy(uint8_t page, uint8_t copy, const BuddyPageHdr& h) {
+    uint32_t addr = copyAddr(page, copy);
+    BuddyFlashRec chunk[RECS_PER_CHUNK];
+    uint32_t check = 2166136261u;
+    uint16_t first = page * BUDDY_PAGE_RECORDS;
+    for (uint16_t i = 0; i < BUDDY_PAGE_RECORDS; i += RECS_PER_CHUNK) {
+        uint16_t n = BUDDY_PAGE_RECORDS - i < RECS_PER_CHUNK ? BUDDY_PAGE_RECORDS - i : RECS_PER_CHUNK;
+        if (!s_ops->read(addr + sizeof(BuddyPageHdr) + i * sizeof(BuddyFlashRec), chunk, n * sizeof(BuddyFlashRec))) {
+            return false;
+        }
+        check = fnv(chunk, n * sizeof(BuddyFlashRec), check);
+        for (uint16_t k = 0; k < n; k++) {
+            uint16_t slot = first + i + k;
+            if (slot >= BUDDY_MAX_CONTACTS) continue;
+            if (chunk[k].used && chunk[k].c.device_id[0]) {
+                s_contacts[slot] = chunk[k].c;
+                s_contacts[slot].call_sign[BUDDY_CALL_SIGN_LEN - 1] = '\0';
+                s_contacts[slot].device_id[BUDDY_DEVICE_ID_LEN - 1] = '\0';
+                bitSet(s_used, slot);
+            } else {
+                bitClr(s_used, slot);
+            }
+        }
+    }
+    if (check == h.check) return true;
+    for (uint16_t i = 0; i < BUDDY_PAGE_RECORDS && first + i < BUDDY_MAX_CONTACTS; i++) bitClr(s_used, first + i);
+    return false;
+}
+
+static void mountPage(uint8_t page) {
+    BuddyPageHdr h[2];
+    bool ok[2];
+    for (uint8_t c = 0; c < 2; c++) {
+        ok[c] = s_ops->read(copyAddr(page, c), &h[c], sizeof(h[c])) && h[c].magic == BUDDY_PAGE_MAGIC &&
+                h[c].page == page && h[c].format == BUDDY_PAGE_FORMAT && h[c].seq != 0xFFFFFFFF;
+    }
+    s_page_seq[page] = 0;
+    s_page_copy[page] = 1;      // Fresh page: first write goes to copy 0
+    // Newest copy first, the older one if it does not verify
+    uint8_t order[2] = { 0, 1 };
+    if (ok[1] && (!ok[0] || h[1].seq > h[0].seq)) { order[0] = 1; order[1] = 0; }
+    for (uint8_t k = 0; k < 2; k++) {
+        uint8_t c = order[k];
+        if (!ok[c] || !loadCopy(page, c, h[c])) continue;
+        s_page_seq[page] = ok[0] && ok[1] && h[0].seq > h[1].seq ? h[0].seq : ok[1] ? h[1].seq : h[0].seq;
+        s_page_copy[page] = c;
+        if (k == 1) s_dirty |= 1 << page;   // Newer copy was torn — rewrite it from this one
+        return;
+    }
+}
+
+void buddyInit() {
+    if (g_buddy_inited) return;
     g_buddy_inited = true;
+    uint32_t t0 = millis();
+    memset(s_used, 0, sizeof(s_used));
+    memset(s_ref, 0, sizeof(s_ref));
+    s_ops = qspiFlashInit() ? &qspiFlashOps() : nullptr;
+    if (s_ops) {
+        for (uint8_t p = 0; p < BUDDY_PAGES; p++) mountPage(p);
+        if (s_dirty) s_dirty_since = s_last_change = millis();
+    }
+    s_count = 0;
+    for (uint16_t i = 0; i < BUDDY_MAX_CONTACTS; i++) s_count += bitGet(s_used, i);
+    idxRebuild();
+    s_rebuilds = 0;
+    s_mount_ms = millis() - t0;
+}
+
+void buddyFlush() {
+    if (!s_ops) {
+        s_dirty = 0;
+        return;
+    }
+    for (uint8_t p = 0; p < BUDDY_PAGES; p++) {
+        if ((s_dirty & (1 << p)) && writePage(p)) s_dirty &= ~(1 << p);
+    }
+}
+
+void buddyTick(uint32_t now) {
+    if (!s_dirty) return;
+    if (!s_ops) {
+        s_dirty = 0;
+        return;
+    }
+    if (now - s_last_change < BUDDY_FLUSH_IDLE_MS && now - s_dirty_since < BUDDY_FLUSH_MAX_MS) return;
+    // One page per call — an erase + 4 KiB program is tens of ms
+    for (uint8_t p = 0; p < BUDDY_PAGES; p++) {
+        if (!(s_dirty & (1 << p))) continue;
+        if (writePage(p)) s_dirty &= ~(1 << p);
+        else s_last_change = now;    // Retry after the next idle period
+        break;
+    }
+}
+
+// ── Table ──
+
+static void dropSlot(uint16_t slot) {
+    idxRemove(s_by_id, s_contacts[slot].device_id, slot);
+    if (s_contacts[slot].call_sign[0]) idxRemove(s_by_sign, s_contacts[slot].call_sign, slot);
+    bitClr(s_used, slot);
+    bitClr(s_ref, slot);
+    s_count--;
+    markDirty(slot);
+}
+
+// Free slot, evicting with the clock hand when the table is full
+static int allocSlot() {
+    if (s_count < BUDDY_MAX_CONTACTS) {
+        for (uint16_t i = 0; i < BUDDY_MAX_CONTACTS; i++) {
+            uint16_t s = (s_hand + i) % BUDDY_MAX_CONTACTS;
+            if (!bitGet(s_used, s)) return s;
+        }
+    }
+    for (uint32_t n = 0; n < 2u * BUDDY_MAX_CONTACTS; n++) {
+        uint16_t s = s_hand;
+        s_hand = (s_hand + 1) % BUDDY_MAX_CONTACTS;
+        if (strcmp(s_contacts[s].device_id, BUDDY_SELF_ID) == 0) continue;
+        if (bitGet(s_ref, s)) {
+            bitClr(s_ref, s);
+            continue;
+        }
+        dropSlot(s);
+        s_evicted++;
+        return s;
+    }
+    return -1;
 }
 
 void buddyAddOrUpdate(const char* deviceId, const char* callSign) {
     if (!g_buddy_inited) buddyInit();
-    if (!buddy_base || !deviceId || !callSign) return;
-    
-    int len = strlen(callSign);
+    if (!deviceId || !callSign) return;
+
+    size_t len = strlen(callSign);
     if (len == 0 || len > BUDDY_CALL_SIGN_LEN - 1) return;
-    uint8_t idLen = strlen(deviceId);
+    size_t idLen = strlen(deviceId);
     if (idLen == 0 || idLen > BUDDY_DEVICE_ID_LEN - 1) return;
-    
-    // Check for existing entry — update call_sign in place
-    for (int i = 0; i < _bhdr()->count; i++) {
-        BuddyContact* e = _contactPtr(i);
-        if (strcmp(e->device_id, deviceId) == 0) {
-            strncpy(e->call_sign, callSign, BUDDY_CALL_SIGN_LEN - 1);
-            e->call_sign[BUDDY_CALL_SIGN_LEN - 1] = '\0';
-            return;
-        }
-    }
-    
-    // Add new entry — if full, drop oldest (index 0)
-    if (_bhdr()->count >= BUDDY_MAX_CONTACTS) {
-        _bhdr()->count--;
-        for (int i = 0; i < _bhdr()->count; i++) {
-            BuddyContact* dst = _contactPtr(i);
-            BuddyContact* src = _contactPtr(i + 1);
-            memcpy(dst, src, sizeof(BuddyContact));
-        }
+
+    // Existing entry — runs for every received beacon, so an unchanged call sign writes nothing
+    int slot = findById(deviceId);
+    if (slot >= 0) {
+        bitSet(s_ref, slot);
+        BuddyContact& e = s_contacts[slot];
+        if (strcmp(e.call_sign, callSign) == 0) return;
+        if (e.call_sign[0]) idxRemove(s_by_sign, e.call_sign, slot);
+        memset(e.call_sign, 0, sizeof(e.call_sign));
+        memcpy(e.call_sign, callSign, len);
+        idxInsert(s_by_sign, e.call_sign, slot);
+        markDirty(slot);
+        if (s_tombs > BUDDY_INDEX_SIZE / 4) idxRebuild();
+        return;
     }
-    
-    int idx = _bhdr()->count++;
-    BuddyContact* e = _contactPtr(idx);
-    memset(e, 0, sizeof(BuddyContact));
-    strncpy(e->call_sign, callSign, BUDDY_CALL_SIGN_LEN - 1);
-    strncpy(e->device_id, deviceId, BUDDY_DEVICE_ID_LEN - 1);
+
+    slot = allocSlot();
+    if (slot < 0) return;
+    BuddyContact& e = s_contacts[slot];
+    memset(&e, 0, sizeof(e));
+    memcpy(e.call_sign, callSign, len);
+    memcpy(e.device_id, deviceId, idLen);
+    bitSet(s_used, slot);
+    bitSet(s_ref, slot);
+    s_count++;
+    idxInsert(s_by_id, e.device_id, slot);
+    idxInsert(s_by_sign, e.call_sign, slot);
+    markDirty(slot);
+    if (s_tombs > BUDDY_INDEX_SIZE / 4) idxRebuild();
+}
+
+bool buddyRemove(const char* deviceId) {
+    if (!g_buddy_inited) buddyInit();
+    if (!deviceId) return false;
+    int slot = findById(deviceId);
+    if (slot < 0) return false;
+    dropSlot(slot);
+    if (s_tombs > BUDDY_INDEX_SIZE / 4) idxRebuild();
+    return true;
+}
+
+uint16_t buddyCount() {
+    if (!g_buddy_inited) buddyInit();
+    return s_count;
 }
 
 const char* buddyLookupName(const char* deviceId) {
     if (!g_buddy_inited) buddyInit();
-    if (!buddy_base || !deviceId) return "";
-    
-    for (int i = 0; i < _bhdr()->count; i++) {
-        BuddyContact* e = _contactPtr(i);
-        if (strcmp(e->device_id, deviceId) == 0 && e->call_sign[0] != '\0') {
-            return e->call_sign;
-        }
-    }
-    return "";
+    if (!deviceId) return "";
+    s_lookups++;
+    int slot = findById(deviceId);
+    if (slot < 0) return "";
+    bitSet(s_ref, slot);
+    return s_contacts[slot].call_sign;
 }
 
 const char* buddyLookupIdByCallSign(const char* sign) {
     if (!g_buddy_inited) buddyInit();
-    if (!buddy_base || !sign) return "";
-    
-    for (int i = 0; i < _bhdr()->count; i++) {
-        BuddyContact* e = _contactPtr(i);
-        if (strcmp(e->call_sign, sign) == 0 && e->device_id[0] != '\0') {
-            return e->device_id;
-        }
-    }
-    return "";
+    if (!sign || !sign[0]) return "";
+    s_lookups++;
+    int pos = idxFind(s_by_sign, sign);
+    if (pos < 0) return "";
+    uint16_t slot = s_by_sign[pos] - 1;
+    bitSet(s_ref, slot);
+    return s_contacts[slot].device_id;
 }
 
-bool buddyExportCsv(char* out_buf, uint16_t max_len) {
+bool buddyExportCsv(char* out_buf, uint16_t max_len, uint16_t& cursor) {
     if (!g_buddy_inited) buddyInit();
-    if (!buddy_base || !out_buf) return false;
-    
+    if (!out_buf || max_len == 0) return false;
+
     out_buf[0] = '\0';
     uint16_t off = 0;
-    
-    for (int i = 0; i < _bhdr()->count; i++) {
-        BuddyContact* e = _contactPtr(i);
-        if (e->call_sign[0] == '\0') continue;
-        
+    uint16_t i = cursor;
+
+    for (; i < BUDDY_MAX_CONTACTS; i++) {
+        if (!bitGet(s_used, i)) continue;
+        const BuddyContact& e = s_contacts[i];
+        if (e.call_sign[0] == '\0') continue;
+
         // Format: CN{call_sign}|DI{device_id},...
-        int written = snprintf(out_buf + off, max_len - off, "CN%s|DI%s,", 
-                               e->call_sign, e->device_id);
+        int written = snprintf(out_buf + off, max_len - off, "CN%s|DI%s,",
+                               e.call_sign, e.device_id);
         if (written < 0 || (uint16_t)written >= max_len - off) {
-            return false;  // Buffer too small
+            out_buf[off] = '\0';    // Buffer full — continue from this contact next time
+            break;
         }
         off += written;
     }
-    
-    return _bhdr()->count > 0;
+
+    cursor = i < BUDDY_MAX_CONTACTS ? i : BUDDY_EXPORT_DONE;
+    return off > 0;
 }
 
 int buddyImportCsv(const char* csv_str) {
-    if (!csv_str || !g_buddy_inited) buddyInit();
+    if (!g_buddy_inited) buddyInit();
+    if (!csv_str) return 0;
     int count = 0;
-    
-    // Parse CSV: "CNname1|DIid1,CNname2|DIid2,..."
+
+    // Parse CSV: "CNname1|DIid1,CNname2|DIid2,-DIid3,..."
     const char* p = csv_str;
-    while (*p && strlen(p) >= 6) {  // minimal entry: CNx|DIxxxxx,
-        if (p[0] == 'C' && p[1] == 'N') {
-            const char* pipe = strchr(p, '|');
-            if (pipe && *(pipe + 1) == 'D') {
-                char callSign[BUDDY_CALL_SIGN_LEN];
+    while (*p) {
+        const char* comma = strchr(p, ',');
+        uint16_t elen = comma ? (uint16_t)(comma - p) : (uint16_t)strlen(p);
+
+        if (elen > 3 && p[0] == '-' && p[1] == 'D' && p[2] == 'I') {
+            uint8_t diLen = elen - 3;
+            if (diLen < BUDDY_DEVICE_ID_LEN) {
                 char deviceId[BUDDY_DEVICE_ID_LEN];
-                uint8_t csLen = (uint8_t)(pipe - p - 2);
-                if (csLen > 0 && csLen < BUDDY_CALL_SIGN_LEN) {
-                    strncpy(callSign, p + 2, csLen);
+                memcpy(deviceId, p + 3, diLen);
+                deviceId[diLen] = '\0';
+                if (buddyRemove(deviceId)) count++;
+            }
+        } else if (elen >= 6 && p[0] == 'C' && p[1] == 'N') {  // minimal entry: CNx|DIx
+            const char* pipe = (const char*)memchr(p, '|', elen);
+            if (pipe && pipe + 2 < p + elen && pipe[1] == 'D' && pipe[2] == 'I') {
+                uint16_t csLen = (uint16_t)(pipe - p - 2);
+                uint16_t diLen = (uint16_t)(p + elen - (pipe + 3));
+                if (csLen > 0 && csLen < BUDDY_CALL_SIGN_LEN && diLen > 0 && diLen < BUDDY_DEVICE_ID_LEN) {
+                    char callSign[BUDDY_CALL_SIGN_LEN];
+                    char deviceId[BUDDY_DEVICE_ID_LEN];
+                    memcpy(callSign, p + 2, csLen);
                     callSign[csLen] = '\0';
-                    
-                    const char* comma = strchr(pipe + 1, ',');
-                    uint8_t diLen;
-                    if (comma) {
-                        diLen = (uint8_t)(comma - (pipe + 2));
-                    } else {
-                        diLen = (uint8_t)strlen(pipe + 2);
-                    }
-                    
-                    if (diLen > 0 && diLen < BUDDY_DEVICE_ID_LEN) {
-                        strncpy(deviceId, pipe + 2, diLen);
-                        deviceId[diLen] = '\0';
-                        
-                        buddyAddOrUpdate(deviceId, callSign);
-                        count++;
-                    }
+                    memcpy(deviceId, pipe + 3, diLen);
+                    deviceId[diLen] = '\0';
+                    buddyAddOrUpdate(deviceId, callSign);
+                    count++;
                 }
             }
         }
-        
-        // Advance past current entry
-        const char* comma = strchr(p, ',');
-        if (comma) {
-            p = comma + 1;
-        } else {
-            break;
-        }
+
+        if (!comma) break;
+        p = comma + 1;
     }
-    
+
     return count;
 }
 
 void buddySetDisplayName(const char* name) {
-    buddyAddOrUpdate("SELF", name);
+    buddyAddOrUpdate(BUDDY_SELF_ID, name);
 }
 
 const char* buddyGetDisplayName() {
     if (!g_buddy_inited) buddyInit();
-    // Look for SELF entry — returns static buffer for display
-    if (_bhdr()->count > 0) {
-        BuddyContact* first = _contactPtr(0);
-        if (first && strcmp(first->device_id, "SELF") == 0 && first->call_sign[0] != '\0') {
-            return first->call_sign;
-        }
-    }
-    return "";
+    int slot = findById(BUDDY_SELF_ID);
+    return slot < 0 ? "" : s_contacts[slot].call_sign;
+}
+
+int buddyFormatStats(char* out, size_t out_len) {
+    if (!g_buddy_inited) buddyInit();
+    return snprintf(out, out_len,
+                    "OK{DIRSTATS:n=%u,cap=%u,store=%s,dirty=%u,pages_written=%lu,lookups=%lu,probe_max=%u,"
+                    "evicted=%lu,rebuilds=%u,mount_ms=%lu}",
+                    s_count, (unsigned)BUDDY_MAX_CONTACTS, s_ops ? "qspi" : "ram", __builtin_popcount(s_dirty),
+                    (unsigned long)s_pages_written, (unsigned long)s_lookups, s_probe_max,
+                    (unsigned long)s_evicted, s_rebuilds, (unsigned long)s_mount_ms);
 }
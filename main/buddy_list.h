@@ -4,36 +4,60 @@
 #include <stdint.h>
 #include <Arduino.h>
 
-// Buddy list storage in RTC RAM — placed after text_inbox (0x200075C0..0x20007BFF), starts at 0x20007C00
-// Each contact: 16-byte call_sign + 8-byte deviceId = 24 bytes + 4 byte header = 28 bytes rounded to 32
-#define BUDDY_RAM_BASE              ((volatile uint8_t*)0x20007C00)
-#define BUDDY_MAX_CONTACTS          16
+// Contact directory: device ID <-> call sign for up to BUDDY_MAX_CONTACTS buddies (an organisation
+// roster pushed with SETBUDDY, plus everyone heard on the air).
+//
+// RAM: a fixed table of BuddyContact slots and two open-addressing hash indexes (FNV-1a, linear
+// probing) — one on device ID, one on call sign — so lookups and the per-beacon update are O(1).
+// When the table is full the clock hand evicts a contact that was not used since its last pass.
+//
+// Flash: the table is stored as BUDDY_PAGES pages of BUDDY_PAGE_RECORDS fixed-size records at
+// QSPI_BUDDY_BASE. Each page has two sector copies written alternately; the copy's header (seq +
+// FNV of the records) is programmed last, so a power cut keeps the previous copy. Changes only mark
+// their page dirty — buddyTick() writes dirty pages back once updates have been quiet for
+// BUDDY_FLUSH_IDLE_MS (at the latest after BUDDY_FLUSH_MAX_MS), one page per call.
+// Without the flash chip the directory still works, it just starts empty after a reset.
+#define BUDDY_MAX_CONTACTS          1024
 #define BUDDY_CALL_SIGN_LEN         16
-#define BUDDY_DEVICE_ID_LEN         8
-#define CONTACT_SLOT_SIZE           32
+#define BUDDY_DEVICE_ID_LEN         9       // 8 hex digits (bleGetDeviceIdShort) + null
+#define BUDDY_INDEX_SIZE            2048    // Slots per hash index — power of two, >= 2 x contacts
+#define CONTACT_SLOT_SIZE           32      // Flash record: contact + flags, padded
+#define BUDDY_PAGE_RECORDS          127     // 32-byte page header + 127 records = one sector
+#define BUDDY_PAGES                 ((BUDDY_MAX_CONTACTS + BUDDY_PAGE_RECORDS - 1) / BUDDY_PAGE_RECORDS)
+#define BUDDY_FLUSH_IDLE_MS         3000
+#define BUDDY_FLUSH_MAX_MS          30000
+#define BUDDY_EXPORT_DONE           0xFFFF
 
 typedef struct __attribute__((packed)) {
-    uint32_t magic;               // 'BDLY' = 0x42444C59
-    uint8_t count;                // number of entries
-} BuddyHeader;
-
-typedef struct __attribute__((packed)) {
-    char    call_sign[BUDDY_CALL_SIGN_LEN];  // null-terminated, up to 16 chars
+    char    call_sign[BUDDY_CALL_SIGN_LEN];  // null-terminated, up to 15 chars
     char    device_id[BUDDY_DEVICE_ID_LEN];  // hex short ID (8 chars + null)
 } BuddyContact;
 
-// API — all calls are non-blocking, use static buffers
+// API — all calls are non-blocking except buddyFlush(), use static buffers
 void buddyInit();
 void buddyAddOrUpdate(const char* deviceId, const char* callSign);
-const char* buddyLookupName(const char* deviceId);   // returns persistent pointer or deviceId itself if unknown
+bool buddyRemove(const char* deviceId);
+uint16_t buddyCount();
+const char* buddyLookupName(const char* deviceId);   // returns persistent pointer, "" if unknown
 const char* buddyLookupIdByCallSign(const char* sign); // reverse lookup
 
-// Export / import: formats as "CN{call_sign}|DI{device_id},..." for GATT transfer (CSV in one string)
-bool buddyExportCsv(char* out_buf, uint16_t max_len);
-int  buddyImportCsv(const char* csv_str);               // returns count of parsed contacts
+// Export / import: "CN{call_sign}|DI{device_id},..." for GATT transfer (CSV in one string).
+// Export is incremental: pass cursor 0 first, then the returned cursor until BUDDY_EXPORT_DONE.
+bool buddyExportCsv(char* out_buf, uint16_t max_len, uint16_t& cursor);
+// Merges into the directory; "-DI{device_id}" entries remove a contact. Returns entries applied.
+int  buddyImportCsv(const char* csv_str);
 
-// Get/set local display name (stored as first entry with device_id == our own short ID)
+// Get/set local display name (stored as the entry with device_id "SELF", never evicted)
 void buddySetDisplayName(const char* name);
 const char* buddyGetDisplayName();
 
+// Loop context — batched write-back of dirty pages
+void buddyTick(uint32_t now);
+// Write every dirty page now (power off)
+void buddyFlush();
+
+// "OK{DIRSTATS:n=..,cap=..,store=qspi|ram,dirty=..,pages_written=..,lookups=..,probe_max=..,
+//  evicted=..,rebuilds=..,mount_ms=..}"
+int buddyFormatStats(char* out, size_t out_len);
+
 #endif
@@ -1,38 +1,14 @@
 // ---- HardFault / crash detection and debugging ----
-#define CRASH_MAGIC        0x43524153  // "CRAS"
-#define STACK_GUARD_PAT    0xDEADBEEF
+#include "retained_ram.h"   // CrashRecord, DebugLog — RR_CRASH / RR_DBGLOG regions
+
+#define STACK_GUARD_PAT    RETAINED_GUARD
 #define MAX_CRASH_LOG      16
 
-typedef struct {
-    uint32_t    magic;
-    uint32_t    stack_guard_pattern;
-    uint32_t    msp_before_crash;
-    uint32_t    psp_main;
-    uint32_t    psp_isr;
-    uint32_t    lr_at_crash;
-    uint32_t    cfsr;
-    uint32_t    hfsr;
-    uint32_t    bfar;
-    uint32_t    afsr;
-    uint32_t    xPSR;
-    uint32_t    r0, r1, r2, r3;
-    uint32_t    r12, r4, r5, r6, r7, r8, r9, r10, r11;
-    char        function[16];
-    uint32_t    line_number;
-    uint32_t    tick_count;
-    uint32_t    loop_count;
-    uint32_t    free_heap_min;
-} CrashRecord;
-
-#define CRASH_RAM_BASE   ((volatile CrashRecord*)0x20007FC0)
 static CrashRecord* g_crash = nullptr;
 
 void initCrashDetection() {
-    g_crash = (CrashRecord*)CRASH_RAM_BASE;
-    if (!g_crash->magic) {
-        memset((void*)g_crash, 0, sizeof(CrashRecord));
-        g_crash->magic = CRASH_MAGIC;
-    }
+    // The record is left alone: CRASH_MAGIC in it means a fault is waiting to be reported
+    g_crash = &g_retained.crash.body;
 
     // Enable fault detection
     SCB->CFSR = 0xFFFFFFFF;
@@ -50,7 +26,7 @@ void initCrashDetection() {
 
 void recordCrash(uint32_t lr, uint32_t cfsr_val, uint32_t hfsr_val,
                  const char* func_name, uint32_t line_num) {
-    if (!g_crash) g_crash = (CrashRecord*)CRASH_RAM_BASE;
+    if (!g_crash) g_crash = &g_retained.crash.body;
 
     uint32_t msp, psp_main, psp_isr;
     __asm volatile("mrs %0, msp" : "=r"(msp));
@@ -121,19 +97,17 @@ void recordCrash(uint32_t lr, uint32_t cfsr_val, uint32_t hfsr_val,
     if (!g_crash->free_heap_min || (getFreeHeap() < g_crash->free_heap_min)) {
         g_crash->free_heap_min = getFreeHeap();
     }
+    retainedSeal(RR_CRASH);
 }
 
 void dumpCrashInfo(bool fatal) {
-    if (!g_crash || !g_crash->magic) return;
+    if (!g_crash || g_crash->magic != CRASH_MAGIC) return;
 
     uint32_t cfsr = g_crash->cfsr;
 
-// crashCount is declared in main.ino as volatile uint32_t crashCount = 0x5A5A5A5A;
-    extern volatile uint32_t crashCount;
-    
     SerialMon.println("\n\n################################");
     SerialMon.print(F("### CRASH DETECTED (reboot #"));
-    SerialMon.print(g_crash->tick_count > 0 ? ((crashCount + 1) & 0xFF) : 0);
+    SerialMon.print(g_crash->tick_count > 0 ? (g_crash->crash_count & 0xFF) : 0);
     SerialMon.println(") ###");
     SerialMon.println("################################");
 
@@ -204,14 +178,14 @@ void dumpCrashInfo(bool fatal) {
     if (g_crash->stack_guard_pattern == STACK_GUARD_PAT) {
         SerialMon.println("  [OK] Stack guard intact");
     } else {
-        uint32_t current_val = *(volatile uint32_t*)0x20007FFC;
+        uint32_t current_val = g_retained.guard;
         if (current_val != STACK_GUARD_PAT) {
             uint32_t consumed = (STACK_GUARD_PAT - current_val) / 4;
             SerialMon.print("  [CRITICAL] Stack overflow! ");
             SerialMon.print(consumed);
             SerialMon.println(" words consumed");
         } else {
-            SerialMon.println("  [OK] Stack guard intact (at top of RAM)");
+            SerialMon.println("  [OK] Stack guard intact (end of retained RAM)");
         }
     }
 
@@ -229,14 +203,16 @@ void dumpCrashInfo(bool fatal) {
 
     // Inline clear since we're in same translation unit
     if (g_crash && g_crash->magic) {
-        g_crash->magic = 0;
+        uint32_t crashes = g_crash->crash_count;
         memset((void*)g_crash, 0, sizeof(CrashRecord));
+        g_crash->crash_count = crashes;
+        retainedSeal(RR_CRASH);
     }
 }
 
 void clearCrashInfo();  // Forward declaration — defined after dumpCrashInfo
 
-#define STACK_GUARD_ADDR  ((volatile uint32_t*)0x20007FFC)
+#define STACK_GUARD_ADDR  (&g_retained.guard)   // Last word of the retained block
 
 void initStackGuard() {
     *STACK_GUARD_ADDR = STACK_GUARD_PAT;
@@ -253,10 +229,8 @@ bool checkStackOverflow() {
     return false;
 }
 
-// crashCount is declared in main.ino as volatile uint32_t crashCount = 0x5A5A5A5A;
-
 void reportCrashState() {
-    if (!g_crash || !g_crash->magic) return;
+    if (!g_crash || g_crash->magic != CRASH_MAGIC) return;
 
     dumpCrashInfo(true);
 
@@ -297,32 +271,24 @@ void reportCrashState() {
         }
     }
 
-    extern volatile uint32_t crashCount;
-    if (crashCount > 3) {
+    if (g_crash->crash_count > 3) {
         SerialMon.print(F("\n[DIAG] WARNING: "));
-        SerialMon.print(crashCount);
+        SerialMon.print(g_crash->crash_count);
         SerialMon.println(" consecutive crashes — possible infinite reset loop");
     }
 
     clearCrashInfo();
 }
 
-// Debug logging buffer
-#define DEBUG_LOG_MAX_ENTRIES 32
-
-typedef struct {
-    uint32_t tick;
-    char text[40];
-} DebugEntry;
-
-#define DBG_BUF_ADDR ((volatile DebugEntry*)0x20006FC0)
+// Debug logging buffer — RR_DBGLOG region, still readable after a reset
 static DebugEntry* g_dbg_buf = nullptr;
 
 void initDebugBuffer() {
-    g_dbg_buf = (DebugEntry*)DBG_BUF_ADDR;
-    for (int i = 0; i < DEBUG_LOG_MAX_ENTRIES; i++) {
-        g_dbg_buf[i].tick = 0;
-        g_dbg_buf[i].text[0] = '\0';
+    // No clearing — entries from before the reset stay; retainedInit() zeroed the region if it was damaged
+    g_dbg_buf = g_retained.dbglog.body.entries;
+    if (g_retained.dbglog.body.idx >= DEBUG_LOG_MAX_ENTRIES) {
+        g_retained.dbglog.body.idx = 0;
+        retainedSeal(RR_DBGLOG);
     }
 }
 
@@ -330,7 +296,7 @@ void dbgLog(const char* fmt, ...) {
     if (!g_dbg_buf) initDebugBuffer();
     if (!g_dbg_buf) return;
 
-    static uint8_t idx = 0;
+    uint8_t& idx = g_retained.dbglog.body.idx;
 
     char buf[41];
     va_list args;
@@ -340,9 +306,10 @@ void dbgLog(const char* fmt, ...) {
 
     g_dbg_buf[idx].tick = millis();
     strncpy(g_dbg_buf[idx].text, buf, 39);
-    g_dbg_buf[idx].text[40] = '\0';
+    g_dbg_buf[idx].text[39] = '\0';
 
     idx = (idx + 1) % DEBUG_LOG_MAX_ENTRIES;
+    retainedSeal(RR_DBGLOG);
 }
 
 void dumpDebugBuffer() {
@@ -372,6 +339,8 @@ size_t getMinFreeHeap() {
 
 void clearCrashInfo() {
     if (!g_crash || !g_crash->magic) return;
-    g_crash->magic = 0;
+    uint32_t crashes = g_crash->crash_count;    // The streak outlives the report
     memset((void*)g_crash, 0, sizeof(CrashRecord));
+    g_crash->crash_count = crashes;
+    retainedSeal(RR_CRASH);
 }
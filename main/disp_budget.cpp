@@ -0,0 +1,102 @@
+// disp_budget.cpp — Refresh pacing, per-region ghost accounting and refresh metrics
+
+#include "disp_budget.h"
+
+#define REGIONS_X       ((DISP_MIRROR_W + DISP_REGION - 1) / DISP_REGION)
+#define REGIONS_Y       ((DISP_MIRROR_H + DISP_REGION - 1) / DISP_REGION)
+#define HOUR_BUCKETS    12
+#define BUCKET_MS       (3600000UL / HOUR_BUCKETS)
+
+static uint16_t s_region[REGIONS_Y][REGIONS_X];    // Partials since the last full refresh
+static uint16_t s_region_max = 0;
+
+static bool s_started_any = false;
+static uint32_t s_last_start_ms = 0;
+static bool s_user_waiting = false;                 // Input since the last refresh start
+static uint32_t s_activity_ms = 0;
+
+// Refreshes per hour: sliding window of 5-minute buckets, each tagged with its bucket number
+static uint16_t s_hour_count[HOUR_BUCKETS];
+static uint32_t s_hour_tag[HOUR_BUCKETS];
+
+// Stats
+static uint32_t s_partials = 0;
+static uint32_t s_full = 0;
+static uint32_t s_ghost_full = 0;
+static uint32_t s_deferred = 0;
+static uint64_t s_blocked_us = 0;
+static uint32_t s_blocked_max_us = 0;
+
+void dispBudgetActivity() {
+    s_user_waiting = true;
+    s_activity_ms = millis();
+}
+
+bool dispBudgetMayStart(uint32_t now) {
+    return !s_started_any || s_user_waiting || now - s_last_start_ms >= DISP_MIN_INTERVAL_MS;
+}
+
+bool dispBudgetGhostDue(uint32_t now) {
+    if (s_region_max < DISP_GHOST_PARTIALS) return false;
+    if (s_region_max >= DISP_GHOST_FORCE) return true;
+    return now - s_activity_ms >= DISP_IDLE_MS;
+}
+
+static void countHour(uint32_t now) {
+    uint32_t tag = now / BUCKET_MS;
+    uint8_t i = tag % HOUR_BUCKETS;
+    if (s_hour_tag[i] != tag) {
+        s_hour_tag[i] = tag;
+        s_hour_count[i] = 0;
+    }
+    s_hour_count[i]++;
+}
+
+static uint32_t perHour(uint32_t now) {
+    uint32_t tag = now / BUCKET_MS;
+    uint32_t n = 0;
+    for (uint8_t i = 0; i < HOUR_BUCKETS; i++) {
+        if (tag - s_hour_tag[i] < HOUR_BUCKETS) n += s_hour_count[i];
+    }
+    return n;
+}
+
+void dispBudgetStarted(const DispRect& r, bool full, uint32_t now) {
+    bool ghost = full && s_region_max >= DISP_GHOST_PARTIALS;
+    s_started_any = true;
+    s_last_start_ms = now;
+    s_user_waiting = false;
+    countHour(now);
+
+    if (full) {
+        s_full++;
+        if (ghost) s_ghost_full++;
+        memset(s_region, 0, sizeof(s_region));
+        s_region_max = 0;
+        return;
+    }
+
+    s_partials++;
+    int rx0 = r.x / DISP_REGION, ry0 = r.y / DISP_REGION;
+    int rx1 = (r.x + r.w - 1) / DISP_REGION, ry1 = (r.y + r.h - 1) / DISP_REGION;
+    for (int ry = ry0; ry <= ry1 && ry < REGIONS_Y; ry++) {
+        for (int rx = rx0; rx <= rx1 && rx < REGIONS_X; rx++) {
+            uint16_t n = ++s_region[ry][rx];
+            if (n > s_region_max) s_region_max = n;
+        }
+    }
+}
+
+void dispBudgetDeferred() { s_deferred++; }
+
+void dispBudgetBlocked(uint32_t us) {
+    s_blocked_us += us;
+    if (us > s_blocked_max_us) s_blocked_max_us = us;
+}
+
+int dispBudgetFormatStats(char* out, size_t out_len) {
+    return snprintf(out, out_len, "OK{PANELSTATS:partials=%lu,full=%lu,ghost_full=%lu,deferred=%lu,per_hour=%lu,region_max=%u,blocked_ms=%lu,blocked_max_ms=%lu}",
+                    (unsigned long)s_partials, (unsigned long)s_full, (unsigned long)s_ghost_full, (unsigned long)s_deferred,
+                    (unsigned long)perHour(millis()), (unsigned)s_region_max,
+                    (unsigned long)(s_blocked_us / 1000), (unsigned long)(s_blocked_max_us / 1000));
+}
@@ -0,0 +1,42 @@
+// disp_budget.h — Refresh budget for the frame pipeline: pacing, anti-ghosting full refreshes, metrics
+
+#ifndef DISP_BUDGET_H
+#define DISP_BUDGET_H
+
+#include <Arduino.h>
+#include "disp_dirty.h"
+
+// Every path that changes the screen ends in dispFrameSubmit(); disp_dirty asks this module
+// whether a refresh may start now and whether it has to be a full (flashing) one.
+//
+// Pacing: refreshes start at most every DISP_MIN_INTERVAL_MS. A frame submitted sooner stays
+// pending and is diffed against the newest render when the gate opens, so bursts collapse into
+// one refresh with the latest content. Button/touch input opens the gate at once.
+//
+// Ghosting: each partial refresh counts against the DISP_REGION-sized regions it covers. Once a
+// region reaches DISP_GHOST_PARTIALS a full refresh is due; it runs when the user has been idle
+// for DISP_IDLE_MS, or regardless at DISP_GHOST_FORCE partials. A full refresh resets all regions.
+
+#define DISP_MIN_INTERVAL_MS    1000
+#define DISP_REGION             40
+#define DISP_GHOST_PARTIALS     40
+#define DISP_GHOST_FORCE        80
+#define DISP_IDLE_MS            10000
+
+// Button or touch input — the next frame goes out without waiting for the interval
+void dispBudgetActivity();
+
+bool dispBudgetMayStart(uint32_t now);
+bool dispBudgetGhostDue(uint32_t now);
+// A refresh of logical rect r was started (full = full waveform)
+void dispBudgetStarted(const DispRect& r, bool full, uint32_t now);
+// A frame was held back by the interval gate
+void dispBudgetDeferred();
+
+// Main-loop time spent on display work (render, frame gather, blocking drains)
+void dispBudgetBlocked(uint32_t us);
+
+// "OK{PANELSTATS:partials=..,full=..,ghost_full=..,deferred=..,per_hour=..,region_max=..,blocked_ms=..,blocked_max_ms=..}"
+int dispBudgetFormatStats(char* out, size_t out_len);
+
+#endif
@@ -0,0 +1,245 @@
+// disp_dirty.cpp — Frame mirror, tile diff, widget coalescing and the async frame pipeline
+
+#include "disp_dirty.h"
+#include "disp_refresh.h"
+#include "disp_budget.h"
+
+#define MIRROR_STRIDE   (DISP_MIRROR_W / 8)
+#define TILES_X         (DISP_MIRROR_W / DISP_TILE)
+#define TILES_Y         (DISP_MIRROR_H / DISP_TILE)
+
+// 1 bit per pixel, row-major, 1 = black
+static uint8_t s_frame[MIRROR_STRIDE * DISP_MIRROR_H];     // What is being drawn now
+static uint8_t s_panel[MIRROR_STRIDE * DISP_MIRROR_H];     // What the panel shows
+static uint8_t s_tx[MIRROR_STRIDE * DISP_MIRROR_H];        // Frame in flight (EasyDMA source), panel orientation
+static bool s_stale = true;
+
+// Pipeline: at most one frame in flight; renders that land meanwhile just mark a pending frame
+// and the diff is taken against the newest s_frame once the panel is free
+static bool s_pending = false;
+static bool s_pending_whole = false;
+static DispRect s_inflight;
+static uint32_t s_inflight_ms = 0;
+static bool s_held = false;         // Pending frame is waiting on the refresh interval (disp_budget)
+static bool s_flushing = false;     // dispFrameFlush() drains without pacing
+static bool s_hold = false;
+
+static DispRect s_widgets[DISP_MAX_WIDGETS];
+static uint8_t s_widget_count = 0;
+
+static DispRect s_clip[DISP_MAX_CLIP];
+static uint8_t s_clip_count = 0;
+
+// Stats
+static uint32_t s_renders = 0;
+static uint32_t s_unchanged = 0;
+static uint32_t s_skipped = 0;
+static uint32_t s_px_pushed = 0;
+static uint32_t s_refresh_ms = 0;
+static uint32_t s_pushes = 0;
+static uint32_t s_coalesced = 0;
+static uint32_t s_failed = 0;
+
+void dispMirrorPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= DISP_MIRROR_W || y >= DISP_MIRROR_H) return;
+    uint8_t& b = s_frame[y * MIRROR_STRIDE + (x >> 3)];
+    uint8_t mask = 0x80 >> (x & 7);
+    if (color == GxEPD_WHITE) b &= ~mask;
+    else b |= mask;
+}
+
+void dispMirrorFill(uint16_t color) {
+    memset(s_frame, color == GxEPD_WHITE ? 0x00 : 0xFF, sizeof(s_frame));
+}
+
+uint8_t* dispMirrorFrame() { return s_frame; }
+
+void dispClipBegin() { s_clip_count = 0; }
+void dispClipEnd() { s_clip_count = 0; }
+uint8_t dispClipCount() { return s_clip_count; }
+const DispRect& dispClipRect(uint8_t i) { return s_clip[i]; }
+
+void dispClipAdd(int x, int y, int w, int h) {
+    if (s_clip_count >= DISP_MAX_CLIP || w <= 0 || h <= 0) return;
+    s_clip[s_clip_count++] = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h };
+}
+
+bool dispClipHit(int16_t x, int16_t y) {
+    if (s_clip_count == 0) return true;
+    for (uint8_t i = 0; i < s_clip_count; i++) {
+        const DispRect& r = s_clip[i];
+        if (x >= r.x && y >= r.y && x < r.x + r.w && y < r.y + r.h) return true;
+    }
+    return false;
+}
+
+void dispFrameUnchanged() { s_unchanged++; }
+
+void dispFrameBegin() {
+    s_renders++;
+    s_widget_count = 0;
+}
+
+void dispWidget(int x, int y, int w, int h) {
+    if (s_widget_count >= DISP_MAX_WIDGETS || w <= 0 || h <= 0) return;
+    s_widgets[s_widget_count++] = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h };
+}
+
+static bool tileChanged(int tx, int ty) {
+    int off = ty * DISP_TILE * MIRROR_STRIDE + tx;
+    for (int r = 0; r < DISP_TILE; r++, off += MIRROR_STRIDE) {
+        if (s_frame[off] != s_panel[off]) return true;
+    }
+    return false;
+}
+
+static void growUnion(DispRect& u, bool& any, int x0, int y0, int x1, int y1) {
+    if (!any) {
+        u = { (int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+        any = true;
+        return;
+    }
+    int ux1 = u.x + u.w, uy1 = u.y + u.h;
+    if (x0 < u.x) u.x = x0;
+    if (y0 < u.y) u.y = y0;
+    if (x1 > ux1) ux1 = x1;
+    if (y1 > uy1) uy1 = y1;
+    u.w = ux1 - u.x;
+    u.h = uy1 - u.y;
+}
+
+bool dispFrameDiff(DispRect& out) {
+    bool any = false;
+    for (int ty = 0; ty < TILES_Y; ty++) {
+        for (int tx = 0; tx < TILES_X; tx++) {
+            if (!tileChanged(tx, ty)) continue;
+            int x0 = tx * DISP_TILE, y0 = ty * DISP_TILE;
+            int x1 = x0 + DISP_TILE, y1 = y0 + DISP_TILE;
+            // Widen to every widget this tile touches
+            for (uint8_t i = 0; i < s_widget_count; i++) {
+                const DispRect& w = s_widgets[i];
+                if (w.x >= x1 || w.y >= y1 || w.x + w.w <= x0 || w.y + w.h <= y0) continue;
+                if (w.x < x0) x0 = w.x;
+                if (w.y < y0) y0 = w.y;
+                if (w.x + w.w > x1) x1 = w.x + w.w;
+                if (w.y + w.h > y1) y1 = w.y + w.h;
+            }
+            growUnion(out, any, x0, y0, x1, y1);
+        }
+    }
+    if (!any) {
+        s_skipped++;
+        return false;
+    }
+
+    // Byte-align to the tile grid and clip to the panel
+    int x0 = (out.x < 0 ? 0 : out.x) & ~(DISP_TILE - 1);
+    int y0 = (out.y < 0 ? 0 : out.y) & ~(DISP_TILE - 1);
+    int x1 = (out.x + out.w + DISP_TILE - 1) & ~(DISP_TILE - 1);
+    int y1 = (out.y + out.h + DISP_TILE - 1) & ~(DISP_TILE - 1);
+    if (x1 > DISP_MIRROR_W) x1 = DISP_MIRROR_W;
+    if (y1 > DISP_MIRROR_H) y1 = DISP_MIRROR_H;
+    out = { (int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+    return true;
+}
+
+// Logical (rotation 3) window → panel RAM window. The controller's x runs along logical y and its
+// y runs backwards along logical x; one controller byte is 8 logical rows of the same column.
+static void gatherWindow(const DispRect& r, DispRect& phys) {
+    phys = { r.y, (int16_t)(DISP_MIRROR_W - r.x - r.w), r.h, r.w };
+    uint8_t* out = s_tx;
+    for (int py = phys.y; py < phys.y + phys.h; py++) {
+        int lx = DISP_MIRROR_W - 1 - py;
+        const uint8_t* col = s_frame + (lx >> 3);
+        uint8_t mask = 0x80 >> (lx & 7);
+        for (int px = phys.x; px < phys.x + phys.w; px += 8) {
+            const uint8_t* p = col + px * MIRROR_STRIDE;
+            uint8_t b = 0;
+            for (int i = 0; i < 8; i++, p += MIRROR_STRIDE) {
+                b <<= 1;
+                if (!(*p & mask)) b |= 1;       // Controller RAM: 1 = white
+            }
+            *out++ = b;
+        }
+    }
+}
+
+static void startNextFrame() {
+    if (s_hold) return;
+    uint32_t now = millis();
+    if (!s_flushing && !dispBudgetMayStart(now)) {
+        if (s_pending && !s_held) dispBudgetDeferred();
+        s_held = s_pending;
+        return;     // Stays pending; whatever s_frame holds when the gate opens goes out
+    }
+    s_held = false;
+    bool full = dispBudgetGhostDue(now);
+    s_pending = false;
+    DispRect r = { 0, 0, DISP_MIRROR_W, DISP_MIRROR_H };
+    if (!full && !s_pending_whole && !s_stale && !dispFrameDiff(r)) return;     // Panel already shows this frame
+    s_pending_whole = false;
+
+    DispRect phys;
+    gatherWindow(r, phys);
+    if (!epdStartFrame(s_tx, phys.x, phys.y, phys.w, phys.h, full)) {
+        s_pending = true;
+        return;
+    }
+    // From here on the panel is taken to show s_frame; the next diff starts from it
+    memcpy(s_panel, s_frame, sizeof(s_panel));
+    s_stale = false;
+    s_inflight = r;
+    s_inflight_ms = now;
+    dispBudgetStarted(r, full, now);
+}
+
+void dispFrameSubmit(bool whole_window) {
+    if (s_pending) s_coalesced++;
+    s_pending = true;
+    s_pending_whole |= whole_window;
+    if (!isEpdBusy()) startNextFrame();
+}
+
+void dispFramePump() {
+    if (stepEpdRefresh()) {
+        if (epdLastFrameOk()) {
+            s_pushes++;
+            s_px_pushed += (uint32_t)s_inflight.w * s_inflight.h;
+            s_refresh_ms += millis() - s_inflight_ms;
+        } else {
+            s_failed++;
+            s_stale = true;
+            s_pending = true;
+        }
+    }
+    // Idle with a full refresh due: repaint the unchanged frame with the full waveform
+    if ((s_pending || dispBudgetGhostDue(millis())) && !isEpdBusy()) startNextFrame();
+}
+
+bool dispFrameBusy() {
+    return s_pending || isEpdBusy();
+}
+
+void dispFrameFlush() {
+    uint32_t t0 = millis();
+    uint32_t us0 = micros();
+    s_flushing = true;
+    while (dispFrameBusy() && millis() - t0 < 10000) {
+        dispFramePump();
+        yield();
+    }
+    s_flushing = false;
+    dispBudgetBlocked(micros() - us0);
+}
+
+void dispFrameHold(bool hold) { s_hold = hold; }
+void dispFrameInvalidate() { s_stale = true; }
+bool dispFrameStale() { return s_stale; }
+
+int dispDirtyFormatStats(char* out, size_t out_len) {
+    return snprintf(out, out_len, "OK{DISPSTATS:renders=%lu,unchanged=%lu,skipped=%lu,coalesced=%lu,pushes=%lu,failed=%lu,px_pushed=%lu,px_full=%lu,avg_ms=%lu}",
+                    (unsigned long)s_renders, (unsigned long)s_unchanged, (unsigned long)s_skipped, (unsigned long)s_coalesced,
+                    (unsigned long)s_pushes, (unsigned long)s_failed,
+                    (unsigned long)s_px_pushed, (unsigned long)s_pushes * DISP_MIRROR_W * DISP_MIRROR_H,
+                    (unsigned long)(s_pushes ? s_refresh_ms / s_pushes : 0));
+}
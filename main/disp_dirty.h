@@ -0,0 +1,114 @@
+// disp_dirty.h — Dirty-rectangle tracking for the layout renderer
+
+#ifndef DISP_DIRTY_H
+#define DISP_DIRTY_H
+
+#include <Arduino.h>
+#include <GxEPD2_BW.h>
+#include "font_blit.h"
+
+// GxEPD2 keeps its frame buffer private, so the display object is an EpdTracked that mirrors
+// every pixel write into a 1bpp logical-coordinate copy. That copy is the off-screen frame buffer:
+// it is diffed against the frame last pushed to the panel in 8x8 tiles (byte-aligned in both panel
+// orientations), the union of what changed is rotated into panel order and streamed to the SSD1681
+// by disp_refresh — or nothing is sent at all. GxEPD2's own displayWindow() is no longer used.
+//
+// One frame is in flight at a time. Frames submitted meanwhile coalesce into a single pending
+// frame that is diffed against the newest render once the panel is free (dispFramePump()).
+// When a frame may start and whether it gets the full waveform is up to disp_budget.
+//
+// Primitives register their bounding box with dispWidget(); a changed tile inside a widget
+// dirties the whole widget, so text is always refreshed as one block.
+
+#define DISP_MIRROR_W       200
+#define DISP_MIRROR_H       200
+#define DISP_TILE           8
+#define DISP_MAX_WIDGETS    24
+
+struct DispRect {
+    int16_t x, y, w, h;
+};
+
+void dispMirrorPixel(int16_t x, int16_t y, uint16_t color);
+void dispMirrorFill(uint16_t color);
+// Raw frame for blitters: row-major, DISP_MIRROR_W / 8 bytes per row, 1 = black
+uint8_t* dispMirrorFrame();
+
+// ── Clip mask ──
+// While a mask is set, drawing only lands inside its rects and fillScreen() clears just those
+// rects — the retained layout renderer uses it to redraw changed widgets and nothing else
+#define DISP_MAX_CLIP       4
+void dispClipBegin();
+void dispClipAdd(int x, int y, int w, int h);
+void dispClipEnd();
+uint8_t dispClipCount();
+const DispRect& dispClipRect(uint8_t i);
+bool dispClipHit(int16_t x, int16_t y);
+
+typedef GxEPD2_BW<GxEPD2_150_BN, GxEPD2_150_BN::HEIGHT> EpdBase;
+
+class EpdTracked : public EpdBase {
+  public:
+    using EpdBase::EpdBase;
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (!dispClipHit(x, y)) return;
+        EpdBase::drawPixel(x, y, color);
+        dispMirrorPixel(x, y, color);
+    }
+    void fillScreen(uint16_t color) override {
+        uint8_t n = dispClipCount();
+        if (n == 0) {
+            EpdBase::fillScreen(color);
+            dispMirrorFill(color);
+            return;
+        }
+        for (uint8_t i = 0; i < n; i++) {
+            const DispRect& r = dispClipRect(i);
+            fillRect(r.x, r.y, r.w, r.h, color);
+        }
+    }
+    // Text in the atlased fonts is blitted straight into the frame (font_blit.cpp). GxEPD2's own
+    // buffer misses those glyphs, which is fine: only the direct GxEPD2 paths still push it and
+    // they fill the whole screen. The firmware never calls setTextSize(), so size is always 1.
+    size_t write(uint8_t c) override {
+        if (gfxFont && c != '\n' && c != '\r') {
+            int16_t adv = fontBlitChar(gfxFont, cursor_x, cursor_y, c, textcolor, wrap ? _width : 0);
+            if (adv >= 0) {
+                cursor_x += adv;
+                return 1;
+            }
+        }
+        return EpdBase::write(c);
+    }
+};
+
+// ── Frame lifecycle (renderPageLoop) ──
+void dispFrameBegin();
+void dispWidget(int x, int y, int w, int h);
+bool dispFrameDiff(DispRect& out);          // false = panel already shows this frame
+
+// ── Async pipeline ──
+// Queue the current frame for the panel; whole_window skips the diff (mode switch, legacy
+// full-screen draws in display.cpp/gps.cpp). Never blocks.
+void dispFrameSubmit(bool whole_window);
+// Call every loop — advances the transfer/waveform and starts the pending frame when idle
+void dispFramePump();
+bool dispFrameBusy();
+// Blocking drain, only before power-off or code that drives GxEPD2 directly (settings panel cycle)
+void dispFrameFlush();
+
+// While held, submitted frames only stay pending — used to render off-screen (LAYOUTBENCH)
+void dispFrameHold(bool hold);
+
+// Panel content unknown (boot, full clear) — next render pushes the whole window
+void dispFrameInvalidate();
+bool dispFrameStale();
+
+// Layout call that returned before rendering because every retained widget hash matched
+void dispFrameUnchanged();
+
+// "OK{DISPSTATS:renders=..,unchanged=..,skipped=..,coalesced=..,pushes=..,failed=..,px_pushed=..,px_full=..,avg_ms=..}"
+int dispDirtyFormatStats(char* out, size_t out_len);
+
+#endif
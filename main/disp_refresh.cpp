@@ -1,12 +1,13 @@
-// disp_refresh.cpp — Non-blocking e-paper waveform transfer
+// disp_refresh.cpp — Non-blocking e-paper transfer and waveform pipeline
 //
-// Replaces blocking display->refresh() with a step function that advances the SSD1681
-// waveform cycle in ~0.5ms increments per call, checked every 10ms via BUSY pin polling.
-// The total wall-clock time is identical (~0.7s partial / ~3.8s full), but the CPU can
-// do BLE/LoRa/button work between steps instead of being dead.
+// Replaces blocking display->displayWindow()/refresh() with a step function. A frame is a
+// physical-orientation 1bpp window handed over by disp_dirty; its bytes are streamed into the
+// SSD1681 RAM by SPIM EasyDMA while the CPU keeps running, then the waveform is triggered and
+// BUSY is polled from stepEpdRefresh(). The waveform itself still takes ~0.7s partial / ~3.8s
+// full, but nothing in the main loop ever waits for it.
 //
-// This copies the exact waveform logic from GxEPD2_150_BN.cpp lines 390-409 and
-// GxEPD2_EPD.cpp _PowerOn() so we don't need to modify vendored libraries.
+// Command sequences mirror GxEPD2_150_BN.cpp (_setPartialRamArea, _Update_Part, writeImagePartAgain)
+// and GxEPD2_EPD.cpp so we don't need to modify vendored libraries.
 
 #include "disp_refresh.h"
 #include "utilities.h"
@@ -84,35 +85,172 @@ static void _epd_write_data(const uint8_t* data, uint16_t n) {
     s_spiclass->endTransaction();
 }
 
+// ── EasyDMA stream into controller RAM ──
+// The Arduino SPIClass drives the same SPIM in blocking mode with interrupts off, so between its
+// transactions the peripheral is ours: point TXD at the frame, start, and poll EVENTS_END.
+static NRF_SPIM_Type* s_spim = nullptr;
+static const uint8_t* s_tx = nullptr;       // Frame bytes (nullptr = solid fill)
+static uint16_t s_tx_len = 0;
+static uint8_t s_fill_byte = 0xFF;
+
+static void _epd_set_ram_area(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    // Mirrors GxEPD2_150_BN::_setPartialRamArea() exactly:
+    //   0x11 → 0x03 (RAM entry mode: x inc, y inc)
+    //   0x44 → x/8, (x+w-1)/8    (horizontal start/end in byte columns)
+    //   0x45 → y%256, y/256, (y+h-1)%256, (y+h-1)/256  (vertical start/end split 4 bytes)
+    //   0x4E → x/8    (RAM-X pointer)
+    //   0x4F → y%256, y/256     (RAM-Y pointer)
+    _epd_write_command(0x11);
+    _epd_write_data(0x03);
+
+    _epd_write_command(0x44);
+    _epd_write_data(uint8_t((x / 8) & 0xFF));
+    _epd_write_data(((x + w - 1) / 8) & 0xFF);
+
+    _epd_write_command(0x45);
+    _epd_write_data(uint8_t(y % 256));
+    _epd_write_data(uint8_t(y / 256));
+    _epd_write_data(((y + h - 1) % 256));
+    _epd_write_data(((y + h - 1) / 256));
+
+    _epd_write_command(0x4e);
+    _epd_write_data(uint8_t((x / 8) & 0xFF));
+
+    _epd_write_command(0x4f);
+    _epd_write_data(uint8_t(y % 256));
+    _epd_write_data(uint8_t(y / 256));
+}
+
+// Starts writing the frame into RAM bank `cmd` (0x24 new / 0x26 previous). Solid fills are at most
+// 5000 bytes (~10ms at 4MHz) and are written inline; frames go out by DMA and finish in _epd_stream_done().
+static void _epd_stream_begin(uint8_t cmd) {
+    _epd_set_ram_area(s_partial_x, s_partial_y, s_partial_w, s_partial_h);
+    _epd_write_command(cmd);
+    s_spiclass->beginTransaction(s_spi_settings);
+    digitalWrite(ePaper_Cs, LOW);
+    if (!s_tx) {
+        for (uint16_t i = 0; i < s_tx_len; i++) s_spiclass->transfer(s_fill_byte);
+        return;
+    }
+    s_spim->RXD.PTR = 0;
+    s_spim->RXD.MAXCNT = 0;
+    s_spim->TXD.PTR = (uint32_t)s_tx;
+    s_spim->TXD.MAXCNT = s_tx_len;
+    s_spim->TXD.LIST = 0;
+    s_spim->EVENTS_END = 0;
+    s_spim->TASKS_START = 1;
+}
+
+static bool _epd_stream_done() {
+    if (s_tx) {
+        if (!s_spim->EVENTS_END) return false;
+        s_spim->EVENTS_END = 0;
+    }
+    digitalWrite(ePaper_Cs, HIGH);
+    s_spiclass->endTransaction();
+    return true;
+}
+
+static void _epd_stream_abort() {
+    if (s_tx) {
+        s_spim->TASKS_STOP = 1;
+        s_spim->EVENTS_END = 0;
+    }
+    digitalWrite(ePaper_Cs, HIGH);
+    s_spiclass->endTransaction();
+}
+
 // ── State machine enum ──
 enum class EpdPhase {
     IDLE,            // Nothing to do
-    POWER_RAMP,      // Waiting for power-on ramp (~100ms)
+    WRITE_NEW,       // DMA into the "current" RAM bank (0x24)
+    WRITE_OLD,       // Full refresh only: same frame into the "previous" bank (0x26)
+    POWER_RAMP,      // Waiting for power-on ramp (~100ms) — bare triggerEpdRefresh() only
     TRIGGERED,       // Waveform triggered, polling BUSY pin
+    WRITE_AGAIN,     // Partial only: sync the "previous" bank so the next diff waveform is right
     DONE             // Waveform complete
 };
 
+// SSD1681 holds BUSY high while the waveform runs (GxEPD2_150_BN::busy_level)
+#define EPD_BUSY_LEVEL      HIGH
+#define EPD_DMA_TIMEOUT_MS  100     // 5000 bytes at 4MHz take ~10ms
+
 static EpdPhase s_phase = EpdPhase::IDLE;
 static uint32_t s_phase_start_ms = 0;
 static bool s_use_full_refresh = false;
-static bool s_partial_initialized = false;
+static bool s_has_frame = false;        // Current cycle writes RAM (vs. bare trigger)
+static bool s_frame_ok = true;
+
+static void enterPhase(EpdPhase p) {
+    s_phase = p;
+    s_phase_start_ms = millis();
+}
+
+static void triggerWaveform() {
+    // Send display update command + data to SSD1681
+    _epd_write_command(0x22);
+    uint8_t cmd_byte = s_use_full_refresh ? 0xF7 : 0xFC;
+    _epd_write_data(cmd_byte);
+
+    // Trigger waveform (cmd 0x20)
+    _epd_write_command(0x20);
+    enterPhase(EpdPhase::TRIGGERED);
+}
+
+static void powerOffAfterPartial() {
+    _epd_write_command(0x22);
+    _epd_write_data(0x83);  // Power off command
+    _epd_write_command(0x20);
+
+    s_partial_x = 0;
+    s_partial_y = 0;
+    s_partial_w = 0;
+    s_partial_h = 0;
+}
 
 // ── Public API ──
 
-void initDispRefresh(SPIClass* spicls, SPISettings spi_set) {
+void initDispRefresh(SPIClass* spicls, SPISettings spi_set, NRF_SPIM_Type* spim) {
     s_spiclass = spicls;
     s_spi_settings = spi_set;
+    s_spim = spim;
 }
 
 bool isEpdRefreshing() {
     return s_phase != EpdPhase::IDLE && s_phase != EpdPhase::DONE;
 }
 
+bool isEpdBusy() {
+    return s_phase != EpdPhase::IDLE;
+}
+
+bool epdLastFrameOk() {
+    return s_frame_ok;
+}
+
 void triggerEpdRefresh(bool full_refresh) {
     if (s_phase != EpdPhase::IDLE) return;  // Already refreshing — skip
     s_use_full_refresh = full_refresh;
-    s_phase = EpdPhase::POWER_RAMP;
-    s_phase_start_ms = millis();
+    s_has_frame = false;
+    s_frame_ok = true;
+    enterPhase(EpdPhase::POWER_RAMP);
+}
+
+bool epdStartFrame(const uint8_t* frame, uint16_t x, uint16_t y, uint16_t w, uint16_t h, bool full_refresh) {
+    if (s_phase != EpdPhase::IDLE || !s_spiclass || !s_spim) return false;
+    s_tx = frame;
+    s_tx_len = (uint16_t)(((w + 7) / 8) * h);
+    s_partial_x = x;
+    s_partial_y = y;
+    s_partial_w = w;
+    s_partial_h = h;
+    s_partial_set = false;
+    s_use_full_refresh = full_refresh;
+    s_has_frame = true;
+    s_frame_ok = true;
+    _epd_stream_begin(0x24);
+    enterPhase(EpdPhase::WRITE_NEW);
+    return true;
 }
 
 bool stepEpdRefresh() {
@@ -124,82 +262,64 @@ bool stepEpdRefresh() {
             s_phase = EpdPhase::IDLE;
             return true;   // Signal "just completed" on first call after done
 
+        case EpdPhase::WRITE_NEW:
+        case EpdPhase::WRITE_OLD:
+        case EpdPhase::WRITE_AGAIN: {
+            if (!_epd_stream_done()) {
+                if (millis() - s_phase_start_ms >= EPD_DMA_TIMEOUT_MS) {
+                    _epd_stream_abort();
+                    s_frame_ok = false;
+                    s_phase = EpdPhase::DONE;
+                }
+                return false;
+            }
+            if (s_phase == EpdPhase::WRITE_NEW && s_use_full_refresh) {
+                // Full waveform compares against nothing — both banks get the frame (writeImageForFullRefresh)
+                _epd_stream_begin(0x26);
+                enterPhase(EpdPhase::WRITE_OLD);
+            } else if (s_phase == EpdPhase::WRITE_AGAIN) {
+                powerOffAfterPartial();
+                s_phase = EpdPhase::DONE;
+            } else {
+                triggerWaveform();
+            }
+            return false;
+        }
+
         case EpdPhase::POWER_RAMP: {
             uint16_t ramp_time = s_use_full_refresh ? 100 : 100;  // power_on_time from GxEPD2_150_BN
             if (millis() - s_phase_start_ms >= ramp_time) {
                 if (!s_use_full_refresh && s_partial_set) {
                     // For partial updates, write GRAM window + pointer registers so the SSD1681 knows
-                    // which region to refresh. Mirrors GxEPD2_150_BN::_setPartialRamArea() exactly:
-                    //   0x11 → 0x03 (RAM entry mode: x inc, y inc)
-                    //   0x44 → x/8, (x+w-1)/8    (horizontal start/end in byte columns)
-                    //   0x45 → y%256, y/256, (y+h-1)%256, (y+h-1)/256  (vertical start/end split 4 bytes)
-                    //   0x4E → x/8    (RAM-X pointer)
-                    //   0x4F → y%256, y/256     (RAM-Y pointer)
-                    _epd_write_command(0x11);
-                    _epd_write_data(0x03);
-
-                    _epd_write_command(0x44);
-                    _epd_write_data(uint8_t((s_partial_x / 8) & 0xFF));
-                    _epd_write_data(((s_partial_x + s_partial_w - 1) / 8) & 0xFF);
-
-                    _epd_write_command(0x45);
-                    _epd_write_data(uint8_t(s_partial_y % 256));
-                    _epd_write_data(uint8_t(s_partial_y / 256));
-                    _epd_write_data(((s_partial_y + s_partial_h - 1) % 256));
-                    _epd_write_data(((s_partial_y + s_partial_h - 1) / 256));
-
-                    _epd_write_command(0x4e);
-                    _epd_write_data(uint8_t((s_partial_x / 8) & 0xFF));
-
-                    _epd_write_command(0x4f);
-                    _epd_write_data(uint8_t(s_partial_y % 256));
-                    _epd_write_data(uint8_t(s_partial_y / 256));
-
+                    // which region to refresh.
+                    _epd_set_ram_area(s_partial_x, s_partial_y, s_partial_w, s_partial_h);
                     s_partial_set = false;
                 }
-
-                // Send display update command + data to SSD1681
-                _epd_write_command(0x22);
-                uint8_t cmd_byte = s_use_full_refresh ? 0xF7 : 0xFC;
-                _epd_write_data(cmd_byte);
-
-                // Trigger waveform (cmd 0x20)
-                _epd_write_command(0x20);
-
-                s_phase = EpdPhase::TRIGGERED;
-                s_phase_start_ms = millis();
+                triggerWaveform();
             }
             return false;
         }
 
         case EpdPhase::TRIGGERED: {
-            // Poll BUSY pin — returns HIGH when waveform cycle is complete
-            uint16_t busy_timeout = s_use_full_refresh ? 4000 : 800;  // ms from GxEPD2_150_BN
-            if (digitalRead(ePaper_Busy) == HIGH) {
-                // Waveform done — power off for partial refresh
-                if (!s_use_full_refresh) {
-                    _epd_write_command(0x22);
-                    _epd_write_data(0x83);  // Power off command
-                    _epd_write_command(0x20);
-
-                    s_partial_x = 0;
-                    s_partial_y = 0;
-                    s_partial_w = 0;
-                    s_partial_h = 0;
+            uint16_t busy_timeout = s_use_full_refresh ? 5000 : 2000;  // GxEPD2_150_BN nominal x1.3 / x2.5
+            if (digitalRead(ePaper_Busy) != EPD_BUSY_LEVEL) {
+                // Waveform done — 0xF7 powers the panel down by itself, partial needs it explicitly
+                if (s_use_full_refresh) {
+                    s_phase = EpdPhase::DONE;
+                } else if (s_has_frame) {
+                    _epd_stream_begin(0x26);
+                    enterPhase(EpdPhase::WRITE_AGAIN);
+                } else {
+                    powerOffAfterPartial();
+                    s_phase = EpdPhase::DONE;
                 }
-                s_phase = EpdPhase::DONE;
                 return false;
             }
             // Timeout guard
             if (millis() - s_phase_start_ms >= busy_timeout) {
-                // Timed out — still mark done to avoid infinite hang
+                // Timed out — still mark done to avoid infinite hang; panel content is unknown
+                s_frame_ok = false;
                 s_phase = EpdPhase::DONE;
-                return false;
-            }
-            // Check every 10ms for responsiveness
-            static uint32_t last_check = 0;
-            if (millis() - last_check >= 10) {
-                last_check = millis();
             }
             return false;
         }
@@ -209,57 +329,18 @@ bool stepEpdRefresh() {
 }
 
 bool epdWriteAndRefreshRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t color_byte) {
-    // Power on the display
-    _epd_write_command(0x22);
-    _epd_write_data(0xf8);
-    _epd_write_command(0x20);
-    while (digitalRead(ePaper_Busy) == LOW) {}  // wait for power-on
-
-    // Set GRAM address window
-    _epd_write_command(0x11);
-    _epd_write_data(0x03);
-
-    _epd_write_command(0x44);
-    _epd_write_data(uint8_t((x / 8) & 0xFF));
-    _epd_write_data(((x + w - 1) / 8) & 0xFF);
-
-    _epd_write_command(0x45);
-    _epd_write_data(uint8_t(y % 256));
-    _epd_write_data(uint8_t(y / 256));
-    _epd_write_data(((y + h - 1) % 256));
-    _epd_write_data(((y + h - 1) / 256));
-
-    _epd_write_command(0x4e);
-    _epd_write_data(uint8_t((x / 8) & 0xFF));
-
-    _epd_write_command(0x4f);
-    _epd_write_data(uint8_t(y % 256));
-    _epd_write_data(uint8_t(y / 256));
-
-    // Calculate data size: w pixels needs ceil(w/8) bytes per row, h rows
-    uint32_t bytes_per_row = (w + 7) / 8;
-    uint32_t total_bytes = bytes_per_row * h;
-
-    // Write color data to GRAM (command 0x24 = current buffer)
-    _epd_write_command(0x24);
-    for (uint32_t i = 0; i < total_bytes; i++) {
-        _epd_write_data(color_byte);
-    }
-
-    // Trigger partial waveform refresh
-    _epd_write_command(0x22);
-    _epd_write_data(0xfc);  // immediate power off after
-    _epd_write_command(0x20);
-
-    // Wait for BUSY pin (HIGH = done)
-    uint32_t start = millis();
-    while (digitalRead(ePaper_Busy) == LOW) {
-        if (millis() - start > 8000) break;  // safety timeout
-    }
-    return true;
+    // Same pipeline as a frame, with a solid fill instead of a DMA source. Completion is
+    // reported by stepEpdRefresh() like any other frame.
+    if (s_phase != EpdPhase::IDLE) return false;
+    s_fill_byte = color_byte;
+    return epdStartFrame(nullptr, x, y, w, h, false);
 }
 
 void epdPowerOffNow() {
+    if (s_phase == EpdPhase::WRITE_NEW || s_phase == EpdPhase::WRITE_OLD || s_phase == EpdPhase::WRITE_AGAIN) {
+        _epd_stream_abort();
+    }
+    if (isEpdRefreshing()) s_frame_ok = false;   // Cut short — panel content unknown
     _epd_write_command(0x22);
     _epd_write_data(0x83);
     _epd_write_command(0x20);
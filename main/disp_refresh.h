@@ -1,4 +1,4 @@
-// disp_refresh.h — Non-blocking e-paper waveform transfer API
+// disp_refresh.h — Non-blocking e-paper transfer and waveform API
 
 #ifndef DISP_REFRESH_H
 #define DISP_REFRESH_H
@@ -6,11 +6,16 @@
 #include <Arduino.h>
 #include <SPI.h>
 
-// Call once from setupDisplay() to register SPI class and settings
-void initDispRefresh(SPIClass* spicls, SPISettings spi_set);
+// Call once from setupDisplay() to register SPI class, settings and the SPIM instance behind it
+// (frames are streamed with that SPIM's EasyDMA between SPIClass transactions)
+void initDispRefresh(SPIClass* spicls, SPISettings spi_set, NRF_SPIM_Type* spim);
 
 // Returns true while a waveform cycle is in progress (after triggerEpdRefresh, before DONE)
 bool isEpdRefreshing();
+// True until stepEpdRefresh() has reported completion — only one frame is ever in flight
+bool isEpdBusy();
+// False if the last cycle timed out or was cut short — controller RAM/panel content unknown
+bool epdLastFrameOk();
 
 // Start the waveform cycle. total wall-clock time is identical to blocking refresh.
 // Use after drawing is complete (buffer pushed to SSD1681 via firstPage/nextPage).
@@ -20,17 +25,23 @@ void triggerEpdRefresh(bool full_refresh);
 // Call this with the same params as setPartialWindow() when doing partial updates.
 void epdSetGRAMWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 
-// Call from main loop. Advances by ~0.5ms per call, checks BUSY pin every 10ms.
+// Stream a frame into controller RAM and refresh it. `frame` holds ceil(w/8)*h bytes of the
+// physical (unrotated) window, row-major, 1 = white; x and w must be multiples of 8. The buffer
+// is read by DMA and must stay untouched until stepEpdRefresh() reports completion.
+// Returns false (and does nothing) while another frame is in flight.
+bool epdStartFrame(const uint8_t* frame, uint16_t x, uint16_t y, uint16_t w, uint16_t h, bool full_refresh);
+
+// Call from main loop. Never waits: checks DMA END / BUSY pin and issues the next command.
 // Returns true on the first call after DONE (waveform just completed).
 bool stepEpdRefresh();
 
 // Manually power off (e.g. during sleep or when done with full refresh)
 void epdPowerOffNow();
 
-// Write a solid-color rectangle directly to SSD1681 GRAM and optionally trigger partial refresh.
+// Fill a rectangle of SSD1681 GRAM with a solid byte and start a partial refresh of it.
 // This writes pixel data directly to the e-ink controller memory without using GxEPD2's buffer model.
 // color_byte: 0xFF for white, 0x00 for black (byte-per-bitmap format)
-// Returns true when the refresh is complete (BUSY pin released).
+// Returns false if a frame is already in flight; completion is reported by stepEpdRefresh().
 bool epdWriteAndRefreshRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t color_byte);
 
 #endif
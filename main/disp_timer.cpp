@@ -12,6 +12,8 @@
 #include "disp_timer.h"
 #include "display_layout.h"
 #include "app_modes.h"
+#include "settings.h"
+#include "disp_budget.h"
 
 extern void forceFullRefresh();
 
@@ -27,7 +29,7 @@ void deferDraw(bool force_full_refresh) {
         return;
     }
     s_pending_draw = true;
-    s_force_full = force_full_refresh;
+    s_force_full |= force_full_refresh;     // Several paths may defer in one loop; a full request sticks
 }
 
 void flushDisplayIfNeeded() {
@@ -40,14 +42,19 @@ void flushDisplayIfNeeded() {
     }
 
     s_display_busy = true;
+    uint32_t t0 = micros();
     bool full = s_force_full;
     s_pending_draw = false;
+    s_force_full = false;
+    layout_state._dirty = false;
 
     if (full) forceFullRefresh();
 
-    // Re-render based on current mode from layout state
+    // Re-render based on current mode from layout state. The layouts only submit the frame;
+    // disp_budget decides when it reaches the panel.
     const char* mode = current_mode;
-    if (strcmp(mode, "RANGE") == 0) drawRangeLayout();
+    if (in_settings_mode) drawSettingsLayout();
+    else if (strcmp(mode, "RANGE") == 0) drawRangeLayout();
     else if (strcmp(mode, "BEACON") == 0) drawBeaconLayout();
     else if (strcmp(mode, "PTT") == 0) drawPttLayout();
     else if (strcmp(mode, "SCAN") == 0) drawScanLayout();
@@ -62,6 +69,7 @@ void flushDisplayIfNeeded() {
     else if (strcmp(mode, "WP") == 0) drawWpLayout();
     else drawDefaultLayout();
 
+    dispBudgetBlocked(micros() - t0);
     s_display_busy = false;
 }
 
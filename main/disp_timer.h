@@ -2,7 +2,10 @@
 // the main-loop button polling. The pattern:
 //   1. Code that needs a draw calls deferDraw() instead of drawXxxLayout()
 //   2. deferDraw() sets a flag and optionally forces full refresh
-//   3. flushDisplayIfNeeded() (called once per loop after BLE/GPS/button work) does the actual blocking refresh
+//   3. flushDisplayIfNeeded() (called once per loop after BLE/GPS/button work) does the actual render;
+//      the panel transfer and waveform then run in the background (dispFramePump(), disp_dirty.h)
+//   4. The frame is paced by disp_budget: at most one refresh per DISP_MIN_INTERVAL_MS (input
+//      skips the wait), with a full anti-ghosting refresh once partials pile up and the user is idle
 // This ensures button detection completes before any ~0.8-2.5s display update blocks the CPU.
 
 #ifndef DISP_TIMER_H
@@ -18,6 +18,10 @@
 #include <Fonts/FreeMonoBold9pt7b.h>
 #include <Fonts/FreeMonoBold12pt7b.h>
 #include "display.h"
+#include "disp_dirty.h"
+#include "disp_refresh.h"
+#include "display_layout.h"
+#include "epoch_clock.h"
 
 int disp_top_margin = 12;
 int disp_bottom_margin = 3;
@@ -185,7 +189,8 @@ void setupDisplay() {
     SPISettings spiSettings(4000000, MSBFIRST, SPI_MODE0);  // 4 MHz speed, MSB first, SPI mode 0
 
     // Now let's create the display class
-    display = new GxEPD2_BW<GxEPD2_150_BN, GxEPD2_150_BN::HEIGHT>(GxEPD2_150_BN(ePaper_Cs, ePaper_Dc, ePaper_Rst, ePaper_Busy));
+    // EpdTracked mirrors the frame buffer so the layout renderer can push only what changed
+    display = new EpdTracked(GxEPD2_150_BN(ePaper_Cs, ePaper_Dc, ePaper_Rst, ePaper_Busy));
 
     // init(0, true, 20, ...) — serial_diag_bitrate=0 disables diagnostic serial output (_diag_enabled stays false).
     display->init(0, true, 20, false, *dispPort, spiSettings);
@@ -196,6 +201,10 @@ void setupDisplay() {
     // to white (0xFF), then triggers one full waveform refresh (~4s).
     // This is the only correct way to fully reset the e-paper panel on boot.
     display->clearScreen();  // fills controller RAM + triggers one full refresh (cleans panel)
+
+    // From here on frames go out through disp_refresh (EasyDMA on the same SPIM, non-blocking)
+    initDispRefresh(dispPort, spiSettings, NRF_SPIM2);
+    dispFrameInvalidate();
 }
 
 void swapIconBytes(const uint16_t* originalIcon, uint16_t* swappedIcon, int size) {
@@ -215,36 +224,41 @@ void drawIcon(const uint16_t* icon_data, int x, int y, int height, int width, ui
 }
 
 void drawModeIcon(const char* mode) {
+    drawModeIcon(mode, in_settings_mode);
+}
+
+// Layouts pass the mode name they print, which need not be the current_mode pointer — compare text
+void drawModeIcon(const char* mode, bool settings) {
     bool icon_drawn = false;
 
-    if (mode == "OFF") {
+    if (strcmp(mode, "OFF") == 0) {
         drawIcon(off_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
         return;
     }
 
-    if (in_settings_mode) {
+    if (settings) {
         drawIcon(settings_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
         icon_drawn = true;
     } else {
-        if (mode == "PTT") {
+        if (strcmp(mode, "PTT") == 0) {
             drawIcon(ptt_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
             icon_drawn = true;
-        } else if (mode == "TXT") {
+        } else if (strcmp(mode, "TXT") == 0) {
             drawIcon(txt_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
             icon_drawn = true;
-        } else if (mode == "RAW") {
+        } else if (strcmp(mode, "RAW") == 0) {
             drawIcon(raw_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
             icon_drawn = true;
-        } else if (mode == "TST") {
+        } else if (strcmp(mode, "TST") == 0) {
             drawIcon(test_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
             icon_drawn = true;
-        } else if (mode == "RANGE") {
+        } else if (strcmp(mode, "RANGE") == 0) {
             drawIcon(range_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
             icon_drawn = true;
-        } else if (mode == "PONG") {
+        } else if (strcmp(mode, "PONG") == 0) {
             drawIcon(pong_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
             icon_drawn = true;
-        } else if (mode == "BEACON") {
+        } else if (strcmp(mode, "BEACON") == 0) {
             drawIcon(beacon_icon, 0, disp_top_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
             icon_drawn = true;
         }
@@ -288,11 +302,12 @@ bool pendingFullRefresh() {
     return false;
 }
 
-// ── OLD working rendering method: line-by-line with displayWindow ──
+// ── OLD working rendering method: line-by-line, whole window pushed through the frame pipeline ──
 void updDisp(uint8_t line, const char* msg, bool updateScreen) {
     if (line < displayLines && strcmp(disp_buf[line], msg) != 0) {  
         strncpy(disp_buf[line], msg, sizeof(disp_buf[line]) - 1);
         disp_buf[line][sizeof(disp_buf[line]) - 1] = '\0';
+        layoutInvalidate();
 
         drawModeIcon(current_mode);
 
@@ -311,7 +326,7 @@ void updDisp(uint8_t line, const char* msg, bool updateScreen) {
         printline(disp_buf[line]);
 
         if (updateScreen) {
-            display->displayWindow(0, 0, disp_width, disp_height);
+            dispFrameSubmit(true);
         }
     } else {
         // Update buffer even if content unchanged (no-op display render)
@@ -327,6 +342,7 @@ void printStatusOnApp();
 void updModeAndChannelDisplay() {
     // Full screen redraw on mode change — matching old working behavior.
     // fillScreen(WHITE) fills the GxEPD2 buffer with white, then we draw all elements.
+    layoutInvalidate();
     display->fillScreen(GxEPD_WHITE);
     drawModeIcon(current_mode);
 
@@ -337,7 +353,7 @@ void updModeAndChannelDisplay() {
         updDisp(1, displayString, true);  // triggers full screen push at end
     } else {
         char buf[30];
-        if (current_mode == "PTT") {
+        if (strcmp(current_mode, "PTT") == 0) {
             snprintf(buf, sizeof(buf), "chn:%c %dbps", channels[deviceSettings.channel_idx], getBitrateFromIndex(deviceSettings.bitrate_idx));
         } else {
             snprintf(buf, sizeof(buf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
@@ -347,6 +363,7 @@ void updModeAndChannelDisplay() {
 }
 
 void printStatusIcons() {
+    layoutInvalidate();
     uint8_t batteryPercentage = getBatteryPercentage();
     if (batteryPercentage > 90) {
         drawIcon(bat100_icon, disp_width - disp_icon_width - disp_right_margin, disp_height - disp_icon_height - disp_bottom_margin, disp_icon_height, disp_icon_width, GxEPD_WHITE, GxEPD_BLACK);
@@ -389,6 +406,7 @@ void printGPSIcon() {
 }
 
 void printFrequencyIcon(bool updateScreen) {
+    layoutInvalidate();
     display->fillRect(0, disp_height - disp_icon_height - (2 * disp_bottom_margin) - disp_window_offset + disp_font_height, 78, disp_font_height, GxEPD_WHITE);
     display->setCursor(0, disp_height - disp_icon_height - disp_bottom_margin + disp_font_height);
     display->setTextColor(GxEPD_BLACK);
@@ -397,12 +415,13 @@ void printFrequencyIcon(bool updateScreen) {
     snprintf(displayString, sizeof(displayString), "%.2f", currentFrequency);
     display->print(displayString);
     if (updateScreen) {
-        display->displayWindow(0, 0, disp_width, disp_height);
+        dispFrameSubmit(true);
     }
 }
 
 void printTimeIcon(bool updateScreen) {
-    RTC_Date dateTime = rtc.getDateTime();
+    layoutInvalidate();
+    RTC_Date dateTime = clockDateTime();
     char time_str[9];
     snprintf(time_str, sizeof(time_str), "%02d:%02d:%02d", dateTime.hour, dateTime.minute, dateTime.second);
     display->fillRect(5 * disp_font_height + 3, disp_height - disp_icon_height - (2 * disp_bottom_margin) - disp_window_offset + disp_font_height - 4, 39, disp_font_height, GxEPD_WHITE);
@@ -411,7 +430,7 @@ void printTimeIcon(bool updateScreen) {
     display->setFont(&Org_01);
     display->print(time_str);
     if (updateScreen) {
-        display->displayWindow(0, 0, disp_width, disp_height);
+        dispFrameSubmit(true);
     }
 }
 
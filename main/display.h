@@ -20,6 +20,7 @@ extern const uint16_t off_icon[16];
 
 void setupDisplay();
 void drawModeIcon(const char* mode);
+void drawModeIcon(const char* mode, bool settings);    // settings: gear icon instead of the mode's
 void drawIcon(const uint16_t* icon_data, int x, int y, int height, int width, uint16_t bg_color, uint16_t icon_color);
 void enableBacklight(bool en);
 void showError(const char* error_msg);
@@ -1,14 +1,6 @@
 #include "display_layout.h"
-#include "utilities.h"  // for ePaper_Busy pin definition
-#include "app_modes.h"
-#include "battery.h"
-#include "gps.h"
-#include "settings.h"
-#include "ble.h"
-#include "lora.h"
-#include "text_inbox.h"
-#include "scan.h"
-#include "screen_sync.h"
+#include "disp_dirty.h"
+#include "peer_roster.h"
 #include <Fonts/FreeMonoBold9pt7b.h>
 #include <Fonts/FreeMonoBold12pt7b.h>
 #include <Fonts/Org_01.h>
@@ -16,41 +8,92 @@
 // ── LayoutState definition ──
 LayoutState layout_state;
 
-void initLayoutState() {
-    memset(&layout_state, 0, sizeof(layout_state));
-    layout_state.mode = current_mode;
-    layout_state._dirty = false;
-    layout_state.beacon_distance = 0;
-    layout_state.range_distance_m = 0;
-    layout_state.range_sender = false;
-    layout_state.ptt_tx_active = false;
-    layout_state.ptt_rx_active = false;
-    layout_state.ptt_sending = false;
-    layout_state.ptt_receiving = false;
-    layout_state.ptt_state_changed_ms = 0;
-    layout_state.pong_state = 0;
-    layout_state.pong_rtt_ms = 0;
-    layout_state.scan_progress_pct = 0;
-    memset(layout_state.scan_current_freq, 0, sizeof(layout_state.scan_current_freq));
-    layout_state.scan_channel_count = 0;
-    memset(layout_state.scan_channels, 0, sizeof(layout_state.scan_channels));
-    memset(layout_state.raw_hex_line1, 0, sizeof(layout_state.raw_hex_line1));
-    memset(layout_state.raw_ascii_line, 0, sizeof(layout_state.raw_ascii_line));
-    layout_state.tst_sent = 0;
-    layout_state.tst_rcvd = 0;
-    layout_state.wp_lat = 0;
-    layout_state.wp_lon = 0;
-    layout_state.wp_alt = 0;
-    memset(layout_state.wp_label, 0, sizeof(layout_state.wp_label));
-    layout_state.wp_broadcasting = false;
-    layout_state.wp_bcast_remaining_s = 0;
+// ── Live inputs ──
+static bool s_fixture = false;
+
+void layoutUseFixture(bool on) {
+    s_fixture = on;
+}
+
+// First thing every layout does: refresh the inputs it draws from, unless a fixture owns them
+static void layoutInputs(uint16_t parts) {
+    if (!s_fixture) layoutCaptureLive(parts);
+}
+
+// ── Retained widget tree ──
+// Every layout is a root with three widgets: header band, body and status bar. Each widget keeps
+// a hash of the inputs it was last drawn from (the layout's LayoutState fields, not the pixels). renderPageLoop() redraws only widgets whose hash moved, clipped to their rect so the
+// rest of the retained frame is left alone, and does no work at all when nothing moved.
+enum LayoutWidgetId { LW_HEADER, LW_BODY, LW_STATUS, LW_COUNT };
+
+struct LayoutWidget {
+    int16_t x, y, w, h;
+    uint32_t hash;
+    bool dirty;
+};
+
+// Rows 0-31 header, 32-167 body, 168-199 status bar (drawBottomStatusbar)
+static LayoutWidget s_lw[LW_COUNT] = {
+    { 0, 0,   200, 32,  0, true },
+    { 0, 32,  200, 136, 0, true },
+    { 0, 168, 200, 32,  0, true },
+};
+static const void* s_lw_root = nullptr;     // Layout the retained hashes belong to
+static bool s_lw_rendering = false;
+
+// Something drew into the frame outside the layouts (updDisp, status icons) — next layout call
+// redraws every widget
+void layoutInvalidate() {
+    s_lw_root = nullptr;
+}
+
+// Shared primitives skip the formatting and drawing for widgets that are not being redrawn
+static bool layoutWidgetLive(LayoutWidgetId id) {
+    return !s_lw_rendering || s_lw[id].dirty;
+}
+
+// FNV-1a, same as the BLE command table
+#define LW_HASH_SEED    2166136261u
+
+static uint32_t hashBytes(uint32_t h, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t hashInt(uint32_t h, int32_t v) {
+    return hashBytes(h, &v, sizeof(v));
+}
+
+// Quantized to what the layout prints, so sub-digit jitter doesn't force a redraw
+static uint32_t hashFixed(uint32_t h, double v, double scale) {
+    return hashInt(h, (int32_t)lround(v * scale));
+}
+
+static uint32_t hashStr(uint32_t h, const char* s) {
+    return s ? hashBytes(h, s, strlen(s) + 1) : hashInt(h, 0);
+}
+
+// Header inputs: label plus everything the channel/SF (or bitrate) box can show
+static uint32_t headerHash(const char* label) {
+    uint32_t h = hashStr(LW_HASH_SEED, label);
+    h = hashInt(h, layout_state.in_settings);
+    h = hashInt(h, layout_state.chan);
+    h = hashInt(h, layout_state.settings.spreading_factor);
+    return hashInt(h, layout_state.bitrate_bps);
 }
 
 // ── Primitive: draw header row (y=12) ──
 void drawHeaderRow(const char* mode_name, const char* channel_sf) {
-    drawModeIcon(mode_name);
+    if (!layoutWidgetLive(LW_HEADER)) return;
+    dispWidget(0, disp_top_margin, disp_icon_width, disp_icon_height);
+    drawModeIcon(mode_name, layout_state.in_settings);
 
     int name_x = 24;
+    dispWidget(name_x, disp_top_margin, 100, 16);
     display->setFont(&FreeMonoBold9pt7b);
 
     // Black box behind mode name — text centered vertically in the 16px bar
@@ -61,6 +104,7 @@ void drawHeaderRow(const char* mode_name, const char* channel_sf) {
 
     // Channel/SF right-aligned at far-right edge
     int channel_x = disp_width - 90;
+    dispWidget(channel_x, disp_top_margin, 86, 16);
     display->fillRect(channel_x, disp_top_margin, 86, 16, GxEPD_BLACK);
     display->setCursor(channel_x + 4, disp_top_margin + 11);
     display->setTextColor(GxEPD_WHITE);
@@ -71,6 +115,7 @@ void drawHeaderRow(const char* mode_name, const char* channel_sf) {
 
 // ── Primitive: black box tag ──
 void drawBlackBoxTag(const char* text, int x, int y, int w, int h) {
+    dispWidget(x, y, w, h);
     display->fillRect(x, y, w, h, GxEPD_BLACK);
     // Estimate text width to center in box
     int text_w = strlen(text) * 7;  // approximate for FreeMonoBold9pt7b
@@ -86,20 +131,33 @@ void drawBlackBoxTag(const char* text, int x, int y, int w, int h) {
 void drawSolidBar(int x, int y, int w, int h, uint16_t color) {
     // Minimum 3px for visual weight; if h < 3, fill up to 3
     int draw_h = (h < 3) ? 3 : h;
+    dispWidget(x, y, w, draw_h);
     display->fillRect(x, y, w, draw_h, GxEPD_BLACK);
 }
 
 // ── Primitive: bordered rectangle ──
 void drawBorderedRect(int x, int y, int w, int h) {
+    dispWidget(x, y, w, h);
     display->fillRect(x, y, w, h, GxEPD_WHITE);
     display->drawRect(x, y, w, h, GxEPD_BLACK);
 }
 
+// Text primitives own the band from x to the right edge at the current font's height, so a
+// shorter string than last frame still refreshes the tail it leaves behind
+static void textRowWidget(const char* text, int x, int baseline) {
+    int16_t bx, by;
+    uint16_t bw, bh;
+    display->getTextBounds(text, x, baseline, &bx, &by, &bw, &bh);
+    if (bh == 0) return;
+    dispWidget(x, by, disp_width - x, bh);
+}
+
 // ── Primitive: primary value text (centered horizontally at given Y) ──
 void drawPrimaryValue(const char* text, const GFXfont* font, int x, int y) {
     display->setFont(font);
     int text_w = strlen(text) * 8;  // approximate
     int cx = (disp_width - text_w) / 2;
+    textRowWidget(text, 0, y + 10);
     display->setCursor(cx, y + 10);
     display->setTextColor(GxEPD_BLACK);
     display->print(text);
@@ -108,6 +166,7 @@ void drawPrimaryValue(const char* text, const GFXfont* font, int x, int y) {
 // ── Primitive: secondary row (left-aligned at given Y) ──
 void drawSecondaryRow(const char* text, int y) {
     display->setFont(&FreeMonoBold9pt7b);
+    textRowWidget(text, 12, y + 10);
     display->setCursor(12, y + 10);
     display->setTextColor(GxEPD_BLACK);
     display->print(text);
@@ -116,13 +175,36 @@ void drawSecondaryRow(const char* text, int y) {
 // ── Primitive: monospace aligned text ──
 void drawMonospaceAligned(const char* text, int x, int y) {
     display->setFont(&FreeMonoBold9pt7b);
+    textRowWidget(text, x, y + 10);
     display->setCursor(x, y + 10);
     display->setTextColor(GxEPD_BLACK);
     display->print(text);
 }
 
+static const uint16_t* statusBattIcon() {
+    uint8_t batt_pct = layout_state.batt_pct;
+    if (batt_pct > 90) return bat100_icon;
+    if (batt_pct > 80) return bat80_icon;
+    if (batt_pct > 60) return bat60_icon;
+    if (batt_pct > 40) return bat40_icon;
+    if (batt_pct > 20) return bat20_icon;
+    if (batt_pct > 10) return bat10_icon;
+    return bat0_icon;
+}
+
+// Status bar inputs: frequency to 10kHz, HH:MM, satellites, battery icon step
+static uint32_t statusBarHash() {
+    const LayoutState& S = layout_state;
+    uint32_t h = hashFixed(LW_HASH_SEED, S.freq_mhz, 100);
+    h = hashInt(h, S.clock_h * 60 + S.clock_m);
+    h = hashInt(h, S.gps_sats);
+    return hashInt(h, (int32_t)(uintptr_t)statusBattIcon());
+}
+
 // ── Primitive: bottom status bar (y=168) ──
 void drawBottomStatusbar() {
+    if (!layoutWidgetLive(LW_STATUS)) return;
+
     // Fill entire 200x32 rect with BLACK first
     display->fillRect(0, disp_height - 32, disp_width, 32, GxEPD_BLACK);
 
@@ -130,35 +212,30 @@ void drawBottomStatusbar() {
 
     // Frequency (white text, x=4)
     char freq_str[12];
-    snprintf(freq_str, sizeof(freq_str), "%.2f", currentFrequency);
+    snprintf(freq_str, sizeof(freq_str), "%.2f", layout_state.freq_mhz);
     display->setFont(&FreeMonoBold9pt7b);
+    dispWidget(0, sb_y, 72, 32);
     display->setCursor(4, sb_y + 20);
     display->setTextColor(GxEPD_WHITE);
     display->print(freq_str);
 
     // Time (white text, center ~95)
-    RTC_Date dateTime = rtc.getDateTime();
     char time_str[9];
-    snprintf(time_str, sizeof(time_str), "%02d:%02d", dateTime.hour, dateTime.minute);
+    snprintf(time_str, sizeof(time_str), "%02d:%02d", layout_state.clock_h, layout_state.clock_m);
     int time_w = strlen(time_str) * 8;
+    dispWidget((disp_width - time_w) / 2, sb_y, time_w + 8, 32);
     display->setCursor((disp_width - time_w) / 2, sb_y + 20);
     display->print(time_str);
 
     // Sat count (white text, ~155)
+    dispWidget(152, sb_y, 24, 32);
     display->setCursor(152, sb_y + 20);
-    display->print(gps_satellites);
+    display->print(layout_state.gps_sats);
 
     // Battery icon (white, far-right) — use bat icons via drawIcon
-    uint8_t batt_pct = getBatteryPercentage();
-    const uint16_t* batt_icon = nullptr;
-    if (batt_pct > 90) batt_icon = bat100_icon;
-    else if (batt_pct > 80) batt_icon = bat80_icon;
-    else if (batt_pct > 60) batt_icon = bat60_icon;
-    else if (batt_pct > 40) batt_icon = bat40_icon;
-    else if (batt_pct > 20) batt_icon = bat20_icon;
-    else if (batt_pct > 10) batt_icon = bat10_icon;
-    else batt_icon = bat0_icon;
+    const uint16_t* batt_icon = statusBattIcon();
 
+    dispWidget(disp_width - disp_icon_width - disp_right_margin, sb_y + 2, disp_icon_width, disp_icon_height);
     drawIcon(batt_icon, disp_width - disp_icon_width - disp_right_margin, sb_y + 2, disp_icon_height, disp_icon_width, GxEPD_BLACK, GxEPD_WHITE);
 
     // Revert colors
@@ -166,59 +243,104 @@ void drawBottomStatusbar() {
 }
 
 // ── Internal: common page-loop for all layouts.
-//     use_full_refresh=true  → write content to GRAM + full waveform (~3.8s, no flicker)
-//     use_full_refresh=false → two-step GRAM write: white→refresh→black→refresh (~1.6s, no flicker)
-// ── Internal: common page-loop for all layouts.
-//     use_full_refresh=true  → full panel refresh (~2.5s, no ghosting)
-//     use_full_refresh=false → partial update via nextPage() (~0.8s, clean)
-// Both paths use GxEPD2's tested writeImage + refresh LUT internally.
+//     use_full_refresh=true  → every widget redrawn, whole window pushed (mode switch)
+//     use_full_refresh=false → only widgets whose input hash changed are redrawn, or nothing
+// Rendering only touches the off-screen frame; the transfer and waveform (~0.8s) run in the
+// background from dispFramePump(), so this returns in a few ms.
 // ──
 
 typedef void (*drawFn)();
 
-static void renderPageLoop(drawFn drawContent, bool use_full_refresh) {
+static void renderPageLoop(drawFn drawContent, bool use_full_refresh, uint32_t header_hash, uint32_t body_hash) {
+    const uint32_t hashes[LW_COUNT] = { header_hash, body_hash, statusBarHash() };
+    bool all = use_full_refresh || dispFrameStale() || s_lw_root != (const void*)drawContent;
+    uint8_t changed = 0;
+    for (uint8_t i = 0; i < LW_COUNT; i++) {
+        s_lw[i].dirty = all || s_lw[i].hash != hashes[i];
+        s_lw[i].hash = hashes[i];
+        if (s_lw[i].dirty) changed++;
+    }
+    s_lw_root = (const void*)drawContent;
+    if (changed == 0) {
+        dispFrameUnchanged();
+        return;     // Same inputs as the frame already on (or headed for) the panel
+    }
+
+    dispFrameBegin();
+    if (!all) {
+        dispClipBegin();
+        for (uint8_t i = 0; i < LW_COUNT; i++) {
+            if (s_lw[i].dirty) dispClipAdd(s_lw[i].x, s_lw[i].y, s_lw[i].w, s_lw[i].h);
+        }
+    }
+    s_lw_rendering = true;
     display->fillScreen(GxEPD_WHITE);
     drawContent();
-    // Use displayWindow() — single writeImagePart + refresh cycle, no double-step fade.
-    // The old working code used this exact approach for every screen update.
-    display->displayWindow(0, 0, disp_width, disp_height);
+    s_lw_rendering = false;
+    dispClipEnd();
+
+    // Hand the frame to the async pipeline: only the byte-aligned union of what changed since the
+    // last pushed frame is streamed, or nothing at all. Mode switches push the whole window.
+    dispFrameSubmit(use_full_refresh);
 }
 
 // ── Default layout: header row + bottom status bar ──
 void drawDefaultLayout() {
+    layoutInputs(0);
     bool full = pendingFullRefresh();  // true on mode switch, false for normal updates
 
     auto drawContent = []() {
+        const LayoutState& S = layout_state;
         char chan_sf[20];
-        if (current_mode == "PTT") {
-            snprintf(chan_sf, sizeof(chan_sf), "chn:%c %dbps", channels[deviceSettings.channel_idx], getBitrateFromIndex(deviceSettings.bitrate_idx));
+        if (strcmp(S.mode, "PTT") == 0) {
+            snprintf(chan_sf, sizeof(chan_sf), "chn:%c %dbps", S.chan, S.bitrate_bps);
         } else {
-            snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+            snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", S.chan, S.settings.spreading_factor);
         }
 
-        drawHeaderRow(current_mode, chan_sf);
+        drawHeaderRow(S.mode, chan_sf);
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash(layout_state.mode), 0);
 }
+
+static uint8_t beaconRows() {
+    return layout_state.peer_count < LAYOUT_PEER_ROWS ? layout_state.peer_count : LAYOUT_PEER_ROWS;
+}
+
+static uint32_t beaconBodyHash() {
+    const LayoutState& S = layout_state;
+    uint32_t h = hashFixed(LW_HASH_SEED, S.beacon_best_dist, 10);
+    h = hashStr(h, S.beacon_best_name);
+    h = hashInt(h, S.peer_count);
+    for (uint8_t i = 0; i < beaconRows(); i++) {
+        h = hashStr(h, S.peers[i].name);
+        h = hashFixed(h, S.peers[i].dist_m, 1.0 / ROSTER_DIST_STEP_M);
+        h = hashInt(h, S.peers[i].batt);
+    }
+    return h;
+}
+
+// ── Per-mode: BEACON — closest peer + roster ──
 void drawBeaconLayout() {
+    layoutInputs(LI_BEACON);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
+        const LayoutState& S = layout_state;
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("BEACON", chan_sf);
 
         // Peer name and distance area (rows 2-5)
         display->fillRect(12, 32, disp_width - 24, 80, GxEPD_WHITE);
 
-        double bestDist = beacon_display_dist;
-        String bestName = beacon_display_name;
+        double bestDist = S.beacon_best_dist;
 
-        if (bestDist >= 0 && peerRosterCount > 0) {
+        if (bestDist >= 0 && S.peer_count > 0) {
             // Show closest peer with distance
             display->setFont(&FreeMonoBold9pt7b);
             int dy = 36;
@@ -229,12 +351,12 @@ void drawBeaconLayout() {
             display->setTextColor(GxEPD_WHITE);
 
             // Truncate long call signs for display
-            char nameDisplay[20];
-            String bn = bestName;
-            if (bn.length() > 18) {
-                bn = bn.substring(0, 17) + "...";
+            char nameDisplay[24];
+            if (strlen(S.beacon_best_name) > 18) {
+                snprintf(nameDisplay, sizeof(nameDisplay), "%.17s...", S.beacon_best_name);
+            } else {
+                snprintf(nameDisplay, sizeof(nameDisplay), "%s", S.beacon_best_name);
             }
-            strncpy(nameDisplay, bn.c_str(), sizeof(nameDisplay));
             display->print(nameDisplay);
 
             dy += 22;
@@ -257,20 +379,21 @@ void drawBeaconLayout() {
         // Peer count on a separate line
         display->fillRect(12, 74, disp_width - 24, 14, GxEPD_WHITE);
         char buf[30];
-        snprintf(buf, sizeof(buf), "%d peers", peerRosterCount);
+        snprintf(buf, sizeof(buf), "%d peers", S.peer_count);
         display->setCursor(16, 74 + 10);
         display->setTextColor(GxEPD_BLACK);
         display->print(buf);
 
         // Peer roster list starting at y=90 (lines 7-12+)
         int rosterStartY = 88;
-        int maxRows = (disp_height - 104) / 12;  // rows after header/status
+        int maxRows = LAYOUT_PEER_ROWS;  // rows after header/status
         int rosterIdx = 0;
 
-        for (int i = 0; i < peerRosterCount && rosterIdx < maxRows; i++) {
-            float dist = peerRoster[i].distanceM;
-            const char* displayName = peerRoster[i].callSign[0] != '\0' ? peerRoster[i].callSign : peerRoster[i].deviceId.c_str();
-            int batt = peerRoster[i].battery;
+        // Nearest first — the roster keeps the order
+        for (uint8_t i = 0; i < beaconRows(); i++) {
+            float dist = S.peers[i].dist_m;
+            const char* displayName = S.peers[i].name;
+            int batt = S.peers[i].batt;
 
             // Clear the row background
             display->fillRect(12, rosterStartY + (rosterIdx * 12), disp_width - 24, 12, GxEPD_WHITE);
@@ -309,18 +432,33 @@ void drawBeaconLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("BEACON"), beaconBodyHash());
+}
+
+static uint32_t rangeBodyHash() {
+    const LayoutState& S = layout_state;
+    uint32_t h = hashInt(LW_HASH_SEED, S.range_sender);
+    h = hashInt(h, S.gps_fix);
+    if (!S.gps_fix) return hashFixed(h, S.gps_hdop, 10);
+    h = hashFixed(h, S.gps_lat, 1e6);
+    h = hashFixed(h, S.gps_lon, 1e6);
+    h = hashFixed(h, S.range_stable_m, 10);
+    h = hashFixed(h, S.range_max_m, 10);
+    h = hashInt(h, S.range_loss);
+    return hashInt(h, S.range_ok);
 }
 
 // ── Per-mode: RANGE — distance + role card ──
 void drawRangeLayout() {
+    layoutInputs(LI_RANGE);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
+        const LayoutState& S = layout_state;
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("RANGE", chan_sf);
 
         display->fillRect(12, 32, disp_width - 24, 80, GxEPD_WHITE);
@@ -331,12 +469,12 @@ void drawRangeLayout() {
         display->fillRect(12, row, disp_width - 24, 16, GxEPD_BLACK);
         display->setCursor(16, row + 11);
         display->setTextColor(GxEPD_WHITE);
-        display->print(range_role_sender ? "Role: SENDER" : "Role: RECEIVER");
+        display->print(S.range_sender ? "Role: SENDER" : "Role: RECEIVER");
 
-        if (gps_status != GPS_LOC) {
+        if (!S.gps_fix) {
             row += 20;
             char disp_msg[32];
-            snprintf(disp_msg, sizeof(disp_msg), "GPS: %.1f", gps_hdop);
+            snprintf(disp_msg, sizeof(disp_msg), "GPS: %.1f", S.gps_hdop);
             display->fillRect(12, row, disp_width - 24, 14, GxEPD_WHITE);
             display->setCursor(16, row + 10);
             display->setTextColor(GxEPD_BLACK);
@@ -345,14 +483,14 @@ void drawRangeLayout() {
             // Coordinates
             row += 20;
             char disp_msg[32];
-            snprintf(disp_msg, sizeof(disp_msg), "%.6f", gps_latitude);
+            snprintf(disp_msg, sizeof(disp_msg), "%.6f", S.gps_lat);
             display->fillRect(12, row, disp_width - 24, 14, GxEPD_WHITE);
             display->setCursor(16, row + 10);
             display->setTextColor(GxEPD_BLACK);
             display->print(disp_msg);
 
             row += 18;
-            snprintf(disp_msg, sizeof(disp_msg), "%.6f", gps_longitude);
+            snprintf(disp_msg, sizeof(disp_msg), "%.6f", S.gps_lon);
             display->fillRect(12, row, disp_width - 24, 14, GxEPD_WHITE);
             display->setCursor(16, row + 10);
             display->setTextColor(GxEPD_BLACK);
@@ -360,14 +498,14 @@ void drawRangeLayout() {
 
             // Distance readings
             row += 20;
-            snprintf(disp_msg, sizeof(disp_msg), "Rng:%.1fm", range_stable_dist > 0 ? range_stable_dist : 0);
+            snprintf(disp_msg, sizeof(disp_msg), "Rng:%.1fm", S.range_stable_m > 0 ? S.range_stable_m : 0);
             display->fillRect(12, row, disp_width - 24, 14, GxEPD_WHITE);
             display->setCursor(16, row + 10);
             display->setTextColor(GxEPD_BLACK);
             display->print(disp_msg);
 
             row += 18;
-            snprintf(disp_msg, sizeof(disp_msg), "Max:%.1fm", range_max_dist > 0 ? range_max_dist : 0);
+            snprintf(disp_msg, sizeof(disp_msg), "Max:%.1fm", S.range_max_m > 0 ? S.range_max_m : 0);
             display->fillRect(12, row, disp_width - 24, 14, GxEPD_WHITE);
             display->setCursor(16, row + 10);
             display->setTextColor(GxEPD_BLACK);
@@ -375,7 +513,7 @@ void drawRangeLayout() {
 
             // Packet loss stats
             row += 18;
-            snprintf(disp_msg, sizeof(disp_msg), "PLoss:%d/%d", range_total_pckt_loss, range_consecutive_ok);
+            snprintf(disp_msg, sizeof(disp_msg), "PLoss:%d/%d", S.range_loss, S.range_ok);
             display->fillRect(12, row, disp_width - 24, 14, GxEPD_WHITE);
             display->setCursor(16, row + 10);
             display->setTextColor(GxEPD_BLACK);
@@ -385,11 +523,21 @@ void drawRangeLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("RANGE"), rangeBodyHash());
+}
+
+static uint32_t pttBodyHash() {
+    uint32_t h = hashInt(LW_HASH_SEED, layout_state.ptt_tx_active);
+    h = hashInt(h, layout_state.ptt_rx_active);
+    h = hashInt(h, layout_state.chan);
+    h = hashInt(h, layout_state.bitrate_bps);
+    h = hashFixed(h, layout_state.radio_snr, 10);
+    return hashFixed(h, layout_state.radio_rssi, 1);
 }
 
 // ── Per-mode: PTT Big Card TX/RX state block ──
 void drawPttLayout() {
+    layoutInputs(LI_RADIO);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
@@ -414,7 +562,7 @@ void drawPttLayout() {
         }
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c %dbps", channels[deviceSettings.channel_idx], getBitrateFromIndex(deviceSettings.bitrate_idx));
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c %dbps", layout_state.chan, layout_state.bitrate_bps);
         drawHeaderRow("PTT", chan_sf);
 
         // State block at y=48 — bordered rect (176x82 pixels)
@@ -460,31 +608,44 @@ void drawPttLayout() {
 
         char chan_detail[32];
         snprintf(chan_detail, sizeof(chan_detail), "chn:%c %dbps",
-                 channels[deviceSettings.channel_idx],
-                 getBitrateFromIndex(deviceSettings.bitrate_idx));
+                 layout_state.chan,
+                 layout_state.bitrate_bps);
         display->print(chan_detail);
 
         // Signal metrics on next row
         display->setCursor(12, blk_y + blk_h + 36);
 
         char sig_buf[50];
-        float rssi_val = (radio != nullptr) ? radio->getRSSI() : -127.0f;
-        float snr_val = (radio != nullptr) ? radio->getSNR() : 0.0f;
+        float rssi_val = layout_state.radio_rssi;
+        float snr_val = layout_state.radio_snr;
         snprintf(sig_buf, sizeof(sig_buf), "SNR:%.1fdB RSSI:%.0fdBm", snr_val, rssi_val);
         display->print(sig_buf);
 
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("PTT"), pttBodyHash());
+}
+
+// The log only ever appends or clears, so count + revision covers every visible row
+static uint32_t inboxHash(uint32_t h) {
+    h = hashInt(h, layout_state.inbox_count);
+    return hashInt(h, layout_state.inbox_rev);
+}
+
+static uint32_t txtBodyHash() {
+    uint32_t h = hashInt(LW_HASH_SEED, layout_state.txt_unread);
+    h = hashInt(h, layout_state.txt_page);
+    h = hashInt(h, layout_state.peer_alive);
+    return inboxHash(h);
 }
 
 // ── Per-mode: TXT single message (from packet) ──
 void drawTxtSingleLayout() {
     markScreenDirty();
+    layoutInputs(LI_TXT);
     // Guard: never render TXT layout when not in TXT mode (prevents TST flash artifact)
-    extern const char* current_mode;
-    if (strcmp(current_mode, "TXT") != 0) {
+    if (strcmp(layout_state.mode, "TXT") != 0) {
         return;
     }
 
@@ -494,24 +655,24 @@ void drawTxtSingleLayout() {
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("TXT", chan_sf);
 
         // Show latest message content
         display->fillRect(12, 32, disp_width - 24, 80, GxEPD_WHITE);
 
         char buf[60];
-        snprintf(buf, sizeof(buf), "%d msg(s)", txtInboxMsgCount > 0 ? txtInboxMsgCount : inboxCount());
+        const LayoutState& S = layout_state;
+        snprintf(buf, sizeof(buf), "%d msg(s)", S.txt_unread > 0 ? S.txt_unread : S.inbox_count);
         display->setCursor(16, 36 + 10);
         display->setFont(&FreeMonoBold9pt7b);
         display->setTextColor(GxEPD_BLACK);
         display->print(buf);
 
         // Show latest message preview
-        if (txtInboxMsgCount > 0) {
-            uint8_t count = inboxCount();
-            if (count > 0) {
-                inboxGetMessage(count - 1, buf, sizeof(buf));
+        if (S.txt_unread > 0) {
+            if (S.inbox_count > 0 && S.txt_preview) {
+                snprintf(buf, sizeof(buf), "%s", S.txt_preview);
                 display->fillRect(12, 56, disp_width - 24, 14, GxEPD_WHITE);
                 display->setCursor(16, 56 + 10);
                 display->print(buf);
@@ -524,8 +685,7 @@ void drawTxtSingleLayout() {
 
         // Show peer/peer channel liveness status at y=130 (like BEACON's distance readout)
         display->fillRect(12, 128, disp_width - 24, 14, GxEPD_WHITE);
-        extern bool isPeerAlive();
-        if (isPeerAlive()) {
+        if (S.peer_alive) {
             drawPrimaryValue("\u2713 On channel", &FreeMonoBold9pt7b, 16, 128);
         } else {
             drawSecondaryRow("No one on channel", 130);
@@ -534,28 +694,30 @@ void drawTxtSingleLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("TXT"), txtBodyHash());
 }
 
 // ── Per-mode: TXT inbox (from txtShowInbox view) ──
 void drawTxtInboxLayout() {
     markScreenDirty();
+    layoutInputs(LI_TXT | LI_INBOX);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
+        const LayoutState& S = layout_state;
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("TXT", chan_sf);
 
         // Inbox page header
-        uint8_t msg_count = txtInboxMsgCount > 0 ? txtInboxMsgCount : inboxCount();
+        uint16_t msg_count = S.txt_unread > 0 ? S.txt_unread : S.inbox_count;
 
         display->fillRect(12, 32, disp_width - 24, 16, GxEPD_BLACK);
         char page_header[32];
         snprintf(page_header, sizeof(page_header), "P %d/%d (%d msgs)",
-                 txtInboxScrollPage + 1, (msg_count + 15) / 16, msg_count);
+                 S.txt_page + 1, (msg_count + LAYOUT_INBOX_PAGE - 1) / LAYOUT_INBOX_PAGE, msg_count);
         display->setCursor(16, 32 + 11);
         display->setFont(&FreeMonoBold9pt7b);
         display->setTextColor(GxEPD_WHITE);
@@ -563,26 +725,24 @@ void drawTxtInboxLayout() {
 
         // Message list rows (starting at y=50)
         int rosterStartY = 50;
-        int maxRows = (disp_height - 104) / 10;  // leave room for peer status line
-
-        char inbox_msg_buf[INBOX_MAX_MSG_LEN + 1];
+        int maxRows = LAYOUT_INBOX_ROWS;  // leave room for peer status line
 
-        for (int i = 0; i < msg_count && ((i - txtInboxScrollPage * 16) < maxRows) && (i - txtInboxScrollPage * 16) >= 0; i++) {
-            int rowIdx = i - txtInboxScrollPage * 16;
-            if (i < txtInboxScrollPage * 16 || i >= (txtInboxScrollPage + 1) * 16) continue;
+        // Only the rows of this page are read from the log
+        for (int i = S.txt_page * LAYOUT_INBOX_PAGE; i < msg_count && (i - S.txt_page * LAYOUT_INBOX_PAGE) < maxRows; i++) {
+            int rowIdx = i - S.txt_page * LAYOUT_INBOX_PAGE;
+            const char* row = S.inbox_rows[rowIdx];
+            if (!row) continue;
 
-            inboxGetMessage(i, inbox_msg_buf, sizeof(inbox_msg_buf));
             display->fillRect(12, rosterStartY + (rowIdx * 10), disp_width - 24, 10, GxEPD_WHITE);
             display->setCursor(16, rosterStartY + (rowIdx * 10) + 8);
             display->setFont(&FreeMonoBold9pt7b);
             display->setTextColor(GxEPD_BLACK);
-            display->print(inbox_msg_buf);
+            display->print(row);
         }
 
         // Peer/peer channel liveness status at bottom of message list (above statusbar)
         display->fillRect(12, 160, disp_width - 24, 14, GxEPD_WHITE);
-        extern bool isPeerAlive();
-        if (isPeerAlive()) {
+        if (S.peer_alive) {
             drawPrimaryValue("\u2713 On channel", &FreeMonoBold9pt7b, 16, 160);
         } else {
             drawSecondaryRow("No one on channel", 162);
@@ -591,27 +751,33 @@ void drawTxtInboxLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("TXT"), txtBodyHash());
+}
+
+static uint32_t tstBodyHash() {
+    uint32_t h = hashInt(LW_HASH_SEED, layout_state.tst_sent);
+    return hashInt(h, layout_state.tst_rcvd);
 }
 
 // ── Per-mode: TST — Sent/Recv dashboard ──
 void drawTstLayout() {
     markScreenDirty();
+    layoutInputs(LI_TST);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("TST", chan_sf);
 
         display->fillRect(12, 32, disp_width - 24, 80, GxEPD_WHITE);
 
         char buf[40];
 
-        int sent = test_message_counter;
-        int recv = pckt_count;
+        int sent = layout_state.tst_sent;
+        int recv = layout_state.tst_rcvd;
         snprintf(buf, sizeof(buf), "Sent: %d", sent);
         display->setCursor(16, 36 + 10);
         display->setFont(&FreeMonoBold9pt7b);
@@ -627,19 +793,25 @@ void drawTstLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("TST"), tstBodyHash());
+}
+
+static uint32_t pongBodyHash() {
+    uint32_t h = hashInt(LW_HASH_SEED, layout_state.pong_state);
+    return hashInt(h, layout_state.pong_rtt_ms);
 }
 
 // ── Per-mode: PONG — state + RTT display ──
 void drawPongLayout() {
     markScreenDirty();
+    layoutInputs(0);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("PONG", chan_sf);
 
         display->fillRect(12, 32, disp_width - 24, 80, GxEPD_WHITE);
@@ -670,28 +842,34 @@ void drawPongLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("PONG"), pongBodyHash());
+}
+
+static uint32_t scanBodyHash() {
+    uint32_t h = hashInt(LW_HASH_SEED, layout_state.scan_progress_pct);
+    h = hashStr(h, layout_state.scan_current_freq);
+    h = hashFixed(h, layout_state.freq_mhz, 100);
+    h = hashInt(h, layout_state.scan_channel_count);
+    for (uint8_t i = 0; i < layout_state.scan_channel_count && i < 10; i++) {
+        const LayoutState::ScanChannel& ch = layout_state.scan_channels[i];
+        h = hashFixed(h, ch.frequency, 100);
+        h = hashInt(h, ch.quality);
+        h = hashFixed(h, ch.rssi, 1);
+    }
+    return h;
 }
 
 // ── Per-mode: SCAN — scan progress + top channels ──
 void drawScanLayout() {
     markScreenDirty();
+    layoutInputs(LI_SCAN);
     bool full = pendingFullRefresh();
 
-    // Sync scan state into layout_state for this render pass
-    LayoutState& S = layout_state;
-    S.scan_progress_pct = scanning ? (int)((currentFrequency - startFreq) / (endFreq - startFreq) * 100) : 0;
-    if (scanning) {
-        snprintf(S.scan_current_freq, sizeof(S.scan_current_freq), "%.2f", currentFrequency);
-    } else {
-        snprintf(S.scan_current_freq, sizeof(S.scan_current_freq), "---");
-    }
-
     auto drawContent = []() {
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("SCAN", chan_sf);
 
         // ── Current frequency (rows 2-3) ──
@@ -702,7 +880,7 @@ void drawScanLayout() {
 
         char freqBuf[20];
         if (strlen(layout_state.scan_current_freq) > 0 && layout_state.scan_current_freq[0] != '-') {
-            snprintf(freqBuf, sizeof(freqBuf), "F:%.2fMHz", currentFrequency);
+            snprintf(freqBuf, sizeof(freqBuf), "F:%.2fMHz", layout_state.freq_mhz);
         } else {
             snprintf(freqBuf, sizeof(freqBuf), "F:---.--MHz");
         }
@@ -772,19 +950,24 @@ void drawScanLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("SCAN"), scanBodyHash());
+}
+
+static uint32_t rawBodyHash() {
+    return hashStr(LW_HASH_SEED, layout_state.raw_hex_line1);
 }
 
 // ── Per-mode: RAW — raw packet hex display ──
 void drawRawLayout() {
     markScreenDirty();
+    layoutInputs(0);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("RAW", chan_sf);
 
         display->fillRect(12, 32, disp_width - 24, 80, GxEPD_WHITE);
@@ -804,21 +987,41 @@ void drawRawLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("RAW"), rawBodyHash());
+}
+
+static uint32_t settingsBodyHash() {
+    const LayoutState& S = layout_state;
+    uint32_t h = hashInt(LW_HASH_SEED, S.setting_idx);
+    h = hashInt(h, S.settings.spreading_factor);
+    h = hashInt(h, S.chan);
+    h = hashInt(h, S.bitrate_bps);
+    h = hashInt(h, S.settings.backlight);
+    h = hashInt(h, S.settings.volume_level);
+    h = hashInt(h, S.settings.bandwidth_idx);
+    h = hashInt(h, S.settings.coding_rate_idx);
+    h = hashInt(h, S.settings.frequency_hopping_enabled);
+    h = hashInt(h, S.panel_refresh);
+    if (S.setting_idx == HOURS || S.setting_idx == MINUTES || S.setting_idx == SECONDS) {
+        h = hashInt(h, (S.clock_h * 60 + S.clock_m) * 60 + S.clock_s);
+    }
+    return h;
 }
 
 // ── Per-mode: SETTINGS — current setting name + value card ──
 void drawSettingsLayout() {
     markScreenDirty();
+    layoutInputs(0);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
+        const LayoutState& S = layout_state;
         display->fillScreen(GxEPD_WHITE);
 
         // Header row with settings gear icon
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
-        drawModeIcon("SETTINGS");
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
+        drawModeIcon("SETTINGS", S.in_settings);
 
         int name_x = 24;
         display->setFont(&FreeMonoBold9pt7b);
@@ -847,68 +1050,65 @@ void drawSettingsLayout() {
         const char* setting_name = nullptr;
         char setting_value[64] = "";
 
-        switch (setting_idx) {
+        switch (S.setting_idx) {
             case SPREADING_FACTOR:
                 setting_name = "Spreading Factor";
-                snprintf(setting_value, sizeof(setting_value), "SF: %d", deviceSettings.spreading_factor);
+                snprintf(setting_value, sizeof(setting_value), "SF: %d", S.settings.spreading_factor);
                 break;
             case CHANNEL:
                 setting_name = "Channel";
-                snprintf(setting_value, sizeof(setting_value), "%c", channels[deviceSettings.channel_idx]);
+                snprintf(setting_value, sizeof(setting_value), "%c", S.chan);
                 break;
             case BITRATE:
                 setting_name = "Bitrate";
-                snprintf(setting_value, sizeof(setting_value), "%d bps", getBitrateFromIndex(deviceSettings.bitrate_idx));
+                snprintf(setting_value, sizeof(setting_value), "%d bps", S.bitrate_bps);
                 break;
             case BACKLIGHT:
                 setting_name = "Backlight";
-                strncpy(setting_value, deviceSettings.backlight ? "On" : "Off", sizeof(setting_value));
+                strncpy(setting_value, S.settings.backlight ? "On" : "Off", sizeof(setting_value));
                 break;
             case VOLUME:
                 setting_name = "Volume";
-                snprintf(setting_value, sizeof(setting_value), "%d", deviceSettings.volume_level);
+                snprintf(setting_value, sizeof(setting_value), "%d", S.settings.volume_level);
                 break;
             case HOURS: {
-                RTC_Date dt = rtc.getDateTime();
                 setting_name = "Hour";
                 char time_buf[9];
-                snprintf(time_buf, sizeof(time_buf), "%02d:%02d:%02d", dt.hour, dt.minute, dt.second);
+                snprintf(time_buf, sizeof(time_buf), "%02d:%02d:%02d", S.clock_h, S.clock_m, S.clock_s);
                 strncpy(setting_value, time_buf, sizeof(setting_value));
                 break;
             }
             case MINUTES: {
-                RTC_Date dt = rtc.getDateTime();
                 setting_name = "Minute";
                 char time_buf[9];
-                snprintf(time_buf, sizeof(time_buf), "%02d:%02d:%02d", dt.hour, dt.minute, dt.second);
+                snprintf(time_buf, sizeof(time_buf), "%02d:%02d:%02d", S.clock_h, S.clock_m, S.clock_s);
                 strncpy(setting_value, time_buf, sizeof(setting_value));
                 break;
             }
             case SECONDS: {
-                RTC_Date dt = rtc.getDateTime();
                 setting_name = "Second";
                 char time_buf[9];
-                snprintf(time_buf, sizeof(time_buf), "%02d:%02d:%02d", dt.hour, dt.minute, dt.second);
+                snprintf(time_buf, sizeof(time_buf), "%02d:%02d:%02d", S.clock_h, S.clock_m, S.clock_s);
                 strncpy(setting_value, time_buf, sizeof(setting_value));
                 break;
             }
             case BANDWIDTH: {
-                float bw_khz = deviceSettings.bandwidth_idx / 1000.0;
+                float bw_khz = S.settings.bandwidth_idx / 1000.0;
                 setting_name = "Bandwidth";
                 snprintf(setting_value, sizeof(setting_value), "%.2f kHz", bw_khz);
                 break;
             }
             case CODING_RATE:
                 setting_name = "Coding Rate";
-                snprintf(setting_value, sizeof(setting_value), "1/%d", deviceSettings.coding_rate_idx);
+                snprintf(setting_value, sizeof(setting_value), "1/%d", S.settings.coding_rate_idx);
                 break;
             case FREQUENCY_HOPPING:
                 setting_name = "Freq Hopping";
-                strncpy(setting_value, deviceSettings.frequency_hopping_enabled ? "Enabled" : "Disabled", sizeof(setting_value));
+                strncpy(setting_value, S.settings.frequency_hopping_enabled ? "Enabled" : "Disabled", sizeof(setting_value));
                 break;
             case PANEL_REFRESH:
                 setting_name = "Panel Refresh";
-                strncpy(setting_value, panel_refresh_enabled ? "Cycling..." : "Tap to start", sizeof(setting_value));
+                strncpy(setting_value, S.panel_refresh ? "Cycling..." : "Tap to start", sizeof(setting_value));
                 break;
         }  // end of setting name/value selection
 
@@ -940,19 +1140,29 @@ void drawSettingsLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("SETTINGS"), settingsBodyHash());
+}
+
+static uint32_t wpBodyHash() {
+    uint32_t h = hashFixed(LW_HASH_SEED, layout_state.wp_lat, 1e6);
+    h = hashFixed(h, layout_state.wp_lon, 1e6);
+    h = hashInt(h, layout_state.wp_broadcasting);
+    h = hashInt(h, layout_state.wp_bcast_remaining_s);
+    h = hashStr(h, layout_state.wp_label);
+    return hashFixed(h, layout_state.wp_alt, 10);
 }
 
 // ── Per-mode: WP — Lat/Lon + broadcast ──
 void drawWpLayout() {
     markScreenDirty();
+    layoutInputs(0);
     bool full = pendingFullRefresh();
 
     auto drawContent = []() {
         display->fillScreen(GxEPD_WHITE);
 
         char chan_sf[20];
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", layout_state.chan, layout_state.settings.spreading_factor);
         drawHeaderRow("WP", chan_sf);
 
         display->fillRect(12, 32, disp_width - 24, 80, GxEPD_WHITE);
@@ -960,10 +1170,16 @@ void drawWpLayout() {
         int row = 36;
         char buf[60];
 
-        snprintf(buf, sizeof(buf), "Lat: %.6f", layout_state.wp_lat);
-        display->setCursor(16, row + 10);
         display->setFont(&FreeMonoBold9pt7b);
         display->setTextColor(GxEPD_BLACK);
+        if (layout_state.wp_label[0]) {
+            display->setCursor(16, row + 10);
+            display->print(layout_state.wp_label);
+            row += 20;
+        }
+
+        snprintf(buf, sizeof(buf), "Lat: %.6f", layout_state.wp_lat);
+        display->setCursor(16, row + 10);
         display->print(buf);
 
         row += 20;
@@ -985,5 +1201,150 @@ void drawWpLayout() {
         drawBottomStatusbar();
     };
 
-    renderPageLoop(drawContent, full);
+    renderPageLoop(drawContent, full, headerHash("WP"), wpBodyHash());
+}
+
+// ── LAYOUTBENCH — every layout rendered off-screen from a fixed LayoutState fixture ──
+// The panel is held and the layouts run in fixture mode for the duration, so nothing reaches the
+// panel and nothing live leaks into the frame. Per layout: full render, unchanged re-render
+// (retained-widget skip), an update after one fixture tick with the pixels of the widgets it
+// redrew, and an FNV-1a signature of the whole frame after the full render. The host build renders
+// the same fixture (tests/host/layout_test.cpp), so the signatures must match
+// tests/host/golden/layouts.txt on any device.
+
+static const char* const s_bench_rows[] = {
+    "Alice: on my way", "Bob: copy", "Carol: at the hut", "Dave: 10 min", "Eve: ok",
+};
+
+void layoutBenchFixture(uint8_t tick) {
+    LayoutState& s = layout_state;
+    s.mode = "TXT";                 // drawTxtSingleLayout() only renders in TXT mode
+    s.chan = 'C';
+    s.bitrate_bps = 1300;
+    memset(&s.settings, 0, sizeof(s.settings));
+    s.settings.spreading_factor = 9;
+    s.settings.volume_level = 6;
+    s.settings.backlight = true;
+    s.settings.bandwidth_idx = BW_125_KHZ;
+    s.settings.coding_rate_idx = CR_5;
+    s.settings.frequency_hopping_enabled = true;
+    s.in_settings = false;
+    s.setting_idx = BANDWIDTH;
+    s.panel_refresh = false;
+    s.freq_mhz = 869.525f;
+    s.clock_h = 14;
+    s.clock_m = 7 + tick;
+    s.clock_s = 30;
+    s.gps_sats = 9;
+    s.batt_pct = 72;
+
+    s.beacon_best_dist = 850 + tick * 25;
+    strncpy(s.beacon_best_name, "PA3XYZ-portable", sizeof(s.beacon_best_name));
+    s.peer_count = 3;
+    static const LayoutState::Peer peers[] = {
+        { "PA3XYZ-portable", 850, 81 }, { "ON4ABC", 2400, 0 }, { "DL1QRS", 0, 55 },
+    };
+    memset(s.peers, 0, sizeof(s.peers));
+    memcpy(s.peers, peers, sizeof(peers));
+    s.peers[0].dist_m = s.beacon_best_dist;
+
+    s.range_sender = true;
+    s.gps_fix = true;
+    s.gps_hdop = 0.9f;
+    s.gps_lat = 52.370216;
+    s.gps_lon = 4.895168;
+    s.range_stable_m = 1250 + tick * 10;
+    s.range_max_m = 1830;
+    s.range_loss = 2;
+    s.range_ok = 17 + tick;
+
+    s.ptt_tx_active = tick & 1;
+    s.ptt_rx_active = false;
+    s.radio_snr = 7.25f;
+    s.radio_rssi = -92.5f;
+
+    s.txt_unread = 5;
+    s.txt_page = 0;
+    s.peer_alive = tick == 0;
+    s.inbox_count = 5;
+    s.inbox_rev = 11 + tick;
+    s.txt_preview = s_bench_rows[4];
+    memset(s.inbox_rows, 0, sizeof(s.inbox_rows));
+    memcpy(s.inbox_rows, s_bench_rows, sizeof(s_bench_rows));
+
+    s.pong_state = 1 + tick;
+    s.pong_rtt_ms = 320 + tick;
+    s.scan_progress_pct = 40 + tick * 10;
+    snprintf(s.scan_current_freq, sizeof(s.scan_current_freq), "%.3f", 869.525 + tick * 0.025);
+    s.scan_channel_count = 3;
+    for (uint8_t i = 0; i < s.scan_channel_count; i++) {
+        s.scan_channels[i] = { 869.4f + i * 0.1f, 90 - i * 15, -80.0f - i * 6 };
+    }
+    snprintf(s.raw_hex_line1, sizeof(s.raw_hex_line1), "48656C6C6F%02X", tick);
+    snprintf(s.raw_ascii_line, sizeof(s.raw_ascii_line), "Hello%u", tick);
+    s.tst_sent = 42 + tick;
+    s.tst_rcvd = 40 + tick;
+    s.tst_last_rssi = -88.0f;
+    s.tst_last_snr = 9.5f;
+    s.tst_last_time_on_air = 144;
+    s.wp_lat = 52.370216;
+    s.wp_lon = 4.895168;
+    s.wp_alt = 12.5f;
+    strncpy(s.wp_label, "Dam", sizeof(s.wp_label));
+    s.wp_broadcasting = true;
+    s.wp_bcast_remaining_s = 30 - tick;
+}
+
+uint32_t layoutFrameSig() {
+    return hashBytes(LW_HASH_SEED, dispMirrorFrame(), DISP_MIRROR_W / 8 * DISP_MIRROR_H);
+}
+
+int layoutBenchmark(char* out, size_t out_len) {
+    static const struct { const char* name; void (*fn)(); } layouts[] = {
+        { "DEFAULT", drawDefaultLayout },   { "BEACON", drawBeaconLayout }, { "RANGE", drawRangeLayout },
+        { "PTT", drawPttLayout },           { "TXT", drawTxtSingleLayout }, { "INBOX", drawTxtInboxLayout },
+        { "TST", drawTstLayout },           { "PONG", drawPongLayout },     { "SCAN", drawScanLayout },
+        { "RAW", drawRawLayout },           { "WP", drawWpLayout },         { "SETTINGS", drawSettingsLayout },
+    };
+    LayoutState saved = layout_state;
+    dispFrameHold(true);
+    layoutUseFixture(true);
+
+    int n = snprintf(out, out_len, "OK{LAYOUTBENCH:");
+    for (size_t i = 0; i < sizeof(layouts) / sizeof(layouts[0]); i++) {
+        layoutBenchFixture(0);
+        layoutInvalidate();
+        uint32_t t0 = micros();
+        layouts[i].fn();
+        uint32_t full_us = micros() - t0;
+        uint32_t sig = layoutFrameSig();
+
+        t0 = micros();
+        layouts[i].fn();
+        uint32_t skip_us = micros() - t0;
+
+        layoutBenchFixture(1);
+        t0 = micros();
+        layouts[i].fn();
+        uint32_t upd_us = micros() - t0;
+        uint32_t upd_px = 0;
+        for (uint8_t w = 0; w < LW_COUNT; w++) {
+            if (s_lw[w].dirty) upd_px += (uint32_t)s_lw[w].w * s_lw[w].h;
+        }
+
+        if (n > 0 && (size_t)n < out_len) {
+            n += snprintf(out + n, out_len - n, "%s%s=%lu/%lu/%lu/%lu/%08lX", i ? ";" : "", layouts[i].name,
+                          (unsigned long)full_us, (unsigned long)skip_us, (unsigned long)upd_us,
+                          (unsigned long)upd_px, (unsigned long)sig);
+        }
+    }
+    if (n > 0 && (size_t)n < out_len) n += snprintf(out + n, out_len - n, "}");
+
+    // Back to the live screen: the pending frame is re-rendered and diffed against the panel
+    layoutUseFixture(false);
+    layout_state = saved;
+    layoutInvalidate();
+    dispFrameHold(false);
+    layout_state._dirty = true;
+    return n;
 }
@@ -29,6 +29,10 @@ void drawWpLayout();
 void drawSettingsLayout();
 
 // ── Layout state (current mode's data) ──
+#define LAYOUT_PEER_ROWS    8       // BEACON roster rows: (disp_height - 104) / 12
+#define LAYOUT_INBOX_ROWS   9       // TXT inbox rows: (disp_height - 104) / 10
+#define LAYOUT_INBOX_PAGE   16      // Messages per inbox page (scroll step)
+
 struct LayoutState {
     const char* mode;
     int beacon_peer_name;     // index into display buffer for beacon peer name
@@ -67,13 +71,71 @@ struct LayoutState {
     char wp_label[25];
     bool wp_broadcasting;
     uint32_t wp_bcast_remaining_s;
-    
+
+    // ── Live inputs ──
+    // layoutCaptureLive() (layout_input.cpp) copies these from the firmware at the start of every
+    // layout call. The layouts read nothing else, so a fixture only has to fill them in.
+    char chan;                      // channels[deviceSettings.channel_idx]
+    int bitrate_bps;                // getBitrateFromIndex(deviceSettings.bitrate_idx)
+    DeviceSettings settings;
+    bool in_settings;
+    uint8_t setting_idx;
+    bool panel_refresh;
+    float freq_mhz;                 // currentFrequency
+    uint8_t clock_h, clock_m, clock_s;
+    int gps_sats;
+    uint8_t batt_pct;
+
+    // BEACON — closest peer, roster nearest first
+    double beacon_best_dist;        // < 0 = no peer position
+    char beacon_best_name[24];
+    uint8_t peer_count;             // rosterCount(); peers[] holds the first LAYOUT_PEER_ROWS
+    struct Peer {
+        char name[20];
+        float dist_m;               // 0 = unknown
+        uint8_t batt;
+    };
+    Peer peers[LAYOUT_PEER_ROWS];
+
+    // RANGE
+    bool gps_fix;
+    float gps_hdop;
+    double gps_lat, gps_lon;
+    double range_stable_m, range_max_m;
+    int range_loss, range_ok;
+
+    // PTT
+    float radio_snr, radio_rssi;
+
+    // TXT — strings are owned by whoever filled them in (the capture keeps its own row cache)
+    uint16_t txt_unread;            // txtInboxMsgCount
+    uint16_t txt_page;              // txtInboxScrollPage
+    bool peer_alive;
+    uint16_t inbox_count;
+    uint32_t inbox_rev;
+    const char* txt_preview;        // Newest message
+    const char* inbox_rows[LAYOUT_INBOX_ROWS];     // Rows of txt_page shown, from the top
+
     // ── Dirty flag for lazy display updates (from disp_timer) ──
     bool _dirty;  // true = screen needs redraw via flushDisplayIfNeeded()
 };
 extern LayoutState layout_state;
 void initLayoutState();
 
+// Which live inputs a layout needs — header, status bar and settings are always captured
+#define LI_BEACON   (1 << 0)
+#define LI_RANGE    (1 << 1)
+#define LI_RADIO    (1 << 2)
+#define LI_TXT      (1 << 3)
+#define LI_INBOX    (1 << 4)
+#define LI_TST      (1 << 5)
+#define LI_SCAN     (1 << 6)
+void layoutCaptureLive(uint16_t parts);
+
+// Fixture mode: the layouts stop capturing and render whatever layout_state holds
+// (LAYOUTBENCH, host tests)
+void layoutUseFixture(bool on);
+
 // ── PTT state helpers (called from modules that know TX/RX state) — also triggers screen sync ──
 extern void markScreenDirty();
 
@@ -90,6 +152,16 @@ inline void setPttRxActive(bool active) {
     markScreenDirty();
 }
 
+// ── Retained widgets — call after drawing into the frame outside the layouts (legacy updDisp path) ──
+void layoutInvalidate();
+
+// ── On-device layout benchmark (BLE LAYOUTBENCH) — renders off-screen, panel untouched ──
+// "OK{LAYOUTBENCH:NAME=full_us/skip_us/upd_us/upd_px/sig;...}" — sig is the whole frame rendered
+// from layoutBenchFixture(0); tests/host/golden/layouts.txt holds the expected values
+int layoutBenchmark(char* out, size_t out_len);
+void layoutBenchFixture(uint8_t tick);
+uint32_t layoutFrameSig();
+
 // ── Default layout (header + statusbar) for modes that haven't implemented a custom layout yet ──
 void drawDefaultLayout();
 
@@ -0,0 +1,260 @@
+// epoch_clock.cpp — Anchor + rate trim, PPS pairing, civil conversion, PCF8563 checkpoints
+
+#include "epoch_clock.h"
+#include "settings.h"
+
+static struct {
+    uint32_t    epoch;      // Whole second ...
+    uint32_t    ms;         // ... that began at this millis()
+    int32_t     ppm;        // Tick rate error, + = the tick runs fast
+    ClockSource src;
+} s_clk = { CLOCK_EPOCH_2000, 0, 0, CLOCK_SRC_NONE };
+
+// Last two PPS edges and their number, written by the ISR
+static volatile uint32_t s_pps_ms = 0;
+static volatile uint32_t s_pps_prev_ms = 0;
+static volatile uint32_t s_pps_count = 0;
+
+// Last PPS anchor for the rate estimate
+static uint32_t s_rate_epoch = 0;
+static uint32_t s_rate_ms = 0;
+
+static bool     s_rtc_present = false;
+static uint32_t s_rtc_write_at = 0;     // 0 = no write pending
+static uint32_t s_rtc_checked_ms = 0;
+
+// Stats
+static uint32_t s_steps = 0;
+static int32_t  s_offset_ms = 0;        // Clock minus GPS at the last PPS pairing
+static uint32_t s_rtc_reads = 0;
+static uint32_t s_rtc_writes = 0;
+
+static void ppsIsr() {
+    s_pps_prev_ms = s_pps_ms;
+    s_pps_ms = millis();
+    s_pps_count++;
+}
+
+// Days since 1970-01-01 — H. Hinnant's days_from_civil
+static int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+    y -= m <= 2;
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yoe = (uint32_t)(y - era * 400);
+    uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+uint32_t clockFromCivil(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
+    return (uint32_t)daysFromCivil(year, month, day) * 86400UL + hour * 3600UL + minute * 60UL + second;
+}
+
+RTC_Date clockToCivil(uint32_t epoch) {
+    uint32_t z = epoch / 86400UL + 719468;
+    uint32_t sod = epoch % 86400UL;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    uint32_t d = doy - (153 * mp + 2) / 5 + 1;
+    uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+    uint32_t y = yoe + era * 400 + (m <= 2);
+    return RTC_Date(y, m, d, sod / 3600, (sod / 60) % 60, sod % 60);
+}
+
+// Trimmed milliseconds since the anchor
+static uint32_t elapsedMs(uint32_t now) {
+    uint32_t e = now - s_clk.ms;
+    return e - (uint32_t)((int64_t)e * s_clk.ppm / 1000000);
+}
+
+uint32_t clockNow(uint16_t* ms) {
+    uint32_t e = elapsedMs(millis());
+    if (ms) *ms = e % 1000;
+    return s_clk.epoch + e / 1000;
+}
+
+bool clockValid() {
+    return s_clk.src != CLOCK_SRC_NONE;
+}
+
+ClockSource clockSource() {
+    return s_clk.src;
+}
+
+RTC_Date clockDateTime() {
+    return clockToCivil(clockEpoch());
+}
+
+static void anchor(uint32_t epoch, uint32_t at_ms, ClockSource src) {
+    s_clk.epoch = epoch;
+    s_clk.ms = at_ms;
+    s_clk.src = src;
+}
+
+// PCF8563 follows a better source shortly after it took over
+static void scheduleRtcWrite() {
+    if (!s_rtc_present || s_clk.src <= CLOCK_SRC_RTC || s_rtc_write_at != 0) return;
+    s_rtc_write_at = millis() + CLOCK_RTC_SETTLE_MS;
+    if (s_rtc_write_at == 0) s_rtc_write_at = 1;
+}
+
+void clockInit(bool rtc_present) {
+    s_rtc_present = rtc_present;
+    s_rtc_checked_ms = millis();
+    if (!rtc_present) return;
+    RTC_Date d = rtc.getDateTime();
+    s_rtc_reads++;
+    if (d.year < 2000 || d.month < 1 || d.month > 12 || d.day < 1 || d.day > 31) return;
+    anchor(clockFromCivil(d.year, d.month, d.day, d.hour, d.minute, d.second), millis(), CLOCK_SRC_RTC);
+}
+
+void clockAttachPps(uint8_t pin) {
+    attachInterrupt(digitalPinToInterrupt(pin), ppsIsr, RISING);
+}
+
+uint32_t clockPpsEdge(uint32_t now) {
+    noInterrupts();
+    uint32_t ms = s_pps_ms;
+    uint32_t count = s_pps_count;
+    interrupts();
+    return count != 0 && now - ms < CLOCK_PPS_WINDOW_MS ? count : 0;
+}
+
+void clockGpsTime(uint32_t epoch, uint32_t pps_edge) {
+    uint32_t now = millis();
+    noInterrupts();
+    uint32_t last = s_pps_ms;
+    uint32_t prev = s_pps_prev_ms;
+    uint32_t count = s_pps_count;
+    interrupts();
+
+    // The edge is found by its number: when the loop was held up between the sentence and this
+    // call, the next second's edge has already come and is the latest one
+    bool paired = pps_edge != 0 && (pps_edge == count || pps_edge + 1 == count);
+    uint32_t pps = pps_edge == count ? last : prev;
+    if (!paired) {
+        // No edge to pair with — the sentence arrives some 100-500 ms into its second, so only
+        // correct whole seconds and keep a PPS anchor if there is one
+        if (clockEpoch() == epoch) return;
+        // While the edges keep coming they run the clock; an unpaired sentence is a late one, or
+        // one the UART ring overflowed into
+        if (s_clk.src == CLOCK_SRC_PPS && now - last < CLOCK_PPS_LOST_MS) return;
+        anchor(epoch, now, CLOCK_SRC_GPS);
+        s_steps++;
+        scheduleRtcWrite();
+        return;
+    }
+
+    if (s_clk.src == CLOCK_SRC_PPS && s_clk.ms == pps && s_clk.epoch == epoch) return;  // RMC + GGA, same second
+
+    // How far off the running clock was at the edge
+    if (s_clk.src >= CLOCK_SRC_GPS) {
+        int64_t ours = (int64_t)s_clk.epoch * 1000 + (int32_t)elapsedMs(pps);
+        s_offset_ms = (int32_t)(ours - (int64_t)epoch * 1000);
+    }
+
+    // Tick rate against the GPS second over a long enough span
+    // (compares PPS timestamps with GPS seconds only, so steps and slews in between do not matter)
+    if (s_rate_epoch != 0 && epoch > s_rate_epoch && epoch - s_rate_epoch < CLOCK_FOLD_MS / 1000) {
+        uint32_t span_s = epoch - s_rate_epoch;
+        if (span_s >= CLOCK_RATE_SPAN_S) {
+            int32_t err_ms = (int32_t)(pps - s_rate_ms - span_s * 1000);
+            int32_t ppm = (int32_t)((int64_t)err_ms * 1000 / span_s);
+            if (ppm > -CLOCK_RATE_MAX_PPM && ppm < CLOCK_RATE_MAX_PPM) {
+                s_clk.ppm = s_clk.ppm ? (s_clk.ppm * 3 + ppm) / 4 : ppm;
+            }
+            s_rate_epoch = epoch;
+            s_rate_ms = pps;
+        }
+    } else {
+        s_rate_epoch = epoch;
+        s_rate_ms = pps;
+    }
+
+    bool stepped = s_clk.src < CLOCK_SRC_GPS || s_offset_ms <= -1000 || s_offset_ms >= 1000;
+    anchor(epoch, pps, CLOCK_SRC_PPS);
+    if (stepped) {
+        s_steps++;
+        scheduleRtcWrite();
+    }
+}
+
+void clockStep(uint32_t epoch, ClockSource src) {
+    anchor(epoch, millis(), src);
+    s_steps++;
+    scheduleRtcWrite();
+}
+
+void clockSlew(int32_t seconds) {
+    if (seconds == 0) return;
+    s_clk.epoch += seconds;
+    scheduleRtcWrite();
+}
+
+void clockTick(uint32_t now) {
+    // Keep millis() - anchor small so the ppm product cannot overflow
+    if (now - s_clk.ms >= CLOCK_FOLD_MS) {
+        uint32_t e = elapsedMs(now);
+        s_clk.epoch += e / 1000;
+        s_clk.ms = now - e % 1000;
+    }
+
+    if (!s_rtc_present) return;
+    if (s_rtc_write_at != 0 && (int32_t)(now - s_rtc_write_at) >= 0) {
+        // Right after a second boundary, so the chip starts its second close to ours
+        uint16_t ms;
+        uint32_t t = clockNow(&ms);
+        if (ms > 100) return;
+        RTC_Date d = clockToCivil(t);
+        rtc.setDateTime(d.year, d.month, d.day, d.hour, d.minute, d.second);
+        s_rtc_writes++;
+        s_rtc_write_at = 0;
+        s_rtc_checked_ms = now;
+    } else if (now - s_rtc_checked_ms >= CLOCK_RTC_CHECKPOINT_MS) {
+        s_rtc_checked_ms = now;
+        if (s_clk.src > CLOCK_SRC_RTC) {
+            scheduleRtcWrite();
+        } else {
+            // The chip's crystal is still the best reference we have
+            RTC_Date d = rtc.getDateTime();
+            s_rtc_reads++;
+            if (d.year >= 2000) anchor(clockFromCivil(d.year, d.month, d.day, d.hour, d.minute, d.second), now, CLOCK_SRC_RTC);
+        }
+    }
+}
+
+size_t clockFormatSD(char* out, size_t out_len) {
+    RTC_Date d = clockDateTime();
+    snprintf(out, out_len, "%04d%02d%02d%02d%02d%02d", d.year, d.month, d.day, d.hour, d.minute, d.second);
+    return CLOCK_SD_LEN;
+}
+
+bool clockParseSD(const char* s, size_t len, uint32_t* epoch) {
+    if (len < CLOCK_SD_LEN) return false;
+    uint16_t v[6];
+    static const uint8_t width[6] = { 4, 2, 2, 2, 2, 2 };
+    for (int f = 0; f < 6; f++) {
+        v[f] = 0;
+        for (int i = 0; i < width[f]; i++, s++) {
+            if (*s < '0' || *s > '9') return false;
+            v[f] = v[f] * 10 + (*s - '0');
+        }
+    }
+    if (v[0] < 2000 || v[1] < 1 || v[1] > 12 || v[2] < 1 || v[2] > 31 || v[3] > 23 || v[4] > 59 || v[5] > 59) {
+        return false;
+    }
+    *epoch = clockFromCivil(v[0], v[1], v[2], v[3], v[4], v[5]);
+    return true;
+}
+
+int clockFormatStats(char* out, size_t out_len) {
+    uint16_t ms;
+    uint32_t t = clockNow(&ms);
+    return snprintf(out, out_len,
+                    "OK{CLOCK:epoch=%lu,ms=%u,src=%u,ppm=%ld,pps=%lu,off_ms=%ld,steps=%lu,rtc_rd=%lu,rtc_wr=%lu}",
+                    (unsigned long)t, ms, (unsigned)s_clk.src, (long)s_clk.ppm, (unsigned long)s_pps_count,
+                    (long)s_offset_ms, (unsigned long)s_steps, (unsigned long)s_rtc_reads,
+                    (unsigned long)s_rtc_writes);
+}
@@ -0,0 +1,85 @@
+// epoch_clock.h — Software epoch clock on the RTC tick, disciplined by GPS PPS / PCF8563 checkpoints
+
+#ifndef EPOCH_CLOCK_H
+#define EPOCH_CLOCK_H
+
+#include <Arduino.h>
+#include <pcf8563.h>
+
+// Unix seconds and milliseconds, counted on millis() — on this core the FreeRTOS tick from RTC1 on
+// the 32.768 kHz LFCLK, so reading the time costs no I2C transaction. The clock is an anchor
+// (epoch second, millis() at its start) plus a rate trim in ppm:
+//
+//   boot        clockInit() reads the PCF8563 once
+//   GPS         loopGPS() hands over each NMEA date / time with the number of the PPS edge that
+//               was the latest when the sentence began (gnss.cpp asks clockPpsEdge() at its '$').
+//               That edge is the start of the second (ms-exact), even if the loop only gets to
+//               the sentence after the next edge; without PPS the clock is only stepped when the
+//               whole seconds disagree, and not at all while the PPS edges are running it.
+//   rate        PPS anchors at least CLOCK_RATE_SPAN_S apart give the tick error in ppm, which
+//               carries the clock through a GPS outage
+//   peers       clockStep() for the first ~SD heard, clockSlew() for the gradual convergence
+//   PCF8563     written CLOCK_RTC_SETTLE_MS after a step and every CLOCK_RTC_CHECKPOINT_MS while
+//               a better source runs the clock; re-read at the checkpoint while it is the source
+//
+// ~SD is "YYYYMMDDHHMMSS" in the frame header; clockFormatSD() / clockParseSD() convert it
+// without String.
+
+#define CLOCK_SD_LEN            14
+#define CLOCK_EPOCH_2000        946684800UL     // PCF8563 range starts here
+#define CLOCK_PPS_WINDOW_MS     900             // NMEA time pairs with a PPS edge this recent
+#define CLOCK_PPS_LOST_MS       3000            // Until no edge came for this long only paired NMEA time counts
+#define CLOCK_RATE_SPAN_S       600             // Shortest PPS span for a rate estimate (1.7 ppm/ms)
+#define CLOCK_RATE_MAX_PPM      500             // Beyond this the estimate is wrong, not the crystal
+#define CLOCK_RTC_CHECKPOINT_MS 3600000
+#define CLOCK_RTC_SETTLE_MS     10000           // A burst of peer nudges becomes one I2C write
+#define CLOCK_FOLD_MS           86400000UL      // Move the anchor up before millis() deltas grow large
+
+enum ClockSource : uint8_t {
+    CLOCK_SRC_NONE = 0,
+    CLOCK_SRC_RTC,          // PCF8563 at boot
+    CLOCK_SRC_MANUAL,       // Settings screen
+    CLOCK_SRC_PEER,         // ~SD of a received frame
+    CLOCK_SRC_GPS,          // NMEA, no PPS
+    CLOCK_SRC_PPS           // NMEA paired with a PPS edge
+};
+
+// setupSettings() — rtc_present: the PCF8563 answered on I2C
+void clockInit(bool rtc_present);
+// setupGPS() — rising edge = start of the GPS second
+void clockAttachPps(uint8_t pin);
+// gnss.cpp, as a sentence begins — number of the latest PPS edge if it came within
+// CLOCK_PPS_WINDOW_MS of now, else 0
+uint32_t clockPpsEdge(uint32_t now);
+// loopGPS() — date and time of a valid NMEA sentence; pps_edge from clockPpsEdge() (GnssFix::time_pps),
+// 0 = do not pair
+void clockGpsTime(uint32_t epoch, uint32_t pps_edge);
+void clockStep(uint32_t epoch, ClockSource src);
+void clockSlew(int32_t seconds);
+// Loop context — PCF8563 checkpoint, anchor fold
+void clockTick(uint32_t now);
+
+// Whole seconds; ms (optional) gets the fraction
+uint32_t clockNow(uint16_t* ms);
+inline uint32_t clockEpoch() {
+    return clockNow(nullptr);
+}
+inline uint32_t clockSecondOfDay() {
+    return clockEpoch() % 86400UL;
+}
+bool clockValid();
+ClockSource clockSource();
+// Drop-in for rtc.getDateTime()
+RTC_Date clockDateTime();
+
+uint32_t clockFromCivil(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second);
+RTC_Date clockToCivil(uint32_t epoch);
+// out_len > CLOCK_SD_LEN. Returns CLOCK_SD_LEN.
+size_t clockFormatSD(char* out, size_t out_len);
+// First CLOCK_SD_LEN characters of s; false when they are not a date
+bool clockParseSD(const char* s, size_t len, uint32_t* epoch);
+
+// "OK{CLOCK:epoch=..,ms=..,src=..,ppm=..,pps=..,off_ms=..,steps=..,rtc_rd=..,rtc_wr=..}"
+int clockFormatStats(char* out, size_t out_len);
+
+#endif
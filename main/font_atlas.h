@@ -0,0 +1,593 @@
+// font_atlas.h — GENERATED by build_scripts/gen_font_atlas.py, do not edit
+// Byte-aligned 1bpp glyph rows for font_blit.cpp (included there only)
+
+#ifndef FONT_ATLAS_H
+#define FONT_ATLAS_H
+
+#include "font_blit.h"
+
+static const uint8_t FreeMonoBold9pt7bAtlasBits[] = {
+    0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0x40, 0x40, 0x00, 0xE0, 0xE0, 0xEC, 0x44, 0x44, 0x44, 0x44,
+    0x36, 0x36, 0x36, 0x7F, 0x7F, 0x36, 0xFF, 0xFF, 0x3C, 0x3C, 0x3C, 0x00, 0x18, 0x7E, 0xFE, 0xC6,
+    0xC0, 0xF8, 0x7E, 0x06, 0x46, 0x46, 0x7C, 0x18, 0x18, 0x18, 0x60, 0x90, 0x90, 0x90, 0x66, 0x38,
+    0xDC, 0x22, 0x22, 0x26, 0x1C, 0x3C, 0x7E, 0x60, 0x60, 0x30, 0x7B, 0xDF, 0xCE, 0xFF, 0x7F, 0xC0,
+    0x40, 0x40, 0x40, 0x40, 0x30, 0x70, 0x60, 0x60, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x60, 0x60,
+    0x30, 0x10, 0xC0, 0xE0, 0x60, 0x60, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x60, 0x60, 0xC0, 0x80,
+    0x18, 0x18, 0xFF, 0xFF, 0x3C, 0x3C, 0x66, 0x18, 0x18, 0x18, 0xFF, 0xFF, 0x18, 0x18, 0x18, 0x18,
+    0x60, 0x40, 0xC0, 0x80, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xC0, 0xC0, 0x02, 0x06, 0x06, 0x0C, 0x0C,
+    0x18, 0x18, 0x18, 0x30, 0x30, 0x60, 0x60, 0xC0, 0xC0, 0x80, 0x38, 0x7C, 0xEE, 0xC6, 0xC6, 0xC6,
+    0xC6, 0xC6, 0xC6, 0xEE, 0x7C, 0x38, 0x38, 0x78, 0xD8, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+    0x7E, 0x3C, 0xFE, 0xC7, 0x03, 0x03, 0x06, 0x0C, 0x18, 0x70, 0xE3, 0xFF, 0xFF, 0x7C, 0xFE, 0x03,
+    0x03, 0x03, 0x1E, 0x1E, 0x07, 0x03, 0x03, 0xFE, 0x7C, 0x1C, 0x1C, 0x2C, 0x2C, 0x4C, 0xCC, 0xFE,
+    0xFE, 0x3E, 0x3E, 0x7E, 0x00, 0x7E, 0x00, 0x60, 0x00, 0x7E, 0x00, 0x7F, 0x00, 0x63, 0x80, 0x01,
+    0x80, 0x01, 0x80, 0xC3, 0x80, 0xFF, 0x00, 0x7E, 0x00, 0x0F, 0x3F, 0x30, 0x60, 0x60, 0xDC, 0xFE,
+    0xE3, 0xC3, 0x63, 0x7E, 0x3C, 0xFF, 0xFF, 0xC3, 0x03, 0x06, 0x06, 0x06, 0x0C, 0x0C, 0x0C, 0x18,
+    0x38, 0x7C, 0xC6, 0xC6, 0xC6, 0x7C, 0x7C, 0xC6, 0xC6, 0xC6, 0xFC, 0x38, 0x3C, 0x7E, 0xE6, 0xC3,
+    0xC3, 0xE7, 0x7F, 0x3B, 0x06, 0x0E, 0xFC, 0xF0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0,
+    0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x60, 0x40, 0xC0, 0x80, 0x80, 0x01, 0x80, 0x07, 0x00, 0x1C,
+    0x00, 0x70, 0x00, 0xF8, 0x00, 0x1C, 0x00, 0x07, 0x00, 0x01, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0x00,
+    0x00, 0x00, 0x00, 0xFF, 0x80, 0xFF, 0x80, 0xC0, 0x00, 0xF0, 0x00, 0x3C, 0x00, 0x0F, 0x00, 0x0F,
+    0x80, 0x3C, 0x00, 0xF0, 0x00, 0xC0, 0x00, 0x7C, 0xFE, 0xC7, 0x03, 0x0E, 0x1C, 0x00, 0x00, 0x00,
+    0x30, 0x30, 0x1E, 0x00, 0x3E, 0x00, 0x73, 0x00, 0xE3, 0x00, 0xC7, 0x00, 0xCF, 0x00, 0xDB, 0x00,
+    0xDB, 0x00, 0xDB, 0x00, 0xDF, 0x80, 0xCF, 0x80, 0xE0, 0x00, 0x63, 0x00, 0x7F, 0x00, 0x1E, 0x00,
+    0x3C, 0x00, 0x3E, 0x00, 0x0E, 0x00, 0x0B, 0x00, 0x1B, 0x00, 0x1B, 0x00, 0x3F, 0x80, 0x3F, 0x80,
+    0x71, 0xC0, 0xFB, 0xE0, 0xFB, 0xE0, 0xFF, 0x00, 0xFF, 0x80, 0x61, 0x80, 0x61, 0x80, 0x7F, 0x00,
+    0x7F, 0x80, 0x61, 0xC0, 0x60, 0xC0, 0x60, 0xC0, 0xFF, 0xC0, 0xFF, 0x00, 0x1F, 0x80, 0x7F, 0x80,
+    0x63, 0x80, 0xC1, 0x80, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x61, 0x80, 0x7F, 0x80,
+    0x1F, 0x00, 0xFE, 0x00, 0xFF, 0x80, 0x61, 0x80, 0x60, 0xC0, 0x60, 0xC0, 0x60, 0xC0, 0x60, 0xC0,
+    0x60, 0xC0, 0x61, 0x80, 0xFF, 0x80, 0xFE, 0x00, 0xFF, 0x80, 0xFF, 0x80, 0x61, 0x80, 0x6D, 0x80,
+    0x7C, 0x00, 0x7C, 0x00, 0x6C, 0x00, 0x61, 0x80, 0x61, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80,
+    0xFF, 0x80, 0x61, 0x80, 0x6D, 0x80, 0x7C, 0x00, 0x7C, 0x00, 0x6C, 0x00, 0x60, 0x00, 0x60, 0x00,
+    0xF8, 0x00, 0xF8, 0x00, 0x1F, 0x80, 0x7F, 0x80, 0x61, 0x80, 0xC1, 0x80, 0xC0, 0x00, 0xC0, 0x00,
+    0xC7, 0xC0, 0xC7, 0xC0, 0xE1, 0x80, 0x7F, 0x80, 0x3F, 0x00, 0xF7, 0x80, 0xF7, 0x80, 0x63, 0x00,
+    0x63, 0x00, 0x63, 0x00, 0x7F, 0x00, 0x7F, 0x00, 0x63, 0x00, 0x63, 0x00, 0xF7, 0x80, 0xF7, 0x80,
+    0xFC, 0xFC, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xFC, 0xFC, 0x1F, 0xC0, 0x1F, 0xC0, 0x03,
+    0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0xC3, 0x00, 0xC3, 0x00, 0xC7, 0x00, 0xFE, 0x00, 0x7C,
+    0x00, 0xF7, 0x80, 0xF7, 0x80, 0x66, 0x00, 0x6C, 0x00, 0x78, 0x00, 0x7C, 0x00, 0x6E, 0x00, 0x66,
+    0x00, 0x63, 0x00, 0xF3, 0xC0, 0xF3, 0xC0, 0xFC, 0x00, 0xFC, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0x31, 0x80, 0x31, 0x80, 0x31, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xE0, 0xE0, 0xF1,
+    0xE0, 0x71, 0xC0, 0x7B, 0xC0, 0x7B, 0xC0, 0x6B, 0xC0, 0x6E, 0xC0, 0x6E, 0xC0, 0x60, 0xC0, 0xF1,
+    0xE0, 0xF1, 0xE0, 0xE1, 0xE0, 0xF1, 0xE0, 0x78, 0xC0, 0x78, 0xC0, 0x6C, 0xC0, 0x6E, 0xC0, 0x66,
+    0xC0, 0x63, 0xC0, 0x63, 0xC0, 0xF1, 0xC0, 0xF0, 0xC0, 0x1F, 0x00, 0x3F, 0x80, 0x71, 0xC0, 0xE0,
+    0xE0, 0xC0, 0x60, 0xC0, 0x60, 0xC0, 0x60, 0xE0, 0xE0, 0x71, 0xC0, 0x3F, 0x80, 0x1F, 0x00, 0xFE,
+    0x00, 0xFF, 0x00, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x7F, 0x00, 0x7E, 0x00, 0x60, 0x00, 0x60,
+    0x00, 0xF8, 0x00, 0xF8, 0x00, 0x1F, 0x00, 0x3F, 0x80, 0x71, 0xC0, 0xE0, 0xE0, 0xC0, 0x60, 0xC0,
+    0x60, 0xC0, 0x60, 0xE0, 0xE0, 0x71, 0xC0, 0x3F, 0x80, 0x1F, 0x00, 0x18, 0x60, 0x3F, 0xE0, 0x3F,
+    0xC0, 0xFC, 0x00, 0xFE, 0x00, 0x63, 0x00, 0x63, 0x00, 0x67, 0x00, 0x7E, 0x00, 0x7C, 0x00, 0x66,
+    0x00, 0x63, 0x00, 0xFB, 0x80, 0xF9, 0x80, 0x3F, 0x80, 0x7F, 0x80, 0xC1, 0x80, 0xC0, 0x00, 0xF0,
+    0x00, 0x7F, 0x00, 0x0F, 0x80, 0xC1, 0x80, 0xC3, 0x80, 0xFF, 0x00, 0xFE, 0x00, 0xFF, 0x80, 0xFF,
+    0x80, 0xD9, 0x80, 0xD9, 0x80, 0xD9, 0x80, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x7E,
+    0x00, 0x7E, 0x00, 0xF1, 0xE0, 0xF1, 0xE0, 0x60, 0xC0, 0x60, 0xC0, 0x60, 0xC0, 0x60, 0xC0, 0x60,
+    0xC0, 0x60, 0xC0, 0x60, 0xC0, 0x3F, 0x80, 0x1F, 0x00, 0xFB, 0xE0, 0xFB, 0xE0, 0x70, 0xC0, 0x31,
+    0x80, 0x31, 0x80, 0x1B, 0x00, 0x1B, 0x00, 0x0A, 0x00, 0x0E, 0x00, 0x0E, 0x00, 0x04, 0x00, 0xFB,
+    0xC0, 0xFB, 0xC0, 0x60, 0xC0, 0x64, 0xC0, 0x6E, 0xC0, 0x6E, 0xC0, 0x7A, 0xC0, 0x7B, 0x80, 0x7B,
+    0x80, 0x3B, 0x80, 0x31, 0x80, 0xF3, 0xC0, 0xF3, 0xC0, 0x73, 0x80, 0x3F, 0x00, 0x1E, 0x00, 0x0C,
+    0x00, 0x1E, 0x00, 0x33, 0x00, 0x73, 0x80, 0xF3, 0xC0, 0xF3, 0xC0, 0xF3, 0xC0, 0xF3, 0xC0, 0x73,
+    0x80, 0x33, 0x00, 0x1E, 0x00, 0x1E, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x3F, 0x00, 0x3F,
+    0x00, 0xFE, 0xFE, 0xC6, 0xCC, 0x18, 0x18, 0x30, 0x63, 0xC3, 0xFF, 0xFF, 0xF0, 0xF0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF0, 0xF0, 0x00, 0x80, 0xC0, 0xC0, 0x60, 0x60,
+    0x30, 0x30, 0x18, 0x18, 0x0C, 0x0C, 0x06, 0x06, 0x02, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0, 0x10, 0x38, 0x78, 0x6C, 0xC6, 0x82, 0xFF, 0xE0, 0xFF,
+    0xE0, 0x80, 0x40, 0x20, 0x7E, 0x00, 0x7F, 0x00, 0x3F, 0x00, 0x7F, 0x00, 0xE3, 0x00, 0xC3, 0x00,
+    0xFF, 0x80, 0x7F, 0x80, 0xE0, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x6F, 0x00, 0x7F, 0x80, 0x71, 0xC0,
+    0x60, 0xC0, 0x60, 0xC0, 0x71, 0xC0, 0xFF, 0x80, 0xEF, 0x00, 0x3F, 0x80, 0x7F, 0x80, 0xE1, 0x80,
+    0xC1, 0x80, 0xC0, 0x00, 0xE0, 0x80, 0x7F, 0x80, 0x3F, 0x00, 0x03, 0x80, 0x03, 0x80, 0x01, 0x80,
+    0x3D, 0x80, 0x7F, 0x80, 0xE3, 0x80, 0xC1, 0x80, 0xC1, 0x80, 0xE3, 0x80, 0x7F, 0xC0, 0x3F, 0xC0,
+    0x3E, 0x00, 0x7F, 0x00, 0xC3, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xC0, 0x00, 0x7F, 0x80, 0x3F, 0x00,
+    0x1F, 0x3F, 0x30, 0x7E, 0x7E, 0x30, 0x30, 0x30, 0x30, 0xFE, 0xFE, 0x3F, 0x80, 0x7F, 0x80, 0xE7,
+    0x00, 0xC3, 0x00, 0xC3, 0x00, 0xE7, 0x00, 0x7F, 0x00, 0x3B, 0x00, 0x03, 0x00, 0x03, 0x00, 0x3F,
+    0x00, 0x3E, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x6E, 0x00, 0x7F, 0x00, 0x73, 0x00, 0x63,
+    0x00, 0x63, 0x00, 0x63, 0x00, 0xF7, 0x80, 0xF7, 0x80, 0x18, 0x18, 0x00, 0x78, 0x78, 0x18, 0x18,
+    0x18, 0x18, 0xFF, 0xFF, 0x18, 0x18, 0x00, 0xFC, 0xFC, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
+    0x0C, 0xFC, 0xF8, 0xE0, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x6F, 0x00, 0x6F, 0x00, 0x7C, 0x00, 0x78,
+    0x00, 0x7C, 0x00, 0x6E, 0x00, 0xE7, 0x80, 0xE7, 0x80, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0xFF, 0xFF, 0xFD, 0x80, 0xFF, 0xC0, 0x66, 0xC0, 0x66, 0xC0, 0x66, 0xC0, 0x66, 0xC0,
+    0xF7, 0xE0, 0xF7, 0xE0, 0xEE, 0x00, 0xFF, 0x00, 0x63, 0x00, 0x63, 0x00, 0x63, 0x00, 0x63, 0x00,
+    0xF7, 0x80, 0xF7, 0x80, 0x3E, 0x00, 0x7F, 0x00, 0xE3, 0x80, 0xC1, 0x80, 0xC1, 0x80, 0xE3, 0x80,
+    0x7F, 0x00, 0x3E, 0x00, 0xEF, 0x00, 0xFF, 0xC0, 0x70, 0xE0, 0x60, 0x60, 0x60, 0x60, 0x70, 0xE0,
+    0x7F, 0xC0, 0x6F, 0x00, 0x60, 0x00, 0x60, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x1E, 0xE0, 0x7F, 0xE0,
+    0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0xC0, 0x1E, 0xC0, 0x00, 0xC0, 0x00, 0xC0,
+    0x03, 0xE0, 0x03, 0xE0, 0x77, 0x80, 0x7F, 0x80, 0x3C, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0xFE, 0x00, 0xFE, 0x00, 0x3F, 0xFF, 0xC3, 0xFC, 0x3F, 0xC3, 0xFF, 0xFC, 0x60, 0x60, 0x60, 0xFE,
+    0xFE, 0x60, 0x60, 0x60, 0x61, 0x7F, 0x3E, 0xE7, 0x00, 0xE7, 0x00, 0x63, 0x00, 0x63, 0x00, 0x63,
+    0x00, 0x63, 0x00, 0x7F, 0x80, 0x3F, 0x80, 0xFB, 0xE0, 0xFB, 0xE0, 0x31, 0x80, 0x31, 0x80, 0x1B,
+    0x00, 0x1B, 0x00, 0x0E, 0x00, 0x0E, 0x00, 0xF1, 0xE0, 0xF1, 0xE0, 0x6E, 0xC0, 0x6E, 0xC0, 0x3F,
+    0x80, 0x3B, 0x80, 0x3B, 0x80, 0x31, 0x80, 0xF7, 0x80, 0xF7, 0x80, 0x36, 0x00, 0x1C, 0x00, 0x3C,
+    0x00, 0x77, 0x00, 0xF7, 0x80, 0xF7, 0x80, 0xF3, 0xC0, 0xF3, 0xC0, 0x61, 0x80, 0x33, 0x00, 0x33,
+    0x00, 0x1E, 0x00, 0x1E, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x18, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xFE,
+    0xFE, 0xCC, 0x18, 0x30, 0x62, 0xFE, 0xFE, 0x30, 0x70, 0x60, 0x60, 0x60, 0x60, 0xC0, 0xC0, 0x60,
+    0x60, 0x60, 0x60, 0x70, 0x30, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xE0, 0x60, 0x60, 0x60, 0x60, 0x30, 0x30, 0x60, 0x60, 0x60, 0x60, 0xE0,
+    0xC0, 0x70, 0x00, 0xF9, 0x80, 0xCF, 0x00, 0x06, 0x00,
+};
+
+static const FontAtlasGlyph FreeMonoBold9pt7bAtlasGlyphs[] = {
+    {     0,  0,  0, 0, 11,   0,   1 },  // 0x20
+    {     0,  3, 11, 1, 11,   4, -10 },  // 0x21
+    {    11,  7,  5, 1, 11,   2, -10 },  // 0x22
+    {    16,  8, 12, 1, 11,   1, -10 },  // 0x23
+    {    28,  7, 14, 1, 11,   2, -11 },  // 0x24
+    {    42,  7, 11, 1, 11,   2, -10 },  // 0x25
+    {    53,  8, 10, 1, 11,   1,  -9 },  // 0x26
+    {    63,  3,  5, 1, 11,   4, -10 },  // 0x27
+    {    68,  4, 14, 1, 11,   5, -10 },  // 0x28
+    {    82,  4, 14, 1, 11,   2, -10 },  // 0x29
+    {    96,  8,  7, 1, 11,   2, -10 },  // 0x2A
+    {   103,  8,  9, 1, 11,   2,  -8 },  // 0x2B
+    {   112,  3,  5, 1, 11,   3,  -1 },  // 0x2C
+    {   117,  9,  2, 2, 11,   1,  -5 },  // 0x2D
+    {   121,  2,  2, 1, 11,   4,  -1 },  // 0x2E
+    {   123,  7, 15, 1, 11,   2, -12 },  // 0x2F
+    {   138,  7, 12, 1, 11,   2, -11 },  // 0x30
+    {   150,  7, 11, 1, 11,   2, -10 },  // 0x31
+    {   161,  8, 12, 1, 11,   1, -11 },  // 0x32
+    {   173,  8, 12, 1, 11,   2, -11 },  // 0x33
+    {   185,  7, 10, 1, 11,   2,  -9 },  // 0x34
+    {   195,  9, 11, 2, 11,   1, -10 },  // 0x35
+    {   217,  8, 12, 1, 11,   2, -11 },  // 0x36
+    {   229,  8, 11, 1, 11,   1, -10 },  // 0x37
+    {   240,  7, 12, 1, 11,   2, -11 },  // 0x38
+    {   252,  8, 12, 1, 11,   2, -11 },  // 0x39
+    {   264,  2,  8, 1, 11,   4,  -7 },  // 0x3A
+    {   272,  3, 11, 1, 11,   3,  -7 },  // 0x3B
+    {   283,  9,  8, 2, 11,   1,  -8 },  // 0x3C
+    {   299,  9,  6, 2, 11,   1,  -7 },  // 0x3D
+    {   311,  9,  8, 2, 11,   1,  -8 },  // 0x3E
+    {   327,  8, 11, 1, 11,   2, -10 },  // 0x3F
+    {   338,  9, 15, 2, 11,   1, -11 },  // 0x40
+    {   368, 11, 11, 2, 11,   0, -10 },  // 0x41
+    {   390, 10, 11, 2, 11,   1, -10 },  // 0x42
+    {   412,  9, 11, 2, 11,   1, -10 },  // 0x43
+    {   434, 10, 11, 2, 11,   0, -10 },  // 0x44
+    {   456,  9, 11, 2, 11,   1, -10 },  // 0x45
+    {   478,  9, 11, 2, 11,   1, -10 },  // 0x46
+    {   500, 10, 11, 2, 11,   1, -10 },  // 0x47
+    {   522,  9, 11, 2, 11,   1, -10 },  // 0x48
+    {   544,  6, 11, 1, 11,   3, -10 },  // 0x49
+    {   555, 10, 11, 2, 11,   1, -10 },  // 0x4A
+    {   577, 10, 11, 2, 11,   1, -10 },  // 0x4B
+    {   599,  9, 11, 2, 11,   1, -10 },  // 0x4C
+    {   621, 11, 11, 2, 11,   0, -10 },  // 0x4D
+    {   643, 11, 11, 2, 11,   0, -10 },  // 0x4E
+    {   665, 11, 11, 2, 11,   0, -10 },  // 0x4F
+    {   687,  9, 11, 2, 11,   1, -10 },  // 0x50
+    {   709, 11, 14, 2, 11,   0, -10 },  // 0x51
+    {   737,  9, 11, 2, 11,   1, -10 },  // 0x52
+    {   759,  9, 11, 2, 11,   1, -10 },  // 0x53
+    {   781,  9, 11, 2, 11,   1, -10 },  // 0x54
+    {   803, 11, 11, 2, 11,   0, -10 },  // 0x55
+    {   825, 11, 11, 2, 11,   0, -10 },  // 0x56
+    {   847, 10, 11, 2, 11,   0, -10 },  // 0x57
+    {   869, 10, 11, 2, 11,   0, -10 },  // 0x58
+    {   891, 10, 11, 2, 11,   0, -10 },  // 0x59
+    {   913,  8, 11, 1, 11,   2, -10 },  // 0x5A
+    {   924,  4, 14, 1, 11,   5, -10 },  // 0x5B
+    {   938,  7, 15, 1, 11,   2, -12 },  // 0x5C
+    {   953,  4, 14, 1, 11,   2, -10 },  // 0x5D
+    {   967,  7,  6, 1, 11,   2, -11 },  // 0x5E
+    {   973, 11,  2, 2, 11,   0,   3 },  // 0x5F
+    {   977,  3,  3, 1, 11,   3, -11 },  // 0x60
+    {   980,  9,  8, 2, 11,   1,  -7 },  // 0x61
+    {   996, 10, 11, 2, 11,   0, -10 },  // 0x62
+    {  1018,  9,  8, 2, 11,   1,  -7 },  // 0x63
+    {  1034, 10, 11, 2, 11,   1, -10 },  // 0x64
+    {  1056,  9,  8, 2, 11,   1,  -7 },  // 0x65
+    {  1072,  8, 11, 1, 11,   2, -10 },  // 0x66
+    {  1083,  9, 12, 2, 11,   1,  -7 },  // 0x67
+    {  1107,  9, 11, 2, 11,   1, -10 },  // 0x68
+    {  1129,  8, 11, 1, 11,   2, -10 },  // 0x69
+    {  1140,  6, 15, 1, 11,   2, -10 },  // 0x6A
+    {  1155,  9, 11, 2, 11,   1, -10 },  // 0x6B
+    {  1177,  8, 11, 1, 11,   2, -10 },  // 0x6C
+    {  1188, 11,  8, 2, 11,   0,  -7 },  // 0x6D
+    {  1204,  9,  8, 2, 11,   1,  -7 },  // 0x6E
+    {  1220,  9,  8, 2, 11,   1,  -7 },  // 0x6F
+    {  1236, 11, 12, 2, 11,   0,  -7 },  // 0x70
+    {  1260, 11, 12, 2, 11,   0,  -7 },  // 0x71
+    {  1284,  9,  8, 2, 11,   1,  -7 },  // 0x72
+    {  1300,  8,  8, 1, 11,   2,  -7 },  // 0x73
+    {  1308,  8, 11, 1, 11,   1, -10 },  // 0x74
+    {  1319,  9,  8, 2, 11,   1,  -7 },  // 0x75
+    {  1335, 11,  8, 2, 11,   0,  -7 },  // 0x76
+    {  1351, 11,  8, 2, 11,   0,  -7 },  // 0x77
+    {  1367,  9,  8, 2, 11,   1,  -7 },  // 0x78
+    {  1383, 10, 12, 2, 11,   0,  -7 },  // 0x79
+    {  1407,  7,  8, 1, 11,   2,  -7 },  // 0x7A
+    {  1415,  4, 14, 1, 11,   3, -10 },  // 0x7B
+    {  1429,  2, 14, 1, 11,   5, -10 },  // 0x7C
+    {  1443,  4, 14, 1, 11,   4, -10 },  // 0x7D
+    {  1457,  9,  4, 2, 11,   1,  -6 },  // 0x7E
+};
+
+static const FontAtlas FreeMonoBold9pt7bAtlas = {
+    0x50DEA95Fu, FreeMonoBold9pt7bAtlasBits, FreeMonoBold9pt7bAtlasGlyphs, 0x20, 0x7E, 18
+};
+
+static const uint8_t FreeMonoBold12pt7bAtlasBits[] = {
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x60, 0x60, 0x60, 0x60, 0x00, 0x60, 0xF0, 0x60, 0xE7,
+    0xE7, 0x62, 0x42, 0x42, 0x42, 0x42, 0x11, 0x80, 0x39, 0x80, 0x31, 0x80, 0x31, 0x80, 0x33, 0x00,
+    0xFF, 0xE0, 0xFF, 0xE0, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0xFF, 0xC0, 0xFF, 0xC0,
+    0x33, 0x00, 0x33, 0x00, 0x73, 0x00, 0x63, 0x00, 0x22, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x3F, 0x80, 0x7F, 0x80, 0x71, 0x80, 0x60, 0x80, 0x60, 0x00, 0x78, 0x00, 0x3F, 0x80, 0x07, 0xC0,
+    0xC0, 0xC0, 0xE0, 0xC0, 0xE1, 0xC0, 0xFF, 0x80, 0xFF, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+    0x0C, 0x00, 0x38, 0x00, 0x7C, 0x00, 0xC4, 0x00, 0x84, 0x00, 0xC4, 0x00, 0x7C, 0x00, 0x39, 0xC0,
+    0x0F, 0x00, 0x7F, 0x00, 0xCF, 0x80, 0x08, 0xC0, 0x08, 0x40, 0x08, 0xC0, 0x0F, 0x80, 0x07, 0x00,
+    0x3E, 0x00, 0x7F, 0x00, 0x66, 0x00, 0x60, 0x00, 0x70, 0x00, 0x30, 0x00, 0x78, 0x00, 0xFB, 0x80,
+    0xDF, 0x80, 0xCF, 0x00, 0xC7, 0x00, 0xFF, 0x80, 0x7F, 0x80, 0xE0, 0xE0, 0x40, 0x40, 0x40, 0x40,
+    0x40, 0x38, 0x38, 0x70, 0x70, 0x60, 0xE0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x60, 0x60,
+    0x70, 0x30, 0x38, 0x10, 0xE0, 0xE0, 0x70, 0x70, 0x30, 0x38, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x30, 0x30, 0x70, 0x60, 0xE0, 0x40, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0xED, 0xC0, 0xFF,
+    0xC0, 0x7F, 0x80, 0x1E, 0x00, 0x3F, 0x00, 0x33, 0x00, 0x33, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x06, 0x00, 0xFF, 0xF0, 0xFF, 0xF0, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x06, 0x00, 0x38, 0x70, 0x70, 0x60, 0xE0, 0xC0, 0x80, 0xFF, 0xF0, 0xFF, 0xF0,
+    0xE0, 0xE0, 0xE0, 0x00, 0x40, 0x00, 0xC0, 0x01, 0xC0, 0x01, 0xC0, 0x03, 0x80, 0x03, 0x80, 0x03,
+    0x00, 0x07, 0x00, 0x06, 0x00, 0x0E, 0x00, 0x0C, 0x00, 0x1C, 0x00, 0x18, 0x00, 0x38, 0x00, 0x30,
+    0x00, 0x70, 0x00, 0x60, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0x40, 0x00, 0x1E, 0x00, 0x3F, 0x00, 0x61,
+    0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xE1, 0xC0, 0x61, 0x80, 0x3F, 0x00, 0x1E, 0x00, 0x1C, 0x00, 0x3C, 0x00, 0xFC, 0x00, 0xEC,
+    0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C,
+    0x00, 0x0C, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x1F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xE0, 0xC0, 0xC0,
+    0xC0, 0x01, 0xC0, 0x03, 0x80, 0x07, 0x80, 0x0F, 0x00, 0x1E, 0x00, 0x3C, 0x00, 0x78, 0xC0, 0xF0,
+    0xC0, 0xFF, 0xC0, 0xFF, 0xC0, 0x3F, 0x00, 0x7F, 0x80, 0x61, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x01,
+    0xC0, 0x0F, 0x80, 0x0F, 0x80, 0x01, 0xC0, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0xC0, 0xE0, 0xFF,
+    0xC0, 0x7F, 0x00, 0x07, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x1F, 0x00, 0x1B, 0x00, 0x3B, 0x00, 0x33,
+    0x00, 0x63, 0x00, 0xE3, 0x00, 0xFF, 0x80, 0xFF, 0x80, 0x03, 0x00, 0x1F, 0x80, 0x1F, 0x80, 0x7F,
+    0x80, 0x7F, 0x80, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7E, 0x00, 0x7F, 0x80, 0x61, 0x80, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0xC1, 0x80, 0xFF, 0x80, 0x7E, 0x00, 0x07, 0xC0, 0x1F,
+    0xC0, 0x3C, 0x00, 0x70, 0x00, 0x60, 0x00, 0xE0, 0x00, 0xEF, 0x00, 0xFF, 0x80, 0xF1, 0xC0, 0xE0,
+    0xC0, 0xE0, 0xC0, 0xE0, 0xC0, 0x71, 0xC0, 0x3F, 0x80, 0x1F, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0xC1,
+    0xC0, 0xC1, 0xC0, 0x01, 0x80, 0x01, 0x80, 0x03, 0x80, 0x03, 0x00, 0x03, 0x00, 0x07, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x0E, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x1E, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x61, 0x80, 0x7F, 0x80, 0x7F, 0x80, 0xE1, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00, 0x3E, 0x00, 0x7F, 0x00, 0xE3, 0x80, 0xC1, 0xC0, 0xC1,
+    0xC0, 0xC1, 0xC0, 0xE3, 0xC0, 0x7F, 0xC0, 0x3D, 0xC0, 0x01, 0xC0, 0x01, 0x80, 0x03, 0x80, 0x0F,
+    0x00, 0xFE, 0x00, 0xF8, 0x00, 0xE0, 0xE0, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xE0, 0xE0,
+    0x70, 0x70, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x60, 0x60, 0xC0, 0xC0, 0x80, 0x80, 0x00,
+    0x30, 0x00, 0xF0, 0x03, 0xE0, 0x0F, 0x80, 0x3E, 0x00, 0xF8, 0x00, 0x3E, 0x00, 0x0F, 0x80, 0x03,
+    0xE0, 0x00, 0xF0, 0x00, 0x20, 0xFF, 0xF0, 0xFF, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+    0xF0, 0xFF, 0xF0, 0x60, 0x00, 0xF8, 0x00, 0x3E, 0x00, 0x0F, 0x80, 0x03, 0xE0, 0x01, 0xF0, 0x07,
+    0xC0, 0x1F, 0x00, 0x7C, 0x00, 0xF0, 0x00, 0x40, 0x00, 0x7C, 0x00, 0xFF, 0x00, 0xC3, 0x80, 0xC1,
+    0x80, 0x01, 0x80, 0x03, 0x80, 0x0F, 0x00, 0x1E, 0x00, 0x18, 0x00, 0x10, 0x00, 0x00, 0x00, 0x38,
+    0x00, 0x38, 0x00, 0x38, 0x00, 0x1E, 0x00, 0x3F, 0x80, 0x71, 0xC0, 0x60, 0xC0, 0xC0, 0xC0, 0xC3,
+    0xC0, 0xCF, 0xC0, 0xDC, 0xC0, 0xD8, 0xC0, 0xD8, 0xC0, 0xDC, 0xC0, 0xCF, 0xE0, 0xC7, 0xE0, 0xC0,
+    0x00, 0xC0, 0x00, 0x60, 0x00, 0x71, 0xC0, 0x3F, 0xC0, 0x1F, 0x00, 0x3F, 0x80, 0x3F, 0xC0, 0x07,
+    0xC0, 0x0E, 0xC0, 0x0E, 0xE0, 0x0C, 0x60, 0x1C, 0x60, 0x1C, 0x70, 0x1F, 0xF0, 0x3F, 0xF8, 0x30,
+    0x18, 0x30, 0x18, 0xFC, 0x7E, 0xFC, 0x7E, 0xFF, 0xC0, 0xFF, 0xE0, 0x30, 0x70, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x70, 0x3F, 0xE0, 0x3F, 0xF0, 0x30, 0x38, 0x30, 0x18, 0x30, 0x18, 0x30, 0x38, 0xFF,
+    0xF0, 0xFF, 0xE0, 0x0F, 0xF0, 0x3F, 0xF0, 0x70, 0x70, 0x60, 0x30, 0xC0, 0x30, 0xC0, 0x00, 0xC0,
+    0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x60, 0x30, 0x70, 0x70, 0x3F, 0xF0, 0x0F, 0xC0, 0xFF,
+    0x00, 0xFF, 0xC0, 0x60, 0xE0, 0x60, 0x60, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60,
+    0x30, 0x60, 0x30, 0x60, 0x70, 0x60, 0xE0, 0xFF, 0xC0, 0xFF, 0x80, 0xFF, 0xF0, 0xFF, 0xF0, 0x30,
+    0x30, 0x30, 0x30, 0x31, 0xB0, 0x31, 0x80, 0x3F, 0x80, 0x3F, 0x80, 0x31, 0x80, 0x31, 0x98, 0x30,
+    0x18, 0x30, 0x18, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xF8, 0xFF, 0xF8, 0x30, 0x18, 0x30, 0x18, 0x31,
+    0x98, 0x31, 0x80, 0x3F, 0x80, 0x3F, 0x80, 0x31, 0x80, 0x31, 0x80, 0x30, 0x00, 0x30, 0x00, 0xFF,
+    0x00, 0xFF, 0x00, 0x0F, 0xF0, 0x3F, 0xF0, 0x70, 0x70, 0x60, 0x30, 0xC0, 0x30, 0xC0, 0x00, 0xC0,
+    0x00, 0xC3, 0xF8, 0xC3, 0xF8, 0xC0, 0x30, 0xE0, 0x30, 0x70, 0x70, 0x3F, 0xF0, 0x0F, 0xC0, 0x7C,
+    0xF8, 0x7C, 0xF8, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x3F, 0xF0, 0x3F, 0xF0, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xFC, 0xFC, 0xFC, 0xFC, 0xFF, 0xC0, 0xFF, 0xC0, 0x0C,
+    0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C,
+    0x00, 0x0C, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x0F, 0xF8, 0x0F, 0xF8, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1, 0x80, 0xFF,
+    0x80, 0x3E, 0x00, 0xFC, 0xF8, 0xFC, 0xF8, 0x30, 0xE0, 0x31, 0xC0, 0x33, 0x80, 0x3F, 0x00, 0x3F,
+    0x00, 0x3F, 0x80, 0x39, 0xC0, 0x30, 0xC0, 0x30, 0xE0, 0x30, 0x60, 0xFC, 0x7C, 0xFC, 0x3C, 0xFF,
+    0x00, 0xFF, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18,
+    0x30, 0x18, 0x30, 0x18, 0x30, 0x18, 0x30, 0xFF, 0xF0, 0xFF, 0xF0, 0xF0, 0x3C, 0xF0, 0x3C, 0x78,
+    0x78, 0x78, 0x78, 0x7C, 0xF8, 0x6C, 0xF8, 0x6F, 0xD8, 0x67, 0xD8, 0x67, 0x98, 0x63, 0x98, 0x63,
+    0x18, 0x60, 0x18, 0xFC, 0xFC, 0xFC, 0xFC, 0xF1, 0xF8, 0xF9, 0xF8, 0x3C, 0x30, 0x3C, 0x30, 0x3E,
+    0x30, 0x36, 0x30, 0x37, 0x30, 0x33, 0xB0, 0x31, 0xB0, 0x31, 0xF0, 0x30, 0xF0, 0x30, 0xF0, 0x7E,
+    0x70, 0x7E, 0x30, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0, 0x60, 0x60, 0xE0, 0x70, 0xC0, 0x30, 0xC0,
+    0x30, 0xC0, 0x30, 0xC0, 0x30, 0xE0, 0x70, 0x60, 0x60, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0xFF,
+    0x80, 0xFF, 0xE0, 0x30, 0x70, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x70, 0x3F, 0xE0, 0x3F,
+    0x80, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70,
+    0xE0, 0x60, 0x60, 0xE0, 0x70, 0xC0, 0x30, 0xC0, 0x30, 0xC0, 0x30, 0xC0, 0x30, 0xE0, 0x70, 0x60,
+    0x60, 0x70, 0xE0, 0x3F, 0xC0, 0x1F, 0x00, 0x18, 0x30, 0x3F, 0xF0, 0x3F, 0xE0, 0xFF, 0x80, 0xFF,
+    0xE0, 0x30, 0x70, 0x30, 0x30, 0x30, 0x30, 0x30, 0x70, 0x3F, 0xE0, 0x3F, 0xC0, 0x31, 0xE0, 0x30,
+    0xE0, 0x30, 0x70, 0x30, 0x30, 0xFE, 0x3C, 0xFE, 0x1C, 0x3F, 0xC0, 0x7F, 0xC0, 0xE1, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xE0, 0x00, 0x7E, 0x00, 0x1F, 0x80, 0x01, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xE1,
+    0xC0, 0xFF, 0x80, 0xFF, 0x00, 0xFF, 0xF0, 0xFF, 0xF0, 0xC6, 0x30, 0xC6, 0x30, 0xC6, 0x30, 0xC6,
+    0x30, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x3F, 0xC0, 0x3F,
+    0xC0, 0xFF, 0xF0, 0xFF, 0xF0, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x39, 0xC0, 0x1F, 0xC0, 0x0F, 0x00, 0xFC, 0x3F, 0xFC,
+    0x3F, 0x30, 0x0C, 0x38, 0x1C, 0x18, 0x18, 0x1C, 0x38, 0x1C, 0x38, 0x0E, 0x70, 0x0E, 0x70, 0x0F,
+    0x60, 0x07, 0xE0, 0x07, 0xE0, 0x03, 0xC0, 0x03, 0xC0, 0xFC, 0xFC, 0xFC, 0xFC, 0x60, 0x1C, 0x73,
+    0x18, 0x77, 0x98, 0x77, 0x98, 0x77, 0x98, 0x37, 0xF8, 0x3F, 0xF8, 0x3C, 0xF8, 0x3C, 0xF8, 0x3C,
+    0xF0, 0x38, 0x70, 0x38, 0x70, 0xF8, 0xF8, 0xF8, 0xF8, 0x38, 0x60, 0x3C, 0xE0, 0x1F, 0xC0, 0x0F,
+    0x80, 0x07, 0x00, 0x0F, 0x80, 0x0F, 0x80, 0x1D, 0xC0, 0x38, 0xE0, 0x78, 0x70, 0xFC, 0xFC, 0xFC,
+    0xFC, 0xF9, 0xF0, 0xF9, 0xF0, 0x30, 0xC0, 0x39, 0xC0, 0x19, 0x80, 0x1F, 0x80, 0x0F, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x3F, 0xC0, 0x3F, 0xC0, 0xFF, 0x80, 0xFF,
+    0x80, 0xC3, 0x80, 0xC3, 0x00, 0xC6, 0x00, 0xCE, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x38, 0xC0, 0x30,
+    0xC0, 0x60, 0xC0, 0xC0, 0xC0, 0xFF, 0xC0, 0xFF, 0xC0, 0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0x40, 0x00, 0xC0, 0x00,
+    0xE0, 0x00, 0x60, 0x00, 0x70, 0x00, 0x30, 0x00, 0x38, 0x00, 0x18, 0x00, 0x1C, 0x00, 0x0C, 0x00,
+    0x0E, 0x00, 0x06, 0x00, 0x07, 0x00, 0x03, 0x00, 0x03, 0x80, 0x03, 0x80, 0x01, 0xC0, 0x01, 0xC0,
+    0x00, 0xC0, 0x00, 0x40, 0xF8, 0xF8, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0xF8, 0xF8, 0x04, 0x00, 0x0C, 0x00, 0x1E, 0x00, 0x3F, 0x00, 0x7B,
+    0x80, 0x71, 0xC0, 0xE1, 0xC0, 0xC0, 0xC0, 0xFF, 0xFC, 0xFF, 0xFC, 0xC0, 0xE0, 0x70, 0x30, 0x3F,
+    0x00, 0x7F, 0x80, 0x00, 0xC0, 0x00, 0xC0, 0x1F, 0xC0, 0x7F, 0xC0, 0x60, 0xC0, 0xC0, 0xC0, 0xC1,
+    0xC0, 0xFF, 0xF0, 0x3F, 0xF0, 0xF0, 0x00, 0xF0, 0x00, 0x30, 0x00, 0x30, 0x00, 0x37, 0xC0, 0x3F,
+    0xF0, 0x3C, 0x70, 0x38, 0x38, 0x30, 0x18, 0x30, 0x18, 0x30, 0x18, 0x30, 0x38, 0x3C, 0x70, 0xFF,
+    0xF0, 0xF7, 0xC0, 0x1F, 0xB0, 0x3F, 0xF0, 0x70, 0xF0, 0xE0, 0x70, 0xC0, 0x30, 0xC0, 0x00, 0xC0,
+    0x00, 0xC0, 0x00, 0x70, 0x70, 0x7F, 0xF0, 0x1F, 0xC0, 0x01, 0xE0, 0x01, 0xE0, 0x00, 0x60, 0x00,
+    0x60, 0x1F, 0x60, 0x7F, 0xE0, 0x71, 0xE0, 0xE0, 0xE0, 0xC0, 0x60, 0xC0, 0x60, 0xC0, 0x60, 0xC0,
+    0xE0, 0x71, 0xE0, 0x7F, 0xF8, 0x1F, 0x78, 0x1F, 0x80, 0x3F, 0xC0, 0x70, 0xE0, 0xE0, 0x70, 0xFF,
+    0xF0, 0xFF, 0xF0, 0xE0, 0x00, 0xE0, 0x00, 0x70, 0x70, 0x3F, 0xF0, 0x1F, 0xC0, 0x07, 0xC0, 0x1F,
+    0xE0, 0x18, 0x00, 0x18, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18,
+    0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x1F, 0x78, 0x3F, 0xF8, 0x71,
+    0xE0, 0xC0, 0xE0, 0xC0, 0x60, 0xC0, 0x60, 0xC0, 0x60, 0xE0, 0xE0, 0x71, 0xE0, 0x3F, 0xE0, 0x1F,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0xE0, 0x1F, 0xC0, 0x1F, 0x80, 0xF0, 0x00, 0xF0, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0x37, 0xC0, 0x3F, 0xE0, 0x3C, 0x70, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0xFC, 0xFC, 0xFC, 0xFC, 0x06, 0x00, 0x06, 0x00, 0x00, 0x00, 0x7E,
+    0x00, 0x7E, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06,
+    0x00, 0xFF, 0xE0, 0xFF, 0xE0, 0x06, 0x06, 0x00, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x07, 0xFE, 0xFC, 0xF0, 0x00, 0xF0, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x33, 0xF0, 0x33, 0xF0, 0x37, 0x80, 0x3F, 0x00, 0x3E, 0x00, 0x3E, 0x00, 0x3F, 0x00, 0x37, 0x80,
+    0x31, 0xC0, 0xF1, 0xF8, 0xF1, 0xF8, 0x7E, 0x00, 0x7E, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00,
+    0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00,
+    0xFF, 0xE0, 0xFF, 0xE0, 0xFE, 0xF0, 0xFF, 0xF8, 0x73, 0x98, 0x63, 0x18, 0x63, 0x18, 0x63, 0x18,
+    0x63, 0x18, 0x63, 0x18, 0x63, 0x18, 0xFB, 0xDE, 0xFB, 0xDE, 0x77, 0xC0, 0x7F, 0xE0, 0x3C, 0x70,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xFC, 0x7C, 0xFC, 0x7C,
+    0x1F, 0x80, 0x3F, 0xC0, 0x70, 0xE0, 0xE0, 0x70, 0xC0, 0x30, 0xC0, 0x30, 0xC0, 0x30, 0xE0, 0x70,
+    0x70, 0xE0, 0x3F, 0xC0, 0x1F, 0x80, 0xF7, 0xE0, 0xFF, 0xF0, 0x3C, 0x38, 0x38, 0x1C, 0x30, 0x0C,
+    0x30, 0x0C, 0x30, 0x0C, 0x38, 0x1C, 0x3C, 0x38, 0x3F, 0xF0, 0x37, 0xE0, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0xFE, 0x00, 0xFE, 0x00, 0x1F, 0xBC, 0x3F, 0xFC, 0x70, 0xF0, 0xE0, 0x70, 0xC0, 0x30,
+    0xC0, 0x30, 0xC0, 0x30, 0xE0, 0x70, 0x70, 0xF0, 0x3F, 0xF0, 0x1F, 0xB0, 0x00, 0x30, 0x00, 0x30,
+    0x00, 0x30, 0x01, 0xFC, 0x01, 0xFC, 0x79, 0xE0, 0x7F, 0xF0, 0x1F, 0x30, 0x1C, 0x00, 0x18, 0x00,
+    0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x3F, 0x80, 0x7F, 0xC0,
+    0xE1, 0xC0, 0xE0, 0x80, 0xFE, 0x00, 0x7F, 0x80, 0x0F, 0xC0, 0xC0, 0xC0, 0xE0, 0xC0, 0xFF, 0xC0,
+    0xFF, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0xFF, 0xC0, 0xFF, 0xC0, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0xE0, 0x1F, 0xE0, 0x0F, 0x80, 0xF1, 0xF0,
+    0xF1, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x38, 0xF0,
+    0x1F, 0xF8, 0x0F, 0xB8, 0xFC, 0xFC, 0xFC, 0xFC, 0x38, 0x70, 0x38, 0x70, 0x1C, 0x60, 0x1C, 0xE0,
+    0x0E, 0xC0, 0x0F, 0xC0, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0xF8, 0x7C, 0xF8, 0x7C, 0x73, 0x98,
+    0x33, 0x98, 0x37, 0xB0, 0x3F, 0xF0, 0x3F, 0xF0, 0x1E, 0xF0, 0x1C, 0xF0, 0x1C, 0xE0, 0x18, 0x60,
+    0x7C, 0xF8, 0x7C, 0xF8, 0x3C, 0xF0, 0x1F, 0xE0, 0x0F, 0xC0, 0x07, 0x80, 0x0F, 0xC0, 0x1C, 0xE0,
+    0x38, 0x70, 0xFC, 0xFC, 0xFC, 0xFC, 0xF9, 0xF0, 0xF9, 0xF0, 0x70, 0xE0, 0x30, 0xC0, 0x39, 0xC0,
+    0x19, 0x80, 0x19, 0x80, 0x1F, 0x80, 0x0F, 0x00, 0x0F, 0x00, 0x06, 0x00, 0x06, 0x00, 0x0E, 0x00,
+    0x0C, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x7F, 0xC0, 0x7F, 0xC0, 0x63, 0x80, 0x67, 0x00, 0x07, 0x00,
+    0x0E, 0x00, 0x1C, 0x00, 0x38, 0xC0, 0x70, 0xE0, 0xFF, 0xE0, 0xFF, 0xE0, 0x0E, 0x1E, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x38, 0xF0, 0xF0, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x0E, 0xC0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0x00, 0xE0, 0xE0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x1E, 0x1E, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0xF0, 0xE0, 0x3C, 0x30, 0x7E, 0x70, 0x67, 0xE0, 0x61, 0xC0,
+};
+
+static const FontAtlasGlyph FreeMonoBold12pt7bAtlasGlyphs[] = {
+    {     0,  0,  0, 0, 14,   0,   1 },  // 0x20
+    {     0,  4, 15, 1, 14,   5, -14 },  // 0x21
+    {    15,  8,  7, 1, 14,   3, -13 },  // 0x22
+    {    22, 11, 18, 2, 14,   2, -15 },  // 0x23
+    {    58, 10, 20, 2, 14,   2, -16 },  // 0x24
+    {    98, 10, 15, 2, 14,   2, -14 },  // 0x25
+    {   128, 10, 13, 2, 14,   2, -12 },  // 0x26
+    {   154,  3,  7, 1, 14,   5, -13 },  // 0x27
+    {   161,  5, 19, 1, 14,   6, -14 },  // 0x28
+    {   180,  5, 19, 1, 14,   3, -14 },  // 0x29
+    {   199, 10, 10, 2, 14,   2, -14 },  // 0x2A
+    {   219, 12, 13, 2, 14,   1, -12 },  // 0x2B
+    {   245,  5,  7, 1, 14,   4,  -2 },  // 0x2C
+    {   252, 12,  2, 2, 14,   1,  -7 },  // 0x2D
+    {   256,  3,  3, 1, 14,   5,  -2 },  // 0x2E
+    {   259, 10, 20, 2, 14,   2, -16 },  // 0x2F
+    {   299, 10, 15, 2, 14,   2, -14 },  // 0x30
+    {   329, 10, 15, 2, 14,   2, -14 },  // 0x31
+    {   359, 10, 15, 2, 14,   2, -14 },  // 0x32
+    {   389, 11, 15, 2, 14,   1, -14 },  // 0x33
+    {   419,  9, 14, 2, 14,   2, -13 },  // 0x34
+    {   447, 10, 15, 2, 14,   2, -14 },  // 0x35
+    {   477, 10, 15, 2, 14,   2, -14 },  // 0x36
+    {   507, 10, 15, 2, 14,   2, -14 },  // 0x37
+    {   537, 10, 15, 2, 14,   2, -14 },  // 0x38
+    {   567, 10, 15, 2, 14,   3, -14 },  // 0x39
+    {   597,  3, 11, 1, 14,   5, -10 },  // 0x3A
+    {   608,  4, 15, 1, 14,   4, -10 },  // 0x3B
+    {   623, 12, 11, 2, 14,   1, -11 },  // 0x3C
+    {   645, 12,  7, 2, 14,   1,  -9 },  // 0x3D
+    {   659, 12, 11, 2, 14,   1, -11 },  // 0x3E
+    {   681,  9, 14, 2, 14,   3, -13 },  // 0x3F
+    {   709, 11, 19, 2, 14,   2, -14 },  // 0x40
+    {   747, 15, 14, 2, 14,  -1, -13 },  // 0x41
+    {   775, 13, 14, 2, 14,   0, -13 },  // 0x42
+    {   803, 12, 14, 2, 14,   1, -13 },  // 0x43
+    {   831, 12, 14, 2, 14,   1, -13 },  // 0x44
+    {   859, 13, 14, 2, 14,   0, -13 },  // 0x45
+    {   887, 13, 14, 2, 14,   0, -13 },  // 0x46
+    {   915, 13, 14, 2, 14,   1, -13 },  // 0x47
+    {   943, 14, 14, 2, 14,   0, -13 },  // 0x48
+    {   971, 10, 14, 2, 14,   2, -13 },  // 0x49
+    {   999, 13, 14, 2, 14,   1, -13 },  // 0x4A
+    {  1027, 14, 14, 2, 14,   0, -13 },  // 0x4B
+    {  1055, 12, 14, 2, 14,   1, -13 },  // 0x4C
+    {  1083, 14, 14, 2, 14,   0, -13 },  // 0x4D
+    {  1111, 13, 14, 2, 14,   0, -13 },  // 0x4E
+    {  1139, 12, 14, 2, 14,   1, -13 },  // 0x4F
+    {  1167, 12, 14, 2, 14,   0, -13 },  // 0x50
+    {  1195, 12, 17, 2, 14,   1, -13 },  // 0x51
+    {  1229, 14, 14, 2, 14,   0, -13 },  // 0x52
+    {  1257, 10, 14, 2, 14,   2, -13 },  // 0x53
+    {  1285, 12, 14, 2, 14,   1, -13 },  // 0x54
+    {  1313, 12, 14, 2, 14,   1, -13 },  // 0x55
+    {  1341, 16, 14, 2, 14,  -1, -13 },  // 0x56
+    {  1369, 14, 14, 2, 14,   0, -13 },  // 0x57
+    {  1397, 14, 14, 2, 14,   0, -13 },  // 0x58
+    {  1425, 12, 14, 2, 14,   1, -13 },  // 0x59
+    {  1453, 10, 14, 2, 14,   2, -13 },  // 0x5A
+    {  1481,  5, 19, 1, 14,   6, -14 },  // 0x5B
+    {  1500, 10, 20, 2, 14,   2, -16 },  // 0x5C
+    {  1540,  5, 19, 1, 14,   3, -14 },  // 0x5D
+    {  1559, 10,  8, 2, 14,   2, -15 },  // 0x5E
+    {  1575, 14,  2, 2, 14,   0,   4 },  // 0x5F
+    {  1579,  4,  4, 1, 14,   4, -15 },  // 0x60
+    {  1583, 12, 11, 2, 14,   1, -10 },  // 0x61
+    {  1605, 13, 15, 2, 14,   0, -14 },  // 0x62
+    {  1635, 12, 11, 2, 14,   1, -10 },  // 0x63
+    {  1657, 13, 15, 2, 14,   1, -14 },  // 0x64
+    {  1687, 12, 11, 2, 14,   1, -10 },  // 0x65
+    {  1709, 11, 15, 2, 14,   2, -14 },  // 0x66
+    {  1739, 13, 16, 2, 14,   1, -10 },  // 0x67
+    {  1771, 14, 15, 2, 14,   0, -14 },  // 0x68
+    {  1801, 11, 14, 2, 14,   1, -13 },  // 0x69
+    {  1829,  8, 19, 1, 15,   3, -13 },  // 0x6A
+    {  1848, 13, 15, 2, 14,   1, -14 },  // 0x6B
+    {  1878, 11, 15, 2, 14,   1, -14 },  // 0x6C
+    {  1908, 15, 11, 2, 14,   0, -10 },  // 0x6D
+    {  1930, 14, 11, 2, 14,   0, -10 },  // 0x6E
+    {  1952, 12, 11, 2, 14,   1, -10 },  // 0x6F
+    {  1974, 14, 16, 2, 14,   0, -10 },  // 0x70
+    {  2006, 14, 16, 2, 14,   0, -10 },  // 0x71
+    {  2038, 12, 11, 2, 14,   1, -10 },  // 0x72
+    {  2060, 10, 11, 2, 14,   2, -10 },  // 0x73
+    {  2082, 11, 14, 2, 14,   1, -13 },  // 0x74
+    {  2110, 13, 11, 2, 14,   0, -10 },  // 0x75
+    {  2132, 14, 11, 2, 14,   0, -10 },  // 0x76
+    {  2154, 14, 11, 2, 14,   0, -10 },  // 0x77
+    {  2176, 14, 11, 2, 14,   0, -10 },  // 0x78
+    {  2198, 12, 16, 2, 14,   1, -10 },  // 0x79
+    {  2230, 11, 11, 2, 14,   1, -10 },  // 0x7A
+    {  2252,  7, 19, 1, 14,   3, -14 },  // 0x7B
+    {  2271,  2, 19, 1, 14,   6, -14 },  // 0x7C
+    {  2290,  7, 19, 1, 14,   4, -14 },  // 0x7D
+    {  2309, 12,  4, 2, 14,   1,  -7 },  // 0x7E
+};
+
+static const FontAtlas FreeMonoBold12pt7bAtlas = {
+    0x68296E9Du, FreeMonoBold12pt7bAtlasBits, FreeMonoBold12pt7bAtlasGlyphs, 0x20, 0x7E, 24
+};
+
+static const uint8_t Org_01AtlasBits[] = {
+    0x80, 0x80, 0x80, 0x00, 0x80, 0xA0, 0x50, 0xF8, 0x50, 0xF8, 0x50, 0xF8, 0xA0, 0xF8, 0x28, 0xF8,
+    0x88, 0x10, 0x20, 0x40, 0x88, 0xF0, 0x90, 0xF8, 0x90, 0xE8, 0x80, 0x40, 0x80, 0x80, 0x80, 0x40,
+    0x80, 0x40, 0x40, 0x40, 0x80, 0xA0, 0x40, 0xA0, 0x40, 0xE0, 0x40, 0x80, 0x80, 0xF0, 0x80, 0x08,
+    0x10, 0x20, 0x40, 0x80, 0xF8, 0x88, 0x88, 0x88, 0xF8, 0x80, 0x80, 0x80, 0x80, 0x80, 0xF8, 0x08,
+    0xF8, 0x80, 0xF8, 0xF8, 0x08, 0xF8, 0x08, 0xF8, 0x88, 0x88, 0xF8, 0x08, 0x08, 0xF8, 0x80, 0xF8,
+    0x08, 0xF8, 0xF8, 0x80, 0xF8, 0x88, 0xF8, 0xF8, 0x08, 0x08, 0x08, 0x08, 0xF8, 0x88, 0xF8, 0x88,
+    0xF8, 0xF8, 0x88, 0xF8, 0x08, 0xF8, 0x80, 0x00, 0x00, 0x80, 0x80, 0x00, 0x80, 0x80, 0x20, 0x40,
+    0x80, 0x40, 0x20, 0xF0, 0x00, 0xF0, 0x80, 0x40, 0x20, 0x40, 0x80, 0xF8, 0x08, 0x38, 0x00, 0x20,
+    0xF8, 0xA8, 0xB8, 0x80, 0xF8, 0xF8, 0x88, 0xF8, 0x88, 0x88, 0xF0, 0x88, 0xF0, 0x88, 0xF0, 0xF8,
+    0x80, 0x80, 0x80, 0xF8, 0xF0, 0x88, 0x88, 0x88, 0xF0, 0xF8, 0x80, 0xF8, 0x80, 0xF8, 0xF8, 0x80,
+    0xF8, 0x80, 0x80, 0xF8, 0x80, 0xB8, 0x88, 0xF8, 0x88, 0x88, 0xF8, 0x88, 0x88, 0xF8, 0x20, 0x20,
+    0x20, 0xF8, 0x78, 0x10, 0x10, 0x90, 0xF8, 0x88, 0xB0, 0xC0, 0xB0, 0x88, 0x80, 0x80, 0x80, 0x80,
+    0xF8, 0xF8, 0xA8, 0xA8, 0xA8, 0xA8, 0xF8, 0x88, 0x88, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, 0xF8,
+    0xF8, 0x88, 0xF8, 0x80, 0x80, 0xF8, 0x88, 0x88, 0x98, 0xF8, 0xF8, 0x88, 0xF8, 0x90, 0x90, 0xF8,
+    0x80, 0xF8, 0x08, 0xF8, 0xF8, 0x20, 0x20, 0x20, 0x20, 0x88, 0x88, 0x88, 0x88, 0xF8, 0x88, 0x88,
+    0x88, 0x50, 0x20, 0xA8, 0xA8, 0xA8, 0xA8, 0xF8, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x88, 0x50,
+    0x20, 0x20, 0xF8, 0x08, 0xF8, 0x80, 0xF8, 0xC0, 0x80, 0x80, 0x80, 0xC0, 0x80, 0x40, 0x20, 0x10,
+    0x08, 0xC0, 0x40, 0x40, 0x40, 0xC0, 0x40, 0xA0, 0xF8, 0x80, 0xF0, 0x10, 0xF0, 0xF0, 0x80, 0xF0,
+    0x90, 0x90, 0xF0, 0xF0, 0x80, 0x80, 0xF0, 0x10, 0xF0, 0x90, 0x90, 0xF0, 0xF0, 0xF0, 0x80, 0xF0,
+    0x60, 0x40, 0xE0, 0x40, 0x40, 0xF0, 0x90, 0x90, 0xF0, 0x10, 0x80, 0xF0, 0x90, 0x90, 0x90, 0x80,
+    0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0xC0, 0x80, 0xA0, 0xF0, 0x90, 0x90, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0xF8, 0xA8, 0x88, 0x88, 0xF0, 0x90, 0x90, 0x90, 0xF0, 0x90, 0x90, 0xF0, 0xF0, 0x90,
+    0x90, 0xF0, 0x80, 0xF0, 0x90, 0x90, 0xF0, 0x20, 0xF0, 0x80, 0x80, 0x80, 0x40, 0x70, 0x10, 0xF0,
+    0x20, 0xF8, 0x20, 0x20, 0x20, 0x90, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x90, 0x70, 0x88, 0x88, 0xA8,
+    0xF8, 0x90, 0x60, 0x60, 0x90, 0x90, 0x90, 0x90, 0xF0, 0x10, 0x20, 0xE0, 0x80, 0xF0, 0x20, 0x40,
+    0xC0, 0x40, 0x20, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x60, 0x40, 0x80, 0x08, 0xF8, 0x80,
+};
+
+static const FontAtlasGlyph Org_01AtlasGlyphs[] = {
+    {     0,  0,  0, 0,  6,   0,   1 },  // 0x20
+    {     0,  1,  5, 1,  2,   0,  -4 },  // 0x21
+    {     5,  3,  1, 1,  4,   0,  -4 },  // 0x22
+    {     6,  5,  5, 1,  6,   0,  -4 },  // 0x23
+    {    11,  5,  5, 1,  6,   0,  -4 },  // 0x24
+    {    16,  5,  5, 1,  6,   0,  -4 },  // 0x25
+    {    21,  5,  5, 1,  6,   0,  -4 },  // 0x26
+    {    26,  1,  1, 1,  2,   0,  -4 },  // 0x27
+    {    27,  2,  5, 1,  3,   0,  -4 },  // 0x28
+    {    32,  2,  5, 1,  3,   0,  -4 },  // 0x29
+    {    37,  3,  3, 1,  4,   0,  -3 },  // 0x2A
+    {    40,  3,  3, 1,  4,   0,  -3 },  // 0x2B
+    {    43,  1,  2, 1,  2,   0,   0 },  // 0x2C
+    {    45,  4,  1, 1,  5,   0,  -2 },  // 0x2D
+    {    46,  1,  1, 1,  2,   0,   0 },  // 0x2E
+    {    47,  5,  5, 1,  6,   0,  -4 },  // 0x2F
+    {    52,  5,  5, 1,  6,   0,  -4 },  // 0x30
+    {    57,  1,  5, 1,  2,   0,  -4 },  // 0x31
+    {    62,  5,  5, 1,  6,   0,  -4 },  // 0x32
+    {    67,  5,  5, 1,  6,   0,  -4 },  // 0x33
+    {    72,  5,  5, 1,  6,   0,  -4 },  // 0x34
+    {    77,  5,  5, 1,  6,   0,  -4 },  // 0x35
+    {    82,  5,  5, 1,  6,   0,  -4 },  // 0x36
+    {    87,  5,  5, 1,  6,   0,  -4 },  // 0x37
+    {    92,  5,  5, 1,  6,   0,  -4 },  // 0x38
+    {    97,  5,  5, 1,  6,   0,  -4 },  // 0x39
+    {   102,  1,  4, 1,  2,   0,  -3 },  // 0x3A
+    {   106,  1,  4, 1,  2,   0,  -3 },  // 0x3B
+    {   110,  3,  5, 1,  4,   0,  -4 },  // 0x3C
+    {   115,  4,  3, 1,  5,   0,  -3 },  // 0x3D
+    {   118,  3,  5, 1,  4,   0,  -4 },  // 0x3E
+    {   123,  5,  5, 1,  6,   0,  -4 },  // 0x3F
+    {   128,  5,  5, 1,  6,   0,  -4 },  // 0x40
+    {   133,  5,  5, 1,  6,   0,  -4 },  // 0x41
+    {   138,  5,  5, 1,  6,   0,  -4 },  // 0x42
+    {   143,  5,  5, 1,  6,   0,  -4 },  // 0x43
+    {   148,  5,  5, 1,  6,   0,  -4 },  // 0x44
+    {   153,  5,  5, 1,  6,   0,  -4 },  // 0x45
+    {   158,  5,  5, 1,  6,   0,  -4 },  // 0x46
+    {   163,  5,  5, 1,  6,   0,  -4 },  // 0x47
+    {   168,  5,  5, 1,  6,   0,  -4 },  // 0x48
+    {   173,  5,  5, 1,  6,   0,  -4 },  // 0x49
+    {   178,  5,  5, 1,  6,   0,  -4 },  // 0x4A
+    {   183,  5,  5, 1,  6,   0,  -4 },  // 0x4B
+    {   188,  5,  5, 1,  6,   0,  -4 },  // 0x4C
+    {   193,  5,  5, 1,  6,   0,  -4 },  // 0x4D
+    {   198,  5,  5, 1,  6,   0,  -4 },  // 0x4E
+    {   203,  5,  5, 1,  6,   0,  -4 },  // 0x4F
+    {   208,  5,  5, 1,  6,   0,  -4 },  // 0x50
+    {   213,  5,  5, 1,  6,   0,  -4 },  // 0x51
+    {   218,  5,  5, 1,  6,   0,  -4 },  // 0x52
+    {   223,  5,  5, 1,  6,   0,  -4 },  // 0x53
+    {   228,  5,  5, 1,  6,   0,  -4 },  // 0x54
+    {   233,  5,  5, 1,  6,   0,  -4 },  // 0x55
+    {   238,  5,  5, 1,  6,   0,  -4 },  // 0x56
+    {   243,  5,  5, 1,  6,   0,  -4 },  // 0x57
+    {   248,  5,  5, 1,  6,   0,  -4 },  // 0x58
+    {   253,  5,  5, 1,  6,   0,  -4 },  // 0x59
+    {   258,  5,  5, 1,  6,   0,  -4 },  // 0x5A
+    {   263,  2,  5, 1,  3,   0,  -4 },  // 0x5B
+    {   268,  5,  5, 1,  6,   0,  -4 },  // 0x5C
+    {   273,  2,  5, 1,  3,   0,  -4 },  // 0x5D
+    {   278,  3,  2, 1,  4,   0,  -4 },  // 0x5E
+    {   280,  5,  1, 1,  6,   0,   1 },  // 0x5F
+    {   281,  1,  1, 1,  2,   0,  -4 },  // 0x60
+    {   282,  4,  4, 1,  5,   0,  -3 },  // 0x61
+    {   286,  4,  5, 1,  5,   0,  -4 },  // 0x62
+    {   291,  4,  4, 1,  5,   0,  -3 },  // 0x63
+    {   295,  4,  5, 1,  5,   0,  -4 },  // 0x64
+    {   300,  4,  4, 1,  5,   0,  -3 },  // 0x65
+    {   304,  3,  5, 1,  4,   0,  -4 },  // 0x66
+    {   309,  4,  5, 1,  5,   0,  -3 },  // 0x67
+    {   314,  4,  5, 1,  5,   0,  -4 },  // 0x68
+    {   319,  1,  4, 1,  2,   0,  -3 },  // 0x69
+    {   323,  2,  5, 1,  3,   0,  -3 },  // 0x6A
+    {   328,  4,  5, 1,  5,   0,  -4 },  // 0x6B
+    {   333,  1,  5, 1,  2,   0,  -4 },  // 0x6C
+    {   338,  5,  4, 1,  6,   0,  -3 },  // 0x6D
+    {   342,  4,  4, 1,  5,   0,  -3 },  // 0x6E
+    {   346,  4,  4, 1,  5,   0,  -3 },  // 0x6F
+    {   350,  4,  5, 1,  5,   0,  -3 },  // 0x70
+    {   355,  4,  5, 1,  5,   0,  -3 },  // 0x71
+    {   360,  4,  4, 1,  5,   0,  -3 },  // 0x72
+    {   364,  4,  4, 1,  5,   0,  -3 },  // 0x73
+    {   368,  5,  5, 1,  6,   0,  -4 },  // 0x74
+    {   373,  4,  4, 1,  5,   0,  -3 },  // 0x75
+    {   377,  4,  4, 1,  5,   0,  -3 },  // 0x76
+    {   381,  5,  4, 1,  6,   0,  -3 },  // 0x77
+    {   385,  4,  4, 1,  5,   0,  -3 },  // 0x78
+    {   389,  4,  5, 1,  5,   0,  -3 },  // 0x79
+    {   394,  4,  4, 1,  5,   0,  -3 },  // 0x7A
+    {   398,  3,  5, 1,  4,   0,  -4 },  // 0x7B
+    {   403,  1,  5, 1,  2,   0,  -4 },  // 0x7C
+    {   408,  3,  5, 1,  4,   0,  -4 },  // 0x7D
+    {   413,  5,  3, 1,  6,   0,  -3 },  // 0x7E
+};
+
+static const FontAtlas Org_01Atlas = {
+    0x1D945627u, Org_01AtlasBits, Org_01AtlasGlyphs, 0x20, 0x7E, 7
+};
+
+static const FontAtlas* const font_atlases[] = {
+    &FreeMonoBold9pt7bAtlas,
+    &FreeMonoBold12pt7bAtlas,
+    &Org_01Atlas,
+};
+
+#endif
@@ -0,0 +1,146 @@
+// font_blit.cpp — Atlas-based text blitter for the off-screen frame
+
+#include "font_blit.h"
+#include "font_atlas.h"
+#include "disp_dirty.h"
+#include "display.h"
+#include "display_layout.h"
+#include <Fonts/FreeMonoBold9pt7b.h>
+
+#define FB_STRIDE   (DISP_MIRROR_W / 8)
+
+static bool s_enabled = true;
+
+// Last few GFXfont pointers seen and the atlas they resolved to (nullptr = no atlas)
+#define FB_FONT_CACHE   8
+static const GFXfont* s_font_ptr[FB_FONT_CACHE];
+static const FontAtlas* s_font_atlas[FB_FONT_CACHE];
+static uint8_t s_font_next = 0;
+
+// Must match signature() in gen_font_atlas.py
+static uint32_t fontSignature(const GFXfont* f) {
+    uint32_t h = 2166136261u;
+    auto mix = [&h](uint8_t b) { h = (h ^ b) * 16777619u; };
+    mix(f->first);
+    mix(f->last);
+    mix(f->yAdvance);
+    for (uint16_t c = f->first; c <= f->last; c++) {
+        const GFXglyph& g = f->glyph[c - f->first];
+        mix(g.bitmapOffset & 0xFF);
+        mix(g.bitmapOffset >> 8);
+        mix(g.width);
+        mix(g.height);
+        mix(g.xAdvance);
+        mix((uint8_t)g.xOffset);
+        mix((uint8_t)g.yOffset);
+    }
+    return h;
+}
+
+static const FontAtlas* atlasFor(const GFXfont* font) {
+    for (uint8_t i = 0; i < FB_FONT_CACHE; i++) {
+        if (s_font_ptr[i] == font) return s_font_atlas[i];
+    }
+    uint32_t sig = fontSignature(font);
+    const FontAtlas* found = nullptr;
+    for (const FontAtlas* a : font_atlases) {
+        if (a->signature == sig) {
+            found = a;
+            break;
+        }
+    }
+    s_font_ptr[s_font_next] = font;
+    s_font_atlas[s_font_next] = found;
+    s_font_next = (s_font_next + 1) % FB_FONT_CACHE;
+    return found;
+}
+
+// Whole glyph box must sit inside one clip rect — anything else goes the per-pixel way
+static bool boxInsideClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    uint8_t n = dispClipCount();
+    if (n == 0) return true;
+    for (uint8_t i = 0; i < n; i++) {
+        const DispRect& r = dispClipRect(i);
+        if (x >= r.x && y >= r.y && x + w <= r.x + r.w && y + h <= r.y + r.h) return true;
+    }
+    return false;
+}
+
+int16_t fontBlitChar(const GFXfont* font, int16_t x, int16_t y, uint8_t c, uint16_t color, int16_t wrap_width) {
+    if (!s_enabled || !font) return -1;
+    const FontAtlas* a = atlasFor(font);
+    if (!a) return -1;
+    if (c < a->first || c > a->last) return 0;     // Adafruit_GFX skips these without advancing
+
+    const FontAtlasGlyph& g = a->glyphs[c - a->first];
+    if (g.width == 0 || g.height == 0) return g.x_advance;
+    if (wrap_width > 0 && x + g.x_offset + g.width > wrap_width) return -1;
+
+    int16_t gx = x + g.x_offset;
+    int16_t gy = y + g.y_offset;
+    if (gx < 0 || gy < 0 || gx + g.width > DISP_MIRROR_W || gy + g.height > DISP_MIRROR_H) return -1;
+    if (!boxInsideClip(gx, gy, g.width, g.height)) return -1;
+
+    const uint8_t* src = a->bits + g.offset;
+    uint8_t* row = dispMirrorFrame() + gy * FB_STRIDE + (gx >> 3);
+    uint8_t shift = gx & 7;
+    bool black = color != GxEPD_WHITE;          // Frame: 1 = black
+
+    if (shift == 0) {
+        // Fast path — glyph starts on a byte: rows go in as-is
+        for (uint8_t r = 0; r < g.height; r++, row += FB_STRIDE, src += g.stride) {
+            for (uint8_t b = 0; b < g.stride; b++) {
+                if (black) row[b] |= src[b];
+                else row[b] &= ~src[b];
+            }
+        }
+    } else {
+        // Each source byte straddles two frame bytes; only touch the bytes the glyph covers
+        uint8_t span = (shift + g.width + 7) >> 3;
+        for (uint8_t r = 0; r < g.height; r++, row += FB_STRIDE, src += g.stride) {
+            uint8_t carry = 0;
+            for (uint8_t b = 0; b < span; b++) {
+                uint8_t v = b < g.stride ? src[b] : 0;
+                uint8_t out = carry | (v >> shift);
+                carry = v << (8 - shift);
+                if (black) row[b] |= out;
+                else row[b] &= ~out;
+            }
+        }
+    }
+    return g.x_advance;
+}
+
+void fontBlitEnable(bool en) {
+    s_enabled = en;
+}
+
+static uint32_t benchPass(bool blit, uint16_t& chars) {
+    static const char line[] = "The quick fox 0123";
+    fontBlitEnable(blit);
+    display->fillScreen(GxEPD_WHITE);
+    display->setFont(&FreeMonoBold9pt7b);
+    display->setTextColor(GxEPD_BLACK);
+    chars = 0;
+    uint32_t t0 = micros();
+    for (int16_t y = 14; y < DISP_MIRROR_H; y += 18) {
+        display->setCursor(1, y);       // Off the byte grid — the shifted path is the common case
+        display->print(line);
+        chars += sizeof(line) - 1;
+    }
+    uint32_t us = micros() - t0;
+    fontBlitEnable(true);
+    return us;
+}
+
+int fontBlitBenchmark(char* out, size_t out_len) {
+    uint16_t chars = 0;
+    uint32_t pixel_us = benchPass(false, chars);
+    uint32_t blit_us = benchPass(true, chars);
+
+    // The frame now holds benchmark text, not the layout — force a complete redraw
+    layoutInvalidate();
+    layout_state._dirty = true;
+    return snprintf(out, out_len, "OK{FONTBENCH:chars=%u,pixel_us=%lu,blit_us=%lu}",
+                    chars, (unsigned long)pixel_us, (unsigned long)blit_us);
+}
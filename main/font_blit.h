@@ -0,0 +1,42 @@
+// font_blit.h — Atlas-based text blitter for the off-screen frame
+
+#ifndef FONT_BLIT_H
+#define FONT_BLIT_H
+
+#include <Arduino.h>
+#include <gfxfont.h>
+
+// Glyphs of the fonts we use are pre-rasterised into byte-aligned 1bpp rows by
+// build_scripts/gen_font_atlas.py (→ font_atlas.h). Instead of one drawPixel() per set bit,
+// a glyph row is ORed/ANDed into the frame a byte at a time with a shift — or copied straight
+// when the glyph starts on an 8-pixel boundary.
+
+struct FontAtlasGlyph {
+    uint16_t offset;        // Into bits[]
+    uint8_t  width, height;
+    uint8_t  stride;        // Bytes per row
+    uint8_t  x_advance;
+    int8_t   x_offset, y_offset;
+};
+
+struct FontAtlas {
+    uint32_t signature;     // Of the source GFXfont — each TU has its own copy of the font, so match by content
+    const uint8_t* bits;
+    const FontAtlasGlyph* glyphs;
+    uint8_t first, last;
+    uint8_t y_advance;
+};
+
+// Draw one character at the text cursor (x, y = baseline). Returns the cursor advance, or -1
+// when the caller must fall back to Adafruit_GFX: font not in the atlas, glyph crosses the panel
+// edge or a clip-rect boundary, or it would wrap (wrap_width > 0).
+int16_t fontBlitChar(const GFXfont* font, int16_t x, int16_t y, uint8_t c, uint16_t color, int16_t wrap_width);
+
+// Benchmark toggle — false routes every glyph through Adafruit_GFX's per-pixel path
+void fontBlitEnable(bool en);
+
+// Renders a screen of text both ways into the frame (not pushed to the panel), then invalidates
+// the layout so the next render restores it. "OK{FONTBENCH:chars=..,pixel_us=..,blit_us=..}"
+int fontBlitBenchmark(char* out, size_t out_len);
+
+#endif
@@ -0,0 +1,192 @@
+// geodesy.cpp — Float equirectangular / haversine kernels, cached origin, benchmark
+
+#include "geodesy.h"
+#include <math.h>
+#include <TinyGPS++.h>
+
+#define GEO_RAD_PER_E6          (1e-6f * (float)DEG_TO_RAD)
+
+static struct {
+    int32_t lat_e6, lon_e6;
+    float   kx;             // geoLonScale(lat_e6)
+    float   sin_lat, cos_lat;
+    bool    valid;
+} s_origin;
+
+static int32_t wrapLon(int32_t dlon) {
+    if (dlon > 180000000) return dlon - 360000000;
+    if (dlon < -180000000) return dlon + 360000000;
+    return dlon;
+}
+
+static bool shortRange(int32_t lat, int32_t dlat, int32_t dlon) {
+    return abs(dlat) < GEO_EQR_MAX_E6 && abs(dlon) < GEO_EQR_MAX_E6 &&
+           abs(lat) < GEO_EQR_MAX_LAT_E6;
+}
+
+float geoLonScale(int32_t lat_e6) {
+    return GEO_M_PER_E6 * cosf(lat_e6 * GEO_RAD_PER_E6);
+}
+
+// cos φ as sin(90° − |φ|): the integer co-latitude is exact in a float near the poles, where
+// cosf(φ) would lose the last few 1e-6° of φ and with them metres of a polar distance
+static float cosLat(int32_t lat_e6) {
+    return sinf((90000000 - abs(lat_e6)) * GEO_RAD_PER_E6);
+}
+
+// sin and cos of Δλ/2. Past 90° they come from the (exact, small) supplement, so that cos stays
+// precise towards the antipode.
+static void halfLon(int32_t dlon, float* hl, float* cl) {
+    if (abs(dlon) <= 90000000) {
+        float h = dlon * (0.5f * GEO_RAD_PER_E6);
+        *hl = sinf(h);
+        *cl = cosf(h);
+        return;
+    }
+    float r = (180000000 - abs(dlon)) * (0.5f * GEO_RAD_PER_E6);
+    *hl = dlon < 0 ? -cosf(r) : cosf(r);
+    *cl = sinf(r);
+}
+
+// Central angle, radians — cos of both latitudes supplied by the caller
+static float haversine(float c1, float c2, int32_t lat1, int32_t lat2, int32_t dlon) {
+    float hl, cl;
+    halfLon(dlon, &hl, &cl);
+    // a = sin²(Δφ/2) + …  from the exact integer difference, so short distances keep their precision;
+    // 1 − a = sin²(Σφ/2) + c1·c2·cos²(Δλ/2) the same way, so near-antipodal ones do too
+    float hs = sinf((lat2 - lat1) * (0.5f * GEO_RAD_PER_E6));
+    float hc = sinf((lat2 + lat1) * (0.5f * GEO_RAD_PER_E6));
+    float a = hs * hs + c1 * c2 * hl * hl;
+    float b = hc * hc + c1 * c2 * cl * cl;
+    return 2.0f * atan2f(sqrtf(a), sqrtf(b));
+}
+
+static float bearing(float s1, float c2, int32_t lat1, int32_t lat2, int32_t dlon) {
+    // y = sin Δλ·c2, x = c1·s2 − s1·c2·cos Δλ, with cos Δλ written as 1 − 2 sin²(Δλ/2) (short
+    // range) or 2 cos²(Δλ/2) − 1 (towards the antipode) so that x does not cancel in either
+    float hl, cl;
+    halfLon(dlon, &hl, &cl);
+    float y = 2.0f * hl * cl * c2;
+    float x = abs(dlon) <= 90000000
+                  ? sinf((lat2 - lat1) * GEO_RAD_PER_E6) + 2.0f * s1 * c2 * hl * hl
+                  : sinf((lat2 + lat1) * GEO_RAD_PER_E6) - 2.0f * s1 * c2 * cl * cl;
+    float deg = atan2f(y, x) * (float)RAD_TO_DEG;
+    return deg < 0 ? deg + 360.0f : deg;
+}
+
+static float enuBearing(float east, float north) {
+    float deg = atan2f(east, north) * (float)RAD_TO_DEG;
+    return deg < 0 ? deg + 360.0f : deg;
+}
+
+float geoDistanceE6(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2) {
+    int32_t dlat = lat2 - lat1;
+    int32_t dlon = wrapLon(lon2 - lon1);
+    if (shortRange(lat1, dlat, dlon)) {
+        float dx = dlon * geoLonScale(lat1 + dlat / 2);
+        float dy = dlat * GEO_M_PER_E6;
+        return sqrtf(dx * dx + dy * dy);
+    }
+    return GEO_EARTH_R_M * haversine(cosLat(lat1), cosLat(lat2), lat1, lat2, dlon);
+}
+
+float geoBearingE6(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2) {
+    int32_t dlat = lat2 - lat1;
+    int32_t dlon = wrapLon(lon2 - lon1);
+    if (shortRange(lat1, dlat, dlon)) {
+        return enuBearing(dlon * geoLonScale(lat1 + dlat / 2), dlat * GEO_M_PER_E6);
+    }
+    return bearing(sinf(lat1 * GEO_RAD_PER_E6), cosLat(lat2), lat1, lat2, dlon);
+}
+
+// ── Local frame ──
+
+void geoSetOrigin(double lat, double lon) {
+    int32_t la = geoE6(lat);
+    s_origin.lon_e6 = geoE6(lon);
+    s_origin.valid = true;
+    if (la == s_origin.lat_e6 && s_origin.kx != 0) return;     // Standing still — keep the trig
+    float p = la * GEO_RAD_PER_E6;
+    s_origin.lat_e6 = la;
+    s_origin.sin_lat = sinf(p);
+    s_origin.cos_lat = cosLat(la);
+    s_origin.kx = GEO_M_PER_E6 * s_origin.cos_lat;
+}
+
+bool geoOriginValid() {
+    return s_origin.valid;
+}
+
+void geoToEnu(int32_t lat_e6, int32_t lon_e6, float* east, float* north) {
+    int32_t dlat = lat_e6 - s_origin.lat_e6;
+    // Longitude scale at the mid latitude: cos(φ0 + δ) ≈ cos φ0 − sin φ0·δ, δ = Δφ/2
+    float kx = s_origin.kx - GEO_M_PER_E6 * s_origin.sin_lat * (dlat * (0.5f * GEO_RAD_PER_E6));
+    *east = wrapLon(lon_e6 - s_origin.lon_e6) * kx;
+    *north = dlat * GEO_M_PER_E6;
+}
+
+float geoFromOriginDistanceE6(int32_t la, int32_t lo) {
+    int32_t dlat = la - s_origin.lat_e6;
+    int32_t dlon = wrapLon(lo - s_origin.lon_e6);
+    if (shortRange(s_origin.lat_e6, dlat, dlon)) {
+        float e, n;
+        geoToEnu(la, lo, &e, &n);
+        return sqrtf(e * e + n * n);
+    }
+    return GEO_EARTH_R_M * haversine(s_origin.cos_lat, cosLat(la), s_origin.lat_e6, la, dlon);
+}
+
+float geoFromOriginBearing(double lat, double lon) {
+    int32_t la = geoE6(lat), lo = geoE6(lon);
+    int32_t dlat = la - s_origin.lat_e6;
+    int32_t dlon = wrapLon(lo - s_origin.lon_e6);
+    if (shortRange(s_origin.lat_e6, dlat, dlon)) {
+        float e, n;
+        geoToEnu(la, lo, &e, &n);
+        return enuBearing(e, n);
+    }
+    return bearing(s_origin.sin_lat, cosLat(la), s_origin.lat_e6, la, dlon);
+}
+
+// ── Benchmark ──
+
+int geoBenchmark(char* out, size_t out_len) {
+    const int N = 200;
+    // Peers scattered over ~30 km around a fixed point — the beacon / RANGE case
+    const double lat0 = 52.370216, lon0 = 4.895168;
+    static double lat[N], lon[N];
+    uint32_t x = 0x2545F491;
+    for (int i = 0; i < N; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        lat[i] = lat0 + ((int32_t)(x & 0xFFFF) - 32768) * 4e-6;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        lon[i] = lon0 + ((int32_t)(x & 0xFFFF) - 32768) * 6e-6;
+    }
+
+    static float ref[N];
+    uint32_t t0 = micros();
+    for (int i = 0; i < N; i++) ref[i] = TinyGPSPlus::distanceBetween(lat0, lon0, lat[i], lon[i]);
+    uint32_t tiny_us = micros() - t0;
+
+    float max_err = 0;
+    volatile float sink = 0;
+    t0 = micros();
+    for (int i = 0; i < N; i++) sink = geoDistance(lat0, lon0, lat[i], lon[i]);
+    uint32_t geo_us = micros() - t0;
+
+    auto saved = s_origin;
+    geoSetOrigin(lat0, lon0);
+    t0 = micros();
+    for (int i = 0; i < N; i++) sink = geoFromOriginDistance(lat[i], lon[i]);
+    uint32_t origin_us = micros() - t0;
+    for (int i = 0; i < N; i++) {
+        float e = fabsf(geoFromOriginDistance(lat[i], lon[i]) - ref[i]);
+        if (e > max_err) max_err = e;
+    }
+    s_origin = saved;
+    (void)sink;
+
+    return snprintf(out, out_len, "OK{GEOBENCH:n=%d,tinygps_us=%lu,geo_us=%lu,origin_us=%lu,max_err_cm=%lu}",
+                    N, (unsigned long)tiny_us, (unsigned long)geo_us, (unsigned long)origin_us,
+                    (unsigned long)lroundf(max_err * 100));
+}
@@ -0,0 +1,67 @@
+// geodesy.h — Single-precision distance, bearing and local ENU projection
+
+#ifndef GEODESY_H
+#define GEODESY_H
+
+#include <Arduino.h>
+
+// The Cortex-M4F FPU only does single precision, so TinyGPSPlus::distanceBetween() / courseTo()
+// (double sin/cos/atan2/sqrt) run in soft-float libm. This module works in float on the same
+// sphere, with positions as int32 1e-6 degrees so that coordinate differences stay exact:
+//
+//   short range  |Δlat|, |Δlon| < GEO_EQR_MAX_E6, |lat| < GEO_EQR_MAX_LAT_E6
+//                equirectangular — cosf of the mean latitude, one sqrtf
+//   otherwise    haversine in float
+//
+// geoSetOrigin() (loopGPS, every good fix) caches our position and its longitude scale, so the
+// geoFrom*() functions against our own position skip the cosf as well.
+//
+// Accuracy against the same formulas in double on the same inputs (tests/host/geodesy_test.cpp,
+// 2M pairs weighted towards the poles, the antipode and the cut-over):
+//   short range  distance < 0.0002 %, bearing < 0.1° (the straight line runs at the mid-latitude
+//                heading, the great circle starts off by up to Δλ·sin φ / 2)
+//   haversine    distance < 0.2 m up to 400 km, < 0.00005 % beyond; bearing < 0.002° from 10 m
+//                out to 10 km short of the antipode (closer, every bearing is nearly right)
+// Both hold at the poles and the antipode only because cos φ and cos(Δλ/2) come from the exact
+// integer complement there, and 1 − a is computed rather than subtracted. Rounding the inputs to
+// 1e-6° adds up to 0.1 m. The sphere itself is off by up to 0.5 % against WGS84 — the same as
+// TinyGPS++.
+
+#define GEO_EARTH_R_M           6372795.0f      // TinyGPS++ sphere
+#define GEO_M_PER_E6            0.11122626f     // Metres per 1e-6 degree of latitude on that sphere
+#define GEO_EQR_MAX_E6          200000          // 0.2° (~22 km) — equirectangular below this
+#define GEO_EQR_MAX_LAT_E6      80000000        // Haversine near the poles
+
+inline int32_t geoE6(double deg) {
+    return (int32_t)lround(deg * 1e6);
+}
+
+// Metres per 1e-6 degree of longitude at lat_e6
+float geoLonScale(int32_t lat_e6);
+
+// Great-circle distance in metres
+float geoDistanceE6(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2);
+// Initial bearing from point 1 to point 2, degrees 0..360 (north = 0, east = 90)
+float geoBearingE6(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2);
+
+inline float geoDistance(double lat1, double lon1, double lat2, double lon2) {
+    return geoDistanceE6(geoE6(lat1), geoE6(lon1), geoE6(lat2), geoE6(lon2));
+}
+
+// ── Local frame around our own position ──
+void geoSetOrigin(double lat, double lon);
+bool geoOriginValid();
+// Metres east / north of the origin (equirectangular — keep it to the short range)
+void geoToEnu(int32_t lat_e6, int32_t lon_e6, float* east, float* north);
+float geoFromOriginDistanceE6(int32_t lat_e6, int32_t lon_e6);
+float geoFromOriginBearing(double lat, double lon);
+
+inline float geoFromOriginDistance(double lat, double lon) {
+    return geoFromOriginDistanceE6(geoE6(lat), geoE6(lon));
+}
+
+// Times TinyGPSPlus::distanceBetween against geoDistance / geoFromOriginDistance over the same
+// pairs. "OK{GEOBENCH:n=..,tinygps_us=..,geo_us=..,origin_us=..,max_err_cm=..}"
+int geoBenchmark(char* out, size_t out_len);
+
+#endif
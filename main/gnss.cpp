@@ -0,0 +1,412 @@
+// gnss.cpp — $PCAS configuration, RMC / GGA parser, standby duty cycle
+
+#include "gnss.h"
+#include "utilities.h"
+#include "geodesy.h"
+#include "epoch_clock.h"
+
+enum : uint8_t { P_IDLE, P_ADDR, P_FIELD, P_CS_HI, P_CS_LO };
+enum : uint8_t { S_OTHER, S_RMC, S_GGA };
+
+#define FRAC_MAX    7       // Fraction digits kept; the L76K sends at most 5
+
+static GnssFix s_fix;
+
+// Parser — one field at a time, folded into numbers as the characters arrive
+static struct {
+    uint8_t  state;
+    uint8_t  cs;            // XOR of everything between '$' and '*'
+    uint8_t  cs_rx;
+    uint8_t  type;          // S_*
+    uint8_t  field;         // 0 = address
+    char     addr[5];       // Last characters of the address, "GNRMC" → "RMC" at [2..4]
+    uint8_t  len;           // Characters in the current field
+    uint32_t ival;          // Digits before '.'
+    uint32_t frac;          // ... and after, fdig of them
+    uint8_t  fdig;
+    bool     dot, neg;
+    char     c0;            // First character — status, hemisphere
+} s_p;
+
+// The sentence being parsed; committed to s_fix when the checksum matches
+static struct {
+    int32_t  lat_e7, lon_e7;
+    float    alt_m, speed_mps, course_deg;
+    uint16_t hdop_x100;
+    uint8_t  sats;
+    uint32_t date, time;
+    uint32_t pps;           // PPS edge the sentence follows (gnssPoll)
+    uint16_t have;          // GNSS_F_* fields present
+    bool     fix;           // RMC status A / GGA quality > 0
+} s_pend;
+
+static uint16_t s_fix_ms = GNSS_FIX_MS_DEFAULT;
+static uint8_t  s_cfg_tries = 0;
+static uint32_t s_cfg_ms = 0;
+static bool     s_cfg_due = false;
+
+static struct {
+    GnssPower state;
+    bool      enabled;
+    uint8_t   still;        // Consecutive fixes standing still
+    int32_t   ref_lat_e7, ref_lon_e7;
+    uint32_t  since;        // millis() the state was entered
+    uint32_t  seen_fixes;
+} s_psm = { GNSS_AWAKE, true, 0, 0, 0, 0, 0 };
+
+// Stats
+static uint32_t s_bytes = 0;
+static uint32_t s_rmc = 0;
+static uint32_t s_gga = 0;
+static uint32_t s_fixes = 0;            // RMC with status A
+static uint32_t s_skipped = 0;
+static uint32_t s_bad_cs = 0;
+static uint32_t s_overruns = 0;         // Polls that found the UART ring full
+static uint32_t s_cfg_sent = 0;
+static uint32_t s_sleeps = 0;
+static uint32_t s_asleep_ms = 0;
+static uint32_t s_parse_us = 0;
+
+static const uint32_t s_pow10[FRAC_MAX + 1] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
+
+// ── Field values ──
+
+// ival.frac scaled by 10^digits, fraction truncated
+static uint32_t fieldScaled(uint8_t digits) {
+    uint32_t f = s_p.fdig >= digits ? s_p.frac / s_pow10[s_p.fdig - digits] : s_p.frac * s_pow10[digits - s_p.fdig];
+    return s_p.ival * s_pow10[digits] + f;
+}
+
+static float fieldFloat() {
+    float v = s_p.ival + (float)s_p.frac / s_pow10[s_p.fdig];
+    return s_p.neg ? -v : v;
+}
+
+// (d)ddmm.mmmmm → degrees × 1e7
+static int32_t fieldCoordE7() {
+    uint32_t deg = s_p.ival / 100;
+    uint64_t min_e7 = (uint64_t)(s_p.ival % 100) * 10000000 + (uint64_t)s_p.frac * s_pow10[FRAC_MAX - s_p.fdig];
+    return (int32_t)(deg * 10000000 + (min_e7 + 30) / 60);
+}
+
+static void fieldDone() {
+    if (s_p.len == 0) return;   // Empty — leaves the field out of the sentence
+    if (s_p.type == S_RMC) {
+        switch (s_p.field) {
+            case 1: s_pend.time = fieldScaled(2); s_pend.have |= GNSS_F_TIME; break;
+            case 2: s_pend.fix = s_p.c0 == 'A'; break;
+            case 3: s_pend.lat_e7 = fieldCoordE7(); s_pend.have |= GNSS_F_LOC; break;
+            case 4: if (s_p.c0 == 'S') s_pend.lat_e7 = -s_pend.lat_e7; break;
+            case 5: s_pend.lon_e7 = fieldCoordE7(); break;
+            case 6: if (s_p.c0 == 'W') s_pend.lon_e7 = -s_pend.lon_e7; break;
+            case 7: s_pend.speed_mps = fieldFloat() * 0.514444f; s_pend.have |= GNSS_F_SPEED; break;
+            case 8: s_pend.course_deg = fieldFloat(); s_pend.have |= GNSS_F_COURSE; break;
+            case 9: s_pend.date = s_p.ival; s_pend.have |= GNSS_F_DATE; break;
+        }
+    } else {
+        switch (s_p.field) {
+            case 1: s_pend.time = fieldScaled(2); s_pend.have |= GNSS_F_TIME; break;
+            case 2: s_pend.lat_e7 = fieldCoordE7(); s_pend.have |= GNSS_F_LOC; break;
+            case 3: if (s_p.c0 == 'S') s_pend.lat_e7 = -s_pend.lat_e7; break;
+            case 4: s_pend.lon_e7 = fieldCoordE7(); break;
+            case 5: if (s_p.c0 == 'W') s_pend.lon_e7 = -s_pend.lon_e7; break;
+            case 6: s_pend.fix = s_p.ival > 0; break;
+            case 7: s_pend.sats = s_p.ival; s_pend.have |= GNSS_F_SATS; break;
+            case 8: s_pend.hdop_x100 = fieldScaled(2); s_pend.have |= GNSS_F_HDOP; break;
+            case 9: s_pend.alt_m = fieldFloat(); s_pend.have |= GNSS_F_ALT; break;
+        }
+    }
+}
+
+// Same split as TinyGPS++: time / date (and GGA's satellites / HDOP) always, the rest with a fix
+static void commit(uint32_t now) {
+    uint16_t mask = GNSS_F_TIME | GNSS_F_DATE | GNSS_F_SATS | GNSS_F_HDOP;
+    if (s_pend.fix) mask |= GNSS_F_LOC | GNSS_F_ALT | GNSS_F_SPEED | GNSS_F_COURSE;
+    uint16_t c = s_pend.have & mask;
+    if (c & GNSS_F_TIME) {
+        // Only the sentence of the whole second starts at its edge; at 5 Hz the .80 one may
+        // arrive after the next. RMC and GGA of a second share the edge either of them got.
+        uint32_t pps = s_pend.time % 100 == 0 ? s_pend.pps : 0;
+        if (pps != 0 || s_pend.time != s_fix.time) s_fix.time_pps = pps;
+        s_fix.time = s_pend.time;
+        s_fix.time_ms = now;
+    }
+    if (c & GNSS_F_DATE) s_fix.date = s_pend.date;
+    if (c & GNSS_F_SATS) s_fix.sats = s_pend.sats;
+    if (c & GNSS_F_HDOP) s_fix.hdop_x100 = s_pend.hdop_x100;
+    if (c & GNSS_F_ALT) s_fix.alt_m = s_pend.alt_m;
+    if (c & GNSS_F_SPEED) s_fix.speed_mps = s_pend.speed_mps;
+    if (c & GNSS_F_COURSE) s_fix.course_deg = s_pend.course_deg;
+    if (c & GNSS_F_LOC) {
+        s_fix.lat_e7 = s_pend.lat_e7;
+        s_fix.lon_e7 = s_pend.lon_e7;
+        s_fix.loc_ms = now;
+    }
+    s_fix.valid |= c;
+    s_fix.updated |= c;
+    if (s_p.type == S_RMC) {
+        s_rmc++;
+        if (s_pend.fix) s_fixes++;
+    } else {
+        s_gga++;
+    }
+}
+
+static uint8_t hexVal(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return 0xFF;
+}
+
+static void parseByte(uint8_t c, uint32_t now) {
+    if (c == '$') {
+        memset(&s_p, 0, sizeof(s_p));
+        memset(&s_pend, 0, sizeof(s_pend));
+        s_p.state = P_ADDR;
+        return;
+    }
+    switch (s_p.state) {
+        case P_IDLE:
+            return;
+
+        case P_ADDR:
+            if (c == ',') {
+                if (s_p.len == 5 && memcmp(&s_p.addr[2], "RMC", 3) == 0) s_p.type = S_RMC;
+                else if (s_p.len == 5 && memcmp(&s_p.addr[2], "GGA", 3) == 0) s_p.type = S_GGA;
+                else {
+                    // Not ours — ignore the rest. The first one after reset means the receiver is up;
+                    // one still coming after $PCAS03 means it was lost.
+                    s_skipped++;
+                    if (s_cfg_tries == 0 ||
+                        (s_cfg_tries < GNSS_CFG_TRIES && now - s_cfg_ms >= GNSS_CFG_RETRY_MS)) {
+                        s_cfg_due = true;
+                    }
+                    s_p.state = P_IDLE;
+                    return;
+                }
+                s_p.cs ^= c;
+                s_p.field = 1;
+                s_p.len = 0;
+                s_p.state = P_FIELD;
+            } else if (s_p.len < 5) {
+                s_p.cs ^= c;
+                s_p.addr[s_p.len++] = c;
+            } else {
+                s_p.state = P_IDLE;     // Too long for an address
+            }
+            return;
+
+        case P_FIELD:
+            if (c == ',' || c == '*') {
+                fieldDone();
+                s_p.field++;
+                s_p.len = 0;
+                s_p.ival = s_p.frac = 0;
+                s_p.fdig = 0;
+                s_p.dot = s_p.neg = false;
+                if (c == '*') {
+                    s_p.state = P_CS_HI;
+                    return;
+                }
+                s_p.cs ^= c;
+                return;
+            }
+            if (c < 0x20 || c > 0x7E) {
+                s_p.state = P_IDLE;     // Line noise or a truncated sentence
+                return;
+            }
+            s_p.cs ^= c;
+            if (s_p.len++ == 0) s_p.c0 = c;
+            if (c >= '0' && c <= '9') {
+                if (!s_p.dot) s_p.ival = s_p.ival * 10 + (c - '0');
+                else if (s_p.fdig < FRAC_MAX) {
+                    s_p.frac = s_p.frac * 10 + (c - '0');
+                    s_p.fdig++;
+                }
+            } else if (c == '.') {
+                s_p.dot = true;
+            } else if (c == '-') {
+                s_p.neg = true;
+            }
+            return;
+
+        case P_CS_HI:
+            s_p.cs_rx = hexVal(c) << 4;
+            s_p.state = P_CS_LO;
+            return;
+
+        case P_CS_LO:
+            s_p.cs_rx |= hexVal(c);
+            if (s_p.cs_rx == s_p.cs) {
+                if (s_cfg_tries == 0) s_cfg_due = true;
+                commit(now);
+            } else {
+                s_bad_cs++;
+            }
+            s_p.state = P_IDLE;
+            return;
+    }
+}
+
+void gnssFeed(const uint8_t* p, size_t n, uint32_t now) {
+    s_bytes += n;
+    while (n--) parseByte(*p++, now);
+}
+
+// ── Receiver configuration ──
+
+static void sendPcas(const char* body) {
+    uint8_t cs = 0;
+    for (const char* q = body; *q; q++) cs ^= (uint8_t)*q;
+    char line[48];
+    int n = snprintf(line, sizeof(line), "$%s*%02X\r\n", body, cs);
+    SerialGPS.write((const uint8_t*)line, n);
+}
+
+static void sendConfig(uint32_t now) {
+    // GGA, GLL, GSA, GSV, RMC, VTG, ZDA, ANT, DHV, LPS, -, -, UTC, GST
+    sendPcas("PCAS03,1,0,0,0,1,0,0,0,0,0,,,0,0");
+    char body[16];
+    snprintf(body, sizeof(body), "PCAS02,%u", s_fix_ms);
+    sendPcas(body);
+    s_cfg_tries++;
+    s_cfg_ms = now;
+    s_cfg_sent++;
+    s_cfg_due = false;
+}
+
+// ── Standby ──
+
+static bool standingStill() {
+    return (s_fix.valid & (GNSS_F_SPEED | GNSS_F_HDOP)) == (GNSS_F_SPEED | GNSS_F_HDOP) &&
+           s_fix.speed_mps < GNSS_PSM_STILL_MPS && s_fix.hdop_x100 <= GNSS_PSM_HDOP_X100 &&
+           s_fix.sats >= GNSS_PSM_MIN_SATS;
+}
+
+static bool nearRef() {
+    return geoDistanceE6(s_psm.ref_lat_e7 / 10, s_psm.ref_lon_e7 / 10, s_fix.lat_e7 / 10, s_fix.lon_e7 / 10) <
+           GNSS_PSM_MOVE_M;
+}
+
+static void wake(uint32_t now) {
+    digitalWrite(Gps_Wakeup_Pin, HIGH);
+    s_asleep_ms += now - s_psm.since;
+    s_psm.state = GNSS_WAKING;
+    s_psm.since = now;
+}
+
+static void powerTick(uint32_t now) {
+    bool fresh = s_fixes != s_psm.seen_fixes;
+    s_psm.seen_fixes = s_fixes;
+
+    switch (s_psm.state) {
+        case GNSS_STANDBY:
+            if (now - s_psm.since >= GNSS_PSM_SLEEP_MS) wake(now);
+            return;
+
+        case GNSS_WAKING:
+            if (!fresh) {
+                if (now - s_psm.since >= GNSS_PSM_WAKE_MAX_MS) {
+                    s_psm.state = GNSS_AWAKE;
+                    s_psm.still = 0;
+                }
+                return;
+            }
+            // Hot fix — a few more at the same place and back to standby
+            s_psm.state = GNSS_AWAKE;
+            s_psm.still = standingStill() && nearRef() ? GNSS_PSM_STABLE_FIXES - GNSS_PSM_RECHECK_FIXES : 0;
+            break;
+
+        case GNSS_AWAKE:
+            if (!fresh) return;
+            break;
+    }
+
+    if (!standingStill()) {
+        s_psm.still = 0;
+        return;
+    }
+    if (s_psm.still > 0 && !nearRef()) s_psm.still = 0;    // Crept away at walking pace
+    if (s_psm.still == 0) {
+        s_psm.ref_lat_e7 = s_fix.lat_e7;
+        s_psm.ref_lon_e7 = s_fix.lon_e7;
+    }
+    if (++s_psm.still >= GNSS_PSM_STABLE_FIXES && s_psm.enabled) {
+        digitalWrite(Gps_Wakeup_Pin, LOW);
+        s_psm.state = GNSS_STANDBY;
+        s_psm.since = now;
+        s_sleeps++;
+    }
+}
+
+// ── API ──
+
+void gnssBegin(uint16_t fix_ms) {
+    s_fix_ms = fix_ms;
+    s_cfg_tries = 0;
+    s_cfg_due = false;
+    memset(&s_p, 0, sizeof(s_p));
+    SerialGPS.begin(GNSS_BAUD);
+}
+
+void gnssPoll(uint32_t now) {
+    uint32_t t0 = micros();
+    // A full ring dropped what came after its last byte, so the sentence open there is cut — its
+    // checksum would catch all but 1 in 256 of those
+    int full = SerialGPS.available();
+    if (full >= SERIAL_BUFFER_SIZE - 1) s_overruns++;
+    else full = 0;
+    int c;
+    while ((c = SerialGPS.read()) >= 0) {
+        s_bytes++;
+        parseByte((uint8_t)c, now);
+        if (c == '$') s_pend.pps = SerialGPS.available() < GNSS_PPS_FRESH_BYTES ? clockPpsEdge(now) : 0;
+        if (full && --full == 0) s_p.state = P_IDLE;
+    }
+    s_parse_us += micros() - t0;
+
+    if (s_cfg_due) sendConfig(now);
+    powerTick(now);
+}
+
+const GnssFix& gnssFix() {
+    return s_fix;
+}
+
+void gnssClear(uint16_t mask) {
+    s_fix.updated &= ~mask;
+}
+
+uint32_t gnssBytes() {
+    return s_bytes;
+}
+
+GnssPower gnssPower() {
+    return s_psm.state;
+}
+
+bool gnssConfigure(uint16_t fix_ms, int8_t psm) {
+    if (fix_ms != 0 && (fix_ms < GNSS_FIX_MS_MIN || fix_ms > GNSS_FIX_MS_MAX)) return false;
+    if (psm >= 0) {
+        s_psm.enabled = psm != 0;
+        if (!s_psm.enabled && s_psm.state == GNSS_STANDBY) wake(millis());
+    }
+    if (fix_ms != 0 && fix_ms != s_fix_ms) {
+        s_fix_ms = fix_ms;
+        if (s_psm.state == GNSS_STANDBY) wake(millis());
+        s_cfg_tries = 0;
+        s_cfg_due = true;
+    }
+    return true;
+}
+
+int gnssFormatStats(char* out, size_t out_len) {
+    uint32_t asleep = s_asleep_ms + (s_psm.state == GNSS_STANDBY ? millis() - s_psm.since : 0);
+    return snprintf(out, out_len,
+                    "OK{GNSS:fix_ms=%u,psm=%u,pwr=%u,bytes=%lu,rmc=%lu,gga=%lu,skip=%lu,bad_cs=%lu,overrun=%lu,cfg=%lu,"
+                    "sleeps=%lu,asleep_s=%lu,parse_us=%lu}",
+                    s_fix_ms, s_psm.enabled, (unsigned)s_psm.state, (unsigned long)s_bytes, (unsigned long)s_rmc,
+                    (unsigned long)s_gga, (unsigned long)s_skipped, (unsigned long)s_bad_cs, (unsigned long)s_overruns,
+                    (unsigned long)s_cfg_sent, (unsigned long)s_sleeps, (unsigned long)(asleep / 1000),
+                    (unsigned long)s_parse_us);
+}
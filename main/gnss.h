@@ -0,0 +1,106 @@
+// gnss.h — L76K front end: sentence filter, fix rate, standby duty cycle, incremental NMEA parser
+
+#ifndef GNSS_H
+#define GNSS_H
+
+#include <Arduino.h>
+
+// The receiver talks on UARTE1 (utilities.h), so bytes arrive through the core's RX interrupt into
+// its ring buffer instead of a bit-banged GPIO interrupt per byte. gnssPoll() drains that ring
+// straight into a byte-at-a-time parser: it checksums as it goes, drops any sentence other than
+// RMC / GGA after the address field, and folds each field into numbers as the digits arrive —
+// no sentence buffer, no strings. A sentence only reaches gnssFix() when its checksum matched.
+//
+// Configuration ($PCAS, CASIC NMEA extension) goes out once the receiver is heard after reset:
+//   PCAS03   RMC + GGA only (the defaults add GLL, GSA, GSV, VTG, ZDA, TXT — some 4x the bytes)
+//   PCAS02   fix interval, GNSS_FIX_MS_MIN..GNSS_FIX_MS_MAX
+// and again while sentences we turned off keep coming (GNSS_CFG_RETRY_MS, GNSS_CFG_TRIES).
+//
+// Standby: GNSS_PSM_STABLE_FIXES fixes in a row standing still with a good HDOP put the receiver
+// in standby through its WAKEUP pin for GNSS_PSM_SLEEP_MS. It keeps ephemeris and time, so the
+// wake-up is a hot start; GNSS_PSM_RECHECK_FIXES good fixes at the same place send it back, a
+// move (or no fix within GNSS_PSM_WAKE_MAX_MS) keeps it running.
+
+#define GNSS_BAUD               9600
+#define GNSS_FIX_MS_DEFAULT     1000
+#define GNSS_FIX_MS_MIN         200         // RMC + GGA at 5 Hz is ~750 B/s of the 960 at 9600 Bd
+#define GNSS_FIX_MS_MAX         10000
+#define GNSS_CFG_RETRY_MS       3000
+#define GNSS_CFG_TRIES          3
+// A '$' read with fewer bytes behind it in the UART ring arrived within ~25 ms (9600 Bd) — the
+// sentence was still coming in, so the latest PPS edge is the one it follows. With more behind it
+// the loop was held up and the sentence is not paired with an edge.
+#define GNSS_PPS_FRESH_BYTES    24
+
+#define GNSS_PSM_STABLE_FIXES   30
+#define GNSS_PSM_RECHECK_FIXES  5           // Also lets the PPS pairing (epoch_clock.h) catch up
+#define GNSS_PSM_STILL_MPS      0.8f
+#define GNSS_PSM_HDOP_X100      200
+#define GNSS_PSM_MIN_SATS       6
+#define GNSS_PSM_MOVE_M         25.0f
+#define GNSS_PSM_SLEEP_MS       60000
+#define GNSS_PSM_WAKE_MAX_MS    30000
+
+// GnssFix::valid / updated
+#define GNSS_F_TIME             (1 << 0)
+#define GNSS_F_DATE             (1 << 1)
+#define GNSS_F_LOC              (1 << 2)
+#define GNSS_F_ALT              (1 << 3)
+#define GNSS_F_SPEED            (1 << 4)
+#define GNSS_F_COURSE           (1 << 5)
+#define GNSS_F_SATS             (1 << 6)
+#define GNSS_F_HDOP             (1 << 7)
+
+// Committed per sentence the way TinyGPS++ did: time / date always, the rest only with a fix
+struct GnssFix {
+    int32_t  lat_e7, lon_e7;
+    float    alt_m;
+    float    speed_mps;
+    float    course_deg;
+    uint16_t hdop_x100;
+    uint8_t  sats;
+    uint32_t date;          // ddmmyy
+    uint32_t time;          // hhmmsscc
+    uint32_t time_ms;       // millis() of the last time
+    uint32_t time_pps;      // clockPpsEdge() as its sentence began; 0 = none, late or a fractional second
+    uint32_t loc_ms;        // ... and location
+    uint16_t valid;         // GNSS_F_*
+    uint16_t updated;       // GNSS_F_*, until gnssClear()
+};
+
+enum GnssPower : uint8_t {
+    GNSS_AWAKE = 0,
+    GNSS_STANDBY,
+    GNSS_WAKING             // Out of standby, waiting for the first fix
+};
+
+// setupGPS() — after the reset pulse
+void gnssBegin(uint16_t fix_ms);
+// loopGPS() — drain the UART, run the standby state machine
+void gnssPoll(uint32_t now);
+// Parser only, for replays (tests/host/gnss_replay_test.cpp) — now is the millis() recorded with a location
+void gnssFeed(const uint8_t* p, size_t n, uint32_t now);
+
+const GnssFix& gnssFix();
+void gnssClear(uint16_t mask);
+inline bool gnssUpdated(uint16_t mask) {
+    return (gnssFix().updated & mask) == mask;
+}
+inline double gnssLat() {
+    return gnssFix().lat_e7 * 1e-7;
+}
+inline double gnssLon() {
+    return gnssFix().lon_e7 * 1e-7;
+}
+// Bytes seen since boot
+uint32_t gnssBytes();
+GnssPower gnssPower();
+
+// fix_ms 0 = leave; psm 0 / 1, -1 = leave. Returns false for a fix_ms out of range.
+bool gnssConfigure(uint16_t fix_ms, int8_t psm);
+
+// "OK{GNSS:fix_ms=..,psm=..,pwr=..,bytes=..,rmc=..,gga=..,skip=..,bad_cs=..,overrun=..,cfg=..,
+//  sleeps=..,asleep_s=..,parse_us=..}"
+int gnssFormatStats(char* out, size_t out_len);
+
+#endif
@@ -1,11 +1,13 @@
-#include <TinyGPS++.h>
 #include "utilities.h"  // Include pin definitions here
 #include "settings.h"   // Include for 'time_set' and 'rtc' definitions
 #include "gps.h"
 #include "display.h"
+#include "disp_timer.h"
 #include "app_modes.h"
-
-TinyGPSPlus     *gps;
+#include "track_log.h"
+#include "geodesy.h"
+#include "epoch_clock.h"
+#include "gnss.h"
 
 uint32_t lastGPSUpdate;
 GPSStatus gps_status = NO_GPS;  // Initialize the GPS status
@@ -30,11 +32,12 @@ extern bool time_set;  // Ensure 'time_set' is declared in settings.h
 //extern PCF8563_Class rtc;  // RTC instance from your RTC code
 
 bool setupGPS() {
-    SerialGPS.begin(9600);
+    gnssBegin(GNSS_FIX_MS_DEFAULT);
     delay(10);
     while (Serial.available()) Serial.read();
 
     pinMode(Gps_pps_Pin, INPUT);
+    clockAttachPps(Gps_pps_Pin);
     pinMode(Gps_Wakeup_Pin, OUTPUT);
     digitalWrite(Gps_Wakeup_Pin, HIGH);
 
@@ -45,7 +48,6 @@ bool setupGPS() {
     digitalWrite(Gps_Reset_Pin, HIGH);
 
     gps_status = GPS_INIT;  // GPS module has been initialized
-    gps = new TinyGPSPlus();  // Create a new instance of TinyGPSPlus
 
     while (Serial.available()) Serial.read();
     
@@ -53,13 +55,12 @@ bool setupGPS() {
 }
 
 void loopGPS() {
-    while (SerialGPS.available() > 0) {
-        gps->encode(SerialGPS.read());
-    }
+    gnssPoll(millis());
+    const GnssFix& fix = gnssFix();
 
     // Error check for insufficient GPS data
     static int noDataCount = 0;
-    if (gps->charsProcessed() < 10) {
+    if (gnssBytes() < 10) {
         noDataCount++;
         gps_status = GPS_ERROR;  // Set status to GPS_ERROR
         return;  // Exit the function to avoid further processing
@@ -68,115 +69,113 @@ void loopGPS() {
         noDataCount = 0;
     }
 
-    // Only attempt to update RTC if GPS time has been updated and not already synced
-    if (gps_satellites >= 5 && gps->time.isUpdated() && gps->date.isUpdated() && digitalRead(Gps_pps_Pin) == HIGH) {
-        // Get the GPS time and date
-        int gpsHour = gps->time.hour();
-        int gpsMinute = gps->time.minute();
-        int gpsSecond = gps->time.second();
-        int gpsYear = gps->date.year();
-        int gpsMonth = gps->date.month();
-        int gpsDay = gps->date.day();
-        //Only correct it when it's off
-
-        RTC_Date currentTime = rtc.getDateTime();  // Get the current time from RTC
-
-        if(currentTime.second != gpsSecond) {
-            //Update time if we are longer then a minute out of synch
-            rtc.setDateTime(gpsYear, gpsMonth, gpsDay, gpsHour, gpsMinute, gpsSecond);
-            time_set = true;
-        }
+    // GPS time disciplines the epoch clock — paired with the PPS edge there, no I2C here
+    if (gps_satellites >= 5 && gnssUpdated(GNSS_F_TIME | GNSS_F_DATE)) {
+        gnssClear(GNSS_F_TIME | GNSS_F_DATE);
+        clockGpsTime(clockFromCivil(2000 + fix.date % 100, (fix.date / 100) % 100, fix.date / 10000,
+                                    fix.time / 1000000, (fix.time / 10000) % 100, (fix.time / 100) % 100),
+                     fix.time_pps);
+        time_set = true;
         if(gps_status==GPS_INIT) {
             gps_status = GPS_TIME;  // Set status to GPS_TIME since we found the time
         }
     }
 
     if (millis() - lastGPSUpdate > 5000) {
-        if (gps->altitude.isUpdated()) {
-            gps_altitude = gps->altitude.meters();
+        uint32_t now = millis();
+        if (gnssUpdated(GNSS_F_ALT)) {
+            gps_altitude = fix.alt_m;
         }
 
-        if (gps->satellites.isUpdated()) {
-            if(gps_satellites != gps->satellites.value() ) {
-                //Something has changed, update the display
-                printStatusIcons();
-                display->displayWindow(0,0,disp_width,disp_height);
+        if (gnssUpdated(GNSS_F_SATS)) {
+            if(gps_satellites != fix.sats ) {
+                //Something has changed, update the display — the status bar hash picks up the new count
+                deferDraw();
             }
 
-            gps_satellites = gps->satellites.value();  // Update the satellite count
+            gps_satellites = fix.sats;  // Update the satellite count
         }
 
-        if (gps->date.isUpdated()) {
-            gps_date_age = gps->date.age();
-            gps_date_value = gps->date.value();
+        // The clock pairing above takes the update flags for date / time, so these just follow
+        if (fix.valid & GNSS_F_DATE) {
+            gps_date_age = now - fix.time_ms;
+            gps_date_value = fix.date;
         }
 
-        if (gps->time.isUpdated()) {
-            gps_time_age = gps->time.age();
-            gps_time_value = gps->time.value();
+        if (fix.valid & GNSS_F_TIME) {
+            gps_time_age = now - fix.time_ms;
+            gps_time_value = fix.time;
         }
 
-        if (gps->speed.isUpdated()) {
-            gps_speed_kmph = gps->speed.kmph();
-            gps_speed_mps = gps->speed.mps();
+        if (gnssUpdated(GNSS_F_SPEED)) {
+            gps_speed_mps = fix.speed_mps;
+            gps_speed_kmph = fix.speed_mps * 3.6f;
         }
 
-        if (gps->course.isUpdated()) {
-            gps_course = gps->course.deg();
+        if (gnssUpdated(GNSS_F_COURSE)) {
+            gps_course = fix.course_deg;
         }
 
-        if (gps->hdop.isUpdated()) {
-            gps_hdop = gps->hdop.value();
+        if (gnssUpdated(GNSS_F_HDOP)) {
+            gps_hdop = fix.hdop_x100;
         }
 
-        if (gps->location.isUpdated()) {
-            if(gps->location.isValid()) {
-                if (gps->satellites.value() >= 4) {
-                    // Location is more stable
-                    if (gps->hdop.isValid() && gps->hdop.value() <= 100.0) {
-                        // HDOP is within a good range, likely stable
-                        if (gps->location.age() < 4000) {
-                            // The fix is recent, likely stable
-                            gps_latitude = gps->location.lat();
-                            gps_longitude = gps->location.lng();
-                            gps_location_age = gps->location.age();
-                            gps_status = GPS_LOC;  // GPS location found, update status
-                        }
-                        else {
-                            //Location is too old
-                            gps_status=GPS_TIME;
-                            sendSerialToAppLn("[GPS] Loc age too high " + String(gps->location.age()));
-                        }
-                    } else {
-                        // HDOP is too high, position might be unstable
+        if (gnssUpdated(GNSS_F_LOC)) {
+            uint32_t loc_age = now - fix.loc_ms;
+            if (fix.sats >= 4) {
+                // Location is more stable
+                if ((fix.valid & GNSS_F_HDOP) && fix.hdop_x100 <= 100) {
+                    // HDOP is within a good range, likely stable
+                    if (loc_age < 4000) {
+                        // The fix is recent, likely stable
+                        gps_latitude = gnssLat();
+                        gps_longitude = gnssLon();
+                        gps_location_age = loc_age;
+                        gps_status = GPS_LOC;  // GPS location found, update status
+                        geoSetOrigin(gps_latitude, gps_longitude);
+                        trackOffer(gps_latitude, gps_longitude, gps_altitude, gps_speed_mps, gps_course,
+                                   gps_date_value, gps_time_value);
+                    }
+                    else {
+                        //Location is too old
                         gps_status=GPS_TIME;
-                        sendSerialToAppLn("[GPS] Loc hdop too low " + String(gps->hdop.value()));
-
-                        //Still store it, in case someone still wants to use it.
-                        gps_latitude = gps->location.lat();
-                        gps_longitude = gps->location.lng();
-                        gps_location_age = gps->location.age();
-
-
+                        sendSerialToAppLn("[GPS] Loc age too high " + String(loc_age));
                     }
                 } else {
-                    // Location might not be stable
+                    // HDOP is too high, position might be unstable
                     gps_status=GPS_TIME;
-                    /*SerialMon.print("GPS Loc sattelites too low ");
-                    */
+                    sendSerialToAppLn("[GPS] Loc hdop too low " + String(fix.hdop_x100));
+
+                    //Still store it, in case someone still wants to use it.
+                    gps_latitude = gnssLat();
+                    gps_longitude = gnssLon();
+                    gps_location_age = loc_age;
+
 
                 }
+            } else {
+                // Location might not be stable
+                gps_status=GPS_TIME;
+                /*SerialMon.print("GPS Loc sattelites too low ");
+                */
 
             }
-            else {
-              gps_status=GPS_TIME;
-              sendSerialToAppLn("[GPS] Location invalid");
-              sendSerialToAppLn("[GPS] Location invalid");
-            }
 
         }
+        gnssClear(GNSS_F_ALT | GNSS_F_SATS | GNSS_F_SPEED | GNSS_F_COURSE | GNSS_F_HDOP | GNSS_F_LOC);
         printGPSIcon();
         lastGPSUpdate = millis();
     }
 }
 
+size_t gpsPackPosition(uint8_t flags, bool allow_delta, int8_t battery, char* out, size_t out_len) {
+    PosFix f;
+    f.lat = gps_latitude;
+    f.lon = gps_longitude;
+    f.alt_m = gps_altitude;
+    f.speed_mps = gps_speed_mps;
+    f.course_deg = gps_course;
+    f.battery = battery;
+    f.flags = flags;
+    return posEncode(f, allow_delta, millis(), out, out_len);
+}
@@ -1,7 +1,8 @@
 #ifndef GPS_H
 #define GPS_H
 
-#include <TinyGPS++.h>
+#include <Arduino.h>
+#include "pos_codec.h"
 
 // Enum to represent GPS status
 enum GPSStatus {
@@ -32,4 +33,7 @@ extern float gps_hdop;
 bool setupGPS();
 void loopGPS();
 
+// Our fix as a ~PP value (pos_codec.h) — flags POS_F_ALT / MOTION / HIRES, battery -1 = leave out
+size_t gpsPackPosition(uint8_t flags, bool allow_delta, int8_t battery, char* out, size_t out_len);
+
 #endif
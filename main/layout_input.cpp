@@ -0,0 +1,142 @@
+// layout_input.cpp — Copies the firmware state each layout draws from into layout_state
+
+#include "display_layout.h"
+#include "app_modes.h"
+#include "battery.h"
+#include "gps.h"
+#include "settings.h"
+#include "lora.h"
+#include "text_inbox.h"
+#include "scan.h"
+#include "peer_roster.h"
+#include "epoch_clock.h"
+
+// Inbox rows keep what a row can show: a longer message already wraps over the rows below it
+#define LI_ROW_LEN      64
+
+static char s_preview[60];
+static char s_rows[LAYOUT_INBOX_ROWS][LI_ROW_LEN];
+static uint32_t s_rows_rev = 0;
+static uint16_t s_rows_count = 0xFFFF;
+static uint16_t s_rows_page = 0xFFFF;
+static uint32_t s_preview_rev = 0;
+static uint16_t s_preview_count = 0xFFFF;
+static uint32_t s_roster_rev = 0;
+static bool s_roster_valid = false;
+
+void initLayoutState() {
+    memset(&layout_state, 0, sizeof(layout_state));
+    layout_state.mode = current_mode;
+}
+
+static void captureBeacon(LayoutState& S) {
+    S.beacon_best_dist = beacon_display_dist;
+    snprintf(S.beacon_best_name, sizeof(S.beacon_best_name), "%s", beacon_display_name.c_str());
+
+    // Distances move every roster tick; the revision bumps only when a shown value would
+    uint32_t rev = rosterRevision();
+    if (s_roster_valid && rev == s_roster_rev) return;
+    s_roster_valid = true;
+    s_roster_rev = rev;
+    S.peer_count = rosterCount();
+    for (uint8_t i = 0; i < LAYOUT_PEER_ROWS; i++) {
+        LayoutState::Peer& out = S.peers[i];
+        if (i >= S.peer_count) {
+            memset(&out, 0, sizeof(out));
+            continue;
+        }
+        const RosterPeer* p = rosterNearest(i);
+        snprintf(out.name, sizeof(out.name), "%s", rosterName(p));
+        out.dist_m = (p->flags & ROSTER_F_DIST) ? p->distanceM : 0;
+        out.batt = p->battery;
+    }
+}
+
+static void captureRange(LayoutState& S) {
+    S.range_sender = range_role_sender;
+    S.gps_fix = gps_status == GPS_LOC;
+    S.gps_hdop = gps_hdop;
+    S.gps_lat = gps_latitude;
+    S.gps_lon = gps_longitude;
+    S.range_stable_m = range_stable_dist;
+    S.range_max_m = range_max_dist;
+    S.range_loss = range_total_pckt_loss;
+    S.range_ok = range_consecutive_ok;
+}
+
+// The log only appends or clears, so a row is re-read from flash only when count, revision
+// or page moved
+static void captureTxt(LayoutState& S, bool rows) {
+    S.txt_unread = txtInboxMsgCount;
+    S.txt_page = txtInboxScrollPage;
+    S.peer_alive = isPeerAlive();
+    S.inbox_count = inboxCount();
+    S.inbox_rev = inboxRevision();
+
+    if (S.inbox_count != s_preview_count || S.inbox_rev != s_preview_rev) {
+        s_preview_count = S.inbox_count;
+        s_preview_rev = S.inbox_rev;
+        s_preview[0] = '\0';
+        if (S.inbox_count > 0) inboxGetMessage(S.inbox_count - 1, s_preview, sizeof(s_preview));
+    }
+    S.txt_preview = s_preview;
+
+    if (!rows) return;
+    uint16_t msg_count = S.txt_unread > 0 ? S.txt_unread : S.inbox_count;
+    if (msg_count != s_rows_count || S.inbox_rev != s_rows_rev || S.txt_page != s_rows_page) {
+        s_rows_count = msg_count;
+        s_rows_rev = S.inbox_rev;
+        s_rows_page = S.txt_page;
+        for (uint8_t r = 0; r < LAYOUT_INBOX_ROWS; r++) {
+            int i = S.txt_page * LAYOUT_INBOX_PAGE + r;
+            s_rows[r][0] = '\0';
+            if (i < msg_count) inboxGetMessage(i, s_rows[r], sizeof(s_rows[r]));
+        }
+    }
+    for (uint8_t r = 0; r < LAYOUT_INBOX_ROWS; r++) {
+        int i = S.txt_page * LAYOUT_INBOX_PAGE + r;
+        S.inbox_rows[r] = i < msg_count ? s_rows[r] : nullptr;
+    }
+}
+
+static void captureScan(LayoutState& S) {
+    S.scan_progress_pct = scanning ? (int)((currentFrequency - startFreq) / (endFreq - startFreq) * 100) : 0;
+    if (scanning) {
+        snprintf(S.scan_current_freq, sizeof(S.scan_current_freq), "%.2f", currentFrequency);
+    } else {
+        snprintf(S.scan_current_freq, sizeof(S.scan_current_freq), "---");
+    }
+}
+
+void layoutCaptureLive(uint16_t parts) {
+    LayoutState& S = layout_state;
+
+    // Header, status bar and the settings card
+    S.mode = current_mode;
+    S.chan = channels[deviceSettings.channel_idx];
+    S.bitrate_bps = getBitrateFromIndex(deviceSettings.bitrate_idx);
+    S.settings = deviceSettings;
+    S.in_settings = in_settings_mode;
+    S.setting_idx = setting_idx;
+    S.panel_refresh = panel_refresh_enabled;
+    S.freq_mhz = currentFrequency;
+    RTC_Date dt = clockDateTime();
+    S.clock_h = dt.hour;
+    S.clock_m = dt.minute;
+    S.clock_s = dt.second;
+    S.gps_sats = gps_satellites;
+    S.batt_pct = getBatteryPercentage();
+
+    if (parts & LI_BEACON) captureBeacon(S);
+    if (parts & LI_RANGE) captureRange(S);
+    if (parts & LI_RADIO) {
+        S.radio_snr = radio ? radio->getSNR() : 0.0f;
+        S.radio_rssi = radio ? radio->getRSSI() : -127.0f;
+    }
+    if (parts & (LI_TXT | LI_INBOX)) captureTxt(S, parts & LI_INBOX);
+    if (parts & LI_TST) {
+        S.tst_sent = test_message_counter;
+        S.tst_rcvd = pckt_count;
+    }
+    if (parts & LI_SCAN) captureScan(S);
+}
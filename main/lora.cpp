@@ -13,6 +13,13 @@
 #include "gps.h"
 #include "battery.h"
 #include "buddy_list.h"
+#include "lora_capture.h"
+#include "geodesy.h"
+#include "pos_codec.h"
+#include "beacon_sched.h"
+#include "peer_roster.h"
+#include "epoch_clock.h"
+#include "mesh_relay.h"
 #include <time.h>  // For RTC time management
 #include <stdlib.h>  // For random number generation
 
@@ -92,6 +99,7 @@ unsigned long resendTime = 0;  // Non-blocking timer for post-hop retransmit del
 unsigned long lastPeerPacketTime = 0;  // Track when last packet from peer was received
 bool     peerPacketReceived = false;    // Guard against zero-boot artifact
 unsigned long lastBeaconTime = 0;      // Track when last beacon was sent
+unsigned long peerTimeoutMs = PEER_TIMEOUT;  // Follows the interval the peer advertises
 
 // Probe-based frequency hopping discovery globals
 bool inProbeMode = true;              // Start in probe mode — waiting for time sync
@@ -110,73 +118,25 @@ void setPeerAcked() {
 
 bool isPeerAlive() {
     if (!peerPacketReceived && !peerAcked) return false;  // Never report alive before first packet or ACK
-    bool received_ok = (millis() - lastPeerPacketTime < PEER_TIMEOUT);
-    bool acked_ok = peerAcked && (millis() - peerAckedTimeMs < PEER_TIMEOUT);
+    unsigned long ackTimeout = peerTimeoutMs > P2P_ACK_TIMEOUT_MS ? peerTimeoutMs : P2P_ACK_TIMEOUT_MS;
+    bool received_ok = (millis() - lastPeerPacketTime < peerTimeoutMs);
+    bool acked_ok = peerAcked && (millis() - peerAckedTimeMs < ackTimeout);
     return received_ok || acked_ok;  // Alive if either direction confirmed
 }
 
-// Peer roster globals for BEACON mode
-PeerEntry peerRoster[MAX_ROSTER_PEERS];
-int     peerRosterCount = 0;
+// BEACON mode flag (roster itself lives in peer_roster.cpp)
 bool    inBeaconMode = false;
 
 void beaconAddOrUpdate(const Packet& packet) {
     // Extract device ID from B prefix: "B{id_short}"
-    String devId = packet.beacon_deviceId;
+    const String& devId = packet.beacon_deviceId;
     if (devId.length() == 0 || devId == bleGetDeviceIdShort()) return; // Skip self
-    
-    unsigned long now = millis();
-    
-    // Check if peer already in roster — update it
-    for (int i = 0; i < peerRosterCount; i++) {
-        if (peerRoster[i].deviceId == devId) {
-            peerRoster[i].lat     = packet.beacon_lat;
-            peerRoster[i].lon     = packet.beacon_lon;
-            peerRoster[i].battery = packet.beacon_battery;
-            strncpy(peerRoster[i].callSign, packet.beacon_callSign, 16);
-            peerRoster[i].callSign[16] = '\0';
-            if (packet.beacon_callSign[0] != '\0') {
-                buddyAddOrUpdate(devId.c_str(), packet.beacon_callSign);
-            }
-            peerRoster[i].lastSeen = now;
-            
-            // Compute distance if we have GPS fix
-            if (gps_status == GPS_LOC) {
-                peerRoster[i].distanceM = TinyGPSPlus::distanceBetween(
-                    gps_latitude, gps_longitude,
-                    packet.beacon_lat, packet.beacon_lon);
-            }
-            return;
-        }
-    }
-    
-    // Add new entry — find empty slot
-    if (peerRosterCount >= MAX_ROSTER_PEERS) {
-        // Roster full — discard oldest (lowest index is oldest)
-        peerRosterCount--;
-        for (int i = 0; i < peerRosterCount; i++) {
-            peerRoster[i] = peerRoster[i + 1];
-        }
-    }
-    
-    int slot = peerRosterCount++;
-    peerRoster[slot].deviceId  = devId;
-    strncpy(peerRoster[slot].callSign, packet.beacon_callSign, 16);
-    peerRoster[slot].callSign[16] = '\0';
+
     if (packet.beacon_callSign[0] != '\0') {
         buddyAddOrUpdate(devId.c_str(), packet.beacon_callSign);
     }
-    peerRoster[slot].lat       = packet.beacon_lat;
-    peerRoster[slot].lon       = packet.beacon_lon;
-    peerRoster[slot].battery   = packet.beacon_battery;
-    peerRoster[slot].lastSeen  = now;
-    peerRoster[slot].distanceM = 0;
-    
-    if (gps_status == GPS_LOC) {
-        peerRoster[slot].distanceM = TinyGPSPlus::distanceBetween(
-            gps_latitude, gps_longitude,
-            packet.beacon_lat, packet.beacon_lon);
-    }
+    rosterUpdate(devId.c_str(), packet.beacon_callSign, packet.has_pos ? &packet.pos : nullptr,
+                 packet.beacon_battery, bcnPeerTimeoutMs(packet.beacon_interval_s, PEER_TIMEOUT), millis());
 
     // Trigger screen sync if BEACON mode is active
     extern const char* current_mode;
@@ -186,64 +146,19 @@ void beaconAddOrUpdate(const Packet& packet) {
     }
 }
 
-void beaconDisplayRoster(uint8_t line) {
-    char buf[30];
-    unsigned long now = millis();
-    
-    // Clean stale entries (beyond PEER_TIMEOUT)
-    int activeCount = 0;
-    for (int i = 0; i < peerRosterCount; i++) {
-        if (now - peerRoster[i].lastSeen > PEER_TIMEOUT) {
-            peerRoster[i] = peerRoster[peerRosterCount - 1];
-            peerRosterCount--;
-            i--; // recheck this index
-        } else {
-            activeCount++;
-        }
-    }
-    
-    updDisp(line, "Peers:", true);
-    
-    int maxLines = (disp_height + disp_top_margin) / disp_font_height;
-    for (int i = 0; i < activeCount && (line + 1 + i) < maxLines; i++) {
-        float dist = peerRoster[i].distanceM;
-        const char* displayName = peerRoster[i].callSign[0] != '\0' ? peerRoster[i].callSign : peerRoster[i].deviceId.c_str();
-        if (dist > 0 && dist < 1000) {
-            snprintf(buf, sizeof(buf), "%s %.0fm", displayName, dist);
-        } else if (dist >= 1000) {
-            snprintf(buf, sizeof(buf), "%s %.1fkm", displayName, dist / 1000.0);
-        } else {
-            snprintf(buf, sizeof(buf), "%s ???m", displayName);
-        }
-        // Add battery indicator
-        int batt = peerRoster[i].battery;
-        if (batt > 0) {
-            strncat(buf, " ", sizeof(buf) - strlen(buf) - 1);
-            char battBuf[12];
-            snprintf(battBuf, sizeof(battBuf), "%d%%", batt);
-            strncat(buf, battBuf, sizeof(buf) - strlen(buf) - 1);
-        } else {
-            strncat(buf, " -%", sizeof(buf) - strlen(buf) - 1);
-        }
-        
-        char displayLine[5];
-        snprintf(displayLine, sizeof(displayLine), "%d", line + 1 + i);
-        // Use direct line number
-        updDisp(line + 1 + i, buf, true);
-    }
-}
-
 void sendPeerBeacon() {
     extern const char* buddyGetDisplayName();
     const char* myCallSign = buddyGetDisplayName();
     static char beacon[MAX_PACKET_SIZE];
     
     if (gps_status == GPS_LOC) {
-        int batt = getBatteryPercentage();
+        // Position, speed / course and battery in one packed ~PP field (pos_codec.h)
+        char pp[POS_FIELD_MAX + 1];
+        gpsPackPosition(POS_F_MOTION, false, (int8_t)constrain(getBatteryPercentage(), 0, 100), pp, sizeof(pp));
         if (myCallSign[0] != '\0') {
-            snprintf(beacon, sizeof(beacon), "B%s~CN%s~GP%.6f,%.6f~BT%d", bleGetDeviceIdShort(), myCallSign, gps_latitude, gps_longitude, batt);
+            snprintf(beacon, sizeof(beacon), "B%s~CN%s~PP%s", bleGetDeviceIdShort(), myCallSign, pp);
         } else {
-            snprintf(beacon, sizeof(beacon), "B%s~GP%.6f,%.6f~BT%d", bleGetDeviceIdShort(), gps_latitude, gps_longitude, batt);
+            snprintf(beacon, sizeof(beacon), "B%s~PP%s", bleGetDeviceIdShort(), pp);
         }
     } else {
         int batt = getBatteryPercentage();
@@ -253,9 +168,27 @@ void sendPeerBeacon() {
             snprintf(beacon, sizeof(beacon), "B%s~BT%d", bleGetDeviceIdShort(), batt);
         }
     }
+    // Upper bound until our next beacon — receivers time us out from it (beacon_sched.h)
+    size_t n = strlen(beacon);
+    snprintf(beacon + n, sizeof(beacon) - n, "~BI%u", bcnCommit());
     sendPacket((uint8_t*)beacon, strlen(beacon));
 }
 
+// "WPT" + "~PP<packed>,<sender>,<label>" — the label goes last so it may contain commas.
+void sendWaypointPacket(double lat, double lon, float alt, const char* label) {
+    static char wp[MAX_PACKET_SIZE];
+    PosFix f;
+    f.lat = lat;
+    f.lon = lon;
+    f.alt_m = alt;
+    f.battery = -1;
+    f.flags = POS_F_HIRES | POS_F_ALT;     // A marker, not a moving station — keep 1e-7°
+    char pp[POS_FIELD_MAX + 1];
+    posEncode(f, false, millis(), pp, sizeof(pp));
+    snprintf(wp, sizeof(wp), "WPT~PP%s,%s,%s", pp, bleGetDeviceIdShort(), label);
+    sendPacket((uint8_t*)wp, strlen(wp));
+}
+
 unsigned int messageCounter = 0;       // The counter I add to each message so that it can be tracket
 unsigned int lastReceivedCounter = 0;  // Global variable to store the last received packet counter
 uint8_t lastMessageBuffer[MAX_PACKET_SIZE];  // Fixed-size buffer for last message
@@ -332,66 +265,45 @@ bool extractSDField(const uint8_t* buffer, uint16_t bufferSize, String& outDateT
     return false;
 }
 
+// Sender's time of day minus ours, folded into ±12 h — the hop schedule only uses the time of day
+static long peerClockOffset(uint32_t peerEpoch) {
+    long diff = (long)(peerEpoch % HOP_EPOCH_SECONDS) - (long)clockSecondOfDay();
+    if (diff > (long)HOP_EPOCH_SECONDS / 2) diff -= HOP_EPOCH_SECONDS;
+    else if (diff < -(long)HOP_EPOCH_SECONDS / 2) diff += HOP_EPOCH_SECONDS;
+    return diff;
+}
+
+// Gradual convergence toward a peer's clock: up to TIME_CONVERGENCE_MAX_JUMP seconds per packet
+// beyond the tolerance, one second within it
+static void convergeToPeer(uint32_t peerEpoch) {
+    long offset = peerClockOffset(peerEpoch);
+    long jump = abs(offset) > TIME_CONVERGENCE_TOLERANCE
+              ? constrain(offset, -TIME_CONVERGENCE_MAX_JUMP, TIME_CONVERGENCE_MAX_JUMP)
+              : constrain(offset, -1, 1);
+    clockSlew(jump);
+}
+
 // Automatically sync local RTC from received packet timestamp when GPS has
-// not yet provided a fix — attempts to use the parsed sendDateTime field,
+// not yet provided a fix — attempts to use the parsed sendEpoch field,
 // falling back to raw SD field extraction if the packet type lacks it.
 void autoSyncRTCFromPacket(const Packet& packet) {
-    if (!packet.sendDateTime.length()) {
+    uint32_t peerEpoch = packet.sendEpoch;
+    if (peerEpoch == 0) {
         // Try raw extraction as fallback (for non-standard packet types)
         String sdVal;
-        if (extractSDField(packet.raw, packet.rawLength, sdVal)) {
-            adjustRTC(sdVal);
+        if (extractSDField(packet.raw, packet.rawLength, sdVal) &&
+            clockParseSD(sdVal.c_str(), sdVal.length(), &peerEpoch)) {
+            adjustRTC(peerEpoch);
         }
         return;
     }
-    
-    // Use the parsed sendDateTime field directly
-    if (packet.sendDateTime.length() != 14) return;
-    
-    long receiverTimeSeconds = 0;
-    receiverTimeSeconds = packet.sendDateTime.substring(8, 10).toInt() * 3600
-                        + packet.sendDateTime.substring(10, 12).toInt() * 60
-                        + packet.sendDateTime.substring(12, 14).toInt();
-    
-    RTC_Date rtc_time = rtc.getDateTime();
-    long localSeconds = rtc_time.hour * 3600 + rtc_time.minute * 60 + rtc_time.second;
-    long timeDiff = abs(receiverTimeSeconds - localSeconds);
-    
+
     // If we don't have GPS time yet, accept the sender's time as truth
     if (!time_set) {
-        adjustRTC(packet.sendDateTime);
-    } 
-    // If we DO have GPS time but drifting, use existing gradual convergence logic
-    else if (timeDiff > TIME_CONVERGENCE_TOLERANCE) {
-        long jump = constrain(receiverTimeSeconds - localSeconds, -TIME_CONVERGENCE_MAX_JUMP, TIME_CONVERGENCE_MAX_JUMP);
-        RTC_Date currentRtc = rtc.getDateTime();
-        long currentRtcSeconds = currentRtc.hour * 3600 + currentRtc.minute * 60 + currentRtc.second;
-        long newRtcSeconds = currentRtcSeconds + jump;
-        
-        if (newRtcSeconds < 0) {
-            newRtcSeconds += HOP_EPOCH_SECONDS;
-        } else if (newRtcSeconds >= HOP_EPOCH_SECONDS) {
-            newRtcSeconds -= HOP_EPOCH_SECONDS;
-        }
-        
-        long hours = newRtcSeconds / 3600;
-        long minutes = (newRtcSeconds % 3600) / 60;
-        long seconds = newRtcSeconds % 60;
-        
-        rtc.setDateTime(currentRtc.year, currentRtc.month, currentRtc.day, hours, minutes, seconds);
+        adjustRTC(peerEpoch);
     } else {
-        // Within tolerance — just nudge toward sender's time
-        long jump = constrain(receiverTimeSeconds - localSeconds, -1, 1);
-        if (jump != 0) {
-            RTC_Date currentRtc = rtc.getDateTime();
-            long newSeconds = currentRtc.hour * 3600 + currentRtc.minute * 60 + currentRtc.second + jump;
-            if (newSeconds < 0) newSeconds += HOP_EPOCH_SECONDS;
-            if (newSeconds >= HOP_EPOCH_SECONDS) newSeconds -= HOP_EPOCH_SECONDS;
-            long h = newSeconds / 3600;
-            long m = (newSeconds % 3600) / 60;
-            long s = newSeconds % 60;
-            rtc.setDateTime(currentRtc.year, currentRtc.month, currentRtc.day, h, m, s);
-        }
+        // If we DO have GPS time but drifting, converge gradually
+        convergeToPeer(peerEpoch);
     }
 }
 
@@ -399,7 +311,9 @@ void autoSyncRTCFromPacket(const Packet& packet) {
 void sendProbeBeacon() {
     // Include ~SD field so receiver can adopt our RTC time
     char probeBuf[120];
-    snprintf(probeBuf, sizeof(probeBuf), "PR~DI%s~SD%s", bleGetDeviceIdShort(), getFormattedDateTime().c_str());
+    char sd[CLOCK_SD_LEN + 1];
+    clockFormatSD(sd, sizeof(sd));
+    snprintf(probeBuf, sizeof(probeBuf), "PR~DI%s~SD%s", bleGetDeviceIdShort(), sd);
     sendPacket(probeBuf);
 }
 
@@ -584,11 +498,27 @@ void checkLoraPacketComplete() {
                 memset(rcv_pkt_buf, 0, MAX_PKT);  // Clear the receive buffer
                 int state = radio->readData(rcv_pkt_buf, packet_len);
                 radio->startReceive();  // Quickly continue receiving
+                if (state != RADIOLIB_ERR_RX_TIMEOUT) {
+                    uint32_t cap_t0 = micros();
+                    uint8_t cap_flags = state == RADIOLIB_ERR_NONE ? 0
+                                      : state == RADIOLIB_ERR_CRC_MISMATCH ? CAP_F_CRC_ERR : CAP_F_ERR;
+                    capRecord(rcv_pkt_buf, packet_len, cap_flags, radio->getRSSI(), radio->getSNR(), cap_t0);
+                }
                 if (state == RADIOLIB_ERR_NONE) {
                     rcv_pkt_buf[packet_len] = '\0';  // Null-terminate the received packet
 
                     Packet packet;
-                    if (packet.parsePacket(rcv_pkt_buf, packet_len)) {
+                    bool parsed = packet.parsePacket(rcv_pkt_buf, packet_len);
+                    MeshRx mesh = parsed ? meshOnReceive(rcv_pkt_buf, packet_len, radio->getSNR(),
+                                                         radio->getTimeOnAir(packet_len) / 1000, millis())
+                                         : MESH_RX_DROP;
+                    if (mesh == MESH_RX_RELAYED) {
+                        // The origin's ~PC / ~SD, late by the relay delays — content only,
+                        // not our peer's NAK sequence or clock
+                        sendSerialToApp(F("Relayed packet: "));
+                        sendSerialToAppLn((String)packet.type);
+                        handlePacket(packet);
+                    } else if (mesh == MESH_RX_DIRECT) {
                         sendSerialToApp(F("Packet parsed: "));
                         sendSerialToApp((String)packet.type);
                         sendSerialToApp("\n");
@@ -597,52 +527,11 @@ void checkLoraPacketComplete() {
                         sendSerialToApp(F("PC: "));
                         sendSerialToAppLn((String)packet.packetCounter);
 
-                        // Extract sender's time from the packet for gradual convergence
-                        long receiverTimeSeconds = 0;
-                        if (packet.sendDateTime.length() == 14) {
-                            receiverTimeSeconds = packet.sendDateTime.substring(8, 10).toInt() * 3600
-                                                + packet.sendDateTime.substring(10, 12).toInt() * 60
-                                                + packet.sendDateTime.substring(12, 14).toInt();
+                        // Converge gradually toward the sender's clock
+                        if (packet.sendEpoch != 0) {
+                            convergeToPeer(packet.sendEpoch);
                         }
 
-                        RTC_Date rtc_time = rtc.getDateTime();
-                        long localSeconds = rtc_time.hour * 3600 + rtc_time.minute * 60 + rtc_time.second;
-
-                        // Check if time is out of sync and converge gradually
-                        long timeDiff = abs(receiverTimeSeconds - localSeconds);
-                        if (timeDiff > TIME_CONVERGENCE_TOLERANCE) {
-                            long jump = constrain(receiverTimeSeconds - localSeconds, -TIME_CONVERGENCE_MAX_JUMP, TIME_CONVERGENCE_MAX_JUMP);
-                            RTC_Date currentRtc = rtc.getDateTime();
-                            long currentRtcSeconds = currentRtc.hour * 3600 + currentRtc.minute * 60 + currentRtc.second;
-                            long newRtcSeconds = currentRtcSeconds + jump;
-
-                            // Handle day wraparound
-                            if (newRtcSeconds < 0) {
-                                newRtcSeconds += HOP_EPOCH_SECONDS;
-                            } else if (newRtcSeconds >= HOP_EPOCH_SECONDS) {
-                                newRtcSeconds -= HOP_EPOCH_SECONDS;
-                            }
-
-                            long hours = newRtcSeconds / 3600;
-                            long minutes = (newRtcSeconds % 3600) / 60;
-                            long seconds = newRtcSeconds % 60;
-
-                            rtc.setDateTime(currentRtc.year, currentRtc.month, currentRtc.day, hours, minutes, seconds);
-                        } else {
-                            // Within tolerance — just nudge toward sender's time
-                            long jump = constrain(receiverTimeSeconds - localSeconds, -1, 1);
-                            if (jump != 0) {
-                                RTC_Date currentRtc = rtc.getDateTime();
-                                long newSeconds = currentRtc.hour * 3600 + currentRtc.minute * 60 + currentRtc.second + jump;
-                                if (newSeconds < 0) newSeconds += HOP_EPOCH_SECONDS;
-                                if (newSeconds >= HOP_EPOCH_SECONDS) newSeconds -= HOP_EPOCH_SECONDS;
-                                long h = newSeconds / 3600;
-                                long m = (newSeconds % 3600) / 60;
-                                long s = newSeconds % 60;
-                                rtc.setDateTime(currentRtc.year, currentRtc.month, currentRtc.day, h, m, s);
-                             }
-                         }
-
                         // PRB packet handling — probe discovery: extract DI and auto-sync RTC
                         if (packet.type == "PRB") {
                             sendSerialToApp(F("PRB rx on "));
@@ -663,10 +552,8 @@ void checkLoraPacketComplete() {
                             // Lock to discovery channel for several hop cycles after PRB receive
                             // Use sender's time (from ~SD) so both devices start their lock period together.
                             unsigned long senderCycle = 0;
-                            if (packet.sendDateTime.length() >= 14) {
-                                unsigned long senderSecs = packet.sendDateTime.substring(8, 10).toInt() * 3600
-                                                 + packet.sendDateTime.substring(10, 12).toInt() * 60
-                                                 + packet.sendDateTime.substring(12, 14).toInt();
+                            if (packet.sendEpoch != 0) {
+                                unsigned long senderSecs = packet.sendEpoch % HOP_EPOCH_SECONDS;
                                 senderCycle = (senderSecs / FrequencyHopSeconds) + 5;
                             }
 
@@ -680,8 +567,8 @@ void checkLoraPacketComplete() {
                                 time_set = true;
                                 sendSerialToApp(F("RTC synced from PRB ~SD: "));
                                 sendSerialToAppLn(packet.sendDateTime);
-                                adjustRTC(packet.sendDateTime);
-                            } else if (packet.sendDateTime.length() >= 14) {
+                                adjustRTC(packet.sendEpoch);
+                            } else if (packet.sendEpoch != 0) {
                                 // Already peer-synced — gradual convergence only
                              autoSyncRTCFromPacket(packet);
                          }
@@ -724,7 +611,7 @@ void checkLoraPacketComplete() {
                              }
 
                              // After syncing from this PRB, broadcast sync confirmation so peer also exits probe mode
-                             if (wasInProbe && packet.sendDateTime.length() == 14) {
+                             if (wasInProbe && packet.sendEpoch != 0) {
                                 char confirmBuf[80];
                                 snprintf(confirmBuf, sizeof(confirmBuf), "PR~DI%s~SD%s", bleGetDeviceIdShort(), packet.sendDateTime.c_str());
                                 sendPacket((uint8_t*)confirmBuf, strlen(confirmBuf));
@@ -741,11 +628,11 @@ void checkLoraPacketComplete() {
                             }
                         } else if (!time_set) {
                             // Not a PRB but no GPS yet — accept sender's time as truth
-                            if (packet.sendDateTime.length() == 14) {
+                            if (packet.sendEpoch != 0) {
                                 time_set = true;
                                 sendSerialToApp(F("RTC synced from peer ~SD: "));
                                 sendSerialToAppLn(packet.sendDateTime);
-                                adjustRTC(packet.sendDateTime);
+                                adjustRTC(packet.sendEpoch);
                             } else {
                                 autoSyncRTCFromPacket(packet);
                             }
@@ -773,26 +660,22 @@ void checkLoraPacketComplete() {
                                 sendSerialToAppLn(packet.beacon_deviceId);
                             }
 
-                            if (packet.sendDateTime.length() == 14) {
+                            if (packet.sendEpoch != 0) {
                                 if (!time_set) {
                                     time_set = true;
                                     sendSerialToApp(F("RTC synced from peer ~SD: "));
                                     sendSerialToAppLn(packet.sendDateTime);
-                                    adjustRTC(packet.sendDateTime);
+                                    adjustRTC(packet.sendEpoch);
                                 } else {
                                     // Already have GPS — accept peer time anyway to resolve drift
-                                    long localSecs = rtc.getDateTime().hour * 3600 + rtc.getDateTime().minute * 60 + rtc.getDateTime().second;
-                                    long pktSecs = packet.sendDateTime.substring(8, 10).toInt() * 3600
-                                                 + packet.sendDateTime.substring(10, 12).toInt() * 60
-                                                 + packet.sendDateTime.substring(12, 14).toInt();
-                                    long diff = abs(pktSecs - localSecs);
+                                    long diff = abs(peerClockOffset(packet.sendEpoch));
                                     
                                     if (diff > FrequencyHopSeconds) {
                                         // RTC is wildly wrong — accept peer time to get back in sync
                                         sendSerialToApp(F("RTC drifting by "));
                                         sendSerialToApp((String)diff);
                                         sendSerialToAppLn(F("s from peer — correcting"));
-                                        adjustRTC(packet.sendDateTime);
+                                        adjustRTC(packet.sendEpoch);
                                     } else {
                                         // Within hop cycle tolerance — gradual nudge is fine
                                         autoSyncRTCFromPacket(packet);
@@ -826,6 +709,9 @@ void checkLoraPacketComplete() {
                         syncLossTimer = millis();
                         lastPeerPacketTime = millis();
                         peerPacketReceived = true;
+                        if (packet.type == "BEACON") {
+                            peerTimeoutMs = bcnPeerTimeoutMs(packet.beacon_interval_s, PEER_TIMEOUT);
+                        }
 
                     } else {
                         //No need to process
@@ -844,8 +730,7 @@ void checkLoraPacketComplete() {
 
     // Discovery mode: stay on 869.47 MHz, listen for other devices
     if (deviceSettings.frequency_hopping_enabled && inProbeMode) {
-        RTC_Date rtc_dt = rtc.getDateTime();
-        unsigned long currentSecondsInDay = rtc_dt.hour * 3600 + rtc_dt.minute * 60 + rtc_dt.second;
+        unsigned long currentSecondsInDay = clockSecondOfDay();
 
         // Use the hop cycle number to trigger once per cycle
         unsigned long currentHopCycle = currentSecondsInDay / FrequencyHopSeconds;
@@ -891,13 +776,14 @@ void checkLoraPacketComplete() {
     static uint32_t syncBroadcastAt = 0;
     if (syncBroadcastAt == 0 && !inProbeMode) {
         char confirmBuf[80];
-        snprintf(confirmBuf, sizeof(confirmBuf), "PR~DI%s~SD%s", bleGetDeviceIdShort(), getFormattedDateTime().c_str());
+        char sd[CLOCK_SD_LEN + 1];
+        clockFormatSD(sd, sizeof(sd));
+        snprintf(confirmBuf, sizeof(confirmBuf), "PR~DI%s~SD%s", bleGetDeviceIdShort(), sd);
         sendPacket((uint8_t*)confirmBuf, strlen(confirmBuf));
         syncBroadcastAt = millis() + 30000;  // Reset after 30s
     }
     if (deviceSettings.frequency_hopping_enabled && !inProbeMode) {
-        RTC_Date currentTime = rtc.getDateTime();
-        unsigned long sharedTime = currentTime.hour * 3600 + currentTime.minute * 60 + currentTime.second;
+        unsigned long sharedTime = clockSecondOfDay();
         unsigned long currentHopCycle = sharedTime / FrequencyHopSeconds;
 
         // Check if we should hop to discovery frequency (every 5 minutes, for one hop cycle)
@@ -907,11 +793,9 @@ void checkLoraPacketComplete() {
         if (syncLockUntilCycle > currentHopCycle) {
             forceDiscoveryHop = true;
             static unsigned long lastSyncLog = 0;
-            RTC_Date now = rtc.getDateTime();
-            unsigned long nowSecs = now.hour * 3600 + now.minute * 60 + now.second;
-            if (nowSecs - lastSyncLog >= FrequencyHopSeconds) {
+            if (sharedTime - lastSyncLog >= FrequencyHopSeconds) {
                 sendSerialToAppLn(F("SYNC LOCK — staying on 869.47 for verification"));
-                lastSyncLog = nowSecs;
+                lastSyncLog = sharedTime;
             }
         }
         
@@ -942,8 +826,7 @@ void checkLoraPacketComplete() {
         }
 
         // During a discovery hop, transmit a PRB beacon to announce ourselves
-        unsigned long currentSecondsInDay = currentTime.hour * 3600 + currentTime.minute * 60 + currentTime.second;
-        unsigned long secondsIntoHop = currentSecondsInDay % FrequencyHopSeconds;
+        unsigned long secondsIntoHop = sharedTime % FrequencyHopSeconds;
         if (forceDiscoveryHop && secondsIntoHop >= PROBEBEACON_JITTER_MIN && secondsIntoHop < PROBEBEACON_JITTER_MAX
             && !transmitFlag && operationDone) {
             // Only send if we haven't already sent a PRB in this cycle
@@ -977,10 +860,10 @@ void checkLoraPacketComplete() {
         }
     }
 
-    // Send peer beacon periodically (only when not in probe mode)
+    // Send peer beacon when the SmartBeaconing schedule says so (only when not in probe mode)
     if (!inProbeMode) {
         unsigned long currentTime = millis();
-        if (currentTime - lastBeaconTime >= PEER_BEACON_INTERVAL) {
+        if (bcnDue(currentTime, lastBeaconTime)) {
             sendPeerBeacon();
             lastBeaconTime = currentTime;
         }
@@ -1096,19 +979,6 @@ bool setupLoRa() {
     return lora_ready;
 }
 
-String getFormattedDateTime() {
-    // Get the current date and time from the RTC
-    RTC_Date dateTime = rtc.getDateTime();
-
-    // Format it as YYYYMMDDHHMMSS
-    char dateTimeStr[15];
-    snprintf(dateTimeStr, sizeof(dateTimeStr), "%04d%02d%02d%02d%02d%02d",
-             dateTime.year, dateTime.month, dateTime.day,
-             dateTime.hour, dateTime.minute, dateTime.second);
-
-    return String(dateTimeStr);
-}
-
 void storePacketInBuffer(uint8_t* pkt_buf, uint16_t len, unsigned int counter) {
     // Truncate to max size — no heap allocation needed
     uint16_t safeLen = len > MAX_PACKET_SIZE ? MAX_PACKET_SIZE : len;
@@ -1203,7 +1073,11 @@ void sendPacket(uint8_t* pkt_buf, uint16_t len, unsigned int messageCounterOverr
     char* contentStart = (char*)(pkt_buf + 3);
     uint16_t contentLen = len - 3;
     
-    headerLen = snprintf(localBuf, sizeof(localBuf), "~PC%d~SD%s~~", currentMessageCounter, getFormattedDateTime().c_str());
+    char sd[CLOCK_SD_LEN + 1];
+    clockFormatSD(sd, sizeof(sd));
+    char mh[MESH_FIELD_MAX];
+    meshHeaderField(pkt_buf, len, currentMessageCounter, mh, sizeof(mh));
+    headerLen = snprintf(localBuf, sizeof(localBuf), "~PC%d%s~SD%s~~", currentMessageCounter, mh, sd);
     
     // Copy type prefix (first 3 chars)
     memmove(localBuf, pkt_buf, 3);
@@ -1215,12 +1089,12 @@ void sendPacket(uint8_t* pkt_buf, uint16_t len, unsigned int messageCounterOverr
         // Fall back to heap for oversized packets (shouldn't happen in normal use)
         send_pkt_buf = new char[newLen + 1];
         memmove(send_pkt_buf, pkt_buf, 3);
-        snprintf(send_pkt_buf + 3, newLen - 2, "~PC%d~SD%s~~", currentMessageCounter, getFormattedDateTime().c_str());
+        snprintf(send_pkt_buf + 3, newLen - 2, "~PC%d%s~SD%s~~", currentMessageCounter, mh, sd);
         memcpy(send_pkt_buf + headerLen, contentStart, contentLen);
         send_pkt_buf[newLen] = '\0';
     } else {
         memmove(localBuf + 3, "~PC", 3);
-        snprintf(localBuf + 3, sizeof(localBuf) - 3, "~PC%d~SD%s~~", currentMessageCounter, getFormattedDateTime().c_str());
+        snprintf(localBuf + 3, sizeof(localBuf) - 3, "~PC%d%s~SD%s~~", currentMessageCounter, mh, sd);
         memcpy(localBuf + headerLen, contentStart, contentLen);
         localBuf[newLen] = '\0';
         send_pkt_buf = localBuf;
@@ -1247,6 +1121,7 @@ void sendPacket(uint8_t* pkt_buf, uint16_t len, unsigned int messageCounterOverr
     // Start the transmission
     int state = radio->startTransmit((uint8_t*)send_pkt_buf, newLen);
     transmitFlag = true;
+    capRecord((uint8_t*)send_pkt_buf, newLen, CAP_F_TX | (state != RADIOLIB_ERR_NONE ? CAP_F_ERR : 0), 0, 0, micros());
 
         if (state != RADIOLIB_ERR_NONE) {
             sendSerialToApp(F("Transmission start failed, code "));
@@ -1266,6 +1141,20 @@ void sendPacket(uint8_t* pkt_buf, uint16_t len, unsigned int messageCounterOverr
 }
 
 
+// Mesh rebroadcast (mesh_relay.cpp) — the frame goes out verbatim. Returns false while the radio
+// is busy or probing; the caller keeps the frame and tries again.
+bool sendRawPacket(const uint8_t* buf, uint16_t len) {
+    if (transmitFlag || inProbeMode) return false;
+    timeOnAir = radio->getTimeOnAir(len);
+    int state = radio->startTransmit((uint8_t*)buf, len);
+    transmitFlag = state == RADIOLIB_ERR_NONE;
+    capRecord(buf, len, CAP_F_TX | (state != RADIOLIB_ERR_NONE ? CAP_F_ERR : 0), 0, 0, micros());
+    if (state != RADIOLIB_ERR_NONE) {
+        sendSerialToApp(F("Relay transmit failed, code "));
+        sendSerialToAppLn((String)state);
+    }
+    return transmitFlag;
+}
 
 // This function converts the string to uint8_t* and calls the main sendPacket
 void sendPacket(const char* str) {
@@ -1311,23 +1200,12 @@ bool isDuplicatePacket(Packet& packet) {
     return false;
 }
 
-// Function to adjust RTC based on received timestamp
-void adjustRTC(const String& dateTime) {
-    if (dateTime.length() != 14) {
+// Step the clock to a received ~SD (clockParseSD); the PCF8563 follows at its next checkpoint
+void adjustRTC(uint32_t epoch) {
+    if (epoch == 0) {
         return;  // Invalid timestamp, skip adjustment
     }
-
-    // Extract components from the received timestamp (assumed format is "YYYYMMDDHHMMSS")
-    int year = dateTime.substring(0, 4).toInt();
-    int month = dateTime.substring(4, 6).toInt();
-    int day = dateTime.substring(6, 8).toInt();
-    int hour = dateTime.substring(8, 10).toInt();
-    int minute = dateTime.substring(10, 12).toInt();
-    int second = dateTime.substring(12, 14).toInt();
-
-    // Adjust the RTC time
-    rtc.setDateTime(year, month, day, hour, minute, second);
-    //Serial.println(F("RTC adjusted to new time"));
+    clockStep(epoch, CLOCK_SRC_PEER);
 }
 
 
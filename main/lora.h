@@ -81,11 +81,11 @@ void checkLoraPacketComplete();
 bool setupLoRa();
 void sendPacket(uint8_t* pkt_buf, uint16_t len, unsigned int messageCounterOverride = 0);
 void sendPacket(const char* str);
+bool sendRawPacket(const uint8_t* buf, uint16_t len);   // As is, no header, no retransmit buffer
 void sleepLoRa();
 int setFrequency(float freq);
 unsigned char calculateChecksum(const unsigned char* data, int len);
 int calculateQuality(float rssi, float snr, bool ignoreSNR);
-String getFormattedDateTime();
 
 // Packet handling related functions
 void storePacketInBuffer(uint8_t* pkt_buf, uint16_t len, unsigned int counter);  // Store packet in buffer for retransmission
@@ -94,7 +94,7 @@ void storePacketInQueue(uint8_t* pkt_buf, uint16_t len, unsigned int counter);
 void processPacketQueue();  // Process the queued packets
 void handleRetransmitRequestComplete();  // Handle retransmission completion and process queued packets
 bool checkForMissingPackets(Packet& packet);  // Check for missing packets and request retransmission if necessary
-void adjustRTC(const String& dateTime);
+void adjustRTC(uint32_t epoch);
 void handleTransmissionComplete();
 void enqueuePacket(uint8_t* pkt_buf, uint16_t len);
 
@@ -104,31 +104,20 @@ void checkOutstandingReqs(unsigned int processedCounter);  // Check if any resol
 bool markPacketReceived(unsigned int counter);           // Track that a specific counter arrived (resolves outstanding REQs)
 void sendRetransmitRequest(unsigned int counter);        // Send REQ with dedup + spacing logic
 // Peer beacon & liveness tracking
+// The beacon rate itself comes from beacon_sched.h; these apply without a GPS fix and to peers
+// whose beacons carry no ~BI interval
 #define PEER_BEACON_INTERVAL 94000  // 94s = 2 hop cycles, reduces airtime while keeping liveness visible
 #define PEER_TIMEOUT 94000          // 94s = 2 beacon cycles
 
 extern unsigned long lastPeerPacketTime;
+extern unsigned long peerTimeoutMs;     // PEER_TIMEOUT, or from the last heard ~BI
 bool isPeerAlive();
 void sendPeerBeacon();
 const char* bleGetDeviceIdShort();
 
-// Peer roster (BEACON mode)
-#define MAX_ROSTER_PEERS 8
-struct PeerEntry {
-    String  deviceId;     // Last 8 hex chars of MAC
-    char    callSign[17]; // Call sign from ~CN field (up to 16 chars + null)
-    double  lat;          // From ~GP field
-    double  lon;          // From ~GP field
-    uint8_t battery;      // From ~BT field
-    unsigned long lastSeen; // millis() timestamp
-    float   distanceM;    // Computed from GPS location
-};
-
-extern PeerEntry peerRoster[MAX_ROSTER_PEERS];
-extern int     peerRosterCount;
+// Peer roster (BEACON mode) — peer_roster.h
 extern bool    inBeaconMode;
 void beaconAddOrUpdate(const Packet& packet);
-void beaconDisplayRoster(uint8_t line);
 
 // Waypoint broadcast state
 #define WP_BROADCAST_INTERVAL_MS 3000   // Send waypoint every 3s during broadcast
@@ -145,7 +134,7 @@ extern bool heardProbeThisCycle;         // Whether we received a PRB during cur
 extern unsigned long syncLockUntilCycle; // Hop cycle number until which we lock to discovery freq after PRB receive
 
 // Peer-to-peer handshake (bidirectional liveness)
-#define P2P_ACK_TIMEOUT_MS 94000          // 94s = 2 beacon cycles
+#define P2P_ACK_TIMEOUT_MS 94000          // 94s = 2 beacon cycles — floor, peerTimeoutMs when longer
 extern bool peerAcked;                   // True once peer acknowledged our probe (bidirectional sync)
 extern unsigned long peerAckedTimeMs;    // millis() when peer ACK was last received
 void setPeerAcked();                     // Called on receiving PS packet from peer
@@ -0,0 +1,201 @@
+// lora_capture.cpp — RAM staging on the radio path, msg_log ring on QSPI, hex export
+
+#include "lora_capture.h"
+#include "settings.h"
+#include "lora.h"
+#include "epoch_clock.h"
+
+struct CapSlot {
+    volatile bool ready;    // Filled — capTick() may write it out
+    uint8_t   _pad;
+    uint16_t  len;          // Frame bytes
+    CapRecHdr hdr;
+    uint8_t   frame[CAP_FRAME_MAX];
+};
+
+// Two producers: the loop (RX, most TX) and the BLE task, whose voice path calls sendPacket().
+// A slot is claimed and released with interrupts off — which also keeps the scheduler from
+// switching tasks — and filled outside; capTick() only takes it once it is ready.
+static CapSlot s_stage[CAP_STAGE_SLOTS];
+static uint8_t s_stage_head = 0;    // Next slot to claim
+static uint8_t s_stage_tail = 0;    // Oldest claimed slot
+static volatile uint8_t s_stage_used = 0;
+
+static MsgSectorIndex s_index[QSPI_CAP_SECTORS];
+static MsgLog s_log;
+static bool s_inited = false;
+static bool s_enabled = true;
+static bool s_boot_pending = false; // Boot marker not written yet
+static uint16_t s_seq = 0;
+static uint32_t s_clock_ms = 0;     // Last clock marker
+static bool s_clock_done = false;   // At least one valid clock marker this boot
+
+// Stats
+static uint32_t s_rx = 0;
+static uint32_t s_tx = 0;
+static uint32_t s_crc_err = 0;
+static uint32_t s_dropped = 0;
+static uint8_t  s_staged_max = 0;
+static uint32_t s_hot_us = 0;
+static uint32_t s_hot_max_us = 0;
+static uint32_t s_mount_ms = 0;
+
+void capInit() {
+    if (s_inited) return;
+    s_inited = true;
+    uint32_t t0 = millis();
+    if (qspiFlashInit()) {
+        s_log.ops = &qspiFlashOps();
+        s_log.base = QSPI_CAP_BASE;
+        s_log.sectors = QSPI_CAP_SECTORS;
+        s_log.index = s_index;
+        msgLogMount(s_log);
+    } else {
+        s_log.ops = nullptr;
+    }
+    s_mount_ms = millis() - t0;
+    s_boot_pending = true;
+}
+
+static void fillHdr(CapRecHdr& h, uint8_t flags, uint16_t seq) {
+    h.t_ms = millis();
+    h.freq_khz = (uint32_t)(currentFrequency * 1000.0f + 0.5f);
+    h.seq = seq;
+    h.bw_100hz = (uint16_t)(deviceSettings.bandwidth_idx / 100);
+    h.rssi_q4 = 0;
+    h.snr_q4 = 0;
+    h.sf = deviceSettings.spreading_factor;
+    h.cr = deviceSettings.coding_rate_idx;
+    h.flags = flags;
+}
+
+void capRecord(const uint8_t* frame, uint16_t len, uint8_t flags, float rssi, float snr, uint32_t t0_us) {
+    if (!s_enabled) return;
+    noInterrupts();
+    uint16_t seq = s_seq++;
+    if (s_stage_used >= CAP_STAGE_SLOTS) {
+        s_dropped++;        // The seq is spent: the gap shows in the export
+        interrupts();
+        return;
+    }
+    CapSlot& s = s_stage[s_stage_head];
+    s_stage_head = (s_stage_head + 1) % CAP_STAGE_SLOTS;
+    s_stage_used++;
+    if (s_stage_used > s_staged_max) s_staged_max = s_stage_used;
+    if (flags & CAP_F_TX) s_tx++;
+    else s_rx++;
+    if (flags & CAP_F_CRC_ERR) s_crc_err++;
+    interrupts();
+
+    if (len > CAP_FRAME_MAX) {
+        len = CAP_FRAME_MAX;
+        flags |= CAP_F_TRUNC;
+    }
+    fillHdr(s.hdr, flags, seq);
+    if (!(flags & CAP_F_TX)) {
+        s.hdr.rssi_q4 = (int16_t)(rssi * 4.0f);
+        s.hdr.snr_q4 = (int8_t)constrain((int)(snr * 4.0f), -128, 127);
+    }
+    memcpy(s.frame, frame, len);
+    s.len = len;
+    __sync_synchronize();   // Contents before the flag
+    s.ready = true;
+
+    s_hot_us = micros() - t0_us;
+    if (s_hot_us > s_hot_max_us) s_hot_max_us = s_hot_us;
+}
+
+static bool appendMarker(uint8_t flags) {
+    uint8_t buf[sizeof(CapRecHdr) + sizeof(CapClock)];
+    CapRecHdr h;
+    noInterrupts();
+    uint16_t seq = s_seq++;
+    interrupts();
+    fillHdr(h, flags, seq);
+    CapClock c;
+    memset(&c, 0, sizeof(c));
+    c.format = CAP_FORMAT;
+    if (time_set) {
+        RTC_Date d = clockDateTime();
+        c.valid = 1;
+        c.year = d.year;
+        c.month = d.month;
+        c.day = d.day;
+        c.hour = d.hour;
+        c.minute = d.minute;
+        c.second = d.second;
+    }
+    memcpy(buf, &h, sizeof(h));
+    memcpy(buf + sizeof(h), &c, sizeof(c));
+    return msgLogAppend(s_log, nullptr, 0, buf, sizeof(buf));
+}
+
+// Hand the oldest staged slot back once it has been written out (or dropped)
+static void releaseSlot() {
+    s_stage[s_stage_tail].ready = false;
+    s_stage_tail = (s_stage_tail + 1) % CAP_STAGE_SLOTS;
+    noInterrupts();
+    s_stage_used--;
+    interrupts();
+}
+
+void capTick(uint32_t now) {
+    if (!s_inited) return;
+    if (!s_log.ops) {
+        // No flash: nothing to drain into, keep the stage from filling up
+        while (s_stage_used > 0 && s_stage[s_stage_tail].ready) releaseSlot();
+        return;
+    }
+    if (s_boot_pending) {
+        s_boot_pending = false;
+        appendMarker(CAP_F_BOOT | CAP_F_CLOCK);
+        s_clock_done = time_set;
+        s_clock_ms = now;
+        return;
+    }
+    if (s_stage_used > 0) {
+        // Claimed but still being filled by the other task — next pass
+        CapSlot& s = s_stage[s_stage_tail];
+        if (!s.ready) return;
+        __sync_synchronize();
+        // Header and frame are contiguous in the slot
+        static_assert(offsetof(CapSlot, frame) == offsetof(CapSlot, hdr) + sizeof(CapRecHdr), "CapSlot must not pad");
+        msgLogAppend(s_log, nullptr, 0, (const uint8_t*)&s.hdr, sizeof(CapRecHdr) + s.len);
+        releaseSlot();
+        return;
+    }
+    // Clock marker once the RTC gets set, then every CAP_CLOCK_EVERY_MS
+    if (time_set && (!s_clock_done || now - s_clock_ms >= CAP_CLOCK_EVERY_MS)) {
+        appendMarker(CAP_F_CLOCK);
+        s_clock_done = true;
+        s_clock_ms = now;
+    }
+}
+
+void capSetEnabled(bool on) {
+    s_enabled = on;
+}
+
+void capClear() {
+    if (!s_inited) capInit();
+    if (s_log.ops) msgLogClear(s_log);
+}
+
+int capExport(char* out, size_t out_len, uint32_t from) {
+    if (!s_inited) capInit();
+    if (!s_log.ops) return snprintf(out, out_len, "ERR{PCAP:no flash}");
+    return msgLogExportHex(s_log, "PCAP", from, out, out_len);
+}
+
+int capFormatStats(char* out, size_t out_len) {
+    if (!s_inited) capInit();
+    uint32_t recs = s_log.ops ? msgLogCount(s_log) : 0;
+    uint32_t first = s_log.ops ? msgLogFirst(s_log) : 0;
+    return snprintf(out, out_len,
+                    "OK{CAPSTATS:on=%d,store=%s,recs=%lu,first=%lu,rx=%lu,tx=%lu,crc_err=%lu,dropped=%lu,"
+                    "staged_max=%u,hot_us=%lu,hot_max_us=%lu,erases=%lu,mount_ms=%lu}",
+                    s_enabled ? 1 : 0, s_log.ops ? "qspi" : "none", (unsigned long)recs, (unsigned long)first,
+                    (unsigned long)s_rx, (unsigned long)s_tx, (unsigned long)s_crc_err, (unsigned long)s_dropped,
+                    s_staged_max, (unsigned long)s_hot_us, (unsigned long)s_hot_max_us,
+                    (unsigned long)s_log.erases, (unsigned long)s_mount_ms);
+}
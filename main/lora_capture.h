@@ -0,0 +1,69 @@
+// lora_capture.h — Capture ring of every LoRa frame sent and received, exported for pcapng
+
+#ifndef LORA_CAPTURE_H
+#define LORA_CAPTURE_H
+
+#include <Arduino.h>
+#include "msg_log.h"
+
+// Hot path (checkLoraPacketComplete / sendPacket): capRecord() fills one of CAP_STAGE_SLOTS RAM
+// slots with a CapRecHdr and a copy of the frame — no flash access, no allocation. When every slot
+// is taken the frame is dropped and counted; the per-boot seq in each record shows the gap.
+// capRecord() is safe from the BLE task too (voice frames go out from the write callback).
+// capTick() (loop) moves one staged record per call into a msg_log ring at QSPI_CAP_BASE; the
+// oldest sector drops out when it wraps. Without the flash chip records are staged and dropped.
+//
+// Each msg_log payload is a CapRecHdr followed by the raw frame. Marker records (CAP_F_BOOT,
+// CAP_F_CLOCK) carry a CapClock instead, so the host can turn t_ms into wall-clock time.
+// build_scripts/cap2pcapng.py converts a PCAP dump into pcapng and writes a Wireshark dissector.
+
+#define CAP_STAGE_SLOTS         8
+#define CAP_FRAME_MAX           255         // MAX_PKT
+#define CAP_CLOCK_EVERY_MS      600000      // Clock marker interval while the RTC is set
+#define CAP_EXPORT_MAX_CHARS    1024        // One PCAP reply
+#define CAP_FORMAT              1           // CapClock.format — bump when CapRecHdr changes
+
+// CapRecHdr.flags
+#define CAP_F_TX                (1 << 0)    // Sent by us (else received)
+#define CAP_F_CRC_ERR           (1 << 1)    // RX: payload CRC mismatch — frame is what the radio gave us
+#define CAP_F_ERR               (1 << 2)    // RX: other read error / TX: startTransmit failed
+#define CAP_F_TRUNC             (1 << 3)    // Frame cut at CAP_FRAME_MAX
+#define CAP_F_CLOCK             (1 << 6)    // Marker: payload is a CapClock
+#define CAP_F_BOOT              (1 << 7)    // Marker: first record after a reset (t_ms restarts)
+
+struct __attribute__((packed)) CapRecHdr {
+    uint32_t t_ms;          // millis() at capture
+    uint32_t freq_khz;      // Carrier
+    uint16_t seq;           // Per boot, +1 per captured frame (markers included)
+    uint16_t bw_100hz;      // Bandwidth in 100 Hz units (1250 = 125 kHz)
+    int16_t  rssi_q4;       // RX: packet RSSI, dBm x 4
+    int8_t   snr_q4;        // RX: packet SNR, dB x 4
+    uint8_t  sf;
+    uint8_t  cr;            // 5..8 = 4/5..4/8
+    uint8_t  flags;         // CAP_F_*
+};
+
+struct __attribute__((packed)) CapClock {
+    uint8_t  format;        // CAP_FORMAT
+    uint8_t  valid;         // RTC was set (GPS / peer) when the marker was written
+    uint16_t year;
+    uint8_t  month, day, hour, minute, second;
+};
+
+void capInit();
+// Hot path. t0_us = micros() before the caller read RSSI/SNR, so hot_us covers the whole capture.
+void capRecord(const uint8_t* frame, uint16_t len, uint8_t flags, float rssi, float snr, uint32_t t0_us);
+// Loop context — one staged record to flash per call, clock markers
+void capTick(uint32_t now);
+void capSetEnabled(bool on);
+void capClear();
+
+// "OK{PCAP:<first>:<hex>,<hex>,...}{NEXT:<n>}" — records from message number `from` on, as many
+// as fit; NEXT is the number to ask for next and is omitted once the dump has caught up.
+int capExport(char* out, size_t out_len, uint32_t from);
+
+// "OK{CAPSTATS:on=1,store=qspi|none,recs=..,first=..,rx=..,tx=..,crc_err=..,dropped=..,staged_max=..,
+//  hot_us=..,hot_max_us=..,erases=..,mount_ms=..}"
+int capFormatStats(char* out, size_t out_len);
+
+#endif
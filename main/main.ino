@@ -33,9 +33,15 @@
 #include "app_modes.h"
 #include "lora.h"
 #include "ble.h"
+#include "retained_ram.h"
+#include "settings_store.h"
 
-// GPS SoftwareSerial on P1.8 (TX) / P1.9 (RX)
-SoftwareSerial SerialGPS(Gps_Tx_Pin, Gps_Rx_Pin);  // RX pin, TX pin
+// GPS on UARTE1, P1.8 (TX) / P1.9 (RX) — RX interrupt into the core's ring buffer (gnss.h)
+Uart SerialGPS(NRF_UARTE1, UARTE1_IRQn, Gps_Tx_Pin, Gps_Rx_Pin);  // RX pin, TX pin
+
+extern "C" void UARTE1_IRQHandler(void) {
+    SerialGPS.IrqHandler();
+}
 
 
 
@@ -48,7 +54,6 @@ volatile uint32_t fault_cfsr = 0;
 volatile uint32_t fault_bfar = 0;
 volatile uint32_t fault_lr = 0;
 bool fatal_crash_detected = false;
-volatile uint32_t crashCount = 0x5A5A5A5A;  // survives reset in RAM (BSS preserved by NVIC_SystemReset)
 
 extern "C" void HardFault_Handler(void) {
     // Save state first (these are safe — direct register reads)
@@ -60,7 +65,19 @@ extern "C" void HardFault_Handler(void) {
     fault_lr = lr;
     
     fatal_crash_detected = true;
-    crashCount++;  // track how many crashes in a row
+
+    // Keep the fault in retained RAM (RR_CRASH) — the globals above are gone after the reset
+    CrashRecord& c = g_retained.crash.body;
+    c.magic = CRASH_MAGIC;
+    c.lr_at_crash = lr;
+    c.cfsr = fault_cfsr;
+    c.hfsr = SCB->HFSR;
+    c.bfar = fault_bfar;
+    memcpy(c.function, "HardFault", 10);
+    c.line_number = 0;
+    c.tick_count = millis();
+    c.crash_count++;  // track how many crashes in a row
+    retainedSeal(RR_CRASH);
     
     // Clear pending faults before resetting
     SCB->CFSR = 0xFFFFFFFF;
@@ -112,6 +129,9 @@ bool checkStackGuard(uint32_t* guard, uint32_t pattern) {
 
 void setup()
 {
+    // Before anything touches the crash record
+    uint8_t retained_repaired = retainedInit();
+
     Serial.begin(115200);
     
     // Crash-proof safe mode flag — BSS persists across NVIC_SystemReset
@@ -134,25 +154,29 @@ void setup()
         }
     }
     
-    // Log crash count on boot (RAM preserved across NVIC_SystemReset)
-    if (crashCount != 0x5A5A5A5A) {
+    // Retained-RAM regions: which survived the reset, which were re-initialised
+    {
+        char rr[96];
+        retainedFormat(rr, sizeof(rr));
+        SerialMon.print(F("[BOOT] "));
+        SerialMon.println(rr);
+    }
+
+    // Report the fault only when this reset came from one (RR_CRASH survives NVIC_SystemReset):
+    // HardFault_Handler sets CRASH_MAGIC, the report clears it. crash_count is the streak.
+    const CrashRecord& last_crash = g_retained.crash.body;
+    if (!(retained_repaired & (1 << RR_CRASH)) && last_crash.magic == CRASH_MAGIC) {
         SerialMon.print(F("[BOOT] Crash reboot #"));
-        SerialMon.println(crashCount);
-        
-        // Dump RTC RAM crash info from last fault (if available)
-        #define CRASH_MAGIC 0x43524153
-        typedef struct { uint32_t magic; uint32_t lr_at_crash; uint32_t cfsr; uint32_t bfar; char function[16]; uint32_t line_number; } CrashRecord;
-        CrashRecord* g_crash = (CrashRecord*)0x20007FC0;  // RTC RAM crash area
-        
-        if (g_crash->magic == CRASH_MAGIC) {
-            SerialMon.println("\n--- Last crash from RTC RAM ---");
-            SerialMon.print(F("  LR=0x"));   SerialMon.println(g_crash->lr_at_crash, HEX);
-            SerialMon.print(F("  CFSR=0x"));  SerialMon.println(g_crash->cfsr, HEX);
-            SerialMon.print(F("  BFAR=0x"));  SerialMon.println(g_crash->bfar, HEX);
-            SerialMon.print(F("  Func: "));   SerialMon.println(g_crash->function);
-            SerialMon.print(F("  Line: "));   SerialMon.println(g_crash->line_number);
-            SerialMon.println("---");
-        }
+        SerialMon.println(last_crash.crash_count);
+        SerialMon.println("\n--- Last crash from retained RAM ---");
+        SerialMon.print(F("  LR=0x"));   SerialMon.println(last_crash.lr_at_crash, HEX);
+        SerialMon.print(F("  CFSR=0x"));  SerialMon.println(last_crash.cfsr, HEX);
+        SerialMon.print(F("  BFAR=0x"));  SerialMon.println(last_crash.bfar, HEX);
+        SerialMon.print(F("  Func: "));   SerialMon.println(last_crash.function);
+        SerialMon.print(F("  Line: "));   SerialMon.println(last_crash.line_number);
+        SerialMon.println("---");
+        g_retained.crash.body.magic = 0;    // Reported — the count stays until the streak ends
+        retainedSeal(RR_CRASH);
     }
     
     // Drain USB buffer before blocking operations
@@ -187,6 +211,15 @@ void setup()
     checkCrashState();
     DB("after first updDisp");
 
+    // ---------- Stored settings ---------- (before setupLoRa() reads them)
+    {
+        settingsStoreLoad();
+        char st[96];
+        settingsStoreFormat(st, sizeof(st));
+        SerialMon.print(F("[BOOT] "));
+        SerialMon.println(st);
+    }
+
     // ---------- Frequency Map ----------
     static uint32_t crash_step = 0;  // BSS persists: survives crash resets
     unsigned long step1Start = millis();
@@ -337,6 +370,13 @@ void setup()
 void loop()
 {
     checkCrashState();
+
+    // A clean stretch of uptime ends the crash streak
+    static bool crash_streak_ended = false;
+    if (!crash_streak_ended && millis() > CRASH_CLEAN_UPTIME_MS) {
+        crash_streak_ended = true;
+        retainedCrashStreakEnd();
+    }
     
     //sendSerialToAppLn(F("[LOOP] begin"));
     handleAppModes();
@@ -0,0 +1,190 @@
+// mesh_relay.cpp — ~MH field, seen cache, pending rebroadcasts
+
+#include "mesh_relay.h"
+#include "settings.h"
+#include "lora.h"
+
+#define MH_ID_LEN       8
+#define MH_BODY_LEN     (MH_ID_LEN + 3 + 1 + 1)
+
+struct MeshHdr {
+    const uint8_t* origin;
+    uint32_t id;            // origin as a number — (id, seq) names the frame
+    uint16_t seq;
+    uint8_t  ttl, hop;
+    uint16_t ttl_at;        // Offset of the ttl digit in the frame
+};
+
+// Recently seen (origin, seq) — a ring, oldest overwritten
+static struct {
+    uint32_t id;
+    uint16_t seq;
+    uint32_t at;
+} s_seen[MESH_SEEN_SLOTS];
+static uint8_t s_seen_head = 0;
+
+static struct {
+    bool     used;
+    uint32_t id;
+    uint16_t seq;
+    uint32_t due;
+    uint32_t toa_ms;
+    uint16_t len;
+    uint8_t  frame[MESH_FRAME_MAX];
+} s_pend[MESH_PENDING];
+
+// Stats
+static uint32_t s_tagged = 0;           // Tagged frames received, first copies
+static uint32_t s_dups = 0;
+static uint32_t s_own = 0;
+static uint32_t s_queued = 0;
+static uint32_t s_sent = 0;
+static uint32_t s_cancelled = 0;
+static uint32_t s_lost = 0;             // No free slot, or the radio stayed busy
+static uint32_t s_air_ms = 0;
+
+static const char hexDigits[] = "0123456789ABCDEF";
+
+static int hexVal(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Text, position-bearing and beacon frames — not probes, handshakes, NAKs or PTT audio
+static bool floodType(const uint8_t* f, uint16_t len) {
+    if (len < 3) return false;
+    if (f[0] == 'T' && f[1] == 'X') return true;
+    if (f[0] == 'B' && f[1] != '~') return true;
+    return memcmp(f, "WPT", 3) == 0;
+}
+
+// ~MH among the header fields (before "~~")
+static bool parseMh(const uint8_t* f, uint16_t len, MeshHdr* h) {
+    for (uint16_t i = 0; i + 3 + MH_BODY_LEN <= len; i++) {
+        if (f[i] != '~') continue;
+        if (f[i + 1] == '~') return false;
+        if (f[i + 1] != 'M' || f[i + 2] != 'H') continue;
+        const uint8_t* v = f + i + 3;
+        uint32_t id = 0;
+        for (int k = 0; k < MH_ID_LEN; k++) {
+            int d = hexVal(v[k]);
+            if (d < 0) return false;
+            id = id << 4 | d;
+        }
+        int s0 = hexVal(v[8]), s1 = hexVal(v[9]), s2 = hexVal(v[10]), t = hexVal(v[11]), hp = hexVal(v[12]);
+        if (s0 < 0 || s1 < 0 || s2 < 0 || t < 0 || hp < 0) return false;
+        h->origin = v;
+        h->id = id;
+        h->seq = (uint16_t)(s0 << 8 | s1 << 4 | s2);
+        h->ttl = t;
+        h->hop = hp;
+        h->ttl_at = i + 3 + 11;
+        return true;
+    }
+    return false;
+}
+
+static bool seen(const MeshHdr& h, uint32_t now) {
+    for (uint8_t i = 0; i < MESH_SEEN_SLOTS; i++) {
+        if (s_seen[i].at == 0 || now - s_seen[i].at >= MESH_SEEN_MS) continue;
+        if (s_seen[i].id == h.id && s_seen[i].seq == h.seq) return true;
+    }
+    return false;
+}
+
+static void remember(const MeshHdr& h, uint32_t now) {
+    s_seen[s_seen_head].id = h.id;
+    s_seen[s_seen_head].seq = h.seq;
+    s_seen[s_seen_head].at = now ? now : 1;
+    s_seen_head = (s_seen_head + 1) % MESH_SEEN_SLOTS;
+}
+
+static void schedule(const uint8_t* frame, uint16_t len, const MeshHdr& h, float snr, uint32_t toa_ms,
+                     uint32_t now) {
+    int k = -1;
+    for (int i = 0; i < MESH_PENDING; i++) {
+        if (!s_pend[i].used) {
+            k = i;
+            break;
+        }
+    }
+    if (k < 0 || len > MESH_FRAME_MAX) {
+        s_lost++;
+        return;
+    }
+    float pos = (snr - MESH_SNR_EDGE_DB) / (MESH_SNR_NEAR_DB - MESH_SNR_EDGE_DB);
+    pos = constrain(pos, 0.0f, 1.0f);
+    uint32_t delay = (uint32_t)(toa_ms * (MESH_DELAY_MIN_SLOTS + MESH_DELAY_SNR_SLOTS * pos)) + random(toa_ms + 1);
+
+    s_pend[k].used = true;
+    s_pend[k].id = h.id;
+    s_pend[k].seq = h.seq;
+    s_pend[k].due = now + delay;
+    s_pend[k].toa_ms = toa_ms;
+    s_pend[k].len = len;
+    memcpy(s_pend[k].frame, frame, len);
+    s_pend[k].frame[h.ttl_at] = hexDigits[h.ttl - 1];
+    s_pend[k].frame[h.ttl_at + 1] = hexDigits[h.hop < 15 ? h.hop + 1 : 15];
+    s_queued++;
+}
+
+size_t meshHeaderField(const uint8_t* frame, uint16_t len, unsigned int counter, char* out, size_t out_len) {
+    out[0] = '\0';
+    if (!deviceSettings.mesh_enabled || !floodType(frame, len)) return 0;
+    int n = snprintf(out, out_len, "~MH%.8s%03X%X0", bleGetDeviceIdShort(), counter & 0xFFF,
+                     constrain(deviceSettings.mesh_ttl, 1, MESH_TTL_MAX));
+    return n > 0 ? (size_t)n : 0;
+}
+
+MeshRx meshOnReceive(const uint8_t* frame, uint16_t len, float snr, uint32_t toa_ms, uint32_t now) {
+    MeshHdr h;
+    if (!parseMh(frame, len, &h)) return MESH_RX_DIRECT;
+    if (memcmp(h.origin, bleGetDeviceIdShort(), MH_ID_LEN) == 0) {
+        s_own++;
+        return MESH_RX_DROP;
+    }
+
+    if (seen(h, now)) {
+        // Someone else relayed it first — ours would add nothing here
+        s_dups++;
+        for (int i = 0; i < MESH_PENDING; i++) {
+            if (s_pend[i].used && s_pend[i].id == h.id && s_pend[i].seq == h.seq) {
+                s_pend[i].used = false;
+                s_cancelled++;
+            }
+        }
+        return MESH_RX_DROP;
+    }
+    remember(h, now);
+    s_tagged++;
+
+    if (deviceSettings.mesh_enabled && h.ttl > 0 && floodType(frame, len)) {
+        schedule(frame, len, h, snr, toa_ms, now);
+    }
+    return h.hop == 0 ? MESH_RX_DIRECT : MESH_RX_RELAYED;
+}
+
+void meshTick(uint32_t now) {
+    for (int i = 0; i < MESH_PENDING; i++) {
+        if (!s_pend[i].used || (int32_t)(now - s_pend[i].due) < 0) continue;
+        if (sendRawPacket(s_pend[i].frame, s_pend[i].len)) {
+            s_pend[i].used = false;
+            s_sent++;
+            s_air_ms += s_pend[i].toa_ms;
+            return;     // One per pass — the radio is busy now
+        }
+        if (now - s_pend[i].due > MESH_STALE_MS) {
+            s_pend[i].used = false;
+            s_lost++;
+        }
+    }
+}
+
+int meshFormatStats(char* out, size_t out_len) {
+    return snprintf(out, out_len,
+                    "OK{MESH:on=%u,ttl=%d,tagged=%lu,dup=%lu,own=%lu,queued=%lu,sent=%lu,cancel=%lu,lost=%lu,air_ms=%lu}",
+                    deviceSettings.mesh_enabled ? 1 : 0, deviceSettings.mesh_ttl, (unsigned long)s_tagged,
+                    (unsigned long)s_dups, (unsigned long)s_own, (unsigned long)s_queued, (unsigned long)s_sent,
+                    (unsigned long)s_cancelled, (unsigned long)s_lost, (unsigned long)s_air_ms);
+}
@@ -0,0 +1,59 @@
+// mesh_relay.h — Managed flood: ~MH origin / sequence / TTL, duplicate cache, SNR-timed rebroadcast
+
+#ifndef MESH_RELAY_H
+#define MESH_RELAY_H
+
+#include <Arduino.h>
+
+// With deviceSettings.mesh_enabled, sendPacket() tags TXT / TXM, beacon and WPT frames with
+//
+//   ~MH<origin 8><seq 3 hex><ttl 1 hex><hop 1 hex>      e.g. ~MH1A2B3C4D07F30
+//
+// origin = bleGetDeviceIdShort(), seq = the frame's ~PC (so a post-hop resend is the same frame).
+// The seen cache keeps the (origin, seq) pairs themselves, not a hash, so a new frame is never
+// taken for a copy; an origin that is not 8 hex digits makes the field invalid (an untagged frame).
+// A receiver that has not seen (origin, seq) within MESH_SEEN_MS delivers it and, when it relays
+// and ttl > 0, queues a copy with ttl - 1 / hop + 1. The copy goes out after
+//
+//   airtime × (MESH_DELAY_MIN_SLOTS + MESH_DELAY_SNR_SLOTS × snr_position) + random(airtime)
+//
+// snr_position runs 0 at MESH_SNR_EDGE_DB .. 1 at MESH_SNR_NEAR_DB, so the nodes that barely heard
+// the sender — the ones that extend the reach most — go first. Hearing another copy while waiting
+// cancels ours: that neighbourhood is covered.
+//
+// Every node drops copies it already has (and its own frames coming back), relaying or not;
+// untagged frames from older firmware stay single-hop as before. A relayed frame (hop > 0) carries
+// the origin's ~PC and ~SD, late by the relay delays — lora.cpp hands it to handlePacket() but
+// keeps it away from the NAK sequence and the clock.
+
+#define MESH_TTL_DEFAULT        3
+#define MESH_TTL_MAX            7
+#define MESH_FIELD_MAX          20          // "~MH" + 13 + NUL, rounded up
+#define MESH_SEEN_SLOTS         64
+#define MESH_SEEN_MS            120000      // Longer than any relay chain; a rebooted origin restarts its seq
+#define MESH_PENDING            4
+#define MESH_FRAME_MAX          255         // MAX_PKT
+#define MESH_DELAY_MIN_SLOTS    1
+#define MESH_DELAY_SNR_SLOTS    4
+#define MESH_SNR_EDGE_DB        (-15.0f)
+#define MESH_SNR_NEAR_DB        10.0f
+#define MESH_STALE_MS           10000       // Radio busy this long past due — give the copy up
+
+enum MeshRx : uint8_t {
+    MESH_RX_DIRECT = 0,     // Untagged, or straight from the origin — the usual path
+    MESH_RX_RELAYED,        // First copy, through at least one relay
+    MESH_RX_DROP            // Seen before, or our own
+};
+
+// sendPacket() — the ~MH field for frame (type in the first bytes) with ~PC counter, "" if the
+// frame is not flooded. Returns the length written.
+size_t meshHeaderField(const uint8_t* frame, uint16_t len, unsigned int counter, char* out, size_t out_len);
+// RX path, after parsePacket() — snr of the frame, toa_ms its airtime
+MeshRx meshOnReceive(const uint8_t* frame, uint16_t len, float snr, uint32_t toa_ms, uint32_t now);
+// Loop context — sends due copies through sendRawPacket()
+void meshTick(uint32_t now);
+
+// "OK{MESH:on=..,ttl=..,tagged=..,dup=..,own=..,queued=..,sent=..,cancel=..,lost=..,air_ms=..}"
+int meshFormatStats(char* out, size_t out_len);
+
+#endif
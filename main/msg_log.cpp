@@ -0,0 +1,287 @@
+// msg_log.cpp — Log-structured message store: mount/replay, append with commit word, indexed reads
+
+#include "msg_log.h"
+
+#define MSG_SECTOR_MAGIC    0x4C47534D      // "MSGL"
+#define MSG_REC_MAGIC       0x5243          // "CR"
+#define MSG_COMMIT_SIZE     4
+#define MSG_ERASED16        0xFFFF
+
+static uint32_t recSize(uint16_t len) {
+    return sizeof(MsgRecHdr) + ((len + 3u) & ~3u) + MSG_COMMIT_SIZE;
+}
+
+static uint32_t sectorAddr(const MsgLog& log, uint16_t s) {
+    return log.base + (uint32_t)s * FLASH_SECTOR_SIZE;
+}
+
+static uint16_t nextSector(const MsgLog& log, uint16_t s) {
+    return s + 1 < log.sectors ? s + 1 : 0;
+}
+
+static uint32_t payloadCheck(const uint8_t* p, uint16_t len) {
+    uint32_t h = 2166136261u;
+    for (uint16_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool readSectorHdr(const MsgLog& log, uint16_t s, MsgSectorHdr& h) {
+    return log.ops->read(sectorAddr(log, s), &h, sizeof(h)) && h.magic == MSG_SECTOR_MAGIC && h.seq != 0xFFFFFFFF;
+}
+
+// Returns the sector's new erase count
+static uint32_t eraseSector(MsgLog& log, uint16_t s) {
+    MsgSectorHdr h;
+    uint32_t erases = readSectorHdr(log, s, h) && h.erases != 0xFFFFFFFF ? h.erases + 1 : 1;
+    log.ops->erase(sectorAddr(log, s));
+    log.index[s] = { 0, 0 };
+    log.erases++;
+    if (log.cur_sector == s) log.cur_sector = 0xFFFF;
+    return erases;
+}
+
+static bool openSector(MsgLog& log, uint16_t s, uint32_t erases) {
+    // Magic goes on last: a header cut short by power loss never reads as valid, so a half-opened
+    // sector cannot win the next mount with a garbled first_msg/clear_msg
+    MsgSectorHdr h = { MSG_SECTOR_MAGIC, log.next_seq, log.next_msg, log.clear_msg, erases };
+    uint32_t addr = sectorAddr(log, s);
+    if (!log.ops->program(addr + sizeof(h.magic), &h.seq, sizeof(h) - sizeof(h.magic)) ||
+        !log.ops->program(addr, &h.magic, sizeof(h.magic))) return false;
+    log.index[s] = { h.seq, h.first_msg };
+    log.next_seq++;
+    log.head = s;
+    log.head_off = sizeof(MsgSectorHdr);
+    log.head_erases = erases;
+
+    // Erase the next sector now, while the head fills up — it holds the oldest messages
+    uint16_t n = nextSector(log, s);
+    log.next_erases = eraseSector(log, n);
+    log.next_erased = true;
+    return true;
+}
+
+static bool advanceHead(MsgLog& log) {
+    uint16_t s = nextSector(log, log.head);
+    uint32_t erases = log.next_erased ? log.next_erases : eraseSector(log, s);
+    log.next_erased = false;
+    return openSector(log, s, erases);
+}
+
+void msgLogFormat(MsgLog& log) {
+    // Continue above any sequence still on flash so stale sectors never win a later mount
+    uint32_t top = 0;
+    for (uint16_t s = 0; s < log.sectors; s++) {
+        MsgSectorHdr h;
+        if (readSectorHdr(log, s, h) && h.seq > top) top = h.seq;
+        log.index[s] = { 0, 0 };
+    }
+    log.next_seq = top + 1;
+    log.next_msg = 0;
+    log.clear_msg = 0;
+    log.cur_sector = 0xFFFF;
+    log.next_erased = false;
+    log.head = log.sectors - 1;     // advanceHead() opens sector 0
+    advanceHead(log);
+}
+
+bool msgLogMount(MsgLog& log) {
+    log.cur_sector = 0xFFFF;
+    log.next_erased = false;
+    log.replayed = 0;
+
+    uint32_t best = 0;
+    for (uint16_t s = 0; s < log.sectors; s++) {
+        MsgSectorHdr h;
+        if (readSectorHdr(log, s, h)) {
+            log.index[s] = { h.seq, h.first_msg };
+            if (h.seq > best) {
+                best = h.seq;
+                log.head = s;
+                log.clear_msg = h.clear_msg;
+                log.head_erases = h.erases;
+            }
+        } else {
+            log.index[s] = { 0, 0 };
+        }
+    }
+    if (best == 0) {
+        msgLogFormat(log);
+        return false;
+    }
+    log.next_seq = best + 1;
+
+    // Replay the head sector only: find the write offset, the last message and any clear
+    uint32_t base = sectorAddr(log, log.head);
+    uint32_t off = sizeof(MsgSectorHdr);
+    uint32_t msg = log.index[log.head].first_msg;
+    while (off + sizeof(MsgRecHdr) + MSG_COMMIT_SIZE <= FLASH_SECTOR_SIZE) {
+        MsgRecHdr r;
+        if (!log.ops->read(base + off, &r, sizeof(r)) || r.magic == MSG_ERASED16) break;
+        uint32_t size = recSize(r.len);
+        if (r.magic != MSG_REC_MAGIC || r.len > MSG_LOG_MAX_LEN || off + size > FLASH_SECTOR_SIZE) {
+            // Header itself is damaged — nothing after it can be trusted; seal the sector
+            log.torn++;
+            off = FLASH_SECTOR_SIZE;
+            break;
+        }
+        uint32_t commit;
+        if (log.ops->read(base + off + size - MSG_COMMIT_SIZE, &commit, sizeof(commit)) && commit == 0) {
+            log.replayed++;
+            if (r.flags & MSG_REC_CLEAR) log.clear_msg = r.msg;
+            else msg = r.msg + 1;
+        } else {
+            log.torn++;     // Power was cut before the commit word — the slot stays dead
+        }
+        off += size;
+    }
+    log.head_off = off;
+    log.next_msg = msg;
+    return true;
+}
+
+static bool writeRecord(MsgLog& log, uint32_t msg, uint8_t flags, const uint8_t* src, uint8_t src_len,
+                        const uint8_t* payload, uint16_t len) {
+    uint32_t size = recSize(len);
+    if (log.head_off + size > FLASH_SECTOR_SIZE && !advanceHead(log)) return false;
+
+    MsgRecHdr r;
+    memset(&r, 0xFF, sizeof(r));
+    r.magic = MSG_REC_MAGIC;
+    r.len = len;
+    r.msg = msg;
+    r.src_len = src_len < MSG_LOG_SRC_LEN ? src_len : MSG_LOG_SRC_LEN;
+    memset(r.src, 0, sizeof(r.src));
+    if (src) memcpy(r.src, src, r.src_len);
+    r.flags = flags;
+    r.check = payloadCheck(payload, len);
+
+    // Advance first: a failed write leaves a torn record behind, never a half-used slot
+    uint32_t addr = sectorAddr(log, log.head) + log.head_off;
+    log.head_off += size;
+    static const uint32_t commit = 0;
+    bool ok = log.ops->program(addr, &r, sizeof(r)) &&
+              (len == 0 || log.ops->program(addr + sizeof(r), payload, len)) &&
+              log.ops->program(addr + size - MSG_COMMIT_SIZE, &commit, sizeof(commit));
+    if (ok) {
+        log.appends++;
+        log.bytes += size;
+    }
+    return ok;
+}
+
+bool msgLogAppend(MsgLog& log, const uint8_t* src, uint8_t src_len, const uint8_t* payload, uint16_t len) {
+    uint8_t flags = 0;
+    if (len > MSG_LOG_MAX_LEN) {
+        len = MSG_LOG_MAX_LEN;
+        flags |= MSG_REC_TRUNCATED;
+    }
+    if (!writeRecord(log, log.next_msg, flags, src, src_len, payload, len)) return false;
+    log.next_msg++;
+    return true;
+}
+
+void msgLogClear(MsgLog& log) {
+    writeRecord(log, log.next_msg, MSG_REC_CLEAR, nullptr, 0, nullptr, 0);
+    log.clear_msg = log.next_msg;
+    log.cur_sector = 0xFFFF;
+}
+
+// Oldest sector still in the log — normally two past the head (the one in between is pre-erased)
+static uint16_t tailSector(const MsgLog& log) {
+    uint16_t s = nextSector(log, log.head);
+    while (s != log.head && log.index[s].seq == 0) s = nextSector(log, s);
+    return s;
+}
+
+uint32_t msgLogFirst(const MsgLog& log) {
+    uint32_t first = log.index[tailSector(log)].first_msg;
+    return first > log.clear_msg ? first : log.clear_msg;
+}
+
+uint32_t msgLogCount(const MsgLog& log) {
+    return log.next_msg - msgLogFirst(log);
+}
+
+// Sector holding message m: binary search over the ring from tail to head (first_msg ascends)
+static uint16_t findSector(const MsgLog& log, uint32_t m) {
+    uint16_t tail = tailSector(log);
+    uint16_t n = (log.head + log.sectors - tail) % log.sectors + 1;
+    uint16_t lo = 0, hi = n - 1;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi + 1) / 2;
+        if (log.index[(tail + mid) % log.sectors].first_msg <= m) lo = mid;
+        else hi = mid - 1;
+    }
+    return (tail + lo) % log.sectors;
+}
+
+bool msgLogRead(MsgLog& log, uint32_t i, MsgLogEntry& out, uint8_t* payload, uint16_t cap) {
+    uint32_t m = msgLogFirst(log) + i;
+    if (m >= log.next_msg) return false;
+
+    uint16_t s = findSector(log, m);
+    uint32_t off = sizeof(MsgSectorHdr);
+    if (log.cur_sector == s && log.cur_msg <= m) off = log.cur_off;
+
+    uint32_t base = sectorAddr(log, s);
+    uint32_t end = s == log.head ? log.head_off : FLASH_SECTOR_SIZE;
+    while (off + sizeof(MsgRecHdr) + MSG_COMMIT_SIZE <= end) {
+        MsgRecHdr r;
+        if (!log.ops->read(base + off, &r, sizeof(r)) || r.magic != MSG_REC_MAGIC || r.len > MSG_LOG_MAX_LEN) break;
+        uint32_t size = recSize(r.len);
+        uint32_t commit;
+        bool committed = log.ops->read(base + off + size - MSG_COMMIT_SIZE, &commit, sizeof(commit)) && commit == 0;
+        if (committed && !(r.flags & MSG_REC_CLEAR) && r.msg == m) {
+            out.msg = r.msg;
+            out.len = r.len;
+            memcpy(out.src, r.src, sizeof(out.src));
+            out.src_len = r.src_len;
+            out.flags = r.flags;
+            uint16_t n = r.len < cap ? r.len : cap;
+            if (n && !log.ops->read(base + off + sizeof(r), payload, n)) return false;
+            if (n == r.len && payloadCheck(payload, n) != r.check) return false;
+            log.cur_sector = s;
+            log.cur_off = off + size;
+            log.cur_msg = m + 1;
+            return true;
+        }
+        off += size;
+    }
+    return false;
+}
+
+int msgLogExportHex(MsgLog& log, const char* tag, uint32_t from, char* out, size_t out_len) {
+    static const char hex[] = "0123456789ABCDEF";
+    static uint8_t rec[MSG_LOG_MAX_LEN];
+    const size_t tail = 20;             // "}{NEXT:4294967295}" + NUL
+
+    uint32_t first = msgLogFirst(log);
+    if (from < first) from = first;     // Older records dropped out while the dump was running
+    int n = snprintf(out, out_len, "OK{%s:%lu:", tag, (unsigned long)from);
+    if (n < 0 || (size_t)n + tail >= out_len) return n;
+
+    uint32_t m = from;
+    for (; m < log.next_msg; m++) {
+        MsgLogEntry e;
+        bool ok = msgLogRead(log, m - first, e, rec, sizeof(rec));
+        uint16_t len = ok ? e.len : 0;
+        size_t need = (m > from ? 1 : 0) + 2 * (size_t)len;
+        if ((size_t)n + need + tail > out_len) {
+            if (m > from) break;
+            len = 0;                    // Cannot fit even alone — skip it rather than stall the dump
+        }
+        if (m > from) out[n++] = ',';
+        // An unreadable (torn) record stays as an empty entry so the numbering holds
+        for (uint16_t i = 0; i < len; i++) {
+            out[n++] = hex[rec[i] >> 4];
+            out[n++] = hex[rec[i] & 0x0F];
+        }
+    }
+    out[n++] = '}';
+    out[n] = '\0';
+    if (m < log.next_msg) n += snprintf(out + n, out_len - n, "{NEXT:%lu}", (unsigned long)m);
+    return n;
+}
@@ -0,0 +1,103 @@
+// msg_log.h — Append-only, log-structured message store on NOR flash (FlashOps)
+
+#ifndef MSG_LOG_H
+#define MSG_LOG_H
+
+#include <Arduino.h>
+#include "qspi_flash.h"
+
+// The log is a ring of FLASH_SECTOR_SIZE sectors written strictly in order, so every sector is
+// erased equally often (wear levelling by rotation). Each sector opens with a MsgSectorHdr; records
+// never straddle sectors. A record is written as header + payload, then its 4-byte commit word is
+// programmed 0xFFFFFFFF → 0 — a record without it (power cut mid-write) is skipped on replay.
+//
+// RAM index: one MsgSectorIndex per sector (sector sequence + number of the first message in it).
+// Message n is found by binary search over the index and a walk of one sector's records. Mount
+// reads the sector headers and replays only the newest sector.
+//
+// When the ring wraps the oldest sector is erased and its messages drop out of the log. The sector
+// after the head is erased as soon as the head opens, so the (slow) erase overlaps normal work
+// instead of landing on the next append.
+
+#define MSG_LOG_MAX_LEN         512         // Payload bytes per record (longest reassembled TXT)
+#define MSG_LOG_SRC_LEN         4
+
+struct __attribute__((packed)) MsgSectorHdr {
+    uint32_t magic;         // MSG_SECTOR_MAGIC
+    uint32_t seq;           // Sector sequence, +1 per opened sector — newest wins on mount
+    uint32_t first_msg;     // Number of the first message written into this sector
+    uint32_t clear_msg;     // Messages below this number were cleared
+    uint32_t erases;        // Erase count of this sector (wear statistics)
+};
+
+struct __attribute__((packed)) MsgRecHdr {
+    uint16_t magic;         // MSG_REC_MAGIC
+    uint16_t len;           // Payload bytes
+    uint32_t msg;           // Message number (MSG_REC_CLEAR: new clear_msg)
+    uint8_t  src[MSG_LOG_SRC_LEN];
+    uint8_t  src_len;
+    uint8_t  flags;         // MSG_REC_*
+    uint16_t _pad;
+    uint32_t check;         // FNV-1a of the payload
+};
+
+#define MSG_REC_CLEAR           (1 << 0)    // Control record: hide everything below msg
+#define MSG_REC_TRUNCATED       (1 << 1)    // Payload was cut at MSG_LOG_MAX_LEN
+
+struct MsgSectorIndex {
+    uint32_t seq;           // 0 = erased / not part of the log
+    uint32_t first_msg;
+};
+
+struct MsgLog {
+    const FlashOps* ops;
+    uint32_t base;
+    uint16_t sectors;
+    MsgSectorIndex* index;  // [sectors]
+
+    uint16_t head;          // Sector being appended to
+    uint32_t head_off;      // Write offset in it
+    uint32_t next_seq;      // Sequence for the next opened sector
+    uint32_t next_msg;      // Number for the next message
+    uint32_t clear_msg;
+    uint32_t head_erases;
+    bool     next_erased;   // Sector after head was erased this session (pre-erase)
+    uint32_t next_erases;   // Its erase count
+
+    // Lookup cursor — sequential reads continue the walk instead of restarting it
+    uint16_t cur_sector;
+    uint32_t cur_off;
+    uint32_t cur_msg;
+
+    // Stats
+    uint32_t appends;
+    uint32_t erases;
+    uint32_t bytes;
+    uint32_t replayed;      // Records read back by the last mount
+    uint32_t torn;          // Uncommitted or damaged records skipped
+};
+
+struct MsgLogEntry {
+    uint32_t msg;
+    uint16_t len;           // Payload bytes stored
+    uint8_t  src[MSG_LOG_SRC_LEN];
+    uint8_t  src_len;
+    uint8_t  flags;
+};
+
+// ops/base/sectors/index must be set; formats the area when it holds no valid log
+bool msgLogMount(MsgLog& log);
+void msgLogFormat(MsgLog& log);
+bool msgLogAppend(MsgLog& log, const uint8_t* src, uint8_t src_len, const uint8_t* payload, uint16_t len);
+// Visible messages, oldest first
+uint32_t msgLogCount(const MsgLog& log);
+uint32_t msgLogFirst(const MsgLog& log);
+// Message i (0 = oldest visible); copies up to cap payload bytes, out.len is the stored length
+bool msgLogRead(MsgLog& log, uint32_t i, MsgLogEntry& out, uint8_t* payload, uint16_t cap);
+void msgLogClear(MsgLog& log);
+// Bulk export for BLE replies: "OK{<tag>:<from>:<hex>,<hex>,...}{NEXT:<n>}" — payloads of messages
+// from, from+1, ... hex-encoded, as many as fit out_len. An empty entry is a record that could not
+// be read. NEXT is omitted once the dump has reached the head; from below the oldest starts there.
+int msgLogExportHex(MsgLog& log, const char* tag, uint32_t from, char* out, size_t out_len);
+
+#endif
@@ -4,6 +4,7 @@
 #include <cstring>  // For strncpy and memcpy
 
 #include "lora.h"
+#include "epoch_clock.h"
 
 extern void sendSerialToApp(const String& msg);
 extern void sendSerialToAppLn(const String& msg);
@@ -19,7 +20,13 @@ Packet::Packet()
       testCounter(0),// Initialize packetCounter to 0
        gpsData(""),           // Add gpsData as an empty string if you store it
       sendDateTime(""),      // Add sendDateTime as an empty string
-      beacon_callSign("")   // Initialize call sign to empty
+      sendEpoch(0),
+      has_pos(false),
+      beacon_lat(0),
+      beacon_lon(0),
+      beacon_battery(0),
+      beacon_callSign(""),  // Initialize call sign to empty
+      beacon_interval_s(0)
 {}
 
 Packet::~Packet() {
@@ -208,6 +215,9 @@ bool Packet::parseHeader(uint8_t* buffer, uint16_t bufferSize) {
     } else if (strncmp((char*)buffer, "REQ", 3) == 0 && index == 3) {
         type = "REQ";
         sendSerialToAppLn(F("Type determined: REQ (Retransmit Request)"));
+    } else if (strncmp((char*)buffer, "WPT", 3) == 0 && index == 3) {
+        type = "WAYPOINT";
+        sendSerialToAppLn(F("Type determined: WAYPOINT"));
     } else if (strncmp((char*)buffer, "B", 1) == 0 && buffer[1] != '~') {
         // Peer beacon packet — type is already "BEACON" from the check below
         type = "BEACON";
@@ -278,118 +288,149 @@ bool Packet::parseHeader(uint8_t* buffer, uint16_t bufferSize) {
 
         // If we have found a field, process the field identifier and value
         if (fieldLength >= 2) {
-            char fieldType[3];
-            strncpy(fieldType, (char*)(buffer + fieldStart), 2);  // Extract the 2-character field type
-            fieldType[2] = '\0';
-
-            // Move past the field identifier
-            fieldStart += 2;
-            fieldLength -= 2;
-
-            sendSerialToApp(F("Field type extracted: "));
-            sendSerialToAppLn(fieldType);
-
-            // Process the fields: PC (packet counter), SD (Send DateTime), GP (GPS Data)
-            if (strcmp(fieldType, "PC") == 0) {
-                // Packet Counter (PC)
-                if (fieldLength > 0) {
-                    char packetCounterStr[fieldLength + 1];
-                    strncpy(packetCounterStr, (char*)(buffer + fieldStart), fieldLength);
-                    packetCounterStr[fieldLength] = '\0';  // Null-terminate the string
-                    packetCounter = atoi(packetCounterStr);  // Convert to integer
-                    sendSerialToApp(F("Packet counter (PC) determined: "));
-                    sendSerialToAppLn((String)packetCounter);
-                }
-            } else if (strcmp(fieldType, "SD") == 0) {
-                // Send DateTime (SD) — always take first 14 chars as YYYYMMDDHHMMSS
-                // The value may be followed by other data (e.g. device ID in beacons)
-                if (fieldLength > 0) {
-                    int len = fieldLength < 14 ? fieldLength : 14;
-                    char dateTimeStr[15];
-                    strncpy(dateTimeStr, (char*)(buffer + fieldStart), len);
-                    dateTimeStr[len] = '\0';
-                    sendDateTime = String(dateTimeStr);
-                    sendSerialToApp(F("Send DateTime (SD) determined: "));
-                    sendSerialToAppLn(sendDateTime);
-                }
-            } else if (strcmp(fieldType, "GP") == 0) {
-                // GPS data (GP) — store as-is for RANGE/other uses
-                if (fieldLength > 0) {  // Ensure some data is available for GPS
-                    char gpsStr[fieldLength + 1];  // +1 for null terminator
-                    strncpy(gpsStr, (char*)(buffer + fieldStart), fieldLength);
-                    gpsStr[fieldLength] = '\0';  // Null-terminate the string
-                    gpsData = String(gpsStr);  // Store as string or parse as needed
-                    sendSerialToApp(F("GPS data (GP) determined: "));
-                    sendSerialToAppLn(gpsData);
-                }
-                
-                // For beacon packets, also parse ~GP as lat,lon for distance calc
-                if (type == "BEACON") {
-                    char gpStr[fieldLength + 1];
-                    strncpy(gpStr, (char*)(buffer + fieldStart), fieldLength);
-                    gpStr[fieldLength] = '\0';
-                    const char* comma = strchr(gpStr, ',');
-                    if (comma) {
-                        beacon_lat = atof(gpStr);
-                        beacon_lon = atof(comma + 1);
-                    }
-                }
-            } else if (strcmp(fieldType, "BT") == 0) {
-                // Beacon battery percentage
-                if (type == "BEACON") {
-                    char battStr[fieldLength + 1];
-                    strncpy(battStr, (char*)(buffer + fieldStart), fieldLength);
-                    battStr[fieldLength] = '\0';
-                    beacon_battery = (uint8_t)atoi(battStr);
-                }
-            } else if (strcmp(fieldType, "CN") == 0) {
-                // Beacon call sign from buddy list
-                if (type == "BEACON") {
-                    char cnStr[fieldLength + 1];
-                    strncpy(cnStr, (char*)(buffer + fieldStart), fieldLength);
-                    cnStr[fieldLength] = '\0';
-                    memset(beacon_callSign, 0, sizeof(beacon_callSign));
-                    strncpy(beacon_callSign, cnStr, 16);
-                    beacon_callSign[16] = '\0';
-                }
-            } else {
-                // Unknown field type
-                sendSerialToApp(F("Unknown field: "));
-                sendSerialToAppLn(fieldType);
-            }
+            parseField((const char*)(buffer + fieldStart), fieldLength);
         }
     }
 
+    // sendPacket() inserts ~PC~SD~~ after the first three characters, so the rest of a beacon
+    // (device ID, ~CN, ~PP) and the position of TXT / TXM frames come after the "~~"
+    if (type == "BEACON" || type == "TXT" || type == "TXT_MULTI" || type == "WAYPOINT") {
+        parseTailFields(buffer, index, bufferSize);
+    }
+
     return true;
 }
 
-// Function to compare device's current time with the received 'sendDateTime'
-bool Packet::isTimeOutOfSync() {
-    if (sendDateTime.length() != 14) {
-        return false;  // Invalid timestamp, skip comparison
+// Leading "~XX" fields of the content. A short prefix before the first '~' is skipped (the rest
+// of a beacon's device ID, TXM "A1/3"). Stops at "~~", at the end, or after ~ST, whose value runs
+// straight into the message text.
+void Packet::parseTailFields(uint8_t* buffer, uint16_t start, uint16_t bufferSize) {
+    uint16_t index = start;
+    while (index < bufferSize && index - start < 12 && buffer[index] != '~' && buffer[index] != 0) {
+        index++;
     }
+    if (type == "BEACON" && beacon_deviceId.length() == 0) {
+        // "B" + the first two ID characters went in front of the header, the rest behind it
+        beacon_deviceId = String((char)buffer[1]) + (char)buffer[2];
+        for (uint16_t i = start; i < index; i++) beacon_deviceId += (char)buffer[i];
+    }
+    while (index + 2 < bufferSize && buffer[index] == '~' && buffer[index + 1] != '~') {
+        uint16_t fieldStart = ++index;
+        while (index < bufferSize && buffer[index] != '~' && buffer[index] != 0) {
+            index++;
+        }
+        if (index - fieldStart >= 2) {
+            parseField((const char*)(buffer + fieldStart), index - fieldStart);
+        }
+        if (strncmp((const char*)(buffer + fieldStart), "ST", 2) == 0) break;
+    }
+}
 
-    // Get the current time from the RTC
-    RTC_Date currentTime = rtc.getDateTime();
-
-    // Extract components from sendDateTime (assumed format is "YYYYMMDDHHMMSS")
-    int year = sendDateTime.substring(0, 4).toInt();
-    int month = sendDateTime.substring(4, 6).toInt();
-    int day = sendDateTime.substring(6, 8).toInt();
-    int hour = sendDateTime.substring(8, 10).toInt();
-    int minute = sendDateTime.substring(10, 12).toInt();
-    int second = sendDateTime.substring(12, 14).toInt();
-
-    // Compare the received time with the local RTC time
-    long receivedTimeSeconds = hour * 3600 + minute * 60 + second;
-    long currentTimeSeconds = currentTime.hour * 3600 + currentTime.minute * 60 + currentTime.second;
+void Packet::parseField(const char* field, uint16_t fieldLength) {
+    char fieldType[3] = { field[0], field[1], '\0' };
+    const char* value = field + 2;
+    fieldLength -= 2;
+
+    sendSerialToApp(F("Field type extracted: "));
+    sendSerialToAppLn(fieldType);
+
+    // Process the fields: PC (packet counter), SD (Send DateTime), GP / PP (position)
+    if (strcmp(fieldType, "PC") == 0) {
+        // Packet Counter (PC)
+        if (fieldLength > 0) {
+            char packetCounterStr[fieldLength + 1];
+            strncpy(packetCounterStr, value, fieldLength);
+            packetCounterStr[fieldLength] = '\0';  // Null-terminate the string
+            packetCounter = atoi(packetCounterStr);  // Convert to integer
+            sendSerialToApp(F("Packet counter (PC) determined: "));
+            sendSerialToAppLn((String)packetCounter);
+        }
+    } else if (strcmp(fieldType, "SD") == 0) {
+        // Send DateTime (SD) — always take first 14 chars as YYYYMMDDHHMMSS
+        // The value may be followed by other data (e.g. device ID in beacons)
+        if (fieldLength > 0) {
+            int len = fieldLength < 14 ? fieldLength : 14;
+            char dateTimeStr[15];
+            strncpy(dateTimeStr, value, len);
+            dateTimeStr[len] = '\0';
+            sendDateTime = String(dateTimeStr);
+            if (!clockParseSD(value, fieldLength, &sendEpoch)) sendEpoch = 0;
+            sendSerialToApp(F("Send DateTime (SD) determined: "));
+            sendSerialToAppLn(sendDateTime);
+        }
+    } else if (strcmp(fieldType, "GP") == 0) {
+        // GPS data (GP) — store as-is for RANGE/other uses
+        if (fieldLength > 0) {  // Ensure some data is available for GPS
+            char gpsStr[fieldLength + 1];  // +1 for null terminator
+            strncpy(gpsStr, value, fieldLength);
+            gpsStr[fieldLength] = '\0';  // Null-terminate the string
+            gpsData = String(gpsStr);  // Store as string or parse as needed
+            sendSerialToApp(F("GPS data (GP) determined: "));
+            sendSerialToAppLn(gpsData);
+        }
+        setPosition(posDecodeAscii(value, fieldLength, &pos));
+    } else if (strcmp(fieldType, "PP") == 0) {
+        // Packed position — pos_codec.h
+        setPosition(posDecode(value, fieldLength, &pos));
+        if (has_pos && pos.battery >= 0 && type == "BEACON") {
+            beacon_battery = (uint8_t)pos.battery;
+        }
+    } else if (strcmp(fieldType, "BT") == 0) {
+        // Beacon battery percentage
+        if (type == "BEACON") {
+            char battStr[fieldLength + 1];
+            strncpy(battStr, value, fieldLength);
+            battStr[fieldLength] = '\0';
+            beacon_battery = (uint8_t)atoi(battStr);
+        }
+    } else if (strcmp(fieldType, "CN") == 0) {
+        // Beacon call sign from buddy list
+        if (type == "BEACON") {
+            memset(beacon_callSign, 0, sizeof(beacon_callSign));
+            strncpy(beacon_callSign, value, fieldLength < 16 ? fieldLength : 16);
+            beacon_callSign[16] = '\0';
+        }
+    } else if (strcmp(fieldType, "BI") == 0) {
+        // Beacon interval in seconds — the peer's liveness timeout follows it
+        if (type == "BEACON") {
+            char ivStr[8];
+            uint16_t n = fieldLength < sizeof(ivStr) - 1 ? fieldLength : sizeof(ivStr) - 1;
+            strncpy(ivStr, value, n);
+            ivStr[n] = '\0';
+            long iv = atol(ivStr);
+            beacon_interval_s = (uint16_t)(iv < 0 ? 0 : iv > 65535 ? 65535 : iv);
+        }
+    } else if (strcmp(fieldType, "ST") == 0 || strcmp(fieldType, "DI") == 0 || strcmp(fieldType, "MH") == 0) {
+        // TXT send time / probe device ID / mesh header (mesh_relay.cpp) — read elsewhere
+    } else {
+        // Unknown field type
+        sendSerialToApp(F("Unknown field: "));
+        sendSerialToAppLn(fieldType);
+    }
+}
 
-    // Calculate the time difference in seconds
-    long timeDifference = abs(receivedTimeSeconds - currentTimeSeconds);
+void Packet::setPosition(bool ok) {
+    has_pos = ok;
+    if (!ok) {
+        sendSerialToAppLn(F("Position field not decoded"));
+        return;
+    }
+    // For beacon packets, also keep lat,lon for the roster distance
+    if (type == "BEACON") {
+        beacon_lat = pos.lat;
+        beacon_lon = pos.lon;
+    }
+}
 
-    //Serial.print(F("Time difference: "));
-    //Serial.println(timeDifference);
+// Function to compare device's current time with the received 'sendDateTime'
+bool Packet::isTimeOutOfSync() {
+    if (sendEpoch == 0) {
+        return false;  // Invalid timestamp, skip comparison
+    }
 
-    // Define a threshold (e.g., 5 seconds) to determine if sync is lost
-    return timeDifference > 1;  // Time difference greater than 1 seconds indicates sync loss
+    // Time of day only, like the hop schedule
+    long diff = (long)(sendEpoch % 86400UL) - (long)clockSecondOfDay();
+    if (diff > 43200) diff -= 86400;
+    else if (diff < -43200) diff += 86400;
+    return abs(diff) > 1;  // Time difference greater than 1 seconds indicates sync loss
 }
\ No newline at end of file
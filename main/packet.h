@@ -2,6 +2,7 @@
 #define PACKET_H
 
 #include <Arduino.h>
+#include "pos_codec.h"
 
 class Packet {
 public:
@@ -16,13 +17,19 @@ public:
     uint32_t testCounter;   // Message counter to track duplicates or for other purposes
     String gpsData;         // GPS data
     String sendDateTime;    // Send date and time
+    uint32_t sendEpoch;     // ~SD as Unix seconds, parsed once (epoch_clock.h) — 0 = none
+
+    // Sender position from ~PP (packed) or ~GP (ASCII) — beacons, TXT / TXM and WPT frames
+    bool    has_pos;
+    PosFix  pos;
 
     // Beacon-specific fields (populated when type == "BEACON")
-    double  beacon_lat;      // Latitude from ~GP field
-    double  beacon_lon;      // Longitude from ~GP field
-    uint8_t beacon_battery;  // Battery from ~BT field
+    double  beacon_lat;      // Latitude from ~PP / ~GP field
+    double  beacon_lon;      // Longitude from ~PP / ~GP field
+    uint8_t beacon_battery;  // Battery from the ~PP nibble or ~BT field
     String  beacon_deviceId; // Device ID (changed from String, max 15 + null)
     char    beacon_callSign[17]; // Call sign from ~CN field (max 16 bytes + null)
+    uint16_t beacon_interval_s; // Sender's beacon interval from ~BI (beacon_sched.h), 0 = not given
 
     // Constructor
     Packet();
@@ -50,6 +57,9 @@ public:
 
 private:
     bool parseHeader(uint8_t* buffer, uint16_t bufferSize);
+    void parseTailFields(uint8_t* buffer, uint16_t start, uint16_t bufferSize);
+    void parseField(const char* field, uint16_t fieldLength);
+    void setPosition(bool ok);
 };
 
 #endif
@@ -0,0 +1,245 @@
+// peer_roster.cpp — Roster slots, LRU chain, distance order, dead reckoning
+
+#include "peer_roster.h"
+#include "geodesy.h"
+#include <math.h>
+
+static RosterPeer s_peer[ROSTER_MAX];
+static uint8_t s_order[ROSTER_MAX];         // Used slots, nearest first
+static uint8_t s_count = 0;
+static uint8_t s_oldest = ROSTER_NONE;
+static uint8_t s_newest = ROSTER_NONE;
+static uint32_t s_revision = 0;
+static uint32_t s_last_tick = 0;
+
+// Stats
+static uint32_t s_added = 0;
+static uint32_t s_evicted = 0;
+static uint32_t s_expired = 0;
+static uint32_t s_moves = 0;                // Order positions shifted, update + tick
+static uint32_t s_tick_us = 0;
+static uint32_t s_tick_max_us = 0;
+
+static uint32_t idHash(const char* id) {
+    uint32_t h = 2166136261u;
+    while (*id) h = (h ^ (uint8_t)*id++) * 16777619u;
+    return h;
+}
+
+static void lruUnlink(uint8_t k) {
+    RosterPeer& p = s_peer[k];
+    if (p.older != ROSTER_NONE) s_peer[p.older].newer = p.newer;
+    else s_oldest = p.newer;
+    if (p.newer != ROSTER_NONE) s_peer[p.newer].older = p.older;
+    else s_newest = p.older;
+    p.older = p.newer = ROSTER_NONE;
+}
+
+static void lruPushNewest(uint8_t k) {
+    s_peer[k].older = s_newest;
+    s_peer[k].newer = ROSTER_NONE;
+    if (s_newest != ROSTER_NONE) s_peer[s_newest].newer = k;
+    else s_oldest = k;
+    s_newest = k;
+}
+
+// a goes in front of b: by distance, peers without one last and newest first among them
+static bool before(const RosterPeer& a, const RosterPeer& b) {
+    bool da = a.flags & ROSTER_F_DIST, db = b.flags & ROSTER_F_DIST;
+    if (da != db) return da;
+    if (da) return a.distanceM < b.distanceM;
+    return (int32_t)(a.lastSeen - b.lastSeen) > 0;
+}
+
+// Moves s_order[i] left or right into place
+static void reposition(int i) {
+    uint8_t k = s_order[i];
+    while (i > 0 && before(s_peer[k], s_peer[s_order[i - 1]])) {
+        s_order[i] = s_order[i - 1];
+        i--;
+        s_moves++;
+    }
+    while (i + 1 < s_count && before(s_peer[s_order[i + 1]], s_peer[k])) {
+        s_order[i] = s_order[i + 1];
+        i++;
+        s_moves++;
+    }
+    s_order[i] = k;
+}
+
+static int orderIndex(uint8_t k) {
+    for (int i = 0; i < s_count; i++) {
+        if (s_order[i] == k) return i;
+    }
+    return -1;
+}
+
+// Extrapolated position and its distance from our last fix
+static void locate(RosterPeer& p, uint32_t now) {
+    p.dr_lat_e6 = p.lat_e6;
+    p.dr_lon_e6 = p.lon_e6;
+    if ((p.flags & ROSTER_F_MOTION) && p.speed_mps >= ROSTER_DR_MIN_MPS) {
+        uint32_t dt = now - p.lastSeen;
+        if (dt > ROSTER_DR_MAX_MS) dt = ROSTER_DR_MAX_MS;
+        float d = p.speed_mps * (dt * 0.001f);
+        float c = p.course_deg * (float)DEG_TO_RAD;
+        int32_t lat = p.lat_e6 + (int32_t)lroundf(d * cosf(c) / GEO_M_PER_E6);
+        p.dr_lat_e6 = constrain(lat, -90000000L, 90000000L);
+        float kx = geoLonScale(p.dr_lat_e6);
+        if (kx > 1e-3f) {
+            int32_t lon = p.lon_e6 + (int32_t)lroundf(d * sinf(c) / kx);
+            if (lon > 180000000) lon -= 360000000;
+            else if (lon < -180000000) lon += 360000000;
+            p.dr_lon_e6 = lon;
+        }
+    }
+    if ((p.flags & ROSTER_F_POS) && geoOriginValid()) {
+        p.distanceM = geoFromOriginDistanceE6(p.dr_lat_e6, p.dr_lon_e6);
+        p.flags |= ROSTER_F_DIST;
+    }
+}
+
+static void removeSlot(uint8_t k) {
+    int i = orderIndex(k);
+    if (i >= 0) {
+        memmove(&s_order[i], &s_order[i + 1], (s_count - i - 1) * sizeof(s_order[0]));
+        s_count--;
+    }
+    lruUnlink(k);
+    s_peer[k].flags = 0;
+}
+
+static void copyStr(char* dst, const char* src, size_t cap) {
+    strncpy(dst, src ? src : "", cap - 1);
+    dst[cap - 1] = '\0';
+}
+
+int rosterUpdate(const char* id, const char* callSign, const PosFix* pos, uint8_t battery,
+                 uint32_t timeout_ms, uint32_t now) {
+    if (!id || !id[0]) return -1;
+    uint32_t h = idHash(id);
+
+    int k = -1;
+    for (uint8_t i = 0; i < s_count; i++) {
+        const RosterPeer& p = s_peer[s_order[i]];
+        if (p.idHash == h && strncmp(p.id, id, ROSTER_ID_LEN) == 0) {
+            k = s_order[i];
+            break;
+        }
+    }
+
+    if (k < 0) {
+        if (s_count < ROSTER_MAX) {
+            for (k = 0; s_peer[k].flags & ROSTER_F_USED; k++) {}
+            s_order[s_count++] = k;
+        } else {
+            // Full — the least recently heard peer gives up its slot (and its place in s_order)
+            k = s_oldest;
+            lruUnlink(k);
+            s_evicted++;
+        }
+        RosterPeer& p = s_peer[k];
+        memset(&p, 0, sizeof(p));
+        copyStr(p.id, id, sizeof(p.id));
+        p.idHash = h;
+        p.flags = ROSTER_F_USED;
+        p.older = p.newer = ROSTER_NONE;
+        s_added++;
+    } else {
+        lruUnlink(k);
+    }
+    lruPushNewest(k);
+
+    RosterPeer& p = s_peer[k];
+    copyStr(p.callSign, callSign, sizeof(p.callSign));
+    // A beacon without a position keeps the last one, but not moving it any further
+    p.flags &= ~ROSTER_F_MOTION;
+    if (pos) {
+        p.lat_e6 = geoE6(pos->lat);
+        p.lon_e6 = geoE6(pos->lon);
+        p.flags |= ROSTER_F_POS;
+        if (pos->flags & POS_F_MOTION) {
+            p.speed_mps = pos->speed_mps;
+            p.course_deg = pos->course_deg;
+            p.flags |= ROSTER_F_MOTION;
+        }
+    }
+    p.battery = battery;
+    p.lastSeen = now;
+    p.timeoutMs = timeout_ms;
+    locate(p, now);
+    reposition(orderIndex(k));
+    s_revision++;
+    return k;
+}
+
+void rosterTick(uint32_t now) {
+    if (now - s_last_tick < ROSTER_TICK_MS) return;
+    s_last_tick = now;
+    if (!s_count) return;
+    uint32_t t0 = micros();
+    bool changed = false;
+
+    for (int i = s_count - 1; i >= 0; i--) {
+        uint8_t k = s_order[i];
+        RosterPeer& p = s_peer[k];
+        if (now - p.lastSeen > p.timeoutMs) {
+            removeSlot(k);
+            s_expired++;
+            changed = true;
+            continue;
+        }
+        long step = lroundf(p.distanceM / ROSTER_DIST_STEP_M);
+        uint8_t flags = p.flags;
+        locate(p, now);
+        if (lroundf(p.distanceM / ROSTER_DIST_STEP_M) != step || p.flags != flags) changed = true;
+    }
+
+    // Insertion sort — the order from the last tick is nearly right
+    uint32_t moves = s_moves;
+    for (int i = 1; i < s_count; i++) {
+        uint8_t k = s_order[i];
+        int j = i;
+        while (j > 0 && before(s_peer[k], s_peer[s_order[j - 1]])) {
+            s_order[j] = s_order[j - 1];
+            j--;
+            s_moves++;
+        }
+        s_order[j] = k;
+    }
+    if (changed || s_moves != moves) s_revision++;
+
+    s_tick_us = micros() - t0;
+    if (s_tick_us > s_tick_max_us) s_tick_max_us = s_tick_us;
+}
+
+uint8_t rosterCount() {
+    return s_count;
+}
+
+const RosterPeer* rosterNearest(uint8_t i) {
+    return i < s_count ? &s_peer[s_order[i]] : nullptr;
+}
+
+const char* rosterName(const RosterPeer* p) {
+    return p->callSign[0] != '\0' ? p->callSign : p->id;
+}
+
+uint32_t rosterRevision() {
+    return s_revision;
+}
+
+void rosterClear() {
+    memset(s_peer, 0, sizeof(s_peer));
+    s_count = 0;
+    s_oldest = s_newest = ROSTER_NONE;
+    s_revision++;
+}
+
+int rosterFormatStats(char* out, size_t out_len) {
+    return snprintf(out, out_len,
+                    "OK{ROSTERSTATS:n=%u,cap=%u,added=%lu,evicted=%lu,expired=%lu,moves=%lu,tick_us=%lu,tick_max_us=%lu}",
+                    s_count, (unsigned)ROSTER_MAX, (unsigned long)s_added, (unsigned long)s_evicted,
+                    (unsigned long)s_expired, (unsigned long)s_moves, (unsigned long)s_tick_us,
+                    (unsigned long)s_tick_max_us);
+}
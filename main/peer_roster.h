@@ -0,0 +1,65 @@
+// peer_roster.h — Peers heard in BEACON mode: LRU slots, distance order, dead reckoning
+
+#ifndef PEER_ROSTER_H
+#define PEER_ROSTER_H
+
+#include <Arduino.h>
+#include "pos_codec.h"
+
+// ROSTER_MAX fixed slots, no heap. Peers are found by an FNV-1a hash of the device ID, chained
+// least → most recently heard; a new peer in a full roster takes the least recently heard slot.
+//
+// s_order keeps the slots sorted by distance (peers without one last, newest first). A beacon
+// moves its own peer to its new place; rosterTick() moves every peer that reported speed and
+// course along that course for the time since its beacon (at most ROSTER_DR_MAX_MS), takes the
+// distance from our latest fix and re-sorts — an insertion sort, which is linear on an order that
+// barely changed. It also drops peers past their timeout (beacon_sched.h). The display and screen
+// sync only read rosterNearest().
+
+#define ROSTER_MAX              64
+#define ROSTER_ID_LEN           15
+#define ROSTER_TICK_MS          1000
+#define ROSTER_DR_MIN_MPS       0.5f        // Slower than this is GPS jitter — no extrapolation
+#define ROSTER_DR_MAX_MS        300000
+#define ROSTER_DIST_STEP_M      10          // A tick only counts as a change beyond this (e-paper)
+
+#define ROSTER_F_USED           (1 << 0)
+#define ROSTER_F_POS            (1 << 1)    // Reported a position
+#define ROSTER_F_MOTION         (1 << 2)    // ... with speed and course
+#define ROSTER_F_DIST           (1 << 3)    // distanceM is valid (we had a fix)
+
+struct RosterPeer {
+    char     id[ROSTER_ID_LEN + 1];
+    char     callSign[17];
+    uint32_t idHash;
+    int32_t  lat_e6, lon_e6;        // As reported
+    int32_t  dr_lat_e6, dr_lon_e6;  // Extrapolated to the last tick
+    float    speed_mps, course_deg;
+    float    distanceM;             // To the extrapolated position
+    uint32_t lastSeen;              // millis()
+    uint32_t timeoutMs;
+    uint8_t  battery;
+    uint8_t  flags;                 // ROSTER_F_*
+    uint8_t  older, newer;          // LRU chain, ROSTER_NONE at the ends
+};
+
+#define ROSTER_NONE             0xFF
+
+// Adds or refreshes a peer. pos may be null. Returns the slot, -1 for an empty ID.
+int rosterUpdate(const char* id, const char* callSign, const PosFix* pos, uint8_t battery,
+                 uint32_t timeout_ms, uint32_t now);
+// Loop context — dead reckoning, distances, order, timeouts; every ROSTER_TICK_MS
+void rosterTick(uint32_t now);
+uint8_t rosterCount();
+// i-th nearest, nullptr past the end
+const RosterPeer* rosterNearest(uint8_t i);
+// Call sign if known, else the device ID
+const char* rosterName(const RosterPeer* p);
+// Bumped whenever a peer, the order or a distance (by ROSTER_DIST_STEP_M) changed
+uint32_t rosterRevision();
+void rosterClear();
+
+// "OK{ROSTERSTATS:n=..,cap=..,added=..,evicted=..,expired=..,moves=..,tick_us=..,tick_max_us=..}"
+int rosterFormatStats(char* out, size_t out_len);
+
+#endif
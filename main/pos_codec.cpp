@@ -0,0 +1,245 @@
+#include "pos_codec.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char B64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Last full 24-bit fix sent, and the last POS_RX_REFS received — the reference of a delta. Frames
+// from several senders interleave on the air, so the decoder finds the reference by its tag rather
+// than taking the latest full fix.
+struct PosRef {
+    int32_t  lat, lon;      // 24-bit grid
+    uint32_t tag;           // 24 bits
+    uint32_t ms;
+    bool     valid;
+};
+static PosRef s_tx;
+static PosRef s_rx[POS_RX_REFS];
+static uint8_t s_rx_next = 0;
+
+static int32_t gridLat(double lat) {
+    long v = lround(lat * (8388608.0 / 90.0));
+    return v > 8388607 ? 8388607 : v < -8388608 ? -8388608 : (int32_t)v;
+}
+
+static int32_t gridLon(double lon) {
+    long v = lround(lon * (8388608.0 / 180.0));
+    if (v >= 8388608) v -= 16777216;        // +180° is -180°
+    return v < -8388608 ? -8388608 : (int32_t)v;
+}
+
+// 24-bit check of a full fix: the low byte goes out right after the flags, bits 8-23 as tag2.
+static uint32_t refTag(int32_t lat, int32_t lon) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < 3; i++) {
+        h = (h ^ (uint8_t)(lat >> (8 * i))) * 16777619u;
+        h = (h ^ (uint8_t)(lon >> (8 * i))) * 16777619u;
+    }
+    return (uint8_t)(h ^ h >> 8 ^ h >> 16 ^ h >> 24) | (h & 0xFFFF00);
+}
+
+static void rxRemember(int32_t lat, int32_t lon) {
+    // A relayed copy of a fix we already hold is not stored twice, so it cannot look ambiguous
+    for (PosRef& r : s_rx) {
+        if (r.valid && r.lat == lat && r.lon == lon) return;
+    }
+    PosRef& r = s_rx[s_rx_next];
+    s_rx_next = (s_rx_next + 1) % POS_RX_REFS;
+    r.lat = lat;
+    r.lon = lon;
+    r.tag = refTag(lat, lon);
+    r.valid = true;
+}
+
+// The one remembered fix the tag names; null if none or several do
+static const PosRef* rxFind(uint32_t tag) {
+    const PosRef* found = nullptr;
+    for (const PosRef& r : s_rx) {
+        if (!r.valid || r.tag != tag) continue;
+        if (found) return nullptr;
+        found = &r;
+    }
+    return found;
+}
+
+static void put24(uint8_t* p, int32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+}
+
+static int32_t get24(const uint8_t* p) {
+    int32_t v = p[0] | p[1] << 8 | p[2] << 16;
+    return v & 0x800000 ? v - 0x1000000 : v;
+}
+
+static void put32(uint8_t* p, int32_t v) {
+    put24(p, v);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static int32_t get32(const uint8_t* p) {
+    return (int32_t)((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+}
+
+size_t posEncode(const PosFix& f, bool allow_delta, uint32_t now_ms, char* out, size_t out_len) {
+    uint8_t rec[POS_RECORD_MAX];
+    uint8_t flags = f.flags & (POS_F_ALT | POS_F_MOTION | POS_F_HIRES);
+    uint8_t batt = f.battery < 0 ? 0 : 1 + ((f.battery >= 100 ? 100 : f.battery) * 14 + 50) / 100;
+    size_t n = 1;
+
+    if (flags & POS_F_HIRES) {
+        put32(rec + n, (int32_t)lround(f.lat * 1e7));
+        put32(rec + n + 4, (int32_t)lround(f.lon * 1e7));
+        n += 8;
+    } else {
+        int32_t la = gridLat(f.lat), lo = gridLon(f.lon);
+        int32_t dla = la - s_tx.lat, dlo = lo - s_tx.lon;
+        if (dlo > 8388607) dlo -= 16777216;
+        else if (dlo < -8388608) dlo += 16777216;
+        if (allow_delta && s_tx.valid && now_ms - s_tx.ms <= POS_DELTA_MAX_MS &&
+            dla >= -128 && dla <= 127 && dlo >= -128 && dlo <= 127) {
+            flags |= POS_F_DELTA;
+            rec[n++] = (uint8_t)s_tx.tag;
+            rec[n++] = (uint8_t)(int8_t)dla;
+            rec[n++] = (uint8_t)(int8_t)dlo;
+        } else {
+            put24(rec + n, la);
+            put24(rec + n + 3, lo);
+            n += 6;
+            s_tx.lat = la;
+            s_tx.lon = lo;
+            s_tx.tag = refTag(la, lo);
+            s_tx.ms = now_ms;
+            s_tx.valid = true;
+        }
+    }
+    if (flags & POS_F_ALT) {
+        long a = lroundf(f.alt_m);
+        int16_t alt = a > 32767 ? 32767 : a < -32768 ? -32768 : (int16_t)a;
+        rec[n++] = (uint8_t)alt;
+        rec[n++] = (uint8_t)(alt >> 8);
+    }
+    if (flags & POS_F_MOTION) {
+        long s = lroundf(f.speed_mps * 2);
+        rec[n++] = (uint8_t)(s > 255 ? 255 : s < 0 ? 0 : s);
+        float c = fmodf(f.course_deg, 360.0f);
+        if (c < 0) c += 360.0f;
+        rec[n++] = (uint8_t)((long)lroundf(c * (256.0f / 360.0f)) & 0xFF);
+    }
+    // Tag bits 8-23, after the optional fields
+    if (flags & POS_F_DELTA) {
+        rec[n++] = (uint8_t)(s_tx.tag >> 8);
+        rec[n++] = (uint8_t)(s_tx.tag >> 16);
+    }
+    rec[0] = flags | batt;
+
+    // base64url, no padding
+    size_t chars = (n * 8 + 5) / 6;
+    if (chars + 1 > out_len) return 0;
+    uint32_t acc = 0;
+    int bits = 0;
+    size_t o = 0;
+    for (size_t i = 0; i < n; i++) {
+        acc = acc << 8 | rec[i];
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            out[o++] = B64[(acc >> bits) & 0x3F];
+        }
+    }
+    if (bits) out[o++] = B64[(acc << (6 - bits)) & 0x3F];
+    out[o] = '\0';
+    return o;
+}
+
+static int b64Value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '-') return 62;
+    if (c == '_') return 63;
+    return -1;
+}
+
+bool posDecode(const char* s, size_t len, PosFix* f) {
+    uint8_t rec[POS_RECORD_MAX];
+    size_t n = 0;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < len && n < sizeof(rec); i++) {
+        int v = b64Value(s[i]);
+        if (v < 0) break;
+        acc = acc << 6 | v;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            rec[n++] = (uint8_t)(acc >> bits);
+        }
+    }
+    if (n < 1) return false;
+
+    uint8_t flags = rec[0] & 0xF0;
+    size_t need = 1 + ((flags & POS_F_HIRES) ? 8 : (flags & POS_F_DELTA) ? 3 + 2 : 6) +
+                  ((flags & POS_F_ALT) ? 2 : 0) + ((flags & POS_F_MOTION) ? 2 : 0);     // Delta: + tag2
+    if (n < need) return false;
+
+    size_t i = 1;
+    if (flags & POS_F_HIRES) {
+        f->lat = get32(rec + 1) * 1e-7;
+        f->lon = get32(rec + 5) * 1e-7;
+        i += 8;
+    } else {
+        int32_t la, lo;
+        if (flags & POS_F_DELTA) {
+            const PosRef* ref = rxFind(rec[1] | rec[need - 2] << 8 | rec[need - 1] << 16);
+            if (!ref) return false;
+            la = ref->lat + (int8_t)rec[2];
+            lo = ref->lon + (int8_t)rec[3];
+            if (lo > 8388607) lo -= 16777216;
+            else if (lo < -8388608) lo += 16777216;
+            i += 3;
+        } else {
+            la = get24(rec + 1);
+            lo = get24(rec + 4);
+            i += 6;
+            rxRemember(la, lo);
+        }
+        f->lat = la * (90.0 / 8388608.0);
+        f->lon = lo * (180.0 / 8388608.0);
+    }
+    f->alt_m = 0;
+    f->speed_mps = 0;
+    f->course_deg = 0;
+    if (flags & POS_F_ALT) {
+        f->alt_m = (int16_t)(rec[i] | rec[i + 1] << 8);
+        i += 2;
+    }
+    if (flags & POS_F_MOTION) {
+        f->speed_mps = rec[i] * 0.5f;
+        f->course_deg = rec[i + 1] * (360.0f / 256.0f);
+        i += 2;
+    }
+    uint8_t batt = rec[0] & 0x0F;
+    f->battery = batt ? (int8_t)(((batt - 1) * 100 + 7) / 14) : -1;
+    f->flags = flags;
+    return f->lat >= -90 && f->lat <= 90 && f->lon >= -180 && f->lon <= 180;
+}
+
+bool posDecodeAscii(const char* s, size_t len, PosFix* f) {
+    char buf[32];
+    if (len >= sizeof(buf)) len = sizeof(buf) - 1;
+    memcpy(buf, s, len);
+    buf[len] = '\0';
+    const char* comma = strchr(buf, ',');
+    if (!comma) return false;
+    f->lat = atof(buf);
+    f->lon = atof(comma + 1);
+    f->alt_m = 0;
+    f->speed_mps = 0;
+    f->course_deg = 0;
+    f->battery = -1;
+    f->flags = 0;
+    return f->lat >= -90 && f->lat <= 90 && f->lon >= -180 && f->lon <= 180;
+}
@@ -0,0 +1,58 @@
+#ifndef POS_CODEC_H
+#define POS_CODEC_H
+
+// Packed position record for LoRa frames — plain C++, no Arduino types, so the same encoder /
+// decoder builds for host-side tools.
+//
+// Travels as the ~PP field in place of ~GP<lat>,<lon> (and the beacon's ~BT<percent>):
+//   [flags | battery]              high nibble POS_F_*, low nibble battery (0 = not given,
+//                                  1..15 = 0..100 %)
+//   full   lat, lon                24-bit two's complement, 90° / 2^23 and 180° / 2^23 per step
+//                                  (1.2 m and 2.4 m x cos lat) — 32-bit, 1e-7°, with POS_F_HIRES
+//   delta  tag, dlat, dlon         1 byte check of the last full fix + int8 steps of the 24-bit
+//                                  grid (±150 m north-south) — only right after a full fix
+//   [alt]                          int16 metres                      POS_F_ALT
+//   [speed, course]                0.5 m/s, 360° / 256               POS_F_MOTION
+//   [tag2]                         2 more check bytes                delta only
+// then base64url without padding, so the field never holds '~', ',' or NUL. A beacon fix with
+// battery and motion is 9 bytes: "~PP" + 12 characters, against 26 for "~GP52.370216,4.895168~BT87".
+//
+// The decoder keeps the last POS_RX_REFS full fixes it decoded, whoever sent them, and resolves a
+// delta to the one its 24-bit check (tag and tag2) names — none or more than one and the delta is
+// dropped, so a delta whose own reference was lost lands on another sender's fix only on a 24-bit
+// collision. A delta without tag2 is malformed and dropped.
+//
+// The decoder takes both forms — posDecodeAscii() reads the old "<lat>,<lon>" text.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define POS_F_DELTA         0x80
+#define POS_F_ALT           0x40
+#define POS_F_MOTION        0x20
+#define POS_F_HIRES         0x10
+
+#define POS_RECORD_MAX      13          // flags + 8 + 2 + 2
+#define POS_FIELD_MAX       18          // base64url of POS_RECORD_MAX
+#define POS_DELTA_MAX_MS    30000       // A delta only refers to a full fix sent this recently
+#define POS_RX_REFS         8           // Full fixes received that a delta may refer to
+
+struct PosFix {
+    double  lat, lon;       // Degrees
+    float   alt_m;          // POS_F_ALT
+    float   speed_mps;      // POS_F_MOTION
+    float   course_deg;
+    int8_t  battery;        // Percent, -1 = not given
+    uint8_t flags;          // POS_F_* — what the record carries (or should carry)
+};
+
+// Encodes the fields named in f.flags. allow_delta: send a delta if a full 24-bit fix went out
+// within POS_DELTA_MAX_MS (now_ms) and the step fits. Returns the field length, 0 if it won't fit.
+size_t posEncode(const PosFix& f, bool allow_delta, uint32_t now_ms, char* out, size_t out_len);
+// Reads base64url up to the first character outside the alphabet. False for a short record or a
+// delta whose reference fix this decoder has not seen (or cannot tell apart).
+bool posDecode(const char* s, size_t len, PosFix* f);
+// "<lat>,<lon>" — the ~GP field of older firmware
+bool posDecodeAscii(const char* s, size_t len, PosFix* f);
+
+#endif
@@ -0,0 +1,68 @@
+// qspi_flash.cpp — QSPI NOR flash through Adafruit SPIFlash, plus the RAM disk backend
+
+#include "qspi_flash.h"
+#include "utilities.h"
+#include <Adafruit_SPIFlashBase.h>     // Raw sector access only — no FAT layer (SdFat)
+
+// IO0/IO1 are the MOSI/MISO lines in single-SPI mode
+static Adafruit_FlashTransport_QSPI s_transport(Flash_Sclk, Flash_Cs, Flash_Mosi, Flash_Miso, Flash_Io2, Flash_Io3);
+static Adafruit_SPIFlashBase s_flash(&s_transport);
+static bool s_ready = false;
+
+bool qspiFlashInit() {
+    if (s_ready) return true;
+    s_ready = s_flash.begin() && s_flash.size() >= QSPI_FLASH_SIZE;
+    return s_ready;
+}
+
+bool qspiFlashReady() { return s_ready; }
+
+static bool qspiRead(uint32_t addr, void* buf, uint32_t len) {
+    return s_flash.readBuffer(addr, (uint8_t*)buf, len) == len;
+}
+
+static bool qspiProgram(uint32_t addr, const void* buf, uint32_t len) {
+    return s_flash.writeBuffer(addr, (const uint8_t*)buf, len) == len;
+}
+
+// Returns once the command is issued; the next read/program waits for the erase to finish
+static bool qspiErase(uint32_t addr) {
+    return s_flash.eraseSector(addr / FLASH_SECTOR_SIZE);
+}
+
+static const FlashOps s_qspi_ops = { qspiRead, qspiProgram, qspiErase };
+
+const FlashOps& qspiFlashOps() { return s_qspi_ops; }
+
+// ── RAM disk ──
+static uint8_t* s_ram = nullptr;
+static uint32_t s_ram_size = 0;
+
+void ramDiskAttach(uint8_t* buf, uint32_t size) {
+    s_ram = buf;
+    s_ram_size = size;
+}
+
+static bool ramRead(uint32_t addr, void* buf, uint32_t len) {
+    if (!s_ram || addr + len > s_ram_size) return false;
+    memcpy(buf, s_ram + addr, len);
+    return true;
+}
+
+// AND, like a NOR page program
+static bool ramProgram(uint32_t addr, const void* buf, uint32_t len) {
+    if (!s_ram || addr + len > s_ram_size) return false;
+    const uint8_t* src = (const uint8_t*)buf;
+    for (uint32_t i = 0; i < len; i++) s_ram[addr + i] &= src[i];
+    return true;
+}
+
+static bool ramErase(uint32_t addr) {
+    if (!s_ram || addr + FLASH_SECTOR_SIZE > s_ram_size) return false;
+    memset(s_ram + addr, 0xFF, FLASH_SECTOR_SIZE);
+    return true;
+}
+
+static const FlashOps s_ram_ops = { ramRead, ramProgram, ramErase };
+
+const FlashOps& ramDiskOps() { return s_ram_ops; }
@@ -0,0 +1,42 @@
+// qspi_flash.h — On-board 2 MiB QSPI NOR flash (MX25R1635F) and a RAM disk with the same interface
+
+#ifndef QSPI_FLASH_H
+#define QSPI_FLASH_H
+
+#include <Arduino.h>
+
+// NOR rules apply to both backends: erase sets a whole sector to 0xFF, program can only clear
+// bits. Log-structured stores (msg_log) rely on that to commit records in place.
+#define FLASH_SECTOR_SIZE       4096
+
+// ── QSPI flash map ──
+#define QSPI_FLASH_SIZE         (2UL * 1024 * 1024)
+#define QSPI_MSG_BASE           0x000000UL                  // Message log (text_inbox)
+#define QSPI_MSG_SECTORS        254
+#define QSPI_BENCH_BASE         (QSPI_MSG_BASE + QSPI_MSG_SECTORS * FLASH_SECTOR_SIZE)
+#define QSPI_BENCH_SECTORS      2                           // Scratch for MSGBENCH
+#define QSPI_BUDDY_BASE         0x100000UL                  // Contact directory (buddy_list)
+#define QSPI_BUDDY_SECTORS      18                          // 9 pages x 2 copies
+#define QSPI_CAP_BASE           (QSPI_BUDDY_BASE + QSPI_BUDDY_SECTORS * FLASH_SECTOR_SIZE)
+#define QSPI_CAP_SECTORS        128                         // LoRa capture ring (lora_capture)
+#define QSPI_TRACK_BASE         (QSPI_CAP_BASE + QSPI_CAP_SECTORS * FLASH_SECTOR_SIZE)
+#define QSPI_TRACK_SECTORS      64                          // GPS track log (track_log)
+#define QSPI_FREE_BASE          (QSPI_TRACK_BASE + QSPI_TRACK_SECTORS * FLASH_SECTOR_SIZE)
+
+struct FlashOps {
+    bool (*read)(uint32_t addr, void* buf, uint32_t len);
+    bool (*program)(uint32_t addr, const void* buf, uint32_t len);
+    bool (*erase)(uint32_t addr);       // One FLASH_SECTOR_SIZE sector; addr is sector-aligned
+};
+
+// Probe the chip (JEDEC ID) — false if it does not answer
+bool qspiFlashInit();
+bool qspiFlashReady();
+const FlashOps& qspiFlashOps();
+
+// RAM disk over a caller-owned buffer (fallback when the flash is missing, MSGBENCH reference).
+// Only one RAM disk is attached at a time.
+void ramDiskAttach(uint8_t* buf, uint32_t size);
+const FlashOps& ramDiskOps();
+
+#endif
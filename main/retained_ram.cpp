@@ -0,0 +1,106 @@
+// retained_ram.cpp — The .noinit block, layout checks and the boot-time validator
+
+#include "retained_ram.h"
+
+// Section flags are spelled out as NOBITS so the block takes no space in the flash image; the
+// trailing '@' starts an assembler comment and swallows the flags GCC appends. The core's linker
+// script does not name .noinit, so ld places it as an orphan after .bss — outside the ranges the
+// startup code copies (.data) and zeroes (.bss), below the heap.
+RetainedRam g_retained __attribute__((section(".noinit,\"aw\",%nobits@"), aligned(8)));
+
+// ── Layout checks ──
+// Regions must follow each other without overlap, in RetainedId order, inside the budget.
+#define RR_END(f)   (offsetof(RetainedRam, f) + sizeof(((RetainedRam*)0)->f))
+
+static_assert(offsetof(RetainedRam, crash) == 0, "crash region must open the block");
+static_assert(offsetof(RetainedRam, waypoints) >= RR_END(crash), "waypoint region overlaps crash region");
+static_assert(offsetof(RetainedRam, dbglog) >= RR_END(waypoints), "debug log region overlaps waypoint region");
+static_assert(offsetof(RetainedRam, guard) >= RR_END(dbglog), "guard word overlaps debug log region");
+static_assert(sizeof(RetainedRam) <= RETAINED_RAM_MAX, "retained regions exceed RETAINED_RAM_MAX");
+static_assert(sizeof(CrashRecord) < 0x10000 && sizeof(WaypointStore) < 0x10000 && sizeof(DebugLog) < 0x10000, "region body too large for RetainedHdr.size");
+static_assert(RR_COUNT <= 8, "retainedInit() reports regions in a uint8_t mask");
+
+struct RegionDesc {
+    RetainedHdr* hdr;
+    uint8_t*     body;
+    uint16_t     size;
+    uint8_t      version;
+    const char*  name;
+};
+
+#define RR_DESC(f, n) { &g_retained.f.hdr, (uint8_t*)&g_retained.f.body, (uint16_t)sizeof(g_retained.f.body), \
+                        decltype(g_retained.f)::version, n }
+
+// Indexed by RetainedId
+static const RegionDesc s_regions[RR_COUNT] = {
+    RR_DESC(crash, "crash"),
+    RR_DESC(waypoints, "wp"),
+    RR_DESC(dbglog, "dbg"),
+};
+
+static_assert(decltype(g_retained.crash)::id == RR_CRASH &&
+              decltype(g_retained.waypoints)::id == RR_WAYPOINT && decltype(g_retained.dbglog)::id == RR_DBGLOG,
+              "s_regions[] must be indexed by RetainedId");
+
+static uint8_t s_repaired = 0;
+
+static uint32_t bodyCheck(const uint8_t* p, uint16_t len) {
+    uint32_t h = 2166136261u;
+    for (uint16_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+bool retainedValid(RetainedId id) {
+    if (id >= RR_COUNT) return false;
+    const RegionDesc& r = s_regions[id];
+    const RetainedHdr& h = *r.hdr;
+    return h.magic == RETAINED_HDR_MAGIC && h.id == id && h.version == r.version && h.size == r.size &&
+           h.check == bodyCheck(r.body, r.size);
+}
+
+void retainedSeal(RetainedId id) {
+    if (id >= RR_COUNT) return;
+    const RegionDesc& r = s_regions[id];
+    r.hdr->magic = RETAINED_HDR_MAGIC;
+    r.hdr->id = id;
+    r.hdr->version = r.version;
+    r.hdr->size = r.size;
+    r.hdr->_pad = 0;
+    r.hdr->check = bodyCheck(r.body, r.size);
+}
+
+uint8_t retainedInit() {
+    s_repaired = 0;
+    for (uint8_t i = 0; i < RR_COUNT; i++) {
+        if (retainedValid((RetainedId)i)) continue;
+        memset(s_regions[i].body, 0, s_regions[i].size);
+        retainedSeal((RetainedId)i);
+        s_repaired |= 1 << i;
+    }
+    g_retained.guard = RETAINED_GUARD;
+    return s_repaired;
+}
+
+uint8_t retainedRepaired() { return s_repaired; }
+
+void retainedCrashStreakEnd() {
+    CrashRecord& c = g_retained.crash.body;
+    if (!c.crash_count) return;
+    c.crash_count = 0;
+    retainedSeal(RR_CRASH);
+}
+
+int retainedFormat(char* out, size_t out_len) {
+    int n = snprintf(out, out_len, "RR");
+    for (uint8_t i = 0; i < RR_COUNT && n > 0 && (size_t)n < out_len; i++) {
+        n += snprintf(out + n, out_len - n, " %s=%s", s_regions[i].name,
+                      (s_repaired & (1 << i)) ? "repaired" : "ok");
+    }
+    if (n > 0 && (size_t)n < out_len) {
+        n += snprintf(out + n, out_len - n, " used=%u/%u", (unsigned)sizeof(RetainedRam), (unsigned)RETAINED_RAM_MAX);
+    }
+    return n;
+}
@@ -0,0 +1,143 @@
+// retained_ram.h — RAM that survives a reset: one .noinit block, typed regions, boot validation
+
+#ifndef RETAINED_RAM_H
+#define RETAINED_RAM_H
+
+#include <Arduino.h>
+#include <stddef.h>
+
+// Everything that has to outlive NVIC_SystemReset / a watchdog reset lives in g_retained, a single
+// struct in the .noinit section: the startup code neither copies nor zeroes it, and the linker
+// places it like any other variable, so it can never land on top of .data/.bss, the heap or
+// another store. Regions are members of that struct — the compiler does the allocation, the
+// static_asserts in retained_ram.cpp check the result against RETAINED_RAM_MAX.
+//
+// Each region opens with a RetainedHdr (id, layout version, body size, FNV-1a of the body).
+// retainedInit() runs first thing in setup() and re-initialises only the regions whose header or
+// check does not match — after a power cycle, a firmware update that moved or resized the block,
+// or a stray write. Owners call retainedSeal() after changing a body.
+//
+// Bump a region's version whenever its body layout changes; old contents are then dropped on the
+// next boot instead of being misread.
+
+#define RETAINED_RAM_MAX        16384       // Budget for the whole block
+#define RETAINED_HDR_MAGIC      0x5252      // "RR"
+
+enum RetainedId : uint8_t {
+    RR_CRASH = 0,
+    RR_WAYPOINT,
+    RR_DBGLOG,
+    RR_COUNT
+};
+
+struct RetainedHdr {
+    uint16_t magic;         // RETAINED_HDR_MAGIC
+    uint8_t  id;            // RetainedId
+    uint8_t  version;
+    uint16_t size;          // sizeof(body)
+    uint16_t _pad;
+    uint32_t check;         // FNV-1a over the body
+};
+
+template <typename T, RetainedId ID, uint8_t VERSION>
+struct RetainedRegion {
+    static const RetainedId id = ID;
+    static const uint8_t version = VERSION;
+    RetainedHdr hdr;
+    T body;
+};
+
+// ── Region bodies ──
+
+#define CRASH_MAGIC        0x43524153  // "CRAS"
+#define CRASH_CLEAN_UPTIME_MS   (10UL * 60 * 1000)  // Running this long without a fault ends a crash streak
+
+// Last HardFault (crash_debug.h / HardFault_Handler); magic is CRASH_MAGIC from the fault until the
+// next boot has reported it, so it marks "this reset was a crash"
+struct CrashRecord {
+    uint32_t    magic;
+    uint32_t    stack_guard_pattern;
+    uint32_t    msp_before_crash;
+    uint32_t    psp_main;
+    uint32_t    psp_isr;
+    uint32_t    lr_at_crash;
+    uint32_t    cfsr;
+    uint32_t    hfsr;
+    uint32_t    bfar;
+    uint32_t    afsr;
+    uint32_t    xPSR;
+    uint32_t    r0, r1, r2, r3;
+    uint32_t    r12, r4, r5, r6, r7, r8, r9, r10, r11;
+    char        function[16];
+    uint32_t    line_number;
+    uint32_t    tick_count;
+    uint32_t    loop_count;
+    uint32_t    free_heap_min;
+    uint32_t    crash_count;    // Faults in a row — zeroed by retainedCrashStreakEnd()
+};
+
+// Waypoint store (waypoint_store.h) — fixed-size POD records, no heap pointers
+#define WP_STORE_MAX            256
+#define WP_LABEL_LEN            18
+#define WP_SENDER_LEN           9       // bleGetDeviceIdShort() — 8 hex digits + NUL
+
+struct WaypointRecord {
+    int32_t  lat_e6;        // 1e-6 degrees
+    int32_t  lon_e6;
+    uint32_t seen;          // WaypointStore.seq when last added or heard — the oldest is evicted
+    int16_t  alt_m;
+    uint8_t  flags;         // WP_F_*
+    uint8_t  hits;          // Copies received (repeated broadcasts), saturates at 255
+    char     label[WP_LABEL_LEN + 1];
+    char     sender[WP_SENDER_LEN];
+};
+
+struct WaypointStore {
+    uint16_t       count;   // rec[0..count) in use
+    uint16_t       _pad;
+    uint32_t       seq;     // +1 per add / repeat
+    WaypointRecord rec[WP_STORE_MAX];
+};
+
+// dbgLog() ring (crash_debug.h) — readable after a reset or from a debugger
+#define DEBUG_LOG_MAX_ENTRIES 32
+
+struct DebugEntry {
+    uint32_t tick;
+    char text[40];
+};
+
+struct DebugLog {
+    uint8_t    idx;
+    uint8_t    _pad[3];
+    DebugEntry entries[DEBUG_LOG_MAX_ENTRIES];
+};
+
+// ── The block ──
+
+#define RETAINED_GUARD          0xDEADBEEF  // Last word — anything else means a region overran
+
+struct RetainedRam {
+    RetainedRegion<CrashRecord,   RR_CRASH,    1> crash;
+    RetainedRegion<WaypointStore, RR_WAYPOINT, 2> waypoints;
+    RetainedRegion<DebugLog,      RR_DBGLOG,   1> dbglog;
+    uint32_t guard;
+};
+
+extern RetainedRam g_retained;
+
+// Validate every region, re-initialise (zero body, new header) only the damaged ones.
+// Returns a bitmask of repaired regions (1 << RetainedId).
+uint8_t retainedInit();
+// Recompute a region's check after its owner changed the body
+void retainedSeal(RetainedId id);
+// Body intact? (header + check)
+bool retainedValid(RetainedId id);
+// Regions repaired by the last retainedInit()
+uint8_t retainedRepaired();
+// "RR crash=ok wp=repaired ... used=N/16384" for the boot log
+int retainedFormat(char* out, size_t out_len);
+// Clean uptime (CRASH_CLEAN_UPTIME_MS) or a clean power-off: the crash streak is over
+void retainedCrashStreakEnd();
+
+#endif
@@ -8,8 +8,11 @@
 #include "settings.h"
 #include "text_inbox.h"
 #include "scan.h"
+#include "peer_roster.h"
+#include "epoch_clock.h"
 
 #include <Arduino.h>
+#include <stdarg.h>
 
 // Forward declarations for functions defined in ble.cpp (not in ble.h)
 extern void sendSerialToApp(const String& msg);
@@ -33,41 +36,147 @@ extern void sendSerialToAppLn(const String& msg);
 
     // Extern declarations for scan.cpp globals
     extern ChannelResult topChannels[];
-    extern int peerRosterCount;
 
-// Payload format (JSON-like, compact):
-// LINE:S|H:{channel_sf}|C:<content_fields>|S:{freq}|T:{time}|G:{sats}|B:{batt}%|I:gpst=ok,bat=N
-// SCAN mode content fields: s{pct}@{current_freq},{ch1_f}{ch1_r},...  (f=freq*10, r=rssi*10)
+// Payload format (compact, '|'-separated sections, ','-separated entries):
+// Keyframe: LINE:S|V:{seq}|M:{mode}|H:{channel_sf}|C:<content_fields>|S:{freq}|T:{time}|G:{sats}|B:{batt}%|I:gpst=ok,bat=N
+// Delta:    LINE:SD|V:{seq},b={base}|<only the sections/entries that changed since {base}>
+// SCAN mode content fields: s{pct}@{current_freq},{ch1_f}{ch1_r},...  (f=freq*100, r=rssi*10)
+//
+// Every field keeps a fingerprint of the value it last rendered and the sync seq in which that
+// value first went out. A delta carries the fields whose version is newer than the last seq the
+// app acknowledged (SYNCACK:{seq}), so a lost delta is repaired by the next one. Keyframes go out
+// on mode change, GETSCREEN, every SYNC_KEYFRAME_MS, whenever a field disappears, and always
+// until the app has acked once on this connection — apps that never ack only ever see LINE:S.
 
 static uint32_t last_sync_ms = 0;
 static const uint32_t SYNC_INTERVAL_MS = 1000; // Throttle: max 1 update per second
 static volatile bool screen_dirty = false;
-static int8_t last_batt_idx = -1;
+
+// ── Field versions ──
+#define SYNC_MAX_FIELDS     48
+#define SYNC_KEYFRAME_MS    30000
+#define SYNC_STAT_MODES     12
+
+struct SyncSlot {
+    uint32_t id;        // Hash of key + row
+    uint32_t fp;        // Fingerprint of the value last rendered
+    uint32_t ver;       // Seq of the sync that first carried this value
+    uint32_t seen;      // Pass that last visited this field
+};
+
+static SyncSlot sync_slots[SYNC_MAX_FIELDS];
+static uint8_t  sync_slot_count = 0;
+static uint32_t sync_seq = 0;           // Seq of the last sync sent
+static uint32_t sync_pass = 0;
+static volatile uint32_t sync_acked = 0;
+static volatile bool sync_delta_ok = false;     // App acked at least once this connection
+static bool     sync_need_key = true;
+static uint32_t last_keyframe_ms = 0;
+static const char* sync_mode = nullptr;         // Mode the slot table belongs to
+
+struct SyncOut {
+    char*    buf;
+    int      off;
+    bool     key;       // Keyframe: render every field
+    uint32_t base;      // Delta: render fields with ver > base
+    char     section;   // Section currently open
+    uint8_t  changed;   // Fields whose value changed this pass
+    uint8_t  written;   // Fields rendered this pass
+};
+
+// Per-mode byte accounting — "full" is what re-sending the whole snapshot would have cost
+struct SyncStats {
+    uint32_t sent_bytes;
+    uint32_t full_bytes;
+    uint32_t active_ms;
+    uint16_t syncs;
+    uint16_t keyframes;
+    uint16_t last_full_len;
+};
+
+static SyncStats sync_stats[SYNC_STAT_MODES];
+static uint32_t sync_stats_mark_ms = 0;
 
 void markScreenDirty() { screen_dirty = true; }
 
-void sendScreenSync() {
-    uint32_t now = millis();
-    if (now - last_sync_ms < SYNC_INTERVAL_MS) return;
-    last_sync_ms = now;
-    screen_dirty = false;
+static uint32_t fnv1a(const char* s, uint32_t h = 2166136261u) {
+    while (s && *s) { h ^= (uint8_t)*s++; h *= 16777619u; }
+    return h;
+}
 
-    if (!display) return;
+static int modeIndex(const char* mode) {
+    for (int i = 0; i < numModes && i < SYNC_STAT_MODES; i++) {
+        if (mode == modes[i] || strcmp(mode, modes[i]) == 0) return i;
+    }
+    return -1;
+}
 
-    char buf[SYNC_MAX_PAYLOAD];
-    int off = 0;
+static SyncSlot* syncSlot(uint32_t id, uint32_t fp, bool& changed) {
+    for (uint8_t i = 0; i < sync_slot_count; i++) {
+        if (sync_slots[i].id != id) continue;
+        changed = sync_slots[i].fp != fp;
+        return &sync_slots[i];
+    }
+    changed = true;
+    if (sync_slot_count >= SYNC_MAX_FIELDS) return nullptr;
+    SyncSlot* s = &sync_slots[sync_slot_count++];
+    s->id = id;
+    s->fp = ~fp;
+    return s;
+}
 
-    // Header: mode + channel/SF info
-    char chan_sf[32];
-    if (strcmp(current_mode, "PTT") == 0) {
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c %dbps", channels[deviceSettings.channel_idx], getBitrateFromIndex(deviceSettings.bitrate_idx));
+static void syncOpen(SyncOut& o, char section) {
+    if (o.section == section) return;
+    o.section = section;
+    o.off += snprintf(o.buf + o.off, SYNC_MAX_PAYLOAD - o.off, "|%c:", section);
+}
+
+// Render one entry if it is new/changed since the acked base (or always, on a keyframe).
+// The fingerprint is compared first, so unchanged fields cost no formatting at all.
+static void syncField(SyncOut& o, char section, const char* key, int row, uint32_t fp, const char* fmt, ...) {
+    bool changed;
+    uint32_t id = fnv1a(key) ^ ((uint32_t)row << 24) ^ (uint32_t)section;
+    SyncSlot* s = syncSlot(id, fp, changed);
+    if (s) {
+        s->seen = sync_pass;
+        if (changed) {
+            s->fp = fp;
+            s->ver = sync_seq + 1;
+            o.changed++;
+        }
+        if (!o.key && s->ver <= o.base) return;
+    } else if (changed) {
+        o.changed++;    // Table full — untracked fields ride every sync
+    }
+
+    if (o.off >= SYNC_MAX_PAYLOAD) return;
+    if (o.section == section) {
+        o.off += snprintf(o.buf + o.off, SYNC_MAX_PAYLOAD - o.off, ",");
     } else {
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+        syncOpen(o, section);
     }
+    if (o.off >= SYNC_MAX_PAYLOAD) return;
+    va_list ap;
+    va_start(ap, fmt);
+    o.off += vsnprintf(o.buf + o.off, SYNC_MAX_PAYLOAD - o.off, fmt, ap);
+    va_end(ap);
+    o.written++;
+}
+
+static inline uint32_t fpFloat(double v, double scale) { return (uint32_t)(int32_t)lround(v * scale); }
 
-    off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "LINE:S|M:%s|H:%s|C:", current_mode, chan_sf);
+static int batteryIconIndex(uint8_t batt_pct) {
+    if (batt_pct > 90) return 6;
+    if (batt_pct > 80) return 5;
+    if (batt_pct > 60) return 4;
+    if (batt_pct > 40) return 3;
+    if (batt_pct > 20) return 2;
+    if (batt_pct > 10) return 1;
+    return 0;
+}
 
-    // Per-mode content fields (app maps these to screen rows)
+// Per-mode content fields (app maps these to screen rows)
+static void buildContent(SyncOut& o) {
     if (strcmp(current_mode, "BEACON") == 0) {
         const char* pn = "---";
         if (beacon_display_name.length() > 0 && beacon_display_name.length() < 64) {
@@ -78,190 +187,262 @@ void sendScreenSync() {
                 pn = (const char*)tmpName;
             }
         }
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "peer_name:%s,", pn);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "peer_dist:%.0fm,", (beacon_display_dist >= 0) ? beacon_display_dist : -1);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "roster_count:%d,", peerRosterCount);
+        double pd = (beacon_display_dist >= 0) ? beacon_display_dist : -1;
+        syncField(o, 'C', "peer_name", 0, fnv1a(pn), "peer_name:%s", pn);
+        syncField(o, 'C', "peer_dist", 0, fpFloat(pd, 1), "peer_dist:%.0fm", pd);
+        syncField(o, 'C', "roster_count", 0, rosterCount(), "roster_count:%d", rosterCount());
 
         // Peer liveness — mirrors the on-device indicator to companion app
         extern bool isPeerAlive();
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "beacon_peer_alive:%d,", (isPeerAlive() ? 1 : 0));
+        bool alive = isPeerAlive();
+        syncField(o, 'C', "beacon_peer_alive", 0, alive, "beacon_peer_alive:%d", alive ? 1 : 0);
 
+        // The five nearest — the roster keeps its order
         int roster_rows = 0;
-        // Guard against corrupted peerRosterCount causing out-of-bounds read
-        int max_roster = peerRosterCount;
-        if (max_roster < 0 || max_roster > 50) {
-            sendSerialToAppLn(F("ERR:sendScreenSync corrupted rosterCount="));
-            sendSerialToAppLn(String(max_roster));
-            max_roster = 0;
-        }
-        for (int i = 0; i < max_roster && roster_rows < 5; i++) {
-            const char* dn = peerRoster[i].callSign[0] != '\0' ? peerRoster[i].callSign : peerRoster[i].deviceId.c_str();
-            float dist = peerRoster[i].distanceM;
-            int batt = peerRoster[i].battery;
+        for (uint8_t i = 0; i < rosterCount() && roster_rows < 5; i++) {
+            const RosterPeer* p = rosterNearest(i);
+            const char* dn = rosterName(p);
+            float dist = (p->flags & ROSTER_F_DIST) ? p->distanceM : 0;
+            int batt = p->battery;
 
-            off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_n=%s,", roster_rows, dn);
+            syncField(o, 'C', "r_n", roster_rows, fnv1a(dn), "r%d_n=%s", roster_rows, dn);
 
             if (dist > 0 && dist < 1000) {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_d=%.0fm,", roster_rows, dist);
+                syncField(o, 'C', "r_d", roster_rows, fpFloat(dist, 1), "r%d_d=%.0fm", roster_rows, dist);
             } else if (dist >= 1000) {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_d=%.1fkm,", roster_rows, dist / 1000.0);
+                syncField(o, 'C', "r_d", roster_rows, fpFloat(dist, 0.01), "r%d_d=%.1fkm", roster_rows, dist / 1000.0);
             } else {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_d=???,", roster_rows);
+                syncField(o, 'C', "r_d", roster_rows, 0xFFFFFFFFu, "r%d_d=???", roster_rows);
             }
 
             if (batt > 0) {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_b=%d%%,", roster_rows, batt);
+                syncField(o, 'C', "r_b", roster_rows, batt, "r%d_b=%d%%", roster_rows, batt);
             } else {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_b=-%%,", roster_rows);
+                syncField(o, 'C', "r_b", roster_rows, 0, "r%d_b=-%%", roster_rows);
             }
 
             roster_rows++;
         }
     }
     else if (strcmp(current_mode, "RANGE") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_role:%s,", range_role_sender ? "Sender" : "Receiver");
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_last_count:%d,", range_last_count);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_consecutive_ok:%d,", range_consecutive_ok);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_total_loss:%d,", range_total_pckt_loss);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_stable_dist:%.1fm,", range_stable_dist);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_max_dist:%.1fm,", range_max_dist);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "home_lat:%.6f,", range_home_lat);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "home_lon:%.6f,", range_home_long);
+        syncField(o, 'C', "range_role", 0, range_role_sender, "range_role:%s", range_role_sender ? "Sender" : "Receiver");
+        syncField(o, 'C', "range_last_count", 0, range_last_count, "range_last_count:%d", range_last_count);
+        syncField(o, 'C', "range_consecutive_ok", 0, range_consecutive_ok, "range_consecutive_ok:%d", range_consecutive_ok);
+        syncField(o, 'C', "range_total_loss", 0, range_total_pckt_loss, "range_total_loss:%d", range_total_pckt_loss);
+        syncField(o, 'C', "range_stable_dist", 0, fpFloat(range_stable_dist, 10), "range_stable_dist:%.1fm", range_stable_dist);
+        syncField(o, 'C', "range_max_dist", 0, fpFloat(range_max_dist, 10), "range_max_dist:%.1fm", range_max_dist);
+        syncField(o, 'C', "home_lat", 0, fpFloat(range_home_lat, 1e6), "home_lat:%.6f", range_home_lat);
+        syncField(o, 'C', "home_lon", 0, fpFloat(range_home_long, 1e6), "home_lon:%.6f", range_home_long);
 
         if (gps_status == GPS_LOC) {
-            off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "curr_lat:%.6f,", gps_latitude);
-            off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "curr_lon:%.6f,", gps_longitude);
+            syncField(o, 'C', "curr_lat", 0, fpFloat(gps_latitude, 1e6), "curr_lat:%.6f", gps_latitude);
+            syncField(o, 'C', "curr_lon", 0, fpFloat(gps_longitude, 1e6), "curr_lon:%.6f", gps_longitude);
         }
     }
     else if (strcmp(current_mode, "PTT") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "ptt_state:%s,", layout_state.ptt_sending ? "TX" : (layout_state.ptt_receiving ? "RX" : "Idle"));
+        const char* st = layout_state.ptt_sending ? "TX" : (layout_state.ptt_receiving ? "RX" : "Idle");
+        syncField(o, 'C', "ptt_state", 0, fnv1a(st), "ptt_state:%s", st);
     }
     else if (strcmp(current_mode, "TXT") == 0) {
-        uint8_t msg_count = inboxCount();
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_inbox_count:%d,", msg_count);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_show_inbox:%d,", txtShowInbox ? 1 : 0);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_scroll_page:%d,", txtInboxScrollPage);
+        uint16_t msg_count = inboxCount();
+        syncField(o, 'C', "txt_inbox_count", 0, msg_count, "txt_inbox_count:%d", msg_count);
+        syncField(o, 'C', "txt_show_inbox", 0, txtShowInbox, "txt_show_inbox:%d", txtShowInbox ? 1 : 0);
+        syncField(o, 'C', "txt_scroll_page", 0, txtInboxScrollPage, "txt_scroll_page:%d", txtInboxScrollPage);
 
         // Peer liveness — mirrors the on-device indicator to companion app
         extern bool isPeerAlive();
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_lora_alive:%d,", (isPeerAlive() ? 1 : 0));
+        bool alive = isPeerAlive();
+        syncField(o, 'C', "txt_lora_alive", 0, alive, "txt_lora_alive:%d", alive ? 1 : 0);
 
         if (!txtShowInbox && msg_count > 0) {
-            uint8_t out_len = 0;
+            uint16_t out_len = 0;
             bool out_trunc = false;
             uint8_t out_sender[4] = {0};
             const char* raw = inboxGet(0, out_len, out_trunc, out_sender);
             if (raw && out_len > 0) {
                 static char sanitized[INBOX_MAX_MSG_LEN];
                 int si = 0;
-                for (uint8_t i = 0; i < out_len && si < sizeof(sanitized) - 1; i++) {
+                for (uint16_t i = 0; i < out_len && si < sizeof(sanitized) - 1; i++) {
                     if (raw[i] == ',') { sanitized[si++] = ':'; }
                     else { sanitized[si++] = raw[i]; }
                 }
                 sanitized[si] = '\0';
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_latest_msg=%s,", sanitized);
+                syncField(o, 'C', "txt_latest_msg", 0, fnv1a(sanitized), "txt_latest_msg=%s", sanitized);
             }
         }
     }
     else if (strcmp(current_mode, "TST") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "tst_sent:%d,", test_message_counter);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "tst_recv:%d,", rcv_test_message_counter);
+        syncField(o, 'C', "tst_sent", 0, test_message_counter, "tst_sent:%d", test_message_counter);
+        syncField(o, 'C', "tst_recv", 0, rcv_test_message_counter, "tst_recv:%d", rcv_test_message_counter);
     }
     else if (strcmp(current_mode, "PONG") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "pong_state:%d,", layout_state.pong_state);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "pong_rtt_ms:%d,", layout_state.pong_rtt_ms);
+        syncField(o, 'C', "pong_state", 0, layout_state.pong_state, "pong_state:%d", layout_state.pong_state);
+        syncField(o, 'C', "pong_rtt_ms", 0, layout_state.pong_rtt_ms, "pong_rtt_ms:%d", layout_state.pong_rtt_ms);
     }
     else if (strcmp(current_mode, "SCAN") == 0) {
-        // Compact scan format: "s{pct}@{freq}{ch1_f_r,ch2_f_r,...}~"
-        // Each channel pair = "{f8digits}r{-3digits}" = 12 bytes (float encoded as fixed-point)
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "s%d@%.0f,", layout_state.scan_progress_pct, currentFrequency);
-        for (int i = 0; i < 5 && topChannels[i].frequency > 0; i++) {
+        // Compact scan format: "s{pct}@{freq},{f8digits}{rssi*10},..." — the app keeps the unkeyed
+        // entries as one string, so progress and the channel list travel as a single field.
+        char scan[96];
+        int n = snprintf(scan, sizeof(scan), "s%d@%.0f", layout_state.scan_progress_pct, currentFrequency);
+        for (int i = 0; i < 5 && topChannels[i].frequency > 0 && n < (int)sizeof(scan); i++) {
             // Encode frequency as integer MHz*100 → 8 digits (preserves .XX precision)
             int freq_100 = (int)(topChannels[i].frequency * 100);
             int rssi_10 = (int)(topChannels[i].rssi * 10);
-            off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "%08d%d,", freq_100, rssi_10);
+            n += snprintf(scan + n, sizeof(scan) - n, ",%08d%d", freq_100, rssi_10);
         }
+        syncField(o, 'C', "scan", 0, fnv1a(scan), "%s", scan);
     }
     else if (strcmp(current_mode, "RAW") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "raw_count:%d,", pckt_count);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "raw_last_rssi=%.1fdBm,", radio->getRSSI());
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "raw_last_snr=%.1fdB,", radio->getSNR());
+        float rssi = radio->getRSSI();
+        float snr = radio->getSNR();
+        syncField(o, 'C', "raw_count", 0, pckt_count, "raw_count:%d", pckt_count);
+        syncField(o, 'C', "raw_last_rssi", 0, fpFloat(rssi, 10), "raw_last_rssi=%.1fdBm", rssi);
+        syncField(o, 'C', "raw_last_snr", 0, fpFloat(snr, 10), "raw_last_snr=%.1fdB", snr);
     }
     else if (strcmp(current_mode, "WP") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_label=%s,", layout_state.wp_label);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_lat=%.6f,", layout_state.wp_lat);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_lon=%.6f,", layout_state.wp_lon);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_alt=%.1fm,", layout_state.wp_alt);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_broadcasting:%d,", layout_state.wp_broadcasting ? 1 : 0);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_bcast_rem:%ds,", layout_state.wp_bcast_remaining_s);
+        syncField(o, 'C', "wp_label", 0, fnv1a(layout_state.wp_label), "wp_label=%s", layout_state.wp_label);
+        syncField(o, 'C', "wp_lat", 0, fpFloat(layout_state.wp_lat, 1e6), "wp_lat=%.6f", layout_state.wp_lat);
+        syncField(o, 'C', "wp_lon", 0, fpFloat(layout_state.wp_lon, 1e6), "wp_lon=%.6f", layout_state.wp_lon);
+        syncField(o, 'C', "wp_alt", 0, fpFloat(layout_state.wp_alt, 10), "wp_alt=%.1fm", layout_state.wp_alt);
+        syncField(o, 'C', "wp_broadcasting", 0, layout_state.wp_broadcasting, "wp_broadcasting:%d", layout_state.wp_broadcasting ? 1 : 0);
+        syncField(o, 'C', "wp_bcast_rem", 0, layout_state.wp_bcast_remaining_s, "wp_bcast_rem:%ds", layout_state.wp_bcast_remaining_s);
     }
+}
 
-    // Status bar: freq, time, GPS sats, battery level
-    char freq_str[16];
-    snprintf(freq_str, sizeof(freq_str), "%.2f", currentFrequency);
+// One pass over the screen state — returns the payload length (0 = nothing to send)
+static int buildSync(char* buf, bool key) {
+    SyncOut o = { buf, 0, key, sync_acked, 0, 0, 0 };
+    sync_pass++;
+
+    if (key) {
+        o.off = snprintf(buf, SYNC_MAX_PAYLOAD, "LINE:S|V:%lu", (unsigned long)(sync_seq + 1));
+    } else {
+        o.off = snprintf(buf, SYNC_MAX_PAYLOAD, "LINE:SD|V:%lu,b=%lu", (unsigned long)(sync_seq + 1), (unsigned long)o.base);
+    }
 
-    RTC_Date dateTime = rtc.getDateTime();
-    char time_str[9];
-    snprintf(time_str, sizeof(time_str), "%02d:%02d", dateTime.hour, dateTime.minute);
+    // Header: mode + channel/SF info
+    bool ptt = strcmp(current_mode, "PTT") == 0;
+    uint32_t h_fp = ((uint32_t)deviceSettings.channel_idx << 16) | (ptt ? 0x8000u | deviceSettings.bitrate_idx : deviceSettings.spreading_factor);
+    syncField(o, 'M', "mode", 0, fnv1a(current_mode), "%s", current_mode);
+    if (ptt) {
+        syncField(o, 'H', "chan_sf", 0, h_fp, "chn:%c %dbps", channels[deviceSettings.channel_idx], getBitrateFromIndex(deviceSettings.bitrate_idx));
+    } else {
+        syncField(o, 'H', "chan_sf", 0, h_fp, "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
+    }
 
+    if (key) syncOpen(o, 'C');
+    buildContent(o);
+
+    // Status bar: freq, time, GPS sats, battery level
+    RTC_Date dateTime = clockDateTime();
     uint8_t batt_pct = getBatteryPercentage();
-    int bat_idx = 6;
-    if (batt_pct > 90) bat_idx = 6;
-    else if (batt_pct > 80) bat_idx = 5;
-    else if (batt_pct > 60) bat_idx = 4;
-    else if (batt_pct > 40) bat_idx = 3;
-    else if (batt_pct > 20) bat_idx = 2;
-    else if (batt_pct > 10) bat_idx = 1;
-    else bat_idx = 0;
-
-    // Only send battery data if icon level changed — avoids flooding from ADC noise
-    bool batt_changed = (bat_idx != last_batt_idx);
-    last_batt_idx = bat_idx;
-
-    // Close content field and add status bar
-    off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "|S:%s|T:%s|G:%d|B:%d%%|I:", freq_str, time_str, gps_satellites, batt_pct);
+    int bat_idx = batteryIconIndex(batt_pct);
+
+    syncField(o, 'S', "freq", 0, fpFloat(currentFrequency, 100), "%.2f", currentFrequency);
+    syncField(o, 'T', "time", 0, dateTime.hour * 60 + dateTime.minute, "%02d:%02d", dateTime.hour, dateTime.minute);
+    syncField(o, 'G', "sats", 0, gps_satellites, "%d", gps_satellites);
+    // Battery percentage is keyed on the icon level — ADC noise (134→135%) maps to the same icon
+    syncField(o, 'B', "batt", 0, bat_idx, "%d%%", batt_pct);
 
     // Icons: icon_name:value pairs (gpst=GPS state, bat=battery icon level)
-    if (gps_status == GPS_LOC) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "gpst=ok,");
-    } else {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "gpst=no%,");
+    bool fix = gps_status == GPS_LOC;
+    syncField(o, 'I', "gpst", 0, fix, fix ? "gpst=ok" : "gpst=no");
+    syncField(o, 'I', "bat", 0, bat_idx, "bat=%d", bat_idx);
+
+    // A field that vanished (GPS fix lost, roster shrank) can't be expressed as a delta
+    bool removed = false;
+    for (uint8_t i = 0; i < sync_slot_count; ) {
+        if (sync_slots[i].seen != sync_pass) {
+            sync_slots[i] = sync_slots[--sync_slot_count];
+            removed = true;
+        } else {
+            i++;
+        }
     }
 
-    off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "bat=%d", bat_idx);
-
-    buf[off] = '\0';
+    if (removed) {
+        sync_need_key = true;
+        if (!key) return buildSync(buf, true);
+    }
 
-    if (off >= SYNC_MAX_PAYLOAD) {
+    if (o.off >= SYNC_MAX_PAYLOAD) {
         sendSerialToAppLn(F("ERR:sendScreenSync buffer overrun off="));
-        sendSerialToAppLn(String(off));
-        return;
+        sendSerialToAppLn(String(o.off));
+        return -1;
     }
-    
-    // Verify queue has room for this large message before attempting to send
-    int pending = getPendingNotificationCount();
-    if (pending > 8) {
-        return;
+    if (!key && o.written == 0) return 0;
+    if (key && o.changed == 0 && !sync_need_key) return 0;
+    buf[o.off] = '\0';
+    return o.off;
+}
+
+// Bytes/min accounting — time is charged to whichever mode was active since the last call
+static void syncAccount(int len, bool key) {
+    uint32_t now = millis();
+    int mi = modeIndex(current_mode);
+    if (mi < 0) return;
+    SyncStats& st = sync_stats[mi];
+    if (sync_stats_mark_ms) st.active_ms += now - sync_stats_mark_ms;
+    sync_stats_mark_ms = now;
+    if (len <= 0) return;
+    if (key) {
+        st.keyframes++;
+        st.last_full_len = (uint16_t)len;
+    }
+    st.syncs++;
+    st.sent_bytes += len;
+    st.full_bytes += st.last_full_len;
+}
+
+static void sendSyncPass(bool force_key) {
+    if (sync_mode != current_mode) {
+        // New mode — different field set, start from a clean table
+        sync_mode = current_mode;
+        sync_slot_count = 0;
+        force_key = true;
     }
+    uint32_t now = millis();
+    bool key = force_key || sync_need_key || !sync_delta_ok || now - last_keyframe_ms >= SYNC_KEYFRAME_MS;
+    if (force_key) sync_need_key = true;
+
+    char buf[SYNC_MAX_PAYLOAD];
+    int len = buildSync(buf, key);
+    if (len < 0) return;
+    if (len > 0) {
+        key = strncmp(buf, "LINE:SD", 7) != 0;
+        sync_seq++;
+        if (key) {
+            last_keyframe_ms = now;
+            sync_need_key = false;
+        }
+        bleMarkNextNotification();  // Track enqueue→notify latency of screen syncs
+        sendNotificationToApp(buf);
+    }
+    syncAccount(len, key);
+}
+
+void sendScreenSync() {
+    uint32_t now = millis();
+    if (now - last_sync_ms < SYNC_INTERVAL_MS) return;
+    last_sync_ms = now;
+    screen_dirty = false;
 
-    // Only push if something OTHER than battery changed.
-    // Battery ADC noise causes tiny percentage swings (134→135%) that map to the same icon level.
-    // Time gives one update/minute anyway — no need to flood on battery-only changes.
-    // EXCEPT: scan mode always needs updates (progress bar and top channels change continuously)
-    if (!batt_changed && strcmp(current_mode, "SCAN") != 0) {
-        last_batt_idx = bat_idx;
-        last_sync_ms = now;
+    if (!display) return;
+
+    // Verify queue has room before building — state is only advanced for syncs that go out
+    int pending = getPendingNotificationCount();
+    if (pending > 8) {
+        screen_dirty = true;
         return;
     }
 
-    // Send via BLE
-    sendNotificationToApp(buf);
+    sendSyncPass(false);
 }
 
 // Only push screen sync if display state changed since last notification
 void sendScreenSyncIfDirty() {
     if (!screen_dirty) return;
-    
+
     // Only sync when BLE is connected — prevents queue filling during boot with no app
     extern int getPendingNotificationCount();
     extern bool isBleConnected();
@@ -279,16 +460,16 @@ void sendScreenSyncIfDirty() {
 
     uint32_t now = millis();
     if (now - last_sync_ms < SYNC_INTERVAL_MS) return;
-    
+
     // Throttle: even dirty updates max out at 1/sec to avoid flooding SoftDevice
     sendScreenSync();
 }
 
-// Forced screen sync — bypasses all throttling, battery-change checks, and intervals.
-// Called in response to GETSCREEN from the companion app.
+// Forced screen sync — bypasses throttling and always sends a full keyframe.
+// Called in response to GETSCREEN from the companion app and on mode switch.
 void sendScreenSyncForced() {
     uint32_t now = millis();
-    
+
     if (!display) return;
 
     // Must be connected — there's nowhere to send otherwise
@@ -303,191 +484,45 @@ void sendScreenSyncForced() {
     // During stall period, there's nothing to receive the notification
     if (now < ble_connect_stall_until) return;
 
-    // Reset sync timestamp so we can immediately send even if just synced
-    last_sync_ms = 0;
-    
-    // Force battery-change check to pass
-    int8_t saved_batt_idx = last_batt_idx;
-    last_batt_idx = -1;
-    
-    // Send via BLE — reuses existing sendScreenSync payload generation
-    // but without any throttle or battery-change filtering
-    
-    // If a normal dirty sync is pending, clear it — the forced sync we're about to send
-    // will carry the latest screen state anyway. The periodic sync will fire again next interval.
-    if (screen_dirty) {
-        screen_dirty = false;
-    }
-    
-    extern void sendNotificationToApp(const char* message);
+    // The keyframe we're about to send carries the latest state — drop any pending dirty sync
+    screen_dirty = false;
+
     int p = getPendingNotificationCount();
     if (p >= 14) {
         sendSerialToAppLn(F("ERR:sendScreenSyncForced queue full after drain"));
-        last_batt_idx = saved_batt_idx;
         return;
     }
 
-    // Build payload inline (same logic as sendScreenSync, but without throttle guards)
-    char buf[SYNC_MAX_PAYLOAD];
-    int off = 0;
-
-    char chan_sf[32];
-    if (strcmp(current_mode, "PTT") == 0) {
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c %dbps", channels[deviceSettings.channel_idx], getBitrateFromIndex(deviceSettings.bitrate_idx));
-    } else {
-        snprintf(chan_sf, sizeof(chan_sf), "chn:%c spf:%d", channels[deviceSettings.channel_idx], deviceSettings.spreading_factor);
-    }
-
-    off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "LINE:S|M:%s|H:%s|C:", current_mode, chan_sf);
-
-    if (strcmp(current_mode, "BEACON") == 0) {
-        const char* pn = "---";
-        if (beacon_display_name.length() > 0 && beacon_display_name.length() < 64) {
-            static unsigned char tmpName[64];
-            beacon_display_name.getBytes(tmpName, sizeof(tmpName));
-            if (tmpName[0] != '\0') pn = (const char*)tmpName;
-        }
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "peer_name:%s,", pn);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "peer_dist:%.0fm,", (beacon_display_dist >= 0) ? beacon_display_dist : -1);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "roster_count:%d,", peerRosterCount);
-
-        // Peer liveness — mirrors the on-device indicator to companion app
-        extern bool isPeerAlive();
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "beacon_peer_alive:%d,", (isPeerAlive() ? 1 : 0));
-
-        int roster_rows = 0;
-        int max_roster = peerRosterCount;
-        if (max_roster < 0 || max_roster > 50) max_roster = 0;
-        for (int i = 0; i < max_roster && roster_rows < 5; i++) {
-            const char* dn = peerRoster[i].callSign[0] != '\0' ? peerRoster[i].callSign : peerRoster[i].deviceId.c_str();
-            float dist = peerRoster[i].distanceM;
-            int batt = peerRoster[i].battery;
-            off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_n=%s,", roster_rows, dn);
-            if (dist > 0 && dist < 1000) {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_d=%.0fm,", roster_rows, dist);
-            } else if (dist >= 1000) {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_d=%.1fkm,", roster_rows, dist / 1000.0);
-            } else {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_d=???,", roster_rows);
-            }
-            if (batt > 0) {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_b=%d%%,", roster_rows, batt);
-            } else {
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "r%d_b=-%%,", roster_rows);
-            }
-            roster_rows++;
-        }
-    }
-    else if (strcmp(current_mode, "RANGE") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_role:%s,", range_role_sender ? "Sender" : "Receiver");
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_last_count:%d,", range_last_count);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_consecutive_ok:%d,", range_consecutive_ok);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_total_loss:%d,", range_total_pckt_loss);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_stable_dist:%.1fm,", range_stable_dist);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "range_max_dist:%.1fm,", range_max_dist);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "home_lat:%.6f,", range_home_lat);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "home_lon:%.6f,", range_home_long);
-        if (gps_status == GPS_LOC) {
-            off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "curr_lat:%.6f,", gps_latitude);
-            off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "curr_lon:%.6f,", gps_longitude);
-        }
-    }
-    else if (strcmp(current_mode, "PTT") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "ptt_state:%s,", layout_state.ptt_sending ? "TX" : (layout_state.ptt_receiving ? "RX" : "Idle"));
-    }
-    else if (strcmp(current_mode, "TXT") == 0) {
-        uint8_t msg_count = inboxCount();
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_inbox_count:%d,", msg_count);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_show_inbox:%d,", txtShowInbox ? 1 : 0);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_scroll_page:%d,", txtInboxScrollPage);
-
-        // Peer liveness — mirrors the on-device indicator to companion app
-        extern bool isPeerAlive();
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_lora_alive:%d,", (isPeerAlive() ? 1 : 0));
-
-        if (!txtShowInbox && msg_count > 0) {
-            uint8_t out_len = 0;
-            bool out_trunc = false;
-            uint8_t out_sender[4] = {0};
-            const char* raw = inboxGet(0, out_len, out_trunc, out_sender);
-            if (raw && out_len > 0) {
-                static char sanitized[INBOX_MAX_MSG_LEN];
-                int si = 0;
-                for (uint8_t i = 0; i < out_len && si < sizeof(sanitized) - 1; i++) {
-                    if (raw[i] == ',') sanitized[si++] = ':';
-                    else sanitized[si++] = raw[i];
-                }
-                sanitized[si] = '\0';
-                off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "txt_latest_msg=%s,", sanitized);
-            }
-        }
-    }
-    else if (strcmp(current_mode, "TST") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "tst_sent:%d,", test_message_counter);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "tst_recv:%d,", rcv_test_message_counter);
-    }
-    else if (strcmp(current_mode, "PONG") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "pong_state:%d,", layout_state.pong_state);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "pong_rtt_ms:%d,", layout_state.pong_rtt_ms);
-    }
-    else if (strcmp(current_mode, "SCAN") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "s%d@%.0f,", layout_state.scan_progress_pct, currentFrequency);
-        for (int i = 0; i < 5 && topChannels[i].frequency > 0; i++) {
-            int freq_10k = (int)(topChannels[i].frequency * 10);
-            int rssi_10 = (int)(topChannels[i].rssi * 10);
-            off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "%08d%d,", freq_10k, rssi_10);
-        }
-    }
-    else if (strcmp(current_mode, "RAW") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "raw_count:%d,", pckt_count);
-    }
-    else if (strcmp(current_mode, "WP") == 0) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_label=%s,", layout_state.wp_label);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_lat=%.6f,", layout_state.wp_lat);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_lon=%.6f,", layout_state.wp_lon);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_alt=%.1fm,", layout_state.wp_alt);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_broadcasting:%d,", layout_state.wp_broadcasting ? 1 : 0);
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "wp_bcast_rem:%ds,", layout_state.wp_bcast_remaining_s);
-    }
-
-    // Status bar: freq, time, GPS sats, battery level
-    char freq_str[16];
-    snprintf(freq_str, sizeof(freq_str), "%.2f", currentFrequency);
-
-    RTC_Date dateTime = rtc.getDateTime();
-    char time_str[9];
-    snprintf(time_str, sizeof(time_str), "%02d:%02d", dateTime.hour, dateTime.minute);
+    sendSyncPass(true);
+    last_sync_ms = millis();
+}
 
-    uint8_t batt_pct = getBatteryPercentage();
-    int bat_idx = 6;
-    if (batt_pct > 90) bat_idx = 6;
-    else if (batt_pct > 80) bat_idx = 5;
-    else if (batt_pct > 60) bat_idx = 4;
-    else if (batt_pct > 40) bat_idx = 3;
-    else if (batt_pct > 20) bat_idx = 2;
-    else if (batt_pct > 10) bat_idx = 1;
-    else bat_idx = 0;
-
-    off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "|S:%s|T:%s|G:%d|B:%d%%|I:", freq_str, time_str, gps_satellites, batt_pct);
-
-    if (gps_status == GPS_LOC) {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "gpst=ok,");
-    } else {
-        off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "gpst=no%,");
-    }
+// SYNCACK:{seq} from the app — later deltas are computed against this seq
+void screenSyncAck(uint32_t seq) {
+    if (seq == 0 || seq > sync_seq) return;     // Not something we sent
+    if (seq > sync_acked || !sync_delta_ok) sync_acked = seq;
+    sync_delta_ok = true;
+}
 
-    off += snprintf(buf + off, SYNC_MAX_PAYLOAD - off, "bat=%d", bat_idx);
-    buf[off] = '\0';
+// New connection — the app has no mirror state yet, so start over with keyframes
+void screenSyncReset() {
+    sync_delta_ok = false;
+    sync_acked = 0;
+    sync_need_key = true;
+}
 
-    if (off >= SYNC_MAX_PAYLOAD) {
-        sendSerialToAppLn(F("ERR:sendScreenSyncForced overrun"));
-        last_batt_idx = saved_batt_idx;
-        return;
+// "OK{SYNCSTATS:MODE=syncs/keyframes,before_Bpm,after_Bpm;...}" — modes with no time are skipped
+int screenSyncFormatStats(char* out, size_t out_len) {
+    syncAccount(0, false);
+    int off = snprintf(out, out_len, "OK{SYNCSTATS:");
+    for (int i = 0; i < numModes && i < SYNC_STAT_MODES; i++) {
+        const SyncStats& st = sync_stats[i];
+        if (st.active_ms < 1000 || off >= (int)out_len) continue;
+        uint32_t before = (uint32_t)((uint64_t)st.full_bytes * 60000 / st.active_ms);
+        uint32_t after = (uint32_t)((uint64_t)st.sent_bytes * 60000 / st.active_ms);
+        off += snprintf(out + off, out_len - off, "%s=%u/%u,%lu,%lu;", modes[i], st.syncs, st.keyframes,
+                        (unsigned long)before, (unsigned long)after);
     }
-
-    sendNotificationToApp(buf);
-    
-    // Restore tracking state for periodic sync
-    last_sync_ms = millis();
-    last_batt_idx = saved_batt_idx;
+    if (off < (int)out_len) off += snprintf(out + off, out_len - off, "}");
+    return off;
 }
@@ -1,6 +1,9 @@
 #ifndef SCREEN_SYNC_H
 #define SCREEN_SYNC_H
 
+#include <stdint.h>
+#include <stddef.h>
+
 // Maximum size of a single sync payload (local stack buffer).
 // sendNotificationToApp() handles fragmentation when the wrapped message exceeds MTU.
 // 1024 covers every mode including BEACON with max roster + WP broadcast duration.
@@ -12,4 +15,9 @@ void sendScreenSyncForced();
 void markScreenDirty();
 int getPendingNotificationCount();
 
+// Delta sync — the app acks each LINE:S / LINE:SD it applied with SYNCACK:{seq}
+void screenSyncAck(uint32_t seq);
+void screenSyncReset();
+int  screenSyncFormatStats(char* out, size_t out_len);
+
 #endif
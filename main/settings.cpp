@@ -7,6 +7,9 @@
 #include "settings.h"
 #include <time.h>  // Include time.h for time manipulation
 #include "display_layout.h"
+#include "disp_dirty.h"
+#include "epoch_clock.h"
+#include "mesh_relay.h"
 #include <Fonts/FreeMonoBold12pt7b.h>
 #include <Fonts/FreeMonoBold9pt7b.h>
 
@@ -34,12 +37,21 @@ DeviceSettings deviceSettings = {
     .seconds = 0,
     .bandwidth_idx = BW_250_KHZ, // Set default bandwidth to 250 kHz
     .coding_rate_idx = CR_6,     // Default coding rate 8, to have as much error recovering as possible
-    .frequency_hopping_enabled = true  // Enable frequency hopping by default
+    .frequency_hopping_enabled = true,  // Enable frequency hopping by default
+    .mesh_enabled = false,              // Single hop unless switched on
+    .mesh_ttl = MESH_TTL_DEFAULT
 };
 
+bool validBandwidth(uint32_t hz) {
+    static const uint32_t bws[] = { BW_7_8_KHZ, BW_10_4_KHZ, BW_15_6_KHZ, BW_20_8_KHZ, BW_31_25_KHZ,
+                                    BW_41_7_KHZ, BW_62_5_KHZ, BW_125_KHZ, BW_250_KHZ, BW_500_KHZ };
+    for (uint32_t bw : bws) if (bw == hz) return true;
+    return false;
+}
+
 // Implementing the methods defined in DeviceSettings struct
 void DeviceSettings::nextBitrate() {
-    bitrate_idx = (bitrate_idx + 1) % 6;
+    bitrate_idx = (bitrate_idx + 1) % num_bitrate_modes;
 }
 
 void DeviceSettings::nextVolume() {
@@ -177,6 +189,7 @@ void setupSettings() {
                  dt.year, dt.month, dt.day, dt.hour, dt.minute, dt.second);
         sendSerialToAppLn("[SETTINGS]   RTC: " + String(timeBuf));
     }
+    clockInit(ret == 0);    // epoch_clock.h keeps the time from here on
 
     sendSerialToAppLn("[SETTINGS] <<< setupSettings() DONE");
 }
@@ -203,7 +216,7 @@ void cycleSettings() {
 }
 
 void updateCurrentSetting() {
-    RTC_Date dateTime = rtc.getDateTime();
+    RTC_Date dateTime = clockDateTime();
 
     switch (setting_idx) {
         case SPREADING_FACTOR:
@@ -226,7 +239,8 @@ void updateCurrentSetting() {
         case MINUTES:
         case SECONDS:
             deviceSettings.incrementTime(setting_idx, dateTime);
-            rtc.setDateTime(dateTime.year, dateTime.month, dateTime.day, dateTime.hour, dateTime.minute, dateTime.second);
+            clockStep(clockFromCivil(dateTime.year, dateTime.month, dateTime.day, dateTime.hour, dateTime.minute,
+                                     dateTime.second), CLOCK_SRC_MANUAL);
             break;
         case BANDWIDTH:
             deviceSettings.nextBandwidth();
@@ -257,6 +271,8 @@ void updateCurrentSetting() {
                     }
                     last_touch_state = touch_state;
 
+                    // GxEPD2 drives the panel directly here — let the frame pipeline finish first
+                    dispFrameFlush();
                     display->setFullWindow();
                     display->firstPage();
                     do {
@@ -266,6 +282,8 @@ void updateCurrentSetting() {
                     delay(5000);  // wait for full waveform (~4s) + brief pause
                     
                     display->clearScreen();  // white panel
+                    dispFrameInvalidate();
+                    layoutInvalidate();
                     delay(200);
 
                     drawSettingsLayout();  // keep "Cycling..." visible
@@ -287,15 +305,10 @@ void displayCurrentSetting() {
 
 bool panel_refresh_enabled = false;
 
-// Example function to map the bitrate index to actual bitrate value (bps)
+// Codec2 modes by bitrate_idx (bps)
+const int bitrate_modes[] = { 3200, 2400, 1600, 1400, 1200, 700 };
+const size_t num_bitrate_modes = sizeof(bitrate_modes) / sizeof(bitrate_modes[0]);
+
 int getBitrateFromIndex(int index) {
-    switch (index) {
-        case 0: return 3200;
-        case 1: return 2400;
-        case 2: return 1600;
-        case 3: return 1400;
-        case 4: return 1200;
-        case 5: return 700;
-        default: return 3200;
-    }
+    return index >= 0 && (size_t)index < num_bitrate_modes ? bitrate_modes[index] : bitrate_modes[0];
 }
@@ -65,6 +65,8 @@ struct DeviceSettings {
     int bandwidth_idx;      // Index for bandwidth settings
     int coding_rate_idx;    // Index for coding rate settings
     bool frequency_hopping_enabled;  // Enable frequency hopping (true/false)
+    bool mesh_enabled;      // Tag our frames for relaying and relay others' (mesh_relay.h)
+    int mesh_ttl;           // Relays our frames may take, 1..MESH_TTL_MAX
 
     // Methods to increment or cycle settings
     void nextBitrate();
@@ -106,6 +108,7 @@ void displayBandwidth();   // New function to display bandwidth
 void displayCodingRate();  // New function to display coding rate
 void displayFrequencyHopping();  // New function to display frequency hopping status
 int getBitrateFromIndex(int index);
+bool validBandwidth(uint32_t hz);  // One of the BW_* values the radio accepts
 
 // Panel refresh as a setting
 extern bool panel_refresh_enabled;  // Defined in settings.cpp
@@ -0,0 +1,266 @@
+// settings_store.cpp — A/B settings pages: load, migration, deferred save
+
+#include "settings_store.h"
+#include "settings.h"
+#include "mesh_relay.h"
+#include <flash/flash_nrf5x.h>
+
+#define SETTINGS_MAGIC      0x474E5453      // "STNG"
+
+struct __attribute__((packed)) SettingsBlobHdr {
+    uint32_t magic;
+    uint16_t version;       // SETTINGS_SCHEMA at write time
+    uint16_t size;          // Body bytes
+    uint32_t seq;           // +1 per save — newest valid wins
+    uint32_t check;         // FNV-1a over the fields above and the body
+};
+
+// Persisted fields, fixed width. Append only (see settings_store.h).
+struct __attribute__((packed)) SettingsBody {
+    uint8_t  bitrate_idx;
+    uint8_t  volume_level;
+    uint8_t  channel_idx;
+    uint8_t  spreading_factor;
+    uint32_t bandwidth_hz;
+    uint8_t  coding_rate;
+    uint8_t  backlight;
+    uint8_t  frequency_hopping;
+    uint8_t  _pad;
+    uint8_t  mesh;
+    uint8_t  mesh_ttl;
+};
+
+#define SETTINGS_BODY_MAX   (SETTINGS_PAGE_SIZE - sizeof(SettingsBlobHdr))
+
+static_assert(SETTINGS_FLASH_B == SETTINGS_FLASH_A + SETTINGS_PAGE_SIZE && SETTINGS_FLASH_A % SETTINGS_PAGE_SIZE == 0,
+              "settings pages must be two adjacent flash pages");
+static_assert(SETTINGS_FLASH_B + SETTINGS_PAGE_SIZE <= 0xED000UL, "settings pages overlap InternalFileSystem");
+static_assert(SETTINGS_IMAGE_MAX == 806912, "update upload.maximum_size in build_scripts/01_build_firmware.bat and 03_ci_pipeline.bat");
+
+// ── On-chip flash backend ──
+// flash_nrf5x goes through the SoftDevice when it is enabled and caches one page; flushing after
+// each program keeps the A/B ordering (the cache would otherwise rewrite the page later).
+
+// End of the firmware image: code, then the .data initialisers the startup copies from behind it
+// (symbols from the core's nrf_common.ld). A build made without the SETTINGS_IMAGE_MAX cap can
+// reach the pages — then nothing below this address is ever erased or programmed.
+extern "C" uint32_t __etext, __data_start__, __data_end__;
+
+static uint32_t imageEnd() {
+    return (uint32_t)(uintptr_t)&__etext + (uint32_t)((uintptr_t)&__data_end__ - (uintptr_t)&__data_start__);
+}
+
+static bool intRead(uint32_t addr, void* buf, uint32_t len) {
+    memcpy(buf, (const void*)(uintptr_t)addr, len);    // Memory-mapped
+    return true;
+}
+
+static bool intProgram(uint32_t addr, const void* buf, uint32_t len) {
+    if (addr < imageEnd()) return false;
+    bool ok = flash_nrf5x_write(addr, buf, len) == (int)len;
+    flash_nrf5x_flush();
+    return ok;
+}
+
+static bool intErase(uint32_t addr) {
+    if (addr < imageEnd()) return false;
+    return flash_nrf5x_erase(addr);
+}
+
+static const FlashOps s_int_ops = { intRead, intProgram, intErase };
+
+static const FlashOps* s_ops = &s_int_ops;
+static uint32_t s_page[2] = { SETTINGS_FLASH_A, SETTINGS_FLASH_B };
+
+// ── State ──
+static uint32_t s_seq = 0;          // Seq of the newest blob on flash
+static int8_t   s_cur = -1;         // Page holding it, -1 = none
+static uint16_t s_loaded_version = 0;
+static uint32_t s_saved_hash = 0;   // Fields as last written / loaded
+static uint32_t s_seen_hash = 0;
+static uint32_t s_changed_ms = 0;
+static bool     s_started = false;
+static uint32_t s_load_us = 0;
+static uint32_t s_saves = 0;
+static uint16_t s_rejected = 0;     // Blobs skipped on load (check / schema)
+
+static uint32_t fnv(const void* p, uint32_t len, uint32_t h = 2166136261u) {
+    const uint8_t* b = (const uint8_t*)p;
+    for (uint32_t i = 0; i < len; i++) {
+        h ^= b[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t blobCheck(const SettingsBlobHdr& h, const void* body) {
+    return fnv(body, h.size, fnv(&h, offsetof(SettingsBlobHdr, check)));
+}
+
+static void capture(SettingsBody& b) {
+    memset(&b, 0, sizeof(b));
+    b.bitrate_idx = deviceSettings.bitrate_idx;
+    b.volume_level = deviceSettings.volume_level;
+    b.channel_idx = deviceSettings.channel_idx;
+    b.spreading_factor = deviceSettings.spreading_factor;
+    b.bandwidth_hz = deviceSettings.bandwidth_idx;
+    b.coding_rate = deviceSettings.coding_rate_idx;
+    b.backlight = deviceSettings.backlight;
+    b.frequency_hopping = deviceSettings.frequency_hopping_enabled;
+    b.mesh = deviceSettings.mesh_enabled;
+    b.mesh_ttl = deviceSettings.mesh_ttl;
+}
+
+static uint32_t fieldsHash() {
+    SettingsBody b;
+    capture(b);
+    return fnv(&b, sizeof(b));
+}
+
+// Body as current-schema fields; false if the version is unknown (written by newer firmware)
+static bool migrate(uint16_t version, const uint8_t* raw, uint16_t size, SettingsBody& out) {
+    capture(out);   // Compiled defaults for anything the blob does not carry
+    switch (version) {
+        case 1:
+            memcpy(&out, raw, size < sizeof(out) ? size : sizeof(out));
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void apply(const SettingsBody& b) {
+    // Range checks — a value the UI cannot produce keeps its default
+    if (b.bitrate_idx < num_bitrate_modes) deviceSettings.bitrate_idx = b.bitrate_idx;
+    if (b.volume_level >= 1 && b.volume_level <= 10) deviceSettings.volume_level = b.volume_level;
+    if (b.channel_idx < strlen(channels)) deviceSettings.channel_idx = b.channel_idx;
+    if (b.spreading_factor >= 6 && b.spreading_factor <= 12) deviceSettings.spreading_factor = b.spreading_factor;
+    if (validBandwidth(b.bandwidth_hz)) deviceSettings.bandwidth_idx = b.bandwidth_hz;
+    if (b.coding_rate >= CR_5 && b.coding_rate <= CR_8) deviceSettings.coding_rate_idx = b.coding_rate;
+    deviceSettings.backlight = b.backlight != 0;
+    deviceSettings.frequency_hopping_enabled = b.frequency_hopping != 0;
+    deviceSettings.mesh_enabled = b.mesh != 0;
+    if (b.mesh_ttl >= 1 && b.mesh_ttl <= MESH_TTL_MAX) deviceSettings.mesh_ttl = b.mesh_ttl;
+}
+
+// Header of page p if it looks like a blob (check not verified yet)
+static bool readHdr(uint8_t p, SettingsBlobHdr& h) {
+    return s_ops->read(s_page[p], &h, sizeof(h)) && h.magic == SETTINGS_MAGIC && h.size <= SETTINGS_BODY_MAX &&
+           h.seq != 0xFFFFFFFF;
+}
+
+bool settingsStoreLoad() {
+    uint32_t t0 = micros();
+    s_cur = -1;
+    s_seq = 0;
+    s_loaded_version = 0;
+    s_rejected = 0;
+
+    SettingsBlobHdr h[2];
+    bool ok[2] = { readHdr(0, h[0]), readHdr(1, h[1]) };
+    uint8_t first = ok[1] && (!ok[0] || h[1].seq > h[0].seq) ? 1 : 0;
+
+    bool loaded = false;
+    for (uint8_t k = 0; k < 2 && !loaded; k++) {
+        uint8_t p = k == 0 ? first : first ^ 1;
+        if (!ok[p]) continue;
+        // Track the highest seq even if that blob is rejected, so the next save goes above it
+        if (h[p].seq > s_seq) s_seq = h[p].seq;
+
+        static uint8_t raw[sizeof(SettingsBody)];
+        uint16_t n = h[p].size < sizeof(raw) ? h[p].size : sizeof(raw);
+        // The check covers the full stored body; hash it where it lies when it is longer than ours
+        uint32_t check;
+        if (h[p].size <= sizeof(raw)) {
+            if (!s_ops->read(s_page[p] + sizeof(SettingsBlobHdr), raw, n)) continue;
+            check = blobCheck(h[p], raw);
+        } else {
+            check = fnv(&h[p], offsetof(SettingsBlobHdr, check));
+            uint8_t chunk[32];
+            for (uint16_t off = 0; off < h[p].size; off += sizeof(chunk)) {
+                uint16_t c = (uint16_t)(h[p].size - off) < sizeof(chunk) ? h[p].size - off : sizeof(chunk);
+                if (!s_ops->read(s_page[p] + sizeof(SettingsBlobHdr) + off, chunk, c)) break;
+                check = fnv(chunk, c, check);
+            }
+            s_ops->read(s_page[p] + sizeof(SettingsBlobHdr), raw, n);
+        }
+
+        SettingsBody b;
+        if (check != h[p].check || !migrate(h[p].version, raw, n, b)) {
+            s_rejected++;
+            continue;
+        }
+        apply(b);
+        s_cur = p;
+        s_loaded_version = h[p].version;
+        loaded = true;
+    }
+
+    // A migrated blob is rewritten once in the current schema; compiled defaults need no write
+    uint32_t now_hash = fieldsHash();
+    s_saved_hash = !loaded || s_loaded_version == SETTINGS_SCHEMA ? now_hash : 0;
+    s_seen_hash = now_hash;
+    s_changed_ms = millis();
+    s_started = true;
+    s_load_us = micros() - t0;
+    return loaded;
+}
+
+static bool writeBlob() {
+    SettingsBody b;
+    capture(b);
+    SettingsBlobHdr h;
+    h.magic = SETTINGS_MAGIC;
+    h.version = SETTINGS_SCHEMA;
+    h.size = sizeof(b);
+    h.seq = s_seq + 1;
+    h.check = blobCheck(h, &b);
+
+    uint8_t p = s_cur == 0 ? 1 : 0;     // Never the page holding the newest copy
+    uint8_t buf[sizeof(h) + sizeof(b)];
+    memcpy(buf, &h, sizeof(h));
+    memcpy(buf + sizeof(h), &b, sizeof(b));
+    if (!s_ops->erase(s_page[p]) || !s_ops->program(s_page[p], buf, sizeof(buf))) return false;
+
+    // Read back before trusting it — the SoftDevice can fail a flash operation under radio load
+    SettingsBlobHdr v;
+    if (!readHdr(p, v) || v.seq != h.seq || v.check != h.check) return false;
+
+    s_seq = h.seq;
+    s_cur = p;
+    s_saved_hash = fnv(&b, sizeof(b));
+    s_saves++;
+    return true;
+}
+
+bool settingsStoreSave() {
+    if (!s_started) settingsStoreLoad();
+    if (fieldsHash() == s_saved_hash) return true;
+    return writeBlob();
+}
+
+void settingsStoreTick(uint32_t now) {
+    if (!s_started) return;
+    uint32_t h = fieldsHash();
+    if (h != s_seen_hash) {
+        s_seen_hash = h;
+        s_changed_ms = now;
+        return;
+    }
+    if (h == s_saved_hash || now - s_changed_ms < SETTINGS_SAVE_IDLE_MS) return;
+    if (!writeBlob()) s_changed_ms = now;   // Retry after another idle period
+}
+
+int settingsStoreFormat(char* out, size_t out_len) {
+    bool overlap = s_ops == &s_int_ops && imageEnd() > (s_page[0] < s_page[1] ? s_page[0] : s_page[1]);
+    return snprintf(out, out_len, "settings: v%u seq=%lu page=%c load_us=%lu saves=%lu rejected=%u%s",
+                    s_loaded_version, (unsigned long)s_seq, s_cur < 0 ? '-' : 'A' + s_cur,
+                    (unsigned long)s_load_us, (unsigned long)s_saves, s_rejected, overlap ? " IMAGE-OVERLAP" : "");
+}
+
+void settingsStoreUseOps(const FlashOps* ops, uint32_t page_a, uint32_t page_b) {
+    s_ops = ops ? ops : &s_int_ops;
+    s_page[0] = page_a;
+    s_page[1] = page_b;
+    s_started = false;
+}
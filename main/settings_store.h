@@ -0,0 +1,49 @@
+// settings_store.h — DeviceSettings persisted as a versioned blob in two internal-flash pages (A/B)
+
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <Arduino.h>
+#include "qspi_flash.h"     // FlashOps
+
+// Each save writes one complete blob (header + body) into the page that does NOT hold the newest
+// copy, so a power cut during the erase/program can only damage the older one; load picks the
+// highest seq whose check verifies. The pages are memory-mapped — load is a header check and a
+// few dozen bytes of FNV, no flash driver involved.
+//
+// Saves are deferred: settingsStoreTick() hashes the persisted fields every loop pass and writes
+// once they have stayed unchanged for SETTINGS_SAVE_IDLE_MS, so a burst of SETSETTINGS or button
+// presses costs one page erase.
+//
+// Schema: bump SETTINGS_SCHEMA when a field changes meaning and add a case to the migration in
+// settings_store.cpp. Fields appended to SettingsBody need no bump — older blobs are shorter and the
+// new fields keep their defaults. Every loaded value is range-checked; bad ones fall back to default.
+
+// Two 4 KiB pages just below the InternalFileSystem area (0xED000..0xF3FFF on the nRF52840).
+// They are still inside the core linker script's FLASH region (0x26000..0xED000), so the image must
+// end below SETTINGS_FLASH_A: the build scripts cap it with upload.maximum_size =
+// SETTINGS_IMAGE_MAX, and the on-chip backend refuses to erase or program below the image end.
+#define SETTINGS_FLASH_A        0xEB000UL
+#define SETTINGS_FLASH_B        0xEC000UL
+#define SETTINGS_PAGE_SIZE      4096
+#define SETTINGS_APP_START      0x26000UL               // S140 v6 SoftDevice end
+#define SETTINGS_IMAGE_MAX      (SETTINGS_FLASH_A - SETTINGS_APP_START)    // 806912 bytes
+#define SETTINGS_SCHEMA         1
+#define SETTINGS_SAVE_IDLE_MS   5000
+
+// Apply the newest valid blob to deviceSettings (before setupLoRa()); false = compiled defaults
+bool settingsStoreLoad();
+// Loop context — deferred write-back
+void settingsStoreTick(uint32_t now);
+// Write now if anything changed (power off)
+bool settingsStoreSave();
+
+// "settings: v1 seq=12 page=B load_us=9 saves=3 rejected=0" (boot log / stats); " IMAGE-OVERLAP"
+// is appended when the firmware image reaches into the pages and saving is off
+int settingsStoreFormat(char* out, size_t out_len);
+
+// Backend override — the default is the on-chip flash through the core's flash_nrf5x layer.
+// read() must work on erased pages; erase() takes the page address.
+void settingsStoreUseOps(const FlashOps* ops, uint32_t page_a, uint32_t page_b);
+
+#endif
@@ -2,108 +2,72 @@
 #include <cstring>
 #include <cstdint>
 
-static volatile uint8_t* inbox_base = nullptr;
+static MsgSectorIndex s_index[QSPI_MSG_SECTORS];
+static MsgLog s_log;
+static uint8_t* s_ramdisk = nullptr;
 static bool g_inited = false;
-
-// Return pointer to slot envelope at index
-inline static InboxSlotEnv* _envPtr(uint8_t idx) {
-    uint32_t off = HEADER_SIZE + (idx * SLOT_ENTRY_SIZE);
-    return (InboxSlotEnv*)(inbox_base + off);
-}
-
-// Return pointer to payload at index
-inline static volatile uint8_t* _payloadPtr(uint8_t idx) {
-    uint32_t env_base = HEADER_SIZE + (SLOT_COUNT * SLOT_ENTRY_SIZE);
-    uint32_t off = env_base + (idx * INBOX_MAX_MSG_LEN);
-    return inbox_base + off;
-}
-
-inline static InboxHeader* _hdr() {
-    return (InboxHeader*)inbox_base;
-}
+static uint32_t s_revision = 0;
+static uint32_t s_mount_ms = 0;
+static char s_payload[INBOX_MAX_MSG_LEN + 1];
 
 void inboxInit() {
-    inbox_base = (volatile uint8_t*)INBOX_RAM_BASE;
-    
-    if (_hdr()->magic != MAGIC) {
-        memset((void*)inbox_base, 0, HEADER_SIZE + (SLOT_COUNT * SLOT_ENTRY_SIZE) + (SLOT_COUNT * INBOX_MAX_MSG_LEN));
-        _hdr()->magic = MAGIC;
-        _hdr()->count = 0;
-    }
+    if (g_inited) return;
     g_inited = true;
+    uint32_t t0 = millis();
+    if (qspiFlashInit()) {
+        s_log.ops = &qspiFlashOps();
+        s_log.base = QSPI_MSG_BASE;
+        s_log.sectors = QSPI_MSG_SECTORS;
+    } else {
+        s_ramdisk = (uint8_t*)malloc(INBOX_RAMDISK_SECTORS * FLASH_SECTOR_SIZE);
+        if (!s_ramdisk) {
+            s_log.ops = nullptr;
+            return;
+        }
+        memset(s_ramdisk, 0xFF, INBOX_RAMDISK_SECTORS * FLASH_SECTOR_SIZE);
+        ramDiskAttach(s_ramdisk, INBOX_RAMDISK_SECTORS * FLASH_SECTOR_SIZE);
+        s_log.ops = &ramDiskOps();
+        s_log.base = 0;
+        s_log.sectors = INBOX_RAMDISK_SECTORS;
+    }
+    s_log.index = s_index;
+    msgLogMount(s_log);
+    s_mount_ms = millis() - t0;
 }
 
 bool inboxStore(const char* sender_id, uint8_t sender_len, const uint8_t* payload, uint16_t len) {
     if (!g_inited) inboxInit();
-    if (!inbox_base) return false;
-    
-    // Enforce max payload
-    if (len > INBOX_MAX_MSG_LEN - 1) {
-        len = INBOX_MAX_MSG_LEN - 1;
-    }
-    
-    // Compact: if full, drop oldest and shift
-    if (_hdr()->count >= SLOT_COUNT) {
-        for (int i = 1; i < _hdr()->count; i++) {
-            InboxSlotEnv* dst = _envPtr(i - 1);
-            InboxSlotEnv* src = _envPtr(i);
-            memcpy(dst, src, sizeof(InboxSlotEnv));
-            
-            volatile uint8_t* dp = _payloadPtr(i - 1);
-            volatile uint8_t* sp = _payloadPtr(i);
-            memcpy((void*)dp, (const void*)sp, INBOX_MAX_MSG_LEN);
-        }
-        _hdr()->count--;
-    }
-    
-    int idx = _hdr()->count;
-    InboxSlotEnv* env = _envPtr(idx);
-    memset((void*)env, 0, sizeof(InboxSlotEnv));
-    
-    // Set magic (low nibble) and src_len (high nibble) in first byte
-    uint8_t s_len = sender_len < 4 ? sender_len : 4;
-    env->magic_and_src_len = ((s_len & 0x0F) << 4) | SLOT_MAGIC_LO;
-    
-    if (sender_id && s_len > 0) {
-        memcpy(env->src, sender_id, s_len);
-    }
-    env->msg_len = (uint8_t)len;
-    env->flags = MSG_FLAG_INBOX;
-    
-    // Store payload
-    uint8_t* pp = (uint8_t*)_payloadPtr(idx);
-    memcpy(pp, payload, len);
-    pp[len] = '\0';
-    
-    _hdr()->count++;
+    if (!s_log.ops) return false;
+    if (!msgLogAppend(s_log, (const uint8_t*)sender_id, sender_len, payload, len)) return false;
+    s_revision++;
     return true;
 }
 
-const char* inboxGet(uint8_t index, uint8_t& out_msg_len, bool& out_truncated, uint8_t (&out_sender)[4]) {
+const char* inboxGet(uint16_t index, uint16_t& out_msg_len, bool& out_truncated, uint8_t (&out_sender)[4]) {
     if (!g_inited) inboxInit();
-    if (index >= _hdr()->count || !inbox_base) return nullptr;
-    
     memset(out_sender, 0, 4);
     out_msg_len = 0;
     out_truncated = false;
-    
-    InboxSlotEnv* env = _envPtr(index);
-    // Check magic: first byte low nibble should be 0xA
-    if ((env->magic_and_src_len & 0x0F) != SLOT_MAGIC_LO) return nullptr;
-    
-    uint8_t src_len = (env->magic_and_src_len >> 4) & 0x0F;
-    for (int i = 0; i < src_len && i < 4; i++) {
-        out_sender[i] = (uint8_t)env->src[i];
-    }
-    out_msg_len = env->msg_len;
-    out_truncated = (env->flags & MSG_FLAG_TRUNCATED) != 0;
-    
-    return (const char*)_payloadPtr(index);
+    if (!s_log.ops) return nullptr;
+
+    MsgLogEntry e;
+    if (!msgLogRead(s_log, index, e, (uint8_t*)s_payload, INBOX_MAX_MSG_LEN)) return nullptr;
+    uint16_t n = e.len < INBOX_MAX_MSG_LEN ? e.len : INBOX_MAX_MSG_LEN;
+    s_payload[n] = '\0';
+    memcpy(out_sender, e.src, e.src_len < 4 ? e.src_len : 4);
+    out_msg_len = n;
+    out_truncated = (e.flags & MSG_REC_TRUNCATED) != 0;
+    return s_payload;
+}
+
+uint16_t inboxCount() {
+    if (!g_inited || !s_log.ops) return 0;
+    uint32_t n = msgLogCount(s_log);
+    return n > 0xFFFF ? 0xFFFF : (uint16_t)n;
 }
 
-uint8_t inboxCount() {
-    if (!g_inited) return 0;
-    return _hdr()->count;
+uint32_t inboxRevision() {
+    return s_revision;
 }
 
 bool inboxIsEmpty() {
@@ -111,19 +75,21 @@ bool inboxIsEmpty() {
 }
 
 void inboxClear() {
-    if (!g_inited) return;
-    memset((void*)inbox_base, 0, HEADER_SIZE + (SLOT_COUNT * SLOT_ENTRY_SIZE) + (SLOT_COUNT * INBOX_MAX_MSG_LEN));
-    _hdr()->magic = MAGIC;
-    _hdr()->count = 0;
+    if (!g_inited) inboxInit();
+    if (!s_log.ops) return;
+    msgLogClear(s_log);
+    s_revision++;
 }
 
 // Display the most recent message at a given display line
 void inboxShowLatest(uint8_t start_line) {
-    if (_hdr()->count == 0 || !inbox_base) return;
+    uint16_t count = inboxCount();
+    if (count == 0) return;
     
-    uint8_t ml = 0, sender[4] = {0};
+    uint16_t ml = 0;
+    uint8_t sender[4] = {0};
     bool truncated = false;
-    const char* payload = inboxGet(_hdr()->count - 1, ml, truncated, sender);
+    const char* payload = inboxGet(count - 1, ml, truncated, sender);
     
     if (!payload || ml == 0) return;
     
@@ -155,10 +121,8 @@ void inboxShowLatest(uint8_t start_line) {
 }
 
 // Display a page of inbox messages on E-Paper (up to 16 lines for message body)
-void inboxDisplayPage(uint8_t page_start, uint8_t* scroll_cursor, bool needs_refresh) {
-    if (!_hdr() || !inbox_base) return;
-    
-    int count = _hdr()->count;
+void inboxDisplayPage(uint16_t page_start, uint16_t* scroll_cursor, bool needs_refresh) {
+    int count = inboxCount();
     int lines_per_page = 16;  // rows 2-17 on E-Paper
     
     extern void updDisp(uint8_t line, const char* msg, bool updateScreen);
@@ -168,7 +132,8 @@ void inboxDisplayPage(uint8_t page_start, uint8_t* scroll_cursor, bool needs_ref
         int msg_idx = page_start + i;
         
         if (msg_idx < count) {
-            uint8_t ml = 0, sender[4] = {0};
+            uint16_t ml = 0;
+            uint8_t sender[4] = {0};
             bool truncated = false;
             const char* payload = inboxGet(msg_idx, ml, truncated, sender);
             
@@ -202,15 +167,15 @@ void inboxDisplayPage(uint8_t page_start, uint8_t* scroll_cursor, bool needs_ref
     }
     
     if (scroll_cursor) {
-        *scroll_cursor = count > (uint8_t)lines_per_page ? page_start : 0;
+        *scroll_cursor = count > lines_per_page ? page_start : 0;
     }
 }
 
 // Helper for layout module — gets message payload into caller buffer
-uint8_t inboxGetMessage(uint8_t index, char* out_buf, size_t buf_len) {
-    if (!g_inited || !inbox_base) return 0;
+uint16_t inboxGetMessage(uint16_t index, char* out_buf, size_t buf_len) {
+    if (!g_inited || !s_log.ops) return 0;
     
-    uint8_t ml = 0;
+    uint16_t ml = 0;
     bool truncated = false;
     uint8_t sender[4] = {0};
     const char* payload = inboxGet(index, ml, truncated, sender);
@@ -221,3 +186,68 @@ uint8_t inboxGetMessage(uint8_t index, char* out_buf, size_t buf_len) {
     out_buf[copy_len] = '\0';
     return ml;
 }
+
+// ── MSGBENCH — append/read cost of the log on the QSPI scratch sectors vs. a RAM disk ──
+#define BENCH_MSGS      64
+#define BENCH_LEN       48      // 64 records overflow one sector, so a sector switch + erase is included
+
+struct BenchResult {
+    uint32_t total_us, max_us, read_us;
+};
+
+static BenchResult benchLog(const FlashOps& ops, uint32_t base) {
+    BenchResult r = { 0, 0, 0 };
+    MsgSectorIndex index[QSPI_BENCH_SECTORS];
+    MsgLog log;
+    memset(&log, 0, sizeof(log));
+    log.ops = &ops;
+    log.base = base;
+    log.sectors = QSPI_BENCH_SECTORS;
+    log.index = index;
+    msgLogFormat(log);
+
+    uint8_t payload[BENCH_LEN];
+    for (uint8_t i = 0; i < BENCH_LEN; i++) payload[i] = 'a' + i % 26;
+    for (uint16_t i = 0; i < BENCH_MSGS; i++) {
+        uint32_t t0 = micros();
+        msgLogAppend(log, (const uint8_t*)"BNCH", 4, payload, BENCH_LEN);
+        uint32_t dt = micros() - t0;
+        r.total_us += dt;
+        if (dt > r.max_us) r.max_us = dt;
+    }
+
+    uint32_t t0 = micros();
+    uint32_t n = msgLogCount(log);
+    for (uint32_t i = 0; i < n; i++) {
+        MsgLogEntry e;
+        msgLogRead(log, i, e, payload, sizeof(payload));
+    }
+    r.read_us = micros() - t0;
+    return r;
+}
+
+int inboxBenchmark(char* out, size_t out_len) {
+    if (!g_inited) inboxInit();
+
+    BenchResult q = { 0, 0, 0 };
+    if (qspiFlashReady()) q = benchLog(qspiFlashOps(), QSPI_BENCH_BASE);
+
+    BenchResult m = { 0, 0, 0 };
+    uint8_t* disk = (uint8_t*)malloc(QSPI_BENCH_SECTORS * FLASH_SECTOR_SIZE);
+    if (disk) {
+        memset(disk, 0xFF, QSPI_BENCH_SECTORS * FLASH_SECTOR_SIZE);
+        ramDiskAttach(disk, QSPI_BENCH_SECTORS * FLASH_SECTOR_SIZE);
+        m = benchLog(ramDiskOps(), 0);
+        free(disk);
+        // The inbox itself may be on the RAM disk
+        ramDiskAttach(s_ramdisk, s_ramdisk ? INBOX_RAMDISK_SECTORS * FLASH_SECTOR_SIZE : 0);
+    }
+
+    return snprintf(out, out_len, "OK{MSGBENCH:n=%u,len=%u,qspi_us=%lu,qspi_max_us=%lu,qspi_read_us=%lu,ram_us=%lu,ram_max_us=%lu,ram_read_us=%lu,"
+                    "store=%s,msgs=%u,erases=%lu,replayed=%lu,torn=%lu,mount_ms=%lu}",
+                    BENCH_MSGS, BENCH_LEN,
+                    (unsigned long)q.total_us, (unsigned long)q.max_us, (unsigned long)q.read_us,
+                    (unsigned long)m.total_us, (unsigned long)m.max_us, (unsigned long)m.read_us,
+                    s_ramdisk ? "ram" : "qspi", inboxCount(), (unsigned long)s_log.erases,
+                    (unsigned long)s_log.replayed, (unsigned long)s_log.torn, (unsigned long)s_mount_ms);
+}
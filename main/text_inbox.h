@@ -3,55 +3,35 @@
 
 #include <stdint.h>
 #include <Arduino.h>
+#include "msg_log.h"
 
-// Inbox configuration — RTC RAM budget: ~1.5KB available below crash_debug area (0x20007FC0)
-// Each message: 9-byte envelope + payload. At 512 bytes payload = 521 bytes each.
-// 32 messages * 521 ≈ 16.7KB — too much for RTC RAM. Use compact layout.
-#define INBOX_MAX_MESSAGES    8   // Compact: 8 messages * ~4KB total (fits RTC RAM)
-#define INBOX_MAX_MSG_LEN     256 // Max payload per message
-
-// RTC RAM address range (below crash_debug at 0x20007FC0, above debug buffer at 0x20006FC0)
-#define INBOX_RAM_BASE        ((volatile uint8_t*)0x200075C0)
-
-// Layout constants
-#define HEADER_SIZE           8   // magic(4) + count(1) + padding(3)
-#define SLOT_ENTRY_SIZE       sizeof(InboxSlotEnv)
-#define SLOT_COUNT            INBOX_MAX_MESSAGES
-
-// Magic values
-#define MAGIC                 0x494E4258   // "INBX"
-#define SLOT_MAGIC_LO         0xA           // Low nibble of first byte
-
-// Message state flags
-#define MSG_FLAG_INBOX        (1 << 0)     // Currently in inbox (not yet read)
-#define MSG_FLAG_TRUNCATED    (1 << 1)     // Payload was truncated
-
-typedef struct __attribute__((packed)) {
-    uint8_t   magic_and_src_len;  // bit[3:0]=SLOT_MAGIC_LO, bit[7:4]=src_len
-    char        src[4];           // sender short BLE MAC (null-padded)
-    uint8_t     msg_len;          // payload length in bytes
-    uint8_t     flags;            // MSG_FLAG_* bitmask
-} InboxSlotEnv;
-
-typedef struct __attribute__((packed)) {
-    uint32_t  magic;
-    uint8_t   count;
-    uint8_t   _pad[3];
-} InboxHeader;
+// Inbox storage: the message log on the QSPI flash (msg_log.h, QSPI_MSG_BASE) — survives power
+// loss and holds thousands of messages; the oldest sector's worth drops out when the ring wraps.
+// If the flash does not answer at boot the log runs on a small RAM disk instead (lost on reset).
+// Index 0 is the oldest message.
+#define INBOX_MAX_MSG_LEN     MSG_LOG_MAX_LEN   // Max payload per message
+#define INBOX_RAMDISK_SECTORS 4                 // Fallback capacity: 4 x 4 KiB
 
 // API
 void inboxInit();
 bool inboxStore(const char* sender_id, uint8_t sender_len, const uint8_t* payload, uint16_t len);
-const char* inboxGet(uint8_t index, uint8_t& out_msg_len, bool& out_truncated, uint8_t (&out_sender)[4]);
-uint8_t inboxCount();
+// Payload is copied into a static buffer (NUL-terminated) that the next inboxGet() overwrites
+const char* inboxGet(uint16_t index, uint16_t& out_msg_len, bool& out_truncated, uint8_t (&out_sender)[4]);
+uint16_t inboxCount();
+// Changes with every store/clear — lets the layouts notice new mail without reading the log
+uint32_t inboxRevision();
 bool inboxIsEmpty();
 void inboxClear();
 
 // Display helpers for TXT mode
 void inboxShowLatest(uint8_t start_line);
-void inboxDisplayPage(uint8_t page_start, uint8_t* scroll_cursor, bool needs_refresh);
+void inboxDisplayPage(uint16_t page_start, uint16_t* scroll_cursor, bool needs_refresh);
 
 // Helper for layout module — gets message payload into caller buffer
-uint8_t inboxGetMessage(uint8_t index, char* out_buf, size_t buf_len);
+uint16_t inboxGetMessage(uint16_t index, char* out_buf, size_t buf_len);
+
+// "OK{MSGBENCH:n=..,len=..,qspi_us=..,qspi_max_us=..,qspi_read_us=..,ram_us=..,ram_max_us=..,ram_read_us=..,
+//  store=qspi|ram,msgs=..,erases=..,replayed=..,torn=..,mount_ms=..}" — appends into scratch sectors, inbox untouched
+int inboxBenchmark(char* out, size_t out_len);
 
 #endif // TEXT_INBOX_H
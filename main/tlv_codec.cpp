@@ -0,0 +1,169 @@
+#include "tlv_codec.h"
+#include <string.h>
+
+// ── Writer ──
+
+void tlvBeginFrame(TlvWriter& w, uint8_t* buf, uint16_t cap, uint8_t req_id) {
+    w.buf = buf;
+    w.cap = cap;
+    w.len = 0;
+    w.msg_start = 0;
+    w.count = 0;
+    w.overflow = cap < TLV_FRAME_HDR;
+    if (w.overflow) return;
+    buf[0] = TLV_MAGIC;
+    buf[1] = TLV_CHANNEL;
+    buf[2] = TLV_VERSION;
+    buf[3] = req_id;
+    buf[4] = 0;
+    w.len = TLV_FRAME_HDR;
+}
+
+static bool tlvReserve(TlvWriter& w, uint16_t n) {
+    if (w.overflow || w.len + n > w.cap) {
+        w.overflow = true;
+        return false;
+    }
+    return true;
+}
+
+bool tlvBeginMsg(TlvWriter& w, uint8_t op) {
+    w.msg_start = w.len;    // Set first so a failed begin can't roll back an earlier message
+    if (!tlvReserve(w, TLV_MSG_HDR)) return false;
+    w.buf[w.len++] = op;
+    w.buf[w.len++] = 0;
+    return true;
+}
+
+bool tlvEndMsg(TlvWriter& w) {
+    uint16_t body = w.len - w.msg_start - TLV_MSG_HDR;
+    if (w.overflow || body > 0xFF || w.count >= TLV_COUNT_MASK) {
+        tlvAbortMsg(w);
+        w.overflow = true;
+        return false;
+    }
+    w.buf[w.msg_start + 1] = (uint8_t)body;
+    w.count++;
+    return true;
+}
+
+void tlvAbortMsg(TlvWriter& w) {
+    if (w.msg_start >= TLV_FRAME_HDR) w.len = w.msg_start;
+}
+
+bool tlvPutU8(TlvWriter& w, uint8_t tag, uint8_t v) {
+    if (!tlvReserve(w, 2)) return false;
+    w.buf[w.len++] = (uint8_t)((tag & ~TLV_WT_MASK) | TLV_WT_U8);
+    w.buf[w.len++] = v;
+    return true;
+}
+
+bool tlvPutU16(TlvWriter& w, uint8_t tag, uint16_t v) {
+    if (!tlvReserve(w, 3)) return false;
+    w.buf[w.len++] = (uint8_t)((tag & ~TLV_WT_MASK) | TLV_WT_U16);
+    w.buf[w.len++] = (uint8_t)(v & 0xFF);
+    w.buf[w.len++] = (uint8_t)(v >> 8);
+    return true;
+}
+
+bool tlvPutU32(TlvWriter& w, uint8_t tag, uint32_t v) {
+    if (!tlvReserve(w, 5)) return false;
+    w.buf[w.len++] = (uint8_t)((tag & ~TLV_WT_MASK) | TLV_WT_U32);
+    for (uint8_t i = 0; i < 4; i++) w.buf[w.len++] = (uint8_t)(v >> (8 * i));
+    return true;
+}
+
+bool tlvPutBytes(TlvWriter& w, uint8_t tag, const void* data, uint8_t n) {
+    if (!tlvReserve(w, 2 + n)) return false;
+    w.buf[w.len++] = (uint8_t)((tag & ~TLV_WT_MASK) | TLV_WT_BYTES);
+    w.buf[w.len++] = n;
+    memcpy(w.buf + w.len, data, n);
+    w.len += n;
+    return true;
+}
+
+bool tlvPutStr(TlvWriter& w, uint8_t tag, const char* s) {
+    size_t n = s ? strlen(s) : 0;
+    if (n > 0xFF) n = 0xFF;
+    return tlvPutBytes(w, tag, s, (uint8_t)n);
+}
+
+uint16_t tlvFinishFrame(TlvWriter& w, bool more) {
+    if (w.len < TLV_FRAME_HDR) return 0;
+    w.buf[4] = (uint8_t)((w.count & TLV_COUNT_MASK) | (more ? TLV_FLAG_MORE : 0));
+    return w.len;
+}
+
+// ── Reader ──
+
+bool tlvIsFrame(const uint8_t* data, uint16_t len) {
+    return data && len >= TLV_FRAME_HDR && data[0] == TLV_MAGIC && data[1] == TLV_CHANNEL;
+}
+
+bool tlvParseFrame(const uint8_t* data, uint16_t len, TlvFrame& out) {
+    if (!tlvIsFrame(data, len)) return false;
+    out.version = data[2];
+    out.req_id = data[3];
+    out.count = data[4] & TLV_COUNT_MASK;
+    out.more = (data[4] & TLV_FLAG_MORE) != 0;
+    out.body.p = data + TLV_FRAME_HDR;
+    out.body.end = data + len;
+    return true;
+}
+
+bool tlvNextMsg(TlvCursor& c, uint8_t& op, TlvCursor& fields) {
+    if (c.end - c.p < TLV_MSG_HDR) return false;
+    uint8_t n = c.p[1];
+    if (c.end - c.p - TLV_MSG_HDR < n) return false;    // Truncated message
+    op = c.p[0];
+    fields.p = c.p + TLV_MSG_HDR;
+    fields.end = fields.p + n;
+    c.p = fields.end;
+    return true;
+}
+
+bool tlvNextField(TlvCursor& c, TlvField& f) {
+    if (c.p >= c.end) return false;
+    uint8_t tag = c.p[0];
+    const uint8_t* v = c.p + 1;
+    ptrdiff_t avail = c.end - v;
+    f.tag = tag;
+    f.u = 0;
+    f.data = v;
+    f.len = 0;
+    switch (tag & TLV_WT_MASK) {
+        case TLV_WT_U8:
+            if (avail < 1) return false;
+            f.u = v[0];
+            f.len = 1;
+            c.p = v + 1;
+            return true;
+        case TLV_WT_U16:
+            if (avail < 2) return false;
+            f.u = (uint32_t)v[0] | ((uint32_t)v[1] << 8);
+            f.len = 2;
+            c.p = v + 2;
+            return true;
+        case TLV_WT_U32:
+            if (avail < 4) return false;
+            f.u = (uint32_t)v[0] | ((uint32_t)v[1] << 8) | ((uint32_t)v[2] << 16) | ((uint32_t)v[3] << 24);
+            f.len = 4;
+            c.p = v + 4;
+            return true;
+        default:    // TLV_WT_BYTES
+            if (avail < 1 || avail - 1 < v[0]) return false;
+            f.len = v[0];
+            f.data = v + 1;
+            c.p = v + 1 + v[0];
+            return true;
+    }
+}
+
+uint8_t tlvCopyStr(const TlvField& f, char* out, size_t out_len) {
+    if (!out || out_len == 0) return 0;
+    size_t n = f.len < out_len - 1 ? f.len : out_len - 1;
+    if ((f.tag & TLV_WT_MASK) != TLV_WT_BYTES) n = 0;
+    memcpy(out, f.data, n);
+    out[n] = '\0';
+    return (uint8_t)n;
+}
@@ -0,0 +1,85 @@
+#ifndef TLV_CODEC_H
+#define TLV_CODEC_H
+
+// Binary control/telemetry framing for the companion app — plain C++, no Arduino types,
+// so the same encoder/decoder builds for host-side tools.
+//
+// Frame (one BLE write or notification):
+//   [0xFE][0x02][version][req_id][count|MORE]  then `count` messages
+// Message:
+//   [op][len][fields...]           responses use op | TLV_OP_RESP
+// Field:
+//   [tag][value]                   the top two tag bits carry the wire type, so a reader
+//                                  can skip fields (and whole messages) it doesn't know
+//
+// 0xFE 0x01 stays reserved for raw Opus frames.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TLV_MAGIC           0xFE
+#define TLV_CHANNEL         0x02
+#define TLV_VERSION         1
+#define TLV_FRAME_HDR       5
+#define TLV_MSG_HDR         2
+#define TLV_FLAG_MORE       0x80    // More response frames follow for this req_id
+#define TLV_COUNT_MASK      0x7F
+#define TLV_OP_RESP         0x80
+
+// Wire types (top two tag bits)
+#define TLV_WT_U8           0x00    // 1 byte
+#define TLV_WT_U16          0x40    // 2 bytes little-endian
+#define TLV_WT_U32          0x80    // 4 bytes little-endian (int32 travels as its two's complement)
+#define TLV_WT_BYTES        0xC0    // 1-byte length + data (strings are not NUL-terminated)
+#define TLV_WT_MASK         0xC0
+#define TLV_TAG(wt, id)     ((uint8_t)((wt) | ((id) & 0x3F)))
+
+// ── Writer ──
+struct TlvWriter {
+    uint8_t* buf;
+    uint16_t cap;
+    uint16_t len;
+    uint16_t msg_start;     // Offset of the open message header
+    uint8_t  count;         // Messages completed in this frame
+    bool     overflow;      // Sticky — set once any put didn't fit
+};
+
+void     tlvBeginFrame(TlvWriter& w, uint8_t* buf, uint16_t cap, uint8_t req_id);
+bool     tlvBeginMsg(TlvWriter& w, uint8_t op);
+bool     tlvEndMsg(TlvWriter& w);
+void     tlvAbortMsg(TlvWriter& w);    // Drop the open message (e.g. after overflow)
+bool     tlvPutU8(TlvWriter& w, uint8_t tag, uint8_t v);
+bool     tlvPutU16(TlvWriter& w, uint8_t tag, uint16_t v);
+bool     tlvPutU32(TlvWriter& w, uint8_t tag, uint32_t v);
+bool     tlvPutBytes(TlvWriter& w, uint8_t tag, const void* data, uint8_t n);
+bool     tlvPutStr(TlvWriter& w, uint8_t tag, const char* s);
+uint16_t tlvFinishFrame(TlvWriter& w, bool more);   // Returns total frame length
+
+// ── Reader ── (zero-copy: all pointers reference the caller's buffer)
+struct TlvCursor {
+    const uint8_t* p;
+    const uint8_t* end;
+};
+
+struct TlvFrame {
+    uint8_t   version;
+    uint8_t   req_id;
+    uint8_t   count;
+    bool      more;
+    TlvCursor body;
+};
+
+struct TlvField {
+    uint8_t        tag;
+    uint32_t       u;       // Numeric value for U8/U16/U32
+    const uint8_t* data;    // BYTES payload
+    uint8_t        len;
+};
+
+bool tlvIsFrame(const uint8_t* data, uint16_t len);
+bool tlvParseFrame(const uint8_t* data, uint16_t len, TlvFrame& out);
+bool tlvNextMsg(TlvCursor& c, uint8_t& op, TlvCursor& fields);
+bool tlvNextField(TlvCursor& c, TlvField& f);
+uint8_t tlvCopyStr(const TlvField& f, char* out, size_t out_len);   // NUL-terminates, returns length
+
+#endif // TLV_CODEC_H
@@ -0,0 +1,251 @@
+// track_log.cpp — Fix sampling, delta/varint block encoder, msg_log ring on QSPI
+
+#include "track_log.h"
+#include "geodesy.h"
+#include <math.h>
+
+struct TrackPoint {
+    uint32_t t;
+    int32_t  lat, lon;      // 1e-6 degrees
+    int16_t  alt;           // Metres
+};
+
+// Latest fix from loopGPS(), consumed by trackTick()
+static struct {
+    double   lat, lon;
+    float    alt, speed, course;
+    uint32_t date, time;
+    bool     fresh;
+} s_offer;
+
+static MsgSectorIndex s_index[QSPI_TRACK_SECTORS];
+static MsgLog s_log;
+static bool s_inited = false;
+static bool s_enabled = true;
+
+// Open block
+static uint8_t  s_blk[TRACK_BLOCK_MAX];
+static uint16_t s_blk_len = 0;          // 0 = no block open
+static uint32_t s_blk_opened_ms = 0;
+static bool     s_new_segment = true;
+
+// Encoder state — last point written and the step that led to it
+static bool       s_have_last = false;
+static TrackPoint s_last;
+static int16_t    s_last_alt;           // Altitude as the decoder knows it
+static float      s_last_course = 0;
+static int32_t    s_prev_dlat = 0, s_prev_dlon = 0;
+static uint32_t   s_prev_dt = 0;
+
+// Stats
+static uint32_t s_offered = 0;
+static uint32_t s_points = 0;           // Written or in the open block
+static uint32_t s_bytes = 0;
+static uint32_t s_tick_max_us = 0;
+static uint32_t s_mount_ms = 0;
+
+void trackInit() {
+    if (s_inited) return;
+    s_inited = true;
+    uint32_t t0 = millis();
+    if (qspiFlashInit()) {
+        s_log.ops = &qspiFlashOps();
+        s_log.base = QSPI_TRACK_BASE;
+        s_log.sectors = QSPI_TRACK_SECTORS;
+        s_log.index = s_index;
+        msgLogMount(s_log);
+    } else {
+        s_log.ops = nullptr;
+    }
+    s_mount_ms = millis() - t0;
+}
+
+void trackOffer(double lat, double lon, float alt_m, float speed_mps, float course_deg,
+                uint32_t date, uint32_t time) {
+    s_offer.lat = lat;
+    s_offer.lon = lon;
+    s_offer.alt = alt_m;
+    s_offer.speed = speed_mps;
+    s_offer.course = course_deg;
+    s_offer.date = date;
+    s_offer.time = time;
+    s_offer.fresh = true;
+}
+
+// ── Encoding ──
+
+static uint8_t putVarint(uint8_t* p, uint32_t v) {
+    uint8_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+// Unix time from TinyGPS++ date (ddmmyy) and time (hhmmsscc); 0 if the date is not set
+static uint32_t unixTime(uint32_t date, uint32_t time) {
+    int32_t d = date / 10000, m = (date / 100) % 100, y = 2000 + date % 100;
+    if (d < 1 || m < 1 || m > 12) return 0;
+    // Days from 1970-01-01 (civil calendar, March-based year)
+    y -= m <= 2;
+    int32_t era = y / 400;
+    int32_t yoe = y - era * 400;
+    int32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int32_t days = era * 146097 + doe - 719468;
+    return (uint32_t)days * 86400u + (time / 1000000) * 3600u + ((time / 10000) % 100) * 60u + (time / 100) % 100;
+}
+
+static void closeBlock() {
+    if (s_blk_len == 0) return;
+    if (s_log.ops) msgLogAppend(s_log, nullptr, 0, s_blk, s_blk_len);
+    s_bytes += s_blk_len;
+    s_blk_len = 0;
+}
+
+static void openBlock(const TrackPoint& p, uint32_t now) {
+    TrackBlockHdr h;
+    h.format = TRACK_FORMAT;
+    h.flags = s_new_segment ? TRACK_B_SEGMENT : 0;
+    h.points = 1;
+    h.t0 = p.t;
+    h.lat0 = p.lat;
+    h.lon0 = p.lon;
+    h.alt0 = p.alt;
+    memcpy(s_blk, &h, sizeof(h));
+    s_blk_len = sizeof(h);
+    s_blk_opened_ms = now;
+    s_new_segment = false;
+    s_last = p;
+    s_last_alt = p.alt;
+    s_prev_dlat = s_prev_dlon = 0;
+    s_prev_dt = 0;
+}
+
+static void addPoint(const TrackPoint& p, uint32_t now) {
+    s_points++;
+    if (s_blk_len == 0) {
+        openBlock(p, now);
+        return;
+    }
+    uint32_t dt = p.t - s_last.t;
+    int32_t dlat = p.lat - s_last.lat;
+    int32_t dlon = p.lon - s_last.lon;
+    int32_t plat = s_prev_dt ? (int32_t)((int64_t)s_prev_dlat * dt / s_prev_dt) : 0;
+    int32_t plon = s_prev_dt ? (int32_t)((int64_t)s_prev_dlon * dt / s_prev_dt) : 0;
+    int32_t dalt = p.alt - s_last_alt;
+    bool has_alt = dalt >= TRACK_ALT_STEP_M || dalt <= -TRACK_ALT_STEP_M;
+
+    uint8_t g[20];
+    uint8_t n = putVarint(g, dt << 1 | (has_alt ? 1 : 0));
+    n += putVarint(g + n, zigzag(dlat - plat));
+    n += putVarint(g + n, zigzag(dlon - plon));
+    if (has_alt) n += putVarint(g + n, zigzag(dalt));
+
+    if (s_blk_len + n > TRACK_BLOCK_MAX) {
+        closeBlock();
+        openBlock(p, now);
+        return;
+    }
+    memcpy(s_blk + s_blk_len, g, n);
+    s_blk_len += n;
+    ((TrackBlockHdr*)s_blk)->points++;
+    s_last = p;
+    if (has_alt) s_last_alt = p.alt;
+    s_prev_dlat = dlat;
+    s_prev_dlon = dlon;
+    s_prev_dt = dt;
+}
+
+// ── Sampling ──
+
+static bool wanted(const TrackPoint& p, float speed, float course) {
+    if (!s_have_last) return true;
+    uint32_t dt = p.t - s_last.t;
+    bool moving = speed >= TRACK_IDLE_MPS;
+    if (dt >= (moving ? TRACK_MAX_INTERVAL_S : TRACK_IDLE_INTERVAL_S)) return true;
+    if (moving) {
+        float turn = fabsf(course - s_last_course);
+        if (turn > 180.0f) turn = 360.0f - turn;
+        if (turn >= TRACK_TURN_DEG) return true;
+    }
+    // Equirectangular distance — fine over a few hundred metres
+    float dy = (p.lat - s_last.lat) * GEO_M_PER_E6;
+    float dx = (p.lon - s_last.lon) * geoLonScale(p.lat);
+    return dx * dx + dy * dy >= (float)TRACK_SPACING_M * TRACK_SPACING_M;
+}
+
+void trackTick(uint32_t now) {
+    if (!s_inited) return;
+    if (s_blk_len && now - s_blk_opened_ms >= TRACK_FLUSH_MS) closeBlock();
+    if (!s_offer.fresh) return;
+    s_offer.fresh = false;
+    if (!s_enabled) return;
+
+    uint32_t t0 = micros();
+    s_offered++;
+    TrackPoint p;
+    p.t = unixTime(s_offer.date, s_offer.time);
+    if (p.t == 0) return;
+    p.lat = (int32_t)lround(s_offer.lat * 1e6);
+    p.lon = (int32_t)lround(s_offer.lon * 1e6);
+    p.alt = (int16_t)constrain(lroundf(s_offer.alt), -32768L, 32767L);
+
+    if (s_have_last && (p.t <= s_last.t || p.t - s_last.t > TRACK_SEGMENT_GAP_S)) {
+        if (p.t == s_last.t) return;        // Same fix again
+        closeBlock();                       // Gap or clock step — new segment
+        s_new_segment = true;
+        s_have_last = false;
+    }
+    if (wanted(p, s_offer.speed, s_offer.course)) {
+        addPoint(p, now);
+        s_have_last = true;
+        s_last_course = s_offer.course;
+    }
+    uint32_t us = micros() - t0;
+    if (us > s_tick_max_us) s_tick_max_us = us;
+}
+
+void trackFlush() {
+    closeBlock();
+}
+
+void trackSetEnabled(bool on) {
+    if (!on) closeBlock();
+    s_enabled = on;
+    s_new_segment = true;
+    s_have_last = false;
+}
+
+void trackClear() {
+    if (!s_inited) trackInit();
+    s_blk_len = 0;
+    s_new_segment = true;
+    s_have_last = false;
+    if (s_log.ops) msgLogClear(s_log);
+}
+
+int trackExport(char* out, size_t out_len, uint32_t from) {
+    if (!s_inited) trackInit();
+    if (!s_log.ops) return snprintf(out, out_len, "ERR{TRK:no flash}");
+    return msgLogExportHex(s_log, "TRK", from, out, out_len);
+}
+
+int trackFormatStats(char* out, size_t out_len) {
+    if (!s_inited) trackInit();
+    uint32_t bytes = s_bytes + s_blk_len;
+    return snprintf(out, out_len,
+                    "OK{TRKSTATS:on=%d,store=%s,blocks=%lu,points=%lu,open=%u,bpp_x100=%lu,offered=%lu,"
+                    "tick_max_us=%lu,erases=%lu,mount_ms=%lu}",
+                    s_enabled ? 1 : 0, s_log.ops ? "qspi" : "none",
+                    (unsigned long)(s_log.ops ? msgLogCount(s_log) : 0), (unsigned long)s_points,
+                    s_blk_len ? ((TrackBlockHdr*)s_blk)->points : 0,
+                    (unsigned long)(s_points ? bytes * 100 / s_points : 0), (unsigned long)s_offered,
+                    (unsigned long)s_tick_max_us, (unsigned long)s_log.erases, (unsigned long)s_mount_ms);
+}
@@ -0,0 +1,70 @@
+// track_log.h — GPS track history on QSPI flash: adaptive sampling, delta/varint-coded blocks
+
+#ifndef TRACK_LOG_H
+#define TRACK_LOG_H
+
+#include <Arduino.h>
+#include "msg_log.h"
+
+// loopGPS() hands every accepted fix to trackOffer(), which only copies it. trackTick() (loop)
+// decides whether the fix becomes a track point and encodes it into the open block in RAM, so
+// loopGPS() never waits for maths or flash.
+//
+// A block is one msg_log record at QSPI_TRACK_BASE: a TrackBlockHdr holding an absolute key point,
+// then one varint group per further point —
+//   tag   = dt_s << 1 | has_alt              unsigned varint
+//   dlat  = zigzag(Δlat - predicted Δlat)    1e-6°, predicted = previous Δlat x dt / previous dt
+//   dlon  = the same for longitude
+//   dalt  = zigzag(Δalt), metres             only when has_alt (moved >= TRACK_ALT_STEP_M)
+// A point costs about 3.5 bytes in its varint group, 4.2 with the key points counted (2.5 h of
+// walking and driving in tests/host/track_log_test.cpp). Every block decodes on its own, so the
+// ring may drop its oldest sector. The open block is written when it is full, TRACK_FLUSH_MS after
+// it was opened, at a segment break and by trackFlush() (power off).
+//
+// Sampling (fixes arrive about every 5 s): a point is taken when the course turned by
+// TRACK_TURN_DEG while moving, after TRACK_SPACING_M, or after TRACK_MAX_INTERVAL_S
+// (TRACK_IDLE_INTERVAL_S when standing still). A gap over TRACK_SEGMENT_GAP_S starts a new segment.
+// build_scripts/track2gpx.py turns a TRKDUMP into GPX.
+
+#define TRACK_FORMAT            1
+#define TRACK_BLOCK_MAX         256         // Bytes per block (header included)
+#define TRACK_FLUSH_MS          300000
+#define TRACK_TURN_DEG          20
+#define TRACK_SPACING_M         25
+#define TRACK_MAX_INTERVAL_S    60
+#define TRACK_IDLE_INTERVAL_S   300
+#define TRACK_IDLE_MPS          0.5f
+#define TRACK_ALT_STEP_M        2
+#define TRACK_SEGMENT_GAP_S     600
+
+#define TRACK_B_SEGMENT         (1 << 0)    // Block starts a new track segment
+
+struct __attribute__((packed)) TrackBlockHdr {
+    uint8_t  format;        // TRACK_FORMAT
+    uint8_t  flags;         // TRACK_B_*
+    uint16_t points;        // Including the key point
+    uint32_t t0;            // Key point, Unix time (UTC from the GPS)
+    int32_t  lat0;          // 1e-6 degrees
+    int32_t  lon0;
+    int16_t  alt0;          // Metres
+};
+
+void trackInit();
+// loopGPS(), good fix only — copies the values, nothing else. date = ddmmyy, time = hhmmsscc.
+void trackOffer(double lat, double lon, float alt_m, float speed_mps, float course_deg,
+                uint32_t date, uint32_t time);
+// Loop context — sampling, encoding, block write-back
+void trackTick(uint32_t now);
+// Write the open block now (power off)
+void trackFlush();
+void trackSetEnabled(bool on);
+void trackClear();
+
+// "OK{TRK:<first>:<hex>,...}{NEXT:<n>}" — blocks from number `from` on (msgLogExportHex)
+int trackExport(char* out, size_t out_len, uint32_t from);
+
+// "OK{TRKSTATS:on=1,store=qspi|none,blocks=..,points=..,open=..,bpp_x100=..,offered=..,
+//  tick_max_us=..,erases=..,mount_ms=..}"
+int trackFormatStats(char* out, size_t out_len);
+
+#endif
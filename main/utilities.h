@@ -49,6 +49,8 @@
 #define Flash_Miso          _PINNUM(1,13)
 #define Flash_Mosi          _PINNUM(1,12)
 #define Flash_Sclk          _PINNUM(1,14)
+#define Flash_Io2           _PINNUM(0,7)
+#define Flash_Io3           _PINNUM(0,5)
 
 #define Touch_Pin           _PINNUM(0,11)
 #define Adc_Pin             _PINNUM(0,4)
@@ -93,10 +95,10 @@
 #endif
 
 #define SerialMon           Serial
-// nRF52840 has no Serial2. GPS UART on P1.8 (TX) / P1.9 (RX).
-// Instance defined in main.ino to match T-Echo pin mapping.
-#include <SoftwareSerial.h>
-extern SoftwareSerial SerialGPS;
+// GPS UART on P1.8 (TX) / P1.9 (RX). The core only sets up Serial1 (UARTE0), so the GPS gets
+// UARTE1 — instance and IRQ handler in main.ino to match T-Echo pin mapping.
+#include <Uart.h>
+extern Uart SerialGPS;
 
 #define MONITOR_SPEED       115200
 
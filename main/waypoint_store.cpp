@@ -0,0 +1,194 @@
+// waypoint_store.cpp — Record slots in retained RAM, latitude-sorted index, nearest / dedup queries
+
+#include "waypoint_store.h"
+#include "geodesy.h"
+#include <math.h>
+
+static WaypointStore& s_st = g_retained.waypoints.body;
+static uint16_t s_by_lat[WP_STORE_MAX];     // Slots sorted by lat_e6
+static bool s_inited = false;
+static uint32_t s_revision = 0;
+
+// Stats
+static uint32_t s_added = 0;
+static uint32_t s_dedup = 0;
+static uint32_t s_evicted = 0;
+static uint32_t s_near_us = 0;
+static uint32_t s_near_max_us = 0;
+static uint16_t s_near_visited = 0;
+
+// First index position whose latitude is >= lat
+static uint16_t lowerBound(int32_t lat) {
+    uint16_t lo = 0, hi = s_st.count;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if (s_st.rec[s_by_lat[mid]].lat_e6 < lat) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static void indexInsert(uint16_t slot, uint16_t n) {
+    uint16_t pos = 0, hi = n;
+    while (pos < hi) {
+        uint16_t mid = (pos + hi) / 2;
+        if (s_st.rec[s_by_lat[mid]].lat_e6 < s_st.rec[slot].lat_e6) pos = mid + 1;
+        else hi = mid;
+    }
+    memmove(&s_by_lat[pos + 1], &s_by_lat[pos], (n - pos) * sizeof(s_by_lat[0]));
+    s_by_lat[pos] = slot;
+}
+
+static void indexRemove(uint16_t slot, uint16_t n) {
+    for (uint16_t i = 0; i < n; i++) {
+        if (s_by_lat[i] != slot) continue;
+        memmove(&s_by_lat[i], &s_by_lat[i + 1], (n - i - 1) * sizeof(s_by_lat[0]));
+        return;
+    }
+}
+
+void wpStoreInit() {
+    if (s_inited) return;
+    s_inited = true;
+    if (s_st.count > WP_STORE_MAX) {
+        memset(&s_st, 0, sizeof(s_st));
+        retainedSeal(RR_WAYPOINT);
+    }
+    for (uint16_t i = 0; i < s_st.count; i++) indexInsert(i, i);
+    s_revision++;
+}
+
+// Squared distance in m² — equirectangular, kx = metres per 1e-6° of longitude at the query latitude
+static float dist2(const WaypointRecord& r, int32_t lat, int32_t lon, float kx) {
+    int32_t dlon = r.lon_e6 - lon;
+    if (dlon > 180000000) dlon -= 360000000;
+    else if (dlon < -180000000) dlon += 360000000;
+    float dx = dlon * kx;
+    float dy = (r.lat_e6 - lat) * GEO_M_PER_E6;
+    return dx * dx + dy * dy;
+}
+
+static void copyStr(char* dst, const char* src, size_t cap) {
+    strncpy(dst, src ? src : "", cap - 1);
+    dst[cap - 1] = '\0';
+}
+
+int wpStoreAdd(double lat, double lon, float alt_m, const char* label, const char* sender, uint8_t flags) {
+    if (!s_inited) wpStoreInit();
+    int32_t la = (int32_t)lround(lat * 1e6);
+    int32_t lo = (int32_t)lround(lon * 1e6);
+    float kx = geoLonScale(la);
+    const char* who = sender ? sender : "";
+
+    // Repeat of a stored waypoint? Only the latitude band of WP_DEDUP_M can match.
+    int32_t band = (int32_t)(WP_DEDUP_M / GEO_M_PER_E6) + 1;
+    int slot = -1;
+    for (uint16_t i = lowerBound(la - band); i < s_st.count; i++) {
+        const WaypointRecord& r = s_st.rec[s_by_lat[i]];
+        if (r.lat_e6 > la + band) break;
+        if (strncmp(r.sender, who, WP_SENDER_LEN) == 0 &&
+            dist2(r, la, lo, kx) <= (float)WP_DEDUP_M * WP_DEDUP_M) {
+            slot = s_by_lat[i];
+            break;
+        }
+    }
+
+    bool fresh = slot < 0;
+    if (fresh) {
+        if (s_st.count < WP_STORE_MAX) {
+            slot = s_st.count++;
+        } else {
+            // Full — least recently seen, never our own
+            for (uint16_t i = 0; i < WP_STORE_MAX; i++) {
+                if (s_st.rec[i].flags & WP_F_OWN) continue;
+                if (slot < 0 || s_st.rec[i].seen < s_st.rec[slot].seen) slot = i;
+            }
+            if (slot < 0) return -1;
+            indexRemove(slot, s_st.count);
+            s_evicted++;
+        }
+    } else {
+        s_dedup++;
+    }
+
+    WaypointRecord& r = s_st.rec[slot];
+    if (fresh) {
+        memset(&r, 0, sizeof(r));
+        r.lat_e6 = la;
+        r.lon_e6 = lo;
+        copyStr(r.sender, who, sizeof(r.sender));
+        indexInsert(slot, s_st.count - 1);
+        s_added++;
+    } else if (r.hits < 255) {
+        r.hits++;
+    }
+    r.alt_m = (int16_t)constrain(lroundf(alt_m), -32768L, 32767L);
+    r.flags |= flags;
+    r.seen = ++s_st.seq;
+    copyStr(r.label, label, sizeof(r.label));
+    retainedSeal(RR_WAYPOINT);
+    s_revision++;
+    return slot;
+}
+
+int wpStoreNearest(double lat, double lon, float* dist_m) {
+    if (!s_inited) wpStoreInit();
+    uint32_t t0 = micros();
+    int32_t la = (int32_t)lround(lat * 1e6);
+    int32_t lo = (int32_t)lround(lon * 1e6);
+    float kx = geoLonScale(la);
+
+    int best = -1;
+    float best_d2 = 0;
+    uint16_t visited = 0;
+    int32_t down = (int32_t)lowerBound(la) - 1;
+    uint16_t up = down + 1;
+    while (down >= 0 || up < s_st.count) {
+        // Take the side whose next latitude is closer; stop when even that one cannot win
+        float gd = down >= 0 ? (la - s_st.rec[s_by_lat[down]].lat_e6) * GEO_M_PER_E6 : INFINITY;
+        float gu = up < s_st.count ? (s_st.rec[s_by_lat[up]].lat_e6 - la) * GEO_M_PER_E6 : INFINITY;
+        float g = gd < gu ? gd : gu;
+        if (best >= 0 && g * g >= best_d2) break;
+        uint16_t slot = gd < gu ? s_by_lat[down--] : s_by_lat[up++];
+        float d2 = dist2(s_st.rec[slot], la, lo, kx);
+        visited++;
+        if (best < 0 || d2 < best_d2) {
+            best = slot;
+            best_d2 = d2;
+        }
+    }
+
+    if (dist_m) *dist_m = best >= 0 ? sqrtf(best_d2) : 0;
+    s_near_visited = visited;
+    s_near_us = micros() - t0;
+    if (s_near_us > s_near_max_us) s_near_max_us = s_near_us;
+    return best;
+}
+
+const WaypointRecord* wpStoreGet(uint16_t slot) {
+    if (!s_inited) wpStoreInit();
+    return slot < s_st.count ? &s_st.rec[slot] : nullptr;
+}
+
+uint16_t wpStoreCount() {
+    if (!s_inited) wpStoreInit();
+    return s_st.count;
+}
+
+uint32_t wpStoreRevision() {
+    return s_revision;
+}
+
+void wpStoreClear() {
+    memset(&s_st, 0, sizeof(s_st));
+    retainedSeal(RR_WAYPOINT);
+    s_revision++;
+}
+
+int wpStoreFormatStats(char* out, size_t out_len) {
+    if (!s_inited) wpStoreInit();
+    return snprintf(out, out_len,
+                    "OK{WPSTATS:n=%u,cap=%u,added=%lu,dedup=%lu,evicted=%lu,near_us=%lu,near_max_us=%lu,near_visited=%u}",
+                    s_st.count, (unsigned)WP_STORE_MAX, (unsigned long)s_added, (unsigned long)s_dedup,
+                    (unsigned long)s_evicted, (unsigned long)s_near_us, (unsigned long)s_near_max_us, s_near_visited);
+}
@@ -0,0 +1,39 @@
+// waypoint_store.h — Waypoints set here or heard on the air: retained POD records, latitude index
+
+#ifndef WAYPOINT_STORE_H
+#define WAYPOINT_STORE_H
+
+#include <Arduino.h>
+#include "retained_ram.h"
+
+// Records live in the RR_WAYPOINT retained region (WaypointRecord, retained_ram.h), so they
+// survive a reset but not a power cycle. The RAM index is derived from them and is rebuilt by
+// wpStoreInit(): the record slots sorted by latitude. A nearest query binary-searches the caller's
+// latitude and walks outwards on both sides. It stops once the latitude gap alone is larger than
+// the best distance so far, so it only visits the waypoints in a narrow band.
+//
+// Dedup: startWaypointBroadcast() repeats one waypoint every WP_BROADCAST_INTERVAL_MS for a minute.
+// A waypoint from the same sender within WP_DEDUP_M of a stored one refreshes that record (label,
+// altitude, seen, hits) instead of taking a new slot. When the store is full, the least recently
+// seen record that is not our own is replaced.
+
+#define WP_DEDUP_M              15
+
+#define WP_F_OWN                (1 << 0)    // Set on this device
+
+// After retainedInit()
+void wpStoreInit();
+// Returns the slot, or -1 when every slot holds one of our own waypoints
+int  wpStoreAdd(double lat, double lon, float alt_m, const char* label, const char* sender, uint8_t flags);
+// Slot nearest to (lat, lon), -1 if the store is empty; *dist_m = distance in metres
+int  wpStoreNearest(double lat, double lon, float* dist_m);
+const WaypointRecord* wpStoreGet(uint16_t slot);
+uint16_t wpStoreCount();
+// Changes with every add / clear — lets the WP layout skip the nearest query
+uint32_t wpStoreRevision();
+void wpStoreClear();
+
+// "OK{WPSTATS:n=..,cap=..,added=..,dedup=..,evicted=..,near_us=..,near_max_us=..,near_visited=..}"
+int wpStoreFormatStats(char* out, size_t out_len);
+
+#endif
@@ -0,0 +1,215 @@
+// buddy_list_test.cpp — the contact directory with device IDs as they arrive: 8 hex digits
+//
+// IDs are formatted as bleGetDeviceIdShort() does ("%08X") and go in the way lora.cpp (beacons)
+// and SETBUDDY (buddyImportCsv) put them in. Every one must be looked up both ways, exported whole
+// and land whole in the flash pages, which are decoded here by hand in the on-flash format. A page
+// in the previous format (8-byte device_id) on the chip at boot is ignored.
+//
+//   buddy_list_test
+
+#include "buddy_list.h"
+#include "qspi_flash.h"
+#include "flash_host.h"
+#include <map>
+#include <string>
+
+// ── On-flash format (buddy_list.cpp), written and read by hand ──
+struct __attribute__((packed)) PageHdr {
+    uint32_t magic, seq, check;
+    uint16_t page, count, format;
+    uint8_t  _pad[14];
+};
+
+struct __attribute__((packed)) Rec {
+    char    call_sign[16];
+    char    device_id[9];
+    uint8_t used;
+    uint8_t _pad[6];
+};
+
+struct __attribute__((packed)) RecV1 {
+    char    call_sign[16];
+    char    device_id[8];
+    uint8_t used;
+    uint8_t _pad[7];
+};
+
+static_assert(sizeof(PageHdr) == 32 && sizeof(Rec) == 32 && sizeof(RecV1) == 32, "record size");
+
+#define PAGE_MAGIC  0x59444442
+#define PAGE_RECS   127
+
+// ── Harness ──
+static int s_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                  \
+            s_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+static void begin(const char* name) { printf("== %s\n", name); }
+
+static uint32_t fnv(const void* p, uint32_t len, uint32_t h = 2166136261u) {
+    const uint8_t* b = (const uint8_t*)p;
+    for (uint32_t i = 0; i < len; i++) {
+        h ^= b[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static std::string devId(uint32_t n) {
+    char id[9];
+    snprintf(id, sizeof(id), "%08X", (unsigned)n);
+    return id;
+}
+
+static std::string sign(uint32_t n) {
+    char cs[16];
+    snprintf(cs, sizeof(cs), "OP-%u", (unsigned)n);
+    return cs;
+}
+
+// A verifying format 1 page 0, copy 0, holding one contact with a 7-digit ID (the most it took)
+static void writeV1Page() {
+    uint8_t sector[FLASH_SECTOR_SIZE];
+    memset(sector, 0, sizeof(sector));
+    RecV1* recs = (RecV1*)(sector + sizeof(PageHdr));
+    strcpy(recs[0].call_sign, "OLDTIMER");
+    strcpy(recs[0].device_id, "1234567");
+    recs[0].used = 1;
+    PageHdr h = {};
+    h.magic = PAGE_MAGIC;
+    h.seq = 1;
+    h.check = fnv(recs, PAGE_RECS * sizeof(RecV1));
+    h.count = 1;
+    memcpy(sector, &h, sizeof(h));
+    const FlashOps& ops = qspiFlashOps();
+    CHECK(ops.erase(QSPI_BUDDY_BASE));
+    for (uint32_t off = 0; off < sizeof(PageHdr) + PAGE_RECS * sizeof(RecV1); off += 256) {
+        CHECK(ops.program(QSPI_BUDDY_BASE + off, sector + off, 256));
+    }
+}
+
+// Every contact in the newest verifying copy of each page, device ID -> call sign
+static std::map<std::string, std::string> readPages() {
+    std::map<std::string, std::string> out;
+    const FlashOps& ops = qspiFlashOps();
+    for (uint8_t page = 0; page < BUDDY_PAGES; page++) {
+        PageHdr best = {};
+        int best_copy = -1;
+        for (uint8_t c = 0; c < 2; c++) {
+            PageHdr h;
+            CHECK(ops.read(QSPI_BUDDY_BASE + (page * 2 + c) * FLASH_SECTOR_SIZE, &h, sizeof(h)));
+            if (h.magic != PAGE_MAGIC || h.seq == 0xFFFFFFFF || h.page != page) continue;
+            if (best_copy < 0 || h.seq > best.seq) best = h, best_copy = c;
+        }
+        if (best_copy < 0) continue;
+        CHECK(best.format == 2);
+        static Rec recs[PAGE_RECS];
+        uint32_t addr = QSPI_BUDDY_BASE + (page * 2 + best_copy) * FLASH_SECTOR_SIZE + sizeof(PageHdr);
+        CHECK(ops.read(addr, recs, sizeof(recs)));
+        CHECK(fnv(recs, sizeof(recs)) == best.check);
+        for (const Rec& r : recs) {
+            if (r.used) out[std::string(r.device_id, strnlen(r.device_id, sizeof(r.device_id)))] = r.call_sign;
+        }
+    }
+    return out;
+}
+
+// ── Cases ──
+static void testOldPagesIgnored() {
+    begin("format 1 page on the chip at boot: ignored");
+    buddyInit();
+    CHECK(buddyCount() == 0);
+    CHECK(buddyLookupIdByCallSign("OLDTIMER")[0] == '\0');
+}
+
+static void testBeacons() {
+    begin("beacons: 8-digit IDs from the air");
+    for (uint32_t i = 0; i < 300; i++) buddyAddOrUpdate(devId(0xA0000000u + i * 7919).c_str(), sign(i).c_str());
+    CHECK(buddyCount() == 300);
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < 300; i++) {
+        std::string id = devId(0xA0000000u + i * 7919);
+        found += sign(i) == buddyLookupName(id.c_str()) && id == buddyLookupIdByCallSign(sign(i).c_str());
+    }
+    printf("  %u of 300 found both ways\n", (unsigned)found);
+    CHECK(found == 300);
+
+    // The same beacon again changes nothing; a new call sign replaces the old one
+    buddyAddOrUpdate(devId(0xA0000000u).c_str(), sign(0).c_str());
+    CHECK(buddyCount() == 300);
+    buddyAddOrUpdate(devId(0xA0000000u).c_str(), "RENAMED");
+    CHECK(strcmp(buddyLookupName(devId(0xA0000000u).c_str()), "RENAMED") == 0);
+    CHECK(buddyLookupIdByCallSign(sign(0).c_str())[0] == '\0');
+
+    // Longer than an ID is not one
+    buddyAddOrUpdate("123456789", "TOOLONG");
+    CHECK(buddyCount() == 300);
+    CHECK(buddyLookupIdByCallSign("TOOLONG")[0] == '\0');
+}
+
+static void testSetBuddy() {
+    begin("SETBUDDY / GETBUDDY with 8-digit IDs");
+    std::string csv = "CNALPHA|DI0A1B2C3D,CNBRAVO|DIFFFFFFFF,CNCHARLIE|DI00000001";
+    CHECK(buddyImportCsv(csv.c_str()) == 3);
+    CHECK(strcmp(buddyLookupName("0A1B2C3D"), "ALPHA") == 0);
+    CHECK(strcmp(buddyLookupName("FFFFFFFF"), "BRAVO") == 0);
+    CHECK(strcmp(buddyLookupIdByCallSign("CHARLIE"), "00000001") == 0);
+    CHECK(buddyImportCsv("-DIFFFFFFFF") == 1);
+    CHECK(buddyLookupName("FFFFFFFF")[0] == '\0');
+    CHECK(buddyImportCsv("CNTOOLONG|DI123456789") == 0);
+
+    // Paged export carries every ID whole
+    char buf[200];
+    uint16_t cursor = 0;
+    std::string all;
+    do {
+        if (buddyExportCsv(buf, sizeof(buf), cursor)) all += buf;
+    } while (cursor != BUDDY_EXPORT_DONE);
+    CHECK(all.find("CNALPHA|DI0A1B2C3D,") != std::string::npos);
+    CHECK(all.find("CNCHARLIE|DI00000001,") != std::string::npos);
+    CHECK(all.find("CNOP-7|DI" + devId(0xA0000000u + 7 * 7919) + ",") != std::string::npos);
+    CHECK(all.find("BRAVO") == std::string::npos);
+}
+
+static void testPages() {
+    begin("flush: IDs whole in the flash pages");
+    buddyFlush();
+    std::map<std::string, std::string> pages = readPages();
+    printf("  %zu contacts in the pages, %u in the directory\n", pages.size(), buddyCount());
+    CHECK(pages.size() == buddyCount());
+    CHECK(pages["0A1B2C3D"] == "ALPHA");
+    CHECK(pages[devId(0xA0000000u + 299 * 7919)] == sign(299));
+    CHECK(pages.count("1234567") == 0);
+}
+
+static void testFull() {
+    begin("full directory: eviction with 8-digit IDs");
+    for (uint32_t i = 0; i < 2 * BUDDY_MAX_CONTACTS; i++) {
+        buddyAddOrUpdate(devId(0xB0000000u + i).c_str(), sign(10000 + i).c_str());
+    }
+    char stats[200];
+    buddyFormatStats(stats, sizeof(stats));
+    printf("  %s\n", stats);
+    CHECK(buddyCount() == BUDDY_MAX_CONTACTS);
+    uint32_t last = 2 * BUDDY_MAX_CONTACTS - 1;
+    CHECK(sign(10000 + last) == buddyLookupName(devId(0xB0000000u + last).c_str()));
+}
+
+int main() {
+    hostFlashReset();
+    qspiFlashInit();
+    writeV1Page();
+    testOldPagesIgnored();
+    testBeacons();
+    testSetBuddy();
+    testPages();
+    testFull();
+    if (s_failures) printf("%d checks FAILED\n", s_failures);
+    return s_failures ? 1 : 0;
+}
@@ -0,0 +1,26 @@
+// env_display.cpp — The firmware globals display.cpp reads, for builds that render from fixtures
+//
+// The layouts themselves read only layout_state; these exist so display.cpp links. Anything that
+// would capture live state in a layout test is a bug in the test, so the capture aborts.
+
+#include "display_layout.h"
+#include "gps.h"
+#include "epoch_clock.h"
+
+const char* current_mode = "TXT";
+bool in_settings_mode = false;
+DeviceSettings deviceSettings;
+char channels[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+GPSStatus gps_status = NO_GPS;
+int gps_satellites = 0;
+float currentFrequency = 869.525f;
+
+int getBitrateFromIndex(int) { return 1300; }
+uint8_t getBatteryPercentage() { return 100; }
+RTC_Date clockDateTime() { return RTC_Date(2026, 1, 1, 12, 0, 0); }
+void markScreenDirty() {}
+
+void layoutCaptureLive(uint16_t) {
+    fprintf(stderr, "layoutCaptureLive() called outside fixture mode\n");
+    abort();
+}
@@ -0,0 +1,36 @@
+// epd_host.cpp — disp_refresh.h on the host: no SPI, no waveform, every frame lands at once
+
+#include "epd_host.h"
+#include "disp_refresh.h"
+
+static HostEpdFrame s_last;
+static bool s_inflight = false;
+
+const HostEpdFrame& hostEpdLastFrame() { return s_last; }
+
+void initDispRefresh(SPIClass*, SPISettings, NRF_SPIM_Type*) {}
+bool isEpdRefreshing() { return s_inflight; }
+bool isEpdBusy() { return s_inflight; }
+bool epdLastFrameOk() { return true; }
+void triggerEpdRefresh(bool) {}
+void epdSetGRAMWindow(uint16_t, uint16_t, uint16_t, uint16_t) {}
+
+bool epdStartFrame(const uint8_t*, uint16_t x, uint16_t y, uint16_t w, uint16_t h, bool full_refresh) {
+    s_last.x = x;
+    s_last.y = y;
+    s_last.w = w;
+    s_last.h = h;
+    s_last.full = full_refresh;
+    s_last.count++;
+    s_inflight = true;
+    return true;
+}
+
+bool stepEpdRefresh() {
+    if (!s_inflight) return false;
+    s_inflight = false;
+    return true;
+}
+
+void epdPowerOffNow() {}
+bool epdWriteAndRefreshRect(uint16_t, uint16_t, uint16_t, uint16_t, uint8_t) { return true; }
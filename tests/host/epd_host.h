@@ -0,0 +1,17 @@
+// epd_host.h — host stand-in for disp_refresh: frames "reach the panel" the moment they start
+
+#ifndef EPD_HOST_H
+#define EPD_HOST_H
+
+#include <Arduino.h>
+
+struct HostEpdFrame {
+    uint16_t x, y, w, h;    // Controller orientation, as disp_dirty hands it over
+    bool full;
+    uint32_t count;         // Frames started so far
+};
+
+// Last frame started by disp_dirty
+const HostEpdFrame& hostEpdLastFrame();
+
+#endif
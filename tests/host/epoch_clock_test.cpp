@@ -0,0 +1,180 @@
+// epoch_clock_test.cpp — NMEA time paired with its PPS edge through a loop that stalls
+//
+// Simulated millisecond by millisecond: a PPS edge at the start of every GPS second (the tick a
+// little fast against it), RMC + GGA for that second streaming in from 120 ms after the edge at
+// 9600 Bd into the UART ring, and a loop that runs gnssPoll() / clockGpsTime() as loopGPS() does
+// every LOOP_MS — except when it is held up for STALL_MIN_MS..STALL_MAX_MS, as by a full e-paper
+// refresh. Often the loop only gets to a sentence after the next edge; the clock must still read
+// the GPS time within CLOCK_ERR_MAX_MS every time the loop looks at it.
+//
+// The first run pairs the way the loop used to (the latest edge when the sentence is handled) to
+// show the scenario hits the one-second error; then 1 Hz and 5 Hz with the edge gnss.cpp records.
+//
+//   epoch_clock_test
+
+#include "epoch_clock.h"
+#include "gnss.h"
+#include "utilities.h"
+#include <deque>
+#include <string>
+
+#define SIM_S           1200
+#define LOOP_MS         10
+#define STALL_PER_MILLE 5           // Chance per loop pass
+#define STALL_MIN_MS    200
+#define STALL_MAX_MS    2500
+#define NMEA_DELAY_MS   120         // Edge to the first '$' of the second
+#define TICK_PPM        30          // millis() runs this fast against GPS
+#define CLOCK_ERR_MAX_MS 2
+
+// Firmware globals the modules under test use
+Uart SerialGPS;
+PCF8563_Class rtc;
+
+// ── Harness ──
+static int s_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                  \
+            s_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+static void begin(const char* name) { printf("== %s\n", name); }
+
+// ── Receiver ──
+static std::string nmea(const char* body) {
+    uint8_t cs = 0;
+    for (const char* p = body; *p; p++) cs ^= (uint8_t)*p;
+    char line[120];
+    snprintf(line, sizeof(line), "$%s*%02X\r\n", body, cs);
+    return line;
+}
+
+// RMC + GGA for epoch + cc/100 s
+static std::string sentences(uint32_t epoch, uint8_t cc) {
+    RTC_Date d = clockToCivil(epoch);
+    char t[16], body[100];
+    snprintf(t, sizeof(t), "%02u%02u%02u.%02u", d.hour, d.minute, d.second, cc);
+    snprintf(body, sizeof(body), "GNRMC,%s,A,5222.2130,N,00453.7101,E,0.12,0.00,%02u%02u%02u,,,A", t, d.day, d.month,
+             d.year % 100);
+    std::string s = nmea(body);
+    snprintf(body, sizeof(body), "GNGGA,%s,5222.2130,N,00453.7101,E,1,04,1.8,4.0,M,46.0,M,,", t);
+    return s + nmea(body);
+}
+
+struct Burst {
+    uint32_t at;            // millis() of the first byte
+    std::string bytes;
+};
+
+enum Pairing { PAIR_AT_HANDLING, PAIR_AT_SENTENCE };
+
+struct Result {
+    uint32_t handled, prompt, after_edge, unpaired, looks, bad, wrong_second;
+    int32_t  worst;
+};
+
+// One run of sim_s seconds; the timeline carries on from the previous run
+static Result run(Pairing pairing, uint16_t fix_ms, uint32_t sim_s) {
+    static uint32_t edge = 0, gps = 0;      // Edges so far, GPS second of the last one
+    static uint64_t edge_us = 0;            // When it came, in millis() time
+    static uint32_t t = 0;
+    if (gps == 0) {
+        gps = clockFromCivil(2026, 6, 19, 12, 0, 0);
+        t = 1000;
+        edge_us = 700000;
+        hostSetClock(t);
+    }
+    Result r = {};
+    std::deque<Burst> air;
+    uint32_t loop_at = t, end = t + sim_s * 1000;
+    for (; t < end; t++, hostAdvanceClock(1)) {
+        // The tick is fast, so the next edge comes a little after 1000 ms of it
+        if ((uint64_t)t * 1000 >= edge_us + 1000000 + TICK_PPM) {
+            edge_us += 1000000 + TICK_PPM;
+            edge++;
+            gps++;
+            hostInterrupt(Gps_pps_Pin);
+            for (uint16_t k = 0; k < 1000; k += fix_ms) {
+                air.push_back({ t + NMEA_DELAY_MS + k, sentences(gps, k / 10) });
+            }
+        }
+        // 9600 Bd: about a byte a millisecond
+        if (!air.empty() && air.front().at <= t) {
+            SerialGPS.hostRx(air.front().bytes.data(), 1);
+            air.front().bytes.erase(0, 1);
+            if (air.front().bytes.empty()) air.pop_front();
+        }
+        if (t < loop_at) continue;
+        loop_at = t + (random(1000) < STALL_PER_MILLE ? random(STALL_MIN_MS, STALL_MAX_MS) : LOOP_MS);
+
+        // loopGPS()
+        gnssPoll(millis());
+        if (gnssUpdated(GNSS_F_TIME | GNSS_F_DATE)) {
+            const GnssFix& fix = gnssFix();
+            gnssClear(GNSS_F_TIME | GNSS_F_DATE);
+            uint32_t pps = pairing == PAIR_AT_SENTENCE ? fix.time_pps : clockPpsEdge(millis());
+            clockGpsTime(clockFromCivil(2000 + fix.date % 100, (fix.date / 100) % 100, fix.date / 10000,
+                                        fix.time / 1000000, (fix.time / 10000) % 100, (fix.time / 100) % 100),
+                         pps);
+            r.handled++;
+            if (pps == 0) r.unpaired++;
+            else if (pps == edge) r.prompt++;
+            else r.after_edge++;
+        }
+
+        // Whatever else the loop does with the time, it reads the GPS second — once this run paired
+        if (clockSource() != CLOCK_SRC_PPS || r.prompt + r.after_edge == 0) continue;
+        uint16_t ms;
+        uint32_t now = clockNow(&ms);
+        int64_t truth = (int64_t)gps * 1000 + ((int64_t)t * 1000 - (int64_t)edge_us) / 1000;
+        int32_t err = (int32_t)((int64_t)now * 1000 + ms - truth);
+        r.looks++;
+        if (abs(err) > abs(r.worst)) r.worst = err;
+        if (abs(err) > CLOCK_ERR_MAX_MS) r.bad++;
+        if (abs(err) >= 500) r.wrong_second++;
+    }
+    return r;
+}
+
+static void report(const Result& r) {
+    printf("  %lu sentences: %lu paired before the next edge, %lu after it, %lu unpaired\n",
+           (unsigned long)r.handled, (unsigned long)r.prompt, (unsigned long)r.after_edge, (unsigned long)r.unpaired);
+    printf("  %lu clock reads, %lu off by more than %d ms (%lu by a second), worst %ld ms\n", (unsigned long)r.looks,
+           (unsigned long)r.bad, CLOCK_ERR_MAX_MS, (unsigned long)r.wrong_second, (long)r.worst);
+}
+
+int main() {
+    randomSeed(48);
+    clockInit(false);
+    clockAttachPps(Gps_pps_Pin);
+    gnssBegin(GNSS_FIX_MS_DEFAULT);
+
+    begin("latest edge when the loop handles the sentence (as before)");
+    Result old = run(PAIR_AT_HANDLING, 1000, SIM_S);
+    report(old);
+    CHECK(old.wrong_second > 0);
+
+    begin("1 Hz, edge recorded as the sentence began");
+    Result r1 = run(PAIR_AT_SENTENCE, 1000, SIM_S);
+    report(r1);
+    CHECK(r1.after_edge > 0);
+    CHECK(r1.bad == 0);
+
+    begin("5 Hz, only the .00 sentence pairs");
+    Result r5 = run(PAIR_AT_SENTENCE, 200, SIM_S);
+    report(r5);
+    CHECK(r5.unpaired > r5.prompt + r5.after_edge);
+    CHECK(r5.bad == 0);
+
+    char stats[240];
+    clockFormatStats(stats, sizeof(stats));
+    printf("  %s\n", stats);
+    gnssFormatStats(stats, sizeof(stats));
+    printf("  %s\n", stats);
+    if (s_failures) printf("%d checks FAILED\n", s_failures);
+    return s_failures ? 1 : 0;
+}
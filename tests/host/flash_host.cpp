@@ -0,0 +1,80 @@
+// flash_host.cpp — 2 MiB NOR chip in memory: erase sets 0xFF, program ANDs, like the MX25R1635F
+
+#include "flash_host.h"
+#include <Adafruit_SPIFlashBase.h>
+
+static uint8_t s_mem[HOST_FLASH_SIZE];
+static bool s_init = false;
+static HostFlashStats s_stats;
+
+static bool s_armed = false;
+static bool s_cut = false;
+static uint32_t s_ops_left = 0;
+static uint16_t s_keep = 0;
+
+void hostFlashReset() {
+    memset(s_mem, 0xFF, sizeof(s_mem));
+    s_init = true;
+    s_armed = s_cut = false;
+    hostFlashClearStats();
+}
+
+const HostFlashStats& hostFlashStats() { return s_stats; }
+void hostFlashClearStats() { memset(&s_stats, 0, sizeof(s_stats)); }
+
+void hostFlashCutAfter(uint32_t ops, uint16_t keep_256ths) {
+    s_armed = true;
+    s_ops_left = ops;
+    s_keep = keep_256ths;
+}
+
+bool hostFlashCut() { return s_cut; }
+
+void hostFlashPowerOn() { s_armed = s_cut = false; }
+
+// Bytes of a len-byte write that land: all, a prefix on the op the cut hits, none after it
+static uint32_t landing(uint32_t len) {
+    if (s_cut) return 0;
+    if (!s_armed) return len;
+    if (s_ops_left > 0) {
+        s_ops_left--;
+        return len;
+    }
+    s_cut = true;
+    return (uint32_t)((uint64_t)len * s_keep / 256);
+}
+
+bool Adafruit_SPIFlashBase::begin() {
+    if (!s_init) hostFlashReset();
+    return true;
+}
+
+uint32_t Adafruit_SPIFlashBase::size() { return HOST_FLASH_SIZE; }
+
+uint32_t Adafruit_SPIFlashBase::readBuffer(uint32_t address, uint8_t* buffer, uint32_t len) {
+    if (s_cut || address + len > HOST_FLASH_SIZE) return 0;
+    memcpy(buffer, s_mem + address, len);
+    s_stats.reads++;
+    s_stats.read_bytes += len;
+    return len;
+}
+
+uint32_t Adafruit_SPIFlashBase::writeBuffer(uint32_t address, uint8_t const* buffer, uint32_t len) {
+    if (address + len > HOST_FLASH_SIZE) return 0;
+    uint32_t n = landing(len);
+    for (uint32_t i = 0; i < n; i++) s_mem[address + i] &= buffer[i];
+    if (n) {
+        s_stats.programs++;
+        s_stats.program_bytes += n;
+    }
+    return n == len ? len : 0;
+}
+
+bool Adafruit_SPIFlashBase::eraseSector(uint32_t sectorNumber) {
+    uint32_t addr = sectorNumber * HOST_FLASH_SECTOR;
+    if (addr + HOST_FLASH_SECTOR > HOST_FLASH_SIZE) return false;
+    uint32_t n = landing(HOST_FLASH_SECTOR);
+    memset(s_mem + addr, 0xFF, n);
+    if (n) s_stats.erases++;
+    return n == HOST_FLASH_SECTOR;
+}
@@ -0,0 +1,29 @@
+// flash_host.h — the in-memory NOR chip behind the host Adafruit_SPIFlashBase: op counters and
+// power cuts
+
+#ifndef FLASH_HOST_H
+#define FLASH_HOST_H
+
+#include <Arduino.h>
+
+#define HOST_FLASH_SIZE     (2UL * 1024 * 1024)
+#define HOST_FLASH_SECTOR   4096
+
+struct HostFlashStats {
+    uint32_t reads, programs, erases;
+    uint64_t read_bytes, program_bytes;
+};
+
+// Whole chip back to 0xFF, counters and power cut cleared
+void hostFlashReset();
+const HostFlashStats& hostFlashStats();
+void hostFlashClearStats();
+
+// Power cut after `ops` more program/erase operations. The operation the cut lands on is applied
+// only partly — keep_256ths of its bytes, from the start — and every access after it fails until
+// hostFlashPowerOn(). keep_256ths 0 cuts just before it.
+void hostFlashCutAfter(uint32_t ops, uint16_t keep_256ths);
+bool hostFlashCut();
+void hostFlashPowerOn();
+
+#endif
@@ -0,0 +1,69 @@
+// font_bench.cpp — Full-screen text through Adafruit_GFX's per-pixel path vs the atlas blitter
+//
+// Both passes must leave the same frame; the run fails otherwise. Times are the best of
+// FB_RUNS, so a busy host doesn't skew the ratio.
+
+#include "disp_dirty.h"
+#include "display.h"
+#include "display_layout.h"
+#include <Fonts/FreeMonoBold9pt7b.h>
+#include <Fonts/FreeMonoBold12pt7b.h>
+#include <Fonts/Org_01.h>
+
+#define FB_RUNS     50
+
+static const size_t FRAME_BYTES = DISP_MIRROR_W / 8 * DISP_MIRROR_H;
+
+static uint32_t renderScreen(const GFXfont* font, int16_t x0, uint8_t line_h, bool blit, uint16_t& chars) {
+    static const char line[] = "The quick fox 0123456789";
+    fontBlitEnable(blit);
+    display->fillScreen(GxEPD_WHITE);
+    display->setFont(font);
+    display->setTextColor(GxEPD_BLACK);
+    chars = 0;
+    uint32_t t0 = micros();
+    for (int16_t y = line_h; y < DISP_MIRROR_H; y += line_h) {
+        display->setCursor(x0, y);
+        display->print(line);
+        chars += sizeof(line) - 1;
+    }
+    uint32_t us = micros() - t0;
+    fontBlitEnable(true);
+    return us;
+}
+
+static bool benchFont(const char* name, const GFXfont* font, int16_t x0, uint8_t line_h) {
+    static uint8_t pixel_frame[FRAME_BYTES];
+    uint16_t chars = 0;
+    uint32_t pixel_us = UINT32_MAX, blit_us = UINT32_MAX;
+    for (int i = 0; i < FB_RUNS; i++) {
+        uint32_t us = renderScreen(font, x0, line_h, false, chars);
+        if (us < pixel_us) pixel_us = us;
+    }
+    memcpy(pixel_frame, dispMirrorFrame(), FRAME_BYTES);
+    for (int i = 0; i < FB_RUNS; i++) {
+        uint32_t us = renderScreen(font, x0, line_h, true, chars);
+        if (us < blit_us) blit_us = us;
+    }
+    bool same = memcmp(pixel_frame, dispMirrorFrame(), FRAME_BYTES) == 0;
+    printf("%-22s x0=%d chars=%u pixel_us=%lu blit_us=%lu speedup=%.1fx %s\n", name, x0, chars,
+           (unsigned long)pixel_us, (unsigned long)blit_us, blit_us ? (double)pixel_us / blit_us : 0.0,
+           same ? "frames match" : "FRAMES DIFFER");
+    return same;
+}
+
+int main() {
+    display = new EpdTracked(GxEPD2_150_BN(0, 0, 0, 0));
+    display->setRotation(3);
+
+    bool ok = true;
+    ok &= benchFont("FreeMonoBold9pt7b", &FreeMonoBold9pt7b, 0, 18);      // Byte-aligned fast path
+    ok &= benchFont("FreeMonoBold9pt7b", &FreeMonoBold9pt7b, 1, 18);      // Shifted path
+    ok &= benchFont("FreeMonoBold12pt7b", &FreeMonoBold12pt7b, 3, 24);
+    ok &= benchFont("Org_01", &Org_01, 5, 8);
+
+    char out[96];
+    fontBlitBenchmark(out, sizeof(out));
+    printf("%s\n", out);
+    return ok ? 0 : 1;
+}
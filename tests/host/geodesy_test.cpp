@@ -0,0 +1,186 @@
+// geodesy_test.cpp — geodesy.h float kernels against the same formulas in double, bounds enforced
+//
+// Random pairs over the whole sphere plus the awkward places — near the poles, near the antipode,
+// both sides of the equirectangular cut-over — through geoDistanceE6 / geoBearingE6 and the
+// cached-origin path. The reference is haversine and the initial great-circle bearing in double on
+// the same int32 1e-6° inputs and the same sphere, so the figures are the kernels' own error; the
+// worst pair of each class is printed so a regression can be replayed.
+//
+//   geodesy_test
+
+#include "geodesy.h"
+
+#define PAIRS           2000000
+
+// Bounds geodesy.h quotes
+#define EQR_REL_MAX             2e-6        // Short range: distance, relative
+#define EQR_BEARING_MAX_DEG     0.1
+#define HAV_NEAR_M              400000.0    // Haversine: absolute error below this distance ...
+#define HAV_ABS_MAX_M           0.2
+#define HAV_REL_MAX             5e-7        // ... relative above it
+#define HAV_BEARING_MAX_DEG     0.002
+#define BEARING_MIN_M           10.0        // Bearings to closer points are not compared
+#define BEARING_ANTIPODE_M      10000.0     // Nor within this of the antipode, where any is right
+
+static const double R = GEO_EARTH_R_M;
+static const double RAD = M_PI / 180e6;
+
+static double refDistance(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2) {
+    double p1 = lat1 * RAD, p2 = lat2 * RAD, dl = (double)(lon2 - lon1) * RAD;
+    double hs = sin((p2 - p1) / 2), hl = sin(dl / 2);
+    double a = hs * hs + cos(p1) * cos(p2) * hl * hl;
+    return 2 * R * atan2(sqrt(a), sqrt(fmax(1 - a, 0.0)));
+}
+
+static double refBearing(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2) {
+    double p1 = lat1 * RAD, p2 = lat2 * RAD, dl = (double)(lon2 - lon1) * RAD;
+    double deg = atan2(sin(dl) * cos(p2), cos(p1) * sin(p2) - sin(p1) * cos(p2) * cos(dl)) * 180 / M_PI;
+    return deg < 0 ? deg + 360 : deg;
+}
+
+static double angleDiff(double a, double b) {
+    double d = fabs(a - b);
+    return d > 180 ? 360 - d : d;
+}
+
+// ── Pair generation ──
+static uint64_t s_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t next() {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 7;
+    s_rng ^= s_rng << 17;
+    return s_rng;
+}
+
+// Uniform in [lo, hi]
+static int32_t uniform(int32_t lo, int32_t hi) {
+    return lo + (int32_t)(next() % (uint64_t)((int64_t)hi - lo + 1));
+}
+
+static int32_t clampLat(int64_t lat) {
+    return (int32_t)(lat > 90000000 ? 90000000 : lat < -90000000 ? -90000000 : lat);
+}
+
+static int32_t wrapLon(int64_t lon) {
+    while (lon > 180000000) lon -= 360000000;
+    while (lon <= -180000000) lon += 360000000;
+    return (int32_t)lon;
+}
+
+struct Pair {
+    int32_t lat1, lon1, lat2, lon2;
+};
+
+// Point 2 somewhere within `span` (1e-6°) of point 1, point 1 anywhere in [lat_lo, lat_hi]
+static Pair near(int32_t lat_lo, int32_t lat_hi, int32_t span) {
+    Pair p;
+    p.lat1 = uniform(lat_lo, lat_hi);
+    p.lon1 = uniform(-179999999, 180000000);
+    p.lat2 = clampLat((int64_t)p.lat1 + uniform(-span, span));
+    p.lon2 = wrapLon((int64_t)p.lon1 + uniform(-span, span));
+    return p;
+}
+
+static Pair pairFor(uint32_t i) {
+    switch (i % 6) {
+    case 0: {                                       // Anywhere to anywhere
+        Pair p = { uniform(-90000000, 90000000), uniform(-179999999, 180000000),
+                   uniform(-90000000, 90000000), uniform(-179999999, 180000000) };
+        return p;
+    }
+    case 1: return near(-89000000, 89000000, 1 << (next() % 22));        // Metres to ~450 km
+    case 2: return near(-89000000, 89000000, GEO_EQR_MAX_E6 + 10000);    // Either side of the cut-over
+    case 3: {                                                           // Near the poles
+        Pair p = near(86000000, 90000000, 1 << (next() % 23));
+        if (next() & 1) p.lat1 = -p.lat1, p.lat2 = -p.lat2;
+        return p;
+    }
+    default: {                                      // Near the antipode of point 1
+        Pair p = near(-90000000, 90000000, 1 << (next() % 24));
+        p.lat2 = clampLat(-(int64_t)p.lat2);
+        p.lon2 = wrapLon((int64_t)p.lon2 + 180000000);
+        return p;
+    }
+    }
+}
+
+// ── Error classes ──
+struct Worst {
+    const char* name;
+    double bound;
+    double err;
+    Pair at;
+    double ref;
+    uint32_t n;
+
+    void add(double e, const Pair& p, double r) {
+        n++;
+        if (e > err) err = e, at = p, ref = r;
+    }
+    bool report() const {
+        bool ok = err <= bound;
+        printf("  %-28s n=%-8lu max=%-12.4g bound=%-9.4g %s  (%ld,%ld)->(%ld,%ld) d=%.0f m\n", name, (unsigned long)n,
+               err, bound, ok ? "ok  " : "FAIL", (long)at.lat1, (long)at.lon1, (long)at.lat2, (long)at.lon2, ref);
+        return ok;
+    }
+};
+
+static bool shortRange(const Pair& p) {
+    int32_t dlat = p.lat2 - p.lat1;
+    int32_t dlon = wrapLon((int64_t)p.lon2 - p.lon1);
+    return abs(dlat) < GEO_EQR_MAX_E6 && abs(dlon) < GEO_EQR_MAX_E6 && abs(p.lat1) < GEO_EQR_MAX_LAT_E6;
+}
+
+struct Classes {
+    Worst eqr_rel = { "short range distance (rel)", EQR_REL_MAX };
+    Worst eqr_brg = { "short range bearing (deg)", EQR_BEARING_MAX_DEG };
+    Worst hav_abs = { "haversine < 400 km (m)", HAV_ABS_MAX_M };
+    Worst hav_rel = { "haversine >= 400 km (rel)", HAV_REL_MAX };
+    Worst hav_brg = { "haversine bearing (deg)", HAV_BEARING_MAX_DEG };
+
+    void distance(const Pair& p, double ref, double d) {
+        double err = fabs(d - ref);
+        if (shortRange(p)) eqr_rel.add(ref > 0 ? err / ref : 0, p, ref);
+        else if (ref < HAV_NEAR_M) hav_abs.add(err, p, ref);
+        else hav_rel.add(err / ref, p, ref);
+    }
+    void bearing(const Pair& p, double ref, double b) {
+        bool pole = abs(p.lat1) == 90000000 || abs(p.lat2) == 90000000;
+        if (ref < BEARING_MIN_M || ref > M_PI * R - BEARING_ANTIPODE_M || pole) return;
+        double e = angleDiff(b, refBearing(p.lat1, p.lon1, p.lat2, p.lon2));
+        (shortRange(p) ? eqr_brg : hav_brg).add(e, p, ref);
+    }
+    int report() const {
+        int failures = 0;
+        for (const Worst* w : { &eqr_rel, &eqr_brg, &hav_abs, &hav_rel, &hav_brg }) failures += !w->report();
+        return failures;
+    }
+};
+
+int main() {
+    Classes plain, origin;
+    printf("== %d pairs: float kernels vs double\n", PAIRS);
+    for (uint32_t i = 0; i < PAIRS; i++) {
+        Pair p = pairFor(i);
+        double ref = refDistance(p.lat1, p.lon1, p.lat2, p.lon2);
+        plain.distance(p, ref, geoDistanceE6(p.lat1, p.lon1, p.lat2, p.lon2));
+        plain.bearing(p, ref, geoBearingE6(p.lat1, p.lon1, p.lat2, p.lon2));
+        // The cached origin takes the other code path for the same maths
+        if (i % 16 == 0) {
+            geoSetOrigin(p.lat1 / 1e6, p.lon1 / 1e6);
+            origin.distance(p, ref, geoFromOriginDistanceE6(p.lat2, p.lon2));
+            origin.bearing(p, ref, geoFromOriginBearing(p.lat2 / 1e6, p.lon2 / 1e6));
+        }
+    }
+    printf("geoDistanceE6 / geoBearingE6\n");
+    int failures = plain.report();
+    printf("geoFromOriginDistanceE6 / geoFromOriginBearing\n");
+    failures += origin.report();
+
+    char bench[160];
+    geoBenchmark(bench, sizeof(bench));
+    printf("%s\n", bench);
+    if (failures) printf("%d bounds FAILED\n", failures);
+    return failures ? 1 : 0;
+}
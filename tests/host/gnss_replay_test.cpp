@@ -0,0 +1,184 @@
+// gnss_replay_test.cpp — NMEA logs through gnssFeed(), checked against TinyGPS++ and timed
+//
+// nmea/ holds two logs laid out as the L76K sends them (sentence set and order, talker IDs, field
+// widths, empty fields before a fix):
+//   l76k_walk_1hz.nmea     factory output (GGA GLL GSA GSV RMC VTG ZDA TXT) from a cold start —
+//                          no time, then time without a fix, then a walk in Amsterdam
+//   l76k_drive_5hz.nmea    RMC + GGA only at 5 Hz as after $PCAS03 / $PCAS02, south and west of
+//                          Greenwich, with flipped bits and sentences cut short
+//
+// Every byte goes to gnssFeed() and TinyGPSPlus::encode() alike. At each RMC / GGA TinyGPS++
+// accepts, the fields gnss.cpp marked updated must be the ones TinyGPS++ updated, with the same
+// values; rejected sentences must be rejected by both. Then each log is replayed REPLAY_ROUNDS
+// times through both for the host CPU time per fix.
+//
+//   gnss_replay_test
+
+#include "gnss.h"
+#include "utilities.h"
+#include "settings.h"
+#include "TinyGPS++.h"
+#include <string>
+
+#define NMEA_DIR        "nmea/"
+#define REPLAY_ROUNDS   200
+#define NONE            0xFFFFFFFFu
+
+// Firmware globals gnss.cpp and epoch_clock.cpp use
+Uart SerialGPS;
+PCF8563_Class rtc;
+
+// ── Harness ──
+static int s_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                  \
+            s_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+static void begin(const char* name) { printf("== %s\n", name); }
+
+static std::string load(const char* name) {
+    std::string path = std::string(NMEA_DIR) + name, s;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        printf("  cannot open %s\n", path.c_str());
+        return s;
+    }
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) s.append(buf, n);
+    fclose(f);
+    return s;
+}
+
+static unsigned long statField(const char* stats, const char* key) {
+    const char* p = strstr(stats, key);
+    return p ? strtoul(p + strlen(key), nullptr, 10) : 0;
+}
+
+struct Counts {
+    unsigned long rmc, gga, bad_cs;
+};
+
+static Counts gnssCounts() {
+    char st[240];
+    gnssFormatStats(st, sizeof(st));
+    return { statField(st, "rmc="), statField(st, "gga="), statField(st, "bad_cs=") };
+}
+
+// ── Field by field against TinyGPS++ ──
+struct Diff {
+    unsigned long sentences, compared, mismatches;
+    unsigned line;
+    uint32_t time, date;        // TinyGPS++'s last; NONE before the first real one
+
+    void check(bool same, const char* field) {
+        compared++;
+        if (same) return;
+        if (mismatches++ < 5) printf("  line %u: %s differs\n", line, field);
+    }
+};
+
+// One sentence both parsers accepted; `ours` is gnss.cpp's updated mask
+static void compare(Diff& d, TinyGPSPlus& tiny, uint16_t ours) {
+    const GnssFix& f = gnssFix();
+    bool t_time = tiny.time.isUpdated(), t_date = tiny.date.isUpdated(), t_loc = tiny.location.isUpdated();
+    bool t_alt = tiny.altitude.isUpdated(), t_speed = tiny.speed.isUpdated(), t_course = tiny.course.isUpdated();
+    bool t_sats = tiny.satellites.isUpdated(), t_hdop = tiny.hdop.isUpdated();
+    uint32_t time = tiny.time.value(), date = tiny.date.value();
+    double lat = tiny.location.lat(), lon = tiny.location.lng();
+    double alt = tiny.altitude.meters(), mps = tiny.speed.mps(), course = tiny.course.deg();
+    uint32_t sats = tiny.satellites.value(), hdop = tiny.hdop.value();
+
+    // For an empty time or date field TinyGPS++ commits its last value again (uninitialised before
+    // the first); gnss.cpp leaves it out
+    d.check(ours & GNSS_F_TIME ? t_time && f.time == time : d.time == NONE || time == d.time, "time");
+    d.check(ours & GNSS_F_DATE ? t_date && f.date == date : d.date == NONE || date == d.date, "date");
+    if (ours & GNSS_F_TIME) d.time = time;
+    if (ours & GNSS_F_DATE) d.date = date;
+    d.check(!(ours & GNSS_F_LOC) == !t_loc, "location updated");
+    if (ours & GNSS_F_LOC) {
+        d.check(fabs(f.lat_e7 * 1e-7 - lat) < 1.5e-7 && fabs(f.lon_e7 * 1e-7 - lon) < 1.5e-7, "location");
+    }
+    d.check(!(ours & GNSS_F_ALT) == !t_alt && (!t_alt || fabs(f.alt_m - alt) < 0.006), "altitude");
+    d.check(!(ours & GNSS_F_SPEED) == !t_speed && (!t_speed || fabs(f.speed_mps - mps) < 0.006), "speed");
+    d.check(!(ours & GNSS_F_COURSE) == !t_course && (!t_course || fabs(f.course_deg - course) < 0.006), "course");
+    d.check(!(ours & GNSS_F_SATS) == !t_sats && (!t_sats || f.sats == sats), "satellites");
+    d.check(!(ours & GNSS_F_HDOP) == !t_hdop && (!t_hdop || f.hdop_x100 == hdop), "HDOP");
+}
+
+static void testAgainstTiny(const char* name, const std::string& log) {
+    begin(name);
+    TinyGPSPlus tiny;
+    Diff d = { 0, 0, 0, 1, NONE, NONE };
+    Counts before = gnssCounts();
+    unsigned long tiny_rejected = 0;
+    char addr[6] = "";
+    uint8_t addr_len = 0;
+    bool rejected = false;
+    for (char c : log) {
+        uint8_t b = (uint8_t)c;
+        gnssFeed(&b, 1, 0);
+        if (c == '$') addr_len = 0, rejected = false;
+        else if (addr_len < 5) addr[addr_len++] = c, addr[addr_len] = 0;
+        if (c == '\n') d.line++;
+        // A bit flipped into a '*' can fail TinyGPS++'s checksum twice in one sentence
+        uint32_t failed = tiny.failedChecksum();
+        bool done = tiny.encode(c);
+        if (tiny.failedChecksum() != failed && !rejected) tiny_rejected++, rejected = true;
+        if (!done) continue;
+        bool ours = strcmp(addr + 2, "RMC") == 0 || strcmp(addr + 2, "GGA") == 0;
+        uint16_t updated = gnssFix().updated;
+        gnssClear(0xFFFF);
+        if (!ours) continue;
+        d.sentences++;
+        compare(d, tiny, updated);
+    }
+    Counts after = gnssCounts();
+    unsigned long committed = after.rmc + after.gga - before.rmc - before.gga;
+    printf("  %zu bytes, %lu RMC/GGA accepted by TinyGPS++, %lu by gnss.cpp, %lu rejected (checksum)\n",
+           log.size(), d.sentences, committed, after.bad_cs - before.bad_cs);
+    printf("  %lu field comparisons, %lu differ\n", d.compared, d.mismatches);
+    CHECK(d.sentences > 0);
+    CHECK(committed == d.sentences);
+    CHECK(after.bad_cs - before.bad_cs == tiny_rejected);
+    CHECK(d.mismatches == 0);
+}
+
+// ── Host CPU time per fix ──
+static void bench(const char* name, const std::string& log) {
+    Counts before = gnssCounts();
+    uint32_t t0 = micros();
+    for (int r = 0; r < REPLAY_ROUNDS; r++) gnssFeed((const uint8_t*)log.data(), log.size(), 0);
+    uint32_t ours_us = micros() - t0;
+    unsigned long fixes = (gnssCounts().rmc - before.rmc);
+
+    TinyGPSPlus tiny;
+    t0 = micros();
+    for (int r = 0; r < REPLAY_ROUNDS; r++) {
+        for (char c : log) tiny.encode(c);
+    }
+    uint32_t tiny_us = micros() - t0;
+    uint64_t bytes = (uint64_t)log.size() * REPLAY_ROUNDS;
+    printf("  %-22s %7lu fixes  gnss.cpp %.3f us/fix %.2f ns/byte   TinyGPS++ %.3f us/fix %.2f ns/byte\n", name, fixes,
+           (double)ours_us / fixes, ours_us * 1000.0 / bytes, (double)tiny_us / fixes, tiny_us * 1000.0 / bytes);
+}
+
+int main() {
+    std::string walk = load("l76k_walk_1hz.nmea");
+    std::string drive = load("l76k_drive_5hz.nmea");
+    CHECK(!walk.empty() && !drive.empty());
+
+    testAgainstTiny("1 Hz factory output, cold start, walk", walk);
+    testAgainstTiny("5 Hz RMC + GGA, S/W, line errors", drive);
+
+    begin("host CPU time per fix (one RMC per fix)");
+    bench("l76k_walk_1hz", walk);
+    bench("l76k_drive_5hz", drive);
+    if (s_failures) printf("%d checks FAILED\n", s_failures);
+    return s_failures ? 1 : 0;
+}
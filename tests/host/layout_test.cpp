@@ -0,0 +1,269 @@
+// layout_test.cpp — Every mode layout rendered from scripted LayoutState fixtures, checked against
+// golden frame hashes
+//
+// Per case: a full render from layoutBenchFixture(0) plus the case's edits, an unchanged re-render
+// (must not start a frame), then an update from layoutBenchFixture(1). The retained-widget update
+// must leave the same frame as a full render of the tick-1 state. Frames are FNV-1a hashed and
+// compared with golden/layouts.txt; PBMs of both land in build/layouts/.
+//
+//   layout_test [--update]     --update rewrites the golden file from this run
+
+#include "display_layout.h"
+#include "disp_dirty.h"
+#include "disp_budget.h"
+#include "epd_host.h"
+#include <map>
+#include <string>
+#include <sys/stat.h>
+
+#define GOLDEN      "golden/layouts.txt"
+#define PBM_DIR     "build/layouts"
+
+typedef void (*EditFn)(LayoutState& s);
+
+struct LayoutCase {
+    const char* name;
+    void (*draw)();
+    EditFn edit;
+};
+
+static void none(LayoutState&) {}
+
+// ── Fixtures ──
+static void modePtt(LayoutState& s) { s.mode = "PTT"; }
+static void modeSettings(LayoutState& s) { s.in_settings = true; }
+
+static void beaconNoPeer(LayoutState& s) {
+    s.beacon_best_dist = -1;
+    s.beacon_best_name[0] = '\0';
+    s.peer_count = 0;
+    memset(s.peers, 0, sizeof(s.peers));
+}
+
+static void beaconFull(LayoutState& s) {
+    static const char* const names[] = { "A-very-long-callsign", "ON4ABC", "DL1QRS", "G0XYZ",
+                                         "F5AAA", "EA3BCD", "OK1DEF", "SP2GHI" };
+    s.peer_count = 23;
+    for (uint8_t i = 0; i < LAYOUT_PEER_ROWS; i++) {
+        snprintf(s.peers[i].name, sizeof(s.peers[i].name), "%s", names[i]);
+        s.peers[i].dist_m = 120.0f + i * i * 900.0f;
+        s.peers[i].batt = i * 12;
+    }
+    snprintf(s.beacon_best_name, sizeof(s.beacon_best_name), "%s", names[0]);
+    s.beacon_best_dist = 120;
+}
+
+static void rangeNoFix(LayoutState& s) {
+    s.gps_fix = false;
+    s.gps_hdop = 3.4f;
+    s.range_sender = false;
+}
+
+static void pttTx(LayoutState& s) { s.ptt_tx_active = true; }
+static void pttRx(LayoutState& s) {
+    s.ptt_tx_active = false;
+    s.ptt_rx_active = true;
+}
+
+static void txtEmpty(LayoutState& s) {
+    s.txt_unread = 0;
+    s.inbox_count = 0;
+    s.txt_preview = "";
+    memset(s.inbox_rows, 0, sizeof(s.inbox_rows));
+    s.peer_alive = false;
+}
+
+static void inboxPage2(LayoutState& s) {
+    static const char* const rows[] = { "Row 16: second page", "Row 17", "Row 18: the last one" };
+    s.txt_unread = 19;
+    s.inbox_count = 19;
+    s.txt_page = 1;
+    memset(s.inbox_rows, 0, sizeof(s.inbox_rows));
+    memcpy(s.inbox_rows, rows, sizeof(rows));
+}
+
+static void pongIdle(LayoutState& s) {
+    s.pong_state = 0;
+    s.pong_rtt_ms = 0;
+}
+
+static void scanIdle(LayoutState& s) {
+    s.scan_progress_pct = 0;
+    snprintf(s.scan_current_freq, sizeof(s.scan_current_freq), "---");
+    s.scan_channel_count = 0;
+}
+
+static void rawEmpty(LayoutState& s) { s.raw_hex_line1[0] = '\0'; }
+
+static void wpStill(LayoutState& s) {
+    s.wp_broadcasting = false;
+    s.wp_label[0] = '\0';
+}
+
+static void settingsAt(LayoutState& s, uint8_t idx) {
+    s.in_settings = true;
+    s.setting_idx = idx;
+    s.panel_refresh = idx == PANEL_REFRESH;
+}
+#define SETTINGS_CASE(idx) [](LayoutState& s) { settingsAt(s, idx); }
+
+static const LayoutCase s_cases[] = {
+    { "default", drawDefaultLayout, none },
+    { "default_ptt", drawDefaultLayout, modePtt },
+    { "default_settings", drawDefaultLayout, modeSettings },
+    { "beacon", drawBeaconLayout, none },
+    { "beacon_nopeer", drawBeaconLayout, beaconNoPeer },
+    { "beacon_full", drawBeaconLayout, beaconFull },
+    { "range", drawRangeLayout, none },
+    { "range_nofix", drawRangeLayout, rangeNoFix },
+    { "ptt", drawPttLayout, none },
+    { "ptt_tx", drawPttLayout, pttTx },
+    { "ptt_rx", drawPttLayout, pttRx },
+    { "txt", drawTxtSingleLayout, none },
+    { "txt_empty", drawTxtSingleLayout, txtEmpty },
+    { "inbox", drawTxtInboxLayout, none },
+    { "inbox_page2", drawTxtInboxLayout, inboxPage2 },
+    { "tst", drawTstLayout, none },
+    { "pong", drawPongLayout, none },
+    { "pong_idle", drawPongLayout, pongIdle },
+    { "scan", drawScanLayout, none },
+    { "scan_idle", drawScanLayout, scanIdle },
+    { "raw", drawRawLayout, none },
+    { "raw_empty", drawRawLayout, rawEmpty },
+    { "wp", drawWpLayout, none },
+    { "wp_still", drawWpLayout, wpStill },
+    { "settings_sf", drawSettingsLayout, SETTINGS_CASE(SPREADING_FACTOR) },
+    { "settings_channel", drawSettingsLayout, SETTINGS_CASE(CHANNEL) },
+    { "settings_bitrate", drawSettingsLayout, SETTINGS_CASE(BITRATE) },
+    { "settings_backlight", drawSettingsLayout, SETTINGS_CASE(BACKLIGHT) },
+    { "settings_volume", drawSettingsLayout, SETTINGS_CASE(VOLUME) },
+    { "settings_hours", drawSettingsLayout, SETTINGS_CASE(HOURS) },
+    { "settings_minutes", drawSettingsLayout, SETTINGS_CASE(MINUTES) },
+    { "settings_seconds", drawSettingsLayout, SETTINGS_CASE(SECONDS) },
+    { "settings_bandwidth", drawSettingsLayout, SETTINGS_CASE(BANDWIDTH) },
+    { "settings_cr", drawSettingsLayout, SETTINGS_CASE(CODING_RATE) },
+    { "settings_hopping", drawSettingsLayout, SETTINGS_CASE(FREQUENCY_HOPPING) },
+    { "settings_refresh", drawSettingsLayout, SETTINGS_CASE(PANEL_REFRESH) },
+};
+
+// ── Harness ──
+static void writePbm(const char* name) {
+    char path[128];
+    snprintf(path, sizeof(path), PBM_DIR "/%s.pbm", name);
+    FILE* f = fopen(path, "wb");
+    if (!f) return;
+    fprintf(f, "P4\n%d %d\n", DISP_MIRROR_W, DISP_MIRROR_H);
+    fwrite(dispMirrorFrame(), 1, DISP_MIRROR_W / 8 * DISP_MIRROR_H, f);     // P4: 1 = black, as the frame
+    fclose(f);
+}
+
+// One layout call the way the main loop makes it; returns its time. A frame that started goes
+// straight through the host panel.
+static uint32_t render(void (*draw)()) {
+    hostAdvanceClock(DISP_MIN_INTERVAL_MS);
+    dispBudgetActivity();
+    uint32_t t0 = micros();
+    draw();
+    uint32_t us = micros() - t0;
+    dispFramePump();
+    return us;
+}
+
+static void fixture(const LayoutCase& c, uint8_t tick) {
+    layoutBenchFixture(tick);
+    c.edit(layout_state);
+}
+
+struct Golden {
+    uint32_t full, upd;
+};
+
+static std::map<std::string, Golden> loadGolden() {
+    std::map<std::string, Golden> g;
+    FILE* f = fopen(GOLDEN, "r");
+    if (!f) return g;
+    char line[160], name[64];
+    unsigned long a, b;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%63s %lx %lx", name, &a, &b) == 3) g[name] = { (uint32_t)a, (uint32_t)b };
+    }
+    fclose(f);
+    return g;
+}
+
+int main(int argc, char** argv) {
+    bool update = argc > 1 && strcmp(argv[1], "--update") == 0;
+    mkdir("build", 0755);
+    mkdir(PBM_DIR, 0755);
+    hostSetClock(1000);
+
+    display = new EpdTracked(GxEPD2_150_BN(0, 0, 0, 0));
+    display->setRotation(3);
+    layoutUseFixture(true);
+
+    std::map<std::string, Golden> golden = loadGolden();
+    std::map<std::string, Golden> seen;
+    int failures = 0;
+
+    printf("%-20s %8s %8s %8s %12s  %s\n", "case", "full_us", "skip_us", "upd_us", "changed_px", "result");
+    for (const LayoutCase& c : s_cases) {
+        const char* why = nullptr;
+
+        fixture(c, 0);
+        forceFullRefresh();
+        uint32_t full_us = render(c.draw);
+        uint32_t full_sig = layoutFrameSig();
+        writePbm(c.name);
+
+        uint32_t frames = hostEpdLastFrame().count;
+        uint32_t skip_us = render(c.draw);
+        if (hostEpdLastFrame().count != frames) why = "unchanged re-render pushed a frame";
+
+        fixture(c, 1);
+        uint32_t upd_us = render(c.draw);
+        bool pushed = hostEpdLastFrame().count != frames;
+        uint32_t changed_px = pushed ? (uint32_t)hostEpdLastFrame().w * hostEpdLastFrame().h : 0;
+        uint32_t upd_sig = layoutFrameSig();
+        char upd_name[80];
+        snprintf(upd_name, sizeof(upd_name), "%s_upd", c.name);
+        writePbm(upd_name);
+
+        // Retained update vs a fresh render of the same state
+        layoutInvalidate();
+        render(c.draw);
+        if (!why && layoutFrameSig() != upd_sig) why = "retained update differs from a full render";
+
+        seen[c.name] = { full_sig, upd_sig };
+        auto g = golden.find(c.name);
+        if (!why && !update) {
+            if (g == golden.end()) why = "no golden hash";
+            else if (g->second.full != full_sig) why = "full frame differs from golden";
+            else if (g->second.upd != upd_sig) why = "updated frame differs from golden";
+        }
+        if (why) failures++;
+        printf("%-20s %8lu %8lu %8lu %12lu  %s\n", c.name, (unsigned long)full_us, (unsigned long)skip_us,
+               (unsigned long)upd_us, (unsigned long)changed_px, why ? why : "ok");
+    }
+
+    char bench[640];
+    layoutBenchmark(bench, sizeof(bench));
+    printf("%s\n", bench);
+
+    if (update) {
+        FILE* f = fopen(GOLDEN, "w");
+        if (!f) {
+            perror(GOLDEN);
+            return 1;
+        }
+        fprintf(f, "# layout_test golden frames: case, FNV-1a of the 200x200 frame at tick 0, after the tick-1 update\n");
+        fprintf(f, "# Regenerate with: make -C tests/host golden — and look at build/layouts/*.pbm first\n");
+        for (const LayoutCase& c : s_cases) {
+            fprintf(f, "%-20s %08lX %08lX\n", c.name, (unsigned long)seen[c.name].full, (unsigned long)seen[c.name].upd);
+        }
+        fclose(f);
+        printf("wrote " GOLDEN "\n");
+    }
+    if (failures) printf("%d of %zu cases FAILED\n", failures, sizeof(s_cases) / sizeof(s_cases[0]));
+    return failures ? 1 : 0;
+}
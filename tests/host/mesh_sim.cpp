@@ -0,0 +1,361 @@
+// mesh_sim.cpp — mesh_relay.cpp on many simulated nodes: delivery, airtime and latency per topology
+//
+// Every node runs its own copy of the module (the Makefile builds mesh_relay.cpp once per node with
+// the entry points renamed, NODE_LIST below), fed the way lora.cpp feeds it: meshHeaderField() when
+// a message goes out, meshOnReceive() for each frame heard, meshTick() from the loop, and
+// sendRawPacket() starting a transmission unless the node's radio is already sending.
+//
+// Radio: log-distance path loss to an SNR, a few dB of fading per frame, nothing below
+// RX_MIN_SNR_DB. Half duplex — a node sending misses what arrives meanwhile — and collisions at the
+// receiver unless the wanted frame is CAPTURE_DB above the other. No listen-before-talk, as on the
+// radio. Every frame takes TOA_MS.
+//
+// For a line, a grid and a random field, MSGS messages from random origins go out with the mesh
+// off (single hop) and at a few TTLs:
+//   delivered     share of the other nodes that got the message
+//   tx/msg        transmissions per message — the airtime amplification of the flood
+//   latency       origin transmit start to delivery, mean and 95th percentile
+// No node may deliver a message twice. Then the seen cache on its own: two frames whose (origin,
+// seq) hashed alike under the old 32-bit key must both be delivered.
+//
+//   mesh_sim
+
+#include "mesh_relay.h"
+#include "settings.h"
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define TOA_MS          250
+#define RX_MIN_SNR_DB   (-15.0)     // Demodulation floor at the spreading factor in use
+#define SNR_AT_1KM_DB   (-15.0)     // Nominal range 1 km ...
+#define PATH_LOSS_EXP   3.0         // ... falling 30 dB per decade
+#define FADE_DB         3.0         // Uniform ± per frame and receiver
+#define CAPTURE_DB      6.0
+#define TICK_MS         10          // meshTick() period in the loop
+#define MSGS            200
+#define MSG_GAP_MIN_MS  5000
+#define MSG_GAP_MAX_MS  25000
+#define DRAIN_MS        30000
+
+// One mesh_relay.cpp object per entry, as the Makefile's MESH_NODES
+#define NODE_LIST(X)                                                                                  \
+    X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16) X(17)   \
+    X(18) X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31) X(32) X(33)    \
+    X(34) X(35) X(36) X(37) X(38) X(39)
+
+#define DECLARE(i)                                                                                    \
+    size_t meshHeaderField_##i(const uint8_t*, uint16_t, unsigned int, char*, size_t);                \
+    MeshRx meshOnReceive_##i(const uint8_t*, uint16_t, float, uint32_t, uint32_t);                    \
+    void meshTick_##i(uint32_t);                                                                      \
+    int meshFormatStats_##i(char*, size_t);
+NODE_LIST(DECLARE)
+
+struct Module {
+    size_t (*headerField)(const uint8_t*, uint16_t, unsigned int, char*, size_t);
+    MeshRx (*onReceive)(const uint8_t*, uint16_t, float, uint32_t, uint32_t);
+    void (*tick)(uint32_t);
+    int (*formatStats)(char*, size_t);
+};
+
+#define ENTRY(i) { meshHeaderField_##i, meshOnReceive_##i, meshTick_##i, meshFormatStats_##i },
+static const Module s_modules[] = { NODE_LIST(ENTRY) };
+#define MAX_NODES ((int)(sizeof(s_modules) / sizeof(s_modules[0])))
+
+// ── Firmware globals mesh_relay.cpp uses ──
+DeviceSettings deviceSettings;
+
+struct Tx {
+    int node;
+    uint32_t start, end;
+    std::string frame;
+};
+
+struct Node {
+    double x, y;
+    char id[9];
+    unsigned int counter;       // ~PC
+    uint32_t busy_until;        // Transmitting until
+};
+
+static std::vector<Node> s_nodes;
+static std::vector<Tx> s_air;               // Transmissions still on the air or just ended
+static int s_cur = 0;                       // Node whose module is running
+static uint32_t s_now = 0;
+static uint32_t s_tx_count = 0;
+static uint32_t s_next_id = 0x5A170000u;    // Fresh origins per topology: the modules remember seqs
+
+const char* bleGetDeviceIdShort() {
+    return s_nodes[s_cur].id;
+}
+
+bool sendRawPacket(const uint8_t* buf, uint16_t len) {
+    Node& n = s_nodes[s_cur];
+    if (s_now < n.busy_until) return false;
+    n.busy_until = s_now + TOA_MS;
+    s_air.push_back({ s_cur, s_now, s_now + TOA_MS, std::string((const char*)buf, len) });
+    s_tx_count++;
+    return true;
+}
+
+// ── Harness ──
+static int s_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                  \
+            s_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+static void begin(const char* name) { printf("== %s\n", name); }
+
+static uint32_t s_rng = 0x9E3779B9u;
+
+static uint32_t rnd(uint32_t max) {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng % max;
+}
+
+static double uniform(double lo, double hi) {
+    return lo + (hi - lo) * rnd(1000001) / 1000000.0;
+}
+
+// ── Radio ──
+static double snrAt(int from, int to) {
+    double d = hypot(s_nodes[from].x - s_nodes[to].x, s_nodes[from].y - s_nodes[to].y);
+    return SNR_AT_1KM_DB - 10 * PATH_LOSS_EXP * log10(std::max(d, 1.0) / 1000.0);
+}
+
+static bool overlaps(const Tx& a, const Tx& b) {
+    return a.start < b.end && b.start < a.end;
+}
+
+// Who hears tx, with the SNR they hear it at
+static std::vector<std::pair<int, float>> receivers(const Tx& tx) {
+    std::vector<std::pair<int, float>> out;
+    for (int r = 0; r < (int)s_nodes.size(); r++) {
+        if (r == tx.node) continue;
+        double snr = snrAt(tx.node, r) + uniform(-FADE_DB, FADE_DB);
+        if (snr < RX_MIN_SNR_DB) continue;
+        bool lost = false;
+        for (const Tx& o : s_air) {
+            if (&o == &tx || !overlaps(o, tx)) continue;
+            if (o.node == r) lost = true;                                   // Sending itself
+            else if (snrAt(o.node, r) > snr - CAPTURE_DB) lost = true;      // Collision
+        }
+        if (!lost) out.push_back({ r, (float)snr });
+    }
+    return out;
+}
+
+// ── Topologies ──
+static void placeNode(double x, double y) {
+    Node n = {};
+    n.x = x;
+    n.y = y;
+    snprintf(n.id, sizeof(n.id), "%08X", (unsigned)s_next_id++);
+    s_nodes.push_back(n);
+}
+
+static void line(int n, double spacing) {
+    for (int i = 0; i < n; i++) placeNode(i * spacing, 0);
+}
+
+static void grid(int side, double spacing) {
+    for (int i = 0; i < side * side; i++) placeNode(i % side * spacing, i / side * spacing);
+}
+
+static void field(int n, double size) {
+    for (int i = 0; i < n; i++) placeNode(uniform(0, size), uniform(0, size));
+}
+
+// ── One run ──
+struct Result {
+    double delivered;           // Share of the other nodes
+    double tx_per_msg;
+    double latency_mean, latency_p95;
+    uint32_t dups;              // Deliveries of a message a node already had
+};
+
+static Result run(bool mesh, int ttl) {
+    deviceSettings.mesh_enabled = mesh;
+    deviceSettings.mesh_ttl = ttl;
+    int n = (int)s_nodes.size();
+    std::vector<std::vector<uint32_t>> got(MSGS, std::vector<uint32_t>(n, 0));   // Delivery time + 1
+    std::vector<uint32_t> sent_at(MSGS, 0);
+    std::vector<std::pair<int, std::string>> waiting;   // Origin and frame, radio busy
+    uint32_t tx_before = s_tx_count, dups = 0;
+    uint32_t next_msg = s_now + 1000, end = UINT32_MAX;
+    int msg = 0;
+
+    for (; s_now < end; s_now++) {
+        // A message from a random node: the frame sendPacket() builds, ~MH from that node's module
+        if (msg < MSGS && s_now >= next_msg) {
+            s_cur = rnd(n);
+            Node& o = s_nodes[s_cur];
+            char body[24], mh[MESH_FIELD_MAX];
+            snprintf(body, sizeof(body), "TXT%04d", msg);
+            o.counter++;
+            s_modules[s_cur].headerField((const uint8_t*)body, strlen(body), o.counter, mh, sizeof(mh));
+            std::string frame = std::string("TX") + mh + "~~" + body;
+            waiting.push_back({ s_cur, frame });
+            sent_at[msg] = s_now;
+            msg++;
+            next_msg = s_now + MSG_GAP_MIN_MS + rnd(MSG_GAP_MAX_MS - MSG_GAP_MIN_MS);
+            if (msg == MSGS) end = s_now + DRAIN_MS;
+        }
+        for (size_t i = 0; i < waiting.size();) {
+            s_cur = waiting[i].first;
+            if (sendRawPacket((const uint8_t*)waiting[i].second.data(), waiting[i].second.size())) {
+                waiting.erase(waiting.begin() + i);
+            } else {
+                i++;
+            }
+        }
+
+        // Frames ending now reach whoever heard them
+        for (size_t i = 0; i < s_air.size(); i++) {
+            if (s_air[i].end != s_now) continue;
+            Tx tx = s_air[i];
+            int m = atoi(tx.frame.c_str() + tx.frame.find("~~") + 5);
+            for (auto& rx : receivers(s_air[i])) {
+                s_cur = rx.first;
+                MeshRx r = s_modules[s_cur].onReceive((const uint8_t*)tx.frame.data(), tx.frame.size(), rx.second,
+                                                      TOA_MS, s_now);
+                if (r == MESH_RX_DROP) continue;     // A copy, or our own message coming back
+                if (got[m][s_cur]) dups++;
+                else got[m][s_cur] = s_now - sent_at[m] + 1;
+            }
+        }
+        s_air.erase(std::remove_if(s_air.begin(), s_air.end(),
+                                   [](const Tx& t) { return t.end + 2 * TOA_MS < s_now; }),
+                    s_air.end());
+
+        // The loop on every node, staggered
+        for (int i = 0; i < n; i++) {
+            if ((s_now + i) % TICK_MS) continue;
+            s_cur = i;
+            s_modules[i].tick(s_now);
+        }
+    }
+
+    Result res = {};
+    std::vector<uint32_t> lat;
+    uint64_t delivered = 0;
+    for (int m = 0; m < MSGS; m++) {
+        for (int r = 0; r < n; r++) {
+            if (!got[m][r]) continue;
+            delivered++;
+            lat.push_back(got[m][r] - 1);
+        }
+    }
+    std::sort(lat.begin(), lat.end());
+    res.delivered = (double)delivered / ((double)MSGS * (n - 1));
+    res.tx_per_msg = (double)(s_tx_count - tx_before) / MSGS;
+    double sum = 0;
+    for (uint32_t l : lat) sum += l;
+    res.latency_mean = lat.empty() ? 0 : sum / lat.size();
+    res.latency_p95 = lat.empty() ? 0 : lat[lat.size() * 95 / 100];
+    res.dups = dups;
+    return res;
+}
+
+static double neighbours() {
+    int links = 0;
+    for (int a = 0; a < (int)s_nodes.size(); a++) {
+        for (int b = 0; b < (int)s_nodes.size(); b++) links += a != b && snrAt(a, b) >= RX_MIN_SNR_DB;
+    }
+    return (double)links / s_nodes.size();
+}
+
+static void topology(const char* name) {
+    begin(name);
+    printf("  %d nodes, %.1f neighbours each within range\n", (int)s_nodes.size(), neighbours());
+    printf("  %-11s %9s %7s %12s %8s\n", "", "delivered", "tx/msg", "latency ms", "p95 ms");
+    static const int ttls[] = { 1, 3, 7 };
+    Result single = run(false, 1);
+    printf("  %-11s %8.1f%% %7.2f %12.0f %8.0f\n", "single hop", single.delivered * 100, single.tx_per_msg,
+           single.latency_mean, single.latency_p95);
+    CHECK(single.dups == 0);
+    CHECK(single.tx_per_msg == 1.0);
+    Result ttl3 = {};
+    for (int ttl : ttls) {
+        Result r = run(true, ttl);
+        char label[16];
+        snprintf(label, sizeof(label), "TTL %d", ttl);
+        printf("  %-11s %8.1f%% %7.2f %12.0f %8.0f\n", label, r.delivered * 100, r.tx_per_msg, r.latency_mean,
+               r.latency_p95);
+        CHECK(r.dups == 0);
+        CHECK(r.tx_per_msg <= 1 + ttl * (double)(s_nodes.size() - 1));
+        if (ttl == 3) ttl3 = r;
+    }
+    CHECK(ttl3.delivered > single.delivered);
+}
+
+// ── Seen cache ──
+// The key mesh_relay.cpp used to keep: FNV-1a over the origin digits and the sequence
+static uint32_t oldKey(const char* id, uint16_t seq) {
+    uint32_t k = 2166136261u;
+    for (int i = 0; i < 8; i++) k = (k ^ (uint8_t)id[i]) * 16777619u;
+    k = (k ^ (seq & 0xFF)) * 16777619u;
+    return (k ^ (seq >> 8)) * 16777619u;
+}
+
+static void testSeenCache() {
+    begin("seen cache: frames whose old 32-bit keys collide");
+    std::unordered_map<uint32_t, uint64_t> keys;
+    char a[9] = "", b[9] = "";
+    uint16_t sa = 0, sb = 0;
+    for (uint32_t i = 0; i < 4000000 && !a[0]; i++) {
+        uint32_t id = 0x10000000u + rnd(0x0FFFFFFF);
+        uint16_t seq = rnd(4096);
+        char s[9];
+        snprintf(s, sizeof(s), "%08X", id);
+        uint32_t k = oldKey(s, seq);
+        auto it = keys.find(k);
+        if (it != keys.end() && it->second != ((uint64_t)id << 12 | seq)) {
+            snprintf(a, sizeof(a), "%08X", (unsigned)(it->second >> 12));
+            sa = it->second & 0xFFF;
+            memcpy(b, s, sizeof(b));
+            sb = seq;
+        }
+        keys[k] = (uint64_t)id << 12 | seq;
+    }
+    printf("  %s/%03X and %s/%03X, key %08lX\n", a, sa, b, sb, (unsigned long)oldKey(a, sa));
+    CHECK(a[0] && oldKey(a, sa) == oldKey(b, sb));
+
+    deviceSettings.mesh_enabled = false;
+    s_cur = 0;
+    char fa[64], fb[64];
+    int na = snprintf(fa, sizeof(fa), "TX~MH%s%03X30~~first", a, sa);
+    int nb = snprintf(fb, sizeof(fb), "TX~MH%s%03X30~~second", b, sb);
+    s_now += MESH_SEEN_MS;
+    CHECK(s_modules[0].onReceive((const uint8_t*)fa, na, 0, TOA_MS, s_now) == MESH_RX_DIRECT);
+    CHECK(s_modules[0].onReceive((const uint8_t*)fb, nb, 0, TOA_MS, s_now) == MESH_RX_DIRECT);
+    CHECK(s_modules[0].onReceive((const uint8_t*)fa, na, 0, TOA_MS, s_now) == MESH_RX_DROP);
+}
+
+int main() {
+    randomSeed(50);
+
+    line(12, 800);
+    topology("line of 12, 800 m apart");
+
+    s_nodes.clear();
+    grid(6, 700);
+    topology("6 x 6 grid, 700 m apart");
+
+    s_nodes.clear();
+    field(40, 4000);
+    topology("40 nodes at random in 4 x 4 km");
+
+    CHECK((int)s_nodes.size() <= MAX_NODES);
+    testSeenCache();
+    if (s_failures) printf("%d checks FAILED\n", s_failures);
+    return s_failures ? 1 : 0;
+}
@@ -0,0 +1,25 @@
+// Adafruit_SPIFlashBase.h — host mock: the raw sector API over an in-memory NOR chip (flash_host.cpp)
+
+#ifndef HOST_ADAFRUIT_SPIFLASHBASE_H
+#define HOST_ADAFRUIT_SPIFLASHBASE_H
+
+#include <Arduino.h>
+
+class Adafruit_FlashTransport {};
+
+class Adafruit_FlashTransport_QSPI : public Adafruit_FlashTransport {
+  public:
+    Adafruit_FlashTransport_QSPI(int8_t, int8_t, int8_t, int8_t, int8_t, int8_t) {}
+};
+
+class Adafruit_SPIFlashBase {
+  public:
+    Adafruit_SPIFlashBase(Adafruit_FlashTransport*) {}
+    bool begin();
+    uint32_t size();
+    uint32_t readBuffer(uint32_t address, uint8_t* buffer, uint32_t len);
+    uint32_t writeBuffer(uint32_t address, uint8_t const* buffer, uint32_t len);
+    bool eraseSector(uint32_t sectorNumber);
+};
+
+#endif
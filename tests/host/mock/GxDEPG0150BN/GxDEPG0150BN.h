@@ -0,0 +1,10 @@
+// GxDEPG0150BN.h — host mock: the legacy GxEPD panel class is only named
+
+#ifndef HOST_GXDEPG0150BN_H
+#define HOST_GXDEPG0150BN_H
+
+#include "../GxEPD2.h"
+
+class GxEPD_Class;
+
+#endif
@@ -0,0 +1,9 @@
+// GxEPD2.h — host mock: colour constants
+
+#ifndef HOST_GXEPD2_H
+#define HOST_GXEPD2_H
+
+#define GxEPD_BLACK     0x0000
+#define GxEPD_WHITE     0xFFFF
+
+#endif
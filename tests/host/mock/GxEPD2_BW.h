@@ -0,0 +1,67 @@
+// GxEPD2_BW.h — host mock: the GFX surface of GxEPD2_BW over an in-memory panel buffer
+//
+// Pixels land in a 1bpp buffer in controller orientation (1 = white), after the same rotation
+// GxEPD2 applies. Everything that would talk to the panel is a no-op; the firmware's own frame
+// mirror (disp_dirty) is what the host tests read.
+
+#ifndef HOST_GXEPD2_BW_H
+#define HOST_GXEPD2_BW_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Adafruit_GFX.h>
+#include "GxEPD2.h"
+#include "epd/GxEPD2_150_BN.h"
+
+template <typename GxEPD2_Type, const uint16_t page_height>
+class GxEPD2_BW : public Adafruit_GFX {
+  public:
+    GxEPD2_Type epd2;
+
+    GxEPD2_BW(GxEPD2_Type epd2_instance)
+        : Adafruit_GFX(GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance) {
+        fillScreen(GxEPD_WHITE);
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || x >= width() || y < 0 || y >= height()) return;
+        switch (getRotation()) {
+            case 1: { int16_t t = x; x = GxEPD2_Type::WIDTH - y - 1; y = t; break; }
+            case 2: x = GxEPD2_Type::WIDTH - x - 1; y = GxEPD2_Type::HEIGHT - y - 1; break;
+            case 3: { int16_t t = x; x = y; y = GxEPD2_Type::HEIGHT - t - 1; break; }
+        }
+        uint8_t& b = _buffer[y * (GxEPD2_Type::WIDTH / 8) + x / 8];
+        uint8_t mask = 0x80 >> (x & 7);
+        if (color == GxEPD_WHITE) b |= mask;
+        else b &= ~mask;
+    }
+
+    virtual void fillScreen(uint16_t color) override {
+        memset(_buffer, color == GxEPD_WHITE ? 0xFF : 0x00, sizeof(_buffer));
+    }
+
+    // Controller-orientation buffer, 1 = white
+    const uint8_t* panelBuffer() const { return _buffer; }
+
+    void init(uint32_t = 0) {}
+    void init(uint32_t, bool, uint16_t = 10, bool = false) {}
+    void init(uint32_t, bool, uint16_t, bool, SPIClass&, SPISettings) {}
+    void setFullWindow() {}
+    void setPartialWindow(uint16_t, uint16_t, uint16_t, uint16_t) {}
+    void firstPage() {}
+    bool nextPage() { return false; }
+    void display(bool = false) {}
+    void displayWindow(int16_t, int16_t, int16_t, int16_t) {}
+    void refresh(bool = false) {}
+    void refresh(int16_t, int16_t, int16_t, int16_t) {}
+    void clearScreen(uint8_t = 0xFF) { fillScreen(GxEPD_WHITE); }
+    void writeScreenBuffer(uint8_t = 0xFF) {}
+    void drawImage(const uint8_t*, int16_t, int16_t, int16_t, int16_t, bool = false, bool = false, bool = false) {}
+    void powerOff() {}
+    void hibernate() {}
+
+  private:
+    uint8_t _buffer[GxEPD2_Type::WIDTH / 8 * GxEPD2_Type::HEIGHT];
+};
+
+#endif
@@ -0,0 +1,8 @@
+// GxIO.h — host mock: the legacy GxEPD I/O class is only named
+
+#ifndef HOST_GXIO_H
+#define HOST_GXIO_H
+
+class GxIO_Class;
+
+#endif
@@ -0,0 +1,8 @@
+// GxIO_SPI.h — host mock
+
+#ifndef HOST_GXIO_SPI_H
+#define HOST_GXIO_SPI_H
+
+#include "../GxIO.h"
+
+#endif
@@ -0,0 +1,17 @@
+// GxEPD2_150_BN.h — host mock of the 1.54" SSD1681 driver: geometry only
+
+#ifndef HOST_GXEPD2_150_BN_H
+#define HOST_GXEPD2_150_BN_H
+
+#include <Arduino.h>
+
+class GxEPD2_150_BN {
+  public:
+    static const uint16_t WIDTH = 200;
+    static const uint16_t WIDTH_VISIBLE = WIDTH;
+    static const uint16_t HEIGHT = 200;
+
+    GxEPD2_150_BN(int16_t cs, int16_t dc, int16_t rst, int16_t busy) {}
+};
+
+#endif
@@ -0,0 +1,244 @@
+// msg_log_test.cpp — msg_log crash-safety replays and its flash-write cost, QSPI chip vs RAM disk
+//
+// Replays: one scripted workload (appends of mixed length, clears, several trips round a small
+// ring) is re-run once per flash operation with the power cut on that operation — before it, or
+// after 1/4, 1/2 or 3/4 of its bytes landed. After each cut the log is mounted fresh and must hold every acknowledged
+// message that had not aged out, byte for byte, nothing it never acknowledged, and still take
+// appends.
+//
+// Benchmark: MSGBENCH_MSGS messages through the full QSPI_MSG_SECTORS log on the host chip
+// (qspi_flash.cpp over flash_host.cpp) and on the RAM disk — host time, flash operations per
+// message, write amplification, wear spread and the cost of a mount.
+//
+//   msg_log_test
+
+#include "msg_log.h"
+#include "flash_host.h"
+#include <string>
+#include <vector>
+
+#define REPLAY_SECTORS  6
+#define REPLAY_CALLS    260
+#define MSGBENCH_MSGS   20000
+
+struct Call {
+    bool clear;
+    std::string payload;
+};
+
+static std::vector<Call> s_calls;
+static std::vector<std::string> s_payload_of;      // Message number -> payload
+static MsgSectorIndex s_index[QSPI_MSG_SECTORS];
+
+static void buildWorkload() {
+    randomSeed(37);
+    for (uint16_t i = 0; i < REPLAY_CALLS; i++) {
+        Call c;
+        c.clear = i % 97 == 96;
+        if (!c.clear) {
+            // Mostly short chat lines, a few that fill a good part of a sector, one past the limit
+            uint16_t len = i == 150 ? MSG_LOG_MAX_LEN + 40 : (i % 11 == 0 ? 300 + random(200) : 1 + random(90));
+            for (uint16_t k = 0; k < len; k++) c.payload += (char)('a' + (i * 7 + k) % 26);
+            s_payload_of.push_back(c.payload.substr(0, MSG_LOG_MAX_LEN));
+        }
+        s_calls.push_back(c);
+    }
+}
+
+static void initLog(MsgLog& log, const FlashOps& ops, uint32_t base, uint16_t sectors) {
+    memset(&log, 0, sizeof(log));
+    log.ops = &ops;
+    log.base = base;
+    log.sectors = sectors;
+    log.index = s_index;
+}
+
+static bool run(MsgLog& log, const Call& c) {
+    if (c.clear) {
+        msgLogClear(log);
+        return true;
+    }
+    return msgLogAppend(log, (const uint8_t*)"SRC1", 4, (const uint8_t*)c.payload.data(), c.payload.size());
+}
+
+// Every visible message reads back as the workload wrote it
+static const char* checkContents(MsgLog& log) {
+    static uint8_t buf[MSG_LOG_MAX_LEN];
+    uint32_t first = msgLogFirst(log);
+    if (msgLogCount(log) != log.next_msg - first) return "count does not match first/next";
+    for (uint32_t m = first; m < log.next_msg; m++) {
+        MsgLogEntry e;
+        if (!msgLogRead(log, m - first, e, buf, sizeof(buf))) return "visible message unreadable";
+        const std::string& want = s_payload_of[m];
+        if (e.msg != m || e.len != want.size() || memcmp(buf, want.data(), want.size()) != 0) {
+            return "visible message differs";
+        }
+    }
+    return nullptr;
+}
+
+// ── Replays ──
+struct RefState {
+    uint32_t first, next, ops;      // After the call
+};
+
+static std::vector<RefState> referenceRun() {
+    std::vector<RefState> ref;
+    MsgLog log;
+    hostFlashReset();
+    initLog(log, qspiFlashOps(), QSPI_MSG_BASE, REPLAY_SECTORS);
+    msgLogFormat(log);
+    hostFlashClearStats();
+    for (const Call& c : s_calls) {
+        run(log, c);
+        const HostFlashStats& st = hostFlashStats();
+        ref.push_back({ msgLogFirst(log), log.next_msg, st.programs + st.erases });
+    }
+    return ref;
+}
+
+static const char* replay(const std::vector<RefState>& ref, uint32_t cut, uint16_t keep, uint32_t& at_call) {
+    MsgLog log;
+    hostFlashReset();
+    initLog(log, qspiFlashOps(), QSPI_MSG_BASE, REPLAY_SECTORS);
+    msgLogFormat(log);
+    hostFlashCutAfter(cut, keep);
+    at_call = 0;
+    while (at_call < s_calls.size()) {
+        run(log, s_calls[at_call]);
+        if (hostFlashCut()) break;
+        at_call++;
+    }
+    hostFlashPowerOn();
+
+    // Calls before at_call were acknowledged; at_call itself may or may not have landed
+    const RefState before = at_call ? ref[at_call - 1] : RefState{ 0, 0, 0 };
+    const RefState after = ref[at_call];
+    initLog(log, qspiFlashOps(), QSPI_MSG_BASE, REPLAY_SECTORS);
+    if (!msgLogMount(log)) return "mount found no log";
+    if (log.next_msg != before.next && log.next_msg != after.next) return "next message number wrong";
+    uint32_t first = msgLogFirst(log);
+    if (first < before.first) return "acknowledged clear or eviction undone";
+    if (first > after.first) return "acknowledged message lost";
+    const char* why = checkContents(log);
+    if (why) return why;
+
+    // The recovered log keeps working: append across a sector switch and mount again
+    uint32_t next = log.next_msg;
+    for (uint8_t i = 0; i < 40; i++) {
+        if (s_payload_of.size() <= next + i) break;
+        const std::string& p = s_payload_of[next + i];
+        if (!msgLogAppend(log, (const uint8_t*)"SRC1", 4, (const uint8_t*)p.data(), p.size())) return "append after recovery failed";
+    }
+    initLog(log, qspiFlashOps(), QSPI_MSG_BASE, REPLAY_SECTORS);
+    if (!msgLogMount(log)) return "second mount found no log";
+    return checkContents(log);
+}
+
+static int replays() {
+    std::vector<RefState> ref = referenceRun();
+    uint32_t total = ref.back().ops;
+    int failures = 0;
+    static const uint16_t keeps[] = { 0, 64, 128, 192 };
+    for (uint16_t keep : keeps) {
+        uint32_t bad = 0;
+        for (uint32_t cut = 0; cut < total; cut++) {
+            uint32_t at_call;
+            const char* why = replay(ref, cut, keep, at_call);
+            if (why) {
+                if (bad < 5) printf("  cut at op %lu (call %lu, keep %u/256): %s\n", (unsigned long)cut,
+                                    (unsigned long)at_call, keep, why);
+                bad++;
+            }
+        }
+        printf("replay keep=%u/256: %lu cut points, %lu failed\n", keep, (unsigned long)total, (unsigned long)bad);
+        failures += bad;
+    }
+    return failures;
+}
+
+// ── Benchmark ──
+struct BenchResult {
+    uint32_t append_us, max_us, read_us, mount_us;
+    uint32_t count, replayed;
+};
+
+static BenchResult bench(const FlashOps& ops, uint32_t base, bool& ok) {
+    static uint8_t buf[MSG_LOG_MAX_LEN];
+    BenchResult r = { 0, 0, 0, 0, 0, 0 };
+    MsgLog log;
+    initLog(log, ops, base, QSPI_MSG_SECTORS);
+    msgLogFormat(log);
+
+    std::string p;
+    for (uint32_t i = 0; i < MSGBENCH_MSGS; i++) {
+        p.assign(24 + i % 120, (char)('A' + i % 26));
+        uint32_t t0 = micros();
+        ok &= msgLogAppend(log, (const uint8_t*)"BNCH", 4, (const uint8_t*)p.data(), p.size());
+        uint32_t dt = micros() - t0;
+        r.append_us += dt;
+        if (dt > r.max_us) r.max_us = dt;
+    }
+
+    uint32_t t0 = micros();
+    initLog(log, ops, base, QSPI_MSG_SECTORS);
+    ok &= msgLogMount(log);
+    r.mount_us = micros() - t0;
+    r.replayed = log.replayed;
+    r.count = msgLogCount(log);
+
+    t0 = micros();
+    uint32_t first = msgLogFirst(log);
+    for (uint32_t i = 0; i < r.count; i++) {
+        MsgLogEntry e;
+        uint32_t m = first + i;
+        ok &= msgLogRead(log, i, e, buf, sizeof(buf)) && e.len == 24 + m % 120 && buf[0] == 'A' + m % 26;
+    }
+    r.read_us = micros() - t0;
+    return r;
+}
+
+static bool benchmark() {
+    bool ok = true;
+    static uint8_t disk[QSPI_MSG_SECTORS * FLASH_SECTOR_SIZE];
+    memset(disk, 0xFF, sizeof(disk));
+    ramDiskAttach(disk, sizeof(disk));
+    BenchResult ram = bench(ramDiskOps(), 0, ok);
+
+    hostFlashReset();
+    BenchResult q = bench(qspiFlashOps(), QSPI_MSG_BASE, ok);
+    HostFlashStats st = hostFlashStats();
+
+    // Wear: erase counts the sector headers carry
+    uint32_t wmin = UINT32_MAX, wmax = 0;
+    for (uint16_t s = 0; s < QSPI_MSG_SECTORS; s++) {
+        MsgSectorHdr h;
+        qspiFlashOps().read(QSPI_MSG_BASE + s * FLASH_SECTOR_SIZE, &h, sizeof(h));
+        if (h.erases == 0xFFFFFFFF) continue;
+        if (h.erases < wmin) wmin = h.erases;
+        if (h.erases > wmax) wmax = h.erases;
+    }
+
+    uint64_t payload = 0;
+    for (uint32_t i = 0; i < MSGBENCH_MSGS; i++) payload += 24 + i % 120;
+    printf("bench n=%u msgs, %u sectors: kept=%lu replayed_on_mount=%lu wear=%lu..%lu erases/sector\n",
+           MSGBENCH_MSGS, QSPI_MSG_SECTORS, (unsigned long)q.count, (unsigned long)q.replayed,
+           (unsigned long)wmin, (unsigned long)wmax);
+    printf("  flash/msg: programs=%.2f bytes=%.1f (x%.2f payload) erases=%.4f\n",
+           (double)st.programs / MSGBENCH_MSGS, (double)st.program_bytes / MSGBENCH_MSGS,
+           (double)st.program_bytes / payload, (double)st.erases / MSGBENCH_MSGS);
+    printf("  %-5s append_us/msg=%.2f max_us=%lu read_all_us=%lu mount_us=%lu\n", "qspi",
+           (double)q.append_us / MSGBENCH_MSGS, (unsigned long)q.max_us, (unsigned long)q.read_us, (unsigned long)q.mount_us);
+    printf("  %-5s append_us/msg=%.2f max_us=%lu read_all_us=%lu mount_us=%lu\n", "ram",
+           (double)ram.append_us / MSGBENCH_MSGS, (unsigned long)ram.max_us, (unsigned long)ram.read_us, (unsigned long)ram.mount_us);
+    if (!ok) printf("benchmark: log did not read back\n");
+    return ok;
+}
+
+int main() {
+    qspiFlashInit();
+    buildWorkload();
+    int failures = replays();
+    bool ok = benchmark();
+    return failures == 0 && ok ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+// pos_codec_test.cpp — ~PP records from several senders interleaved on one receiver
+//
+// The encoder keeps one reference (ours), so each sender's frames are encoded back to back and
+// then received in a shuffled order with some lost, the way TXM chunks from nearby nodes arrive.
+// Every delta must decode to its own sender's position or be dropped — never land on another
+// sender's reference. Also: a relayed copy of a full fix, and deltas cut short before the tag
+// extension, which are dropped.
+//
+//   pos_codec_test
+
+#include "pos_codec.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define SENDERS         24
+#define ROUNDS          400
+#define CHUNKS          4           // Full fix + 3 deltas, as a TXM message
+#define LOSS_PCT        10
+#define GRID_DEG        (90.0 / 8388608.0)
+
+static int s_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                  \
+            s_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+static void begin(const char* name) { printf("== %s\n", name); }
+
+static uint32_t s_rng = 0x2545F491u;
+
+static uint32_t rnd(uint32_t max) {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng % max;
+}
+
+struct Frame {
+    std::string pp;
+    double lat, lon;
+    bool delta;
+};
+
+static Frame encode(double lat, double lon, bool allow_delta, uint32_t ms) {
+    PosFix f = {};
+    f.lat = lat;
+    f.lon = lon;
+    f.battery = -1;
+    char pp[POS_FIELD_MAX + 1];
+    size_t n = posEncode(f, allow_delta, ms, pp, sizeof(pp));
+    // POS_F_DELTA is the top bit of the first byte, so the first character is in the upper half
+    bool delta = n && strchr("ghijklmnopqrstuvwxyz0123456789-_", pp[0]);
+    return { std::string(pp, n), lat, lon, delta };
+}
+
+static bool near(const PosFix& d, double lat, double lon) {
+    return fabs(d.lat - lat) <= GRID_DEG && fabs(d.lon - lon) <= 2 * GRID_DEG;
+}
+
+// Re-encode a delta without its tag extension
+static std::string dropTagExt(const std::string& pp) {
+    static const char B64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::vector<uint8_t> rec;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (char c : pp) {
+        acc = acc << 6 | (uint32_t)(strchr(B64, c) - B64);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            rec.push_back((uint8_t)(acc >> bits));
+        }
+    }
+    rec.resize(rec.size() - 2);
+    std::string out;
+    acc = 0;
+    bits = 0;
+    for (uint8_t b : rec) {
+        acc = acc << 8 | b;
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            out += B64[(acc >> bits) & 0x3F];
+        }
+    }
+    if (bits) out += B64[(acc << (6 - bits)) & 0x3F];
+    return out;
+}
+
+static bool decode(const Frame& fr, PosFix* d) {
+    return posDecode(fr.pp.data(), fr.pp.size(), d);
+}
+
+// ── Cases ──
+static void testInterleaved() {
+    begin("A full, B full, A delta");
+    Frame a0 = encode(52.370216, 4.895168, false, 0);
+    Frame a1 = encode(52.370516, 4.895468, true, 5000);
+    Frame b0 = encode(51.924420, 4.477733, false, 6000);
+    CHECK(a1.delta && !b0.delta);
+    PosFix d;
+    CHECK(decode(a0, &d));
+    CHECK(decode(b0, &d));
+    CHECK(decode(a1, &d) && near(d, a1.lat, a1.lon));
+    printf("  delta: %zu chars\n", a1.pp.size());
+
+    begin("relayed copy of the reference");
+    CHECK(decode(a0, &d));
+    CHECK(decode(a0, &d));
+    CHECK(decode(a1, &d) && near(d, a1.lat, a1.lon));
+}
+
+// Fill the receiver's table with fixes far from the ones under test
+static void flush() {
+    PosFix d;
+    for (int j = 0; j < POS_RX_REFS; j++) decode(encode(-30.0 - j, 150.0, false, 0), &d);
+}
+
+static void testNoTagExt() {
+    begin("delta without the tag extension: dropped");
+    Frame a0 = encode(48.858370, 2.294481, false, 0);
+    Frame a1 = encode(48.858570, 2.294781, true, 1000);
+    Frame cut = { dropTagExt(a1.pp), a1.lat, a1.lon, true };
+    CHECK(cut.pp.size() + 2 == a1.pp.size());
+    PosFix d;
+    flush();
+    CHECK(decode(a0, &d));
+    CHECK(!decode(cut, &d));
+    CHECK(decode(a1, &d) && near(d, a1.lat, a1.lon));
+}
+
+static void testCrowd() {
+    begin("interleaved TXM position chunks from many senders, some lost");
+    struct Sent {
+        int sender;
+        Frame f;
+    };
+    uint32_t deltas = 0, right = 0, dropped = 0, wrong = 0, fulls_bad = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        std::vector<std::vector<Sent>> queues(SENDERS);
+        for (int s = 0; s < SENDERS; s++) {
+            double lat = 52.0 + rnd(100000) * 1e-6, lon = 4.0 + rnd(100000) * 1e-6;
+            for (int c = 0; c < CHUNKS; c++) {
+                queues[s].push_back({ s, encode(lat, lon, c > 0, c * 2000) });
+                lat += ((int)rnd(201) - 100) * 1e-6;
+                lon += ((int)rnd(201) - 100) * 1e-6;
+            }
+        }
+        // Each sender's chunks keep their order; the senders interleave at random
+        std::vector<Sent> air;
+        std::vector<size_t> at(SENDERS, 0);
+        for (size_t left = SENDERS * CHUNKS; left > 0; left--) {
+            int s;
+            do s = rnd(SENDERS); while (at[s] == CHUNKS);
+            air.push_back(queues[s][at[s]++]);
+        }
+        for (const Sent& x : air) {
+            if (rnd(100) < LOSS_PCT) continue;
+            PosFix d;
+            bool ok = decode(x.f, &d);
+            if (!x.f.delta) {
+                fulls_bad += !ok || !near(d, x.f.lat, x.f.lon);
+                continue;
+            }
+            deltas++;
+            if (!ok) dropped++;
+            else if (near(d, x.f.lat, x.f.lon)) right++;
+            else wrong++;
+        }
+    }
+    printf("  %d senders x %d rounds: %lu deltas received, %lu right, %lu dropped, %lu wrong\n", SENDERS, ROUNDS,
+           (unsigned long)deltas, (unsigned long)right, (unsigned long)dropped, (unsigned long)wrong);
+    CHECK(fulls_bad == 0);
+    CHECK(wrong == 0);
+    CHECK(right > deltas / 4);
+}
+
+int main() {
+    testInterleaved();
+    testNoTagExt();
+    testCrowd();
+    if (s_failures) printf("%d checks FAILED\n", s_failures);
+    return s_failures ? 1 : 0;
+}
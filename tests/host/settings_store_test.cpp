@@ -0,0 +1,308 @@
+// settings_store_test.cpp — Settings A/B pages on a simulated flash: round trip, deferred save,
+// migration of older/newer blobs, range checks and power loss during a save
+//
+// The pages sit on the host NOR chip (flash_host.cpp) through settingsStoreUseOps(). Blobs from
+// other firmware versions are written by hand in the on-flash format, so a format change shows up
+// here as a failure.
+//
+//   settings_store_test
+
+#include "settings_store.h"
+#include "settings.h"
+#include "mesh_relay.h"
+#include "flash_host.h"
+
+#define PAGE_A      0x1FE000UL
+#define PAGE_B      0x1FF000UL
+
+// ── Firmware globals settings_store.cpp reads (defaults as in settings.cpp) ──
+static const DeviceSettings s_defaults = {
+    .bitrate_idx = 2,
+    .volume_level = 5,
+    .channel_idx = 0,
+    .spreading_factor = 8,
+    .backlight = true,
+    .hours = 0,
+    .minutes = 0,
+    .seconds = 0,
+    .bandwidth_idx = BW_250_KHZ,
+    .coding_rate_idx = CR_6,
+    .frequency_hopping_enabled = true,
+    .mesh_enabled = false,
+    .mesh_ttl = MESH_TTL_DEFAULT
+};
+DeviceSettings deviceSettings = s_defaults;
+char channels[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const int bitrate_modes[] = { 3200, 2400, 1600, 1400, 1200, 700 };
+const size_t num_bitrate_modes = sizeof(bitrate_modes) / sizeof(bitrate_modes[0]);
+
+bool validBandwidth(uint32_t hz) {
+    static const uint32_t bws[] = { BW_7_8_KHZ, BW_10_4_KHZ, BW_15_6_KHZ, BW_20_8_KHZ, BW_31_25_KHZ,
+                                    BW_41_7_KHZ, BW_62_5_KHZ, BW_125_KHZ, BW_250_KHZ, BW_500_KHZ };
+    for (uint32_t bw : bws) if (bw == hz) return true;
+    return false;
+}
+
+// No on-chip image on the host — the overlap guard sees an empty one
+extern "C" {
+uint32_t __etext, __data_start__, __data_end__;
+}
+
+// ── On-flash format (settings_store.cpp), written by hand for other firmware versions ──
+struct __attribute__((packed)) BlobHdr {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t seq;
+    uint32_t check;
+};
+
+struct __attribute__((packed)) BodyV1 {
+    uint8_t  bitrate_idx, volume_level, channel_idx, spreading_factor;
+    uint32_t bandwidth_hz;
+    uint8_t  coding_rate, backlight, frequency_hopping, _pad, mesh, mesh_ttl;
+};
+
+static uint32_t fnv(const void* p, uint32_t len, uint32_t h = 2166136261u) {
+    const uint8_t* b = (const uint8_t*)p;
+    for (uint32_t i = 0; i < len; i++) {
+        h ^= b[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void writeBlob(uint32_t page, uint16_t version, uint32_t seq, const void* body, uint16_t size) {
+    uint8_t buf[256];
+    BlobHdr h = { 0x474E5453, version, size, seq, 0 };
+    h.check = fnv(body, size, fnv(&h, offsetof(BlobHdr, check)));
+    memcpy(buf, &h, sizeof(h));
+    memcpy(buf + sizeof(h), body, size);
+    qspiFlashOps().erase(page);
+    qspiFlashOps().program(page, buf, sizeof(h) + size);
+}
+
+// ── Harness ──
+static int s_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                  \
+            s_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+static bool same(const DeviceSettings& a, const DeviceSettings& b) {
+    return a.bitrate_idx == b.bitrate_idx && a.volume_level == b.volume_level && a.channel_idx == b.channel_idx &&
+           a.spreading_factor == b.spreading_factor && a.backlight == b.backlight &&
+           a.bandwidth_idx == b.bandwidth_idx && a.coding_rate_idx == b.coding_rate_idx &&
+           a.frequency_hopping_enabled == b.frequency_hopping_enabled && a.mesh_enabled == b.mesh_enabled &&
+           a.mesh_ttl == b.mesh_ttl;
+}
+
+static DeviceSettings custom(int k) {
+    DeviceSettings s = s_defaults;
+    s.bitrate_idx = k % 6;
+    s.volume_level = 1 + k % 10;
+    s.channel_idx = k % 26;
+    s.spreading_factor = 6 + k % 7;
+    s.backlight = k & 1;
+    s.bandwidth_idx = k & 2 ? BW_62_5_KHZ : BW_500_KHZ;
+    s.coding_rate_idx = CR_5 + k % 4;
+    s.frequency_hopping_enabled = !(k & 4);
+    s.mesh_enabled = k & 8;
+    s.mesh_ttl = 1 + k % MESH_TTL_MAX;
+    return s;
+}
+
+// Power cycle: RAM back to compiled defaults, store state rebuilt from flash
+static bool reboot() {
+    deviceSettings = s_defaults;
+    settingsStoreUseOps(&qspiFlashOps(), PAGE_A, PAGE_B);
+    return settingsStoreLoad();
+}
+
+static void fresh() {
+    hostFlashReset();
+    reboot();
+}
+
+static void begin(const char* name) { printf("== %s\n", name); }
+
+// ── Cases ──
+static void testEmpty() {
+    begin("empty pages: defaults, nothing written");
+    hostFlashReset();
+    CHECK(!reboot());
+    CHECK(same(deviceSettings, s_defaults));
+    hostFlashClearStats();
+    CHECK(settingsStoreSave());
+    CHECK(hostFlashStats().programs == 0 && hostFlashStats().erases == 0);
+}
+
+static void testRoundTrip() {
+    begin("round trip, A/B alternation");
+    fresh();
+    for (int k = 1; k <= 5; k++) {
+        deviceSettings = custom(k);
+        CHECK(settingsStoreSave());
+        CHECK(reboot());
+        CHECK(same(deviceSettings, custom(k)));
+        char st[96];
+        settingsStoreFormat(st, sizeof(st));
+        char want[32];
+        snprintf(want, sizeof(want), "seq=%d page=%c", k, k % 2 ? 'A' : 'B');
+        CHECK(strstr(st, want) != nullptr);
+        if (k == 5) printf("  %s\n", st);
+    }
+    hostFlashClearStats();
+    CHECK(settingsStoreSave());     // Unchanged since load
+    CHECK(hostFlashStats().erases == 0);
+}
+
+static void testDeferred() {
+    begin("deferred save: one write per burst, after SETTINGS_SAVE_IDLE_MS");
+    fresh();
+    hostSetClock(100000);
+    reboot();
+    hostFlashClearStats();
+    uint32_t t = millis(), last = t;
+    for (int k = 0; k < 10; k++) {
+        deviceSettings.volume_level = 1 + k;
+        last = t;
+        settingsStoreTick(t);
+        t += 500;
+        settingsStoreTick(t);
+    }
+    CHECK(hostFlashStats().erases == 0);
+    settingsStoreTick(last + SETTINGS_SAVE_IDLE_MS - 1);
+    CHECK(hostFlashStats().erases == 0);
+    settingsStoreTick(last + SETTINGS_SAVE_IDLE_MS);
+    CHECK(hostFlashStats().erases == 1);
+    settingsStoreTick(last + 3 * SETTINGS_SAVE_IDLE_MS);
+    CHECK(hostFlashStats().erases == 1);
+    CHECK(reboot() && deviceSettings.volume_level == 10);
+}
+
+static void testCorruptNewest() {
+    begin("damaged newest blob: the older page loads");
+    fresh();
+    deviceSettings = custom(1);
+    settingsStoreSave();
+    deviceSettings = custom(2);
+    settingsStoreSave();            // Page B, seq 2
+    uint8_t zero = 0x00;
+    qspiFlashOps().program(PAGE_B + sizeof(BlobHdr) + 1, &zero, 1);
+    CHECK(reboot());
+    CHECK(same(deviceSettings, custom(1)));
+    char st[96];
+    settingsStoreFormat(st, sizeof(st));
+    CHECK(strstr(st, "page=A") && strstr(st, "rejected=1"));
+
+    // The next save goes to B above the damaged seq and wins from then on
+    deviceSettings = custom(3);
+    CHECK(settingsStoreSave());
+    CHECK(reboot() && same(deviceSettings, custom(3)));
+    settingsStoreFormat(st, sizeof(st));
+    CHECK(strstr(st, "seq=3 page=B"));
+}
+
+static void testMigration() {
+    begin("older, newer and unknown blobs, out-of-range values");
+    BodyV1 b = { 4, 9, 3, 11, BW_125_KHZ, CR_7, 0, 0, 0, 1, 5 };
+
+    // Written before the hopping/mesh fields existed: 10 bytes
+    fresh();
+    writeBlob(PAGE_A, 1, 7, &b, 10);
+    CHECK(reboot());
+    DeviceSettings want = s_defaults;
+    want.bitrate_idx = 4;
+    want.volume_level = 9;
+    want.channel_idx = 3;
+    want.spreading_factor = 11;
+    want.bandwidth_idx = BW_125_KHZ;
+    want.coding_rate_idx = CR_7;
+    want.backlight = false;
+    CHECK(same(deviceSettings, want));
+
+    // Newer firmware appended fields: the known prefix loads, the check still covers all of it
+    uint8_t longer[sizeof(BodyV1) + 40];
+    memset(longer, 0xA5, sizeof(longer));
+    memcpy(longer, &b, sizeof(b));
+    fresh();
+    writeBlob(PAGE_B, 1, 9, longer, sizeof(longer));
+    CHECK(reboot());
+    want.frequency_hopping_enabled = false;
+    want.mesh_enabled = true;
+    want.mesh_ttl = 5;
+    CHECK(same(deviceSettings, want));
+
+    // Unknown schema on the newest page: skipped, the older one loads, the next save goes above both
+    fresh();
+    writeBlob(PAGE_A, 1, 4, &b, sizeof(b));
+    writeBlob(PAGE_B, 2, 5, &b, sizeof(b));
+    CHECK(reboot());
+    CHECK(same(deviceSettings, want));
+    deviceSettings.volume_level = 2;
+    CHECK(settingsStoreSave());
+    char st[96];
+    settingsStoreFormat(st, sizeof(st));
+    CHECK(strstr(st, "seq=6 page=B"));
+
+    // Values the UI cannot produce keep their defaults, the rest apply
+    BodyV1 bad = { 9, 0, 200, 40, 12345, 3, 1, 1, 0, 1, 0 };
+    fresh();
+    writeBlob(PAGE_A, 1, 1, &bad, sizeof(bad));
+    CHECK(reboot());
+    DeviceSettings clamped = s_defaults;
+    clamped.mesh_enabled = true;
+    CHECK(same(deviceSettings, clamped));
+}
+
+static void testPowerLoss() {
+    begin("power cut on every flash op of a save");
+    static const uint16_t keeps[] = { 0, 1, 64, 128, 192, 255 };
+    uint32_t cases = 0, bad = 0;
+    for (int gen = 1; gen <= 3; gen++) {            // A cut into an empty, older and newer page
+        for (uint16_t keep : keeps) {
+            for (uint32_t cut = 0; cut < 2; cut++) {
+                fresh();
+                for (int k = 1; k < gen; k++) {
+                    deviceSettings = custom(k);
+                    settingsStoreSave();
+                }
+                DeviceSettings old = gen > 1 ? custom(gen - 1) : s_defaults;
+                deviceSettings = custom(gen);
+                hostFlashCutAfter(cut, keep);
+                settingsStoreSave();
+                hostFlashPowerOn();
+
+                cases++;
+                reboot();
+                bool ok = same(deviceSettings, old) || same(deviceSettings, custom(gen));
+                // And the store keeps working after the cut
+                deviceSettings = custom(10 + gen);
+                ok &= settingsStoreSave() && reboot() && same(deviceSettings, custom(10 + gen));
+                if (!ok) {
+                    printf("  FAIL gen=%d cut=%lu keep=%u/256\n", gen, (unsigned long)cut, keep);
+                    bad++;
+                }
+            }
+        }
+    }
+    printf("  %lu cut points, %lu failed\n", (unsigned long)cases, (unsigned long)bad);
+    s_failures += bad;
+}
+
+int main() {
+    qspiFlashInit();
+    testEmpty();
+    testRoundTrip();
+    testDeferred();
+    testCorruptNewest();
+    testMigration();
+    testPowerLoss();
+    if (s_failures) printf("%d checks FAILED\n", s_failures);
+    return s_failures ? 1 : 0;
+}
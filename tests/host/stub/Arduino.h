@@ -0,0 +1,156 @@
+// Arduino.h — host stand-in for the nRF52 core: types, time, pins and a std::string-backed String
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include "Print.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH    1
+#define LOW     0
+#define INPUT   0
+#define OUTPUT  1
+#define INPUT_PULLUP    2
+#define RISING  3
+#define FALLING 4
+#define CHANGE  5
+
+#define PI      3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI  6.283185307179586476925286766559
+#define DEG_TO_RAD  0.017453292519943295769236907684886
+#define RAD_TO_DEG  57.295779513082320876798154814105
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+
+#define PROGMEM
+#define pgm_read_byte(addr)     (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t*)(addr))
+// Adafruit_GFX derives pgm_read_pointer from pgm_read_dword, so on the host it must span a pointer
+#define pgm_read_dword(addr)    (*(const unsigned long*)(addr))
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper*)(s))
+
+template <class A, class B> inline auto min(A a, B b) -> decltype(a < b ? a : b) { return a < b ? a : b; }
+template <class A, class B> inline auto max(A a, B b) -> decltype(a < b ? b : a) { return a < b ? b : a; }
+template <class T, class L, class H> inline T constrain(T x, L lo, H hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+// ── Time ──
+// Wall clock by default; hostSetClock() switches millis() to a simulated clock the test advances
+// itself. micros() stays on the wall clock — it is what the firmware times its work with.
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+void hostSetClock(uint32_t ms);
+void hostAdvanceClock(uint32_t ms);
+
+// ── Pins: writes are dropped, reads return LOW, hostInterrupt() runs an attached ISR ──
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t val);
+int digitalRead(uint32_t pin);
+void attachInterrupt(uint32_t pin, void (*isr)(), uint32_t mode);
+uint32_t digitalPinToInterrupt(uint32_t pin);
+void hostInterrupt(uint32_t pin);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+void noInterrupts();
+void interrupts();
+
+class String {
+  public:
+    String(const char* s = "") : s_(s ? s : "") {}
+    String(const std::string& s) : s_(s) {}
+    String(char c) : s_(1, c) {}
+    explicit String(int v) : s_(std::to_string(v)) {}
+    explicit String(unsigned v) : s_(std::to_string(v)) {}
+    explicit String(long v) : s_(std::to_string(v)) {}
+    explicit String(unsigned long v) : s_(std::to_string(v)) {}
+    String(double v, int digits) {
+        char b[32];
+        snprintf(b, sizeof(b), "%.*f", digits, v);
+        s_ = b;
+    }
+
+    const char* c_str() const { return s_.c_str(); }
+    unsigned length() const { return s_.size(); }
+    bool isEmpty() const { return s_.empty(); }
+    char charAt(unsigned i) const { return i < s_.size() ? s_[i] : 0; }
+    char operator[](unsigned i) const { return charAt(i); }
+    char& operator[](unsigned i) { return s_[i]; }
+    void reserve(unsigned n) { s_.reserve(n); }
+
+    String substring(unsigned from) const { return from < s_.size() ? String(s_.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= s_.size()) return String();
+        return String(s_.substr(from, to - from));
+    }
+    int indexOf(char c, unsigned from = 0) const {
+        size_t p = s_.find(c, from);
+        return p == std::string::npos ? -1 : (int)p;
+    }
+    int indexOf(const String& t, unsigned from = 0) const {
+        size_t p = s_.find(t.s_, from);
+        return p == std::string::npos ? -1 : (int)p;
+    }
+    bool startsWith(const String& t) const { return s_.compare(0, t.s_.size(), t.s_) == 0; }
+    bool endsWith(const String& t) const {
+        return s_.size() >= t.s_.size() && s_.compare(s_.size() - t.s_.size(), t.s_.size(), t.s_) == 0;
+    }
+    long toInt() const { return strtol(s_.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(s_.c_str(), nullptr); }
+    void trim() {
+        size_t a = s_.find_first_not_of(" \t\r\n");
+        size_t b = s_.find_last_not_of(" \t\r\n");
+        s_ = a == std::string::npos ? std::string() : s_.substr(a, b - a + 1);
+    }
+    void toUpperCase() {
+        for (char& c : s_) c = toupper((unsigned char)c);
+    }
+
+    String& operator+=(const String& o) { s_ += o.s_; return *this; }
+    String& operator+=(const char* o) { s_ += o; return *this; }
+    String& operator+=(char c) { s_ += c; return *this; }
+    friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+    friend String operator+(const String& a, const char* b) { return String(a.s_ + b); }
+    friend String operator+(const char* a, const String& b) { return String(a + b.s_); }
+    bool operator==(const String& o) const { return s_ == o.s_; }
+    bool operator==(const char* o) const { return s_ == o; }
+    bool operator!=(const String& o) const { return s_ != o.s_; }
+    bool operator!=(const char* o) const { return s_ != o; }
+    bool equals(const String& o) const { return s_ == o.s_; }
+
+  private:
+    std::string s_;
+};
+
+// Serial output goes to stdout
+class HostSerial : public Print {
+  public:
+    void begin(unsigned long) {}
+    operator bool() const { return true; }
+    int available() { return 0; }
+    int read() { return -1; }
+    void flush() { fflush(stdout); }
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    using Print::write;
+};
+extern HostSerial Serial;
+
+#endif
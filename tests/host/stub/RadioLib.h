@@ -0,0 +1,8 @@
+// RadioLib.h — host stand-in: the radio type is only ever named, never driven
+
+#ifndef HOST_RADIOLIB_H
+#define HOST_RADIOLIB_H
+
+class SX1262;
+
+#endif
@@ -0,0 +1,31 @@
+// SPI.h — host stand-in: only what the display code constructs
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define MSBFIRST    1
+#define SPI_MODE0   0
+
+struct NRF_SPIM_Type {
+    uint32_t dummy;
+};
+#define NRF_SPIM2   ((NRF_SPIM_Type*)nullptr)
+
+class SPISettings {
+  public:
+    SPISettings(uint32_t = 4000000, uint8_t = MSBFIRST, uint8_t = SPI_MODE0) {}
+};
+
+class SPIClass {
+  public:
+    SPIClass(NRF_SPIM_Type*, uint8_t, uint8_t, uint8_t) {}
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    uint8_t transfer(uint8_t) { return 0; }
+};
+
+#endif
@@ -0,0 +1,36 @@
+// Uart.h — host stand-in: writes are dropped, hostRx() queues bytes for read() in a ring of the
+// core's size that drops what does not fit, as the RX interrupt does
+
+#ifndef HOST_UART_H
+#define HOST_UART_H
+
+#include <Arduino.h>
+#include <string>
+
+#define SERIAL_BUFFER_SIZE 256
+
+class Uart : public Print {
+  public:
+    void begin(unsigned long) {}
+    void end() {}
+    int available() { return (int)(rx_.size() - at_); }
+    int read() {
+        if (at_ == rx_.size()) return -1;
+        int c = (uint8_t)rx_[at_++];
+        if (at_ == rx_.size()) rx_.clear(), at_ = 0;
+        return c;
+    }
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+
+    void hostRx(const char* p, size_t n) {
+        size_t room = SERIAL_BUFFER_SIZE - available();
+        rx_.append(p, n < room ? n : room);
+    }
+
+  private:
+    std::string rx_;
+    size_t at_ = 0;
+};
+
+#endif
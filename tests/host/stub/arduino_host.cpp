@@ -0,0 +1,121 @@
+// arduino_host.cpp — host implementations behind stub/Arduino.h and stub/Print.h
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <time.h>
+
+HostSerial Serial;
+
+// ── Time ──
+static bool s_sim = false;
+static uint64_t s_sim_us = 0;
+
+static uint64_t wallUs() {
+    static uint64_t t0 = 0;
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t us = (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+    if (!t0) t0 = us - 1000;
+    return us - t0;
+}
+
+uint32_t millis() { return (uint32_t)((s_sim ? s_sim_us : wallUs()) / 1000); }
+uint32_t micros() { return (uint32_t)wallUs(); }
+
+void delay(uint32_t ms) {
+    if (s_sim) s_sim_us += (uint64_t)ms * 1000;
+}
+void delayMicroseconds(uint32_t us) {
+    if (s_sim) s_sim_us += us;
+}
+void yield() {}
+
+void hostSetClock(uint32_t ms) {
+    s_sim = true;
+    s_sim_us = (uint64_t)ms * 1000;
+}
+void hostAdvanceClock(uint32_t ms) { s_sim_us += (uint64_t)ms * 1000; }
+
+// ── Pins ──
+void pinMode(uint32_t, uint32_t) {}
+void digitalWrite(uint32_t, uint32_t) {}
+int digitalRead(uint32_t) { return LOW; }
+uint32_t digitalPinToInterrupt(uint32_t pin) { return pin; }
+
+static struct {
+    uint32_t pin;
+    void (*isr)();
+} s_isrs[8];
+
+void attachInterrupt(uint32_t pin, void (*isr)(), uint32_t) {
+    for (auto& i : s_isrs) {
+        if (i.isr && i.pin != pin) continue;
+        i.pin = pin;
+        i.isr = isr;
+        return;
+    }
+}
+
+void hostInterrupt(uint32_t pin) {
+    for (auto& i : s_isrs) {
+        if (i.isr && i.pin == pin) i.isr();
+    }
+}
+
+// Fixed seed: runs are reproducible
+static uint32_t s_rand = 0x2545F491u;
+
+void randomSeed(unsigned long seed) { s_rand = seed ? (uint32_t)seed : 1; }
+
+long random(long max) {
+    if (max <= 0) return 0;
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return (long)(s_rand % (uint32_t)max);
+}
+
+long random(long lo, long hi) { return hi > lo ? lo + random(hi - lo) : lo; }
+
+void noInterrupts() {}
+void interrupts() {}
+
+// ── Print ──
+size_t Print::print(const String& s) { return write(s.c_str()); }
+
+size_t Print::print(long v, int base) {
+    if (base == DEC) {
+        char b[24];
+        snprintf(b, sizeof(b), "%ld", v);
+        return write(b);
+    }
+    return print((unsigned long)v, base);
+}
+
+size_t Print::print(unsigned long v, int base) {
+    char b[72];
+    char* p = b + sizeof(b) - 1;
+    *p = 0;
+    if (base < 2) base = 10;
+    do {
+        unsigned d = v % base;
+        *--p = d < 10 ? '0' + d : 'A' + d - 10;
+        v /= base;
+    } while (v);
+    return write(p);
+}
+
+size_t Print::print(double v, int digits) {
+    char b[48];
+    snprintf(b, sizeof(b), "%.*f", digits, v);
+    return write(b);
+}
+
+size_t Print::printf(const char* fmt, ...) {
+    char b[512];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(b, sizeof(b), fmt, ap);
+    va_end(ap);
+    return write(b);
+}
@@ -0,0 +1,8 @@
+// bluefruit.h — host stand-in: nothing on the host uses the BLE stack
+
+#ifndef HOST_BLUEFRUIT_H
+#define HOST_BLUEFRUIT_H
+
+#include <Arduino.h>
+
+#endif
@@ -0,0 +1,12 @@
+// flash_nrf5x.h — host stand-in: no on-chip flash; tests give settings_store a FlashOps instead
+
+#ifndef HOST_FLASH_NRF5X_H
+#define HOST_FLASH_NRF5X_H
+
+#include <Arduino.h>
+
+inline int flash_nrf5x_write(uint32_t, const void*, uint32_t) { abort(); }
+inline void flash_nrf5x_flush() {}
+inline bool flash_nrf5x_erase(uint32_t) { abort(); }
+
+#endif
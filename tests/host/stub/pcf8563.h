@@ -0,0 +1,32 @@
+// pcf8563.h — host stand-in: RTC_Date, and a PCF8563_Class that keeps the last time set
+
+#ifndef HOST_PCF8563_H
+#define HOST_PCF8563_H
+
+#include <Arduino.h>
+
+class RTC_Date {
+  public:
+    RTC_Date() : year(0), month(0), day(0), hour(0), minute(0), second(0) {}
+    RTC_Date(uint16_t y, uint8_t mo, uint8_t d, uint8_t h, uint8_t mi, uint8_t s)
+        : year(y), month(mo), day(d), hour(h), minute(mi), second(s) {}
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+};
+
+class PCF8563_Class {
+  public:
+    RTC_Date getDateTime() { return now_; }
+    void setDateTime(uint16_t y, uint8_t mo, uint8_t d, uint8_t h, uint8_t mi, uint8_t s) {
+        now_ = RTC_Date(y, mo, d, h, mi, s);
+    }
+
+  private:
+    RTC_Date now_;
+};
+
+#endif
@@ -0,0 +1,525 @@
+// tlv_codec_test.cpp — the 0xFE 0x02 control protocol: codec round trips, unknown and malformed
+// input, reply fragmentation at small MTUs, and reply sizes against the text commands
+//
+// tlv_codec.cpp on its own first: every wire type through the writer and back, unknown tags and
+// ops skipped, every truncation of a frame and a run of random frames walked without a read past
+// the end. Then ble_proto.cpp with the firmware it calls replaced below: each op as the app would
+// send it, batched requests whose replies must split into MORE frames at small MTUs, and the
+// on-air size of the GETSETTINGS / GETSTATUS replies next to their text forms.
+//
+//   tlv_codec_test
+
+#include "ble_proto.h"
+#include "settings.h"
+#include "app_modes.h"
+#include "gps.h"
+#include "lora.h"
+#include "epoch_clock.h"
+#include "battery.h"
+#include "mesh_relay.h"
+#include <string>
+#include <vector>
+
+#define FUZZ_FRAMES     200000
+#define TEXT_NOTIF_PRE  16          // "LINE:NOTIF|DATA:"
+#define TEXT_NOTIF_END  4           // "~~" from sendNotificationToApp() + the drain's "~~"
+
+// ── Firmware ble_proto.cpp calls ──
+DeviceSettings deviceSettings = { 2, 5, 0, 8, true, 0, 0, 0, BW_250_KHZ, CR_6, true, false, MESH_TTL_DEFAULT };
+char channels[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const int bitrate_modes[] = { 3200, 2400, 1600, 1400, 1200, 700 };
+const size_t num_bitrate_modes = sizeof(bitrate_modes) / sizeof(bitrate_modes[0]);
+const char* modes[] = { "BEACON", "RAW", "TXT", "RANGE", "TST", "PONG", "SCAN", "PTT", "WP" };
+const int numModes = sizeof(modes) / sizeof(modes[0]);
+const char* current_mode = modes[2];
+float currentFrequency = 868.1f;
+int gps_satellites = 7;
+GPSStatus gps_status = GPS_LOC;
+
+static uint16_t s_mtu = 247;
+static std::vector<std::vector<uint8_t>> s_sent;    // Reply frames, in order
+static uint32_t s_reinits = 0;
+static std::string s_txt, s_name;
+
+bool validBandwidth(uint32_t hz) {
+    static const uint32_t bws[] = { BW_7_8_KHZ, BW_10_4_KHZ, BW_15_6_KHZ, BW_20_8_KHZ, BW_31_25_KHZ,
+                                    BW_41_7_KHZ, BW_62_5_KHZ, BW_125_KHZ, BW_250_KHZ, BW_500_KHZ };
+    for (uint32_t bw : bws) if (bw == hz) return true;
+    return false;
+}
+int getBitrateFromIndex(int index) { return bitrate_modes[index]; }
+bool setupLoRa() { s_reinits++; return true; }
+bool isPeerAlive() { return true; }
+void switchMode(String m) {
+    for (int i = 0; i < numModes; i++) if (m == modes[i]) current_mode = modes[i];
+}
+void sendTxtMessage(const char* message) { s_txt = message; }
+void buddySetDisplayName(const char* name) { s_name = name; }
+RTC_Date clockDateTime() { return RTC_Date(2026, 6, 19, 13, 37, 0); }
+uint8_t getBatteryPercentage() { return 81; }
+uint16_t bleNotifyPayloadMax() { return s_mtu - 3; }
+bool sendRawNotification(const uint8_t* data, uint16_t len) {
+    s_sent.push_back(std::vector<uint8_t>(data, data + len));
+    return true;
+}
+
+// ── Harness ──
+static int s_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                  \
+            s_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+static void begin(const char* name) { printf("== %s\n", name); }
+
+static uint32_t s_rng = 0x2545F491u;
+
+static uint32_t rnd(uint32_t max) {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng % max;
+}
+
+// Every field of a message, in order
+static std::vector<TlvField> fieldsOf(TlvCursor c) {
+    std::vector<TlvField> out;
+    TlvField f;
+    while (tlvNextField(c, f)) out.push_back(f);
+    CHECK(c.p == c.end);
+    return out;
+}
+
+// ── Codec ──
+static void testWireTypes() {
+    begin("writer -> reader: every wire type");
+    uint8_t buf[600];
+    TlvWriter w;
+    tlvBeginFrame(w, buf, sizeof(buf), 0x5A);
+    uint8_t blob[255];
+    for (int i = 0; i < 255; i++) blob[i] = (uint8_t)(i * 31);
+    CHECK(tlvBeginMsg(w, 0x11));
+    CHECK(tlvPutU8(w, TLV_TAG(TLV_WT_U8, 1), 0xAB));
+    CHECK(tlvPutU16(w, TLV_TAG(TLV_WT_U16, 2), 0xBEEF));
+    CHECK(tlvPutU32(w, TLV_TAG(TLV_WT_U32, 3), 0xDEADBEEF));
+    CHECK(tlvPutU32(w, TLV_TAG(TLV_WT_U32, 4), (uint32_t)(int32_t)-123456));
+    CHECK(tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, 5), "héllo"));
+    CHECK(tlvPutBytes(w, TLV_TAG(TLV_WT_BYTES, 6), nullptr, 0));
+    CHECK(tlvPutU8(w, TLV_TAG(TLV_WT_U32, 7), 9));         // The put decides the wire type
+    CHECK(tlvEndMsg(w));
+    CHECK(tlvBeginMsg(w, 0x12));
+    CHECK(tlvPutBytes(w, TLV_TAG(TLV_WT_BYTES, 63), blob, 200));
+    CHECK(tlvEndMsg(w));
+    CHECK(tlvBeginMsg(w, 0x13));                            // Empty message
+    CHECK(tlvEndMsg(w));
+    CHECK(tlvBeginMsg(w, 0x14));
+    CHECK(tlvPutBytes(w, TLV_TAG(TLV_WT_BYTES, 8), blob, 255));   // Body over 255: refused whole
+    CHECK(!tlvEndMsg(w));
+    uint16_t n = tlvFinishFrame(w, true);
+    CHECK(w.count == 3);
+
+    TlvFrame fr;
+    CHECK(tlvParseFrame(buf, n, fr));
+    CHECK(fr.version == TLV_VERSION && fr.req_id == 0x5A && fr.count == 3 && fr.more);
+    uint8_t op;
+    TlvCursor fc;
+    CHECK(tlvNextMsg(fr.body, op, fc) && op == 0x11);
+    std::vector<TlvField> f = fieldsOf(fc);
+    CHECK(f.size() == 7);
+    if (f.size() == 7) {
+        CHECK(f[0].tag == TLV_TAG(TLV_WT_U8, 1) && f[0].u == 0xAB);
+        CHECK(f[1].tag == TLV_TAG(TLV_WT_U16, 2) && f[1].u == 0xBEEF);
+        CHECK(f[2].tag == TLV_TAG(TLV_WT_U32, 3) && f[2].u == 0xDEADBEEF);
+        CHECK((int32_t)f[3].u == -123456);
+        char s[16];
+        CHECK(tlvCopyStr(f[4], s, sizeof(s)) == 6 && strcmp(s, "héllo") == 0);
+        CHECK(tlvCopyStr(f[4], s, 4) == 3 && strcmp(s, "hé") == 0);
+        CHECK(f[5].tag == TLV_TAG(TLV_WT_BYTES, 6) && f[5].len == 0);
+        CHECK(f[6].tag == TLV_TAG(TLV_WT_U8, 7) && f[6].u == 9);
+        CHECK(tlvCopyStr(f[0], s, sizeof(s)) == 0 && s[0] == '\0');    // Not a string
+    }
+    CHECK(tlvNextMsg(fr.body, op, fc) && op == 0x12);
+    f = fieldsOf(fc);
+    CHECK(f.size() == 1 && f[0].len == 200 && memcmp(f[0].data, blob, 200) == 0);
+    CHECK(tlvNextMsg(fr.body, op, fc) && op == 0x13 && fc.p == fc.end);
+    CHECK(!tlvNextMsg(fr.body, op, fc));
+    CHECK(fr.body.p == fr.body.end);
+}
+
+static void testWriterOverflow() {
+    begin("writer: overflow is sticky and drops only the open message");
+    uint8_t buf[16];
+    TlvWriter w;
+    tlvBeginFrame(w, buf, sizeof(buf), 1);
+    CHECK(tlvBeginMsg(w, 1) && tlvPutU32(w, TLV_TAG(TLV_WT_U32, 1), 7) && tlvEndMsg(w));   // 5 + 7
+    uint16_t good = w.len;
+    CHECK(tlvBeginMsg(w, 2));
+    CHECK(!tlvPutU32(w, TLV_TAG(TLV_WT_U32, 1), 7));
+    CHECK(!tlvPutU8(w, TLV_TAG(TLV_WT_U8, 2), 1));                 // Would fit, but sticky
+    CHECK(!tlvEndMsg(w));
+    CHECK(w.len == good && w.count == 1);
+    TlvFrame fr;
+    CHECK(tlvParseFrame(buf, tlvFinishFrame(w, false), fr) && fr.count == 1 && !fr.more);
+
+    tlvBeginFrame(w, buf, 4, 1);                                    // Not even a header
+    CHECK(w.overflow && !tlvBeginMsg(w, 1) && tlvFinishFrame(w, false) == 0);
+}
+
+static void testUnknown() {
+    begin("reader: unknown tags and ops skipped by wire type");
+    uint8_t buf[128];
+    TlvWriter w;
+    tlvBeginFrame(w, buf, sizeof(buf), 2);
+    tlvBeginMsg(w, 0x6E);                                           // An op from a newer app
+    tlvPutU32(w, TLV_TAG(TLV_WT_U32, 50), 1);
+    tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, 51), "future");
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_SET_SETTINGS);
+    tlvPutU16(w, TLV_TAG(TLV_WT_U16, 40), 0x1234);                  // Unknown, each wire type
+    tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_VOL), 7);
+    tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, 41), "xyz");
+    tlvPutU32(w, TLV_TAG(TLV_WT_U32, 42), 0xFFFFFFFF);
+    tlvPutU8(w, TLV_TAG(TLV_WT_U8, 43), 0);
+    tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_TTL), 2);
+    tlvEndMsg(w);
+    uint16_t n = tlvFinishFrame(w, false);
+
+    // The codec alone: the known fields are found among the unknown ones
+    TlvFrame fr;
+    CHECK(tlvParseFrame(buf, n, fr));
+    uint8_t op;
+    TlvCursor fc;
+    CHECK(tlvNextMsg(fr.body, op, fc) && op == 0x6E);
+    CHECK(tlvNextMsg(fr.body, op, fc) && op == PROTO_OP_SET_SETTINGS);
+    uint32_t vol = 0, ttl = 0;
+    for (const TlvField& f : fieldsOf(fc)) {
+        if (f.tag == TLV_TAG(TLV_WT_U8, PF_VOL)) vol = f.u;
+        if (f.tag == TLV_TAG(TLV_WT_U8, PF_TTL)) ttl = f.u;
+    }
+    CHECK(vol == 7 && ttl == 2);
+
+    // And the protocol: the unknown op gets an error, the settings go in
+    s_sent.clear();
+    protoHandleFrame(buf, n);
+    CHECK(deviceSettings.volume_level == 7 && deviceSettings.mesh_ttl == 2);
+    CHECK(s_sent.size() == 1);
+    if (s_sent.size() != 1) return;
+    CHECK(tlvParseFrame(s_sent[0].data(), s_sent[0].size(), fr) && fr.count == 2);
+    CHECK(tlvNextMsg(fr.body, op, fc) && op == (PROTO_OP_ERROR | TLV_OP_RESP));
+    std::vector<TlvField> f = fieldsOf(fc);
+    CHECK(f.size() == 2 && f[0].u == 0x6E && f[1].u == PROTO_ERR_UNKNOWN_OP);
+    CHECK(tlvNextMsg(fr.body, op, fc) && op == (PROTO_OP_SET_SETTINGS | TLV_OP_RESP));
+    f = fieldsOf(fc);
+    CHECK(f.size() == 1 && f[0].tag == TLV_TAG(TLV_WT_U8, PF_COUNT) && f[0].u == 2);
+}
+
+// Walk a whole frame; every field must lie inside [data, data + len)
+static uint32_t walk(const uint8_t* data, uint16_t len, bool& inside) {
+    TlvFrame fr;
+    uint32_t fields = 0;
+    inside = true;
+    if (!tlvParseFrame(data, len, fr)) return 0;
+    uint8_t op;
+    TlvCursor fc;
+    while (tlvNextMsg(fr.body, op, fc)) {
+        inside &= fc.p >= data + TLV_FRAME_HDR && fc.end <= data + len;
+        TlvField f;
+        while (tlvNextField(fc, f)) {
+            inside &= f.data >= data && f.data + f.len <= data + len && fc.p <= fc.end;
+            fields++;
+        }
+    }
+    inside &= fr.body.p <= data + len;
+    return fields;
+}
+
+static void testMalformed() {
+    begin("reader: bad headers, every truncation, random frames");
+    const uint8_t opus[] = { 0xFE, 0x01, 4, 0, 1, 2, 3, 4 };
+    const uint8_t text[] = "GETSETTINGS";
+    const uint8_t shortHdr[] = { 0xFE, 0x02, 1, 0 };
+    TlvFrame fr;
+    CHECK(!tlvIsFrame(opus, sizeof(opus)) && !tlvIsFrame(text, sizeof(text) - 1));
+    CHECK(!tlvIsFrame(shortHdr, sizeof(shortHdr)) && !tlvIsFrame(nullptr, 10));
+    CHECK(!tlvParseFrame(shortHdr, sizeof(shortHdr), fr));
+
+    // A frame with every wire type, cut at every length: whatever is read lies inside the cut
+    uint8_t buf[128];
+    TlvWriter w;
+    tlvBeginFrame(w, buf, sizeof(buf), 3);
+    tlvBeginMsg(w, 1);
+    tlvPutU8(w, TLV_TAG(TLV_WT_U8, 1), 1);
+    tlvPutU16(w, TLV_TAG(TLV_WT_U16, 2), 2);
+    tlvPutU32(w, TLV_TAG(TLV_WT_U32, 3), 3);
+    tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, 4), "four");
+    tlvEndMsg(w);
+    tlvBeginMsg(w, 2);
+    tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, 5), "five");
+    tlvEndMsg(w);
+    uint16_t n = tlvFinishFrame(w, false);
+    bool inside;
+    CHECK(walk(buf, n, inside) == 5 && inside);
+    uint32_t bad = 0;
+    for (uint16_t cut = 0; cut < n; cut++) {
+        std::vector<uint8_t> copy(buf, buf + cut);     // Exactly cut bytes on the heap
+        walk(copy.data(), cut, inside);
+        bad += !inside;
+    }
+    CHECK(bad == 0);
+
+    // A message whose length runs past the frame is not returned at all
+    buf[TLV_FRAME_HDR + 1] = 200;
+    TlvCursor fc;
+    uint8_t op;
+    CHECK(tlvParseFrame(buf, n, fr) && !tlvNextMsg(fr.body, op, fc));
+
+    // Random frames, and the firmware handler on each
+    uint64_t fields = 0;
+    uint16_t mtu = s_mtu;
+    for (uint32_t i = 0; i < FUZZ_FRAMES; i++) {
+        uint16_t len = TLV_FRAME_HDR + rnd(60);
+        std::vector<uint8_t> f(len);
+        for (uint8_t& b : f) b = (uint8_t)rnd(256);
+        f[0] = TLV_MAGIC;
+        f[1] = TLV_CHANNEL;
+        if (rnd(4)) f[2] = TLV_VERSION;
+        if (rnd(2)) f[TLV_FRAME_HDR] = (uint8_t)rnd(8);                 // Mostly known ops
+        fields += walk(f.data(), len, inside);
+        bad += !inside;
+        if (i % 16 == 0) {
+            s_sent.clear();
+            s_mtu = 23 + rnd(224);
+            protoHandleFrame(f.data(), len);
+            for (const auto& r : s_sent) bad += r.size() > (size_t)(s_mtu - 3);
+        }
+    }
+    s_mtu = mtu;
+    deviceSettings = { 2, 5, 0, 8, true, 0, 0, 0, BW_250_KHZ, CR_6, true, false, MESH_TTL_DEFAULT };
+    printf("  %d random frames, %llu fields read, %u outside the frame or over the MTU\n", FUZZ_FRAMES,
+           (unsigned long long)fields, (unsigned)bad);
+    CHECK(bad == 0);
+}
+
+// ── Protocol ──
+struct Reply {
+    uint8_t op;
+    std::vector<TlvField> fields;
+    uint16_t size;          // Message bytes, header included
+    uint16_t frame;         // Reply frame it came in
+};
+
+// One request frame through protoHandleFrame(); every reply message, checking the frame layout
+static std::vector<Reply> request(TlvWriter& w, uint8_t req_id) {
+    uint16_t n = tlvFinishFrame(w, false);
+    s_sent.clear();
+    protoHandleFrame(w.buf, n);
+    std::vector<Reply> out;
+    for (size_t i = 0; i < s_sent.size(); i++) {
+        TlvFrame fr;
+        CHECK(tlvParseFrame(s_sent[i].data(), s_sent[i].size(), fr));
+        CHECK(s_sent[i].size() <= (size_t)(s_mtu - 3));
+        CHECK(fr.req_id == req_id && fr.more == (i + 1 < s_sent.size()));
+        uint8_t op, count = 0;
+        TlvCursor fc;
+        while (tlvNextMsg(fr.body, op, fc)) {
+            out.push_back({ op, fieldsOf(fc), (uint16_t)(fc.end - fc.p + TLV_MSG_HDR), (uint16_t)i });
+            count++;
+        }
+        CHECK(count == fr.count);
+    }
+    return out;
+}
+
+static uint32_t fieldU(const Reply& r, uint8_t tag) {
+    for (const TlvField& f : r.fields) if (f.tag == tag) return f.u;
+    return 0xFFFFFFFF;
+}
+
+static void testOps() {
+    begin("every op: request frame -> reply frame");
+    uint8_t buf[256];
+    TlvWriter w;
+
+    tlvBeginFrame(w, buf, sizeof(buf), 10);
+    tlvBeginMsg(w, PROTO_OP_PING);
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_GET_SETTINGS);
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_GET_STATUS);
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_GET_SCREEN);
+    tlvEndMsg(w);
+    std::vector<Reply> r = request(w, 10);
+    CHECK(r.size() == 4);
+    if (r.size() == 4) {
+        CHECK(r[0].op == (PROTO_OP_PING | TLV_OP_RESP) && r[0].fields.empty());
+        CHECK(r[1].op == (PROTO_OP_GET_SETTINGS | TLV_OP_RESP) && r[1].fields.size() == 13);
+        CHECK(fieldU(r[1], TLV_TAG(TLV_WT_U8, PF_SF)) == 8);
+        CHECK(fieldU(r[1], TLV_TAG(TLV_WT_U32, PF_BW)) == BW_250_KHZ);
+        CHECK(fieldU(r[1], TLV_TAG(TLV_WT_U8, PF_TTL)) == MESH_TTL_DEFAULT);
+        CHECK(r[2].op == (PROTO_OP_GET_STATUS | TLV_OP_RESP));
+        CHECK(fieldU(r[2], TLV_TAG(TLV_WT_U8, PF_BLE)) == 1 && fieldU(r[2], TLV_TAG(TLV_WT_U8, PF_LORA)) == 1);
+        CHECK(r[3].op == (PROTO_OP_GET_SCREEN | TLV_OP_RESP));
+        CHECK(fieldU(r[3], TLV_TAG(TLV_WT_U8, PF_MODE)) == 2);
+        CHECK(fieldU(r[3], TLV_TAG(TLV_WT_U32, PF_FREQ_KHZ)) == 868100);
+        CHECK(fieldU(r[3], TLV_TAG(TLV_WT_U16, PF_TIME_MIN)) == 13 * 60 + 37);
+        CHECK(fieldU(r[3], TLV_TAG(TLV_WT_U16, PF_BITRATE_BPS)) == 1600);
+        CHECK(fieldU(r[3], TLV_TAG(TLV_WT_U8, PF_BATT)) == 81 && fieldU(r[3], TLV_TAG(TLV_WT_U8, PF_GPS_FIX)) == 1);
+    }
+
+    // SET_SETTINGS: range-checked, a radio setting re-inits once, a bad value is an error
+    tlvBeginFrame(w, buf, sizeof(buf), 11);
+    tlvBeginMsg(w, PROTO_OP_SET_SETTINGS);
+    tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_SF), 10);
+    tlvPutU32(w, TLV_TAG(TLV_WT_U32, PF_BW), BW_125_KHZ);
+    tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_CR), CR_8);
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_SET_SETTINGS);
+    tlvPutU32(w, TLV_TAG(TLV_WT_U32, PF_BW), 123456);
+    tlvEndMsg(w);
+    uint32_t reinits = s_reinits;
+    r = request(w, 11);
+    CHECK(r.size() == 2 && s_reinits == reinits + 1);
+    CHECK(deviceSettings.spreading_factor == 10 && deviceSettings.bandwidth_idx == BW_125_KHZ);
+    CHECK(deviceSettings.coding_rate_idx == CR_8);
+    if (r.size() == 2) {
+        CHECK(fieldU(r[0], TLV_TAG(TLV_WT_U8, PF_COUNT)) == 3);
+        CHECK(r[1].op == (PROTO_OP_ERROR | TLV_OP_RESP) && fieldU(r[1], TLV_TAG(TLV_WT_U8, PF_ERR)) == PROTO_ERR_BAD_ARG);
+        CHECK(fieldU(r[1], TLV_TAG(TLV_WT_U8, PF_OP)) == PROTO_OP_SET_SETTINGS);
+    }
+
+    // SET_MODE, SEND_TXT, SET_NAME: acks, and an error without their field
+    tlvBeginFrame(w, buf, sizeof(buf), 12);
+    tlvBeginMsg(w, PROTO_OP_SET_MODE);
+    tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_MODE), 7);
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_SEND_TXT);
+    tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, PF_TEXT), "hello mesh");
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_SET_NAME);
+    tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, PF_NAME), "a name longer than thirty-one characters");
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_SET_MODE);
+    tlvPutU8(w, TLV_TAG(TLV_WT_U8, PF_MODE), 99);
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_SEND_TXT);
+    tlvEndMsg(w);
+    r = request(w, 12);
+    CHECK(r.size() == 5);
+    CHECK(strcmp(current_mode, "PTT") == 0);
+    CHECK(s_txt == "hello mesh");
+    CHECK(s_name == std::string("a name longer than thirty-one characters").substr(0, 31));
+    if (r.size() == 5) {
+        CHECK(r[0].op == (PROTO_OP_SET_MODE | TLV_OP_RESP) && r[0].fields.empty());
+        CHECK(r[1].op == (PROTO_OP_SEND_TXT | TLV_OP_RESP));
+        CHECK(r[2].op == (PROTO_OP_SET_NAME | TLV_OP_RESP));
+        CHECK(r[3].op == (PROTO_OP_ERROR | TLV_OP_RESP) && fieldU(r[3], TLV_TAG(TLV_WT_U8, PF_OP)) == PROTO_OP_SET_MODE);
+        CHECK(r[4].op == (PROTO_OP_ERROR | TLV_OP_RESP) && fieldU(r[4], TLV_TAG(TLV_WT_U8, PF_OP)) == PROTO_OP_SEND_TXT);
+    }
+
+    // Another frame version: one error, nothing run
+    tlvBeginFrame(w, buf, sizeof(buf), 13);
+    buf[2] = TLV_VERSION + 1;
+    tlvBeginMsg(w, PROTO_OP_SEND_TXT);
+    tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, PF_TEXT), "from the future");
+    tlvEndMsg(w);
+    r = request(w, 13);
+    CHECK(r.size() == 1 && s_txt == "hello mesh");
+    if (r.size() == 1) CHECK(fieldU(r[0], TLV_TAG(TLV_WT_U8, PF_ERR)) == PROTO_ERR_VERSION);
+
+    // The header count bounds the messages run
+    tlvBeginFrame(w, buf, sizeof(buf), 14);
+    tlvBeginMsg(w, PROTO_OP_PING);
+    tlvEndMsg(w);
+    tlvBeginMsg(w, PROTO_OP_SEND_TXT);
+    tlvPutStr(w, TLV_TAG(TLV_WT_BYTES, PF_TEXT), "not counted");
+    tlvEndMsg(w);
+    w.count = 1;
+    r = request(w, 14);
+    CHECK(r.size() == 1 && s_txt == "hello mesh");
+
+    deviceSettings = { 2, 5, 0, 8, true, 0, 0, 0, BW_250_KHZ, CR_6, true, false, MESH_TTL_DEFAULT };
+    current_mode = modes[2];
+}
+
+static void testFragmentation() {
+    begin("batched replies split into MORE frames at small MTUs");
+    static const uint8_t ops[] = { PROTO_OP_GET_SETTINGS, PROTO_OP_GET_SCREEN, PROTO_OP_GET_STATUS, PROTO_OP_PING };
+    uint8_t buf[256];
+    uint16_t full[4] = {};      // Reply size of each op
+    uint16_t mtus[] = { 247, 185, 100, 64, 48, 40, 27, 23 };
+    for (uint16_t mtu : mtus) {
+        s_mtu = mtu;
+        uint16_t cap = mtu - 3;
+        TlvWriter w;
+        tlvBeginFrame(w, buf, sizeof(buf), 20);
+        for (uint8_t i = 0; i < 24; i++) {
+            tlvBeginMsg(w, ops[i % 4]);
+            tlvEndMsg(w);
+        }
+        std::vector<Reply> r = request(w, 20);
+        if (mtu == 247) {
+            for (size_t i = 0; i < 4 && i < r.size(); i++) full[i] = r[i].size;
+        }
+        uint32_t bytes = 0, in_order = 0, too_big = 0, expect_big = 0, not_greedy = 0;
+        for (const auto& f : s_sent) bytes += f.size();
+        for (size_t i = 0; i < r.size() && i < 24; i++) {
+            if (r[i].op == (ops[i % 4] | TLV_OP_RESP)) in_order++;
+            else if (r[i].op == (PROTO_OP_ERROR | TLV_OP_RESP) && fieldU(r[i], TLV_TAG(TLV_WT_U8, PF_OP)) == ops[i % 4]) too_big++;
+            expect_big += TLV_FRAME_HDR + full[i % 4] > cap;
+            // A reply opens a new frame only when it would not have fitted the one before
+            if (i > 0 && r[i].frame != r[i - 1].frame && s_sent[r[i - 1].frame].size() + r[i].size <= cap) not_greedy++;
+        }
+        printf("  mtu %3u: %2zu frames, %4lu bytes, %2zu replies, %lu too big for one frame\n", mtu, s_sent.size(),
+               (unsigned long)bytes, r.size(), (unsigned long)too_big);
+        CHECK(r.size() == 24 && in_order + too_big == 24);
+        CHECK(too_big == expect_big);
+        CHECK(not_greedy == 0);
+    }
+    s_mtu = 247;
+}
+
+static void testSizes() {
+    begin("reply size on the air: TLV vs text");
+    uint8_t buf[64];
+    TlvWriter w;
+    char text[200];
+
+    tlvBeginFrame(w, buf, sizeof(buf), 30);
+    tlvBeginMsg(w, PROTO_OP_GET_SETTINGS);
+    tlvEndMsg(w);
+    request(w, 30);
+    size_t tlv_settings = s_sent.empty() ? 0 : s_sent[0].size();
+    size_t text_settings = TEXT_NOTIF_PRE + protoFormatSettingsText(text, sizeof(text)) + TEXT_NOTIF_END;
+    printf("  GETSETTINGS  text %3zu bytes (%s)  TLV %3zu bytes  %.1fx\n", text_settings, text, tlv_settings,
+           (double)text_settings / tlv_settings);
+
+    tlvBeginFrame(w, buf, sizeof(buf), 31);
+    tlvBeginMsg(w, PROTO_OP_GET_STATUS);
+    tlvEndMsg(w);
+    request(w, 31);
+    size_t tlv_status = s_sent.empty() ? 0 : s_sent[0].size();
+    // As cmdGetStatus() in ble_cmd.cpp
+    size_t text_status = TEXT_NOTIF_PRE + snprintf(text, sizeof(text), "OK{BLE:1}{LORA:%d}", isPeerAlive() ? 1 : 0) +
+                         TEXT_NOTIF_END;
+    printf("  GETSTATUS    text %3zu bytes (%s)  TLV %3zu bytes  %.1fx\n", text_status, text, tlv_status,
+           (double)text_status / tlv_status);
+    CHECK(tlv_settings > 0 && text_settings >= 3 * tlv_settings);
+    CHECK(tlv_status > 0 && text_status >= 3 * tlv_status);
+}
+
+int main() {
+    testWireTypes();
+    testWriterOverflow();
+    testUnknown();
+    testMalformed();
+    testOps();
+    testFragmentation();
+    testSizes();
+    if (s_failures) printf("%d checks FAILED\n", s_failures);
+    return s_failures ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+// track_log_test.cpp — GPS track encoder → TRKDUMP pages → build_scripts/track2gpx.py round trip
+//
+// A scripted 2.5 h outing (walk with turns, a stop, a drive, a walk back, a gap that must start a
+// new segment) goes through trackOffer()/trackTick() one fix every 5 s, with GPS-like jitter on
+// position, course and altitude. The ring on the host NOR chip is then paged out the way the BLE
+// TRKDUMP command does it and decoded by track2gpx.py:
+//   --text   every decoded point is a fix that was offered — time, lat and lon exact, altitude
+//            within the TRACK_ALT_STEP_M dead band — in the same segments, as many as TRKSTATS counts
+//   GPX      the bytes/point the script reports, which must stay near the figure track_log.h quotes
+//
+//   track_log_test        (needs python3 on the PATH)
+
+#include "track_log.h"
+#include "geodesy.h"
+#include "flash_host.h"
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <time.h>
+
+#define TRACK2GPX       "python3 ../../build_scripts/track2gpx.py"
+#define DUMP_PATH       "build/track_dump.txt"
+#define GPX_PATH        "build/track.gpx"
+#define FIX_MS          5000
+#define START_UNIX      1781870400UL        // 2026-06-19 12:00:00 UTC
+// Bytes per point over the whole outing, key points included — what track_log.h quotes
+#define TRACK_BPP_MIN   3.0
+#define TRACK_BPP_MAX   4.5
+
+struct Fix {
+    uint32_t t;
+    int32_t  lat, lon;      // As the encoder rounds them
+    int      alt;
+    int      seg;
+};
+
+static std::map<uint32_t, Fix> s_fixes;     // Unix time -> offered fix
+
+// ── Harness ──
+static int s_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                  \
+            s_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+static void begin(const char* name) { printf("== %s\n", name); }
+
+// Uniform in [-1, 1)
+static double jitter() {
+    return (random(20001) - 10000) / 10000.0;
+}
+
+// ── Scripted outing ──
+struct Leg {
+    uint32_t secs;
+    float    speed_mps;
+    float    turn_every_s;      // 0 = straight
+    float    turn_deg;
+    float    wander_deg;        // Random course change per fix
+};
+
+static const Leg s_legs[] = {
+    { 1800, 1.4f, 240, 90, 6 },         // Walk through town, a corner every 4 min
+    { 900, 0.0f, 0, 0, 0 },             // Café stop
+    { 1500, 1.3f, 420, -60, 8 },        // Walk on
+    { 1200, 15.0f, 150, 35, 1 },        // Drive
+    { 1200, 1.4f, 300, 120, 5 },        // Walk back
+    { 1800, 0.0f, 0, 0, 0 },            // No fixes: indoors, new segment after
+    { 900, 1.2f, 180, -90, 6 },
+};
+
+static void offerFix(uint32_t t, double lat, double lon, double alt, float speed, float course, int seg) {
+    time_t tt = t;
+    struct tm tm;
+    gmtime_r(&tt, &tm);
+    uint32_t date = tm.tm_mday * 10000 + (tm.tm_mon + 1) * 100 + tm.tm_year % 100;
+    uint32_t tod = tm.tm_hour * 1000000 + tm.tm_min * 10000 + tm.tm_sec * 100;
+    trackOffer(lat, lon, (float)alt, speed, course, date, tod);
+    s_fixes[t] = { t, (int32_t)lround(lat * 1e6), (int32_t)lround(lon * 1e6), (int)lroundf((float)alt), seg };
+}
+
+// Returns the number of fixes offered
+static uint32_t runOuting() {
+    randomSeed(42);
+    double lat = 52.370216, lon = 4.895168, alt = 4.0, course = 30.0;
+    double nlat = 0, nlon = 0;              // Slowly wandering position error, metres
+    uint32_t t = START_UNIX, fixes = 0;
+    int seg = 0;
+    for (const Leg& leg : s_legs) {
+        bool indoors = leg.speed_mps == 0 && leg.secs > TRACK_SEGMENT_GAP_S * 2;
+        for (uint32_t s = 0; s < leg.secs; s += FIX_MS / 1000) {
+            t += FIX_MS / 1000;
+            hostAdvanceClock(FIX_MS);
+            if (leg.turn_every_s > 0 && s > 0 && s % (uint32_t)leg.turn_every_s == 0) course += leg.turn_deg;
+            course += jitter() * leg.wander_deg;
+            course = fmod(course + 360.0, 360.0);
+            double step = leg.speed_mps * FIX_MS / 1000.0;
+            lat += step * cos(course * DEG_TO_RAD) / 111195.0;
+            lon += step * sin(course * DEG_TO_RAD) / (111195.0 * cos(lat * DEG_TO_RAD));
+            alt += leg.speed_mps * 0.01 * jitter();
+            nlat = 0.9 * nlat + 0.6 * jitter();
+            nlon = 0.9 * nlon + 0.6 * jitter();
+
+            if (!indoors) {
+                float speed = leg.speed_mps > 0 ? leg.speed_mps + 0.2f * (float)jitter() : 0.1f * (float)(jitter() + 1);
+                float rep_course = (float)fmod(course + 3 * jitter() + 360.0, 360.0);
+                offerFix(t, lat + nlat / 111195.0, lon + nlon / (111195.0 * cos(lat * DEG_TO_RAD)),
+                         alt + 1.5 * jitter(), speed, rep_course, seg);
+                fixes++;
+            }
+            trackTick(millis());
+        }
+        if (indoors) seg++;
+    }
+    return fixes;
+}
+
+// ── Export: TRKDUMP, TRKDUMP:<NEXT>, ... as ble_cmd.cpp pages it ──
+static bool dump(uint32_t& pages) {
+    FILE* f = fopen(DUMP_PATH, "w");
+    if (!f) return false;
+    static char r[1056];
+    trackFlush();
+    uint32_t from = 0;
+    pages = 0;
+    for (;;) {
+        trackExport(r, sizeof(r), from);
+        fprintf(f, "%s\n", r);
+        pages++;
+        const char* next = strstr(r, "{NEXT:");
+        if (!next || pages > 1000) break;
+        from = strtoul(next + 6, nullptr, 10);
+    }
+    fclose(f);
+    return strncmp(r, "OK{TRK:", 7) == 0;
+}
+
+static unsigned long statField(const char* stats, const char* key) {
+    const char* p = strstr(stats, key);
+    return p ? strtoul(p + strlen(key), nullptr, 10) : 0;
+}
+
+// ── Cases ──
+static void testTextRoundTrip(unsigned long points) {
+    begin("track2gpx.py --text: every point is an offered fix");
+    FILE* p = popen(TRACK2GPX " " DUMP_PATH " --text", "r");
+    CHECK(p != nullptr);
+    if (!p) return;
+    char line[160], iso[32];
+    int seg, alt;
+    double lat, lon;
+    unsigned long decoded = 0, bad = 0, alt_max_err = 0;
+    int last_seg = -1;
+    uint32_t last_t = 0;
+    while (fgets(line, sizeof(line), p)) {
+        if (sscanf(line, "%d %31s %lf %lf %d", &seg, iso, &lat, &lon, &alt) != 5) {
+            bad++;
+            continue;
+        }
+        decoded++;
+        struct tm tm = {};
+        strptime(iso, "%Y-%m-%dT%H:%M:%SZ", &tm);
+        uint32_t t = (uint32_t)timegm(&tm);
+        auto it = s_fixes.find(t);
+        const char* why = nullptr;
+        if (it == s_fixes.end()) why = "time never offered";
+        else if (lround(lat * 1e6) != it->second.lat || lround(lon * 1e6) != it->second.lon) why = "position differs";
+        else if (abs(alt - it->second.alt) >= TRACK_ALT_STEP_M) why = "altitude outside the dead band";
+        else if (t <= last_t) why = "time not increasing";
+        else if (seg != it->second.seg) why = "wrong segment";
+        else {
+            unsigned long e = abs(alt - it->second.alt);
+            if (e > alt_max_err) alt_max_err = e;
+        }
+        if (why) {
+            if (bad < 5) printf("  %s: %s", why, line);
+            bad++;
+        }
+        last_seg = seg;
+        last_t = t;
+    }
+    int rc = pclose(p);
+    printf("  %lu points decoded (TRKSTATS points=%lu), %lu bad, altitude within %lu m\n", decoded, points, bad,
+           alt_max_err);
+    CHECK(rc == 0);
+    CHECK(bad == 0);
+    CHECK(decoded == points);
+    CHECK(last_seg == 1);
+}
+
+static void testGpx(unsigned long bpp_x100) {
+    begin("track2gpx.py GPX: bytes per point");
+    FILE* p = popen(TRACK2GPX " " DUMP_PATH " " GPX_PATH, "r");
+    CHECK(p != nullptr);
+    if (!p) return;
+    char line[256] = "";
+    fgets(line, sizeof(line), p);
+    CHECK(pclose(p) == 0);
+    printf("  %s", line);
+    unsigned long n = 0, segs = 0, blocks = 0;
+    double bpp = 0;
+    CHECK(sscanf(line, "%lu points in %lu segments, %lu blocks, %lf bytes/point", &n, &segs, &blocks, &bpp) == 4);
+    // The script and TRKSTATS count the same bytes
+    CHECK(fabs(bpp * 100 - bpp_x100) < 1.5);
+    // Without the key points: what one varint group costs
+    double group = n > blocks ? (bpp * n - blocks * sizeof(TrackBlockHdr)) / (n - blocks) : 0;
+    printf("  %.2f bytes per delta group, %.1f points per block\n", group, blocks ? (double)n / blocks : 0.0);
+    CHECK(bpp >= TRACK_BPP_MIN && bpp <= TRACK_BPP_MAX);
+}
+
+int main() {
+    mkdir("build", 0755);
+    hostFlashReset();
+    hostSetClock(1000);
+    trackInit();
+    trackClear();
+
+    begin("scripted outing through trackOffer/trackTick");
+    uint32_t offered = runOuting();
+    uint32_t pages = 0;
+    CHECK(dump(pages));
+    char stats[200];
+    trackFormatStats(stats, sizeof(stats));
+    printf("  %lu fixes offered, %lu TRKDUMP pages\n  %s\n", (unsigned long)offered, (unsigned long)pages, stats);
+    CHECK(statField(stats, "offered=") == offered);
+    CHECK(statField(stats, "open=") == 0);
+
+    testTextRoundTrip(statField(stats, "points="));
+    testGpx(statField(stats, "bpp_x100="));
+    if (s_failures) printf("%d checks FAILED\n", s_failures);
+    return s_failures ? 1 : 0;
+}